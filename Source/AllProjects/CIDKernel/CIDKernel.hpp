@@ -374,6 +374,7 @@ namespace tCIDKernel
 #include    "CIDKernel_Environment.hpp"
 #include    "CIDKernel_ResourceName.hpp"
 #include    "CIDKernel_CriticalSection.hpp"
+#include    "CIDKernel_RWLock.hpp"
 #include    "CIDKernel_SharedMemBuf.hpp"
 #include    "CIDKernel_Event.hpp"
 #include    "CIDKernel_Mutex.hpp"
@@ -29,6 +29,11 @@
 //      to maintain portability, since the auto mode is not really supported
 //      on other platforms.
 //
+//  3)  On Linux, bWaitMultiple() can't block on both events at once, so it
+//      waits on each in turn in 10ms slices. So it's a poll, and a trigger of
+//      the second event can take up to one slice to be seen. Don't use it in
+//      code where that latency or the periodic wakeups matter.
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -0,0 +1,166 @@
+//
+// FILE NAME: CIDKernel_Hash64_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is an internal header that provides the guts of the fast 64 bit hash
+//  that is exposed via TRawMem::c8HashBuffer64() and TRawStr::c8HashStr64().
+//  Both of them need it, so it's here as inlines.
+//
+//  It is a multiply/fold hash in the style of wyhash. The input is consumed as
+//  64 bit little endian words, in stripes of four words, which are folded into
+//  two independent lanes so that the multiplies can overlap. Whatever is left
+//  at the end (up to three full words and a partial, zero padded one) is folded
+//  into the combined lanes, and then the byte length is mixed in.
+//
+//  Everything is defined in terms of the byte stream, and words are formed in
+//  little endian order regardless of the platform, so the results are the same
+//  everywhere. The accumulator is incremental, so that text can be converted to
+//  the byte stream on the fly, without knowing the final length up front.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  This is not a cryptographic hash and must not be used where someone
+//      could be trying to create collisions.
+//
+//  2)  The results are part of the public contract (they may be stored or sent
+//      between platforms), so don't change the constants or the scheme.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+namespace CIDKernel_Hash64
+{
+    // -----------------------------------------------------------------------
+    //  The secrets, which are the wyhash default ones, i.e. odd constants with
+    //  a good balance of bits.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard8   c8Secret0 = 0xA0761D6478BD642FULL;
+    constexpr tCIDLib::TCard8   c8Secret1 = 0xE7037ED1A0B428DBULL;
+    constexpr tCIDLib::TCard8   c8Secret2 = 0x8EBC6AF09C88C6E3ULL;
+    constexpr tCIDLib::TCard8   c8Secret3 = 0x589965CC75374CC3ULL;
+
+
+    // -----------------------------------------------------------------------
+    //  Does a full 64x64 to 128 bit multiply and folds the two halves together.
+    //  If the platform defines a 128 bit multiply we use it, else we do it in
+    //  32 bit parts.
+    // -----------------------------------------------------------------------
+    inline tCIDLib::TCard8 c8MulFold(const tCIDLib::TCard8 c8A, const tCIDLib::TCard8 c8B)
+    {
+        tCIDLib::TCard8 c8Lo;
+        tCIDLib::TCard8 c8Hi;
+        #if defined(CIDLIB_MUL128)
+        CIDLIB_MUL128(c8A, c8B, c8Lo, c8Hi)
+        #else
+        const tCIDLib::TCard8 c8ALo = c8A & 0xFFFFFFFF;
+        const tCIDLib::TCard8 c8AHi = c8A >> 32;
+        const tCIDLib::TCard8 c8BLo = c8B & 0xFFFFFFFF;
+        const tCIDLib::TCard8 c8BHi = c8B >> 32;
+
+        const tCIDLib::TCard8 c8LL = c8ALo * c8BLo;
+        const tCIDLib::TCard8 c8LH = c8ALo * c8BHi;
+        const tCIDLib::TCard8 c8HL = c8AHi * c8BLo;
+        const tCIDLib::TCard8 c8HH = c8AHi * c8BHi;
+
+        const tCIDLib::TCard8 c8Mid = (c8LL >> 32) + (c8LH & 0xFFFFFFFF) + (c8HL & 0xFFFFFFFF);
+        c8Lo = (c8Mid << 32) | (c8LL & 0xFFFFFFFF);
+        c8Hi = c8HH + (c8LH >> 32) + (c8HL >> 32) + (c8Mid >> 32);
+        #endif
+        return c8Lo ^ c8Hi;
+    }
+
+
+    // -----------------------------------------------------------------------
+    //   CLASS: THash64Accum
+    //  PREFIX: hacc
+    //
+    //  The incremental accumulator. The caller feeds in full stripes of four
+    //  words, and then calls c8Finish() with whatever is left over, which must
+    //  be less than a stripe.
+    // -----------------------------------------------------------------------
+    class THash64Accum
+    {
+        public :
+            explicit THash64Accum(const tCIDLib::TCard8 c8Seed) :
+
+                m_c8Bytes(0)
+                , m_c8Seed(c8Seed ^ c8MulFold(c8Seed ^ c8Secret0, c8Secret1))
+            {
+                m_c8Lane1 = m_c8Seed;
+                m_c8Lane2 = m_c8Seed ^ c8Secret3;
+            }
+
+            THash64Accum(const THash64Accum&) = delete;
+            THash64Accum(THash64Accum&&) = delete;
+
+            THash64Accum& operator=(const THash64Accum&) = delete;
+            THash64Accum& operator=(THash64Accum&&) = delete;
+
+            tCIDLib::TVoid AddStripe(const  tCIDLib::TCard8 c8W0
+                                    , const tCIDLib::TCard8 c8W1
+                                    , const tCIDLib::TCard8 c8W2
+                                    , const tCIDLib::TCard8 c8W3)
+            {
+                m_c8Lane1 = c8MulFold(c8W0 ^ c8Secret1, c8W1 ^ m_c8Lane1);
+                m_c8Lane2 = c8MulFold(c8W2 ^ c8Secret2, c8W3 ^ m_c8Lane2);
+                m_c8Bytes += 32;
+            }
+
+            //
+            //  The left over words, the last of which can be partial (zero
+            //  padded), and the number of actual bytes they hold.
+            //
+            tCIDLib::TCard8 c8Finish(const  tCIDLib::TCard8* const  pc8Left
+                                    , const tCIDLib::TCard4         c4LeftBytes)
+            {
+                tCIDLib::TCard8 c8Ret = m_c8Lane1 ^ m_c8Lane2;
+
+                const tCIDLib::TCard4 c4Words = (c4LeftBytes + 7) / 8;
+                tCIDLib::TCard4 c4Index = 0;
+                for (; c4Index + 1 < c4Words; c4Index += 2)
+                    c8Ret = c8MulFold(pc8Left[c4Index] ^ c8Secret1, pc8Left[c4Index + 1] ^ c8Ret);
+                if (c4Index < c4Words)
+                    c8Ret = c8MulFold(pc8Left[c4Index] ^ c8Secret1, c8Ret);
+
+                const tCIDLib::TCard8 c8Len = m_c8Bytes + c4LeftBytes;
+                return c8MulFold(c8Ret ^ c8Secret0 ^ c8Len, m_c8Seed ^ c8Secret1);
+            }
+
+        private :
+            // ---------------------------------------------------------------
+            //  Private data members
+            //
+            //  m_c8Bytes
+            //      The bytes consumed via full stripes so far.
+            //
+            //  m_c8Lane1
+            //  m_c8Lane2
+            //      The two lanes the stripes are folded into.
+            //
+            //  m_c8Seed
+            //      The caller's seed, scrambled, which is mixed into the final
+            //      result.
+            // ---------------------------------------------------------------
+            tCIDLib::TCard8     m_c8Bytes;
+            tCIDLib::TCard8     m_c8Lane1;
+            tCIDLib::TCard8     m_c8Lane2;
+            tCIDLib::TCard8     m_c8Seed;
+    };
+}
@@ -0,0 +1,105 @@
+//
+// FILE NAME: CIDKernel_RWLock.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDKernel_RWLock.Cpp file. This file implements
+//  the TKrnlRWLock class, which is a shared/exclusive (reader/writer) lock. Any
+//  number of threads can hold it shared at once, or one thread can hold it
+//  exclusively. Like critical sections, these are local to the process.
+//
+//  Waiting writers are given preference over new readers, so that a steady
+//  stream of readers cannot starve out writers.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  This guy is NOT recursive, in either mode. Because of the writer
+//      preference, a thread that takes it shared a second time can deadlock if
+//      a writer has started waiting in between. The CIDLib level TRWLock class
+//      deals with recursion on top of this.
+//
+//  2)  The platform may not have a timed wait for these. If not, timed waits
+//      are done by polling, which is fine since it's only hit when there is
+//      actual contention.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TKrnlRWLock
+//  PREFIX: krwl
+// ---------------------------------------------------------------------------
+class KRNLEXPORT TKrnlRWLock
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Forward declare our internal platform structure
+        // -------------------------------------------------------------------
+        struct TPlatData;
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TKrnlRWLock();
+
+        TKrnlRWLock(const TKrnlRWLock&) = delete;
+        TKrnlRWLock(TKrnlRWLock&&) = delete;
+
+        ~TKrnlRWLock();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TKrnlRWLock& operator=(const TKrnlRWLock&) = delete;
+        TKrnlRWLock& operator=(TKrnlRWLock&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bLockExclusive
+        (
+            const   tCIDLib::TCard4         c4MilliSecs = kCIDLib::c4MaxWait
+        )   const;
+
+        tCIDLib::TBoolean bLockShared
+        (
+            const   tCIDLib::TCard4         c4MilliSecs = kCIDLib::c4MaxWait
+        )   const;
+
+        tCIDLib::TBoolean bUnlockExclusive() const;
+
+        tCIDLib::TBoolean bUnlockShared() const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_pPlatData
+        //      This is the per-platform data, which they define as desired.
+        // -------------------------------------------------------------------
+        TPlatData*  m_pPlatData;
+};
+
+#pragma CIDLIB_POPPACK
@@ -32,6 +32,7 @@
 //  Includes
 // ---------------------------------------------------------------------------
 #include    "CIDKernel_.hpp"
+#include    "CIDKernel_Hash64_.hpp"
 #include    <memory.h>
 
 
@@ -43,9 +44,13 @@ namespace
     namespace CIDKernel_RawMemory
     {
         // -----------------------------------------------------------------------
-        //  We fault in the CRC table for the 3309 CRC algorithm, upon first use
+        //  We fault in the CRC tables for the 3309 CRC algorithm, upon first use.
+        //  The first one is the standard byte at a time table. The others are
+        //  for the slice by 8 scheme, where entry [n][x] is the CRC of byte x
+        //  followed by n zero bytes. That lets us do 8 bytes per round with
+        //  independent lookups instead of a serial chain of 8.
         // -----------------------------------------------------------------------
-        tCIDLib::TCard4     ac43309Table[256];
+        tCIDLib::TCard4     ac43309Table[8][256];
         TAtomicFlag         atomInit;
     }
 }
@@ -110,6 +115,58 @@ TRawMem::eCompareMemBuf(const   tCIDLib::TVoid* const   p1
 }
 
 
+//
+//  The fast 64 bit hash, see CIDKernel_Hash64_.hpp. We take 32 bytes per round
+//  while we can. Words are loaded in little endian order, which is just a copy
+//  on little endian platforms. The copy gets turned into a plain (unaligned)
+//  load by the compiler.
+//
+tCIDLib::TCard8
+TRawMem::c8HashBuffer64(const   tCIDLib::TVoid* const   pBuf
+                        , const tCIDLib::TCard4         c4Bytes
+                        , const tCIDLib::TCard8         c8Seed) noexcept
+{
+    auto c8Load = [](const tCIDLib::TCard1* const pc1Src) -> tCIDLib::TCard8
+    {
+        #if defined(CIDLIB_LITTLEENDIAN)
+        tCIDLib::TCard8 c8Ret;
+        memcpy(&c8Ret, pc1Src, sizeof(c8Ret));
+        return c8Ret;
+        #else
+        tCIDLib::TCard8 c8Ret = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+            c8Ret |= tCIDLib::TCard8(pc1Src[c4Index]) << (c4Index * 8);
+        return c8Ret;
+        #endif
+    };
+
+    CIDKernel_Hash64::THash64Accum haccBuf(c8Seed);
+
+    const tCIDLib::TCard1* pc1Buf = reinterpret_cast<const tCIDLib::TCard1*>(pBuf);
+    tCIDLib::TCard4 c4Left = c4Bytes;
+    while (c4Left >= 32)
+    {
+        haccBuf.AddStripe
+        (
+            c8Load(pc1Buf), c8Load(pc1Buf + 8), c8Load(pc1Buf + 16), c8Load(pc1Buf + 24)
+        );
+        pc1Buf += 32;
+        c4Left -= 32;
+    }
+
+    // Get the remainder into zero padded words and finish up
+    tCIDLib::TCard8 ac8Left[4] = { 0, 0, 0, 0 };
+    tCIDLib::TCard4 c4Word = 0;
+    for (; (c4Word + 1) * 8 <= c4Left; c4Word++)
+        ac8Left[c4Word] = c8Load(pc1Buf + (c4Word * 8));
+
+    for (tCIDLib::TCard4 c4Index = c4Word * 8; c4Index < c4Left; c4Index++)
+        ac8Left[c4Word] |= tCIDLib::TCard8(pc1Buf[c4Index]) << ((c4Index & 7) * 8);
+
+    return haccBuf.c8Finish(ac8Left, c4Left);
+}
+
+
 //
 //  Do a standard CIDLib hahs on a buffer. This is the hash used internally
 //  by CIDLib classes that need to hash buffers for hashed collections and
@@ -188,7 +245,18 @@ TRawMem::hshHashBuffer3309( const   tCIDLib::THashVal       hshLast
                     else
                         c4Cur >>= 1;
                 }
-                CIDKernel_RawMemory::ac43309Table[c4EntryInd] = c4Cur;
+                CIDKernel_RawMemory::ac43309Table[0][c4EntryInd] = c4Cur;
+            }
+
+            // Build the slice tables from the base one
+            for (tCIDLib::TCard4 c4EntryInd = 0; c4EntryInd < 256; c4EntryInd++)
+            {
+                c4Cur = CIDKernel_RawMemory::ac43309Table[0][c4EntryInd];
+                for (tCIDLib::TCard4 c4Slice = 1; c4Slice < 8; c4Slice++)
+                {
+                    c4Cur = CIDKernel_RawMemory::ac43309Table[0][c4Cur & 0xFF] ^ (c4Cur >> 8);
+                    CIDKernel_RawMemory::ac43309Table[c4Slice][c4EntryInd] = c4Cur;
+                }
             }
 
             // And lastly indicate we've faulted it in
@@ -198,13 +266,42 @@ TRawMem::hshHashBuffer3309( const   tCIDLib::THashVal       hshLast
 
     // Get a byte based temp pointer that we can run upwards as we go
     const tCIDLib::TCard1* pc1Buf = reinterpret_cast<const tCIDLib::TCard1*>(pBuf);
+    const tCIDLib::TCard4 (&ac4Tbl)[8][256] = CIDKernel_RawMemory::ac43309Table;
 
-    // Get a copy of the last hash as a starting point
+    //
+    //  Get a copy of the last hash as a starting point. Do 8 bytes at a time
+    //  while we can. We build up the words from bytes explicitly so that this
+    //  doesn't care about alignment or endianness. The compiler will turn it
+    //  into simple loads where it can.
+    //
     tCIDLib::TCard4 c4Ret = hshLast;
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+    tCIDLib::TCard4 c4Left = c4Bytes;
+    while (c4Left >= 8)
+    {
+        const tCIDLib::TCard4 c4One = c4Ret
+        ^ (tCIDLib::TCard4(pc1Buf[0])
+        | (tCIDLib::TCard4(pc1Buf[1]) << 8)
+        | (tCIDLib::TCard4(pc1Buf[2]) << 16)
+        | (tCIDLib::TCard4(pc1Buf[3]) << 24));
+
+        c4Ret = ac4Tbl[7][c4One & 0xFF]
+                ^ ac4Tbl[6][(c4One >> 8) & 0xFF]
+                ^ ac4Tbl[5][(c4One >> 16) & 0xFF]
+                ^ ac4Tbl[4][c4One >> 24]
+                ^ ac4Tbl[3][pc1Buf[4]]
+                ^ ac4Tbl[2][pc1Buf[5]]
+                ^ ac4Tbl[1][pc1Buf[6]]
+                ^ ac4Tbl[0][pc1Buf[7]];
+
+        pc1Buf += 8;
+        c4Left -= 8;
+    }
+
+    // And do any trailing bytes one at a time
+    while (c4Left)
     {
-        c4Ret = CIDKernel_RawMemory::ac43309Table[(c4Ret ^ pc1Buf[c4Index]) & 0xFF]
-                ^ (c4Ret >> 8);
+        c4Ret = ac4Tbl[0][(c4Ret ^ *pc1Buf++) & 0xFF] ^ (c4Ret >> 8);
+        c4Left--;
     }
     return c4Ret;
 }
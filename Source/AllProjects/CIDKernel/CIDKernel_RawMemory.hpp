@@ -79,6 +79,24 @@ namespace TRawMem
         const   tCIDLib::TVoid* const   pBuf
     );
 
+    //
+    //  Unlike the compare/exchange and exchange calls, which are full fences,
+    //  these are just acquire reads and release writes. They are for lock free
+    //  code where a full fence on every read of a shared index would be too
+    //  much overhead.
+    //
+    KRNLEXPORT tCIDLib::TCard4 c4AcquireGet
+    (
+        const   tCIDLib::TCard4&        c4ToGet
+    )   noexcept;
+
+    //
+    //  Keeps reads after this call from being done before reads that come
+    //  before it. Seqlock readers need this between reading the protected data
+    //  and re-checking the sequence.
+    //
+    KRNLEXPORT tCIDLib::TVoid AcquireFence() noexcept;
+
     KRNLEXPORT tCIDLib::TCard4 c4CompareAndExchange
     (
                 tCIDLib::TCard4&        c4ToFill
@@ -102,6 +120,17 @@ namespace TRawMem
         const   tCIDLib::TCard4         c4Size
     );
 
+    //
+    //  Relaxed reads and writes, which are atomic but impose no ordering. These
+    //  are for values that other threads can look at while one thread changes
+    //  them, where only the value itself matters, such as an owner thread id or
+    //  a cached hash.
+    //
+    KRNLEXPORT tCIDLib::TCard4 c4RelaxedGet
+    (
+        const   tCIDLib::TCard4&        c4ToGet
+    )   noexcept;
+
     KRNLEXPORT tCIDLib::TCard4 c4SafeRefAcquire
     (
                 tCIDLib::TCard4&        c4Ref
@@ -157,6 +186,13 @@ namespace TRawMem
         , const tCIDLib::TCard4         c4Bytes
     );
 
+    KRNLEXPORT [[nodiscard]] tCIDLib::TCard8 c8HashBuffer64
+    (
+        const   tCIDLib::TVoid* const   pBuf
+        , const tCIDLib::TCard4         c4Bytes
+        , const tCIDLib::TCard8         c8Seed = 0
+    )   noexcept;
+
     KRNLEXPORT tCIDLib::THashVal hshHashBufferAdler32
     (
         const   tCIDLib::THashVal       hshAdler
@@ -222,6 +258,18 @@ namespace TRawMem
         ,       TSysMemInfo&            MemInfo
     );
 
+    KRNLEXPORT tCIDLib::TVoid ReleaseSet
+    (
+                tCIDLib::TCard4&        c4ToSet
+        , const tCIDLib::TCard4         c4New
+    )   noexcept;
+
+    KRNLEXPORT tCIDLib::TVoid RelaxedSet
+    (
+                tCIDLib::TCard4&        c4ToSet
+        , const tCIDLib::TCard4         c4New
+    )   noexcept;
+
     KRNLEXPORT tCIDLib::TVoid SetMemBuf
     (
                 tCIDLib::TVoid* const   pMemToFill
@@ -36,6 +36,7 @@
 //  Includes
 // ---------------------------------------------------------------------------
 #include    "CIDKernel_.hpp"
+#include    "CIDKernel_Hash64_.hpp"
 #include    "CIDKernel_PlatformStrOps.hpp"
 
 #include    <math.h>
@@ -844,6 +845,105 @@ static tCIDLib::TInt4 i4TextToCard8( const  tCIDLib::TCh* const pszSrcText
 //  TRawStr Methods
 // ---------------------------------------------------------------------------
 
+//
+//  Calculates the raw hash of a string, i.e. before it is reduced by any
+//  modulus, which is what allows callers to cache it and reduce it later via
+//  hshFromRawHash(). If not case sensitive, each char is lower cased (in the
+//  same way as pszLowerCase() does it) as it is hashed, so the result is the
+//  same as lower casing a copy and hashing that.
+//
+//  We return false if the source is null or badly formed.
+//
+tCIDLib::TBoolean
+TRawStr::bCalcRawHash(  const   tCIDLib::TCh* const pszSrc
+                        , COP   tCIDLib::TCard4&    c4ToFill
+                        , const tCIDLib::TBoolean   bCase) noexcept
+{
+    constexpr tCIDLib::TCard1 ac1FirstByteMark[7] =
+    {
+        0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC
+    };
+
+    c4ToFill = 0;
+    if (!pszSrc)
+        return kCIDLib::False;
+
+    // Start the value off as zero
+    tCIDLib::TCard4 c4Ret = 0;
+
+    //
+    //  In order to maintain platform independent, consistent hashes, we
+    //  will convert the string to UTF-8 form to hash it. We don't store any
+    //  conversion results, we just add each generated byte to the hash as
+    //  we generate it.
+    //
+    const tCIDLib::TCh* pchSrcPtr   = pszSrc;
+    const tCIDLib::TCh* pchSrcEnd   = pszSrc + c4StrLen(pszSrc);
+
+    while (pchSrcPtr < pchSrcEnd)
+    {
+        //
+        //  Get the next char out into a 32 bit value. If its a leading char,
+        //  get the trailing char and put that in. If the next char is not in
+        //  there, then we can't do anything but ignore the whole last char.
+        //
+        tCIDLib::TCard4 c4Val = bCase ? *pchSrcPtr : chLower(*pchSrcPtr);
+
+        tCIDLib::TCard4 c4SrcUsed = 1;
+        if ((c4Val >= 0xD800) && (c4Val <= 0xDBFF))
+        {
+            if (pchSrcPtr + 1 >= pchSrcEnd)
+                break;
+
+            // Create the composite surrogate pair
+            const tCIDLib::TCard4 c4Trail = bCase ? *(pchSrcPtr + 1)
+                                                  : chLower(*(pchSrcPtr + 1));
+            c4Val = ((c4Val - 0xD800) << 10) + ((c4Trail - 0xDC00) + 0x10000);
+            c4SrcUsed++;
+        }
+
+        // Figure out how many bytes we need
+        tCIDLib::TCard4 c4EncBytes;
+        if (c4Val < 0x80)
+            c4EncBytes = 1;
+        else if (c4Val < 0x800)
+            c4EncBytes = 2;
+        else if (c4Val < 0x10000)
+            c4EncBytes = 3;
+        else if (c4Val < 0x200000)
+            c4EncBytes = 4;
+        else if (c4Val < 0x4000000)
+            c4EncBytes = 5;
+        else if (c4Val <= 0x7FFFFFFF)
+            c4EncBytes = 6;
+        else
+            return kCIDLib::False;
+
+        // We can do it, so update the source index
+        pchSrcPtr += c4SrcUsed;
+
+        // And spit out the bytes
+        switch(c4EncBytes)
+        {
+            case 6 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
+                     c4Val >>= 6;
+            case 5 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
+                     c4Val >>= 6;
+            case 4 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
+                     c4Val >>= 6;
+            case 3 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
+                     c4Val >>= 6;
+            case 2 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
+                     c4Val >>= 6;
+            case 1 : c4Ret = c4AddToHash(c4Ret, c4Val | ac1FirstByteMark[c4EncBytes]);
+        }
+    }
+
+    c4ToFill = c4Ret;
+    return kCIDLib::True;
+}
+
+
 //
 //  Finds the body of the text, i.e. the part inside any leading and trailing
 //  text. If there is any, it returns true and sets c4Start to the first non-
@@ -1706,6 +1806,172 @@ TRawStr::c8AsBinary(const   tCIDLib::TCh* const pszToConvert
 }
 
 
+//
+//  The fast 64 bit string hash. To keep the results the same on all platforms,
+//  this is defined as c8HashBuffer64() of the text in UTF-16 (little endian)
+//  form. If that is what our chars already are, and no case folding is needed,
+//  we just pass the buffer through. Else we pack four UTF-16 code units per word
+//  on the fly, splitting any chars beyond the BMP into surrogate pairs.
+//
+//  If not case sensitive, chars are lower cased as we go, the same way that
+//  pszLowerCase() does it.
+//
+//  Unlike hshHashStr(), this never fails. Chars beyond the Unicode range are
+//  just folded in as is.
+//
+tCIDLib::TCard8
+TRawStr::c8HashStr64(const  tCIDLib::TCh* const pszSrc
+                    , const tCIDLib::TCard4     c4Len
+                    , const tCIDLib::TBoolean   bCase
+                    , const tCIDLib::TCard8     c8Seed) noexcept
+{
+    if (!pszSrc)
+        return TRawMem::c8HashBuffer64(nullptr, 0, c8Seed);
+
+    const tCIDLib::TCard4 c4Chars = (c4Len == kCIDLib::c4MaxCard) ? c4StrLen(pszSrc) : c4Len;
+
+    #if defined(CIDLIB_LITTLEENDIAN)
+    if constexpr (kCIDLib::c4CharBytes == 2)
+    {
+        if (bCase)
+            return TRawMem::c8HashBuffer64(pszSrc, c4Chars * 2, c8Seed);
+    }
+    #endif
+
+    CIDKernel_Hash64::THash64Accum haccStr(c8Seed);
+
+    //
+    //  The words of the current stripe, and the current word being built up
+    //  and how many bits of it are used.
+    //
+    tCIDLib::TCard8 ac8Stripe[4] = { 0, 0, 0, 0 };
+    tCIDLib::TCard4 c4StripeWords = 0;
+    tCIDLib::TCard8 c8Word = 0;
+    tCIDLib::TCard4 c4Shift = 0;
+
+    auto AddWord = [&](const tCIDLib::TCard8 c8ToAdd)
+    {
+        ac8Stripe[c4StripeWords++] = c8ToAdd;
+        if (c4StripeWords == 4)
+        {
+            haccStr.AddStripe(ac8Stripe[0], ac8Stripe[1], ac8Stripe[2], ac8Stripe[3]);
+            c4StripeWords = 0;
+        }
+    };
+
+    auto AddUnit = [&](const tCIDLib::TCard4 c4Unit)
+    {
+        c8Word |= tCIDLib::TCard8(c4Unit & 0xFFFF) << c4Shift;
+        c4Shift += 16;
+        if (c4Shift == 64)
+        {
+            AddWord(c8Word);
+            c8Word = 0;
+            c4Shift = 0;
+        }
+    };
+
+    //
+    //  Gets a run of chars out, lower casing if needed, and returns them all OR'd
+    //  together, so the caller can see if any need to be split. The case check is
+    //  kept out of the loop so that the case sensitive one is just loads.
+    //
+    auto c4GetChars = [bCase]( const    tCIDLib::TCh* const pchSrc
+                                ,       tCIDLib::TCard4* const pc4Out
+                                , const tCIDLib::TCard4     c4Count) -> tCIDLib::TCard4
+    {
+        tCIDLib::TCard4 c4Or = 0;
+        if (bCase)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                pc4Out[c4Index] = tCIDLib::TCard4(pchSrc[c4Index]);
+                c4Or |= pc4Out[c4Index];
+            }
+        }
+         else
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                pc4Out[c4Index] = tCIDLib::TCard4(chLower(pchSrc[c4Index]));
+                c4Or |= pc4Out[c4Index];
+            }
+        }
+        return c4Or;
+    };
+
+    // Packs four chars into a word, which the caller knows don't need splitting
+    auto c8Pack = [](const tCIDLib::TCard4* const pc4Chars) -> tCIDLib::TCard8
+    {
+        return tCIDLib::TCard8(pc4Chars[0])
+               | (tCIDLib::TCard8(pc4Chars[1]) << 16)
+               | (tCIDLib::TCard8(pc4Chars[2]) << 32)
+               | (tCIDLib::TCard8(pc4Chars[3]) << 48);
+    };
+
+    const tCIDLib::TCh* pchCur = pszSrc;
+    const tCIDLib::TCh* const pchEnd = pszSrc + c4Chars;
+    while (pchCur < pchEnd)
+    {
+        //
+        //  If we are on a stripe boundary and have a whole stripe's worth of
+        //  chars that don't need to be split, do them directly. This is almost
+        //  always the case.
+        //
+        if (!c4Shift && !c4StripeWords && (pchEnd - pchCur >= 16))
+        {
+            tCIDLib::TCard4 ac4Chars[16];
+            const tCIDLib::TCard4 c4Or = c4GetChars(pchCur, ac4Chars, 16);
+
+            if (!(c4Or & 0xFFFF0000))
+            {
+                haccStr.AddStripe
+                (
+                    c8Pack(ac4Chars)
+                    , c8Pack(ac4Chars + 4)
+                    , c8Pack(ac4Chars + 8)
+                    , c8Pack(ac4Chars + 12)
+                );
+                pchCur += 16;
+                continue;
+            }
+        }
+
+        // Else try a word's worth the same way
+        if (!c4Shift && (pchEnd - pchCur >= 4))
+        {
+            tCIDLib::TCard4 ac4Chars[4];
+            const tCIDLib::TCard4 c4Or = c4GetChars(pchCur, ac4Chars, 4);
+
+            if (!(c4Or & 0xFFFF0000))
+            {
+                AddWord(c8Pack(ac4Chars));
+                pchCur += 4;
+                continue;
+            }
+        }
+
+        // Do a single char, splitting it if needed
+        tCIDLib::TCard4 c4Val = tCIDLib::TCard4(bCase ? *pchCur : chLower(*pchCur));
+        pchCur++;
+        if (c4Val > 0xFFFF)
+        {
+            c4Val -= 0x10000;
+            AddUnit(0xD800 + ((c4Val >> 10) & 0x3FF));
+            AddUnit(0xDC00 + (c4Val & 0x3FF));
+        }
+         else
+        {
+            AddUnit(c4Val);
+        }
+    }
+
+    // Put any partial word in with the left over ones and finish up
+    if (c4Shift)
+        ac8Stripe[c4StripeWords] = c8Word;
+    return haccStr.c8Finish(ac8Stripe, (c4StripeWords * 8) + (c4Shift / 8));
+}
+
 tCIDLib::TCh TRawStr::chLower(const tCIDLib::TCh chToLower) noexcept
 {
     return CIDStrOp_ChToLower(chToLower);
@@ -2231,6 +2497,21 @@ TRawStr::FillString(        tCIDLib::TCh* const pszBuf
 }
 
 
+//
+//  Reduces a raw hash from bCalcRawHash() by the modulus. We never return zero
+//  as a hash.
+//
+tCIDLib::THashVal
+TRawStr::hshFromRawHash(const   tCIDLib::TCard4 c4RawHash
+                        , const tCIDLib::TCard4 c4Modulus) noexcept
+{
+    tCIDLib::TCard4 c4Ret = c4RawHash % c4Modulus;
+    if (!c4Ret)
+        c4Ret = 1;
+    return c4Ret;
+}
+
+
 //
 //  We will never return zero as a legal hash. So we return zero if the src
 //  string is badly formed, to indicate an error. It's the only error we can
@@ -2240,94 +2521,10 @@ tCIDLib::THashVal
 TRawStr::hshHashStr(const   tCIDLib::TCh* const pszSrc
                     , const tCIDLib::TCard4     c4Modulus) noexcept
 {
-    constexpr tCIDLib::TCard1 ac1FirstByteMark[7] =
-    {
-        0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC
-    };
-
-    // We just return zero for a null string
-    if (!pszSrc)
+    tCIDLib::TCard4 c4Raw;
+    if (!bCalcRawHash(pszSrc, c4Raw))
         return 0;
-
-    // Start the value off as zero
-    tCIDLib::TCard4 c4Ret = 0;
-
-    //
-    //  In order to maintain platform independent, consistent hashes, we
-    //  will convert the string to UTF-8 form to hash it. We don't store any
-    //  conversion results, we just add each generated byte to the hash as
-    //  we generate it.
-    //
-    const tCIDLib::TCh* pchSrcPtr   = pszSrc;
-    const tCIDLib::TCh* pchSrcEnd   = pszSrc + c4StrLen(pszSrc);
-
-    while (pchSrcPtr < pchSrcEnd)
-    {
-        //
-        //  Get the next char out into a 32 bit value. If its a leading char,
-        //  get the trailing char and put that in. If the next char is not in
-        //  there, then we can't do anything but ignore the whole last char.
-        //
-        tCIDLib::TCard4 c4Val = *pchSrcPtr;
-
-        tCIDLib::TCard4 c4SrcUsed = 1;
-        if ((c4Val >= 0xD800) && (c4Val <= 0xDBFF))
-        {
-            if (pchSrcPtr + 1 >= pchSrcEnd)
-                break;
-
-            // Create the composite surrogate pair
-            c4Val = ((c4Val - 0xD800) << 10)
-                    + ((*(pchSrcPtr + 1) - 0xDC00) + 0x10000);
-            c4SrcUsed++;
-        }
-
-        // Figure out how many bytes we need
-        tCIDLib::TCard4 c4EncBytes;
-        if (c4Val < 0x80)
-            c4EncBytes = 1;
-        else if (c4Val < 0x800)
-            c4EncBytes = 2;
-        else if (c4Val < 0x10000)
-            c4EncBytes = 3;
-        else if (c4Val < 0x200000)
-            c4EncBytes = 4;
-        else if (c4Val < 0x4000000)
-            c4EncBytes = 5;
-        else if (c4Val <= 0x7FFFFFFF)
-            c4EncBytes = 6;
-        else
-        {
-            // Return zero to indicate an error
-            return 0;
-        }
-
-        // We can do it, so update the source index
-        pchSrcPtr += c4SrcUsed;
-
-        // And spit out the bytes
-        switch(c4EncBytes)
-        {
-            case 6 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
-                     c4Val >>= 6;
-            case 5 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
-                     c4Val >>= 6;
-            case 4 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
-                     c4Val >>= 6;
-            case 3 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
-                     c4Val >>= 6;
-            case 2 : c4Ret = c4AddToHash(c4Ret, (c4Val | 0x80UL) & 0xBFUL);
-                     c4Val >>= 6;
-            case 1 : c4Ret = c4AddToHash(c4Ret, c4Val | ac1FirstByteMark[c4EncBytes]);
-        }
-    }
-
-    // If the hash is zero, set it to 1. We never return zero as a hash
-    c4Ret %= c4Modulus;
-    if (!c4Ret)
-        c4Ret = 1;
-
-    return c4Ret;
+    return hshFromRawHash(c4Raw, c4Modulus);
 }
 
 
@@ -33,6 +33,13 @@
 
 namespace TRawStr
 {
+    KRNLEXPORT [[nodiscard]] tCIDLib::TBoolean bCalcRawHash
+    (
+        const   tCIDLib::TCh* const     pszStr
+        , COP   tCIDLib::TCard4&        c4ToFill
+        , const tCIDLib::TBoolean       bCase = kCIDLib::True
+    )   noexcept;
+
     KRNLEXPORT tCIDLib::TBoolean bFindTextBody
     (
         const   tCIDLib::TCh* const     pszSrc
@@ -236,6 +243,14 @@ namespace TRawStr
         , const tCIDLib::ERadices       eRadix = tCIDLib::ERadices::Auto
     )   noexcept;
 
+    KRNLEXPORT [[nodiscard]] tCIDLib::TCard8 c8HashStr64
+    (
+        const   tCIDLib::TCh* const     pszStr
+        , const tCIDLib::TCard4         c4Len = kCIDLib::c4MaxCard
+        , const tCIDLib::TBoolean       bCase = kCIDLib::True
+        , const tCIDLib::TCard8         c8Seed = 0
+    )   noexcept;
+
     KRNLEXPORT [[nodiscard]] tCIDLib::TCh chLower
     (
         const   tCIDLib::TCh            chToTest
@@ -359,6 +374,12 @@ namespace TRawStr
         , const tCIDLib::TCard4         c4Count
     )   noexcept;
 
+    KRNLEXPORT [[nodiscard]] tCIDLib::THashVal hshFromRawHash
+    (
+        const   tCIDLib::TCard4         c4RawHash
+        , const tCIDLib::TCard4         c4Modulus
+    )   noexcept;
+
     KRNLEXPORT [[nodiscard]] tCIDLib::THashVal hshHashStr
     (
         const   tCIDLib::TCh* const     pszStr
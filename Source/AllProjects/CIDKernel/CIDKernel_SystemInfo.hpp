@@ -45,6 +45,11 @@ namespace TKrnlSysInfo
         ,       TKrnlString&            kstrToFill
     );
 
+    KRNLEXPORT tCIDLib::TBoolean bCPUHasFeatures
+    (
+        const   tCIDLib::ECPUFeatures   eToCheck
+    );
+
     KRNLEXPORT tCIDLib::TBoolean bIsHostAdmin();
 
     KRNLEXPORT tCIDLib::TBoolean bQueryAvailPhysicalMem
@@ -88,6 +93,8 @@ namespace TKrnlSysInfo
 
     KRNLEXPORT tCIDLib::TCard8 c8TotalPhysicalMem();
 
+    KRNLEXPORT tCIDLib::ECPUFeatures eCPUFeatures();
+
     KRNLEXPORT const tCIDLib::TCh* pszNodeName();
 
     KRNLEXPORT const tCIDLib::TCh* pszProcessName();
@@ -378,6 +378,22 @@ namespace tCIDLib
     };
 
 
+    // -----------------------------------------------------------------------
+    //  Optional CPU instruction set extensions that code can check for at
+    //  runtime before using a hardware accelerated path. These are bits, so
+    //  TKrnlSysInfo can return them all at once.
+    // -----------------------------------------------------------------------
+    enum class ECPUFeatures : tCIDLib::TCard4
+    {
+        None                = 0x0
+        , SSE41             = 0x00000001
+        , AESNI             = 0x00000002
+        , PCLMUL            = 0x00000004
+        , AVX2              = 0x00000008
+        , SHA               = 0x00000010
+    };
+
+
     // -----------------------------------------------------------------------
     //  The sides of a client/server connection
     // -----------------------------------------------------------------------
@@ -1194,12 +1210,17 @@ namespace tCIDLib
 
     // -----------------------------------------------------------------------
     //  The possible safe/unsafe states for anything that can be optionally
-    //  threadsafe.
+    //  threadsafe. SharedSafe is for read mostly collections, where read only
+    //  operations can be done in parallel. Things that don't support shared
+    //  locking just treat it like Safe. For SharedSafe, the const methods of the
+    //  elements and key ops that the collection calls must be safe to call from
+    //  more than one thread at once, i.e. they can't lazily fault in data.
     // -----------------------------------------------------------------------
     enum class EMTStates
     {
         Unsafe
         , Safe
+        , SharedSafe
     };
 
 
@@ -2827,6 +2848,7 @@ namespace tCIDCtrls
 //  have these available down here in the kernel.
 //
 BmpEnumTricks(tCIDLib::EAccessModes)
+BmpEnumTricks(tCIDLib::ECPUFeatures)
 BmpEnumTricks(tCIDLib::EDirChFilters)
 BmpEnumTricks(tCIDLib::EDirSearchFlags)
 BmpEnumTricks(tCIDLib::EExtProcFlags)
@@ -18,8 +18,16 @@
 //  This file provides the Linux specific implementation for the class
 //  TKrnlEvent.
 //
+//  Unnamed events are a single futex word, so triggering an event no one is
+//  waiting on, or waiting on one that is already triggered, never leaves user
+//  space. Named events have to be visible to other processes, so they are
+//  still System V semaphores.
+//
 // CAVEATS/GOTCHAS:
 //
+//  1)  There's no way to block on two futexes at once (on the kernels we have
+//      to support), so bWaitMultiple() waits on each in turn in short slices.
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -34,6 +42,188 @@
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDKernel_Event_Linux
+    {
+        // -----------------------------------------------------------------------
+        //  c4Triggered
+        //      The bit in the futex state word that indicates it's triggered.
+        //
+        //  c4PulseInc
+        //      The rest of the state is a pulse count, which is bumped by this
+        //      amount on each pulse of a manual event, so that waiters can see
+        //      they were released.
+        //
+        //  c4MultiSlice
+        //      The slice we wait on each event for in bWaitMultiple.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Triggered     = 0x1;
+        constexpr tCIDLib::TCard4   c4PulseInc      = 0x2;
+        constexpr tCIDLib::TCard4   c4MultiSlice    = 10;
+
+
+        // Allocate and initialize an event implementation
+        TEventHandleImpl* pheviMake(const   tCIDLib::EEventStates   eInitState
+                                    , const tCIDLib::TBoolean       bManual)
+        {
+            TEventHandleImpl* pheviNew = new TEventHandleImpl;
+            pheviNew->c4State = (eInitState == tCIDLib::EEventStates::Triggered) ? c4Triggered : 0;
+            pheviNew->c4Waiters = 0;
+            pheviNew->bManual = bManual;
+            pheviNew->iSysVSemId = -1;
+            pheviNew->bSysVOwner = kCIDLib::False;
+            pheviNew->c4RefCount = 1;
+            return pheviNew;
+        }
+
+
+        // Wake up waiters if there are any
+        tCIDLib::TVoid WakeWaiters(TEventHandleImpl& heviTar)
+        {
+            if (__atomic_load_n(&heviTar.c4Waiters, __ATOMIC_SEQ_CST))
+            {
+                if (heviTar.bManual)
+                    TKrnlLinux::FutexWakeAll(heviTar.c4State);
+                else
+                    TKrnlLinux::FutexWakeOne(heviTar.c4State);
+            }
+        }
+
+
+        //
+        //  Wait for an unnamed event. If it's already triggered, we never go to
+        //  the kernel. For auto-reset events, the thread that gets through resets
+        //  it. For manual events, if the pulse count changes while we wait, we were
+        //  pulsed, so we are released. Auto-reset events are pulsed by triggering
+        //  them, so only the one waiter that resets it gets through.
+        //
+        tCIDLib::TBoolean bFutexWait(TEventHandleImpl& heviWait, const tCIDLib::TCard4 c4Wait)
+        {
+            tCIDLib::TCard4 c4Cur = __atomic_load_n(&heviWait.c4State, __ATOMIC_ACQUIRE);
+            const tCIDLib::TCard4 c4Pulse = c4Cur & ~c4Triggered;
+
+            tCIDLib::TCard8 c8End = 0;
+            if (c4Wait != kCIDLib::c4MaxWait)
+                c8End = TKrnlLinux::c8MonoMillis() + c4Wait;
+
+            while (kCIDLib::True)
+            {
+                if (c4Cur & c4Triggered)
+                {
+                    if (heviWait.bManual)
+                        return kCIDLib::True;
+
+                    // If this fails, it updates c4Cur and we go around again
+                    if (__atomic_compare_exchange_n(&heviWait.c4State
+                                                    , &c4Cur
+                                                    , c4Cur & ~c4Triggered
+                                                    , false
+                                                    , __ATOMIC_ACQ_REL
+                                                    , __ATOMIC_ACQUIRE))
+                    {
+                        return kCIDLib::True;
+                    }
+                    continue;
+                }
+
+                //
+                //  Check for a timeout before the pulse count, so a pulse that
+                //  comes after we have timed out doesn't release us.
+                //
+                tCIDLib::TCard4 c4ThisWait = kCIDLib::c4MaxWait;
+                if (c4Wait != kCIDLib::c4MaxWait)
+                {
+                    const tCIDLib::TCard8 c8Now = TKrnlLinux::c8MonoMillis();
+                    if (c8Now >= c8End)
+                    {
+                        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+                        return kCIDLib::False;
+                    }
+                    c4ThisWait = tCIDLib::TCard4(c8End - c8Now);
+                }
+
+                if (heviWait.bManual && ((c4Cur & ~c4Triggered) != c4Pulse))
+                    return kCIDLib::True;
+
+                //
+                //  The waiter count has to be bumped before the futex checks the
+                //  state, so a trigger either sees us or we see its change.
+                //
+                __atomic_add_fetch(&heviWait.c4Waiters, 1, __ATOMIC_SEQ_CST);
+                const tCIDLib::TBoolean bRes = TKrnlLinux::bFutexWait
+                (
+                    heviWait.c4State, c4Cur, c4ThisWait
+                );
+                __atomic_sub_fetch(&heviWait.c4Waiters, 1, __ATOMIC_SEQ_CST);
+
+                //
+                //  Timeouts get caught at the top, anything else is an error. If
+                //  we were woken up spuriously or interrupted, we just go around
+                //  again, so only a trigger or a (manual) pulse releases us.
+                //
+                if (!bRes && (TKrnlError::kerrLast().errcId() != kKrnlErrs::errcGen_Timeout))
+                    return kCIDLib::False;
+
+                c4Cur = __atomic_load_n(&heviWait.c4State, __ATOMIC_ACQUIRE);
+            }
+            return kCIDLib::False;
+        }
+
+
+        // Set the value of a named event's semaphore. 1 is reset, 0 is triggered
+        tCIDLib::TBoolean bSetSemVal(const tCIDLib::TSInt iSemId, const tCIDLib::TSInt iVal)
+        {
+            union semun SemUnion;
+            SemUnion.val = iVal;
+            if (::semctl(iSemId, 0, SETVAL, SemUnion))
+            {
+                TKrnlError::SetLastHostError(errno);
+                return kCIDLib::False;
+            }
+            return kCIDLib::True;
+        }
+
+
+        // Wait for a named event's semaphore to go to zero
+        tCIDLib::TBoolean bSysVWait(const tCIDLib::TSInt iSemId, const tCIDLib::TCard4 c4Wait)
+        {
+            struct sembuf SemBuf;
+            SemBuf.sem_num = 0;
+            SemBuf.sem_op = 0;
+            SemBuf.sem_flg = 0;
+
+            if (c4Wait == kCIDLib::c4MaxWait)
+            {
+                if (::semop(iSemId, &SemBuf, 1))
+                {
+                    TKrnlError::SetLastHostError(errno);
+                    return kCIDLib::False;
+                }
+                return kCIDLib::True;
+            }
+
+            timespec tsWait;
+            tsWait.tv_sec = c4Wait / 1000;
+            tsWait.tv_nsec = (c4Wait % 1000) * 1000000;
+            if (::semtimedop(iSemId, &SemBuf, 1, &tsWait))
+            {
+                if (errno == EAGAIN)
+                    TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+                else
+                    TKrnlError::SetLastHostError(errno);
+                return kCIDLib::False;
+            }
+            return kCIDLib::True;
+        }
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TEventHandle
 //  PREFIX: hev
@@ -113,36 +303,95 @@ TEventHandle::FormatToStr(          tCIDLib::TCh* const pszToFill
 
 
 
+// ---------------------------------------------------------------------------
+//  Define our implementation of the event data
+// ---------------------------------------------------------------------------
+struct TKrnlEvent::TEventData
+{
+    TEventHandleImpl*   m_pheviThis;
+};
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TKrnlEvent
 //  PREFIX: kev
 // ---------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------
+//  TKrnlEvent: Public, static methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+TKrnlEvent::bWaitMultiple(          TKrnlEvent&         kevOne
+                            ,       TKrnlEvent&         kevTwo
+                            ,       tCIDLib::TCard4&    c4Which
+                            , const tCIDLib::TCard4     c4Wait)
+{
+    tCIDLib::TCard8 c8End = 0;
+    if (c4Wait != kCIDLib::c4MaxWait)
+        c8End = TKrnlLinux::c8MonoMillis() + c4Wait;
+
+    TKrnlEvent* apkevWait[2] = { &kevOne, &kevTwo };
+    while (kCIDLib::True)
+    {
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 2; c4Index++)
+        {
+            tCIDLib::TCard4 c4Slice = CIDKernel_Event_Linux::c4MultiSlice;
+            if (c4Wait != kCIDLib::c4MaxWait)
+            {
+                const tCIDLib::TCard8 c8Now = TKrnlLinux::c8MonoMillis();
+                if (c8Now >= c8End)
+                {
+                    TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+                    return kCIDLib::False;
+                }
+
+                if (c8End - c8Now < c4Slice)
+                    c4Slice = tCIDLib::TCard4(c8End - c8Now);
+            }
+
+            if (apkevWait[c4Index]->bWaitFor(c4Slice))
+            {
+                c4Which = c4Index;
+                return kCIDLib::True;
+            }
+
+            if (TKrnlError::kerrLast().errcId() != kKrnlErrs::errcGen_Timeout)
+                return kCIDLib::False;
+        }
+    }
+    return kCIDLib::False;
+}
+
+
 // ---------------------------------------------------------------------------
 //  TKrnlEvent: Constructors and Destructor
 // ---------------------------------------------------------------------------
 TKrnlEvent::TKrnlEvent() :
 
-    m_pszName(nullptr)
+    m_pData(new TEventData{nullptr})
+    , m_pszName(nullptr)
 {
 }
 
 TKrnlEvent::TKrnlEvent(const tCIDLib::TCh* const pszName) :
 
-    m_pszName(nullptr)
+    m_pData(new TEventData{nullptr})
+    , m_pszName(nullptr)
 {
     if (pszName)
         m_pszName = TRawStr::pszReplicate(pszName);
 }
 
-TKrnlEvent::~TKrnlEvent()
+TKrnlEvent::TKrnlEvent(TKrnlEvent&& kevSrc) :
+
+    TKrnlEvent()
 {
-    if (m_pszName)
-    {
-        delete [] m_pszName;
-        m_pszName = nullptr;
-    }
+    *this = tCIDLib::ForceMove(kevSrc);
+}
 
+TKrnlEvent::~TKrnlEvent()
+{
     if (!bClose())
     {
         //
@@ -159,68 +408,56 @@ TKrnlEvent::~TKrnlEvent()
         );
         #endif
     }
+
+    if (m_pszName)
+    {
+        delete [] m_pszName;
+        m_pszName = nullptr;
+    }
+
+    delete m_pData;
 }
 
 
 // ---------------------------------------------------------------------------
-//  TKrnlEvent: Public, non-virtual methods
+//  TKrnlEvent: Public operators
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TKrnlEvent::bClose()
+TKrnlEvent& TKrnlEvent::operator=(TKrnlEvent&& kevSrc)
 {
-    if (m_hevThis.bIsValid())
+    if (this != &kevSrc)
     {
-        ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
+        tCIDLib::Swap(m_pszName, kevSrc.m_pszName);
+        tCIDLib::Swap(m_pData, kevSrc.m_pData);
+    }
+    return *this;
+}
 
-        tCIDLib::TOSErrCode HostErr;
-        if (!--m_hevThis.m_pheviThis->c4RefCount)
-        {
-            if(m_hevThis.m_pheviThis->iSysVSemId != -1)
-            {
-                if (m_hevThis.m_pheviThis->bSysVOwner)
-                {
-                    union semun SemUnion;
-                    SemUnion.val = 0;
 
-                    if (::semctl(m_hevThis.m_pheviThis->iSysVSemId
-                                 , 0
-                                 , IPC_RMID
-                                 , SemUnion))
-                    {
-                        m_hevThis.m_pheviThis->c4RefCount++;
-                        ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
-                        TKrnlError::SetLastHostError(errno);
-                        return kCIDLib::False;
-                    }
-                }
-            }
-            else
-            {
-                HostErr = ::pthread_cond_destroy(&m_hevThis.m_pheviThis->condThis);
-                if (HostErr)
-                {
-                    TKrnlError::SetLastHostError(HostErr);
-                    return kCIDLib::False;
-                }
-            }
+// ---------------------------------------------------------------------------
+//  TKrnlEvent: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TKrnlEvent::bClose()
+{
+    TEventHandleImpl* pheviClose = m_pData->m_pheviThis;
+    if (!pheviClose)
+        return kCIDLib::True;
 
-            ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
-            HostErr = ::pthread_mutex_destroy(&m_hevThis.m_pheviThis->mtxThis);
-            if (HostErr)
+    if (!__atomic_sub_fetch(&pheviClose->c4RefCount, 1, __ATOMIC_ACQ_REL))
+    {
+        if ((pheviClose->iSysVSemId != -1) && pheviClose->bSysVOwner)
+        {
+            union semun SemUnion;
+            SemUnion.val = 0;
+            if (::semctl(pheviClose->iSysVSemId, 0, IPC_RMID, SemUnion))
             {
-                TKrnlError::SetLastHostError(HostErr);
+                __atomic_add_fetch(&pheviClose->c4RefCount, 1, __ATOMIC_ACQ_REL);
+                TKrnlError::SetLastHostError(errno);
                 return kCIDLib::False;
             }
-
-            delete m_hevThis.m_pheviThis;
-        }
-        else
-        {
-            ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
         }
-
-        m_hevThis.m_pheviThis = nullptr;
+        delete pheviClose;
     }
-
+    m_pData->m_pheviThis = nullptr;
     return kCIDLib::True;
 }
 
@@ -228,7 +465,7 @@ tCIDLib::TBoolean TKrnlEvent::bClose()
 tCIDLib::TBoolean
 TKrnlEvent::bCreate(const tCIDLib::EEventStates eInitState, const tCIDLib::TBoolean bManual)
 {
-    if (m_hevThis.bIsValid())
+    if (bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_AlreadyOpen);
         return kCIDLib::False;
@@ -240,48 +477,11 @@ TKrnlEvent::bCreate(const tCIDLib::EEventStates eInitState, const tCIDLib::TBool
         return bCreateNamed(eInitState, kCIDLib::True, bManual, bCreated);
     }
 
-    m_hevThis.m_pheviThis = new TEventHandleImpl;
-    m_hevThis.m_pheviThis->c4RefCount = 1;
-    m_hevThis.m_pheviThis->iSysVSemId = -1;
-    m_hevThis.m_pheviThis->bSet = (eInitState == tCIDLib::EEventStates::Reset);
-
-    ::pthread_mutex_init(&m_hevThis.m_pheviThis->mtxThis, 0);
-
-    tCIDLib::TSInt iErr = ::pthread_cond_init(&m_hevThis.m_pheviThis->condThis, 0);
-    if (iErr)
-    {
-        ::pthread_mutex_destroy(&m_hevThis.m_pheviThis->mtxThis);
-        delete m_hevThis.m_pheviThis;
-        m_hevThis.m_pheviThis = nullptr;
-        TKrnlError::SetLastHostError(iErr);
-        return kCIDLib::False;
-    }
-
+    m_pData->m_pheviThis = CIDKernel_Event_Linux::pheviMake(eInitState, bManual);
     return kCIDLib::True;
 }
 
 
-tCIDLib::TBoolean
-TKrnlEvent::bOpenOrCreate(  const   tCIDLib::EEventStates   eInitState
-                            , const tCIDLib::TBoolean       bManual
-                            ,       tCIDLib::TBoolean&      bCreated)
-{
-    if (m_hevThis.bIsValid())
-    {
-        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_AlreadyOpen);
-        return kCIDLib::False;
-    }
-
-    if (!m_pszName)
-    {
-        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NullName);
-        return kCIDLib::False;
-    }
-
-    return bCreateNamed(eInitState, kCIDLib::False, bManual, bCreated);
-}
-
-
 tCIDLib::TBoolean TKrnlEvent::bDuplicate(const TKrnlEvent& kevToDup)
 {
     if (!bClose())
@@ -295,22 +495,24 @@ tCIDLib::TBoolean TKrnlEvent::bDuplicate(const TKrnlEvent& kevToDup)
     if (kevToDup.m_pszName)
         m_pszName = TRawStr::pszReplicate(kevToDup.m_pszName);
 
-    // Duplicate the handle
-    m_hevThis = kevToDup.m_hevThis;
-    if (m_hevThis.bIsValid())
-    {
-        ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
-        m_hevThis.m_pheviThis->c4RefCount++;
-        ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
-    }
+    // Duplicate the handle, which just means adding a reference
+    m_pData->m_pheviThis = kevToDup.m_pData->m_pheviThis;
+    if (m_pData->m_pheviThis)
+        __atomic_add_fetch(&m_pData->m_pheviThis->c4RefCount, 1, __ATOMIC_ACQ_REL);
 
     return kCIDLib::True;
 }
 
 
+tCIDLib::TBoolean TKrnlEvent::bIsValid() const noexcept
+{
+    return (m_pData->m_pheviThis != nullptr);
+}
+
+
 tCIDLib::TBoolean TKrnlEvent::bOpen()
 {
-    if (m_hevThis.bIsValid())
+    if (bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_AlreadyOpen);
         return kCIDLib::False;
@@ -322,68 +524,112 @@ tCIDLib::TBoolean TKrnlEvent::bOpen()
         return kCIDLib::False;
     }
 
-    m_hevThis.m_pheviThis = new TEventHandleImpl;
-    m_hevThis.m_pheviThis->c4RefCount = 1;
-
     tCIDLib::TSInt iFlags = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
     key_t key = TRawStr::hshHashStr(m_pszName, kCIDLib::i4MaxInt);
 
     tCIDLib::TSInt iTmp = ::semget(key, 0, iFlags);
     if (iTmp == -1)
     {
-        delete m_hevThis.m_pheviThis;
-        m_hevThis.m_pheviThis = 0;
         TKrnlError::SetLastHostError(errno);
         return kCIDLib::False;
     }
 
-    ::pthread_mutex_init(&m_hevThis.m_pheviThis->mtxThis, 0);
-
-    m_hevThis.m_pheviThis->iSysVSemId = iTmp;
-    m_hevThis.m_pheviThis->bSysVOwner = kCIDLib::False;
+    m_pData->m_pheviThis = CIDKernel_Event_Linux::pheviMake
+    (
+        tCIDLib::EEventStates::Reset, kCIDLib::True
+    );
+    m_pData->m_pheviThis->iSysVSemId = iTmp;
+    m_pData->m_pheviThis->bSysVOwner = kCIDLib::False;
 
     return kCIDLib::True;
 }
 
 
-tCIDLib::TBoolean TKrnlEvent::bReset()
+tCIDLib::TBoolean
+TKrnlEvent::bOpenOrCreate(  const   tCIDLib::EEventStates   eInitState
+                            , const tCIDLib::TBoolean       bManual
+                            ,       tCIDLib::TBoolean&      bCreated)
 {
-    if (!m_hevThis.bIsValid())
+    if (bIsValid())
     {
-        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
+        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_AlreadyOpen);
         return kCIDLib::False;
     }
 
-    if (m_hevThis.m_pheviThis->iSysVSemId != -1)
+    if (!m_pszName)
     {
-        union semun SemUnion;
-        SemUnion.val = 1;
+        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NullName);
+        return kCIDLib::False;
+    }
 
-        if (::semctl(m_hevThis.m_pheviThis->iSysVSemId
-                     , 0
-                     , SETVAL
-                     , SemUnion))
-        {
-            TKrnlError::SetLastHostError(errno);
+    return bCreateNamed(eInitState, kCIDLib::False, bManual, bCreated);
+}
+
+
+//
+//  Release any waiting threads (one for auto-reset events) and leave it reset. For
+//  named events we have to briefly set it and then reset it again.
+//
+//  For manual events we bump the pulse count, which releases everyone waiting
+//  at the time. For auto-reset events, only one waiter can go, so if there are
+//  any we trigger it and wake one up, and the waiter that gets through resets it.
+//  If there are none, it's just left reset.
+//
+tCIDLib::TBoolean TKrnlEvent::bPulse()
+{
+    if (!bIsValid())
+    {
+        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
+        return kCIDLib::False;
+    }
+
+    TEventHandleImpl& heviThis = *m_pData->m_pheviThis;
+    if (heviThis.iSysVSemId != -1)
+    {
+        if (!CIDKernel_Event_Linux::bSetSemVal(heviThis.iSysVSemId, 0))
             return kCIDLib::False;
-        }
+        return CIDKernel_Event_Linux::bSetSemVal(heviThis.iSysVSemId, 1);
     }
-    else
+
+    if (heviThis.bManual)
+    {
+        __atomic_fetch_and(&heviThis.c4State, ~CIDKernel_Event_Linux::c4Triggered, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&heviThis.c4State, CIDKernel_Event_Linux::c4PulseInc, __ATOMIC_SEQ_CST);
+        CIDKernel_Event_Linux::WakeWaiters(heviThis);
+    }
+     else if (__atomic_load_n(&heviThis.c4Waiters, __ATOMIC_SEQ_CST))
+    {
+        __atomic_fetch_or(&heviThis.c4State, CIDKernel_Event_Linux::c4Triggered, __ATOMIC_SEQ_CST);
+        TKrnlLinux::FutexWakeOne(heviThis.c4State);
+    }
+     else
     {
-        ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
+        __atomic_fetch_and(&heviThis.c4State, ~CIDKernel_Event_Linux::c4Triggered, __ATOMIC_SEQ_CST);
+    }
+    return kCIDLib::True;
+}
 
-        m_hevThis.m_pheviThis->bSet = kCIDLib::True;
 
-        ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
+tCIDLib::TBoolean TKrnlEvent::bReset()
+{
+    if (!bIsValid())
+    {
+        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
+        return kCIDLib::False;
     }
 
+    TEventHandleImpl& heviThis = *m_pData->m_pheviThis;
+    if (heviThis.iSysVSemId != -1)
+        return CIDKernel_Event_Linux::bSetSemVal(heviThis.iSysVSemId, 1);
+
+    __atomic_fetch_and(&heviThis.c4State, ~CIDKernel_Event_Linux::c4Triggered, __ATOMIC_ACQ_REL);
     return kCIDLib::True;
 }
 
 
 tCIDLib::TBoolean TKrnlEvent::bSetName(const tCIDLib::TCh* const pszName)
 {
-    if (m_hevThis.bIsValid())
+    if (bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_AlreadyOpen);
         return kCIDLib::False;
@@ -404,138 +650,49 @@ tCIDLib::TBoolean TKrnlEvent::bSetName(const tCIDLib::TCh* const pszName)
 
 tCIDLib::TBoolean TKrnlEvent::bTrigger()
 {
-    if (!m_hevThis.bIsValid())
+    if (!bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
         return kCIDLib::False;
     }
 
-    if (m_hevThis.m_pheviThis->iSysVSemId != -1)
-    {
-        union semun SemUnion;
-        SemUnion.val = 0;
-
-        if (::semctl(m_hevThis.m_pheviThis->iSysVSemId
-                     , 0
-                     , SETVAL
-                     , SemUnion))
-        {
-            TKrnlError::SetLastHostError(errno);
-            return kCIDLib::False;
-        }
-    }
-    else
-    {
-        ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
-
-        m_hevThis.m_pheviThis->bSet = kCIDLib::False;
-        ::pthread_cond_broadcast(&m_hevThis.m_pheviThis->condThis);
-
-        ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
-    }
+    TEventHandleImpl& heviThis = *m_pData->m_pheviThis;
+    if (heviThis.iSysVSemId != -1)
+        return CIDKernel_Event_Linux::bSetSemVal(heviThis.iSysVSemId, 0);
 
+    // If it was already triggered, nobody can be waiting on it
+    const tCIDLib::TCard4 c4Old = __atomic_fetch_or
+    (
+        &heviThis.c4State, CIDKernel_Event_Linux::c4Triggered, __ATOMIC_SEQ_CST
+    );
+    if (!(c4Old & CIDKernel_Event_Linux::c4Triggered))
+        CIDKernel_Event_Linux::WakeWaiters(heviThis);
     return kCIDLib::True;
 }
 
 
 tCIDLib::TBoolean TKrnlEvent::bWaitFor(const tCIDLib::TCard4 c4Wait)
 {
-    if (!m_hevThis.bIsValid())
+    if (!bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
         return kCIDLib::False;
     }
 
-    if (c4Wait == kCIDLib::c4MaxWait)
-    {
-        if (m_hevThis.m_pheviThis->iSysVSemId != -1)
-        {
-            struct sembuf SemBuf;
-            SemBuf.sem_num = 0;
-            SemBuf.sem_op = 0;
-            SemBuf.sem_flg = 0;
-
-            if (::semop(m_hevThis.m_pheviThis->iSysVSemId
-                        , &SemBuf
-                        , 1))
-            {
-                TKrnlError::SetLastHostError(errno);
-                return kCIDLib::False;
-            }
-        }
-        else
-        {
-            ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
-
-            tCIDLib::TOSErrCode HostErr = 0;
-            while (m_hevThis.m_pheviThis->bSet && !HostErr)
-            {
-                HostErr = ::pthread_cond_wait(&m_hevThis.m_pheviThis->condThis
-                                              , &m_hevThis.m_pheviThis->mtxThis);
-            }
-
-            ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
-
-            if (HostErr)
-            {
-                TKrnlError::SetLastHostError(HostErr);
-                return kCIDLib::False;
-            }
-
-        }
-    }
-    else
-    {
-        if (m_hevThis.m_pheviThis->iSysVSemId != -1)
-        {
-            TKrnlLinux::TThreadTimer thtWaitFor(c4Wait);
-
-            struct sembuf SemBuf;
-            SemBuf.sem_num = 0;
-            SemBuf.sem_op = 0;
-            SemBuf.sem_flg = 0;
-
-            if (!thtWaitFor.bBegin())
-                return kCIDLib::False;
-
-            if (::semop(m_hevThis.m_pheviThis->iSysVSemId
-                        , &SemBuf
-                        , 1))
-            {
-                if (errno == EINTR)
-                    TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
-                else
-                    TKrnlError::SetLastHostError(errno);
-                return kCIDLib::False;
-            }
-        }
-        else
-        {
-            struct timespec TimeSpec;
-            TimeSpec.tv_sec = ::time(0) + (c4Wait / 1000);
-            TimeSpec.tv_nsec = (c4Wait % 1000) * 1000000;
-
-            ::pthread_mutex_lock(&m_hevThis.m_pheviThis->mtxThis);
-
-            tCIDLib::TOSErrCode HostErr = 0;
-            while (m_hevThis.m_pheviThis->bSet && !HostErr)
-            {
-                HostErr = ::pthread_cond_timedwait(&m_hevThis.m_pheviThis->condThis
-                                                   , &m_hevThis.m_pheviThis->mtxThis
-                                                   , &TimeSpec);
-            }
-
-            ::pthread_mutex_unlock(&m_hevThis.m_pheviThis->mtxThis);
+    TEventHandleImpl& heviThis = *m_pData->m_pheviThis;
+    if (heviThis.iSysVSemId != -1)
+        return CIDKernel_Event_Linux::bSysVWait(heviThis.iSysVSemId, c4Wait);
+    return CIDKernel_Event_Linux::bFutexWait(heviThis, c4Wait);
+}
 
-            if (HostErr)
-            {
-                TKrnlError::SetLastHostError(HostErr);
-                return kCIDLib::False;
-            }
-        }
-    }
 
-    return kCIDLib::True;
+//
+//  Provide access to our handle, which must be done generically. It should only be
+//  accessed by other platform code that knows what it is.
+//
+tCIDLib::TVoid* TKrnlEvent::pHandle() const
+{
+    return m_pData->m_pheviThis;
 }
 
 
@@ -544,20 +701,9 @@ tCIDLib::TBoolean TKrnlEvent::bWaitFor(const tCIDLib::TCard4 c4Wait)
 // ---------------------------------------------------------------------------
 
 //
-// FUNCTION/METHOD NAME: bCreateNamed
-//
-// DESCRIPTION:
-//
-//  These guys will create mutex, using the different rules that named
-//  resources require.
-// -------------------------------------
-//   INPUT: eInitState indicates the initial lock state.
-//          bFailIfExists indicates whether this is a create operation
-//              or a create w/ optional open.
-//
-//  OUTPUT: None
-//
-//  RETURN: kCIDLib::True if successful, else kCIDLib::False.
+//  Named events have to be visible to other processes, so they are System V
+//  semaphores. A value of 1 means reset (waiters block) and 0 means triggered,
+//  since we wait for zero.
 //
 tCIDLib::TBoolean
 TKrnlEvent::bCreateNamed(const  tCIDLib::EEventStates eInitState
@@ -602,12 +748,11 @@ TKrnlEvent::bCreateNamed(const  tCIDLib::EEventStates eInitState
     {
         bOwner = kCIDLib::True;
 
-        union semun SemUnion;
-        SemUnion.val = eInitState == tCIDLib::EEventStates::Reset ? 1 : 0;
-
-        if (::semctl(iTmp, 0, SETVAL, SemUnion))
+        const tCIDLib::TSInt iInitVal = (eInitState == tCIDLib::EEventStates::Reset) ? 1 : 0;
+        if (!CIDKernel_Event_Linux::bSetSemVal(iTmp, iInitVal))
         {
-            TKrnlError::SetLastHostError(errno);
+            union semun SemUnion;
+            SemUnion.val = 0;
             ::semctl(iTmp, 0, IPC_RMID, SemUnion);
             return kCIDLib::False;
         }
@@ -616,13 +761,9 @@ TKrnlEvent::bCreateNamed(const  tCIDLib::EEventStates eInitState
         bCreated = kCIDLib::True;
     }
 
-    m_hevThis.m_pheviThis = new TEventHandleImpl;
-    m_hevThis.m_pheviThis->c4RefCount = 1;
-    m_hevThis.m_pheviThis->iSysVSemId = iTmp;
-    m_hevThis.m_pheviThis->bSysVOwner = bOwner;
-    m_hevThis.m_pheviThis->bSet = (eInitState == tCIDLib::EEventStates::Reset);
-
-    ::pthread_mutex_init(&m_hevThis.m_pheviThis->mtxThis, 0);
+    m_pData->m_pheviThis = CIDKernel_Event_Linux::pheviMake(eInitState, bManual);
+    m_pData->m_pheviThis->iSysVSemId = iTmp;
+    m_pData->m_pheviThis->bSysVOwner = bOwner;
 
     return kCIDLib::True;
 }
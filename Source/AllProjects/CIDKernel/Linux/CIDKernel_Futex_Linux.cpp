@@ -0,0 +1,116 @@
+//
+// FILE NAME: CIDKernel_Futex_Linux.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file provides the TKrnlLinux futex helpers, which are a thin wrapper
+//  around the futex system call. The Linux events and mutexes are built on
+//  them. We use the
+//  private versions since these are never shared across processes, which lets
+//  the kernel skip some work.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "CIDKernel_.hpp"
+#include    "CIDKernel_InternalHelpers_.hpp"
+#include    <linux/futex.h>
+#include    <sys/syscall.h>
+
+
+
+// ---------------------------------------------------------------------------
+//  Local functions
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDKernel_Futex_Linux
+    {
+        // There's no glibc wrapper for this, so we have to do the raw syscall
+        inline long lFutex(         tCIDLib::TCard4* const  pc4Word
+                            , const int                     iOp
+                            , const tCIDLib::TCard4         c4Val
+                            , const timespec* const         pTimeout)
+        {
+            return ::syscall(SYS_futex, pc4Word, iOp, c4Val, pTimeout, nullptr, 0);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TKrnlLinux futex functions
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+TKrnlLinux::bFutexWait(const   tCIDLib::TCard4&    c4Word
+                        , const tCIDLib::TCard4     c4Expected
+                        , const tCIDLib::TCard4     c4MilliSecs)
+{
+    // The futex wait timeout is relative, so we can just convert it
+    timespec tsWait;
+    timespec* ptsWait = nullptr;
+    if (c4MilliSecs != kCIDLib::c4MaxWait)
+    {
+        tsWait.tv_sec = c4MilliSecs / 1000;
+        tsWait.tv_nsec = (c4MilliSecs % 1000) * 1000000;
+        ptsWait = &tsWait;
+    }
+
+    const long lRes = CIDKernel_Futex_Linux::lFutex
+    (
+        const_cast<tCIDLib::TCard4*>(&c4Word), FUTEX_WAIT_PRIVATE, c4Expected, ptsWait
+    );
+
+    //
+    //  If the value wasn't the expected value (EAGAIN) or we were interrupted by
+    //  a signal, just return True so that the caller checks again.
+    //
+    if (lRes == -1)
+    {
+        if (errno == ETIMEDOUT)
+        {
+            TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+            return kCIDLib::False;
+        }
+
+        if ((errno != EAGAIN) && (errno != EINTR))
+        {
+            TKrnlError::SetLastHostError(errno);
+            return kCIDLib::False;
+        }
+    }
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TKrnlLinux::FutexWakeAll(tCIDLib::TCard4& c4Word)
+{
+    CIDKernel_Futex_Linux::lFutex(&c4Word, FUTEX_WAKE_PRIVATE, kCIDLib::i4MaxInt, nullptr);
+}
+
+
+tCIDLib::TVoid TKrnlLinux::FutexWakeOne(tCIDLib::TCard4& c4Word)
+{
+    CIDKernel_Futex_Linux::lFutex(&c4Word, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
@@ -129,6 +129,18 @@ TKrnlLinux::BuildModName(       tCIDLib::TCh* const     pszPortableBuf
 
 
 
+//
+//  Returns a millisecond count from the monotonic clock, so it's not affected by
+//  changes to the system time. It's for calculating the end of timed waits.
+//
+tCIDLib::TCard8 TKrnlLinux::c8MonoMillis()
+{
+    timespec tsNow;
+    ::clock_gettime(CLOCK_MONOTONIC, &tsNow);
+    return (tCIDLib::TCard8(tsNow.tv_sec) * 1000) + (tsNow.tv_nsec / 1000000);
+}
+
+
 //
 // Converts a time_t value to the kind used by CIDLib. CID file
 // time values are the number of 100-nanosecond intervals elapsed
@@ -35,6 +35,32 @@ namespace TKrnlLinux
     // -----------------------------------------------------------------------
     tCIDLib::TBoolean bInitTermExtProcess(const tCIDLib::EInitTerm eState);
 
+    tCIDLib::TCard8 c8MonoMillis();
+
+    //
+    //  Block on, or wake threads blocked on, a 32 bit word via the futex
+    //  syscall. The wait only blocks if the word still has the expected value,
+    //  and wakeups can be spurious, so callers must always re-check the word.
+    //  It returns False with a timeout error if the time ran out. These are
+    //  the private versions, for use within this process only.
+    //
+    tCIDLib::TBoolean bFutexWait
+    (
+        const   tCIDLib::TCard4&        c4Word
+        , const tCIDLib::TCard4         c4Expected
+        , const tCIDLib::TCard4         c4MilliSecs = kCIDLib::c4MaxWait
+    );
+
+    tCIDLib::TVoid FutexWakeAll
+    (
+                tCIDLib::TCard4&        c4Word
+    );
+
+    tCIDLib::TVoid FutexWakeOne
+    (
+                tCIDLib::TCard4&        c4Word
+    );
+
     tCIDLib::TVoid BuildModName
     (
                 tCIDLib::TCh* const     pszPortableBuf
@@ -63,6 +89,18 @@ namespace TKrnlLinux
 
     tCIDLib::TSCh* pszFindInPath(const tCIDLib::TCh* const pszToFind);
 
+    // Tell the CPU we are in a spin loop, for the user space sync spinners
+    inline tCIDLib::TVoid SpinPause()
+    {
+        #if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+        #elif defined(__aarch64__)
+        asm volatile("yield");
+        #else
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        #endif
+    }
+
     class TThreadTimer
     {
         public:
@@ -18,9 +18,20 @@
 //  This file provides the Linux specific implementation of the class
 //  TKrnlMutex class.
 //
+//  Unnamed mutexes are a futex word with the usual 0 (unlocked), 1 (locked)
+//  and 2 (locked, maybe contended) states, so an uncontended lock or unlock is
+//  a single atomic op. Before blocking we spin for a while, with the spin limit
+//  adapted to how long it has taken to get the lock recently, since most of our
+//  locks are held very briefly. Named mutexes have to be visible to other
+//  processes so they are still System V semaphores.
 //
 // CAVEATS/GOTCHAS:
 //
+//  1)  Mutexes are recursive, so the owning thread and a lock count are kept
+//      outside of the futex word. Only the owner ever changes those, so only
+//      the owner reading its own thread id back matters.
+//
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -33,6 +44,147 @@
 #include    "CIDKernel_InternalHelpers_.hpp"
 
 
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDKernel_Mutex_Linux
+    {
+        // -----------------------------------------------------------------------
+        //  The futex states of an unnamed mutex
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Unlocked      = 0;
+        constexpr tCIDLib::TCard4   c4Locked        = 1;
+        constexpr tCIDLib::TCard4   c4Contended     = 2;
+
+        // -----------------------------------------------------------------------
+        //  The most we'll ever spin before blocking, and the limit is twice the
+        //  recent estimate plus this much.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxSpins      = 100;
+        constexpr tCIDLib::TCard4   c4SpinSlack     = 10;
+
+
+        // Allocate and initialize a mutex implementation
+        TMutexHandleImpl* phmtxiMake()
+        {
+            TMutexHandleImpl* phmtxiNew = new TMutexHandleImpl;
+            phmtxiNew->c4State = c4Unlocked;
+            phmtxiNew->c4SpinEst = 0;
+            phmtxiNew->tidOwner = kCIDLib::tidInvalid;
+            phmtxiNew->iSysVSemId = -1;
+            phmtxiNew->bSysVOwner = kCIDLib::False;
+            phmtxiNew->c4LockCount = 0;
+            phmtxiNew->c4RefCount = 1;
+            return phmtxiNew;
+        }
+
+
+        inline tCIDLib::TBoolean bTryLock(TMutexHandleImpl& hmtxiTar)
+        {
+            tCIDLib::TCard4 c4Exp = c4Unlocked;
+            return __atomic_compare_exchange_n
+            (
+                &hmtxiTar.c4State
+                , &c4Exp
+                , c4Locked
+                , false
+                , __ATOMIC_ACQUIRE
+                , __ATOMIC_RELAXED
+            );
+        }
+
+
+        //
+        //  Lock an unnamed mutex. The caller has already handled the recursive
+        //  case. We try the fast path, then spin a bit, then mark it contended and
+        //  block on the futex.
+        //
+        tCIDLib::TBoolean bFutexLock(TMutexHandleImpl& hmtxiLock, const tCIDLib::TCard4 c4Wait)
+        {
+            if (bTryLock(hmtxiLock))
+                return kCIDLib::True;
+
+            //
+            //  Spin, but only if the owner isn't already known to have waiters,
+            //  which means it's probably going to be a while.
+            //
+            const tCIDLib::TCard4 c4Est = __atomic_load_n(&hmtxiLock.c4SpinEst, __ATOMIC_RELAXED);
+            tCIDLib::TCard4 c4Limit = (c4Est * 2) + c4SpinSlack;
+            if (c4Limit > c4MaxSpins)
+                c4Limit = c4MaxSpins;
+
+            tCIDLib::TCard4 c4Spins = 0;
+            while (c4Spins < c4Limit)
+            {
+                c4Spins++;
+                TKrnlLinux::SpinPause();
+
+                const tCIDLib::TCard4 c4Cur = __atomic_load_n(&hmtxiLock.c4State, __ATOMIC_RELAXED);
+                if (c4Cur == c4Contended)
+                    break;
+
+                if ((c4Cur == c4Unlocked) && bTryLock(hmtxiLock))
+                {
+                    // Move the estimate 1/8th of the way towards what it took
+                    const tCIDLib::TInt4 i4Adj = (tCIDLib::TInt4(c4Spins) - tCIDLib::TInt4(c4Est)) / 8;
+                    __atomic_store_n
+                    (
+                        &hmtxiLock.c4SpinEst, tCIDLib::TCard4(tCIDLib::TInt4(c4Est) + i4Adj), __ATOMIC_RELAXED
+                    );
+                    return kCIDLib::True;
+                }
+            }
+
+            if (!c4Wait)
+            {
+                TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+                return kCIDLib::False;
+            }
+
+            tCIDLib::TCard8 c8End = 0;
+            if (c4Wait != kCIDLib::c4MaxWait)
+                c8End = TKrnlLinux::c8MonoMillis() + c4Wait;
+
+            //
+            //  Mark it contended. If it was unlocked, we got it (and it's marked
+            //  contended, which is just a possibly unneeded wake later.)
+            //
+            while (__atomic_exchange_n(&hmtxiLock.c4State, c4Contended, __ATOMIC_ACQUIRE) != c4Unlocked)
+            {
+                tCIDLib::TCard4 c4ThisWait = kCIDLib::c4MaxWait;
+                if (c4Wait != kCIDLib::c4MaxWait)
+                {
+                    const tCIDLib::TCard8 c8Now = TKrnlLinux::c8MonoMillis();
+                    if (c8Now >= c8End)
+                    {
+                        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+                        return kCIDLib::False;
+                    }
+                    c4ThisWait = tCIDLib::TCard4(c8End - c8Now);
+                }
+
+                if (!TKrnlLinux::bFutexWait(hmtxiLock.c4State, c4Contended, c4ThisWait)
+                &&  (TKrnlError::kerrLast().errcId() != kKrnlErrs::errcGen_Timeout))
+                {
+                    return kCIDLib::False;
+                }
+            }
+            return kCIDLib::True;
+        }
+
+
+        tCIDLib::TVoid FutexUnlock(TMutexHandleImpl& hmtxiUnlock)
+        {
+            if (__atomic_exchange_n(&hmtxiUnlock.c4State, c4Unlocked, __ATOMIC_RELEASE) == c4Contended)
+                TKrnlLinux::FutexWakeOne(hmtxiUnlock.c4State);
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TMutexHandle
 //  PREFIX: hmtx
@@ -165,46 +317,23 @@ tCIDLib::TBoolean TKrnlMutex::bClose()
 {
     if (m_hmtxThis.bIsValid())
     {
-        m_hmtxThis.m_phmtxiThis->prmtxThis->iLock();
-
-        if (!--m_hmtxThis.m_phmtxiThis->c4RefCount)
+        TMutexHandleImpl* phmtxiClose = m_hmtxThis.m_phmtxiThis;
+        if (!__atomic_sub_fetch(&phmtxiClose->c4RefCount, 1, __ATOMIC_ACQ_REL))
         {
-            if((m_hmtxThis.m_phmtxiThis->iSysVSemId != -1)
-               && m_hmtxThis.m_phmtxiThis->bSysVOwner)
+            if ((phmtxiClose->iSysVSemId != -1) && phmtxiClose->bSysVOwner)
             {
                 union semun SemUnion;
                 SemUnion.val = 0;
 
-                if (::semctl(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                             , 0
-                             , IPC_RMID
-                             , SemUnion))
+                if (::semctl(phmtxiClose->iSysVSemId, 0, IPC_RMID, SemUnion))
                 {
-                    m_hmtxThis.m_phmtxiThis->c4RefCount++;
-                    m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
+                    __atomic_add_fetch(&phmtxiClose->c4RefCount, 1, __ATOMIC_ACQ_REL);
                     TKrnlError::SetLastHostError(errno);
                     return kCIDLib::False;
                 }
             }
-
-            m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
-
-            tCIDLib::TOSErrCode HostErr =
-                m_hmtxThis.m_phmtxiThis->prmtxThis->iDestroy();
-            if (HostErr)
-            {
-                TKrnlError::SetLastHostError(HostErr);
-                return kCIDLib::False;
-            }
-
-            delete m_hmtxThis.m_phmtxiThis->prmtxThis;
-            delete m_hmtxThis.m_phmtxiThis;
-        }
-        else
-        {
-            m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
+            delete phmtxiClose;
         }
-
         m_hmtxThis.m_phmtxiThis = 0;
     }
 
@@ -227,16 +356,13 @@ TKrnlMutex::bCreate(const tCIDLib::ELockStates eInitState)
         return bCreateNamed(eInitState, kCIDLib::True, bDummy);
     }
 
-    m_hmtxThis.m_phmtxiThis = new TMutexHandleImpl;
-    m_hmtxThis.m_phmtxiThis->c4RefCount = 1;
-    m_hmtxThis.m_phmtxiThis->iSysVSemId = -1;
-
-    m_hmtxThis.m_phmtxiThis->prmtxThis = new TKrnlLinux::TRecursiveMutex();
-    m_hmtxThis.m_phmtxiThis->prmtxThis->iInitialize();
-
+    m_hmtxThis.m_phmtxiThis = CIDKernel_Mutex_Linux::phmtxiMake();
     if (eInitState == tCIDLib::ELockStates::Locked)
-        m_hmtxThis.m_phmtxiThis->prmtxThis->iLock();
-
+    {
+        m_hmtxThis.m_phmtxiThis->c4State = CIDKernel_Mutex_Linux::c4Locked;
+        m_hmtxThis.m_phmtxiThis->tidOwner = TKrnlThread::tidCaller();
+        m_hmtxThis.m_phmtxiThis->c4LockCount = 1;
+    }
     return kCIDLib::True;
 }
 
@@ -263,100 +389,70 @@ TKrnlMutex::bOpenOrCreate(  const   tCIDLib::ELockStates    eInitState
 
 tCIDLib::TBoolean TKrnlMutex::bLock(const tCIDLib::TCard4 c4MilliSecs) const
 {
-    union semun SemUnion;
-    SemUnion.val = 0;
-
     if (!m_hmtxThis.bIsValid())
     {
         TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotReady);
         return kCIDLib::False;
     }
 
-    if (m_hmtxThis.m_phmtxiThis->iSysVSemId != -1
-        && !::semctl(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                     , 0
-                     , GETVAL
-                     , SemUnion)
-        && (::semctl(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                     , 0
-                     , GETPID
-                     , SemUnion) == ::getpid()))
+    TMutexHandleImpl& hmtxiThis = *m_hmtxThis.m_phmtxiThis;
+    if (hmtxiThis.iSysVSemId == -1)
     {
-        m_hmtxThis.m_phmtxiThis->c4LockCount++;
+        // If we already own it, just bump the count
+        const tCIDLib::TThreadId tidUs = TKrnlThread::tidCaller();
+        if (__atomic_load_n(&hmtxiThis.tidOwner, __ATOMIC_RELAXED) == tidUs)
+        {
+            hmtxiThis.c4LockCount++;
+            return kCIDLib::True;
+        }
+
+        if (!CIDKernel_Mutex_Linux::bFutexLock(hmtxiThis, c4MilliSecs))
+            return kCIDLib::False;
+
+        __atomic_store_n(&hmtxiThis.tidOwner, tidUs, __ATOMIC_RELAXED);
+        hmtxiThis.c4LockCount = 1;
         return kCIDLib::True;
     }
 
-    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    union semun SemUnion;
+    SemUnion.val = 0;
+    if (!::semctl(hmtxiThis.iSysVSemId, 0, GETVAL, SemUnion)
+    &&  (::semctl(hmtxiThis.iSysVSemId, 0, GETPID, SemUnion) == ::getpid()))
     {
-        if (m_hmtxThis.m_phmtxiThis->iSysVSemId != -1)
-        {
-            struct sembuf SemBuf;
-            SemBuf.sem_num = 0;
-            SemBuf.sem_op = -1;
-            SemBuf.sem_flg = 0;
+        hmtxiThis.c4LockCount++;
+        return kCIDLib::True;
+    }
 
-            if (::semop(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                        , &SemBuf
-                        , 1))
-            {
-                TKrnlError::SetLastHostError(errno);
-                return kCIDLib::False;
-            }
+    struct sembuf SemBuf;
+    SemBuf.sem_num = 0;
+    SemBuf.sem_op = -1;
+    SemBuf.sem_flg = 0;
 
-            m_hmtxThis.m_phmtxiThis->c4LockCount = 1;
-        }
-        else
+    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    {
+        if (::semop(hmtxiThis.iSysVSemId, &SemBuf, 1))
         {
-            m_hmtxThis.m_phmtxiThis->prmtxThis->iLock();
+            TKrnlError::SetLastHostError(errno);
+            return kCIDLib::False;
         }
     }
     else
     {
         TKrnlLinux::TThreadTimer thtWaitFor(c4MilliSecs);
+        if (!thtWaitFor.bBegin())
+            return kCIDLib::False;
 
-        if (m_hmtxThis.m_phmtxiThis->iSysVSemId != -1)
-        {
-            struct sembuf SemBuf;
-            SemBuf.sem_num = 0;
-            SemBuf.sem_op = -1;
-            SemBuf.sem_flg = 0;
-
-            if (!thtWaitFor.bBegin())
-                return kCIDLib::False;
-
-            if (::semop(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                        , &SemBuf
-                        , 1))
-            {
-                if (errno == EINTR)
-                    TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
-                else
-                    TKrnlError::SetLastHostError(errno);
-                return kCIDLib::False;
-            }
-
-            m_hmtxThis.m_phmtxiThis->c4LockCount = 1;
-        }
-        else
+        if (::semop(hmtxiThis.iSysVSemId, &SemBuf, 1))
         {
-            if (!thtWaitFor.bTriggered())
-            {
-                if (!thtWaitFor.bBegin())
-                    return kCIDLib::False;
-
-                m_hmtxThis.m_phmtxiThis->prmtxThis->iLock();
-
-                thtWaitFor.Cancel();
-            }
-            else
-            {
-                m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
+            if (errno == EINTR)
                 TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
-                return kCIDLib::False;
-            }
+            else
+                TKrnlError::SetLastHostError(errno);
+            return kCIDLib::False;
         }
     }
 
+    hmtxiThis.c4LockCount = 1;
     return kCIDLib::True;
 }
 
@@ -378,11 +474,7 @@ tCIDLib::TBoolean TKrnlMutex::bDuplicate(const TKrnlMutex& kmtxToDup)
     // Duplicate the handle
     m_hmtxThis = kmtxToDup.m_hmtxThis;
     if (m_hmtxThis.bIsValid())
-    {
-        m_hmtxThis.m_phmtxiThis->prmtxThis->iLock();
-        m_hmtxThis.m_phmtxiThis->c4RefCount++;
-        m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
-    }
+        __atomic_add_fetch(&m_hmtxThis.m_phmtxiThis->c4RefCount, 1, __ATOMIC_ACQ_REL);
 
     return kCIDLib::True;
 }
@@ -402,27 +494,19 @@ tCIDLib::TBoolean TKrnlMutex::bOpen()
         return kCIDLib::False;
     }
 
-    m_hmtxThis.m_phmtxiThis = new TMutexHandleImpl;
-    m_hmtxThis.m_phmtxiThis->c4RefCount = 1;
-
     tCIDLib::TSInt iFlags = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
     key_t key = TRawStr::hshHashStr(m_pszName, kCIDLib::i4MaxInt);
 
     tCIDLib::TSInt iTmp = ::semget(key, 0, iFlags);
     if (iTmp == -1)
     {
-        delete m_hmtxThis.m_phmtxiThis;
-        m_hmtxThis.m_phmtxiThis = 0;
         TKrnlError::SetLastHostError(errno);
         return kCIDLib::False;
     }
 
-    m_hmtxThis.m_phmtxiThis->prmtxThis = new TKrnlLinux::TRecursiveMutex();
-    m_hmtxThis.m_phmtxiThis->prmtxThis->iInitialize();
-
+    m_hmtxThis.m_phmtxiThis = CIDKernel_Mutex_Linux::phmtxiMake();
     m_hmtxThis.m_phmtxiThis->iSysVSemId = iTmp;
     m_hmtxThis.m_phmtxiThis->bSysVOwner = kCIDLib::False;
-    m_hmtxThis.m_phmtxiThis->c4LockCount = 0;
 
     return kCIDLib::True;
 }
@@ -457,47 +541,46 @@ tCIDLib::TBoolean TKrnlMutex::bUnlock() const
         return kCIDLib::False;
     }
 
-    if (m_hmtxThis.m_phmtxiThis->iSysVSemId != -1)
+    TMutexHandleImpl& hmtxiThis = *m_hmtxThis.m_phmtxiThis;
+    if (hmtxiThis.iSysVSemId == -1)
     {
-        union semun SemUnion;
-        SemUnion.val = 0;
-
-        if (!::semctl(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                      , 0
-                      , GETVAL
-                      , SemUnion))
+        if (__atomic_load_n(&hmtxiThis.tidOwner, __ATOMIC_RELAXED) != TKrnlThread::tidCaller())
         {
-            if (::semctl(m_hmtxThis.m_phmtxiThis->iSysVSemId
-                         , 0
-                         , GETPID
-                         , SemUnion) == ::getpid())
-            {
-                if (!--m_hmtxThis.m_phmtxiThis->c4LockCount)
-                {
-                    struct sembuf SemBuf;
-                    SemBuf.sem_num = 0;
-                    SemBuf.sem_op = 1;
-                    SemBuf.sem_flg = 0;
-
-                    if (::semop(m_hmtxThis.m_phmtxiThis->iSysVSemId, &SemBuf, 1))
-                    {
-                        TKrnlError::SetLastHostError(errno);
-                        return kCIDLib::False;
-                    }
-                }
-                return kCIDLib::True;
-            }
+            TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotOwner);
+            return kCIDLib::False;
         }
 
-        TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotOwner);
-        return kCIDLib::False;
+        if (!--hmtxiThis.c4LockCount)
+        {
+            __atomic_store_n(&hmtxiThis.tidOwner, kCIDLib::tidInvalid, __ATOMIC_RELAXED);
+            CIDKernel_Mutex_Linux::FutexUnlock(hmtxiThis);
+        }
+        return kCIDLib::True;
     }
-    else
+
+    union semun SemUnion;
+    SemUnion.val = 0;
+    if (!::semctl(hmtxiThis.iSysVSemId, 0, GETVAL, SemUnion)
+    &&  (::semctl(hmtxiThis.iSysVSemId, 0, GETPID, SemUnion) == ::getpid()))
     {
-        m_hmtxThis.m_phmtxiThis->prmtxThis->iUnlock();
+        if (!--hmtxiThis.c4LockCount)
+        {
+            struct sembuf SemBuf;
+            SemBuf.sem_num = 0;
+            SemBuf.sem_op = 1;
+            SemBuf.sem_flg = 0;
+
+            if (::semop(hmtxiThis.iSysVSemId, &SemBuf, 1))
+            {
+                TKrnlError::SetLastHostError(errno);
+                return kCIDLib::False;
+            }
+        }
+        return kCIDLib::True;
     }
 
-    return kCIDLib::True;
+    TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_NotOwner);
+    return kCIDLib::False;
 }
 
 
@@ -560,14 +643,10 @@ TKrnlMutex::bCreateNamed(const  tCIDLib::ELockStates    eState
         bCreated = kCIDLib::True;
     }
 
-    m_hmtxThis.m_phmtxiThis = new TMutexHandleImpl;
-    m_hmtxThis.m_phmtxiThis->c4RefCount = 1;
+    m_hmtxThis.m_phmtxiThis = CIDKernel_Mutex_Linux::phmtxiMake();
     m_hmtxThis.m_phmtxiThis->iSysVSemId = iTmp;
     m_hmtxThis.m_phmtxiThis->bSysVOwner = bOwner;
 
-    m_hmtxThis.m_phmtxiThis->prmtxThis = new TKrnlLinux::TRecursiveMutex();
-    m_hmtxThis.m_phmtxiThis->prmtxThis->iInitialize();
-
     if (eState == tCIDLib::ELockStates::Locked)
         return bLock(kCIDLib::c4MaxWait);
 
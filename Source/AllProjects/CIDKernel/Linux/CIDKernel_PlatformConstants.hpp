@@ -56,6 +56,7 @@ namespace kCIDLib
     // -----------------------------------------------------------------------
     constexpr tCIDLib::TCard4       c4MemPageSize   = 4096;
     constexpr tCIDLib::TCard4       c4CacheAlign    = 4;
+    constexpr tCIDLib::TCard4       c4CacheLineSz   = 64;
 
 
     // -----------------------------------------------------------------------
@@ -44,6 +44,8 @@
 // ---------------------------------------------------------------------------
 #if defined(__i386__)
 #define CIDLIB_CPU_X86
+#elif defined(__x86_64__)
+#define CIDLIB_CPU_X64
 #elif defined(__ppc__)
 #define CIDLIB_CPU_PPC
 #elif defined(__alpha__)
@@ -53,6 +55,30 @@
 #endif
 
 
+// ---------------------------------------------------------------------------
+//  Code that uses instruction set extension intrinsics (after checking for
+//  them at runtime via TKrnlSysInfo::bCPUHasFeatures) marks those functions
+//  with this, since GCC won't otherwise generate them unless the whole file
+//  is built for that instruction set.
+// ---------------------------------------------------------------------------
+#define CIDLIB_ISATARGET(isa)   __attribute__((target(isa)))
+
+
+// ---------------------------------------------------------------------------
+//  If the compiler can do a full 64x64 to 128 bit multiply, define this to do
+//  it, giving the low and high halves. Code that needs it will do it the hard
+//  way if not defined.
+// ---------------------------------------------------------------------------
+#if defined(__SIZEOF_INT128__)
+#define CIDLIB_MUL128(c8A, c8B, c8Lo, c8Hi) \
+{ \
+    const unsigned __int128 u128Res = static_cast<unsigned __int128>(c8A) * (c8B); \
+    c8Lo = tCIDLib::TCard8(u128Res); \
+    c8Hi = tCIDLib::TCard8(u128Res >> 64); \
+}
+#endif
+
+
 // ---------------------------------------------------------------------------
 //  Define the import/export keywords as blanks
 // ---------------------------------------------------------------------------
@@ -133,10 +133,14 @@ struct TDirSearchHandleImpl
 
 struct TEventHandleImpl
 {
-    // Pthread stuff
-    pthread_mutex_t     mtxThis;
-    pthread_cond_t      condThis;
-    tCIDLib::TBoolean   bSet;
+    //
+    //  Futex stuff, for unnamed events. The low bit of the state is the triggered
+    //  flag and the rest is a pulse count. The waiter count lets triggers skip
+    //  the wake up call if no one is waiting.
+    //
+    tCIDLib::TCard4     c4State;
+    tCIDLib::TCard4     c4Waiters;
+    tCIDLib::TBoolean   bManual;
 
     // System V IPC stuff, for named events
     tCIDLib::TSInt      iSysVSemId;
@@ -172,12 +176,20 @@ struct TModuleHandleImpl
 
 struct TMutexHandleImpl
 {
-    // Pthread stuff
-    TKrnlLinux::TRecursiveMutex* prmtxThis;
+    //
+    //  Futex stuff, for unnamed mutexes. The state is 0 if unlocked, 1 if locked,
+    //  and 2 if locked and there may be waiters. The spin count is the adaptive
+    //  spin estimate.
+    //
+    tCIDLib::TCard4              c4State;
+    tCIDLib::TCard4              c4SpinEst;
+    tCIDLib::TThreadId           tidOwner;
 
     // System V IPC stuff, for named mutexes
     tCIDLib::TSInt               iSysVSemId;
     tCIDLib::TBoolean            bSysVOwner;
+
+    // The recursive lock count, for both types
     tCIDLib::TCard4              c4LockCount;
 
     // Standard handle stuff, enables bDuplicate() method
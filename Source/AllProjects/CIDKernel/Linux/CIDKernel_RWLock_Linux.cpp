@@ -0,0 +1,193 @@
+//
+// FILE NAME: CIDKernel_RWLock_Linux.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file is the Linux specific implementation of the TKrnlRWLock class.
+//  It's a pthreads rwlock, set up to prefer writers.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The pthreads timed lock calls take an absolute time on the realtime
+//      clock, so we have to convert our millisecond timeouts.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDKernel_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local functions
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDKernel_RWLock_Linux
+    {
+        // Convert a relative millisecond wait to the absolute time pthreads wants
+        tCIDLib::TVoid CalcEndTime(const tCIDLib::TCard4 c4MilliSecs, timespec& tsEnd)
+        {
+            ::clock_gettime(CLOCK_REALTIME, &tsEnd);
+            tsEnd.tv_sec += c4MilliSecs / 1000;
+            tsEnd.tv_nsec += (c4MilliSecs % 1000) * 1000000;
+            if (tsEnd.tv_nsec >= 1000000000)
+            {
+                tsEnd.tv_sec++;
+                tsEnd.tv_nsec -= 1000000000;
+            }
+        }
+
+        //
+        //  Store the error for a failed lock. Busy (for a zero wait) and timed
+        //  out are both reported as a timeout.
+        //
+        tCIDLib::TVoid SetLockErr(const tCIDLib::TSInt iErr)
+        {
+            if ((iErr == ETIMEDOUT) || (iErr == EBUSY))
+                TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+            else
+                TKrnlError::SetLastHostError(iErr);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TKrnlRWLock
+//  PREFIX: krwl
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Public data types
+// ---------------------------------------------------------------------------
+struct TKrnlRWLock::TPlatData
+{
+    pthread_rwlock_t    rwlThis;
+};
+
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TKrnlRWLock::TKrnlRWLock() :
+
+    m_pPlatData(new TPlatData)
+{
+    // The default is reader preference, so we have to set it up explicitly
+    pthread_rwlockattr_t Attr;
+    ::pthread_rwlockattr_init(&Attr);
+    ::pthread_rwlockattr_setkind_np(&Attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    ::pthread_rwlock_init(&m_pPlatData->rwlThis, &Attr);
+    ::pthread_rwlockattr_destroy(&Attr);
+}
+
+TKrnlRWLock::~TKrnlRWLock()
+{
+    if (m_pPlatData)
+    {
+        ::pthread_rwlock_destroy(&m_pPlatData->rwlThis);
+        delete m_pPlatData;
+        m_pPlatData = nullptr;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TKrnlRWLock::bLockExclusive(const tCIDLib::TCard4 c4MilliSecs) const
+{
+    tCIDLib::TSInt iRes;
+    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    {
+        iRes = ::pthread_rwlock_wrlock(&m_pPlatData->rwlThis);
+    }
+     else if (!c4MilliSecs)
+    {
+        iRes = ::pthread_rwlock_trywrlock(&m_pPlatData->rwlThis);
+    }
+     else
+    {
+        timespec tsEnd;
+        CIDKernel_RWLock_Linux::CalcEndTime(c4MilliSecs, tsEnd);
+        iRes = ::pthread_rwlock_timedwrlock(&m_pPlatData->rwlThis, &tsEnd);
+    }
+
+    if (iRes)
+    {
+        CIDKernel_RWLock_Linux::SetLockErr(iRes);
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TBoolean TKrnlRWLock::bLockShared(const tCIDLib::TCard4 c4MilliSecs) const
+{
+    tCIDLib::TSInt iRes;
+    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    {
+        iRes = ::pthread_rwlock_rdlock(&m_pPlatData->rwlThis);
+    }
+     else if (!c4MilliSecs)
+    {
+        iRes = ::pthread_rwlock_tryrdlock(&m_pPlatData->rwlThis);
+    }
+     else
+    {
+        timespec tsEnd;
+        CIDKernel_RWLock_Linux::CalcEndTime(c4MilliSecs, tsEnd);
+        iRes = ::pthread_rwlock_timedrdlock(&m_pPlatData->rwlThis, &tsEnd);
+    }
+
+    if (iRes)
+    {
+        CIDKernel_RWLock_Linux::SetLockErr(iRes);
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
+// The same call is used for either mode
+tCIDLib::TBoolean TKrnlRWLock::bUnlockExclusive() const
+{
+    const tCIDLib::TSInt iRes = ::pthread_rwlock_unlock(&m_pPlatData->rwlThis);
+    if (iRes)
+    {
+        TKrnlError::SetLastHostError(iRes);
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+tCIDLib::TBoolean TKrnlRWLock::bUnlockShared() const
+{
+    const tCIDLib::TSInt iRes = ::pthread_rwlock_unlock(&m_pPlatData->rwlThis);
+    if (iRes)
+    {
+        TKrnlError::SetLastHostError(iRes);
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
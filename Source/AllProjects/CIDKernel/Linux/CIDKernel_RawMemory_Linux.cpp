@@ -226,6 +226,18 @@ TRawMem::bAllocSysMem(  const   tCIDLib::TCard4         c4Size
 }
 
 
+tCIDLib::TVoid TRawMem::AcquireFence() noexcept
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+
+tCIDLib::TCard4 TRawMem::c4AcquireGet(const tCIDLib::TCard4& c4ToGet) noexcept
+{
+    return __atomic_load_n(&c4ToGet, __ATOMIC_ACQUIRE);
+}
+
+
 tCIDLib::TCard4
 TRawMem::c4CompareAndExchange(          tCIDLib::TCard4&    c4ToFill
                                 , const tCIDLib::TCard4     c4New
@@ -261,6 +273,12 @@ TRawMem::c4Exchange(        tCIDLib::TCard4&        c4ToFill
 }
 
 
+tCIDLib::TCard4 TRawMem::c4RelaxedGet(const tCIDLib::TCard4& c4ToGet) noexcept
+{
+    return __atomic_load_n(&c4ToGet, __ATOMIC_RELAXED);
+}
+
+
 //
 //  We do a safe inc/dec of the passed reference. Just to be safe we don't allow ref
 //  counts beyond i4MaxCard, since the interlocked stuff really works on signed
@@ -379,3 +397,17 @@ TRawMem::pQueryMemFlags(const   tCIDLib::TVoid*         pBufToQuery
 
     return MemInfo.pAllocBase;
 }
+
+
+tCIDLib::TVoid
+TRawMem::RelaxedSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New) noexcept
+{
+    __atomic_store_n(&c4ToSet, c4New, __ATOMIC_RELAXED);
+}
+
+
+tCIDLib::TVoid
+TRawMem::ReleaseSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New) noexcept
+{
+    __atomic_store_n(&c4ToSet, c4New, __ATOMIC_RELEASE);
+}
@@ -33,6 +33,10 @@
 // ---------------------------------------------------------------------------
 #include    "CIDKernel_.hpp"
 
+#if defined(__i386__) || defined(__x86_64__)
+#include    <cpuid.h>
+#endif
+
 // ---------------------------------------------------------------------------
 //  Global variables
 // ---------------------------------------------------------------------------
@@ -83,6 +87,11 @@ namespace CIDKernel_SystemInfo_Linux
     //  c8TotalPhysicalMem
     //      The amount of memory installed in the machine.
     //
+    //  eCPUFeatures
+    //      The optional instruction set extensions that the CPU (and the OS, for
+    //      the ones that need extra register state saved) supports, so that
+    //      code can pick a hardware accelerated path at runtime.
+    //
     //  szMachineId
     //      The unique machine id for this machine (from /etc/machine-id)
     //
@@ -105,6 +114,7 @@ namespace CIDKernel_SystemInfo_Linux
         tCIDLib::TCard4         c4OSRev;
         tCIDLib::TCard4         c4SSELevel;
         tCIDLib::TCard8         c8TotalPhysicalMem;
+        tCIDLib::ECPUFeatures   eCPUFeatures;
         tCIDLib::TZStr64        szMachineId;
         tCIDLib::TZStr64        szNodeName;
         tCIDLib::TZStr128       szProcessName;
@@ -192,11 +202,55 @@ namespace CIDKernel_SystemInfo_Linux
     }
 
 
+    //
+    //  Query the optional instruction set extensions we care about. AVX2 also
+    //  needs the OS to be saving the YMM registers, which we have to check via
+    //  XGETBV.
+    //
+    tCIDLib::ECPUFeatures eQueryCPUFeatures()
+    {
+        tCIDLib::ECPUFeatures eRet = tCIDLib::ECPUFeatures::None;
+
+        #if defined(__i386__) || defined(__x86_64__)
+        unsigned int c4EAX, c4EBX, c4ECX, c4EDX;
+        if (!__get_cpuid(1, &c4EAX, &c4EBX, &c4ECX, &c4EDX))
+            return eRet;
+
+        if (c4ECX & bit_SSE4_1)
+            eRet |= tCIDLib::ECPUFeatures::SSE41;
+        if (c4ECX & bit_AES)
+            eRet |= tCIDLib::ECPUFeatures::AESNI;
+        if (c4ECX & bit_PCLMUL)
+            eRet |= tCIDLib::ECPUFeatures::PCLMUL;
+
+        // OSXSAVE and AVX, and then the OS has to have XMM/YMM state enabled
+        tCIDLib::TBoolean bOSAVX = kCIDLib::False;
+        if ((c4ECX & (bit_OSXSAVE | bit_AVX)) == (bit_OSXSAVE | bit_AVX))
+        {
+            unsigned int c4XCRLow, c4XCRHigh;
+            __asm__ __volatile__("xgetbv" : "=a"(c4XCRLow), "=d"(c4XCRHigh) : "c"(0));
+            bOSAVX = (c4XCRLow & 0x6) == 0x6;
+        }
+
+        if (__get_cpuid_count(7, 0, &c4EAX, &c4EBX, &c4ECX, &c4EDX))
+        {
+            if (bOSAVX && (c4EBX & bit_AVX2))
+                eRet |= tCIDLib::ECPUFeatures::AVX2;
+            if (c4EBX & bit_SHA)
+                eRet |= tCIDLib::ECPUFeatures::SHA;
+        }
+        #endif
+
+        return eRet;
+    }
+
+
     tCIDLib::TBoolean bQueryCPUInfo(const struct utsname& UtsName)
     {
         // Set defaults for any bits we can't find
         CachedInfo.c4CPUCount = 1;
         CachedInfo.c4SSELevel = 0;
+        CachedInfo.eCPUFeatures = eQueryCPUFeatures();
 
         FILE* CPUFile = ::fopen("/proc/cpuinfo", "r");
         if (!CPUFile)
@@ -430,6 +484,13 @@ TKrnlSysInfo::bCmdLineArg(  const   tCIDLib::TCard4 c4Index
 }
 
 
+tCIDLib::TBoolean
+TKrnlSysInfo::bCPUHasFeatures(const tCIDLib::ECPUFeatures eToCheck)
+{
+    return tCIDLib::bAllBitsOn(CIDKernel_SystemInfo_Linux::CachedInfo.eCPUFeatures, eToCheck);
+}
+
+
 tCIDLib::TBoolean TKrnlSysInfo::bIsHostAdmin()
 {
     // <TBD> Figure out what this is on Linux
@@ -556,6 +617,12 @@ tCIDLib::TCard8 TKrnlSysInfo::c8TotalPhysicalMem()
 }
 
 
+tCIDLib::ECPUFeatures TKrnlSysInfo::eCPUFeatures()
+{
+    return CIDKernel_SystemInfo_Linux::CachedInfo.eCPUFeatures;
+}
+
+
 const tCIDLib::TCh* TKrnlSysInfo::pszNodeName()
 {
     return CIDKernel_SystemInfo_Linux::CachedInfo.szNodeName;
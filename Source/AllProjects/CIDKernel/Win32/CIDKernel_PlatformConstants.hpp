@@ -54,6 +54,7 @@ namespace kCIDLib
     // -----------------------------------------------------------------------
     constexpr tCIDLib::TCard4               c4MemPageSize   = 4096;
     constexpr tCIDLib::TCard4               c4CacheAlign    = 8;
+    constexpr tCIDLib::TCard4               c4CacheLineSz   = 64;
 
 
     // -----------------------------------------------------------------------
@@ -46,6 +46,8 @@
 // ---------------------------------------------------------------------------
 #if defined(_M_IX86)
 #define CIDLIB_CPU_X86
+#elif defined(_M_X64)
+#define CIDLIB_CPU_X64
 #elif defined(_M_PPC)
 #define CIDLIB_CPU_PPC
 #elif defined(_M_ALPHA)
@@ -55,6 +57,28 @@
 #endif
 
 
+// ---------------------------------------------------------------------------
+//  Code that uses instruction set extension intrinsics (after checking for
+//  them at runtime via TKrnlSysInfo::bCPUHasFeatures) marks those functions
+//  with this. Visual C++ lets us use any intrinsics without any special
+//  options, so it's a no-op here.
+// ---------------------------------------------------------------------------
+#define CIDLIB_ISATARGET(isa)
+
+
+// ---------------------------------------------------------------------------
+//  If the compiler can do a full 64x64 to 128 bit multiply, define this to do
+//  it, giving the low and high halves. Code that needs it will do it the hard
+//  way if not defined. The intrinsic is only available for 64 bit builds.
+// ---------------------------------------------------------------------------
+#if defined(_M_X64)
+#define CIDLIB_MUL128(c8A, c8B, c8Lo, c8Hi) \
+{ \
+    c8Lo = _umul128(c8A, c8B, &c8Hi); \
+}
+#endif
+
+
 
 // ---------------------------------------------------------------------------
 //  Define the import/export keywords for the Win32 platform.
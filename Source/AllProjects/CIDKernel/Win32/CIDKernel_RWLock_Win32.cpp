@@ -0,0 +1,129 @@
+//
+// FILE NAME: CIDKernel_RWLock_Win32.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file is the Win32 specific implementation of the TKrnlRWLock class.
+//  It's a slim reader/writer lock, which doesn't let new readers in while a
+//  writer is waiting.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  SRW locks have no timed acquire, so for timed waits we poll with the
+//      try versions.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDKernel_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TKrnlRWLock
+//  PREFIX: krwl
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Public data types
+// ---------------------------------------------------------------------------
+struct TKrnlRWLock::TPlatData
+{
+    alignas(kCIDLib::c4CacheAlign) SRWLOCK  SRWLock;
+};
+
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TKrnlRWLock::TKrnlRWLock() :
+
+    m_pPlatData(new TPlatData)
+{
+    ::InitializeSRWLock(&m_pPlatData->SRWLock);
+}
+
+TKrnlRWLock::~TKrnlRWLock()
+{
+    // SRW locks don't have to be cleaned up
+    delete m_pPlatData;
+    m_pPlatData = nullptr;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TKrnlRWLock: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TKrnlRWLock::bLockExclusive(const tCIDLib::TCard4 c4MilliSecs) const
+{
+    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    {
+        ::AcquireSRWLockExclusive(&m_pPlatData->SRWLock);
+        return kCIDLib::True;
+    }
+
+    const tCIDLib::TCard4 c4End = ::GetTickCount() + c4MilliSecs;
+    while (!::TryAcquireSRWLockExclusive(&m_pPlatData->SRWLock))
+    {
+        if (tCIDLib::TInt4(c4End - ::GetTickCount()) <= 0)
+        {
+            TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+            return kCIDLib::False;
+        }
+        ::Sleep(1);
+    }
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TBoolean TKrnlRWLock::bLockShared(const tCIDLib::TCard4 c4MilliSecs) const
+{
+    if (c4MilliSecs == kCIDLib::c4MaxWait)
+    {
+        ::AcquireSRWLockShared(&m_pPlatData->SRWLock);
+        return kCIDLib::True;
+    }
+
+    const tCIDLib::TCard4 c4End = ::GetTickCount() + c4MilliSecs;
+    while (!::TryAcquireSRWLockShared(&m_pPlatData->SRWLock))
+    {
+        if (tCIDLib::TInt4(c4End - ::GetTickCount()) <= 0)
+        {
+            TKrnlError::SetLastKrnlError(kKrnlErrs::errcGen_Timeout);
+            return kCIDLib::False;
+        }
+        ::Sleep(1);
+    }
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TBoolean TKrnlRWLock::bUnlockExclusive() const
+{
+    ::ReleaseSRWLockExclusive(&m_pPlatData->SRWLock);
+    return kCIDLib::True;
+}
+
+tCIDLib::TBoolean TKrnlRWLock::bUnlockShared() const
+{
+    ::ReleaseSRWLockShared(&m_pPlatData->SRWLock);
+    return kCIDLib::True;
+}
@@ -90,6 +90,22 @@ TRawMem::bAllocSysMem(  const   tCIDLib::TCard4         c4Size
 
 
 
+// There's no acquire only fence in the Win32 API, so this is a full barrier
+tCIDLib::TVoid TRawMem::AcquireFence() noexcept
+{
+    ::MemoryBarrier();
+}
+
+
+tCIDLib::TCard4 TRawMem::c4AcquireGet(const tCIDLib::TCard4& c4ToGet) noexcept
+{
+    return static_cast<tCIDLib::TCard4>
+    (
+        ::ReadAcquire(reinterpret_cast<const volatile LONG*>(&c4ToGet))
+    );
+}
+
+
 tCIDLib::TCard4
 TRawMem::c4CompareAndExchange(              tCIDLib::TCard4&    c4ToFill
                                 , const     tCIDLib::TCard4     c4New
@@ -116,6 +132,15 @@ TRawMem::c4Exchange(        tCIDLib::TCard4&    c4ToFill
 }
 
 
+tCIDLib::TCard4 TRawMem::c4RelaxedGet(const tCIDLib::TCard4& c4ToGet) noexcept
+{
+    return static_cast<tCIDLib::TCard4>
+    (
+        ::ReadNoFence(reinterpret_cast<const volatile LONG*>(&c4ToGet))
+    );
+}
+
+
 //
 //  We do a safe inc/dec of the passed reference. Just to be safe we don't allow ref
 //  counts beyond i4MaxCard, since the interlocked stuff really works on signed
@@ -223,3 +248,16 @@ TRawMem::pQueryMemFlags(const   tCIDLib::TVoid*         pBufToQuery
     return RawInfo.BaseAddress;
 }
 
+
+tCIDLib::TVoid
+TRawMem::RelaxedSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New) noexcept
+{
+    ::WriteNoFence(reinterpret_cast<volatile LONG*>(&c4ToSet), static_cast<LONG>(c4New));
+}
+
+
+tCIDLib::TVoid
+TRawMem::ReleaseSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New) noexcept
+{
+    ::WriteRelease(reinterpret_cast<volatile LONG*>(&c4ToSet), static_cast<LONG>(c4New));
+}
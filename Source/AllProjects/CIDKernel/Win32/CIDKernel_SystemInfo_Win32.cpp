@@ -42,6 +42,7 @@
 #include    <Security.h>
 #include    <shlobj.h>
 #include    <Iphlpapi.h>
+#include    <intrin.h>
 #pragma     warning(pop)
 
 
@@ -94,6 +95,11 @@
 //  c8TotalPhysicalMem
 //      The amount of memory installed in the machine.
 //
+//  eCPUFeatures
+//      The optional instruction set extensions that the CPU (and the OS, for
+//      the ones that need extra register state saved) supports, so that code
+//      can pick a hardware accelerated path at runtime.
+//
 //  szNodeName
 //      The name assigned to this machine in the system setup. This size should be
 //      grotesquely overkill for any node name. This cannot be a kernel string since
@@ -120,6 +126,7 @@ struct TCachedInfo
     tCIDLib::TCard4     c4OSServicePack;
     tCIDLib::TCard4     c4SSELevel;
     tCIDLib::TCard8     c8TotalPhysicalMem;
+    tCIDLib::ECPUFeatures eCPUFeatures;
     tCIDLib::TZStr128   szNodeName;
     tCIDLib::TZStr512   szProcessName;
 };
@@ -136,6 +143,51 @@ namespace
         //      The cached system info that we cache up init and hang onto.
         // -----------------------------------------------------------------------
         TCachedInfo      CachedInfo;
+
+
+        // -----------------------------------------------------------------------
+        //  Query the optional instruction set extensions we care about. AVX2
+        //  also needs the OS to be saving the YMM registers, which we have to
+        //  check via XGETBV.
+        // -----------------------------------------------------------------------
+        tCIDLib::ECPUFeatures eQueryCPUFeatures()
+        {
+            tCIDLib::ECPUFeatures eRet = tCIDLib::ECPUFeatures::None;
+
+            #if defined(_M_IX86) || defined(_M_X64)
+            int aiRegs[4];
+            __cpuid(aiRegs, 0);
+            const int iMaxLeaf = aiRegs[0];
+            if (iMaxLeaf < 1)
+                return eRet;
+
+            __cpuid(aiRegs, 1);
+            const tCIDLib::TCard4 c4ECX = tCIDLib::TCard4(aiRegs[2]);
+            if (c4ECX & 0x00080000)
+                eRet |= tCIDLib::ECPUFeatures::SSE41;
+            if (c4ECX & 0x02000000)
+                eRet |= tCIDLib::ECPUFeatures::AESNI;
+            if (c4ECX & 0x00000002)
+                eRet |= tCIDLib::ECPUFeatures::PCLMUL;
+
+            // OSXSAVE and AVX, and then the OS has to have XMM/YMM state enabled
+            tCIDLib::TBoolean bOSAVX = kCIDLib::False;
+            if ((c4ECX & 0x18000000) == 0x18000000)
+                bOSAVX = (_xgetbv(0) & 0x6) == 0x6;
+
+            if (iMaxLeaf >= 7)
+            {
+                __cpuidex(aiRegs, 7, 0);
+                const tCIDLib::TCard4 c4EBX = tCIDLib::TCard4(aiRegs[1]);
+                if (bOSAVX && (c4EBX & 0x00000020))
+                    eRet |= tCIDLib::ECPUFeatures::AVX2;
+                if (c4EBX & 0x20000000)
+                    eRet |= tCIDLib::ECPUFeatures::SHA;
+            }
+            #endif
+
+            return eRet;
+        }
     }
 }
 
@@ -379,6 +431,10 @@ TCIDKrnlModule::bInitTermSysInfo(const tCIDLib::EInitTerm eState)
             CIDKernel_SystemInfo_Win32::CachedInfo.c4SSELevel = 1;
         else
             CIDKernel_SystemInfo_Win32::CachedInfo.c4SSELevel = 0;
+
+        // And the other instruction set extensions
+        CIDKernel_SystemInfo_Win32::CachedInfo.eCPUFeatures
+                        = CIDKernel_SystemInfo_Win32::eQueryCPUFeatures();
     }
     return kCIDLib::True;
 }
@@ -401,6 +457,13 @@ TKrnlSysInfo::bCmdLineArg(const tCIDLib::TCard4 c4Index, TKrnlString& kstrToFill
 }
 
 
+tCIDLib::TBoolean
+TKrnlSysInfo::bCPUHasFeatures(const tCIDLib::ECPUFeatures eToCheck)
+{
+    return tCIDLib::bAllBitsOn(CIDKernel_SystemInfo_Win32::CachedInfo.eCPUFeatures, eToCheck);
+}
+
+
 tCIDLib::TBoolean TKrnlSysInfo::bIsHostAdmin()
 {
     //
@@ -678,6 +741,12 @@ tCIDLib::TCard8 TKrnlSysInfo::c8TotalPhysicalMem()
 }
 
 
+tCIDLib::ECPUFeatures TKrnlSysInfo::eCPUFeatures()
+{
+    return CIDKernel_SystemInfo_Win32::CachedInfo.eCPUFeatures;
+}
+
+
 const tCIDLib::TCh* TKrnlSysInfo::pszNodeName()
 {
     return CIDKernel_SystemInfo_Win32::CachedInfo.szNodeName;
@@ -79,6 +79,7 @@ namespace tCIDLib
 {
     StdEnumTricks(tCIDLib::ECorners)
     StdEnumTricks(tCIDLib::ELogFlags)
+    StdEnumTricks(tCIDLib::ETaskPrios)
 }
 
 #include    "CIDLib_Object.hpp"
@@ -88,14 +89,19 @@ namespace tCIDLib
 #include    "CIDLib_String.hpp"
 #include    "CIDLib_StringView.hpp"
 #include    "CIDLib_StringId.hpp"
+#include    "CIDLib_Atom.hpp"
 #include    "CIDLib_ResourceName.hpp"
 #include    "CIDLib_CriticalSection.hpp"
 #include    "CIDLib_Event.hpp"
 #include    "CIDLib_Mutex.hpp"
+#include    "CIDLib_RWLock.hpp"
 #include    "CIDLib_ModuleInfo.hpp"
 #include    "CIDLib_Module.hpp"
 #include    "CIDLib_KeyValuePair.hpp"
 #include    "CIDLib_Atomic.hpp"
+#include    "CIDLib_SeqLock.hpp"
+#include    "CIDLib_SlabAlloc.hpp"
+#include    "CIDLib_Arena.hpp"
 #include    "CIDLib_SmartPointer.hpp"
 #include    "CIDLib_ObjLocker.hpp"
 #include    "CIDLib_SearchNSort.hpp"
@@ -373,6 +379,9 @@ namespace tCIDLib
 #include    "CIDLib_UndoCore.hpp"
 #include    "CIDLib_FixedSizePool.hpp"
 #include    "CIDLib_SimplePool.hpp"
+#include    "CIDLib_ThreadPool.hpp"
+#include    "CIDLib_ParColAlgo.hpp"
+#include    "CIDLib_RingQueue.hpp"
 
 
 
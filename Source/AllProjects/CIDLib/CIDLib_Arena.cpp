@@ -0,0 +1,491 @@
+//
+// FILE NAME: CIDLib_Arena.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TArena class and its janitor.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TArena,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_Arena
+    {
+        // -----------------------------------------------------------------------
+        //  The space we reserve at the start of each chunk for its header. It's
+        //  kept a multiple of 16 so the data starts out reasonably aligned.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4HdrSize = 32;
+
+
+        // -----------------------------------------------------------------------
+        //  The process wide cache of free default sized chunks, and the total
+        //  chunk bytes allocated from the heap. These are never destroyed, since
+        //  arenas can be destroyed during static cleanup.
+        // -----------------------------------------------------------------------
+        struct TFreeChunk
+        {
+            TFreeChunk*     pNext;
+        };
+
+        struct TChunkCache
+        {
+            TCriticalSection    crsSync;
+            TFreeChunk*         pHead = nullptr;
+            tCIDLib::TCard4     c4Count = 0;
+            tCIDLib::TCard8     c8ChunkBytes = 0;
+        };
+
+        TChunkCache& cacheChunks()
+        {
+            static TChunkCache* pcacheRet = new TChunkCache;
+            return *pcacheRet;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The stats cache items
+        // -----------------------------------------------------------------------
+        TAtomicFlag         atomStatsInit;
+        TStatsCacheItem     sciCachedChunks;
+        TStatsCacheItem     sciChunkBytes;
+
+        TCriticalSection* pcrsStats()
+        {
+            static TCriticalSection crsStats;
+            return &crsStats;
+        }
+
+
+        // Get a chunk's memory, from the cache if it's of the default size
+        tCIDLib::TCard1* pc1GetChunk(const tCIDLib::TCard4 c4DataSize)
+        {
+            TChunkCache& cacheSrc = cacheChunks();
+            if (c4DataSize == kCIDLib::c4DefArenaChunkSz)
+            {
+                TCritSecLocker crslSync(&cacheSrc.crsSync);
+                if (cacheSrc.pHead)
+                {
+                    TFreeChunk* pchkRet = cacheSrc.pHead;
+                    cacheSrc.pHead = pchkRet->pNext;
+                    cacheSrc.c4Count--;
+                    return reinterpret_cast<tCIDLib::TCard1*>(pchkRet);
+                }
+            }
+
+            tCIDLib::TCard1* pc1Ret = new tCIDLib::TCard1[c4HdrSize + c4DataSize];
+            {
+                TCritSecLocker crslSync(&cacheSrc.crsSync);
+                cacheSrc.c8ChunkBytes += c4HdrSize + c4DataSize;
+            }
+            TArena::UpdateStats();
+            return pc1Ret;
+        }
+
+        //
+        //  Give back a chunk's memory. Default sized ones go into the cache if
+        //  there's room, else it goes back to the heap.
+        //
+        tCIDLib::TVoid PutChunk(        tCIDLib::TCard1* const  pc1Chunk
+                                , const tCIDLib::TCard4         c4DataSize)
+        {
+            TChunkCache& cacheTar = cacheChunks();
+            {
+                TCritSecLocker crslSync(&cacheTar.crsSync);
+                if ((c4DataSize == kCIDLib::c4DefArenaChunkSz)
+                &&  (cacheTar.c4Count < kCIDLib::c4MaxArenaCacheChunks))
+                {
+                    TFreeChunk* pchkFree = reinterpret_cast<TFreeChunk*>(pc1Chunk);
+                    pchkFree->pNext = cacheTar.pHead;
+                    cacheTar.pHead = pchkFree;
+                    cacheTar.c4Count++;
+                    return;
+                }
+                cacheTar.c8ChunkBytes -= c4HdrSize + c4DataSize;
+            }
+            delete [] pc1Chunk;
+            TArena::UpdateStats();
+        }
+
+
+        // Return the padding needed to get the passed address to an alignment
+        inline tCIDLib::TCard4
+        c4PadFor(const tCIDLib::TCard1* const pc1At, const tCIDLib::TCard4 c4Align)
+        {
+            const tCIDLib::TCard4 c4Low = tCIDLib::TCard4(reinterpret_cast<size_t>(pc1At));
+            return (c4Align - (c4Low & (c4Align - 1))) & (c4Align - 1);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArena::TChunk
+//  PREFIX: chk
+//
+//  The header at the start of each chunk. The data follows it, at c4HdrSize
+//  bytes from the start.
+// ---------------------------------------------------------------------------
+struct TArena::TChunk
+{
+    tCIDLib::TCard1* pc1Data()
+    {
+        return reinterpret_cast<tCIDLib::TCard1*>(this) + CIDLib_Arena::c4HdrSize;
+    }
+
+    //
+    //  Return the padding needed to do an allocation of the passed size and
+    //  alignment in this chunk, or c4MaxCard if it won't fit.
+    //
+    tCIDLib::TCard4 c4FitPad(const  tCIDLib::TCard4 c4AllocSize
+                            , const tCIDLib::TCard4 c4Align)
+    {
+        const tCIDLib::TCard4 c4Pad = CIDLib_Arena::c4PadFor(pc1Data() + c4Offset, c4Align);
+        const tCIDLib::TCard4 c4Left = c4Size - c4Offset;
+        if ((c4Pad > c4Left) || (c4AllocSize > c4Left - c4Pad))
+            return kCIDLib::c4MaxCard;
+        return c4Pad;
+    }
+
+    TChunk*             pchkNext;
+    tCIDLib::TCard4     c4Offset;
+    tCIDLib::TCard4     c4Size;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArena
+//  PREFIX: arena
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TArena: Public, static methods
+// ---------------------------------------------------------------------------
+
+// Push the process wide chunk stats out to the stats cache
+tCIDLib::TVoid TArena::UpdateStats()
+{
+    if (!CIDLib_Arena::atomStatsInit)
+    {
+        TCritSecLocker crslStats(CIDLib_Arena::pcrsStats());
+        if (!CIDLib_Arena::atomStatsInit)
+        {
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Arena_CachedChunks
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_Arena::sciCachedChunks
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Arena_ChunkBytes
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_Arena::sciChunkBytes
+            );
+            CIDLib_Arena::atomStatsInit.Set();
+        }
+    }
+
+    tCIDLib::TCard4 c4Cached = 0;
+    tCIDLib::TCard8 c8Bytes = 0;
+    {
+        CIDLib_Arena::TChunkCache& cacheSrc = CIDLib_Arena::cacheChunks();
+        TCritSecLocker crslSync(&cacheSrc.crsSync);
+        c4Cached = cacheSrc.c4Count;
+        c8Bytes = cacheSrc.c8ChunkBytes;
+    }
+    TStatsCache::SetValue(CIDLib_Arena::sciCachedChunks, c4Cached);
+    TStatsCache::SetValue(CIDLib_Arena::sciChunkBytes, c8Bytes);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TArena: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TArena::TArena(const tCIDLib::TCard4 c4ChunkSize) :
+
+    m_c4BytesUsed(0)
+    , m_c4ChunkCount(0)
+    , m_c4ChunkSize(c4ChunkSize ? c4ChunkSize : kCIDLib::c4DefArenaChunkSz)
+    , m_pchkCur(nullptr)
+    , m_pchkFirst(nullptr)
+{
+    static_assert
+    (
+        sizeof(TChunk) <= CIDLib_Arena::c4HdrSize, "Arena chunk header is too large"
+    );
+}
+
+TArena::~TArena()
+{
+    Reset(kCIDLib::True);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TArena: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+TArena::TMark TArena::markCurrent() const
+{
+    TMark markRet;
+    markRet.m_pchkAt = m_pchkCur;
+    markRet.m_c4Offset = m_pchkCur ? m_pchkCur->c4Offset : 0;
+    markRet.m_c4BytesUsed = m_c4BytesUsed;
+    return markRet;
+}
+
+
+tCIDLib::TVoid*
+TArena::pAlloc(const tCIDLib::TCard4 c4Size, const tCIDLib::TCard4 c4Align)
+{
+    if (!c4Align || (c4Align & (c4Align - 1)) || (c4Align > kCIDLib::c4MaxArenaAlign))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcArena_BadAlign
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::BadParms
+            , TCardinal(c4Align)
+            , TCardinal(kCIDLib::c4MaxArenaAlign)
+        );
+    }
+
+    // The fast path, where it fits in the current chunk
+    if (m_pchkCur)
+    {
+        const tCIDLib::TCard4 c4Pad = m_pchkCur->c4FitPad(c4Size, c4Align);
+        if (c4Pad != kCIDLib::c4MaxCard)
+        {
+            tCIDLib::TCard1* pc1Ret = m_pchkCur->pc1Data() + m_pchkCur->c4Offset + c4Pad;
+            m_pchkCur->c4Offset += c4Pad + c4Size;
+            m_c4BytesUsed += c4Pad + c4Size;
+            return pc1Ret;
+        }
+    }
+    return pNewChunk(c4Size, c4Align);
+}
+
+
+const tCIDLib::TCh*
+TArena::pszReplicate(const tCIDLib::TCh* const pszToCopy, const tCIDLib::TCard4 c4Len)
+{
+    const tCIDLib::TCard4 c4ActualLen
+    (
+        (c4Len == kCIDLib::c4MaxCard) ? TRawStr::c4StrLen(pszToCopy) : c4Len
+    );
+
+    tCIDLib::TCh* pszRet = ptAllocArray<tCIDLib::TCh>(c4ActualLen + 1);
+    TRawMem::CopyMemBuf(pszRet, pszToCopy, c4ActualLen * kCIDLib::c4CharBytes);
+    pszRet[c4ActualLen] = kCIDLib::chNull;
+    return pszRet;
+}
+
+const tCIDLib::TCh* TArena::pszReplicate(const TString& strToCopy)
+{
+    return pszReplicate(strToCopy.pszBuffer(), strToCopy.c4Length());
+}
+
+
+//
+//  Throw away everything allocated. Normally we keep the chunks to reuse, but
+//  they can be given back if this arena isn't going to be used for a while.
+//
+tCIDLib::TVoid TArena::Reset(const tCIDLib::TBoolean bFreeChunks)
+{
+    if (bFreeChunks)
+    {
+        TChunk* pchkCur = m_pchkFirst;
+        while (pchkCur)
+        {
+            TChunk* pchkNext = pchkCur->pchkNext;
+            CIDLib_Arena::PutChunk(reinterpret_cast<tCIDLib::TCard1*>(pchkCur), pchkCur->c4Size);
+            pchkCur = pchkNext;
+        }
+        m_pchkFirst = nullptr;
+        m_c4ChunkCount = 0;
+    }
+
+    m_pchkCur = m_pchkFirst;
+    if (m_pchkCur)
+        m_pchkCur->c4Offset = 0;
+    m_c4BytesUsed = 0;
+}
+
+
+//
+//  Go back to a mark. The chunks after the mark's chunk are kept as spares. The
+//  mark's chunk has to be in the part of our list that's in use, and not past
+//  the current position.
+//
+tCIDLib::TVoid TArena::RollBack(const TMark& markTo)
+{
+    if (!markTo.m_pchkAt)
+    {
+        Reset();
+        return;
+    }
+
+    TChunk* pchkCur = m_pchkFirst;
+    while (pchkCur && (pchkCur != markTo.m_pchkAt) && (pchkCur != m_pchkCur))
+        pchkCur = pchkCur->pchkNext;
+
+    if ((pchkCur != markTo.m_pchkAt)
+    ||  ((pchkCur == m_pchkCur) && (markTo.m_c4Offset > m_pchkCur->c4Offset)))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcArena_BadMark
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::BadParms
+        );
+    }
+
+    m_pchkCur = pchkCur;
+    m_pchkCur->c4Offset = markTo.m_c4Offset;
+    m_c4BytesUsed = markTo.m_c4BytesUsed;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TArena: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The current chunk is full (or we don't have one.) If the next chunk is a
+//  spare that the allocation fits in, we move up to it. Else we get a new one
+//  and put it in after the current one, so any spares are still there later.
+//
+tCIDLib::TVoid*
+TArena::pNewChunk(const tCIDLib::TCard4 c4Size, const tCIDLib::TCard4 c4Align)
+{
+    TChunk* pchkNext = m_pchkCur ? m_pchkCur->pchkNext : m_pchkFirst;
+    if (pchkNext)
+    {
+        pchkNext->c4Offset = 0;
+        if (pchkNext->c4FitPad(c4Size, c4Align) == kCIDLib::c4MaxCard)
+            pchkNext = nullptr;
+    }
+
+    if (!pchkNext)
+    {
+        if (c4Size > kCIDLib::c4MaxCard - (CIDLib_Arena::c4HdrSize + c4Align))
+            ThrowTooBig(c4Size);
+
+        // Oversized allocations get a chunk of their own
+        tCIDLib::TCard4 c4DataSize = m_c4ChunkSize;
+        if (c4Size + c4Align > c4DataSize)
+            c4DataSize = c4Size + c4Align;
+
+        pchkNext = reinterpret_cast<TChunk*>(CIDLib_Arena::pc1GetChunk(c4DataSize));
+        pchkNext->c4Offset = 0;
+        pchkNext->c4Size = c4DataSize;
+        if (m_pchkCur)
+        {
+            pchkNext->pchkNext = m_pchkCur->pchkNext;
+            m_pchkCur->pchkNext = pchkNext;
+        }
+         else
+        {
+            pchkNext->pchkNext = m_pchkFirst;
+            m_pchkFirst = pchkNext;
+        }
+        m_c4ChunkCount++;
+    }
+    m_pchkCur = pchkNext;
+
+    const tCIDLib::TCard4 c4Pad = m_pchkCur->c4FitPad(c4Size, c4Align);
+    CIDAssert(c4Pad != kCIDLib::c4MaxCard, L"The new arena chunk is too small");
+
+    tCIDLib::TCard1* pc1Ret = m_pchkCur->pc1Data() + c4Pad;
+    m_pchkCur->c4Offset = c4Pad + c4Size;
+    m_c4BytesUsed += c4Pad + c4Size;
+    return pc1Ret;
+}
+
+
+tCIDLib::TVoid TArena::ThrowTooBig(const tCIDLib::TCard4 c4Size) const
+{
+    facCIDLib().ThrowErr
+    (
+        CID_FILE
+        , CID_LINE
+        , kCIDErrs::errcArena_TooBig
+        , tCIDLib::ESeverities::Failed
+        , tCIDLib::EErrClasses::OutResource
+        , TCardinal(c4Size)
+    );
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArenaJanitor
+//  PREFIX: jan
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TArenaJanitor: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TArenaJanitor::TArenaJanitor(TArena* const parenaToSanitize) :
+
+    m_markStart(parenaToSanitize->markCurrent())
+    , m_parenaToSanitize(parenaToSanitize)
+{
+}
+
+TArenaJanitor::~TArenaJanitor()
+{
+    if (!m_parenaToSanitize)
+        return;
+
+    try
+    {
+        m_parenaToSanitize->RollBack(m_markStart);
+    }
+
+    catch(TError& errToCatch)
+    {
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        TModule::LogEventObj(errToCatch);
+    }
+}
@@ -0,0 +1,287 @@
+//
+// FILE NAME: CIDLib_Arena.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TArena class, which is a monotonic (bump pointer)
+//  allocator. It's for request scoped work, where lots of small, short lived
+//  things are allocated and then all of them are thrown away at once at the end.
+//  Allocating is just moving a pointer forward in the current chunk, and freeing
+//  is a no-op. All of the memory is given back at once, by Reset(), or when the
+//  arena is destroyed.
+//
+//  Chunks are kept when the arena is reset, so an arena reused for each request
+//  settles down to not allocating at all. When an arena is destroyed, its chunks
+//  of the default size go into a process wide cache (up to a limit) so that the
+//  next arena created can pick them up instead of going to the heap.
+//
+//  A mark can be taken and later rolled back to, which gives back everything
+//  allocated since the mark. TArenaJanitor does this in a scoped way, so a
+//  nested bit of work can clean up after itself without resetting the arena.
+//
+//  THashMap and TFundVector can be told to get their nodes/buffers from an
+//  arena, and pszReplicate() provides cheap string copies. For building up
+//  text, TTextArenaOutStream formats into a buffer in an arena.
+//
+//  Stats are published to the stats cache, under the arena scope.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  No destructors are run for anything allocated from an arena. Objects
+//      with non-trivial destructors must be destroyed explicitly before the
+//      arena is reset, which is what the arena aware collections do.
+//
+//  2)  Arenas are not thread safe. They are meant to be owned by whatever is
+//      doing the work, on the thread doing it.
+//
+//  3)  Rolling back to a mark or resetting invalidates anything allocated
+//      since the mark, and marks taken after it.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArena
+//  PREFIX: arena
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TArena : public TObject
+{
+    private :
+        // -------------------------------------------------------------------
+        //  Private class types
+        // -------------------------------------------------------------------
+        struct TChunk;
+
+
+    public  :
+        // -------------------------------------------------------------------
+        //  Public class types
+        //
+        //  A position in the arena, to be rolled back to later. It's opaque to
+        //  everyone but us.
+        // -------------------------------------------------------------------
+        class TMark
+        {
+            public :
+                TMark() = default;
+
+            private :
+                friend class TArena;
+
+                TChunk*             m_pchkAt = nullptr;
+                tCIDLib::TCard4     m_c4Offset = 0;
+                tCIDLib::TCard4     m_c4BytesUsed = 0;
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TVoid UpdateStats();
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TArena
+        (
+            const   tCIDLib::TCard4         c4ChunkSize = kCIDLib::c4DefArenaChunkSz
+        );
+
+        TArena(const TArena&) = delete;
+        TArena(TArena&&) = delete;
+
+        ~TArena();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TArena& operator=(const TArena&) = delete;
+        TArena& operator=(TArena&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4BytesUsed() const
+        {
+            return m_c4BytesUsed;
+        }
+
+        tCIDLib::TCard4 c4ChunkCount() const
+        {
+            return m_c4ChunkCount;
+        }
+
+        tCIDLib::TCard4 c4ChunkSize() const
+        {
+            return m_c4ChunkSize;
+        }
+
+        TMark markCurrent() const;
+
+        tCIDLib::TVoid* pAlloc
+        (
+            const   tCIDLib::TCard4         c4Size
+            , const tCIDLib::TCard4         c4Align = sizeof(tCIDLib::TVoid*)
+        );
+
+        const tCIDLib::TCh* pszReplicate
+        (
+            const   tCIDLib::TCh* const     pszToCopy
+            , const tCIDLib::TCard4         c4Len = kCIDLib::c4MaxCard
+        );
+
+        const tCIDLib::TCh* pszReplicate
+        (
+            const   TString&                strToCopy
+        );
+
+        template <typename T> T* ptAllocArray(const tCIDLib::TCard4 c4Count)
+        {
+            if (c4Count > kCIDLib::c4MaxCard / sizeof(T))
+                ThrowTooBig(c4Count);
+            return static_cast<T*>(pAlloc(tCIDLib::TCard4(sizeof(T) * c4Count), alignof(T)));
+        }
+
+        tCIDLib::TVoid Reset
+        (
+            const   tCIDLib::TBoolean       bFreeChunks = kCIDLib::False
+        );
+
+        tCIDLib::TVoid RollBack
+        (
+            const   TMark&                  markTo
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid* pNewChunk
+        (
+            const   tCIDLib::TCard4         c4Size
+            , const tCIDLib::TCard4         c4Align
+        );
+
+        tCIDLib::TVoid ThrowTooBig
+        (
+            const   tCIDLib::TCard4         c4Size
+        )   const;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4BytesUsed
+        //      The bytes handed out since the last reset, including alignment
+        //      padding but not space left unused at the end of chunks.
+        //
+        //  m_c4ChunkCount
+        //      The number of chunks in our list, used or not.
+        //
+        //  m_c4ChunkSize
+        //      The size of the chunks we allocate, unless a single allocation
+        //      is bigger than that.
+        //
+        //  m_pchkCur
+        //      The chunk we are currently allocating from. Any after this in the
+        //      list are spares kept from before the last reset/roll back. It's
+        //      null until the first allocation.
+        //
+        //  m_pchkFirst
+        //      The head of our list of chunks.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4     m_c4BytesUsed;
+        tCIDLib::TCard4     m_c4ChunkCount;
+        tCIDLib::TCard4     m_c4ChunkSize;
+        TChunk*             m_pchkCur;
+        TChunk*             m_pchkFirst;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TArena,TObject)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArenaJanitor
+//  PREFIX: jan
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TArenaJanitor
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TArenaJanitor() = delete;
+
+        TArenaJanitor
+        (
+                    TArena* const           parenaToSanitize
+        );
+
+        TArenaJanitor(const TArenaJanitor&) = delete;
+        TArenaJanitor(TArenaJanitor&&) = delete;
+
+        ~TArenaJanitor();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TArenaJanitor& operator=(const TArenaJanitor&) = delete;
+        TArenaJanitor& operator=(TArenaJanitor&&) = delete;
+        tCIDLib::TVoid* operator new(size_t) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+
+        // Keep what's been allocated since we were created
+        tCIDLib::TVoid Orphan()
+        {
+            m_parenaToSanitize = nullptr;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_markStart
+        //      The arena's position when we were created, which we roll back
+        //      to on the way out.
+        //
+        //  m_parenaToSanitize
+        //      The arena we are cleaning up, null if orphaned.
+        // -------------------------------------------------------------------
+        TArena::TMark   m_markStart;
+        TArena*         m_parenaToSanitize;
+};
+
+#pragma CIDLIB_POPPACK
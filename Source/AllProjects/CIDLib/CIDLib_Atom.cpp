@@ -0,0 +1,353 @@
+//
+// FILE NAME: CIDLib_Atom.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TAtom class and the process wide table of interned
+//  strings that atoms refer to.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The table is used by the log event and stats cache code, so it has to be
+//      very low level. It uses a kernel lock and never calls out to anything
+//      that might log or use the stats cache while it has the table locked.
+//
+//  2)  The table is never destroyed, since atoms can be used during static
+//      cleanup.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TAtom::TEntry
+//  PREFIX: ent
+//
+//  An entry in the atom table. The hash is of the text, and we link to the next
+//  entry in the same bucket.
+// ---------------------------------------------------------------------------
+struct TAtom::TEntry
+{
+    TEntry(const TStringView& strvText, const tCIDLib::TCard8 c8TextHash) :
+
+        c8Hash(c8TextHash)
+        , pentNext(nullptr)
+        , strText(strvText)
+    {
+        //
+        //  Fault in the string's cached hashes now, before anyone else can see
+        //  it, so that hashing the shared string later only ever reads them. If
+        //  the text can't be hashed, it will just fail later, as it would for
+        //  any other string.
+        //
+        try
+        {
+            [[maybe_unused]] const tCIDLib::THashVal hshCase = strText.hshCalcHash(kCIDLib::c4MaxCard);
+            [[maybe_unused]] const tCIDLib::THashVal hshNoCase = strText.hshCalcHashI(kCIDLib::c4MaxCard);
+        }
+
+        catch(TError&)
+        {
+        }
+    }
+
+    TEntry(const TEntry&) = delete;
+    TEntry(TEntry&&) = delete;
+
+    TEntry& operator=(const TEntry&) = delete;
+    TEntry& operator=(TEntry&&) = delete;
+
+    const tCIDLib::TCard8   c8Hash;
+    TEntry*                 pentNext;
+    const TString           strText;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_Atom
+    {
+        // -----------------------------------------------------------------------
+        //  The initial number of buckets. It must be a power of two, and it's
+        //  doubled whenever the entry count gets larger than the bucket count.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4InitBuckets = 256;
+
+
+        // -----------------------------------------------------------------------
+        //  The table itself. It's faulted in on first use and never destroyed.
+        // -----------------------------------------------------------------------
+        struct TAtomTable
+        {
+            TAtomTable() :
+
+                apentBuckets(new TAtom::TEntry*[c4InitBuckets])
+                , c4BucketCnt(c4InitBuckets)
+                , c4Count(0)
+            {
+                TRawMem::SetMemBuf(apentBuckets, kCIDLib::c1MinCard, tCIDLib::TCard4(sizeof(TAtom::TEntry*) * c4BucketCnt));
+            }
+
+            TKrnlRWLock         krwlSync;
+            TAtom::TEntry**     apentBuckets;
+            tCIDLib::TCard4     c4BucketCnt;
+            tCIDLib::TCard4     c4Count;
+        };
+
+        TAtomTable& tblAtoms()
+        {
+            static TAtomTable* ptblRet = new TAtomTable;
+            return *ptblRet;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  A simple janitor to lock the table, shared or exclusive.
+        // -----------------------------------------------------------------------
+        class TTableJanitor
+        {
+            public :
+                TTableJanitor(TAtomTable& tblToLock, const tCIDLib::TBoolean bExclusive) :
+
+                    m_bExclusive(bExclusive)
+                    , m_tblLocked(tblToLock)
+                {
+                    if (m_bExclusive)
+                        m_tblLocked.krwlSync.bLockExclusive();
+                    else
+                        m_tblLocked.krwlSync.bLockShared();
+                }
+
+                TTableJanitor(const TTableJanitor&) = delete;
+                TTableJanitor(TTableJanitor&&) = delete;
+
+                ~TTableJanitor()
+                {
+                    if (m_bExclusive)
+                        m_tblLocked.krwlSync.bUnlockExclusive();
+                    else
+                        m_tblLocked.krwlSync.bUnlockShared();
+                }
+
+                TTableJanitor& operator=(const TTableJanitor&) = delete;
+                TTableJanitor& operator=(TTableJanitor&&) = delete;
+
+            private :
+                tCIDLib::TBoolean   m_bExclusive;
+                TAtomTable&         m_tblLocked;
+        };
+
+
+        //
+        //  Look for an entry with the passed text. The caller must have the table
+        //  locked, in either mode.
+        //
+        const TAtom::TEntry* pentFind(  const   TAtomTable&             tblSrc
+                                        , const tCIDLib::TCh* const     pszText
+                                        , const tCIDLib::TCard4         c4Len
+                                        , const tCIDLib::TCard8         c8Hash)
+        {
+            const TAtom::TEntry* pentCur = tblSrc.apentBuckets[tCIDLib::TCard4(c8Hash & (tblSrc.c4BucketCnt - 1))];
+            while (pentCur)
+            {
+                if ((pentCur->c8Hash == c8Hash)
+                &&  (pentCur->strText.c4Length() == c4Len)
+                &&  TRawStr::bCompareStrN(pentCur->strText.pszBuffer(), pszText, c4Len))
+                {
+                    return pentCur;
+                }
+                pentCur = pentCur->pentNext;
+            }
+            return nullptr;
+        }
+
+
+        //
+        //  Double the bucket count and relink all of the entries into the new
+        //  buckets. The caller must have the table locked exclusively.
+        //
+        tCIDLib::TVoid GrowTable(TAtomTable& tblTar)
+        {
+            const tCIDLib::TCard4 c4NewCnt = tblTar.c4BucketCnt * 2;
+            TAtom::TEntry** apentNew = new TAtom::TEntry*[c4NewCnt];
+            TRawMem::SetMemBuf(apentNew, kCIDLib::c1MinCard, tCIDLib::TCard4(sizeof(TAtom::TEntry*) * c4NewCnt));
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < tblTar.c4BucketCnt; c4Index++)
+            {
+                TAtom::TEntry* pentCur = tblTar.apentBuckets[c4Index];
+                while (pentCur)
+                {
+                    TAtom::TEntry* pentNext = pentCur->pentNext;
+                    const tCIDLib::TCard4 c4NewInd = tCIDLib::TCard4(pentCur->c8Hash & (c4NewCnt - 1));
+                    pentCur->pentNext = apentNew[c4NewInd];
+                    apentNew[c4NewInd] = pentCur;
+                    pentCur = pentNext;
+                }
+            }
+
+            delete [] tblTar.apentBuckets;
+            tblTar.apentBuckets = apentNew;
+            tblTar.c4BucketCnt = c4NewCnt;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TAtom
+//  PREFIX: atm
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TAtom: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Look up the atom for the passed text, without adding it if it's not there.
+//  The empty string always exists, as the empty atom.
+//
+tCIDLib::TBoolean TAtom::bFind(const TStringView& strvText, TAtom& atmToFill)
+{
+    atmToFill.m_pentText = nullptr;
+
+    const tCIDLib::TCard4 c4Len = strvText.c4Length();
+    if (!c4Len)
+        return kCIDLib::True;
+
+    const tCIDLib::TCh* pszText = strvText.pszBuffer();
+    const tCIDLib::TCard8 c8Hash = TRawStr::c8HashStr64(pszText, c4Len);
+
+    CIDLib_Atom::TAtomTable& tblAtoms = CIDLib_Atom::tblAtoms();
+    CIDLib_Atom::TTableJanitor janLock(tblAtoms, kCIDLib::False);
+    atmToFill.m_pentText = CIDLib_Atom::pentFind(tblAtoms, pszText, c4Len, c8Hash);
+    return (atmToFill.m_pentText != nullptr);
+}
+
+
+// Return the number of unique strings interned so far
+tCIDLib::TCard4 TAtom::c4AtomCount()
+{
+    CIDLib_Atom::TAtomTable& tblAtoms = CIDLib_Atom::tblAtoms();
+    CIDLib_Atom::TTableJanitor janLock(tblAtoms, kCIDLib::False);
+    return tblAtoms.c4Count;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TAtom: Constructors and Destructor
+// ---------------------------------------------------------------------------
+
+//
+//  Intern the passed text. Almost always it's already there, so we first look
+//  for it with a shared lock. If not, we build the new entry outside of the lock,
+//  then lock exclusively and add it, unless someone beat us to it in between.
+//
+TAtom::TAtom(const TStringView& strvText)
+{
+    const tCIDLib::TCard4 c4Len = strvText.c4Length();
+    if (!c4Len)
+        return;
+
+    const tCIDLib::TCh* pszText = strvText.pszBuffer();
+    const tCIDLib::TCard8 c8Hash = TRawStr::c8HashStr64(pszText, c4Len);
+
+    CIDLib_Atom::TAtomTable& tblAtoms = CIDLib_Atom::tblAtoms();
+    {
+        CIDLib_Atom::TTableJanitor janLock(tblAtoms, kCIDLib::False);
+        m_pentText = CIDLib_Atom::pentFind(tblAtoms, pszText, c4Len, c8Hash);
+        if (m_pentText)
+            return;
+    }
+
+    TEntry* pentNew = new TEntry(strvText, c8Hash);
+    {
+        CIDLib_Atom::TTableJanitor janLock(tblAtoms, kCIDLib::True);
+        m_pentText = CIDLib_Atom::pentFind(tblAtoms, pszText, c4Len, c8Hash);
+        if (!m_pentText)
+        {
+            TEntry*& pentHead = tblAtoms.apentBuckets[tCIDLib::TCard4(c8Hash & (tblAtoms.c4BucketCnt - 1))];
+            pentNew->pentNext = pentHead;
+            pentHead = pentNew;
+            m_pentText = pentNew;
+            pentNew = nullptr;
+
+            tblAtoms.c4Count++;
+            if (tblAtoms.c4Count > tblAtoms.c4BucketCnt)
+                CIDLib_Atom::GrowTable(tblAtoms);
+        }
+    }
+
+    // If someone else added it first, toss ours
+    delete pentNew;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TAtom: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TCard4 TAtom::c4Length() const
+{
+    if (!m_pentText)
+        return 0;
+    return m_pentText->strText.c4Length();
+}
+
+
+// This is the same as the 64 bit hash of the text, for the empty atom as well
+tCIDLib::TCard8 TAtom::c8Hash() const
+{
+    if (!m_pentText)
+    {
+        static const tCIDLib::TCard8 c8EmptyHash = TRawStr::c8HashStr64(kCIDLib::pszEmptyZStr, 0);
+        return c8EmptyHash;
+    }
+    return m_pentText->c8Hash;
+}
+
+
+tCIDLib::THashVal TAtom::hshCalcHash(const tCIDLib::TCard4 c4Modulus) const
+{
+    return tCIDLib::THashVal(c8Hash() % c4Modulus);
+}
+
+
+const tCIDLib::TCh* TAtom::pszText() const
+{
+    if (!m_pentText)
+        return kCIDLib::pszEmptyZStr;
+    return m_pentText->strText.pszBuffer();
+}
+
+
+const TString& TAtom::strText() const
+{
+    if (!m_pentText)
+        return TString::strEmpty();
+    return m_pentText->strText;
+}
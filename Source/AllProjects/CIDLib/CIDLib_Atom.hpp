@@ -0,0 +1,162 @@
+//
+// FILE NAME: CIDLib_Atom.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TAtom class, which is a handle to an interned
+//  string. There is a process wide, thread safe table of unique strings, and an
+//  atom is just a pointer to an entry in that table. So any two atoms created
+//  from the same text refer to the same entry, and comparing them is just a
+//  pointer compare. Copying one is just a pointer copy, and the text is stored
+//  once no matter how many atoms refer to it.
+//
+//  This is for identifiers that get repeated all over the place, such as
+//  facility and source file names, and stats cache keys. The text can
+//  be gotten back out, as a TString that lives as long as the process, so it
+//  can be returned by reference.
+//
+//  The entries keep a 64 bit hash of the text, so hashing an atom is free. Use
+//  TAtomKeyOps to use them as keys in the hashed collections.
+//
+//  A default constructed atom is the empty atom. Interning an empty string gives
+//  back the empty atom as well, so they compare equal.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Entries are never removed, so only intern text that comes from a bounded
+//      set. Don't intern arbitrary user or document content, or things like
+//      thread names that are often unique, since that would just grow forever.
+//
+//  2)  Atoms are case sensitive. 'Foo' and 'foo' are different atoms.
+//
+//  3)  Equality is identity, not ordering. There is no less than, since the
+//      entry addresses have no meaningful order. Compare the text if sorting
+//      is needed.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TAtom
+//  PREFIX: atm
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TAtom
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Public class types
+        //
+        //  The table entry that an atom refers to. It's opaque to everyone but
+        //  us.
+        // -------------------------------------------------------------------
+        struct TEntry;
+
+
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        [[nodiscard]] static tCIDLib::TBoolean bFind
+        (
+            const   TStringView&            strvText
+            ,       TAtom&                  atmToFill
+        );
+
+        [[nodiscard]] static tCIDLib::TCard4 c4AtomCount();
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TAtom() = default;
+
+        explicit TAtom
+        (
+            const   TStringView&            strvText
+        );
+
+        TAtom(const TAtom&) = default;
+        TAtom(TAtom&&) = default;
+
+        ~TAtom() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TAtom& operator=(const TAtom&) = default;
+        TAtom& operator=(TAtom&&) = default;
+
+        tCIDLib::TBoolean operator==(const TAtom& atmSrc) const
+        {
+            return (m_pentText == atmSrc.m_pentText);
+        }
+
+        tCIDLib::TBoolean operator!=(const TAtom& atmSrc) const
+        {
+            return (m_pentText != atmSrc.m_pentText);
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        [[nodiscard]] tCIDLib::TBoolean bIsEmpty() const
+        {
+            return (m_pentText == nullptr);
+        }
+
+        [[nodiscard]] tCIDLib::TCard4 c4Length() const;
+
+        [[nodiscard]] tCIDLib::TCard8 c8Hash() const;
+
+        [[nodiscard]] tCIDLib::THashVal hshCalcHash
+        (
+            const   tCIDLib::TCard4         c4Modulus
+        )   const;
+
+        [[nodiscard]] const tCIDLib::TCh* pszText() const;
+
+        [[nodiscard]] const TString& strText() const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private constructors
+        // -------------------------------------------------------------------
+        explicit TAtom(const TEntry* const pentText) :
+
+            m_pentText(pentText)
+        {
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_pentText
+        //      The table entry we refer to, or null if we are the empty atom.
+        //      Entries live as long as the process, so we never have to worry
+        //      about this going bad.
+        // -------------------------------------------------------------------
+        const TEntry*   m_pentText = nullptr;
+};
+
+#pragma CIDLIB_POPPACK
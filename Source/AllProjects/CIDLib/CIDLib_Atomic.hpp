@@ -34,6 +34,16 @@
 
 namespace TAtomic
 {
+    inline tCIDLib::TVoid AcquireFence()
+    {
+        TRawMem::AcquireFence();
+    }
+
+    inline tCIDLib::TCard4 c4AcquireGet(const tCIDLib::TCard4& c4ToGet)
+    {
+        return TRawMem::c4AcquireGet(c4ToGet);
+    }
+
     inline tCIDLib::TCard4
     c4CompareAndExchange(       tCIDLib::TCard4&    c4ToFill
                         , const tCIDLib::TCard4     c4New
@@ -48,6 +58,11 @@ namespace TAtomic
         return TRawMem::c4Exchange(c4ToFill, c4New);
     }
 
+    inline tCIDLib::TCard4 c4RelaxedGet(const tCIDLib::TCard4& c4ToGet)
+    {
+        return TRawMem::c4RelaxedGet(c4ToGet);
+    }
+
     CIDLIBEXP tCIDLib::TCard4 c4SafeAcquire
     (
                     tCIDLib::TCard4&    c4Target
@@ -58,6 +73,16 @@ namespace TAtomic
                     tCIDLib::TCard4&    c4Target
     );
 
+    inline tCIDLib::TVoid RelaxedSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New)
+    {
+        TRawMem::RelaxedSet(c4ToSet, c4New);
+    }
+
+    inline tCIDLib::TVoid ReleaseSet(tCIDLib::TCard4& c4ToSet, const tCIDLib::TCard4 c4New)
+    {
+        TRawMem::ReleaseSet(c4ToSet, c4New);
+    }
+
 
     template <typename T> T* pExchangePtr(T** ppToFill, T* const pNew)
     {
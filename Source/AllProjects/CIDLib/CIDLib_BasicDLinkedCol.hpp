@@ -514,19 +514,19 @@ template <typename TElem> class TBasicDLinkedCol : public TCollection<TElem>
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return m_llstCol.bIsEmpty();
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return m_llstCol.c4ElemCount();
         }
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return new TCursor(this);
         }
 
@@ -710,7 +710,7 @@ template <typename TElem> class TBasicDLinkedCol : public TCollection<TElem>
 
         const TElem& objPeekAtBottom() const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if there are any nodes. If not, throw an exception
             if (m_llstCol.bIsEmpty())
@@ -738,7 +738,7 @@ template <typename TElem> class TBasicDLinkedCol : public TCollection<TElem>
 
         const TElem& objPeekAtTop() const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if there are any nodes. If not, throw an exception
             if (m_llstCol.bIsEmpty())
@@ -485,13 +485,13 @@ template <typename TElem> class TBasicDLinkedRefCol : public TRefCollection<TEle
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsEmpty() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_llstCol.bIsEmpty();
         }
 
         tCIDLib::TCard4 c4ElemCount() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_llstCol.c4ElemCount();
         }
 
@@ -520,7 +520,7 @@ template <typename TElem> class TBasicDLinkedRefCol : public TRefCollection<TEle
 
         [[nodiscard]] TConstCursor<TElem>* pcursNew() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return new TConstCursor<TElem>(this);
         }
 
@@ -745,7 +745,7 @@ template <typename TElem> class TBasicDLinkedRefCol : public TRefCollection<TEle
 
         const TElem* pobjPeekAtBottom() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             // See if there are any nodes. If not, throw an exception
             if (m_llstCol.bIsEmpty())
@@ -773,7 +773,7 @@ template <typename TElem> class TBasicDLinkedRefCol : public TRefCollection<TEle
 
         const TElem* pobjPeekAtTop() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             // See if there are any nodes. If not, throw an exception
             if (m_llstCol.bIsEmpty())
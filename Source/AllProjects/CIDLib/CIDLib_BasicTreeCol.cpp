@@ -55,11 +55,14 @@ TBaseTreeNode::~TBaseTreeNode()
 // ---------------------------------------------------------------------------
 //  TBaseTreeNode: Public, non-virtual methods
 // ---------------------------------------------------------------------------
+//
+//  We don't fault it in here, since this is const and shared readers of the tree
+//  can call it at the same time. If not set, we just return an empty string.
+//
 const TString& TBaseTreeNode::strDescription() const
 {
-    // Fault in if needed
     if (!m_pstrDescription)
-        m_pstrDescription = new TString;
+        return TString::strEmpty();
     return *m_pstrDescription;
 }
 
@@ -145,7 +145,7 @@ class CIDLIBEXP TBaseTreeNode : public TObject
         //      Each node can have an optional descriptive name. This allows
         //      browsing the tree without having to get into the actual data.
         //      Since it might not be used in some cases, it is faulted in
-        //      upon first use.
+        //      when first set.
         //
         //  m_strName
         //      This is the name of this node. It is used to address this
@@ -153,7 +153,7 @@ class CIDLIBEXP TBaseTreeNode : public TObject
         //      of peers.
         // -------------------------------------------------------------------
         tCIDLib::ETreeNodes m_eType;
-        mutable TString*    m_pstrDescription;
+        TString*            m_pstrDescription;
         TString             m_strName;
 
 
@@ -1734,13 +1734,13 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsEmpty() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return ((m_c4TCount + m_c4NTCount) == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             // Return cum of terminal and non-terminal nodes
             return m_c4TCount + m_c4NTCount;
@@ -1778,7 +1778,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const override
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return new TCursor(this);
         }
 
@@ -1788,7 +1788,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bCasePath() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_bCasePath;
         }
 
@@ -1798,7 +1798,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strToCheck, CID_FILE, CID_LINE);
 
             // Looks ok, so lets lock and try to find it
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             tCIDLib::TCard4 c4Dummy;
             return (pnodeFindNode(strToCheck, c4Dummy) != nullptr);
         }
@@ -1810,7 +1810,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strToCheck, CID_FILE, CID_LINE);
 
             // Looks ok, so lets lock and try to find it
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             tCIDLib::TCard4 c4Dummy;
             TNode* pnodeTmp = pnodeFindNode(strToCheck, c4Dummy);
             if (pnodeTmp)
@@ -1820,13 +1820,13 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
 
         tCIDLib::TBoolean bSorted() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_bSorted;
         }
 
         tCIDLib::TCard4 c4NonTerminalCount() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_c4NTCount;
         }
 
@@ -1836,7 +1836,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strScopePath, CID_FILE, CID_LINE);
 
             // Looks ok, so lets lock the collection and start working
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             // Find the node and make sure it's a scope, casting it to the right type
             tCIDLib::TCard4 c4Dummy;
@@ -1854,7 +1854,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
 
         tCIDLib::TCard4 c4TerminalCount() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_c4TCount;
         }
 
@@ -2018,7 +2018,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strPath, CID_FILE, CID_LINE);
 
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             tCIDLib::TCard4 c4Dummy;
             return pnodeFindNode(strPath, c4Dummy, kCIDLib::True)->eType();
         }
@@ -2115,7 +2115,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strPath, CID_FILE, CID_LINE);
 
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             tCIDLib::TCard4 c4Dummy;
             const TNode* pnodeAt = pnodeFindNode(strPath, c4Dummy, kCIDLib::True);
@@ -2167,7 +2167,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strPath, CID_FILE, CID_LINE);
 
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             tCIDLib::TCard4 c4Dummy;
             const TNode* pnodeAt = pnodeFindNode(strPath, c4Dummy, kCIDLib::False);
@@ -2195,7 +2195,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strPath, CID_FILE, CID_LINE);
 
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             tCIDLib::TCard4 c4Dummy;
             return pnodeFindNode(strPath, c4Dummy, kCIDLib::False);
@@ -2286,7 +2286,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
         const TNodeNT* pnodeRoot() const
         {
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_pnodeRoot;
         }
 
@@ -2334,7 +2334,7 @@ template <typename TElem> class TBasicTreeCol : public TCollection<TElem>
             TBasicTreeHelpers::CheckPath(strPath, CID_FILE, CID_LINE);
 
             // Looks ok, so lock the collection
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             tCIDLib::TCard4 c4Dummy;
             return pnodeFindNode(strPath, c4Dummy, kCIDLib::True)->strDescription();
         }
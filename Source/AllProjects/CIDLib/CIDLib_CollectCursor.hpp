@@ -117,7 +117,7 @@ template <typename TElem> class TColCursor : public TCursorBase
                 return kCIDLib::True;
 
             // Lock the collection
-            TLocker lockrCol(m_pcolBaseCurs);
+            TSharedLocker lockrCol(m_pcolBaseCurs);
             return m_pcolBaseCurs->bIsEmpty();
         }
 
@@ -136,7 +136,7 @@ template <typename TElem> class TColCursor : public TCursorBase
             this->CheckInitialized(CID_FILE, CID_LINE);
 
             // Lock the collection and check the serial number
-            TLocker lockrCol(m_pcolBaseCurs);
+            TSharedLocker lockrCol(m_pcolBaseCurs);
             CheckSerialNum(m_pcolBaseCurs->c4SerialNum(), CID_FILE, CID_LINE);
             return m_pcolBaseCurs->c4ElemCount();
         }
@@ -42,6 +42,28 @@ RTTIDecls(TFundColBase,TCollectionBase)
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_Collection
+    {
+        // Create the right type of lock, if any, for a thread safety state
+        MLockable* pmlockMakeSync(const tCIDLib::EMTStates eState)
+        {
+            if (eState == tCIDLib::EMTStates::Safe)
+                return new TMutex;
+
+            if (eState == tCIDLib::EMTStates::SharedSafe)
+                return new TRWLock;
+            return nullptr;
+        }
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TColPubSubInfo
 //  PREFIX: colpsi
@@ -107,8 +129,8 @@ tCIDLib::TVoid TCollectionBase::BadStoredCount(const TClass& clsCol)
 // ---------------------------------------------------------------------------
 TCollectionBase::~TCollectionBase()
 {
-    if (m_pmtxLock)
-        delete m_pmtxLock;
+    if (m_pmlockSync)
+        delete m_pmlockSync;
 
     // If we registered a pub/sub topic, then clean that up
     if (m_ppstopReport)
@@ -134,7 +156,7 @@ tCIDLib::TCard4 TCollectionBase::c4SerialNum() const
 {
     if (bIsMTSafe())
     {
-        TLocker lockrCol(this);
+        TSharedLocker lockrCol(this);
         tCIDLib::TCard4 c4Ret = m_c4SerialNum;
         return c4Ret;
     }
@@ -323,11 +345,10 @@ TCollectionBase::TCollectionBase(const tCIDLib::EMTStates eMTSafe) :
 
     m_bInBlockMode(kCIDLib::False)
     , m_c4SerialNum(1)
-    , m_pmtxLock(nullptr)
+    , m_eMTSafe(eMTSafe)
+    , m_pmlockSync(CIDLib_Collection::pmlockMakeSync(eMTSafe))
     , m_ppstopReport(nullptr)
 {
-    if (eMTSafe == tCIDLib::EMTStates::Safe)
-        m_pmtxLock = new TMutex;
 }
 
 
@@ -341,15 +362,15 @@ TCollectionBase::TCollectionBase(const TCollectionBase& colSrc) :
 
     m_bInBlockMode(kCIDLib::False)
     , m_c4SerialNum(1)
-    , m_pmtxLock(nullptr)
+    , m_eMTSafe(colSrc.m_eMTSafe)
+    , m_pmlockSync(nullptr)
     , m_ppstopReport(nullptr)
 {
     // The source cannot be in a block operation
     CIDAssert(!colSrc.m_bInBlockMode, L"Collection was constructed from while in a block operation");
 
-    // If the source is safe, make us safe
-    if (colSrc.m_pmtxLock)
-        m_pmtxLock = new TMutex;
+    // If the source is safe, make us safe in the same way
+    m_pmlockSync = CIDLib_Collection::pmlockMakeSync(m_eMTSafe);
 }
 
 
@@ -950,23 +971,18 @@ TCollectionBase::PublishSwap(const  tCIDLib::TCard4 c4At1
 
 tCIDLib::TVoid TCollectionBase::SetMTState(const tCIDLib::EMTStates eState)
 {
-    if (eState == tCIDLib::EMTStates::Safe)
-    {
-        if (!m_pmtxLock)
-        {
-            m_pmtxLock = new TMutex;
-            m_c4SerialNum++;
-        }
-    }
-     else
+    // If it's not changing, nothing to do
+    if (eState == m_eMTSafe)
+        return;
+
+    if (m_pmlockSync)
     {
-        if (m_pmtxLock)
-        {
-            delete m_pmtxLock;
-            m_pmtxLock = nullptr;
-            m_c4SerialNum++;
-        }
+        delete m_pmlockSync;
+        m_pmlockSync = nullptr;
     }
+    m_pmlockSync = CIDLib_Collection::pmlockMakeSync(eState);
+    m_eMTSafe = eState;
+    m_c4SerialNum++;
 }
 
 
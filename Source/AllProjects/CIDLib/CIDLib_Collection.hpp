@@ -112,7 +112,7 @@ class TCollection : public TCollectionBase, public MDuplicable
         //
         template <typename IterCB> tCIDLib::TBoolean bForEach(IterCB iterCB) const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             TColCursor<TElem>* pcursEach = pcursNew();
             TJanitor<TColCursor<TElem>> janCursor(pcursEach);
             while (pcursEach->bIsValid())
@@ -339,7 +339,7 @@ template <typename TElem> class TRefCollection : public TCollectionBase
         //
         template <typename IterCB> tCIDLib::TBoolean bForEach(IterCB iterCB) const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             TColCursor<TElem>* pcursEach = pcursNew();
             TJanitor<TColCursor<TElem>> janCursor(pcursEach);
             while (pcursEach->bIsValid())
@@ -343,25 +343,41 @@ class CIDLIBEXP TCollectionBase : public TObject, public MLockable
         //  no lock. Derived classes that provide locking will override these.
         //  This lets all collections (internally and externally) be locked via
         //  the standard MLockable interface and TLocker lock janitor.
+        //
+        //  If we are SharedSafe, then our lock is a reader/writer lock, and read
+        //  only operations use TSharedLocker so that they can run in parallel.
+        //  Otherwise the shared versions are the same as the regular ones.
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bTryLock(const tCIDLib::TCard4 c4WaitMS) const final
         {
-            if (m_pmtxLock)
-                return m_pmtxLock->bTryLock(c4WaitMS);
+            if (m_pmlockSync)
+                return m_pmlockSync->bTryLock(c4WaitMS);
 
             return kCIDLib::True;
         }
 
         tCIDLib::TVoid Lock(const tCIDLib::TCard4 c4WaitMS) const final
         {
-            if (m_pmtxLock)
-                m_pmtxLock->Lock(c4WaitMS);
+            if (m_pmlockSync)
+                m_pmlockSync->Lock(c4WaitMS);
+        }
+
+        tCIDLib::TVoid LockShared(const tCIDLib::TCard4 c4WaitMS) const final
+        {
+            if (m_pmlockSync)
+                m_pmlockSync->LockShared(c4WaitMS);
         }
 
         tCIDLib::TVoid Unlock() const override
         {
-            if (m_pmtxLock)
-                m_pmtxLock->Unlock();
+            if (m_pmlockSync)
+                m_pmlockSync->Unlock();
+        }
+
+        tCIDLib::TVoid UnlockShared() const final
+        {
+            if (m_pmlockSync)
+                m_pmlockSync->UnlockShared();
         }
 
 
@@ -385,7 +401,7 @@ class CIDLIBEXP TCollectionBase : public TObject, public MLockable
 
         tCIDLib::TBoolean bIsMTSafe() const
         {
-            return (m_pmtxLock != nullptr);
+            return (m_pmlockSync != nullptr);
         }
 
         tCIDLib::TBoolean bPublishEnabled() const
@@ -403,9 +419,7 @@ class CIDLIBEXP TCollectionBase : public TObject, public MLockable
 
         tCIDLib::EMTStates eMTSafe() const
         {
-            if (m_pmtxLock == nullptr)
-                return tCIDLib::EMTStates::Unsafe;
-            return tCIDLib::EMTStates::Safe;
+            return m_eMTSafe;
         }
 
         tCIDLib::TVoid PublishBlockChanged
@@ -707,8 +721,13 @@ class CIDLIBEXP TCollectionBase : public TObject, public MLockable
         //      needs to watch for changes. They can set their last serial number to
         //      zero, and it will always trigger an initial inequality.
         //
-        //  m_pmtxLock
+        //  m_eMTSafe
+        //      The thread safety state we were set to. It tells us what type of
+        //      lock m_pmlockSync is, if any.
+        //
+        //  m_pmlockSync
         //      If this collection is thread safe, this is allocated, else null.
+        //      It's a mutex if Safe, or a TRWLock if SharedSafe.
         //
         //  m_ppstopReport
         //      A topic to report changes to subscribers. See the header comments above
@@ -716,7 +735,8 @@ class CIDLIBEXP TCollectionBase : public TObject, public MLockable
         // -------------------------------------------------------------------
         tCIDLib::TBoolean   m_bInBlockMode;
         tCIDLib::TCard4     m_c4SerialNum;
-        TMutex*             m_pmtxLock;
+        tCIDLib::EMTStates  m_eMTSafe;
+        MLockable*          m_pmlockSync;
         TPubSubTopic*       m_ppstopReport;
 
 
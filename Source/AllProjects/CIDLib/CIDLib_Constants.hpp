@@ -46,6 +46,34 @@ namespace kCIDLib
     constexpr tCIDLib::TCard4   c4DefMaxBufferSz = kCIDLib::c4Sz_16M;
 
 
+    // -----------------------------------------------------------------------
+    //  The default grain size for the parallel collection algorithms, i.e. the
+    //  smallest number of elements that is worth farming out to a thread pool
+    //  worker. Below twice this the algorithms just do the work serially. We
+    //  also limit how many chunks per worker the work is broken into, since more
+    //  than that just adds overhead.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4DefParGrain           = 4096;
+    constexpr tCIDLib::TCard4   c4ParChunksPerWorker    = 4;
+
+
+    // -----------------------------------------------------------------------
+    //  How many times a sequence lock reader will spin waiting for a write to
+    //  complete before it starts yielding to let the writer run.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4SeqLockSpins          = 128;
+
+
+    // -----------------------------------------------------------------------
+    //  Arena defaults. The default chunk size, the largest alignment that can
+    //  be asked for, and how many free chunks of the default size are kept
+    //  around for reuse by other arenas.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4DefArenaChunkSz       = 0x10000;
+    constexpr tCIDLib::TCard4   c4MaxArenaAlign         = 64;
+    constexpr tCIDLib::TCard4   c4MaxArenaCacheChunks   = 32;
+
+
     // -----------------------------------------------------------------------
     //  The thread wait list provides a 'reason' mechanism, so that threads
     //  can block for a reason and threads that are blocked for that reason
@@ -110,6 +138,23 @@ namespace kCIDLib
 
     constexpr const tCIDLib::TCh* const   pszStat_Scope_Core          = L"/Stats/Core/";
     constexpr const tCIDLib::TCh* const   pszStat_Core_ThreadCount    = L"/Stats/Core/ThreadCnt";
+
+    constexpr const tCIDLib::TCh* const   pszStat_Scope_TPool         = L"/Stats/Core/ThreadPool/";
+    constexpr const tCIDLib::TCh* const   pszStat_TPool_AvgLatencyUS  = L"/Stats/Core/ThreadPool/AvgLatencyUS";
+    constexpr const tCIDLib::TCh* const   pszStat_TPool_MaxLatencyUS  = L"/Stats/Core/ThreadPool/MaxLatencyUS";
+    constexpr const tCIDLib::TCh* const   pszStat_TPool_QueueDepth    = L"/Stats/Core/ThreadPool/QueueDepth";
+    constexpr const tCIDLib::TCh* const   pszStat_TPool_Steals        = L"/Stats/Core/ThreadPool/Steals";
+    constexpr const tCIDLib::TCh* const   pszStat_TPool_TasksRun      = L"/Stats/Core/ThreadPool/TasksRun";
+
+    constexpr const tCIDLib::TCh* const   pszStat_Scope_Slab          = L"/Stats/Core/SlabAlloc/";
+    constexpr const tCIDLib::TCh* const   pszStat_Slab_Allocs         = L"/Stats/Core/SlabAlloc/Allocs";
+    constexpr const tCIDLib::TCh* const   pszStat_Slab_DepotTrips     = L"/Stats/Core/SlabAlloc/DepotTrips";
+    constexpr const tCIDLib::TCh* const   pszStat_Slab_Frees          = L"/Stats/Core/SlabAlloc/Frees";
+    constexpr const tCIDLib::TCh* const   pszStat_Slab_SlabBytes      = L"/Stats/Core/SlabAlloc/SlabBytes";
+
+    constexpr const tCIDLib::TCh* const   pszStat_Scope_Arena         = L"/Stats/Core/Arena/";
+    constexpr const tCIDLib::TCh* const   pszStat_Arena_CachedChunks  = L"/Stats/Core/Arena/CachedChunks";
+    constexpr const tCIDLib::TCh* const   pszStat_Arena_ChunkBytes    = L"/Stats/Core/Arena/ChunkBytes";
 }
 
 namespace tCIDLib
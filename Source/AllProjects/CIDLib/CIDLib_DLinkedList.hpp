@@ -99,6 +99,7 @@ class CIDLIBEXP TDLstNode : public TObject
         // -------------------------------------------------------------------
         //  Do any needed magic macros
         // -------------------------------------------------------------------
+        SlabAllocDefs()
         RTTIDefs(TDLstNode,TObject)
 };
 
@@ -584,7 +584,7 @@ template <typename TElem> class TFixedSizePool : public TObject
             , m_strName(strName)
         {
             // If MT safe, then allocate the critical section
-            if (eMTSafe == tCIDLib::EMTStates::Safe)
+            if (eMTSafe != tCIDLib::EMTStates::Unsafe)
                 m_pmtxSync = new TMutex;
          }
 
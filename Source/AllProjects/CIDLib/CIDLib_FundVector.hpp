@@ -25,6 +25,10 @@
 //
 //  ONLY use it for fundamental types, not objects or structures.
 //
+//  It can optionally be given an arena to allocate its buffer from, for request
+//  scoped work. When it grows, the old buffer is just abandoned in the arena.
+//  The arena must outlive the vector. Copies of the vector use the heap.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -58,6 +62,7 @@ class TFundVector : public TFundColBase, public MDuplicable
 
             m_c4AllocSize(32)
             , m_c4CurIndex(0)
+            , m_parenaBuf(nullptr)
             , m_ptElements(nullptr)
         {
             //
@@ -71,6 +76,7 @@ class TFundVector : public TFundColBase, public MDuplicable
 
             m_c4AllocSize(tCIDLib::c4EnumOrd(tInitSize))
             , m_c4CurIndex(0)
+            , m_parenaBuf(nullptr)
             , m_ptElements(nullptr)
         {
             // Force the init size to a default if its zero
@@ -84,10 +90,23 @@ class TFundVector : public TFundColBase, public MDuplicable
             m_ptElements = new TElem[m_c4AllocSize];
         }
 
+        TFundVector(const TIndex tInitSize, TArena* const parenaBuf) :
+
+            m_c4AllocSize(tCIDLib::c4EnumOrd(tInitSize))
+            , m_c4CurIndex(0)
+            , m_parenaBuf(parenaBuf)
+            , m_ptElements(nullptr)
+        {
+            if (!m_c4AllocSize)
+                m_c4AllocSize = 32;
+            m_ptElements = ptAllocBuf(m_c4AllocSize);
+        }
+
         TFundVector(const TMyType& fcolSrc) :
 
             m_c4AllocSize(fcolSrc.m_c4AllocSize)
             , m_c4CurIndex(fcolSrc.m_c4CurIndex)
+            , m_parenaBuf(nullptr)
             , m_ptElements(nullptr)
         {
             m_ptElements = new TElem[m_c4AllocSize];
@@ -103,6 +122,7 @@ class TFundVector : public TFundColBase, public MDuplicable
 
             m_c4AllocSize(1)
             , m_c4CurIndex(0)
+            , m_parenaBuf(nullptr)
             , m_ptElements(new TElem[1])
         {
             *this = tCIDLib::ForceMove(fcolSrc);
@@ -112,7 +132,7 @@ class TFundVector : public TFundColBase, public MDuplicable
         {
             try
             {
-                delete [] m_ptElements;
+                FreeBuf(m_ptElements);
                 m_ptElements = nullptr;
             }
 
@@ -138,9 +158,9 @@ class TFundVector : public TFundColBase, public MDuplicable
             // Reallocate if we aren't big enough
             if (m_c4AllocSize < fcolSrc.m_c4CurIndex)
             {
-                delete [] m_ptElements;
+                FreeBuf(m_ptElements);
                 m_c4AllocSize = fcolSrc.m_c4CurIndex + 32;
-                m_ptElements = new TElem[m_c4AllocSize];
+                m_ptElements = ptAllocBuf(m_c4AllocSize);
             }
 
             m_c4CurIndex = fcolSrc.m_c4CurIndex;
@@ -163,6 +183,7 @@ class TFundVector : public TFundColBase, public MDuplicable
 
                 tCIDLib::Swap(m_c4AllocSize, fcolSrc.m_c4AllocSize);
                 tCIDLib::Swap(m_c4CurIndex, fcolSrc.m_c4CurIndex);
+                tCIDLib::Swap(m_parenaBuf, fcolSrc.m_parenaBuf);
                 tCIDLib::Swap(m_ptElements, fcolSrc.m_ptElements);
 
                 this->PublishBlockAdded(0, m_c4CurIndex);
@@ -562,6 +583,22 @@ class TFundVector : public TFundColBase, public MDuplicable
             this->PublishBlockAdded(c4At, c4SrcCount);
         }
 
+        //
+        //  Same as Sort() below, but the sort is spread across the shared thread
+        //  pool. If the count is below twice the grain size, it's just done
+        //  serially.
+        //
+        template <typename TCompFunc>
+        tCIDLib::TVoid ParSort(         TCompFunc           pfnComp
+                                , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain)
+        {
+            if (m_c4CurIndex < 2)
+                return;
+
+            TArrayOps::TParSort<TElem>(m_ptElements, m_c4CurIndex, pfnComp, c4Grain);
+            this->PublishReorder();
+        }
+
         const TElem* ptElements() const
         {
             return m_ptElements;
@@ -676,6 +713,20 @@ class TFundVector : public TFundColBase, public MDuplicable
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid FreeBuf(TElem* const ptToFree)
+        {
+            // Arena buffers are just abandoned
+            if (!m_parenaBuf)
+                delete [] ptToFree;
+        }
+
+        TElem* ptAllocBuf(const tCIDLib::TCard4 c4Count)
+        {
+            if (m_parenaBuf)
+                return m_parenaBuf->ptAllocArray<TElem>(c4Count);
+            return new TElem[c4Count];
+        }
+
         tCIDLib::TVoid CheckExpand( const   tCIDLib::TCard4     c4NewNeeded
                                     , const tCIDLib::TBoolean   bKeepOld)
         {
@@ -686,7 +737,7 @@ class TFundVector : public TFundColBase, public MDuplicable
                 (
                     (m_c4AllocSize + c4NewNeeded) * 1.5
                 );
-                TElem* ptNewArray = new TElem[c4NewSize];
+                TElem* ptNewArray = ptAllocBuf(c4NewSize);
 
                 // If told to, copy over the old stuff, and then delete it
                 if (bKeepOld)
@@ -696,7 +747,7 @@ class TFundVector : public TFundColBase, public MDuplicable
                         ptNewArray, m_ptElements, sizeof(TElem) * m_c4AllocSize
                     );
                 }
-                delete [] m_ptElements;
+                FreeBuf(m_ptElements);
 
                 // And store the new info
                 m_ptElements = ptNewArray;
@@ -720,11 +771,16 @@ class TFundVector : public TFundColBase, public MDuplicable
         //      be placed (and also the current count of elements in the
         //      vector.)
         //
+        //  m_parenaBuf
+        //      If set, our buffer is allocated from this arena instead of the
+        //      heap. We don't own it.
+        //
         //  m_ptElements
         //      This is the allocated array of m_c4AllocSize values.
         // -------------------------------------------------------------------
         tCIDLib::TCard4     m_c4AllocSize;
         tCIDLib::TCard4     m_c4CurIndex;
+        TArena*             m_parenaBuf;
         TElem*              m_ptElements;
 
 
@@ -758,8 +814,8 @@ operator>>(TBinInStream& strmToReadFrom, TFundVector<TElem, TIndex>& colToStream
     if (colToStream.m_c4CurIndex > colToStream.m_c4AllocSize)
     {
         colToStream.m_c4AllocSize = colToStream.m_c4CurIndex + 32;
-        delete [] colToStream.m_ptElements;
-        colToStream.m_ptElements = new TElem[colToStream.m_c4AllocSize];
+        colToStream.FreeBuf(colToStream.m_ptElements);
+        colToStream.m_ptElements = colToStream.ptAllocBuf(colToStream.m_c4AllocSize);
     }
 
     // And read in the stored elements
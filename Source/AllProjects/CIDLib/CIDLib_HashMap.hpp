@@ -23,6 +23,12 @@
 //  Since the key is always explicitly external from the data, we don't need
 //  a key extraction function from the user.
 //
+//  It can optionally be given an arena to allocate its nodes from, for request
+//  scoped maps that are built up and then thrown away. Removed nodes just have
+//  their destructor run, and the space comes back when the arena is reset. The
+//  arena must outlive the map (or at least be reset only after the map is
+//  emptied or destroyed.) Copies of the map use the heap.
+//
 // CAVEATS/GOTCHAS:
 //
 //  1)  Note that these classes cannot use the various magic macros because of
@@ -171,6 +177,12 @@ template <typename TKey, class TValue> class THashMapNode
         // -------------------------------------------------------------------
         TPair                       m_kobjPair;
         THashMapNode<TKey,TValue>*  m_pnodeNext;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        SlabAllocDefs()
 };
 
 
@@ -652,6 +664,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             , m_c4CurElements(0)
             , m_c4HashModulus(c4Modulus)
             , m_kopsToUse(kopsToUse)
+            , m_parenaNodes(nullptr)
         {
             CIDAssert(c4Modulus != 0, L"The hash modulus cannot be zero")
             try
@@ -673,6 +686,16 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             }
         }
 
+        THashMap(   const   tCIDLib::TCard4     c4Modulus
+                    , const TKeyOps&            kopsToUse
+                    ,       TArena* const       parenaNodes
+                    , const tCIDLib::EMTStates  eMTSafe = tCIDLib::EMTStates::Unsafe) :
+
+            THashMap(c4Modulus, kopsToUse, eMTSafe)
+        {
+            m_parenaNodes = parenaNodes;
+        }
+
         THashMap(const TMyType& colSrc) :
 
             TMapCollection<TElem, TKey>(colSrc)
@@ -680,6 +703,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             , m_c4CurElements(0)
             , m_c4HashModulus(colSrc.m_c4HashModulus)
             , m_kopsToUse(colSrc.m_kopsToUse)
+            , m_parenaNodes(nullptr)
         {
             try
             {
@@ -718,6 +742,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             , m_c4CurElements(0)
             , m_c4HashModulus(3)
             , m_kopsToUse(colSrc.m_kopsToUse)
+            , m_parenaNodes(nullptr)
         {
             m_apBuckets = new TNode*[m_c4HashModulus];
             TRawMem::SetMemBuf(m_apBuckets, kCIDLib::c1MinCard, sizeof(tCIDLib::TVoid*) * m_c4HashModulus);
@@ -796,6 +821,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 tCIDLib::Swap(m_c4CurElements, colSrc.m_c4CurElements);
                 tCIDLib::Swap(m_c4HashModulus, colSrc.m_c4HashModulus);
                 tCIDLib::Swap(m_kopsToUse, colSrc.m_kopsToUse);
+                tCIDLib::Swap(m_parenaNodes, colSrc.m_parenaNodes);
 
                 // Publish reload events for both
                 this->PublishReloaded();
@@ -829,13 +855,13 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return (m_c4CurElements == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
              return m_c4CurElements;
         }
 
@@ -865,7 +891,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 while (pnodeCur)
                 {
                     TNode* pnodeNext = pnodeCur->pnodeNext();
-                    delete pnodeCur;
+                    FreeNode(pnodeCur);
                     pnodeCur = pnodeNext;
                 }
                 m_apBuckets[c4BucketInd] = nullptr;
@@ -891,7 +917,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 this->DuplicateKey(kobjToAdd.objKey(), CID_FILE, CID_LINE);
 
             // Add this guy at the head of his bucket
-            m_apBuckets[hshKey] = new TNode(kobjToAdd, m_apBuckets[hshKey]);
+            m_apBuckets[hshKey] = pnodeMake(kobjToAdd, m_apBuckets[hshKey]);
             m_c4CurElements++;
 
             // Bump the serial number to invalidate cursors
@@ -902,7 +928,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return new TCursor(this);
         }
 
@@ -917,7 +943,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bFindByKey(const TKey& keyToFind, TElem& objToFill) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if the element exists
             tCIDLib::THashVal hshKey;
@@ -932,7 +958,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         tCIDLib::TBoolean bKeyExists(const TKey& keyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if the element exists
             tCIDLib::THashVal hshKey;
@@ -979,7 +1005,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 this->c4IncSerialNum();
 
                 // So we can now toast the found node and reduce the element count
-                delete pnodeToRem;
+                FreeNode(pnodeToRem);
                 pnodeToRem = nullptr;
                 m_c4CurElements--;
 
@@ -993,7 +1019,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         tCIDLib::TCard4 c4HashModulus() const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return m_c4HashModulus;
         }
 
@@ -1016,7 +1042,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 this->DuplicateKey(objKey, CID_FILE, CID_LINE);
 
             // Add this guy at the head of his bucket
-            m_apBuckets[hshKey] = new TNode(objKey, objToAdd, m_apBuckets[hshKey]);
+            m_apBuckets[hshKey] = pnodeMake(objKey, objToAdd, m_apBuckets[hshKey]);
             m_c4CurElements++;
 
             // Bump the serial number to invalidate cursors
@@ -1042,7 +1068,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             }
 
             // Add this guy at the head of his bucket
-            m_apBuckets[hshKey] = new TNode(objKey, objToAdd, m_apBuckets[hshKey]);
+            m_apBuckets[hshKey] = pnodeMake(objKey, objToAdd, m_apBuckets[hshKey]);
             m_c4CurElements++;
 
             // Bump the serial number to invalidate cursors
@@ -1070,7 +1096,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
             }
 
             // Add this guy at the head of his bucket
-            m_apBuckets[hshKey] = new TNode(objKey, objToAdd, m_apBuckets[hshKey]);
+            m_apBuckets[hshKey] = pnodeMake(objKey, objToAdd, m_apBuckets[hshKey]);
             m_c4CurElements++;
 
             // Bump the serial number to invalidate cursors
@@ -1097,7 +1123,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         const TPair& kobjFindByKey(const TKey& objKeyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objKeyToFind, hshKey);
@@ -1131,7 +1157,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 //  the node and pass it the current head, which it will make
                 //  it its next node.
                 //
-                pnodeRet = new TNode(objKey, objToFindOrAdd, m_apBuckets[hshKey]);
+                pnodeRet = pnodeMake(objKey, objToFindOrAdd, m_apBuckets[hshKey]);
                 m_apBuckets[hshKey] = pnodeRet;
                 m_c4CurElements++;
 
@@ -1154,7 +1180,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 this->DuplicateKey(kobjToAdd.objKey(), CID_FILE, CID_LINE);
 
             // Add this guy at the head of his bucket
-            m_apBuckets[hshKey] = new TNode(tCIDLib::ForceMove(kobjToAdd), m_apBuckets[hshKey]);
+            m_apBuckets[hshKey] = pnodeMake(tCIDLib::ForceMove(kobjToAdd), m_apBuckets[hshKey]);
             m_c4CurElements++;
 
             // Bump the serial number to invalidate cursors
@@ -1166,7 +1192,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
 
         const TPair* pkobjFindByKey(const TKey& objKeyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objKeyToFind, hshKey);
@@ -1228,7 +1254,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 pnodePrev->pnodeNext(pnodeToRemove->pnodeNext());
 
             // So we can now toast the found node and bump the element count
-            delete pnodeToRemove;
+            FreeNode(pnodeToRemove);
             m_c4CurElements--;
 
             // Bump the serial number to invalidate cursors
@@ -1403,6 +1429,27 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+
+        // Clean up a node, which only needs destructing if from an arena
+        tCIDLib::TVoid FreeNode(TNode* const pnodeToFree)
+        {
+            if (m_parenaNodes)
+                pnodeToFree->~TNode();
+            else
+                delete pnodeToFree;
+        }
+
+        // Create a node, from our arena if we have one, else from the heap
+        template <typename... TArgs> TNode* pnodeMake(TArgs&&... Args)
+        {
+            if (m_parenaNodes)
+            {
+                return new (m_parenaNodes->pAlloc(sizeof(TNode), alignof(TNode)))
+                       TNode(tCIDLib::Forward<TArgs>(Args)...);
+            }
+            return new TNode(tCIDLib::Forward<TArgs>(Args)...);
+        }
+
         TNode* pnodeFind(const TKey& objKeyToFind, tCIDLib::THashVal& hshKey) const
         {
             // Get the hash of the element
@@ -1473,7 +1520,7 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
                 while (pnodeSrc)
                 {
                     // Replicate this bucket's nodes
-                    pnodeCur = new TNode(pnodeSrc->objPair(), nullptr);
+                    pnodeCur = pnodeMake(pnodeSrc->objPair(), nullptr);
 
                     //
                     //  Set last node's next to this one, if there was a
@@ -1512,11 +1559,16 @@ template <typename TElem, class TKey, class TKeyOps> class THashMap
         //  m_kopsToUse
         //      A key ops object that provides all of the operations that
         //      we have to do on key field objects.
+        //
+        //  m_parenaNodes
+        //      If set, nodes are allocated from this arena instead of the heap.
+        //      We don't own it. The bucket array is always on the heap.
         // -------------------------------------------------------------------
         TNode**             m_apBuckets;
         tCIDLib::TCard4     m_c4CurElements;
         tCIDLib::TCard4     m_c4HashModulus;
         TKeyOps             m_kopsToUse;
+        TArena*             m_parenaNodes;
 };
 
 
@@ -152,6 +152,12 @@ template <typename TElem> class THashSetNode
         // -------------------------------------------------------------------
         TElem                   m_objData;
         THashSetNode<TElem>*    m_pnodeNext;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        SlabAllocDefs()
 };
 
 
@@ -828,13 +834,13 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return (m_c4CurElements == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
              return m_c4CurElements;
         }
 
@@ -904,7 +910,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return new TCursor(this);
         }
 
@@ -919,7 +925,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bHasElement(const TElem& objToCheck) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if the element exists
             tCIDLib::THashVal hshElem;
@@ -976,7 +982,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
 
         tCIDLib::TCard4 c4HashModulus() const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return m_c4HashModulus;
         }
 
@@ -988,7 +994,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
         //
         TCursor cursFind(const TElem& objToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objToFind, hshKey);
@@ -1137,7 +1143,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
 
         const TElem& objFind(const TElem& objToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             const TNode* pnodeRet = pnodeFind(objToFind, hshKey);
@@ -1196,7 +1202,7 @@ template <typename TElem, class TKeyOps> class THashSet : public TCollection<TEl
 
         const TElem* pobjFind(const TElem& objToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             const TNode* pnodeRet = pnodeFind(objToFind, hshKey);
@@ -65,9 +65,42 @@ TStringKeyOps::hshKey(  const   TString&        strToHash
     if (m_bCase)
         return strToHash.hshCalcHash(c4Modulus);
 
-    // Create a temp and lower case it and hash that
-    m_strTmp = strToHash;
-    m_strTmp.ToLower();
-    return m_strTmp.hshCalcHash(c4Modulus);
+    // This lower cases on the fly, and is cached in the string like the above
+    return strToHash.hshCalcHashI(c4Modulus);
 }
 
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TFastStringKeyOps
+//  PREFIX: kops
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TFastStringKeyOps: Constructors and destructor
+// ---------------------------------------------------------------------------
+TFastStringKeyOps::TFastStringKeyOps(const tCIDLib::TBoolean bCase) :
+
+    m_bCase(bCase)
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TFastStringKeyOps: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+TFastStringKeyOps::bCompKeys(const TString& str1, const TString& str2) const
+{
+    if (m_bCase)
+        return (str1.eCompare(str2) == tCIDLib::ESortComps::Equal);
+
+    return (str1.eCompareI(str2) == tCIDLib::ESortComps::Equal);
+}
+
+tCIDLib::THashVal
+TFastStringKeyOps::hshKey(  const   TString&        strToHash
+                            , const tCIDLib::TCard4 c4Modulus) const
+{
+    return tCIDLib::THashVal(strToHash.c8CalcHash64(m_bCase) % c4Modulus);
+}
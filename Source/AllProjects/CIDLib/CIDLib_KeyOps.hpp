@@ -93,16 +93,69 @@ class CIDLIBEXP TStringKeyOps
         //  m_bCase
         //      Normally we will do cache sensitive comparisons. But we can be told
         //      to do it insensitively.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean   m_bCase = kCIDLib::True;
+};
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TFastStringKeyOps
+//  PREFIX: kops
+//
+//  The same as TStringKeyOps, but it uses the fast 64 bit hash. It isn't the
+//  default since the hashes are different, so use it for new collections, or
+//  where the hash isn't stored or shared anywhere.
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TFastStringKeyOps
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TFastStringKeyOps() = default;
+
+        explicit TFastStringKeyOps
+        (
+            const   tCIDLib::TBoolean       bCase
+        );
+
+        TFastStringKeyOps(const TFastStringKeyOps&) = default;
+        TFastStringKeyOps(TFastStringKeyOps&&) = default;
+
+        ~TFastStringKeyOps() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TFastStringKeyOps& operator=(const TFastStringKeyOps&) = default;
+        TFastStringKeyOps& operator=(TFastStringKeyOps&&) = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCompKeys
+        (
+            const   TString&                str1
+            , const TString&                str2
+        )   const;
+
+        tCIDLib::THashVal hshKey
+        (
+            const   TString&                strToHash
+            , const tCIDLib::TCard4         c4Modulus
+        )   const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
         //
-        //  m_strTmp
-        //      If non-case sensitive, we have to upper case the keys before we do
-        //      hashing. So this is a temp to avoid creating/destroying a string
-        //      every time. It doesn't need to be copied or assigned, since it's
-        //      purely for temp use. it has to be mutable because the hash method
-        //      is const.
+        //  m_bCase
+        //      Whether we hash and compare case sensitively or not.
         // -------------------------------------------------------------------
         tCIDLib::TBoolean   m_bCase = kCIDLib::True;
-        mutable TString     m_strTmp;
 };
 
 
@@ -132,6 +185,32 @@ template <typename T> class TNumKeyOps
         }
 };
 
+
+// ---------------------------------------------------------------------------
+//   CLASS: TAtomKeyOps
+//  PREFIX: kops
+//
+//  Atoms compare by identity and carry their hash with them, so both of these
+//  are trivial. It's always case sensitive, since atoms are.
+// ---------------------------------------------------------------------------
+class TAtomKeyOps
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCompKeys(const   TAtom&  atm1
+                                    , const TAtom&  atm2) const
+        {
+            return atm1 == atm2;
+        }
+
+        tCIDLib::THashVal hshKey(const TAtom& atmToHash, const tCIDLib::TCard4 c4Modulus) const
+        {
+            return atmToHash.hshCalcHash(c4Modulus);
+        }
+};
+
 #pragma CIDLIB_POPPACK
 
 
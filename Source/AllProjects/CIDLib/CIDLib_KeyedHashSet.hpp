@@ -151,6 +151,12 @@ template <typename TElem,class TKey> class TKeyedHashSetNode
         // -------------------------------------------------------------------
         TElem                           m_objData;
         TKeyedHashSetNode<TElem,TKey>*  m_pnodeNext;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        SlabAllocDefs()
 };
 
 
@@ -897,13 +903,13 @@ class TKeyedHashSet : public TCollection<TElem>
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return (m_c4CurElements == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
              return m_c4CurElements;
         }
 
@@ -950,13 +956,13 @@ class TKeyedHashSet : public TCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return new TCursor(this);
         }
 
         [[nodiscard]] TObject* pobjDuplicate() const final
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return new TMyType(*this);
         }
 
@@ -1059,7 +1065,7 @@ class TKeyedHashSet : public TCollection<TElem>
 
         tCIDLib::TBoolean bFindByKey(const TKey& keyToFind, TElem& objToFill) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if the element exists
             tCIDLib::THashVal hshElem;
@@ -1074,7 +1080,7 @@ class TKeyedHashSet : public TCollection<TElem>
 
         tCIDLib::TBoolean bKeyExists(const TKey& keyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             // See if the element exists
             tCIDLib::THashVal hshElem;
@@ -1147,7 +1153,7 @@ class TKeyedHashSet : public TCollection<TElem>
 
         tCIDLib::TCard4 c4HashModulus() const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
             return m_c4HashModulus;
         }
 
@@ -1159,7 +1165,7 @@ class TKeyedHashSet : public TCollection<TElem>
         //
         TCursor cursFindByKey(const TKey& objKeyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objKeyToFind, hshKey);
@@ -1304,7 +1310,7 @@ class TKeyedHashSet : public TCollection<TElem>
 
         const TElem& objFindByKey(const TKey& objKeyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objKeyToFind, hshKey);
@@ -1397,7 +1403,7 @@ class TKeyedHashSet : public TCollection<TElem>
 
         const TElem* pobjFindByKey(const TKey& objKeyToFind) const
         {
-            TLocker lockrSync(this);
+            TSharedLocker lockrSync(this);
 
             tCIDLib::THashVal hshKey;
             TNode* pnodeRet = pnodeFind(objKeyToFind, hshKey);
@@ -26,6 +26,10 @@
 //  TMutex implements the lockable interface. Various other things may implement
 //  lockable, but generally will just delegate to a mutex member.
 //
+//  Lockables can optionally support shared locking, for read only access, and
+//  there's a TSharedLocker janitor for that. TRWLock is the one that really does
+//  shared locking, everyone else just does a regular lock.
+//
 //  Because locking is so often just an internal detail and not part of the actual
 //  data of the containing class, and therefore often has to be done from
 //  inside const methods. We just make the locking methods const.
@@ -84,6 +88,20 @@ class CIDLIBEXP MLockable
 
         virtual tCIDLib::TVoid Unlock() const = 0;
 
+        //
+        //  Things that can be locked for shared (read only) access can override
+        //  these. By default they are just a regular lock.
+        //
+        virtual tCIDLib::TVoid LockShared(const tCIDLib::TCard4 c4WaitMSs) const
+        {
+            Lock(c4WaitMSs);
+        }
+
+        virtual tCIDLib::TVoid UnlockShared() const
+        {
+            Unlock();
+        }
+
 
     protected :
         // -------------------------------------------------------------------
@@ -244,4 +262,77 @@ class CIDLIBEXP TLocker
         const MLockable*    m_pmlockTar;
 };
 
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TSharedLocker
+// PREFIX: lockr
+//
+//  The same as TLocker, but it locks for shared (read only) access. For
+//  lockables that don't distinguish, it's the same as a regular lock.
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TSharedLocker
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor.
+        // -------------------------------------------------------------------
+        TSharedLocker() = delete;
+
+        TSharedLocker(  const   MLockable* const    pmlockTar
+                        , const tCIDLib::TCard4     c4Timeout = kCIDLib::c4MaxWait) :
+
+            m_pmlockTar(pmlockTar)
+        {
+            if (m_pmlockTar)
+                m_pmlockTar->LockShared(c4Timeout);
+        }
+
+        TSharedLocker(const TSharedLocker&) = delete;
+        TSharedLocker(TSharedLocker&&) = delete;
+
+        ~TSharedLocker()
+        {
+            if (m_pmlockTar)
+            {
+                // This can throw, though it's highly unlikely. If so, we die
+                CIDLib_Suppress(26447)
+                m_pmlockTar->UnlockShared();
+            }
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TSharedLocker& operator=(const TSharedLocker&) = delete;
+        TSharedLocker& operator=(TSharedLocker&&) = delete;
+        tCIDLib::TVoid* operator new(size_t) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid Release()
+        {
+            if (m_pmlockTar)
+            {
+                m_pmlockTar->UnlockShared();
+                m_pmlockTar = nullptr;
+            }
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_pmlockTar
+        //      This is a pointer to the target lockable we will release upon
+        //      destruction. It may be null, in which case we do nothing. It's
+        //      cleared if we are released early.
+        // -------------------------------------------------------------------
+        const MLockable*    m_pmlockTar;
+};
+
 #pragma CIDLIB_POPPACK
@@ -176,7 +176,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSev
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -187,8 +188,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSev)
     , m_strAuxText()
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -197,20 +198,21 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
-    // Get the calling thread's name, and the process name
+    // Get the calling thread's name
     TThread* pthrErr = TThread::pthrCaller();
     if (pthrErr)
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 TLogEvent::TLogEvent(const  TStringView&            strvFacName
@@ -221,7 +223,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSev
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -232,8 +235,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSev)
     , m_strAuxText(strvAuxText)
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -242,11 +245,13 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
     // Get the calling thread's name
@@ -255,7 +260,6 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 TLogEvent::TLogEvent(const  TStringView&            strvFacName
@@ -267,7 +271,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSeverity
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -278,8 +283,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSeverity)
     , m_strAuxText(strvAuxText)
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -288,20 +293,21 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
-    // Get the calling thread's name, and the process name
+    // Get the calling thread's name
     TThread* pthrErr = TThread::pthrCaller();
     if (pthrErr)
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 TLogEvent::TLogEvent(const  TStringView&            strvFacName
@@ -312,7 +318,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSeverity
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -323,8 +330,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSeverity)
     , m_strAuxText()
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -333,20 +340,21 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
-    // Get the calling thread's name, and the process name
+    // Get the calling thread's name
     TThread* pthrErr = TThread::pthrCaller();
     if (pthrErr)
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 TLogEvent::TLogEvent(const  TStringView&            strvFacName
@@ -359,7 +367,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSeverity
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -370,8 +379,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSeverity)
     , m_strAuxText(strvAuxText)
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -380,20 +389,21 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
-    // Get the calling thread's name, and the process name
+    // Get the calling thread's name
     TThread* pthrErr = TThread::pthrCaller();
     if (pthrErr)
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 TLogEvent::TLogEvent(const  TStringView&            strvFacName
@@ -405,7 +415,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
                     , const tCIDLib::ESeverities    eSeverity
                     , const tCIDLib::EErrClasses    eClass) :
 
-    m_bLogged(kCIDLib::False)
+    m_atmFacName(strvFacName)
+    , m_bLogged(kCIDLib::False)
     , m_bReported(kCIDLib::False)
     , m_c4LineNum(c4LineNum)
     , m_eClass(eClass)
@@ -416,8 +427,8 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     , m_eSeverity(eSeverity)
     , m_strAuxText()
     , m_strErrText(strvErrText)
-    , m_strFacName(strvFacName)
     , m_strHostName(TSysInfo::strIPHostName())
+    , m_strProcess(TProcess::strProcessName())
 {
     //
     //  Strip the path part off the file name, because its fed by the
@@ -426,20 +437,21 @@ TLogEvent::TLogEvent(const  TStringView&            strvFacName
     if (strvFileName.bContainsChar(kCIDLib::chPathSep))
     {
         TPathStr pathTmp(strvFileName);
-        pathTmp.bQueryNameExt(m_strFileName);
+        TString strName;
+        pathTmp.bQueryNameExt(strName);
+        m_atmFileName = TAtom(strName);
     }
      else
     {
-        m_strFileName = strvFileName;
+        m_atmFileName = TAtom(strvFileName);
     }
 
-    // Get the calling thread's name, and the process name
+    // Get the calling thread's name
     TThread* pthrErr = TThread::pthrCaller();
     if (pthrErr)
         m_strThread = pthrErr->strName();
     else
         m_strThread = L"????";
-    m_strProcess = TProcess::strProcessName();
 }
 
 
@@ -492,8 +504,8 @@ TLogEvent::AdvFormat(TTextOutStream& strmTar, TTime& tmFmt) const
 
     // Now the other info goes inside braces, indented
     strmTar << L"\n{\n    "
-            << m_strFacName << pszComma
-            << m_strFileName
+            << m_atmFacName.strText() << pszComma
+            << m_atmFileName.strText()
             << kCIDLib::chPeriod << m_c4LineNum
             << pszComma << m_eSeverity
             << kCIDLib::chForwardSlash << m_eClass;
@@ -541,7 +553,7 @@ tCIDLib::TBoolean
 TLogEvent::bCheckEvent( const   TStringView&        strvModName
                         , const tCIDLib::TErrCode   errcToCheck) const
 {
-    if ((m_errcId == errcToCheck) && (strvModName == m_strFacName))
+    if ((m_errcId == errcToCheck) && (strvModName == m_atmFacName.strText()))
         return kCIDLib::True;
     return kCIDLib::False;
 }
@@ -594,7 +606,7 @@ tCIDLib::TBoolean TLogEvent::bReported(const tCIDLib::TBoolean bToSet) const
 tCIDLib::TBoolean TLogEvent::bSameEvent(const TLogEvent& errToCheck) const
 {
     return (m_errcId == errToCheck.m_errcId)
-           && (m_strFacName == errToCheck.m_strFacName);
+           && (m_atmFacName == errToCheck.m_atmFacName);
 }
 
 
@@ -705,10 +717,11 @@ tCIDLib::TVoid TLogEvent::Reset()
     m_errcKrnlId    = 0;
     m_eSeverity     = tCIDLib::ESeverities::Info;
 
+    m_atmFacName    = TAtom();
+    m_atmFileName   = TAtom();
+
     m_strAuxText.Clear();
     m_strErrText.Clear();
-    m_strFacName.Clear();
-    m_strFileName.Clear();
     m_strProcess.Clear();
     m_strStackTrace.Clear();
     m_strThread.Clear();
@@ -746,26 +759,26 @@ const TString& TLogEvent::strErrText(const TStringView& strvNewText)
 // Get/set the facility name
 const TString& TLogEvent::strFacName() const
 {
-    return m_strFacName;
+    return m_atmFacName.strText();
 }
 
 const TString& TLogEvent::strFacName(const TStringView& strvNewName)
 {
-    m_strFacName = strvNewName;
-    return m_strFacName;
+    m_atmFacName = TAtom(strvNewName);
+    return m_atmFacName.strText();
 }
 
 
 // Get/set the file name
 const TString& TLogEvent::strFileName() const
 {
-    return m_strFileName;
+    return m_atmFileName.strText();
 }
 
 const TString& TLogEvent::strFileName(const TStringView& strvToSet)
 {
-    m_strFileName = strvToSet;
-    return m_strFileName;
+    m_atmFileName = TAtom(strvToSet);
+    return m_atmFileName.strText();
 }
 
 
@@ -866,10 +879,20 @@ tCIDLib::TVoid TLogEvent::StreamFrom(TBinInStream& strmToReadFrom)
                     >> m_errcKrnlId
                     >> m_eClass
                     >> m_eSeverity
-                    >> m_strErrText
-                    >> m_strFacName
-                    >> m_strFileName
-                    >> m_strHostName
+                    >> m_strErrText;
+
+    //
+    //  The facility and file names are interned, so read them into a temp first.
+    //  They come from a fixed set of facilities and source files, so interning
+    //  the ones that come in from other processes doesn't grow the table much.
+    //
+    TString strName;
+    strmToReadFrom >> strName;
+    m_atmFacName = TAtom(strName);
+    strmToReadFrom >> strName;
+    m_atmFileName = TAtom(strName);
+
+    strmToReadFrom  >> m_strHostName
                     >> m_strThread
                     >> m_strProcess;
 
@@ -917,8 +940,8 @@ tCIDLib::TVoid TLogEvent::StreamTo(TBinOutStream& strmToWriteTo) const
                     << m_eClass
                     << m_eSeverity
                     << m_strErrText
-                    << m_strFacName
-                    << m_strFileName
+                    << m_atmFacName.strText()
+                    << m_atmFileName.strText()
                     << m_strHostName
                     << m_strThread
                     << m_strProcess;
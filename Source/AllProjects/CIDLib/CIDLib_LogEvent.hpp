@@ -28,6 +28,13 @@
 //      proivde streaming, so we provide a global streaming operator for
 //      it here.
 //
+//  3)  The facility and file names are the same for lots of events, so they
+//      are stored as atoms. That makes copying events (which happens a lot,
+//      since they are also the exceptions) and checking for the same facility
+//      cheap. The accessors still return the text. The host, process and thread
+//      names are not, since the atom table is never freed, thread names are
+//      often unique, and the log server gets events from every client.
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -311,6 +318,15 @@ class CIDLIBEXP TLogEvent :
         // -------------------------------------------------------------------
         //  Private data
         //
+        //  m_atmFacName
+        //      This is the name of the facility that returned the error. It
+        //      is provided for convenience and so that it can be reported
+        //      along with the other information.
+        //
+        //  m_atmFileName
+        //      This is the name of the file in which the error occured.
+        //      This is easily provided via the CID_FILE macro.
+        //
         //  m_bLogged
         //  m_bReported
         //      Indicates whether or not its been sent to the installed logger
@@ -354,15 +370,6 @@ class CIDLIBEXP TLogEvent :
         //      manually with a string or by loading the error text from a
         //      message file and storing it here.
         //
-        //  m_strFacName
-        //      This is the name of the facility that returned the error. It
-        //      is provided for convenience and so that it can be reported
-        //      along with the other information.
-        //
-        //  m_strFileName
-        //      This is the name of the file in which the error occured.
-        //      This is easily provided via the CID_FILE macro.
-        //
         //  m_strHostName
         //      The host name of the host that logged the message. It's not
         //      always obvious because of the distributed nature of CIDLib
@@ -385,6 +392,8 @@ class CIDLIBEXP TLogEvent :
         //  m_strThread
         //      This is the name of the thread that had the error.
         // -------------------------------------------------------------------
+        TAtom                           m_atmFacName;
+        TAtom                           m_atmFileName;
         mutable tCIDLib::TBoolean       m_bLogged;
         mutable tCIDLib::TBoolean       m_bReported;
         tCIDLib::TCard4                 m_c4LineNum;
@@ -396,8 +405,6 @@ class CIDLIBEXP TLogEvent :
         tCIDLib::ESeverities            m_eSeverity;
         TString                         m_strAuxText;
         TString                         m_strErrText;
-        TString                         m_strFacName;
-        TString                         m_strFileName;
         TString                         m_strHostName;
         TString                         m_strProcess;
         TString                         m_strStackTrace;
@@ -407,6 +414,7 @@ class CIDLIBEXP TLogEvent :
         // -------------------------------------------------------------------
         //  Do any needed magic macros
         // -------------------------------------------------------------------
+        SlabAllocDefs()
         RTTIDefs(TLogEvent,TObject)
         DefPolyDup(TLogEvent)
 };
@@ -267,6 +267,17 @@ tCIDLib::TCard8 TMemBuf::c8At(const tCIDLib::TCard4 c4Ind) const
 }
 
 
+// Do the fast 64 bit hash on count bytes of the buffer from the indicated index
+tCIDLib::TCard8
+TMemBuf::c8CalcHash64(  const   tCIDLib::TCard4 c4StartInd
+                        , const tCIDLib::TCard4 c4Count
+                        , const tCIDLib::TCard8 c8Seed) const
+{
+    const tCIDLib::TCard1* pc1Buf = pc1CheckRange(CID_LINE, c4StartInd, c4Count);
+    return TRawMem::c8HashBuffer64(&pc1Buf[c4StartInd], c4Count, c8Seed);
+}
+
+
 // Chet a unicode char at the indicated index
 tCIDLib::TCh TMemBuf::chAt(const tCIDLib::TCard4 c4Ind) const
 {
@@ -144,6 +144,13 @@ class CIDLIBEXP TMemBuf :
             const   tCIDLib::TCard4         c4Index
         )   const;
 
+        [[nodiscard]] tCIDLib::TCard8 c8CalcHash64
+        (
+            const   tCIDLib::TCard4         c4StartInd
+            , const tCIDLib::TCard4         c4Count
+            , const tCIDLib::TCard8         c8Seed = 0
+        )   const;
+
         tCIDLib::TCh chAt
         (
             const   tCIDLib::TCard4         c4Index
@@ -88,7 +88,7 @@ class TObjArray : public TObject, public MDuplicable, public MLockable
             m_c4ElemCount = c4ElemCount;
             m_paobjList = new TElem[c4ElemCount];
 
-            if (eMTSafe == tCIDLib::EMTStates::Safe)
+            if (eMTSafe != tCIDLib::EMTStates::Unsafe)
                 m_pmtxLock = new TMutex;
         }
 
@@ -526,7 +526,7 @@ class TObjArray : public TObject, public MDuplicable, public MLockable
                 m_paobjList = new TElem[m_c4ElemCount];
             }
 
-            if (eMTState == tCIDLib::EMTStates::Safe)
+            if (eMTState != tCIDLib::EMTStates::Unsafe)
             {
                 if (!m_pmtxLock)
                     m_pmtxLock = new TMutex;
@@ -0,0 +1,611 @@
+//
+// FILE NAME: CIDLib_ParColAlgo.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file provides parallel versions of some of the collection algorithms
+//  and array operations. The serial ones are in CIDLib_ColAlgo.hpp and
+//  CIDLib_SearchNSort.hpp, but these need the thread pool, which comes much
+//  later in the include order.
+//
+//  All of them work by breaking the index range up into contiguous chunks and
+//  running each chunk on the shared thread pool. The calling thread runs the
+//  first chunk itself, then waits for the rest. If the calling thread is itself
+//  a pool worker, it will help with queued tasks while it waits, so these can
+//  be nested.
+//
+//  Each takes a grain size, which is the smallest number of elements worth
+//  farming out. If there are fewer than twice that many elements, the work is
+//  just done serially on the calling thread, so small inputs pay nothing extra.
+//  And we never create more than a few chunks per pool worker.
+//
+//  The collection oriented ones work in terms of indices, so they have to be
+//  used with random access collections, i.e. the vectors and arrays.
+//
+//  The parallel sort sorts the chunks using the regular TimSort, then does
+//  pairwise merge passes. Each merge is itself split up so that each pass keeps
+//  all of the workers busy.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The callbacks are invoked from multiple threads at once, so they must not
+//      update any shared data without synchronization.
+//
+//  2)  The collection must not be modified by anyone else while these are
+//      running. They don't lock the collection (other than what operator[]
+//      does), so thread safe collections are not really a good choice here,
+//      since every element access will lock.
+//
+//  3)  The reduce and scan operations must be associative, since partial results
+//      are combined. They are always combined in index order though, so they do
+//      not have to be commutative.
+//
+//  4)  If any chunk throws, the first error is rethrown on the calling thread
+//      once all of the chunks have finished. Any work already done is not
+//      undone, so the target may be partially processed.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+
+namespace TArrayOps
+{
+    //
+    //  Figure out how many chunks to break a range of elements into for the
+    //  given grain size. One means just do it serially.
+    //
+    inline tCIDLib::TCard4
+    c4CalcParChunks(const tCIDLib::TCard4 c4Count, const tCIDLib::TCard4 c4Grain)
+    {
+        tCIDLib::TCard4 c4Chunks = c4Count / (c4Grain ? c4Grain : 1);
+        if (c4Chunks < 2)
+            return 1;
+
+        const tCIDLib::TCard4 c4MaxChunks
+        (
+            TThreadPool::tpoolShared().c4WorkerCount() * kCIDLib::c4ParChunksPerWorker
+        );
+        if (c4Chunks > c4MaxChunks)
+            c4Chunks = c4MaxChunks;
+        return (c4Chunks < 2) ? 1 : c4Chunks;
+    }
+
+
+    //
+    //  Returns the starting index of a chunk. The end of a chunk is the start of
+    //  the next one, so passing the chunk count gets the overall end.
+    //
+    inline tCIDLib::TCard4
+    c4ParChunkStart(const   tCIDLib::TCard4 c4Count
+                    , const tCIDLib::TCard4 c4Chunks
+                    , const tCIDLib::TCard4 c4Chunk)
+    {
+        return tCIDLib::TCard4
+        (
+            (tCIDLib::TCard8(c4Count) * c4Chunk) / c4Chunks
+        );
+    }
+
+
+    //
+    //  The workhorse for everything else. It invokes the callback once for each
+    //  chunk index. Chunk 0 is run on the calling thread and the rest on the
+    //  shared pool. We always wait for all of them, even if one fails, since they
+    //  are referencing the caller's data. The first failure is then thrown.
+    //
+    template <typename TChunkCB>
+    tCIDLib::TVoid ParInvoke(const tCIDLib::TCard4 c4Chunks, TChunkCB fnChunk)
+    {
+        if (c4Chunks < 2)
+        {
+            fnChunk(0);
+            return;
+        }
+
+        TThreadPool& tpoolPar = TThreadPool::tpoolShared();
+        TVector<TThreadPool::TTaskPtr> colTasks(c4Chunks);
+
+        tCIDLib::TBoolean   bFailed = kCIDLib::False;
+        TError              errFirst;
+        try
+        {
+            for (tCIDLib::TCard4 c4Index = 1; c4Index < c4Chunks; c4Index++)
+            {
+                colTasks.objAdd
+                (
+                    tpoolPar.cptrRun
+                    (
+                        [&fnChunk, c4Index](TThreadPoolTask&) { fnChunk(c4Index); }
+                    )
+                );
+            }
+            fnChunk(0);
+        }
+
+        catch(TError& errToCatch)
+        {
+            bFailed = kCIDLib::True;
+            errFirst = errToCatch;
+        }
+
+        catch(...)
+        {
+            bFailed = kCIDLib::True;
+            errFirst = TError
+            (
+                facCIDLib().strName()
+                , CID_FILE
+                , CID_LINE
+                , facCIDLib().strMsg(kCIDErrs::errcTPool_UnknownExcept)
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Unknown
+            );
+        }
+
+        // If we already failed, don't let any that haven't started bother
+        const tCIDLib::TCard4 c4TaskCnt = colTasks.c4ElemCount();
+        if (bFailed)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TaskCnt; c4Index++)
+                colTasks[c4Index]->RequestCancel();
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TaskCnt; c4Index++)
+        {
+            TThreadPool::TTaskPtr& cptrCur = colTasks[c4Index];
+            cptrCur->bWaitDone();
+
+            if (bFailed)
+                continue;
+
+            const tCIDLib::ETaskStates eState = cptrCur->eState();
+            if (eState == tCIDLib::ETaskStates::Failed)
+            {
+                bFailed = kCIDLib::True;
+                errFirst = cptrCur->errFailure();
+            }
+             else if (eState == tCIDLib::ETaskStates::Cancelled)
+            {
+                // Has to be the pool shutting down, but we didn't get it done
+                bFailed = kCIDLib::True;
+                errFirst = TError
+                (
+                    facCIDLib().strName()
+                    , CID_FILE
+                    , CID_LINE
+                    , facCIDLib().strMsg(kCIDErrs::errcTPool_ChunkCancelled)
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::Shutdown
+                );
+            }
+        }
+
+        if (bFailed)
+        {
+            errFirst.AddStackLevel(CID_FILE, CID_LINE);
+            throw errFirst;
+        }
+    }
+
+
+    //
+    //  Finds how many elements of the A list are in the first c4OutInd elements
+    //  of the stable merge of A and B. Elements from A win ties, same as in the
+    //  regular merge. This lets us split a single merge across threads.
+    //
+    template <typename T, typename TComp>
+    tCIDLib::TCard4 c4ParMergeSplit(const   T* const            ptA
+                                    , const tCIDLib::TCard4     c4ACount
+                                    , const T* const            ptB
+                                    , const tCIDLib::TCard4     c4BCount
+                                    , const tCIDLib::TCard4     c4OutInd
+                                    ,       TComp&              pfnComp)
+    {
+        tCIDLib::TCard4 c4Low = (c4OutInd > c4BCount) ? c4OutInd - c4BCount : 0;
+        tCIDLib::TCard4 c4High = (c4OutInd < c4ACount) ? c4OutInd : c4ACount;
+        while (c4Low < c4High)
+        {
+            const tCIDLib::TCard4 c4AInd = c4Low + ((c4High - c4Low) / 2);
+            const tCIDLib::TCard4 c4BInd = c4OutInd - c4AInd;
+
+            //
+            //  If the A element isn't greater than the last B element we'd be
+            //  taking, then it has to be in the output range as well.
+            //
+            if (pfnComp(ptB[c4BInd - 1], ptA[c4AInd]) != tCIDLib::ESortComps::FirstLess)
+                c4Low = c4AInd + 1;
+             else
+                c4High = c4AInd;
+        }
+        return c4Low;
+    }
+
+
+    // A simple, serial, stable merge of two sorted ranges into an output range
+    template <typename T, typename TComp>
+    tCIDLib::TVoid ParMergeRuns(const   T*                  ptA
+                                , const tCIDLib::TCard4     c4ACount
+                                , const T*                  ptB
+                                , const tCIDLib::TCard4     c4BCount
+                                ,       T*                  ptOut
+                                ,       TComp&              pfnComp)
+    {
+        const T* const ptAEnd = ptA + c4ACount;
+        const T* const ptBEnd = ptB + c4BCount;
+        while ((ptA < ptAEnd) && (ptB < ptBEnd))
+        {
+            if (pfnComp(*ptB, *ptA) == tCIDLib::ESortComps::FirstLess)
+                *ptOut++ = *ptB++;
+             else
+                *ptOut++ = *ptA++;
+        }
+
+        while (ptA < ptAEnd)
+            *ptOut++ = *ptA++;
+        while (ptB < ptBEnd)
+            *ptOut++ = *ptB++;
+    }
+
+
+    //
+    //  The parallel sort, declared up in CIDLib_SearchNSort.hpp. We sort each
+    //  chunk via the regular TimSort, and then merge pairs of sorted runs back
+    //  and forth between the array and a temp array until there's only one run
+    //  left. Every pass is broken into about the same number of tasks as the
+    //  original chunk count, so that even the last single merge is spread out.
+    //
+    template <typename T, typename TComp>
+    tCIDLib::TVoid TParSort(        T*                  ptArray
+                            , const tCIDLib::TCard4     c4Count
+                            ,       TComp               pfnComp
+                            , const tCIDLib::TCard4     c4Grain)
+    {
+        CIDAssert(c4Count <= 0x7fffffff, L"Array is too large to sort");
+
+        const tCIDLib::TCard4 c4Chunks = c4CalcParChunks(c4Count, c4Grain);
+        if (c4Chunks < 2)
+        {
+            DoTSort<T, TComp>(ptArray, c4Count, pfnComp);
+            return;
+        }
+
+        // Store the chunk boundaries, with an extra one for the end
+        TArrayJanitor<tCIDLib::TCard4> janBounds(c4Chunks + 1);
+        tCIDLib::TCard4* const pc4Bounds = janBounds.paThis();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index <= c4Chunks; c4Index++)
+            pc4Bounds[c4Index] = c4ParChunkStart(c4Count, c4Chunks, c4Index);
+
+        ParInvoke
+        (
+            c4Chunks
+            , [ptArray, pc4Bounds, &pfnComp](const tCIDLib::TCard4 c4Chunk)
+              {
+                DoTSort<T, TComp>
+                (
+                    ptArray + pc4Bounds[c4Chunk]
+                    , pc4Bounds[c4Chunk + 1] - pc4Bounds[c4Chunk]
+                    , pfnComp
+                );
+              }
+        );
+
+        //
+        //  And now merge runs. Runs are c4Width original chunks wide, so the run
+        //  boundaries are just every c4Width'th chunk boundary.
+        //
+        TArrayJanitor<T> janTmp(c4Count);
+        T* ptSrc = ptArray;
+        T* ptTar = janTmp.paThis();
+        tCIDLib::TCard4 c4Width = 1;
+        while (c4Width < c4Chunks)
+        {
+            const tCIDLib::TCard4 c4Runs = (c4Chunks + c4Width - 1) / c4Width;
+            const tCIDLib::TCard4 c4Pairs = c4Runs / 2;
+            const tCIDLib::TCard4 c4Pieces = (c4Chunks + c4Pairs - 1) / c4Pairs;
+
+            // If an odd run, there's an extra task to copy it across
+            const tCIDLib::TCard4 c4Tasks = (c4Pairs * c4Pieces) + (c4Runs & 1);
+
+            ParInvoke
+            (
+                c4Tasks
+                , [=, &pfnComp](const tCIDLib::TCard4 c4Task)
+                  {
+                    const tCIDLib::TCard4 c4Pair = c4Task / c4Pieces;
+                    const tCIDLib::TCard4 c4AStart = pc4Bounds[c4Pair * 2 * c4Width];
+                    if (c4Pair == c4Pairs)
+                    {
+                        for (tCIDLib::TCard4 c4Index = c4AStart; c4Index < c4Count; c4Index++)
+                            ptTar[c4Index] = ptSrc[c4Index];
+                        return;
+                    }
+
+                    const tCIDLib::TCard4 c4BStart = pc4Bounds[((c4Pair * 2) + 1) * c4Width];
+                    const tCIDLib::TCard4 c4BEnd = pc4Bounds
+                    [
+                        tCIDLib::MinVal(((c4Pair * 2) + 2) * c4Width, c4Chunks)
+                    ];
+
+                    const T* const ptA = ptSrc + c4AStart;
+                    const T* const ptB = ptSrc + c4BStart;
+                    const tCIDLib::TCard4 c4ACount = c4BStart - c4AStart;
+                    const tCIDLib::TCard4 c4BCount = c4BEnd - c4BStart;
+
+                    // Figure out our piece of the output and where that comes from
+                    const tCIDLib::TCard4 c4Piece = c4Task % c4Pieces;
+                    const tCIDLib::TCard4 c4OutStart = c4ParChunkStart
+                    (
+                        c4ACount + c4BCount, c4Pieces, c4Piece
+                    );
+                    const tCIDLib::TCard4 c4OutEnd = c4ParChunkStart
+                    (
+                        c4ACount + c4BCount, c4Pieces, c4Piece + 1
+                    );
+                    const tCIDLib::TCard4 c4AFrom = c4ParMergeSplit
+                    (
+                        ptA, c4ACount, ptB, c4BCount, c4OutStart, pfnComp
+                    );
+                    const tCIDLib::TCard4 c4ATo = c4ParMergeSplit
+                    (
+                        ptA, c4ACount, ptB, c4BCount, c4OutEnd, pfnComp
+                    );
+
+                    ParMergeRuns
+                    (
+                        ptA + c4AFrom
+                        , c4ATo - c4AFrom
+                        , ptB + (c4OutStart - c4AFrom)
+                        , (c4OutEnd - c4ATo) - (c4OutStart - c4AFrom)
+                        , ptTar + c4AStart + c4OutStart
+                        , pfnComp
+                    );
+                  }
+            );
+
+            tCIDLib::Swap(ptSrc, ptTar);
+            c4Width *= 2;
+        }
+
+        // If we ended up in the temp array, copy it back
+        if (ptSrc != ptArray)
+        {
+            ParInvoke
+            (
+                c4Chunks
+                , [ptArray, ptSrc, pc4Bounds](const tCIDLib::TCard4 c4Chunk)
+                  {
+                    const tCIDLib::TCard4 c4End = pc4Bounds[c4Chunk + 1];
+                    for (tCIDLib::TCard4 c4Index = pc4Bounds[c4Chunk]; c4Index < c4End; c4Index++)
+                        ptArray[c4Index] = ptSrc[c4Index];
+                  }
+            );
+        }
+    }
+
+
+    //
+    //  The guts of the inclusive prefix scan, which works on anything that can be
+    //  indexed, so we can use it for raw arrays and collections. Each chunk is
+    //  scanned on its own, then we serially scan the chunk totals to get each
+    //  chunk's carry in, and then apply those to all but the first chunk.
+    //
+    template <typename TElem, typename TSrc, typename TOp>
+    tCIDLib::TVoid ParScanOn(       TSrc&               tSrc
+                            , const tCIDLib::TCard4     c4Count
+                            ,       TOp&                pfnOp
+                            , const tCIDLib::TCard4     c4Grain)
+    {
+        const tCIDLib::TCard4 c4Chunks = c4CalcParChunks(c4Count, c4Grain);
+
+        // Scan each chunk in place
+        ParInvoke
+        (
+            c4Chunks
+            , [&tSrc, &pfnOp, c4Count, c4Chunks](const tCIDLib::TCard4 c4Chunk)
+              {
+                const tCIDLib::TCard4 c4End = c4ParChunkStart(c4Count, c4Chunks, c4Chunk + 1);
+                tCIDLib::TCard4 c4Index = c4ParChunkStart(c4Count, c4Chunks, c4Chunk) + 1;
+                for (; c4Index < c4End; c4Index++)
+                {
+                    TElem tAccum = tSrc[c4Index - 1];
+                    pfnOp(tAccum, tSrc[c4Index]);
+                    tSrc[c4Index] = tAccum;
+                }
+              }
+        );
+
+        if (c4Chunks < 2)
+            return;
+
+        //
+        //  The carry in for chunk x is the carry into the previous chunk plus the
+        //  previous chunk's total, which is its last element.
+        //
+        TArrayJanitor<TElem> janCarries(c4Chunks);
+        TElem* const ptCarries = janCarries.paThis();
+        ptCarries[1] = tSrc[c4ParChunkStart(c4Count, c4Chunks, 1) - 1];
+        for (tCIDLib::TCard4 c4Chunk = 2; c4Chunk < c4Chunks; c4Chunk++)
+        {
+            ptCarries[c4Chunk] = ptCarries[c4Chunk - 1];
+            pfnOp(ptCarries[c4Chunk], tSrc[c4ParChunkStart(c4Count, c4Chunks, c4Chunk) - 1]);
+        }
+
+        ParInvoke
+        (
+            c4Chunks - 1
+            , [&tSrc, &pfnOp, ptCarries, c4Count, c4Chunks](const tCIDLib::TCard4 c4Task)
+              {
+                const tCIDLib::TCard4 c4Chunk = c4Task + 1;
+                const tCIDLib::TCard4 c4End = c4ParChunkStart(c4Count, c4Chunks, c4Chunk + 1);
+                tCIDLib::TCard4 c4Index = c4ParChunkStart(c4Count, c4Chunks, c4Chunk);
+                for (; c4Index < c4End; c4Index++)
+                {
+                    TElem tAccum = ptCarries[c4Chunk];
+                    pfnOp(tAccum, tSrc[c4Index]);
+                    tSrc[c4Index] = tAccum;
+                }
+              }
+        );
+    }
+
+
+    //
+    //  An in place, inclusive prefix scan of a raw array. The operation is called
+    //  as pfnOp(tAccum, tVal) and must update tAccum, the same as the reduce
+    //  callback for tCIDColAlgo::tMapReduce().
+    //
+    template <typename T, typename TOp>
+    tCIDLib::TVoid TParPrefixScan(          T* const            ptArray
+                                    , const tCIDLib::TCard4     c4Count
+                                    ,       TOp                 pfnOp
+                                    , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain)
+    {
+        T* ptSrc = ptArray;
+        ParScanOn<T>(ptSrc, c4Count, pfnOp, c4Grain);
+    }
+}
+
+
+namespace tCIDColAlgo
+{
+    //
+    //  Invokes the callback for every element of a random access collection. The
+    //  callback gets the element and its index. If the collection is const, the
+    //  elements are passed const.
+    //
+    template<typename TCol, typename TIterCB>
+    tCIDLib::TVoid ParForEach(          TCol&               colTar
+                                ,       TIterCB             iterCB
+                                , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain)
+    {
+        const tCIDLib::TCard4 c4Count = colTar.c4ElemCount();
+        const tCIDLib::TCard4 c4Chunks = TArrayOps::c4CalcParChunks(c4Count, c4Grain);
+        TArrayOps::ParInvoke
+        (
+            c4Chunks
+            , [&colTar, &iterCB, c4Count, c4Chunks](const tCIDLib::TCard4 c4Chunk)
+              {
+                const tCIDLib::TCard4 c4End = TArrayOps::c4ParChunkStart
+                (
+                    c4Count, c4Chunks, c4Chunk + 1
+                );
+                tCIDLib::TCard4 c4Index = TArrayOps::c4ParChunkStart(c4Count, c4Chunks, c4Chunk);
+                for (; c4Index < c4End; c4Index++)
+                    iterCB(colTar[c4Index], c4Index);
+              }
+        );
+    }
+
+
+    //
+    //  A parallel version of tMapReduce(), for random access collections. Each
+    //  chunk reduces its selected elements into a partial result, seeded from the
+    //  first element it selects, and then the partials are reduced into the
+    //  initial value in order. So the reduce callback has to be valid for
+    //  combining two partial results, e.g. summing.
+    //
+    template<typename TCol, typename TTest, typename TReduce>
+    typename TCol::TMyElemType
+    tParMapReduce(  const   TCol&                           colSrc
+                    ,       TTest                           pfnTest
+                    ,       TReduce                         pfnReduce
+                    , const typename TCol::TMyElemType&     tInitVal
+                    , const tCIDLib::TCard4                 c4Grain = kCIDLib::c4DefParGrain)
+    {
+        using TElem = typename TCol::TMyElemType;
+
+        const tCIDLib::TCard4 c4Count = colSrc.c4ElemCount();
+        const tCIDLib::TCard4 c4Chunks = TArrayOps::c4CalcParChunks(c4Count, c4Grain);
+
+        // A slot for each chunk's partial result, null if it selected nothing
+        TArrayJanitor<TElem*> janParts(c4Chunks);
+        TElem** const apParts = janParts.paThis();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Chunks; c4Index++)
+            apParts[c4Index] = nullptr;
+
+        TElem tRet = tInitVal;
+        try
+        {
+            TArrayOps::ParInvoke
+            (
+                c4Chunks
+                , [&colSrc, &pfnTest, &pfnReduce, apParts, c4Count, c4Chunks]
+                  (const tCIDLib::TCard4 c4Chunk)
+                  {
+                    const tCIDLib::TCard4 c4End = TArrayOps::c4ParChunkStart
+                    (
+                        c4Count, c4Chunks, c4Chunk + 1
+                    );
+                    tCIDLib::TCard4 c4Index = TArrayOps::c4ParChunkStart
+                    (
+                        c4Count, c4Chunks, c4Chunk
+                    );
+                    for (; c4Index < c4End; c4Index++)
+                    {
+                        const TElem& tCur = colSrc[c4Index];
+                        if (!pfnTest(tCur))
+                            continue;
+
+                        if (apParts[c4Chunk])
+                            pfnReduce(*apParts[c4Chunk], tCur);
+                         else
+                            apParts[c4Chunk] = new TElem(tCur);
+                    }
+                  }
+            );
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Chunks; c4Index++)
+            {
+                if (apParts[c4Index])
+                    pfnReduce(tRet, *apParts[c4Index]);
+            }
+        }
+
+        catch(TError& errToCatch)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Chunks; c4Index++)
+                delete apParts[c4Index];
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            throw;
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Chunks; c4Index++)
+            delete apParts[c4Index];
+        return tRet;
+    }
+
+
+    //
+    //  An in place, inclusive prefix scan of a random access collection. See
+    //  TArrayOps::TParPrefixScan() for the details.
+    //
+    template<typename TCol, typename TOp>
+    tCIDLib::TVoid ParPrefixScan(       TCol&               colTar
+                                ,       TOp                 pfnOp
+                                , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain)
+    {
+        TArrayOps::ParScanOn<typename TCol::TMyElemType>
+        (
+            colTar, colTar.c4ElemCount(), pfnOp, c4Grain
+        );
+    }
+}
+
+#pragma CIDLIB_POPPACK
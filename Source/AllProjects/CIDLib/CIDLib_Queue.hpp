@@ -610,13 +610,13 @@ template <typename TElem> class TQueue : public TCollection<TElem>
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return m_llstQueue.bIsEmpty();
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return m_llstQueue.c4ElemCount();
         }
 
@@ -630,7 +630,7 @@ template <typename TElem> class TQueue : public TCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return new TCursor(this);
         }
 
@@ -0,0 +1,335 @@
+//
+// FILE NAME: CIDLib_RWLock.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TRWLock class.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The shared locks held by each thread are tracked in a thread local list,
+//      so that we can support nested shared locks without going back to the
+//      kernel lock, which could deadlock if a writer is waiting.
+//
+//  2)  The writer thread id and nesting count are only changed by the thread
+//      that has it exclusively, but any locking thread reads the thread id to
+//      see if it's the owner. So they are always accessed via relaxed atomic
+//      ops. A thread can only ever see its own id there if it stored it itself,
+//      so no ordering is needed, the kernel lock provides that.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Do our RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TRWLock,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_RWLock
+    {
+        // -----------------------------------------------------------------------
+        //  The per-thread list of shared locks held and their nesting counts.
+        //  Unused slots have a null lock pointer.
+        // -----------------------------------------------------------------------
+        struct THeldLock
+        {
+            const TRWLock*      prwlHeld;
+            tCIDLib::TCard4     c4Count;
+        };
+        thread_local THeldLock aHeld[TRWLock::c4MaxShared];
+
+
+        // Find the calling thread's entry for the passed lock, if any
+        THeldLock* pFindHeld(const TRWLock* const prwlFind)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < TRWLock::c4MaxShared; c4Index++)
+            {
+                if (aHeld[c4Index].prwlHeld == prwlFind)
+                    return &aHeld[c4Index];
+            }
+            return nullptr;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRWLock
+//  PREFIX: rwl
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TRWLock: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TRWLock::TRWLock() :
+
+    m_c4WriteNest(0)
+    , m_tidWriter(kCIDLib::tidInvalid)
+{
+}
+
+TRWLock::~TRWLock()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRWLock: Public, inherited methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TRWLock::bTryLock(const tCIDLib::TCard4 c4WaitMSs) const
+{
+    return bDoLock(c4WaitMSs, kCIDLib::False);
+}
+
+
+tCIDLib::TVoid TRWLock::Lock(const tCIDLib::TCard4 c4WaitMSs) const
+{
+    bDoLock(c4WaitMSs, kCIDLib::True);
+}
+
+
+tCIDLib::TVoid TRWLock::LockShared(const tCIDLib::TCard4 c4WaitMSs) const
+{
+    bDoLockShared(c4WaitMSs, kCIDLib::True);
+}
+
+
+tCIDLib::TVoid TRWLock::Unlock() const
+{
+    if (TAtomic::c4RelaxedGet(m_tidWriter) != TKrnlThread::tidCaller())
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcRWL_NotOwner
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Authority
+        );
+    }
+
+    const tCIDLib::TCard4 c4Nest = TAtomic::c4RelaxedGet(m_c4WriteNest) - 1;
+    TAtomic::RelaxedSet(m_c4WriteNest, c4Nest);
+    if (!c4Nest)
+    {
+        TAtomic::RelaxedSet(m_tidWriter, kCIDLib::tidInvalid);
+        if (!m_krwlImpl.bUnlockExclusive())
+        {
+            facCIDLib().ThrowKrnlErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kCIDErrs::errcRWL_Unlock
+                , TKrnlError::kerrLast()
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::CantDo
+            );
+        }
+    }
+}
+
+
+tCIDLib::TVoid TRWLock::UnlockShared() const
+{
+    // If we have it exclusive, then the shared lock was just a nesting
+    if (TAtomic::c4RelaxedGet(m_tidWriter) == TKrnlThread::tidCaller())
+    {
+        Unlock();
+        return;
+    }
+
+    //
+    //  Every shared lock we hold has an entry, so if we don't have one, we don't
+    //  have it locked. Else drop the count, and if that doesn't go to zero we
+    //  are done.
+    //
+    CIDLib_RWLock::THeldLock* pHeld = CIDLib_RWLock::pFindHeld(this);
+    if (!pHeld)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcRWL_NotShared
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Authority
+        );
+    }
+
+    if (--pHeld->c4Count)
+        return;
+    pHeld->prwlHeld = nullptr;
+
+    if (!m_krwlImpl.bUnlockShared())
+    {
+        facCIDLib().ThrowKrnlErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcRWL_Unlock
+            , TKrnlError::kerrLast()
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::CantDo
+        );
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRWLock: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TRWLock::bTryLockShared(const tCIDLib::TCard4 c4WaitMSs) const
+{
+    return bDoLockShared(c4WaitMSs, kCIDLib::False);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRWLock: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+TRWLock::bDoLock(const  tCIDLib::TCard4     c4WaitMSs
+                , const tCIDLib::TBoolean   bThrowIfTimeout) const
+{
+    const tCIDLib::TThreadId tidUs = TKrnlThread::tidCaller();
+
+    // If we already have it, just bump the nesting count
+    if (TAtomic::c4RelaxedGet(m_tidWriter) == tidUs)
+    {
+        TAtomic::RelaxedSet(m_c4WriteNest, TAtomic::c4RelaxedGet(m_c4WriteNest) + 1);
+        return kCIDLib::True;
+    }
+
+    // If we have it shared, we'd deadlock on ourself
+    if (CIDLib_RWLock::pFindHeld(this))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcRWL_CantUpgrade
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Already
+        );
+    }
+
+    if (!m_krwlImpl.bLockExclusive(c4WaitMSs))
+    {
+        if (bThrowIfTimeout
+        ||  (TKrnlError::kerrLast().errcId() != kKrnlErrs::errcGen_Timeout))
+        {
+            ThrowLockErr(CID_LINE);
+        }
+        return kCIDLib::False;
+    }
+
+    TAtomic::RelaxedSet(m_c4WriteNest, 1);
+    TAtomic::RelaxedSet(m_tidWriter, tidUs);
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TBoolean
+TRWLock::bDoLockShared( const   tCIDLib::TCard4     c4WaitMSs
+                        , const tCIDLib::TBoolean   bThrowIfTimeout) const
+{
+    // If we have it exclusively, it's just a nesting of that
+    if (TAtomic::c4RelaxedGet(m_tidWriter) == TKrnlThread::tidCaller())
+    {
+        TAtomic::RelaxedSet(m_c4WriteNest, TAtomic::c4RelaxedGet(m_c4WriteNest) + 1);
+        return kCIDLib::True;
+    }
+
+    // If we already have it shared, just bump our count
+    CIDLib_RWLock::THeldLock* pHeld = CIDLib_RWLock::pFindHeld(this);
+    if (pHeld)
+    {
+        pHeld->c4Count++;
+        return kCIDLib::True;
+    }
+
+    //
+    //  We have to be able to track it, else we couldn't nest it later. So make
+    //  sure we have a free slot before we lock it.
+    //
+    pHeld = CIDLib_RWLock::pFindHeld(nullptr);
+    if (!pHeld)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcRWL_TooManyShared
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::OutResource
+            , TCardinal(c4MaxShared)
+        );
+    }
+
+    if (!m_krwlImpl.bLockShared(c4WaitMSs))
+    {
+        if (bThrowIfTimeout
+        ||  (TKrnlError::kerrLast().errcId() != kKrnlErrs::errcGen_Timeout))
+        {
+            ThrowLockErr(CID_LINE);
+        }
+        return kCIDLib::False;
+    }
+
+    pHeld->prwlHeld = this;
+    pHeld->c4Count = 1;
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TRWLock::ThrowLockErr(const tCIDLib::TCard4 c4Line) const
+{
+    const TKrnlError& kerrRes = TKrnlError::kerrLast();
+
+    tCIDLib::EErrClasses eClass = tCIDLib::EErrClasses::Unknown;
+    tCIDLib::TErrCode errcLog = kCIDErrs::errcRWL_LockError;
+    if (kerrRes.errcId() == kKrnlErrs::errcGen_Timeout)
+    {
+        eClass = tCIDLib::EErrClasses::Timeout;
+        errcLog = kCIDErrs::errcRWL_Timeout;
+    }
+
+    facCIDLib().ThrowKrnlErr
+    (
+        CID_FILE
+        , c4Line
+        , errcLog
+        , kerrRes
+        , tCIDLib::ESeverities::Failed
+        , eClass
+    );
+}
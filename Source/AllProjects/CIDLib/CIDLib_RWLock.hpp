@@ -0,0 +1,167 @@
+//
+// FILE NAME: CIDLib_RWLock.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDLib_RWLock.cpp file, which implements the
+//  TRWLock class. This is a shared/exclusive lock, wrapping the kernel's
+//  TKrnlRWLock. Any number of threads can have it locked shared (for reading)
+//  or one thread can have it locked exclusively (for writing.) Waiting writers
+//  block new readers, so readers cannot starve writers.
+//
+//  It implements MLockable. The regular lock/unlock methods are exclusive, and
+//  the LockShared/UnlockShared methods are shared. So TLocker gets an exclusive
+//  lock and TSharedLocker gets a shared lock.
+//
+//  Unlike the kernel lock, this one is recursive, in the same way that mutexes
+//  are, since a lot of code depends on that:
+//
+//  1.  A thread that holds it exclusively can lock it again in either mode,
+//      which just bumps a nesting count.
+//  2.  A thread that holds it shared can lock it shared again, which is tracked
+//      in a small per-thread list of held shared locks.
+//  3.  A thread that holds it shared cannot lock it exclusively. That would
+//      deadlock, so it's caught and an exception is thrown.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The per-thread list of shared locks held is fixed size, c4MaxShared. If
+//      a thread tries to hold more shared locks than that at once, the shared
+//      lock call throws, since we couldn't support nesting of it. It's large
+//      enough that that should never happen in practice.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRWLock
+//  PREFIX: rwl
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TRWLock : public TObject, public MLockable
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Public class constants
+        // -------------------------------------------------------------------
+        static constexpr tCIDLib::TCard4 c4MaxShared = 16;
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TRWLock();
+
+        TRWLock(const TRWLock&) = delete;
+        TRWLock(TRWLock&&) = delete;
+
+        ~TRWLock();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TRWLock& operator=(const TRWLock&) = delete;
+        TRWLock& operator=(TRWLock&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTryLock
+        (
+            const   tCIDLib::TCard4         c4WaitMSs
+        )   const final;
+
+        tCIDLib::TVoid Lock
+        (
+            const   tCIDLib::TCard4         c4WaitMSs = kCIDLib::c4MaxWait
+        )   const final;
+
+        tCIDLib::TVoid LockShared
+        (
+            const   tCIDLib::TCard4         c4WaitMSs = kCIDLib::c4MaxWait
+        )   const final;
+
+        tCIDLib::TVoid Unlock() const final;
+
+        tCIDLib::TVoid UnlockShared() const final;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTryLockShared
+        (
+            const   tCIDLib::TCard4         c4WaitMSs
+        )   const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bDoLock
+        (
+            const   tCIDLib::TCard4         c4WaitMSs
+            , const tCIDLib::TBoolean       bThrowIfTimeout
+        )   const;
+
+        tCIDLib::TBoolean bDoLockShared
+        (
+            const   tCIDLib::TCard4         c4WaitMSs
+            , const tCIDLib::TBoolean       bThrowIfTimeout
+        )   const;
+
+        tCIDLib::TVoid ThrowLockErr
+        (
+            const   tCIDLib::TCard4         c4Line
+        )   const;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4WriteNest
+        //      The nesting count of the exclusive owner. Only the owner thread
+        //      ever changes it, but it's accessed atomically along with the
+        //      thread id.
+        //
+        //  m_krwlImpl
+        //      The kernel lock that does the real work.
+        //
+        //  m_tidWriter
+        //      The thread that currently has it locked exclusively, or the
+        //      invalid thread id if none. Other threads read it, to see if it's
+        //      themselves, while the owner changes it, so it's only accessed
+        //      via relaxed atomic ops.
+        // -------------------------------------------------------------------
+        mutable tCIDLib::TCard4     m_c4WriteNest;
+        TKrnlRWLock                 m_krwlImpl;
+        mutable tCIDLib::TThreadId  m_tidWriter;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TRWLock,TObject)
+};
+
+#pragma CIDLIB_POPPACK
@@ -547,13 +547,13 @@ template <typename TElem> class TRefQueue : public TRefCollection<TElem>
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return m_llstQueue.bIsEmpty();
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return m_llstQueue.c4ElemCount();
         }
 
@@ -584,7 +584,7 @@ template <typename TElem> class TRefQueue : public TRefCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
             return new TCursor(this);
         }
 
@@ -799,7 +799,7 @@ template <typename TElem> class TRefQueue : public TRefCollection<TElem>
 
         [[nodiscard]] TRefQueue<TElem>* pcolMakeNewOf() const
         {
-            TLocker lockrQueue(this);
+            TSharedLocker lockrQueue(this);
 
             // Make a new one with the same basic state, but not content!
             return new TRefQueue<TElem>(this->eAdopt());
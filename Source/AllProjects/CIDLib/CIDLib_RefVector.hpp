@@ -505,7 +505,7 @@ class TRefVector : public TRefCollection<TElem>
         const TElem* operator[](const TIndex tIndex) const
         {
             const tCIDLib::TCard4 c4Index = tCIDLib::TCard4(tIndex);
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             this->CheckIndex(c4Index, m_c4CurCount, CID_FILE, CID_LINE);
             return m_apElems[c4Index];
         }
@@ -561,13 +561,13 @@ class TRefVector : public TRefCollection<TElem>
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return (m_c4CurCount == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return m_c4CurCount;
         }
 
@@ -599,7 +599,7 @@ class TRefVector : public TRefCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return new TCursor(this);
         }
 
@@ -798,7 +798,7 @@ class TRefVector : public TRefCollection<TElem>
         //
         tCIDLib::TVoid DupPointers(TParType& colTarget) const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             TLocker lockrTar(&colTarget);
 
             // One of us must be non-adopting
@@ -832,7 +832,7 @@ class TRefVector : public TRefCollection<TElem>
 
         template <typename IterCB> tCIDLib::TBoolean bForEachI(IterCB iterCB) const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4CurCount; c4Index++)
             {
                 if (!iterCB(*m_apElems[c4Index], c4Index))
@@ -1103,14 +1103,14 @@ class TRefVector : public TRefCollection<TElem>
         [[nodiscard]] TMyType* pcolMakeNewOf() const
         {
             // Make a copy with same characteristics, but not content!
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             return new TMyType(this->eAdopt(), m_c4CurCount);
         }
 
         const TElem* pobjAt(const TIndex tIndex) const
         {
             const tCIDLib::TCard4 c4Index = tCIDLib::TCard4(tIndex);
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             this->CheckIndex(c4Index, m_c4CurCount, CID_FILE, CID_LINE);
             return m_apElems[c4Index];
         }
@@ -1365,7 +1365,7 @@ class TRefVector : public TRefCollection<TElem>
 
         const TElem* pobjLast() const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
             // See if there are any nodes. If not, throw an exception
             if (!m_c4CurCount)
@@ -1620,7 +1620,7 @@ class TRefVector : public TRefCollection<TElem>
         {
             const tCIDLib::TCard4 c4StartAt = tCIDLib::TCard4(tStartAt);
 
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
 			//
 			//	We can allow the start index to be at the item past the end. We just
@@ -0,0 +1,191 @@
+//
+// FILE NAME: CIDLib_RingQueue.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the non-templatized parts of the ring queues, the
+//  TRingQSignal and TRingQBase classes.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Wake() must use a full fence read of the waiter count, not just an
+//      acquire. The waiter bumps the count and then checks the queue, and the
+//      waker updates the queue and then checks the count. If either side could
+//      see the old value of the other's data, a waiter could block with data
+//      in the queue and no one would wake it.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_RingQueue
+    {
+        // -----------------------------------------------------------------------
+        //  c4MaxSize
+        //      The largest slot count we'll allow. It has to stay well under the
+        //      range of the free running indices, so that differences between
+        //      them can be treated as signed.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxSize = 0x40000000;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRingQSignal
+//  PREFIX: sig
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TRingQSignal: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TRingQSignal::TRingQSignal() :
+
+    m_c4Waiters(0)
+    , m_evWake(tCIDLib::EEventStates::Reset, kCIDLib::False)
+{
+}
+
+TRingQSignal::~TRingQSignal()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRingQSignal: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Only do the kernel call if someone is actually waiting
+tCIDLib::TVoid TRingQSignal::Wake()
+{
+    if (TAtomic::c4CompareAndExchange(m_c4Waiters, 0, 0))
+        m_evWake.Trigger();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRingQSignal: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  We don't care whether it times out or not, the caller will check the queue
+//  again either way.
+//
+tCIDLib::TVoid TRingQSignal::Block(const tCIDLib::TCard4 c4WaitMSs)
+{
+    m_evWake.bWaitFor(c4WaitMSs);
+}
+
+
+tCIDLib::TVoid TRingQSignal::EnterWait()
+{
+    TAtomic::c4SafeAcquire(m_c4Waiters);
+}
+
+
+tCIDLib::TVoid TRingQSignal::ExitWait()
+{
+    TAtomic::c4SafeRelease(m_c4Waiters);
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRingQBase
+//  PREFIX: col
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TRingQBase: Destructor
+// ---------------------------------------------------------------------------
+TRingQBase::~TRingQBase()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRingQBase: Hidden constructors
+// ---------------------------------------------------------------------------
+TRingQBase::TRingQBase( const   tCIDLib::TCard4     c4MinSize
+                        , const tCIDLib::TCh* const pszType) :
+
+    m_c4Mask(0)
+    , m_c4Size(1)
+    , m_pszType(pszType)
+{
+    if (!c4MinSize)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcCol_ZeroSize
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::AppError
+        );
+    }
+
+    if (c4MinSize > CIDLib_RingQueue::c4MaxSize)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcCol_CantExpand
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::BadParms
+            , TCardinal(c4MinSize)
+            , TCardinal(CIDLib_RingQueue::c4MaxSize)
+        );
+    }
+
+    // Round up to a power of two so that we can mask the indices
+    while (m_c4Size < c4MinSize)
+        m_c4Size <<= 1;
+    m_c4Mask = m_c4Size - 1;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TRingQBase: Protected, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TVoid TRingQBase::ThrowTimeout(const tCIDLib::TBoolean bForSpace) const
+{
+    facCIDLib().ThrowErr
+    (
+        CID_FILE
+        , CID_LINE
+        , bForSpace ? kCIDErrs::errcCol_Full : kCIDErrs::errcCol_IsEmpty
+        , tCIDLib::ESeverities::Failed
+        , tCIDLib::EErrClasses::Timeout
+        , TString(m_pszType)
+    );
+}
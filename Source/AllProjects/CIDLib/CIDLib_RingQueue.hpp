@@ -0,0 +1,913 @@
+//
+// FILE NAME: CIDLib_RingQueue.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements a couple of bounded, lock free queues, which are useful
+//  alternatives to TQueue for high throughput producer/consumer scenarios. TQueue
+//  allocates a node per element and takes the collection mutex for every put and
+//  get. These guys have a fixed set of slots allocated up front (rounded up to a
+//  power of two) and don't lock at all unless a thread has to block because the
+//  queue is empty or full.
+//
+//  TSPSCRingQ is for exactly one producer thread and one consumer thread. That
+//  lets it get away with just acquire/release access to the read and write
+//  indices, and each side caches the other side's index so it only has to go
+//  read it when it looks like it's out of room/data.
+//
+//  TMPMCRingQ allows any number of producers and consumers. Each slot has a
+//  sequence number that indicates whether it's ready to be written or read for
+//  the current lap around the ring, and threads claim slots by doing a compare
+//  and exchange on the read or write index.
+//
+//  Both support batch puts and gets, which claim as many slots as they can at
+//  once, so the per-element overhead goes way down for bursty traffic.
+//
+//  Blocking is done via TRingQSignal, which keeps a count of waiting threads and
+//  an auto-reset event. Signaling checks the waiter count and only triggers the
+//  event if someone is actually waiting, so the non-blocking path never makes a
+//  kernel call.
+//
+//  These are not TCollection derivatives. They don't support cursors, pub/sub,
+//  streaming, or any of that. They are just for moving data between threads.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The element type must be default constructable and assignable, since the
+//      slots are allocated up front and elements are assigned into and out of
+//      them. Gets move the elements out.
+//
+//  2)  For the SPSC version, it's up to the application to insure that only one
+//      thread ever puts and only one thread ever gets. It cannot be checked.
+//
+//  3)  The element count is only a snapshot, since other threads can be changing
+//      it at any time.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRingQSignal
+//  PREFIX: sig
+//
+//  This is used by the ring queues to block threads waiting for data or space.
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TRingQSignal
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TRingQSignal();
+
+        TRingQSignal(const TRingQSignal&) = delete;
+        TRingQSignal(TRingQSignal&&) = delete;
+
+        ~TRingQSignal();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TRingQSignal& operator=(const TRingQSignal&) = delete;
+        TRingQSignal& operator=(TRingQSignal&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Call the passed function until it returns true or we time out. We
+        //  register as a waiter before checking, so any signal after that will
+        //  wake us up. If we get what we want, we pass along a wakeup in case
+        //  there's more available than just what we took.
+        //
+        template <typename TTryFunc>
+        tCIDLib::TBoolean bWaitFor(         TTryFunc            fnTry
+                                    , const tCIDLib::TCard4     c4WaitMSs)
+        {
+            const tCIDLib::TCard8 c8End
+            (
+                (c4WaitMSs == kCIDLib::c4MaxWait) ? kCIDLib::c8MaxCard
+                                                  : TTime::c8Millis() + c4WaitMSs
+            );
+
+            tCIDLib::TBoolean bRet = kCIDLib::False;
+            EnterWait();
+            try
+            {
+                while (kCIDLib::True)
+                {
+                    if (fnTry())
+                    {
+                        bRet = kCIDLib::True;
+                        break;
+                    }
+
+                    tCIDLib::TCard4 c4Left = kCIDLib::c4MaxWait;
+                    if (c8End != kCIDLib::c8MaxCard)
+                    {
+                        const tCIDLib::TCard8 c8Now = TTime::c8Millis();
+                        if (c8Now >= c8End)
+                            break;
+                        c4Left = tCIDLib::TCard4(c8End - c8Now);
+                    }
+                    Block(c4Left);
+                }
+            }
+
+            catch(TError& errToCatch)
+            {
+                ExitWait();
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                throw;
+            }
+            ExitWait();
+
+            if (bRet)
+                Wake();
+            return bRet;
+        }
+
+        tCIDLib::TVoid Wake();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid Block
+        (
+            const   tCIDLib::TCard4         c4WaitMSs
+        );
+
+        tCIDLib::TVoid EnterWait();
+
+        tCIDLib::TVoid ExitWait();
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Waiters
+        //      The number of threads currently registered as waiting. It's on
+        //      its own cache line since every put or get checks it.
+        //
+        //  m_evWake
+        //      An auto-reset event that waiters block on.
+        // -------------------------------------------------------------------
+        alignas(kCIDLib::c4CacheLineSz) tCIDLib::TCard4 m_c4Waiters;
+        TEvent                                          m_evWake;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TRingQBase
+//  PREFIX: col
+//
+//  The non-templatized base class for the ring queues. It handles the size
+//  calculation, the blocking and the errors, so that they aren't replicated for
+//  every instantiation.
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TRingQBase
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TRingQBase() = delete;
+
+        TRingQBase(const TRingQBase&) = delete;
+        TRingQBase(TRingQBase&&) = delete;
+
+        ~TRingQBase();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TRingQBase& operator=(const TRingQBase&) = delete;
+        TRingQBase& operator=(TRingQBase&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4MaxElems() const
+        {
+            return m_c4Size;
+        }
+
+
+    protected :
+        // -------------------------------------------------------------------
+        //  Hidden constructors
+        // -------------------------------------------------------------------
+        TRingQBase
+        (
+            const   tCIDLib::TCard4         c4MinSize
+            , const tCIDLib::TCh* const     pszType
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Protected, non-virtual methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Try the passed function, and if that fails, wait up to the indicated
+        //  time on the signal for it to work. If we time out, we optionally throw.
+        //
+        template <typename TTryFunc>
+        tCIDLib::TBoolean bWaitOn(          TRingQSignal&       sigWait
+                                    ,       TTryFunc            fnTry
+                                    , const tCIDLib::TCard4     c4WaitMSs
+                                    , const tCIDLib::TBoolean   bThrowIfTimeout
+                                    , const tCIDLib::TBoolean   bForSpace)
+        {
+            if (fnTry())
+                return kCIDLib::True;
+
+            if (c4WaitMSs && sigWait.bWaitFor(fnTry, c4WaitMSs))
+                return kCIDLib::True;
+
+            if (bThrowIfTimeout)
+                ThrowTimeout(bForSpace);
+            return kCIDLib::False;
+        }
+
+        tCIDLib::TVoid ThrowTimeout
+        (
+            const   tCIDLib::TBoolean       bForSpace
+        )   const;
+
+
+        // -------------------------------------------------------------------
+        //  Protected data members
+        //
+        //  m_c4Mask
+        //      The size minus one, to mask the free running indices into slot
+        //      indices.
+        //
+        //  m_c4Size
+        //      The number of slots, which is always a power of two.
+        //
+        //  m_pszType
+        //      The type name of the derived class, for error messages.
+        //
+        //  m_sigNotEmpty
+        //  m_sigNotFull
+        //      The signals that consumers and producers, respectively, block on
+        //      if they have to wait.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4Mask;
+        tCIDLib::TCard4         m_c4Size;
+        const tCIDLib::TCh*     m_pszType;
+        TRingQSignal            m_sigNotEmpty;
+        TRingQSignal            m_sigNotFull;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TSPSCRingQ
+//  PREFIX: col
+// ---------------------------------------------------------------------------
+template <typename TElem> class TSPSCRingQ : public TRingQBase
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TSPSCRingQ(const tCIDLib::TCard4 c4MinSize) :
+
+            TRingQBase(c4MinSize, L"TSPSCRingQ")
+            , m_c4Head(0)
+            , m_c4CachedTail(0)
+            , m_c4Tail(0)
+            , m_c4CachedHead(0)
+            , m_ptSlots(nullptr)
+        {
+            m_ptSlots = new TElem[m_c4Size];
+        }
+
+        TSPSCRingQ(const TSPSCRingQ&) = delete;
+        TSPSCRingQ(TSPSCRingQ&&) = delete;
+
+        ~TSPSCRingQ()
+        {
+            delete [] m_ptSlots;
+            m_ptSlots = nullptr;
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TSPSCRingQ& operator=(const TSPSCRingQ&) = delete;
+        TSPSCRingQ& operator=(TSPSCRingQ&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsEmpty() const
+        {
+            return (c4ElemCount() == 0);
+        }
+
+        tCIDLib::TBoolean bIsFull() const
+        {
+            return (c4ElemCount() == m_c4Size);
+        }
+
+        tCIDLib::TBoolean bGetNext(         TElem&              objToFill
+                                    , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                    , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotEmpty
+                , [this, &objToFill]() { return c4TryGet(&objToFill, 1) == 1; }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::False
+            );
+
+            if (bRet)
+                m_sigNotFull.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TBoolean bPut( const   TElem&              objToPut
+                                , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotFull
+                , [this, &objToPut]() { return c4TryPut(&objToPut, 1) == 1; }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::True
+            );
+
+            if (bRet)
+                m_sigNotEmpty.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TBoolean bPut(         TElem&&             objToPut
+                                , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotFull
+                , [this, &objToPut]()
+                  {
+                    if (!c4PutRoom(1))
+                        return kCIDLib::False;
+                    m_ptSlots[m_c4Tail & m_c4Mask] = tCIDLib::ForceMove(objToPut);
+                    TAtomic::ReleaseSet(m_c4Tail, m_c4Tail + 1);
+                    return kCIDLib::True;
+                  }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::True
+            );
+
+            if (bRet)
+                m_sigNotEmpty.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TCard4 c4ElemCount() const
+        {
+            // Get the head first, so the tail can only be the same or beyond it
+            const tCIDLib::TCard4 c4Head = TAtomic::c4AcquireGet(m_c4Head);
+            return TAtomic::c4AcquireGet(m_c4Tail) - c4Head;
+        }
+
+        //
+        //  Get up to c4MaxCount elements, waiting up to the indicated time for
+        //  at least one to show up. Returns the number we got.
+        //
+        tCIDLib::TCard4 c4GetBatch(         TElem* const        ptToFill
+                                    , const tCIDLib::TCard4     c4MaxCount
+                                    , const tCIDLib::TCard4     c4WaitMSs = 0)
+        {
+            if (!c4MaxCount)
+                return 0;
+
+            tCIDLib::TCard4 c4Got = 0;
+            bWaitOn
+            (
+                m_sigNotEmpty
+                , [this, ptToFill, c4MaxCount, &c4Got]()
+                  {
+                    c4Got = c4TryGet(ptToFill, c4MaxCount);
+                    return (c4Got != 0);
+                  }
+                , c4WaitMSs
+                , kCIDLib::False
+                , kCIDLib::False
+            );
+
+            if (c4Got)
+                m_sigNotFull.Wake();
+            return c4Got;
+        }
+
+        //
+        //  Put as many of the passed elements as will fit, waiting up to the
+        //  indicated time for at least some space. Returns the number put.
+        //
+        tCIDLib::TCard4 c4PutBatch( const   TElem* const        ptToPut
+                                    , const tCIDLib::TCard4     c4Count
+                                    , const tCIDLib::TCard4     c4WaitMSs = 0)
+        {
+            if (!c4Count)
+                return 0;
+
+            tCIDLib::TCard4 c4Put = 0;
+            bWaitOn
+            (
+                m_sigNotFull
+                , [this, ptToPut, c4Count, &c4Put]()
+                  {
+                    c4Put = c4TryPut(ptToPut, c4Count);
+                    return (c4Put != 0);
+                  }
+                , c4WaitMSs
+                , kCIDLib::False
+                , kCIDLib::True
+            );
+
+            if (c4Put)
+                m_sigNotEmpty.Wake();
+            return c4Put;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Called on the consumer side to see how many elements are available,
+        //  up to the number wanted. Only if our cached tail doesn't show enough
+        //  do we go get the producer's current tail.
+        //
+        tCIDLib::TCard4 c4GetAvail(const tCIDLib::TCard4 c4Want)
+        {
+            tCIDLib::TCard4 c4Avail = m_c4CachedTail - m_c4Head;
+            if (c4Avail < c4Want)
+            {
+                m_c4CachedTail = TAtomic::c4AcquireGet(m_c4Tail);
+                c4Avail = m_c4CachedTail - m_c4Head;
+            }
+            return tCIDLib::MinVal(c4Avail, c4Want);
+        }
+
+        // The same for the producer side
+        tCIDLib::TCard4 c4PutRoom(const tCIDLib::TCard4 c4Want)
+        {
+            tCIDLib::TCard4 c4Room = m_c4Size - (m_c4Tail - m_c4CachedHead);
+            if (c4Room < c4Want)
+            {
+                m_c4CachedHead = TAtomic::c4AcquireGet(m_c4Head);
+                c4Room = m_c4Size - (m_c4Tail - m_c4CachedHead);
+            }
+            return tCIDLib::MinVal(c4Room, c4Want);
+        }
+
+        tCIDLib::TCard4 c4TryGet(TElem* const ptToFill, const tCIDLib::TCard4 c4MaxCount)
+        {
+            const tCIDLib::TCard4 c4Count = c4GetAvail(c4MaxCount);
+            const tCIDLib::TCard4 c4Head = m_c4Head;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                ptToFill[c4Index] = tCIDLib::ForceMove
+                (
+                    m_ptSlots[(c4Head + c4Index) & m_c4Mask]
+                );
+            }
+
+            // Only the consumer writes the head, and this publishes the freed slots
+            if (c4Count)
+                TAtomic::ReleaseSet(m_c4Head, c4Head + c4Count);
+            return c4Count;
+        }
+
+        tCIDLib::TCard4 c4TryPut(const TElem* const ptToPut, const tCIDLib::TCard4 c4Count)
+        {
+            const tCIDLib::TCard4 c4Room = c4PutRoom(c4Count);
+            const tCIDLib::TCard4 c4Tail = m_c4Tail;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Room; c4Index++)
+                m_ptSlots[(c4Tail + c4Index) & m_c4Mask] = ptToPut[c4Index];
+
+            // Only the producer writes the tail, and this publishes the new elements
+            if (c4Room)
+                TAtomic::ReleaseSet(m_c4Tail, c4Tail + c4Room);
+            return c4Room;
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Head
+        //  m_c4CachedTail
+        //      The consumer side's stuff. The head is the free running index of
+        //      the next element to read and is only written by the consumer. The
+        //      cached tail is the consumer's last read of the producer's tail.
+        //
+        //  m_c4Tail
+        //  m_c4CachedHead
+        //      And the same for the producer side, on a separate cache line.
+        //
+        //  m_ptSlots
+        //      The slots, m_c4Size of them.
+        // -------------------------------------------------------------------
+        alignas(kCIDLib::c4CacheLineSz) mutable tCIDLib::TCard4 m_c4Head;
+        tCIDLib::TCard4                                         m_c4CachedTail;
+        alignas(kCIDLib::c4CacheLineSz) mutable tCIDLib::TCard4 m_c4Tail;
+        tCIDLib::TCard4                                         m_c4CachedHead;
+        alignas(kCIDLib::c4CacheLineSz) TElem*                  m_ptSlots;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TMPMCRingQ
+//  PREFIX: col
+// ---------------------------------------------------------------------------
+template <typename TElem> class TMPMCRingQ : public TRingQBase
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMPMCRingQ(const tCIDLib::TCard4 c4MinSize) :
+
+            TRingQBase(c4MinSize, L"TMPMCRingQ")
+            , m_c4GetPos(0)
+            , m_c4PutPos(0)
+            , m_pslotList(nullptr)
+        {
+            //
+            //  Each slot's sequence starts at its index, which means it's ready
+            //  to be written for the first lap.
+            //
+            m_pslotList = new TSlot[m_c4Size];
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4Size; c4Index++)
+                m_pslotList[c4Index].c4Seq = c4Index;
+        }
+
+        TMPMCRingQ(const TMPMCRingQ&) = delete;
+        TMPMCRingQ(TMPMCRingQ&&) = delete;
+
+        ~TMPMCRingQ()
+        {
+            delete [] m_pslotList;
+            m_pslotList = nullptr;
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMPMCRingQ& operator=(const TMPMCRingQ&) = delete;
+        TMPMCRingQ& operator=(TMPMCRingQ&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsEmpty() const
+        {
+            return (c4ElemCount() == 0);
+        }
+
+        tCIDLib::TBoolean bIsFull() const
+        {
+            return (c4ElemCount() == m_c4Size);
+        }
+
+        tCIDLib::TBoolean bGetNext(         TElem&              objToFill
+                                    , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                    , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotEmpty
+                , [this, &objToFill]() { return c4TryGet(&objToFill, 1) == 1; }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::False
+            );
+
+            if (bRet)
+                m_sigNotFull.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TBoolean bPut( const   TElem&              objToPut
+                                , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotFull
+                , [this, &objToPut]() { return c4TryPut(&objToPut, 1) == 1; }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::True
+            );
+
+            if (bRet)
+                m_sigNotEmpty.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TBoolean bPut(         TElem&&             objToPut
+                                , const tCIDLib::TCard4     c4WaitMSs = kCIDLib::c4MaxWait
+                                , const tCIDLib::TBoolean   bThrowIfTimeout = kCIDLib::False)
+        {
+            const tCIDLib::TBoolean bRet = bWaitOn
+            (
+                m_sigNotFull
+                , [this, &objToPut]()
+                  {
+                    tCIDLib::TCard4 c4At;
+                    if (!c4ClaimPut(1, c4At))
+                        return kCIDLib::False;
+
+                    TSlot& slotTar = m_pslotList[c4At & m_c4Mask];
+                    slotTar.objVal = tCIDLib::ForceMove(objToPut);
+                    TAtomic::ReleaseSet(slotTar.c4Seq, c4At + 1);
+                    return kCIDLib::True;
+                  }
+                , c4WaitMSs
+                , bThrowIfTimeout
+                , kCIDLib::True
+            );
+
+            if (bRet)
+                m_sigNotEmpty.Wake();
+            return bRet;
+        }
+
+        tCIDLib::TCard4 c4ElemCount() const
+        {
+            //
+            //  Get the get position first, so the put can only be the same or
+            //  beyond it. It can be transiently beyond the size while slots are
+            //  being claimed, so clip it.
+            //
+            const tCIDLib::TCard4 c4Get = TAtomic::c4AcquireGet(m_c4GetPos);
+            return tCIDLib::MinVal(TAtomic::c4AcquireGet(m_c4PutPos) - c4Get, m_c4Size);
+        }
+
+        //
+        //  Get up to c4MaxCount elements, waiting up to the indicated time for
+        //  at least one to show up. Returns the number we got.
+        //
+        tCIDLib::TCard4 c4GetBatch(         TElem* const        ptToFill
+                                    , const tCIDLib::TCard4     c4MaxCount
+                                    , const tCIDLib::TCard4     c4WaitMSs = 0)
+        {
+            if (!c4MaxCount)
+                return 0;
+
+            tCIDLib::TCard4 c4Got = 0;
+            bWaitOn
+            (
+                m_sigNotEmpty
+                , [this, ptToFill, c4MaxCount, &c4Got]()
+                  {
+                    c4Got = c4TryGet(ptToFill, c4MaxCount);
+                    return (c4Got != 0);
+                  }
+                , c4WaitMSs
+                , kCIDLib::False
+                , kCIDLib::False
+            );
+
+            if (c4Got)
+                m_sigNotFull.Wake();
+            return c4Got;
+        }
+
+        //
+        //  Put as many of the passed elements as will fit, waiting up to the
+        //  indicated time for at least some space. Returns the number put.
+        //
+        tCIDLib::TCard4 c4PutBatch( const   TElem* const        ptToPut
+                                    , const tCIDLib::TCard4     c4Count
+                                    , const tCIDLib::TCard4     c4WaitMSs = 0)
+        {
+            if (!c4Count)
+                return 0;
+
+            tCIDLib::TCard4 c4Put = 0;
+            bWaitOn
+            (
+                m_sigNotFull
+                , [this, ptToPut, c4Count, &c4Put]()
+                  {
+                    c4Put = c4TryPut(ptToPut, c4Count);
+                    return (c4Put != 0);
+                  }
+                , c4WaitMSs
+                , kCIDLib::False
+                , kCIDLib::True
+            );
+
+            if (c4Put)
+                m_sigNotEmpty.Wake();
+            return c4Put;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data types
+        //
+        //  The sequence number of a slot is equal to the put position that can
+        //  write it next, and is set to that position plus one once written,
+        //  which is the get position plus one that can read it. When read, it's
+        //  set to the get position plus the size, i.e. ready for the next lap.
+        // -------------------------------------------------------------------
+        struct TSlot
+        {
+            tCIDLib::TCard4     c4Seq;
+            TElem               objVal;
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Claim up to c4Want consecutive slots for reading. We find how many in
+        //  a row are ready from the current get position and then try to move the
+        //  get position past them. Returns how many we got, and the position of
+        //  the first.
+        //
+        tCIDLib::TCard4 c4ClaimGet(const tCIDLib::TCard4 c4Want, tCIDLib::TCard4& c4At)
+        {
+            tCIDLib::TCard4 c4Pos = TAtomic::c4AcquireGet(m_c4GetPos);
+            while (kCIDLib::True)
+            {
+                const tCIDLib::TInt4 i4Diff = tCIDLib::TInt4
+                (
+                    TAtomic::c4AcquireGet(m_pslotList[c4Pos & m_c4Mask].c4Seq) - (c4Pos + 1)
+                );
+
+                // If the first one isn't written yet, we are empty
+                if (i4Diff < 0)
+                    return 0;
+
+                // If it's already been read, someone beat us to it
+                if (i4Diff > 0)
+                {
+                    c4Pos = TAtomic::c4AcquireGet(m_c4GetPos);
+                    continue;
+                }
+
+                tCIDLib::TCard4 c4Ready = 1;
+                while (c4Ready < c4Want)
+                {
+                    const tCIDLib::TCard4 c4Cur = c4Pos + c4Ready;
+                    if (TAtomic::c4AcquireGet(m_pslotList[c4Cur & m_c4Mask].c4Seq) != c4Cur + 1)
+                        break;
+                    c4Ready++;
+                }
+
+                const tCIDLib::TCard4 c4Prev = TAtomic::c4CompareAndExchange
+                (
+                    m_c4GetPos, c4Pos + c4Ready, c4Pos
+                );
+                if (c4Prev == c4Pos)
+                {
+                    c4At = c4Pos;
+                    return c4Ready;
+                }
+                c4Pos = c4Prev;
+            }
+            return 0;
+        }
+
+        // The same as above, for writing
+        tCIDLib::TCard4 c4ClaimPut(const tCIDLib::TCard4 c4Want, tCIDLib::TCard4& c4At)
+        {
+            tCIDLib::TCard4 c4Pos = TAtomic::c4AcquireGet(m_c4PutPos);
+            while (kCIDLib::True)
+            {
+                const tCIDLib::TInt4 i4Diff = tCIDLib::TInt4
+                (
+                    TAtomic::c4AcquireGet(m_pslotList[c4Pos & m_c4Mask].c4Seq) - c4Pos
+                );
+
+                // If the first one hasn't been read from the last lap, we are full
+                if (i4Diff < 0)
+                    return 0;
+
+                if (i4Diff > 0)
+                {
+                    c4Pos = TAtomic::c4AcquireGet(m_c4PutPos);
+                    continue;
+                }
+
+                tCIDLib::TCard4 c4Ready = 1;
+                while (c4Ready < c4Want)
+                {
+                    const tCIDLib::TCard4 c4Cur = c4Pos + c4Ready;
+                    if (TAtomic::c4AcquireGet(m_pslotList[c4Cur & m_c4Mask].c4Seq) != c4Cur)
+                        break;
+                    c4Ready++;
+                }
+
+                const tCIDLib::TCard4 c4Prev = TAtomic::c4CompareAndExchange
+                (
+                    m_c4PutPos, c4Pos + c4Ready, c4Pos
+                );
+                if (c4Prev == c4Pos)
+                {
+                    c4At = c4Pos;
+                    return c4Ready;
+                }
+                c4Pos = c4Prev;
+            }
+            return 0;
+        }
+
+        tCIDLib::TCard4 c4TryGet(TElem* const ptToFill, const tCIDLib::TCard4 c4MaxCount)
+        {
+            tCIDLib::TCard4 c4At;
+            const tCIDLib::TCard4 c4Count = c4ClaimGet(c4MaxCount, c4At);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                TSlot& slotCur = m_pslotList[(c4At + c4Index) & m_c4Mask];
+                ptToFill[c4Index] = tCIDLib::ForceMove(slotCur.objVal);
+                TAtomic::ReleaseSet(slotCur.c4Seq, c4At + c4Index + m_c4Size);
+            }
+            return c4Count;
+        }
+
+        tCIDLib::TCard4 c4TryPut(const TElem* const ptToPut, const tCIDLib::TCard4 c4Count)
+        {
+            tCIDLib::TCard4 c4At;
+            const tCIDLib::TCard4 c4Claimed = c4ClaimPut(c4Count, c4At);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Claimed; c4Index++)
+            {
+                TSlot& slotCur = m_pslotList[(c4At + c4Index) & m_c4Mask];
+                slotCur.objVal = ptToPut[c4Index];
+                TAtomic::ReleaseSet(slotCur.c4Seq, c4At + c4Index + 1);
+            }
+            return c4Claimed;
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4GetPos
+        //  m_c4PutPos
+        //      The free running get and put positions, each on its own cache
+        //      line since they are hammered by the consumers and producers
+        //      respectively.
+        //
+        //  m_pslotList
+        //      The slots, m_c4Size of them.
+        // -------------------------------------------------------------------
+        alignas(kCIDLib::c4CacheLineSz) mutable tCIDLib::TCard4 m_c4GetPos;
+        alignas(kCIDLib::c4CacheLineSz) mutable tCIDLib::TCard4 m_c4PutPos;
+        alignas(kCIDLib::c4CacheLineSz) TSlot*                  m_pslotList;
+};
+
+#pragma CIDLIB_POPPACK
@@ -99,6 +99,7 @@ class CIDLIBEXP TSLstNode : public TObject
         // -------------------------------------------------------------------
         //  Do any needed magic macros
         // -------------------------------------------------------------------
+        SlabAllocDefs()
         RTTIDefs(TSLstNode,TObject)
 };
 
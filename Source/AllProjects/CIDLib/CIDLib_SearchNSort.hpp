@@ -1370,6 +1370,18 @@ namespace TArrayOps
     }
 
 
+    //
+    //  The parallel version of TSort. It needs the thread pool, which is way
+    //  down the food chain from here, so it's implemented in CIDLib_ParColAlgo.hpp.
+    //  It's declared here so that the collections can provide parallel sorts.
+    //
+    template <typename T, typename TComp = tCIDLib::TDefMagComp<T>>
+    tCIDLib::TVoid TParSort(        T*                  ptArray
+                            , const tCIDLib::TCard4     c4Count
+                            ,       TComp               pfnComp = TComp()
+                            , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain);
+
+
     //
     //  A simple template method for binary searching a sorted array. If the
     //  element was found, the return is kCIDLib::True and the index of
@@ -0,0 +1,244 @@
+//
+// FILE NAME: CIDLib_SeqLock.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements TSeqLock, a sequence lock. This is for small structures
+//  that are read very often and written rarely. Readers take no lock at all. They
+//  read the sequence number, copy out the data, and then check the sequence number
+//  again. If it changed, or was odd to begin with (meaning a write was in progress)
+//  they just try again. Writers are serialized by a critical section, and bump the
+//  sequence number before and after they make changes.
+//
+//  So readers never block writers and never block each other, and they don't
+//  write to any shared memory, so they don't bounce cache lines between cores.
+//
+//  There are Read() and Write() helpers that take a lambda to do the reading or
+//  writing, and handle the retry loop and the write bracketing. And there's a
+//  simple TSeqLockedVal template for the common case of just protecting a single
+//  small value that is always read and written as a whole.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Readers can see partially updated data, which they then throw away when
+//      they see that the sequence changed. So the reading code can't do anything
+//      with the data but copy it out. It cannot follow pointers in it or make
+//      decisions based on it until the read has been validated. That also means
+//      the data should be simple values, not objects that manage memory.
+//
+//  2)  This is not a replacement for a lock for anything that's written often,
+//      since readers will just spin.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TSeqLock
+//  PREFIX: sqlk
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TSeqLock
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TSeqLock() :
+
+            m_c4Seq(0)
+        {
+        }
+
+        TSeqLock(const TSeqLock&) = delete;
+        TSeqLock(TSeqLock&&) = delete;
+
+        ~TSeqLock() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TSeqLock& operator=(const TSeqLock&) = delete;
+        TSeqLock& operator=(TSeqLock&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+
+        // Returns true if the read that started at the passed sequence must be redone
+        tCIDLib::TBoolean bReadRetry(const tCIDLib::TCard4 c4Start) const
+        {
+            // Make sure our reads of the data are done before we check again
+            TAtomic::AcquireFence();
+            return (TAtomic::c4AcquireGet(m_c4Seq) != c4Start);
+        }
+
+        // Wait for any write in progress to complete and return the sequence
+        tCIDLib::TCard4 c4ReadBegin() const
+        {
+            tCIDLib::TCard4 c4Seq = TAtomic::c4AcquireGet(m_c4Seq);
+            tCIDLib::TCard4 c4Spins = 0;
+            while (c4Seq & 1)
+            {
+                // If it's taking a while, let the writer get some time
+                if (++c4Spins > kCIDLib::c4SeqLockSpins)
+                    TKrnlThread::Sleep(0);
+                c4Seq = TAtomic::c4AcquireGet(m_c4Seq);
+            }
+            return c4Seq;
+        }
+
+        template <typename TReadFunc> tCIDLib::TVoid Read(TReadFunc fnRead) const
+        {
+            tCIDLib::TCard4 c4Seq;
+            do
+            {
+                c4Seq = c4ReadBegin();
+                fnRead();
+            }   while (bReadRetry(c4Seq));
+        }
+
+        template <typename TWriteFunc> tCIDLib::TVoid Write(TWriteFunc fnWrite)
+        {
+            WriteBegin();
+            try
+            {
+                fnWrite();
+            }
+
+            catch(...)
+            {
+                WriteEnd();
+                throw;
+            }
+            WriteEnd();
+        }
+
+        //
+        //  The exchange is a full fence, so the writer's changes can't be seen
+        //  before readers can see the sequence is odd.
+        //
+        tCIDLib::TVoid WriteBegin()
+        {
+            m_crsWriters.Enter();
+            TAtomic::c4Exchange(m_c4Seq, m_c4Seq + 1);
+        }
+
+        tCIDLib::TVoid WriteEnd()
+        {
+            TAtomic::ReleaseSet(m_c4Seq, m_c4Seq + 1);
+            m_crsWriters.Exit();
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Seq
+        //      The sequence number. It's odd while a write is in progress. It's
+        //      on its own cache line since readers hit it constantly.
+        //
+        //  m_crsWriters
+        //      Serializes writers.
+        // -------------------------------------------------------------------
+        alignas(kCIDLib::c4CacheLineSz) mutable tCIDLib::TCard4 m_c4Seq;
+        TCriticalSection                                        m_crsWriters;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TSeqLockedVal
+//  PREFIX: sqlv
+//
+//  A simple wrapper around a small value that is protected by a sequence lock.
+//  The value type must be something that can be safely copied while it's being
+//  written, i.e. fundamental types or simple structures of them.
+// ---------------------------------------------------------------------------
+template <typename T> class TSeqLockedVal
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TSeqLockedVal() :
+
+            m_tValue()
+        {
+        }
+
+        TSeqLockedVal(const T& tInit) :
+
+            m_tValue(tInit)
+        {
+        }
+
+        TSeqLockedVal(const TSeqLockedVal&) = delete;
+        TSeqLockedVal(TSeqLockedVal&&) = delete;
+
+        ~TSeqLockedVal() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TSeqLockedVal& operator=(const TSeqLockedVal&) = delete;
+        TSeqLockedVal& operator=(TSeqLockedVal&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        T tValue() const
+        {
+            T tRet;
+            m_sqlkSync.Read([this, &tRet]() { tRet = m_tValue; });
+            return tRet;
+        }
+
+        tCIDLib::TVoid SetValue(const T& tToSet)
+        {
+            m_sqlkSync.Write([this, &tToSet]() { m_tValue = tToSet; });
+        }
+
+        // Update the value in place, via a callback that gets the value
+        template <typename TUpdFunc> tCIDLib::TVoid Update(TUpdFunc fnUpdate)
+        {
+            m_sqlkSync.Write([this, &fnUpdate]() { fnUpdate(m_tValue); });
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_sqlkSync
+        //      The sequence lock that protects the value.
+        //
+        //  m_tValue
+        //      The value.
+        // -------------------------------------------------------------------
+        TSeqLock    m_sqlkSync;
+        T           m_tValue;
+};
+
+#pragma CIDLIB_POPPACK
@@ -743,7 +743,7 @@ template<typename TElem> class TSimplePool : public TObject, public MLockable
             , m_strName(strName)
         {
             // If MT safe, then allocate the critical section
-            if (eMTSafe == tCIDLib::EMTStates::Safe)
+            if (eMTSafe != tCIDLib::EMTStates::Unsafe)
                 m_pmtxSync = new TMutex;
         }
 
@@ -0,0 +1,458 @@
+//
+// FILE NAME: CIDLib_SlabAlloc.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TSlabAlloc namespace.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  This is used to allocate collection nodes, so nothing in here can use
+//      collections, or anything else that might call back into here while we
+//      have a depot locked.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_SlabAlloc
+    {
+        // -----------------------------------------------------------------------
+        //  The size classes. Anything over the largest goes to the heap.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4ClassCnt = 10;
+        constexpr tCIDLib::TCard4   ac4ClassSizes[c4ClassCnt] =
+        {
+            16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+        };
+        constexpr tCIDLib::TCard4   c4MaxSize = 512;
+
+
+        // -----------------------------------------------------------------------
+        //  c4MagSize
+        //      The number of blocks moved between a magazine and the depot at
+        //      a time. A magazine that gets to twice this gives back a batch.
+        //
+        //  c4SlabBytes
+        //      The size of the slabs we carve up into blocks.
+        //
+        //  c4StatsFlushCnt
+        //      We push stats out every time this many depot trips are made.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MagSize       = 32;
+        constexpr tCIDLib::TCard4   c4SlabBytes     = 0x10000;
+        constexpr tCIDLib::TCard4   c4StatsFlushCnt = 64;
+
+
+        // -----------------------------------------------------------------------
+        //  Our enabled state, which is latched on first use.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4State_Unknown = 0;
+        constexpr tCIDLib::TCard4   c4State_Off     = 1;
+        constexpr tCIDLib::TCard4   c4State_On      = 2;
+        tCIDLib::TCard4             c4State = c4State_Unknown;
+
+
+        // -----------------------------------------------------------------------
+        //  A free block is just a link to the next one
+        // -----------------------------------------------------------------------
+        struct TFreeBlk
+        {
+            TFreeBlk*   pNext;
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The central depot for each size class, and its stats, which are only
+        //  updated under its lock. The threads' alloc/free counts are added in
+        //  when they make a trip to the depot.
+        // -----------------------------------------------------------------------
+        struct TDepot
+        {
+            TCriticalSection    crsSync;
+            TFreeBlk*           pHead = nullptr;
+            tCIDLib::TCard4     c4Count = 0;
+            tCIDLib::TCard8     c8Allocs = 0;
+            tCIDLib::TCard8     c8Frees = 0;
+            tCIDLib::TCard8     c8SlabBytes = 0;
+            tCIDLib::TCard8     c8Trips = 0;
+        };
+
+        //
+        //  These are never destroyed, since nodes can be freed during static
+        //  cleanup after we'd otherwise be gone.
+        //
+        TDepot* padepList()
+        {
+            static TDepot* padepRet = new TDepot[c4ClassCnt];
+            return padepRet;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The per-thread magazines. When the thread ends, all of its blocks go
+        //  back to the depot. Anything freed on this thread after that (by other
+        //  thread local cleanup) goes straight to the depot.
+        // -----------------------------------------------------------------------
+        struct TMagazine
+        {
+            TFreeBlk*           pHead;
+            tCIDLib::TCard4     c4Count;
+            tCIDLib::TCard4     c4Allocs;
+            tCIDLib::TCard4     c4Frees;
+        };
+
+        struct TThreadCache
+        {
+            TThreadCache();
+            ~TThreadCache();
+
+            TMagazine   amagList[c4ClassCnt];
+        };
+
+        thread_local tCIDLib::TBoolean  bCacheDead = kCIDLib::False;
+        thread_local TThreadCache       tcacheThread;
+
+
+        // -----------------------------------------------------------------------
+        //  The stats cache items
+        // -----------------------------------------------------------------------
+        TAtomicFlag         atomStatsInit;
+        TStatsCacheItem     sciAllocs;
+        TStatsCacheItem     sciDepotTrips;
+        TStatsCacheItem     sciFrees;
+        TStatsCacheItem     sciSlabBytes;
+
+        TCriticalSection* pcrsStats()
+        {
+            static TCriticalSection crsStats;
+            return &crsStats;
+        }
+
+
+        // Return the size class for a size, which must be <= c4MaxSize
+        inline tCIDLib::TCard4 c4ClassFor(const tCIDLib::TCard4 c4Size)
+        {
+            if (c4Size <= 64)
+                return c4Size ? ((c4Size + 15) >> 4) - 1 : 0;
+
+            tCIDLib::TCard4 c4Class = 4;
+            while (ac4ClassSizes[c4Class] < c4Size)
+                c4Class++;
+            return c4Class;
+        }
+
+
+        //
+        //  Move up to c4Cnt blocks from the depot to the magazine, carving up a
+        //  new slab if the depot is empty. Returns true if we should flush stats.
+        //
+        tCIDLib::TBoolean bRefill(  const   tCIDLib::TCard4     c4Class
+                                    ,       TMagazine&          magTar
+                                    , const tCIDLib::TCard4     c4Cnt)
+        {
+            TDepot& depSrc = padepList()[c4Class];
+            TCritSecLocker crslSync(&depSrc.crsSync);
+
+            if (!depSrc.pHead)
+            {
+                const tCIDLib::TCard4 c4BlkSz = ac4ClassSizes[c4Class];
+                tCIDLib::TCard1* pc1Slab = new tCIDLib::TCard1[c4SlabBytes];
+                const tCIDLib::TCard4 c4BlkCnt = c4SlabBytes / c4BlkSz;
+
+                // Link them up in address order
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlkCnt; c4Index++)
+                {
+                    TFreeBlk* pblkCur = reinterpret_cast<TFreeBlk*>(pc1Slab + (c4Index * c4BlkSz));
+                    pblkCur->pNext = (c4Index + 1 < c4BlkCnt)
+                                     ? reinterpret_cast<TFreeBlk*>(pc1Slab + ((c4Index + 1) * c4BlkSz))
+                                     : nullptr;
+                }
+                depSrc.pHead = reinterpret_cast<TFreeBlk*>(pc1Slab);
+                depSrc.c4Count = c4BlkCnt;
+                depSrc.c8SlabBytes += c4SlabBytes;
+            }
+
+            tCIDLib::TCard4 c4Moved = 0;
+            while (depSrc.pHead && (c4Moved < c4Cnt))
+            {
+                TFreeBlk* pblkCur = depSrc.pHead;
+                depSrc.pHead = pblkCur->pNext;
+                pblkCur->pNext = magTar.pHead;
+                magTar.pHead = pblkCur;
+                c4Moved++;
+            }
+            depSrc.c4Count -= c4Moved;
+            magTar.c4Count += c4Moved;
+
+            depSrc.c8Allocs += magTar.c4Allocs;
+            depSrc.c8Frees += magTar.c4Frees;
+            magTar.c4Allocs = 0;
+            magTar.c4Frees = 0;
+
+            depSrc.c8Trips++;
+            return (depSrc.c8Trips % c4StatsFlushCnt) == 0;
+        }
+
+
+        // Move up to c4Cnt blocks from the magazine back to the depot
+        tCIDLib::TBoolean bReturn(  const   tCIDLib::TCard4     c4Class
+                                    ,       TMagazine&          magSrc
+                                    , const tCIDLib::TCard4     c4Cnt)
+        {
+            TDepot& depTar = padepList()[c4Class];
+            TCritSecLocker crslSync(&depTar.crsSync);
+
+            tCIDLib::TCard4 c4Moved = 0;
+            while (magSrc.pHead && (c4Moved < c4Cnt))
+            {
+                TFreeBlk* pblkCur = magSrc.pHead;
+                magSrc.pHead = pblkCur->pNext;
+                pblkCur->pNext = depTar.pHead;
+                depTar.pHead = pblkCur;
+                c4Moved++;
+            }
+            magSrc.c4Count -= c4Moved;
+            depTar.c4Count += c4Moved;
+
+            depTar.c8Allocs += magSrc.c4Allocs;
+            depTar.c8Frees += magSrc.c4Frees;
+            magSrc.c4Allocs = 0;
+            magSrc.c4Frees = 0;
+
+            depTar.c8Trips++;
+            return (depTar.c8Trips % c4StatsFlushCnt) == 0;
+        }
+
+
+        TThreadCache::TThreadCache()
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ClassCnt; c4Index++)
+            {
+                TMagazine& magCur = amagList[c4Index];
+                magCur.pHead = nullptr;
+                magCur.c4Count = 0;
+                magCur.c4Allocs = 0;
+                magCur.c4Frees = 0;
+            }
+        }
+
+        TThreadCache::~TThreadCache()
+        {
+            bCacheDead = kCIDLib::True;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ClassCnt; c4Index++)
+            {
+                TMagazine& magCur = amagList[c4Index];
+                if (magCur.c4Count || magCur.c4Allocs || magCur.c4Frees)
+                    bReturn(c4Index, magCur, kCIDLib::c4MaxCard);
+            }
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TSlabAlloc functions
+// ---------------------------------------------------------------------------
+
+//
+//  Turn on the allocator if it hasn't been latched yet. It returns whether it's
+//  on, so the caller can tell if they were too late.
+//
+tCIDLib::TBoolean TSlabAlloc::bEnable()
+{
+    TRawMem::c4CompareAndExchange
+    (
+        CIDLib_SlabAlloc::c4State
+        , CIDLib_SlabAlloc::c4State_On
+        , CIDLib_SlabAlloc::c4State_Unknown
+    );
+    return bEnabled();
+}
+
+
+tCIDLib::TBoolean TSlabAlloc::bEnabled()
+{
+    tCIDLib::TCard4 c4Cur = TAtomic::c4AcquireGet(CIDLib_SlabAlloc::c4State);
+    if (c4Cur == CIDLib_SlabAlloc::c4State_Unknown)
+    {
+        // Not latched yet, so check the environment
+        tCIDLib::TCh achVal[8];
+        tCIDLib::TCard4 c4New = CIDLib_SlabAlloc::c4State_Off;
+        if (TKrnlEnvironment::bFind(L"CID_SLABALLOC", achVal, 7)
+        &&  (achVal[0] == kCIDLib::chDigit1))
+        {
+            c4New = CIDLib_SlabAlloc::c4State_On;
+        }
+
+        // Somone else may have beat us to it, and then theirs wins
+        TRawMem::c4CompareAndExchange
+        (
+            CIDLib_SlabAlloc::c4State, c4New, CIDLib_SlabAlloc::c4State_Unknown
+        );
+        c4Cur = TAtomic::c4AcquireGet(CIDLib_SlabAlloc::c4State);
+    }
+    return (c4Cur == CIDLib_SlabAlloc::c4State_On);
+}
+
+
+tCIDLib::TVoid
+TSlabAlloc::Free(tCIDLib::TVoid* const pToFree, const tCIDLib::TCard4 c4Size)
+{
+    if (!pToFree)
+        return;
+
+    if ((c4Size > CIDLib_SlabAlloc::c4MaxSize) || !bEnabled())
+    {
+        ::operator delete(pToFree);
+        return;
+    }
+
+    const tCIDLib::TCard4 c4Class = CIDLib_SlabAlloc::c4ClassFor(c4Size);
+    CIDLib_SlabAlloc::TFreeBlk* pblkFree = static_cast<CIDLib_SlabAlloc::TFreeBlk*>(pToFree);
+
+    tCIDLib::TBoolean bFlush = kCIDLib::False;
+    if (CIDLib_SlabAlloc::bCacheDead)
+    {
+        // This thread's cache is gone, so return it directly
+        CIDLib_SlabAlloc::TMagazine magTmp{ pblkFree, 1, 0, 1 };
+        pblkFree->pNext = nullptr;
+        bFlush = CIDLib_SlabAlloc::bReturn(c4Class, magTmp, 1);
+    }
+     else
+    {
+        CIDLib_SlabAlloc::TMagazine& magTar = CIDLib_SlabAlloc::tcacheThread.amagList[c4Class];
+        pblkFree->pNext = magTar.pHead;
+        magTar.pHead = pblkFree;
+        magTar.c4Count++;
+        magTar.c4Frees++;
+
+        if (magTar.c4Count >= CIDLib_SlabAlloc::c4MagSize * 2)
+            bFlush = CIDLib_SlabAlloc::bReturn(c4Class, magTar, CIDLib_SlabAlloc::c4MagSize);
+    }
+
+    if (bFlush)
+        UpdateStats();
+}
+
+
+tCIDLib::TVoid* TSlabAlloc::pAlloc(const tCIDLib::TCard4 c4Size)
+{
+    if ((c4Size > CIDLib_SlabAlloc::c4MaxSize) || !bEnabled())
+        return ::operator new(c4Size);
+
+    const tCIDLib::TCard4 c4Class = CIDLib_SlabAlloc::c4ClassFor(c4Size);
+
+    tCIDLib::TBoolean bFlush = kCIDLib::False;
+    CIDLib_SlabAlloc::TFreeBlk* pblkRet = nullptr;
+    if (CIDLib_SlabAlloc::bCacheDead)
+    {
+        CIDLib_SlabAlloc::TMagazine magTmp{ nullptr, 0, 1, 0 };
+        bFlush = CIDLib_SlabAlloc::bRefill(c4Class, magTmp, 1);
+        pblkRet = magTmp.pHead;
+    }
+     else
+    {
+        CIDLib_SlabAlloc::TMagazine& magSrc = CIDLib_SlabAlloc::tcacheThread.amagList[c4Class];
+        if (!magSrc.pHead)
+            bFlush = CIDLib_SlabAlloc::bRefill(c4Class, magSrc, CIDLib_SlabAlloc::c4MagSize);
+
+        pblkRet = magSrc.pHead;
+        magSrc.pHead = pblkRet->pNext;
+        magSrc.c4Count--;
+        magSrc.c4Allocs++;
+    }
+
+    if (bFlush)
+        UpdateStats();
+
+    return pblkRet;
+}
+
+
+//
+//  Push our current stats out to the stats cache. The per-thread counts that
+//  haven't made it back to the depots yet aren't included.
+//
+tCIDLib::TVoid TSlabAlloc::UpdateStats()
+{
+    if (!CIDLib_SlabAlloc::atomStatsInit)
+    {
+        TCritSecLocker crslStats(CIDLib_SlabAlloc::pcrsStats());
+        if (!CIDLib_SlabAlloc::atomStatsInit)
+        {
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Slab_Allocs
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_SlabAlloc::sciAllocs
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Slab_DepotTrips
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_SlabAlloc::sciDepotTrips
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Slab_Frees
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_SlabAlloc::sciFrees
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_Slab_SlabBytes
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_SlabAlloc::sciSlabBytes
+            );
+            CIDLib_SlabAlloc::atomStatsInit.Set();
+        }
+    }
+
+    tCIDLib::TCard8 c8Allocs = 0;
+    tCIDLib::TCard8 c8Frees = 0;
+    tCIDLib::TCard8 c8SlabBytes = 0;
+    tCIDLib::TCard8 c8Trips = 0;
+    CIDLib_SlabAlloc::TDepot* padepList = CIDLib_SlabAlloc::padepList();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < CIDLib_SlabAlloc::c4ClassCnt; c4Index++)
+    {
+        CIDLib_SlabAlloc::TDepot& depCur = padepList[c4Index];
+        TCritSecLocker crslSync(&depCur.crsSync);
+        c8Allocs += depCur.c8Allocs;
+        c8Frees += depCur.c8Frees;
+        c8SlabBytes += depCur.c8SlabBytes;
+        c8Trips += depCur.c8Trips;
+    }
+
+    TStatsCache::SetValue(CIDLib_SlabAlloc::sciAllocs, c8Allocs);
+    TStatsCache::SetValue(CIDLib_SlabAlloc::sciDepotTrips, c8Trips);
+    TStatsCache::SetValue(CIDLib_SlabAlloc::sciFrees, c8Frees);
+    TStatsCache::SetValue(CIDLib_SlabAlloc::sciSlabBytes, c8SlabBytes);
+}
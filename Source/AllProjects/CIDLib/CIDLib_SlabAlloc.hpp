@@ -0,0 +1,114 @@
+//
+// FILE NAME: CIDLib_SlabAlloc.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TSlabAlloc namespace, which is a thread caching
+//  allocator for small objects, mostly collection nodes. These are allocated
+//  and freed at a high rate, and under multi-threaded load every one of them
+//  is a trip through the global heap's locking.
+//
+//  Sizes are rounded up to one of a small set of size classes. Each class has
+//  a central depot of free blocks, which is locked, and each thread has a
+//  magazine per class, which is not. Allocations and frees just pop and push
+//  on the calling thread's magazine. When a magazine runs dry it takes a batch
+//  from the depot, and when it gets too full it gives a batch back. When the
+//  depot runs dry, a new slab is carved up into blocks for that class.
+//
+//  Classes opt in by using the SlabAllocDefs() macro in their class definition,
+//  which gives them class specific new/delete operators that call here. The
+//  collection node classes do this, so all collections get it.
+//
+//  The allocator as a whole is also opt in. Unless it's enabled, we just pass
+//  everything through to the global heap. It's enabled by setting the
+//  CID_SLABALLOC environment variable to 1, or by calling bEnable() before
+//  the first allocation. Whether it's on or off is latched on the first
+//  allocation and can't change after that.
+//
+//  Stats are published to the stats cache, under the slab allocator scope.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The size of the block is needed to free it, which is why this is only
+//      for use via class specific operators. The compiler passes the size of
+//      the actual class being deleted (as long as the destructor is virtual
+//      if deleting via a base class.)
+//
+//  2)  Slabs are never given back to the heap. Free blocks just go back to
+//      the depot for reuse.
+//
+//  3)  A block freed on another thread than it was allocated on is fine, it
+//      just ends up in the freeing thread's magazine.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//  NAMESPACE: TSlabAlloc
+// ---------------------------------------------------------------------------
+namespace TSlabAlloc
+{
+    CIDLIBEXP tCIDLib::TBoolean bEnable();
+
+    CIDLIBEXP tCIDLib::TBoolean bEnabled();
+
+    CIDLIBEXP tCIDLib::TVoid Free
+    (
+                tCIDLib::TVoid* const   pToFree
+        , const tCIDLib::TCard4         c4Size
+    );
+
+    CIDLIBEXP tCIDLib::TVoid* pAlloc
+    (
+        const   tCIDLib::TCard4         c4Size
+    );
+
+    CIDLIBEXP tCIDLib::TVoid UpdateStats();
+}
+
+#pragma CIDLIB_POPPACK
+
+
+// ---------------------------------------------------------------------------
+//  Put this in a class to have it allocated via the slab allocator. It's
+//  inherited by derived classes. A placement new is provided as well, since
+//  otherwise the class specific one would hide the global one.
+// ---------------------------------------------------------------------------
+#define SlabAllocDefs() \
+public : \
+static tCIDLib::TVoid* operator new(const size_t szAlloc) \
+{ \
+    return TSlabAlloc::pAlloc(tCIDLib::TCard4(szAlloc)); \
+} \
+\
+static tCIDLib::TVoid* operator new(const size_t, tCIDLib::TVoid* const pAt) \
+{ \
+    return pAt; \
+} \
+\
+static tCIDLib::TVoid operator delete(tCIDLib::TVoid* const pToFree, const size_t szAlloc) \
+{ \
+    TSlabAlloc::Free(pToFree, tCIDLib::TCard4(szAlloc)); \
+} \
+\
+static tCIDLib::TVoid operator delete(tCIDLib::TVoid* const, tCIDLib::TVoid* const) \
+{ \
+}
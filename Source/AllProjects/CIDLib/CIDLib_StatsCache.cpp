@@ -108,7 +108,6 @@ class TStatsCacheNode
             , m_c8CreateStamp(TTime::enctNow())
             , m_c8Value(0)
             , m_eType(tCIDLib::EStatItemTypes::Value)
-            , m_pszKey(nullptr)
         {
         }
 
@@ -117,14 +116,12 @@ class TStatsCacheNode
                         , const tCIDLib::TCard8         c8Value = 0) :
 
             m_c8CreateStamp(TTime::enctNow())
-            , m_pszKey(nullptr)
         {
             Set(pszKey, eType, c8Value);
         }
 
         ~TStatsCacheNode()
         {
-            delete [] m_pszKey;
         }
 
 
@@ -139,9 +136,11 @@ class TStatsCacheNode
 
         tCIDLib::TBoolean bIsThisKey
         (
-            const   tCIDLib::TCh* const     pszKey
-            , const tCIDLib::TCard4         c4SrcLen
-        )   const;
+            const   TAtom&                  atmKey
+        )   const
+        {
+            return (m_atmKey == atmKey);
+        }
 
         tCIDLib::TBoolean bSetIfHigher
         (
@@ -189,7 +188,7 @@ class TStatsCacheNode
 
         const tCIDLib::TCh* pszKey() const
         {
-            return m_pszKey;
+            return m_atmKey.pszText();
         }
 
         tCIDLib::TVoid Set
@@ -212,6 +211,11 @@ class TStatsCacheNode
         // -------------------------------------------------------------------
         //  Private data values
         //
+        //  m_atmKey
+        //      The key for this node, which is the full path. It's an atom, so
+        //      looking up a node by key is just an identity check, and the text
+        //      is shared with anything else that interns the same path.
+        //
         //  m_c4KeyLen
         //      We pre-store the key length to help speed up searches.
         //
@@ -229,17 +233,13 @@ class TStatsCacheNode
         //  m_eType
         //      The type of this item, which really just means how the value
         //      should be interpreted.
-        //
-        //  m_pszKey
-        //      The key for this node. It's the full path and allocated to
-        //      hold the key, so we have to delete it when we destruct.
         // -------------------------------------------------------------------
+        TAtom                   m_atmKey;
         tCIDLib::TCard4         m_c4KeyLen;
         tCIDLib::TCard8         m_c8ChangeStamp;
         tCIDLib::TCard8         m_c8CreateStamp;
         tCIDLib::TCard8         m_c8Value;
         tCIDLib::EStatItemTypes m_eType;
-        tCIDLib::TCh*           m_pszKey;
 };
 
 
@@ -258,7 +258,7 @@ TStatsCacheNode::bIsInThisScope(const   tCIDLib::TCh* const pszScope
 
     // We start at the same point in both strings, at the end of the scope
     const tCIDLib::TCh* psz1 = pszScope + c4ScopeLen;
-    const tCIDLib::TCh* psz2 = m_pszKey + c4ScopeLen;
+    const tCIDLib::TCh* psz2 = m_atmKey.pszText() + c4ScopeLen;
     while(psz1 != pszScope)
     {
         psz1--;
@@ -272,33 +272,6 @@ TStatsCacheNode::bIsInThisScope(const   tCIDLib::TCh* const pszScope
 }
 
 
-//
-//  Do an efficient check to see if this guy has the key passed. We do a
-//  from the end comparison, to quickly discard mismatches.
-//
-tCIDLib::TBoolean
-TStatsCacheNode::bIsThisKey(const   tCIDLib::TCh* const pszKey
-                            , const tCIDLib::TCard4     c4SrcLen) const
-{
-    // We can do a quick check of the length first
-    if (m_c4KeyLen != c4SrcLen)
-        return kCIDLib::False;
-
-    const tCIDLib::TCh* psz1 = pszKey + c4SrcLen;
-    const tCIDLib::TCh* psz2 = m_pszKey + m_c4KeyLen;
-    while(psz1 != pszKey)
-    {
-        psz1--;
-        psz2--;
-        if (*psz1 != *psz2)
-            break;
-    }
-
-    // If we make it all the way down to the first character, they matched
-    return (psz1 == pszKey);
-}
-
-
 // If the passed value is higher than the current value, it's the new value
 tCIDLib::TBoolean
 TStatsCacheNode::bSetIfHigher(const tCIDLib::TCard8 c8ToSet)
@@ -319,13 +292,11 @@ TStatsCacheNode::Set(const  tCIDLib::TCh*           pszKey
                     , const tCIDLib::EStatItemTypes eType
                     , const tCIDLib::TCard8         c8Value)
 {
-    m_c4KeyLen = TRawStr::c4StrLen(pszKey);
+    m_atmKey = TAtom(pszKey);
+    m_c4KeyLen = m_atmKey.c4Length();
     m_c8ChangeStamp = TTime::enctNow();
     m_c8Value = c8Value;
     m_eType = eType;
-
-    delete [] m_pszKey;
-    m_pszKey = TRawStr::pszReplicate(pszKey);
 }
 
 
@@ -436,12 +407,22 @@ static TStatsCacheNode* pscnAdd(const   tCIDLib::TCh* const     pszKey
 static TStatsCacheNode* pscnFind(const  tCIDLib::TCh* const pszKey
                                 ,       tCIDLib::TCard4&    c4At)
 {
+    //
+    //  All of our keys are interned, so if this one hasn't been, it can't be
+    //  one of ours. Else we just look for the node with the same atom.
+    //
+    TAtom atmKey;
+    if (!TAtom::bFind(pszKey, atmKey))
+    {
+        c4At = CIDLib_StatsCache::c4CacheUsed;
+        return nullptr;
+    }
+
     c4At = 0;
-    const tCIDLib::TCard4 c4KeyLen = TRawStr::c4StrLen(pszKey);
     while (c4At < CIDLib_StatsCache::c4CacheUsed)
     {
         // Check this one and if it matches, break out
-        if (CIDLib_StatsCache::apscnCache[c4At]->bIsThisKey(pszKey, c4KeyLen))
+        if (CIDLib_StatsCache::apscnCache[c4At]->bIsThisKey(atmKey))
             break;
 
         // Not there yet, so move up and try again
@@ -2172,6 +2172,16 @@ tCIDLib::TCard4 TString::c4Val(const tCIDLib::ERadices eRadix) const
 }
 
 
+//
+//  Does the fast 64 bit hash of our contents. This isn't cached, unlike the regular
+//  hash, since it's already cheap.
+//
+tCIDLib::TCard8 TString::c8CalcHash64(const tCIDLib::TBoolean bCase) const
+{
+    return TRawStr::c8HashStr64(m_strbData.pszBuffer(), m_strbData.c4CurEnd(), bCase);
+}
+
+
 // Tries to convert this string to a Card8 value. Assumes the indicated radix
 tCIDLib::TCard8 TString::c8Val(const tCIDLib::ERadices eRadix) const
 {
@@ -3136,12 +3146,38 @@ tCIDLib::TVoid TString::FromZStr(const  tCIDLib::TCh* const pszSrc
 }
 
 
-// Does a standard hash calcualtion on the contents of this string
+//
+//  Does a standard hash calcualtion on the contents of this string. The raw hash is
+//  cached by the buffer until we are changed, so we only need to apply the modulus.
+//
 tCIDLib::THashVal
 TString::hshCalcHash(const tCIDLib::TCard4 c4Modulus) const
 {
-    tCIDLib::THashVal hshRet = TRawStr::hshHashStr(pszBuffer(), c4Modulus);
-    if (!hshRet)
+    tCIDLib::TCard4 c4Raw;
+    if (!m_strbData.bRawHash(kCIDLib::True, c4Raw))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcStr_NotValidUnicode
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+        );
+    }
+    return TRawStr::hshFromRawHash(c4Raw, c4Modulus);
+}
+
+
+//
+//  The same as above but case insensitive. The result is the same as lower casing
+//  a copy and hashing that, but without the copy.
+//
+tCIDLib::THashVal
+TString::hshCalcHashI(const tCIDLib::TCard4 c4Modulus) const
+{
+    tCIDLib::TCard4 c4Raw;
+    if (!m_strbData.bRawHash(kCIDLib::False, c4Raw))
     {
         facCIDLib().ThrowErr
         (
@@ -3152,7 +3188,7 @@ TString::hshCalcHash(const tCIDLib::TCard4 c4Modulus) const
             , tCIDLib::EErrClasses::Format
         );
     }
-    return hshRet;
+    return TRawStr::hshFromRawHash(c4Raw, c4Modulus);
 }
 
 
@@ -4335,6 +4371,8 @@ TString::TStrBuf::TStrBuf(const TStrBuf& strbSrc) :
 
     m_c4BufSz(strbSrc.m_c4BufSz)
     , m_c4CurEnd(strbSrc.m_c4CurEnd)
+    , m_c4HashCache(TAtomic::c4RelaxedGet(strbSrc.m_c4HashCache))
+    , m_c4HashCacheI(TAtomic::c4RelaxedGet(strbSrc.m_c4HashCacheI))
     , m_szSmallBuf(L"")
 {
     m_szSmallBuf[0] = kCIDLib::chNull;
@@ -4476,6 +4514,10 @@ TString::TStrBuf& TString::TStrBuf::operator=(const TStrBuf& strbSrc)
             TRawMem::CopyMemBuf(m_pszBuffer, strbSrc.m_pszBuffer, m_c4CurEnd * kCIDLib::c4CharBytes);
         }
         m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
+
+        // Same content, so same hashes
+        m_c4HashCache = TAtomic::c4RelaxedGet(strbSrc.m_c4HashCache);
+        m_c4HashCacheI = TAtomic::c4RelaxedGet(strbSrc.m_c4HashCacheI);
     }
     return *this;
 }
@@ -4559,6 +4601,10 @@ TString::TStrBuf& TString::TStrBuf::operator=(TStrBuf&& strbSrc)
             tCIDLib::Swap(m_c4CurEnd, strbSrc.m_c4CurEnd);
             tCIDLib::Swap(m_pszBuffer, strbSrc.m_pszBuffer);
         }
+
+        // The hashes go with the content
+        tCIDLib::Swap(m_c4HashCache, strbSrc.m_c4HashCache);
+        tCIDLib::Swap(m_c4HashCacheI, strbSrc.m_c4HashCacheI);
     }
     return *this;
 }
@@ -4568,6 +4614,7 @@ TString::TStrBuf& TString::TStrBuf::operator=(const TStringView& strvSrc)
     if (strvSrc.c4Length() > m_c4BufSz)
         ExpandTo(strvSrc.c4Length(), kCIDLib::False);
 
+    ClearHash();
     m_c4CurEnd = strvSrc.c4Length();
     TRawMem::CopyMemBuf(m_pszBuffer, strvSrc.pszBuffer(), m_c4CurEnd * kCIDLib::c4CharBytes);
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
@@ -4588,6 +4635,7 @@ TString::TStrBuf& TString::TStrBuf::operator=(TKrnlString&& kstrSrc)
     }
     m_pszBuffer = kstrSrc.pszOrphanBuffer(m_c4BufSz, m_c4CurEnd);
     m_szSmallBuf[0] = kCIDLib::chNull;
+    ClearHash();
     return *this;
 }
 
@@ -4602,6 +4650,7 @@ TString::TStrBuf& TString::TStrBuf::operator=(TKrnlString&& kstrSrc)
 //
 tCIDLib::TVoid TString::TStrBuf::AdoptBuffer(tCIDLib::TCh* const pszToAdopt, const tCIDLib::TCard4 c4Len)
 {
+    ClearHash();
     if (m_pszBuffer != m_szSmallBuf)
     {
         delete [] m_pszBuffer;
@@ -4639,12 +4688,37 @@ TString::TStrBuf::Append(const  tCIDLib::TCh* const     pszSrc
     if ((m_c4CurEnd + c4Count + c4Extra) > m_c4BufSz)
         ExpandBy(c4Count + c4Extra, kCIDLib::True);
 
+    ClearHash();
     TRawMem::CopyMemBuf(&m_pszBuffer[m_c4CurEnd], pszSrc, c4Count * kCIDLib::c4CharBytes);
     m_c4CurEnd += c4Count;
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
 
 
+//
+//  Return the raw hash of our content, case sensitive or not, calculating and
+//  caching it if we don't already have it. Returns false if the content can't
+//  be hashed, i.e. it's not valid Unicode.
+//
+//  Shared readers can call this at the same time, so the cache is read and
+//  written atomically. See the file comments.
+//
+tCIDLib::TBoolean
+TString::TStrBuf::bRawHash(const tCIDLib::TBoolean bCase, tCIDLib::TCard4& c4ToFill) const noexcept
+{
+    tCIDLib::TCard4& c4Cache = bCase ? m_c4HashCache : m_c4HashCacheI;
+    c4ToFill = TAtomic::c4RelaxedGet(c4Cache);
+    if (c4ToFill)
+        return kCIDLib::True;
+
+    if (!TRawStr::bCalcRawHash(pszBuffer(), c4ToFill, bCase))
+        return kCIDLib::False;
+
+    TAtomic::RelaxedSet(c4Cache, c4ToFill);
+    return kCIDLib::True;
+}
+
+
 tCIDLib::TCh TString::TStrBuf::chAt(const tCIDLib::TCard4 c4Ind) const
 {
     if (c4Ind >= m_c4CurEnd)
@@ -4711,6 +4785,7 @@ TString::TStrBuf::c4CalcBufDiff(const   tCIDLib::TCh* const pszUpper
 
 tCIDLib::TVoid TString::TStrBuf::Clear() noexcept
 {
+    ClearHash();
     m_c4CurEnd = 0;
     m_pszBuffer[0] = kCIDLib::chNull;
 }
@@ -4773,6 +4848,7 @@ tCIDLib::TVoid TString::TStrBuf::DecEnd(const tCIDLib::TCard4 c4DecBy)
         );
     }
 
+    ClearHash();
     m_c4CurEnd -= c4DecBy;
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
@@ -4786,6 +4862,7 @@ tCIDLib::TVoid TString::TStrBuf::DeleteLast() noexcept
         return;
 
     // Just put a null in the last character and dec the length
+    ClearHash();
     m_c4CurEnd--;
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
@@ -4817,7 +4894,10 @@ TString::TStrBuf::ExpandTo(const tCIDLib::TCard4 c4NewSize, const tCIDLib::TBool
 
     // If not preserving, zero current size now to make the below simpler
     if (!bPreserve)
+    {
+        ClearHash();
         m_c4CurEnd = 0;
+    }
 
     if (c4NewSize > m_c4BufSz)
     {
@@ -4858,6 +4938,7 @@ TString::TStrBuf::ExpandTo(const tCIDLib::TCard4 c4NewSize, const tCIDLib::TBool
 tCIDLib::TVoid TString::TStrBuf::IncEnd(const tCIDLib::TCard4 c4IncBy)
 {
     CheckIndex(CID_FILE, CID_LINE, m_c4CurEnd + c4IncBy, kCIDLib::True);
+    ClearHash();
     m_c4CurEnd += c4IncBy;
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
@@ -4869,6 +4950,7 @@ TString::TStrBuf::PutAt(const   tCIDLib::TCard4 c4Index
 {
     // We let them put it at the end
     CheckIndex(CID_FILE, CID_LINE, c4Index, kCIDLib::True);
+    ClearHash();
 
     if (c4Index == m_c4CurEnd)
     {
@@ -4897,6 +4979,7 @@ TString::TStrBuf::PutAt(const   tCIDLib::TCard4 c4Index
 //
 tCIDLib::TVoid TString::TStrBuf::ResetEnd() noexcept
 {
+    ClearHash();
     m_c4CurEnd = TRawStr::c4StrLen(m_pszBuffer);
     CIDAssert(m_c4CurEnd <= m_c4BufSz, L"Null term len > buffer size");
 }
@@ -4907,12 +4990,14 @@ tCIDLib::TVoid TString::TStrBuf::SetEnd(const tCIDLib::TCard4 c4At)
 {
     //  We allow it to be the at the null
     CheckIndex(CID_FILE, CID_LINE, c4At, kCIDLib::True);
+    ClearHash();
     m_c4CurEnd = c4At;
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
 
 tCIDLib::TVoid TString::TStrBuf::SetEnd(const tCIDLib::TCh* const pszAt)
 {
+    ClearHash();
     m_c4CurEnd = c4CalcBufDiff(pszAt);
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
@@ -4920,6 +5005,7 @@ tCIDLib::TVoid TString::TStrBuf::SetEnd(const tCIDLib::TCh* const pszAt)
 // A helper for the string class to add a termination at the current end
 tCIDLib::TVoid TString::TStrBuf::Terminate()
 {
+    ClearHash();
     m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
 }
 
@@ -38,10 +38,31 @@
 //  access the buffer via it. We have to tell it the size of buffer we need. It
 //  will see if it is currently using the small string buffer and allocate and
 //  fault in a buffer if needed (moving any current short string contents over to
-//  it.) It supports move/copy to make life easier for us.
+//  it.) It supports move/copy to make life easier for us. The small buffer holds
+//  up to 15 chars, which covers most keys, names, numbers and such.
+//
+//  Hash Caching.
+//
+//  Strings are very commonly used as keys in hashed collections, and are hashed
+//  over and over, though they rarely change once they are keys. So the buffer
+//  also caches the raw (pre-modulus) hash of the text, in both case sensitive
+//  and insensitive forms, since the modulus is applied afterwards. Since all
+//  changes go through the buffer class, it just drops the cached hashes any
+//  time it's changed, or a writable pointer into it is given out.
 //
 // CAVEATS/GOTCHAS:
 //
+//  1)  A raw hash of zero is not cached (zero means not cached), so the empty
+//      string (and any rare zero hash) just gets hashed every time, which is
+//      not an issue.
+//
+//  2)  The hash is cached from a const method, so it's mutable. Const methods
+//      can be called on more than one thread at once (e.g. by the readers of a
+//      SharedSafe collection), so the cache is only read and written via relaxed
+//      atomic ops, and any thread that stores it stores the same value. No
+//      ordering is needed since the content can't change while it's being read.
+//      Clearing it is only done by changes to the string, which have to be
+//      exclusive anyway.
 //
 // LOG:
 //
@@ -941,6 +962,11 @@ class CIDLIBEXP TString :
             const   tCIDLib::ERadices       eRadix = tCIDLib::ERadices::Auto
         )   const;
 
+        [[nodiscard]] tCIDLib::TCard8 c8CalcHash64
+        (
+            const   tCIDLib::TBoolean       bCase = kCIDLib::True
+        )   const;
+
         tCIDLib::TCard8 c8Val
         (
             const   tCIDLib::ERadices       eRadix = tCIDLib::ERadices::Auto
@@ -1179,6 +1205,11 @@ class CIDLIBEXP TString :
             const   tCIDLib::TCard4         c4Modulus
         )   const;
 
+        [[nodiscard]] tCIDLib::THashVal hshCalcHashI
+        (
+            const   tCIDLib::TCard4         c4Modulus
+        )   const;
+
         [[nodiscard]] tCIDLib::TInt4 i4Val
         (
             const   tCIDLib::ERadices       eRadix = tCIDLib::ERadices::Auto
@@ -1439,7 +1470,7 @@ class CIDLIBEXP TString :
         // -------------------------------------------------------------------
         //  Private class constants
         // -------------------------------------------------------------------
-        static constexpr tCIDLib::TCard4 c4SmallBufSz = 7;
+        static constexpr tCIDLib::TCard4 c4SmallBufSz = 15;
 
 
         // -------------------------------------------------------------------
@@ -1538,6 +1569,12 @@ class CIDLIBEXP TString :
                     return m_c4CurEnd == 0;
                 }
 
+                [[nodiscard]] tCIDLib::TBoolean bRawHash
+                (
+                    const   tCIDLib::TBoolean   bCase
+                    , COP   tCIDLib::TCard4&    c4ToFill
+                )   const noexcept;
+
                 tCIDLib::TCard4 c4BufSz() const noexcept
                 {
                     return m_c4BufSz;
@@ -1552,6 +1589,7 @@ class CIDLIBEXP TString :
                 {
                     // We allow it to be on the current end
                     CheckIndex(CID_FILE, CID_LINE, c4ToSet, kCIDLib::True);
+                    ClearHash();
                     m_c4CurEnd = c4ToSet;
                     return m_c4CurEnd;
                 }
@@ -1622,6 +1660,7 @@ class CIDLIBEXP TString :
 
                 tCIDLib::TCh* pszBuffer(const tCIDLib::TBoolean bNullTerm = kCIDLib::True) noexcept
                 {
+                    ClearHash();
                     if (bNullTerm)
                         m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
                     return m_pszBuffer;
@@ -1643,6 +1682,7 @@ class CIDLIBEXP TString :
                 {
                     // We allow it to be on the current end
                     CheckIndex(CID_FILE, CID_LINE, c4At, kCIDLib::True);
+                    ClearHash();
                     if (bNullTerm)
                         m_pszBuffer[m_c4CurEnd] = kCIDLib::chNull;
                     return &m_pszBuffer[c4At];
@@ -1655,6 +1695,7 @@ class CIDLIBEXP TString :
 
                 tCIDLib::TCh* pszAtEnd() noexcept
                 {
+                    ClearHash();
                     return &m_pszBuffer[m_c4CurEnd];
                 }
 
@@ -1691,12 +1732,27 @@ class CIDLIBEXP TString :
                     , const tCIDLib::TBoolean   bEndOk
                 )   const;
 
+                // Called any time our content changes or might be changed
+                tCIDLib::TVoid ClearHash() noexcept
+                {
+                    m_c4HashCache = 0;
+                    m_c4HashCacheI = 0;
+                }
+
 
                 // -----------------------------------------------------------
                 //  Private data members
+                //
+                //  m_c4HashCache
+                //  m_c4HashCacheI
+                //      The cached raw hash of the content, case sensitive and
+                //      insensitive. Zero means not cached. Const methods access
+                //      them atomically. See the file comments.
                 // -----------------------------------------------------------
                 mutable tCIDLib::TCard4 m_c4BufSz = 0;
                 tCIDLib::TCard4         m_c4CurEnd = 0;
+                mutable tCIDLib::TCard4 m_c4HashCache = 0;
+                mutable tCIDLib::TCard4 m_c4HashCacheI = 0;
                 tCIDLib::TCh            m_szSmallBuf[c4SmallBufSz + 1];
                 mutable tCIDLib::TCh*   m_pszBuffer = nullptr;
         };
@@ -16,7 +16,8 @@
 // DESCRIPTION:
 //
 //  This method implements the stream implementation derivatives that allow
-//  a stream to use a string as a data sink/source.
+//  a stream to use a string as a data sink/source. It also implements the
+//  arena based output impl, which builds the text in arena memory.
 //
 // CAVEATS/GOTCHAS:
 //
@@ -37,6 +38,7 @@
 // ---------------------------------------------------------------------------
 RTTIDecls(TStringInStreamImpl,TInStreamImpl)
 RTTIDecls(TStringOutStreamImpl,TOutStreamImpl)
+RTTIDecls(TArenaOutStreamImpl,TOutStreamImpl)
 
 
 
@@ -335,3 +337,82 @@ TStringOutStreamImpl::c4WriteBytes( const   tCIDLib::TVoid* const pToWrite
     // Return the bytes we actually wrote
     return c4ActualChars * kCIDLib::c4CharBytes;
 }
+
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArenaOutStreamImpl
+//  PREFIX: strmi
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TArenaOutStreamImpl: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TArenaOutStreamImpl::TArenaOutStreamImpl(       TArena* const   parenaBuf
+                                        , const tCIDLib::TCard4 c4InitChars) :
+    m_c4BufChars(c4InitChars ? c4InitChars : 64)
+    , m_c4CurEnd(0)
+    , m_parenaBuf(parenaBuf)
+    , m_pszBuf(nullptr)
+{
+    m_pszBuf = m_parenaBuf->ptAllocArray<tCIDLib::TCh>(m_c4BufChars + 1);
+    m_pszBuf[0] = kCIDLib::chNull;
+}
+
+TArenaOutStreamImpl::~TArenaOutStreamImpl()
+{
+    // The buffer belongs to the arena, so nothing to do
+}
+
+
+// ---------------------------------------------------------------------------
+//  TArenaOutStreamImpl: Public, inherited methods
+// ---------------------------------------------------------------------------
+tCIDLib::TCard4
+TArenaOutStreamImpl::c4WriteBytes(  const   tCIDLib::TVoid* const pToWrite
+                                    , const tCIDLib::TCard4       c4BytesToWrite)
+{
+    // Same as the string impl, it has to be whole chars
+    if (c4BytesToWrite % kCIDLib::c4CharBytes)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcStrm_OddByteCount
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::CantDo
+            , TCardinal(c4BytesToWrite)
+        );
+    }
+
+    const tCIDLib::TCard4 c4ActualChars = tCIDLib::MinVal
+    (
+        ((kCIDLib::c4MaxCard - m_c4CurEnd) / kCIDLib::c4CharBytes) - 1
+        , c4BytesToWrite / kCIDLib::c4CharBytes
+    );
+
+    //
+    //  If we need more room, get a new buffer 25 percent bigger than we need,
+    //  copy over what we have, and just abandon the old one.
+    //
+    if (m_c4CurEnd + c4ActualChars > m_c4BufChars)
+    {
+        const tCIDLib::TCard4 c4New = tCIDLib::TCard4
+        (
+            (m_c4BufChars + c4ActualChars) * 1.25
+        );
+
+        tCIDLib::TCh* pszNew = m_parenaBuf->ptAllocArray<tCIDLib::TCh>(c4New + 1);
+        TRawMem::CopyMemBuf(pszNew, m_pszBuf, m_c4CurEnd * kCIDLib::c4CharBytes);
+        m_pszBuf = pszNew;
+        m_c4BufChars = c4New;
+    }
+
+    TRawMem::CopyMemBuf(m_pszBuf + m_c4CurEnd, pToWrite, c4ActualChars * kCIDLib::c4CharBytes);
+    m_c4CurEnd += c4ActualChars;
+    m_pszBuf[m_c4CurEnd] = kCIDLib::chNull;
+
+    return c4ActualChars * kCIDLib::c4CharBytes;
+}
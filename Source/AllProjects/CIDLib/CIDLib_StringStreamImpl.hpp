@@ -18,6 +18,11 @@
 //  This is the header for the CIDLib_StringStreamImpl.Cpp file, which
 //  implements a stream implementation classes.
 //
+//  TArenaOutStreamImpl is a variation of the string output impl that builds
+//  its text in a buffer allocated from an arena, for request scoped work. It
+//  isn't backed by a TString, so it can't be synced to an input stream. The
+//  caller gets the text as a null terminated raw string.
+//
 // CAVEATS/GOTCHAS:
 //
 //  1)  This is a wierd one in some ways. Strings are ONLY Unicode format,
@@ -42,6 +47,10 @@
 //      streams that use stream impl objects is in terms of bytes, so we have
 //      to convert for any reporting of positions to the outside world.
 //
+//  3)  When an arena impl grows, its old buffer is just abandoned in the arena.
+//      The arena must outlive the impl, and must not be reset or rolled back
+//      to a mark taken before the impl was created while it is in use.
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -362,4 +371,116 @@ class CIDLIBEXP TStringOutStreamImpl : public TOutStreamImpl
         RTTIDefs(TStringOutStreamImpl,TOutStreamImpl)
 };
 
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TArenaOutStreamImpl
+//  PREFIX: strmi
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TArenaOutStreamImpl : public TOutStreamImpl
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TArenaOutStreamImpl() = delete;
+
+        TArenaOutStreamImpl
+        (
+                    TArena* const           parenaBuf
+            , const tCIDLib::TCard4         c4InitChars
+        );
+
+        TArenaOutStreamImpl(const TArenaOutStreamImpl&) = delete;
+        TArenaOutStreamImpl(TArenaOutStreamImpl&&) = delete;
+
+        ~TArenaOutStreamImpl();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TArenaOutStreamImpl& operator=(const TArenaOutStreamImpl&) = delete;
+        TArenaOutStreamImpl& operator=(TArenaOutStreamImpl&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsOpen() const final
+        {
+            // Always true for this type
+            return kCIDLib::True;
+        }
+
+        tCIDLib::TCard4 c4WriteBytes
+        (
+            const   tCIDLib::TVoid* const   pBuffer
+            , const tCIDLib::TCard4         c4BytesToWrite
+        )   final;
+
+        tCIDLib::TCard8 c8CurPos() const final
+        {
+            // Convert our character index into a byte count
+            return m_c4CurEnd * kCIDLib::c4CharBytes;
+        }
+
+        tCIDLib::TVoid Reset() final
+        {
+            // Keep the buffer we have, it's as big as it needed to be
+            m_c4CurEnd = 0;
+            m_pszBuf[0] = kCIDLib::chNull;
+        }
+
+        tCIDLib::TVoid SeekToEnd() final
+        {
+            // We only ever append, so we are always at the end
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4Length() const
+        {
+            return m_c4CurEnd;
+        }
+
+        const tCIDLib::TCh* pszText() const
+        {
+            return m_pszBuf;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4BufChars
+        //      The chars that m_pszBuf can hold, not counting the null, which
+        //      we always leave room for.
+        //
+        //  m_c4CurEnd
+        //      The number of chars written so far, which is also where the
+        //      null terminator is.
+        //
+        //  m_parenaBuf
+        //      The arena we allocate our buffer from. We don't own it.
+        //
+        //  m_pszBuf
+        //      The current buffer, always kept null terminated. Old buffers
+        //      are abandoned in the arena when we grow.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 m_c4BufChars;
+        tCIDLib::TCard4 m_c4CurEnd;
+        TArena*         m_parenaBuf;
+        tCIDLib::TCh*   m_pszBuf;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TArenaOutStreamImpl,TOutStreamImpl)
+};
+
 #pragma CIDLIB_POPPACK
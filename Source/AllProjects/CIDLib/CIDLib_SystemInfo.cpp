@@ -475,6 +475,14 @@ tCIDLib::TCard4 TSysInfo::c4CmdLineParmCount()
 }
 
 
+// Return whether the CPU supports all of the indicated instruction set extensions
+tCIDLib::TBoolean
+TSysInfo::bCPUHasFeatures(const tCIDLib::ECPUFeatures eToCheck)
+{
+    return TKrnlSysInfo::bCPUHasFeatures(eToCheck);
+}
+
+
 // Return the count of CPUs in this host
 tCIDLib::TCard4 TSysInfo::c4CPUCount()
 {
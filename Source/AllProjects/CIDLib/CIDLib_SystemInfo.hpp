@@ -297,6 +297,11 @@ class CIDLIBEXP TSysInfo
             , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
         );
 
+        static tCIDLib::TBoolean bCPUHasFeatures
+        (
+            const   tCIDLib::ECPUFeatures   eToCheck
+        );
+
         static tCIDLib::TBoolean bIsHostAdmin();
 
         static tCIDLib::TBoolean bInstallMode();
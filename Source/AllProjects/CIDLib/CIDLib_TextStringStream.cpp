@@ -22,6 +22,9 @@
 //  easily do the same stuff, but these just make it more convient and more
 //  self documenting.
 //
+//  It also implements TTextArenaOutStream, which is the same thing but over
+//  an arena based impl.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -41,6 +44,7 @@
 // ---------------------------------------------------------------------------
 RTTIDecls(TTextStringInStream,TTextInStream)
 RTTIDecls(TTextStringOutStream,TTextOutStream)
+RTTIDecls(TTextArenaOutStream,TTextOutStream)
 
 
 
@@ -265,3 +269,57 @@ const TString& TTextStringOutStream::strData() const
 }
 
 
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TTextArenaOutStream
+//  PREFIX: strm
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTextArenaOutStream: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TTextArenaOutStream::TTextArenaOutStream(       TArena* const   parenaBuf
+                                        , const tCIDLib::TCard4 c4InitChars) :
+
+    TTextOutStream(new TNativeWCConverter)
+    , m_pstrmiOut(nullptr)
+{
+    // We want the newline format to be just LF, same as the string streams
+    eNewLineType(tCIDLib::ENewLineTypes::LF);
+
+    m_pstrmiOut = new TArenaOutStreamImpl(parenaBuf, c4InitChars);
+    AdoptStream(new TBinOutStream(m_pstrmiOut));
+}
+
+TTextArenaOutStream::TTextArenaOutStream(       TArena* const   parenaBuf
+                                        , const TStreamFmt&     strmfToUse
+                                        , const tCIDLib::TCard4 c4InitChars) :
+
+    TTextOutStream(strmfToUse, new TNativeWCConverter)
+    , m_pstrmiOut(nullptr)
+{
+    eNewLineType(tCIDLib::ENewLineTypes::LF);
+
+    m_pstrmiOut = new TArenaOutStreamImpl(parenaBuf, c4InitChars);
+    AdoptStream(new TBinOutStream(m_pstrmiOut));
+}
+
+TTextArenaOutStream::~TTextArenaOutStream()
+{
+    // Our parent cleans up the binary stream, which owns the impl
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTextArenaOutStream: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TCard4 TTextArenaOutStream::c4Length() const
+{
+    return m_pstrmiOut->c4Length();
+}
+
+const tCIDLib::TCh* TTextArenaOutStream::pszText() const
+{
+    return m_pstrmiOut->pszText();
+}
@@ -25,6 +25,10 @@
 //  which makes it safe and convenient to have done. Since string streams are
 //  very common, this provides a good payback.
 //
+//  TTextArenaOutStream is the same idea, but the text is built in memory from
+//  an arena, for request scoped formatting. The result is a raw string in the
+//  arena, which goes away with everything else when the arena is reset.
+//
 // CAVEATS/GOTCHAS:
 //
 //  1)  These classes do now allow you to provide a text converter. Instead,
@@ -32,6 +36,10 @@
 //      the text through in native 'in memory' wide character format. This
 //      insures that the data streamed out is valid string data.
 //
+//  2)  The arena given to a TTextArenaOutStream must outlive it, and must not
+//      be reset or rolled back past when the stream was created while it's in
+//      use. Like the string streams, flush before looking at the text.
+//
 // LOG:
 //
 //  $_CIDLib_Log_$
@@ -212,6 +220,71 @@ class CIDLIBEXP TTextStringOutStream : public TTextOutStream
 };
 
 
+
+// ---------------------------------------------------------------------------
+//   CLASS: TTextArenaOutStream
+//  PREFIX: strm
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TTextArenaOutStream : public TTextOutStream
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TTextArenaOutStream() = delete;
+
+        explicit TTextArenaOutStream
+        (
+                    TArena* const           parenaBuf
+            , const tCIDLib::TCard4         c4InitChars = 64
+        );
+
+        TTextArenaOutStream
+        (
+                    TArena* const           parenaBuf
+            , const TStreamFmt&             strmfToUse
+            , const tCIDLib::TCard4         c4InitChars = 64
+        );
+
+        TTextArenaOutStream(const TTextArenaOutStream&) = delete;
+        TTextArenaOutStream(TTextArenaOutStream&&) = delete;
+
+        ~TTextArenaOutStream();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TTextArenaOutStream& operator=(const TTextArenaOutStream&) = delete;
+        TTextArenaOutStream& operator=(TTextArenaOutStream&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4Length() const;
+
+        const tCIDLib::TCh* pszText() const;
+
+
+    private     :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_pstrmiOut
+        //      A pointer to our impl object, so we can get to the text. The
+        //      binary stream under us owns it.
+        // -------------------------------------------------------------------
+        TArenaOutStreamImpl*    m_pstrmiOut;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTextArenaOutStream,TTextOutStream)
+};
+
+
 #pragma CIDLIB_POPPACK
 
 
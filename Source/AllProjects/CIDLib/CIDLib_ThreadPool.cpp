@@ -0,0 +1,1044 @@
+//
+// FILE NAME: CIDLib_ThreadPool.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TThreadPool and TThreadPoolTask classes.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The stats cache takes a lock on every update, so we don't want to hit it
+//      for every task. Each worker accumulates its numbers and flushes them
+//      every so many tasks, or when it goes idle.
+//
+//  2)  The queued counts are bumped before a task is put into a queue, and
+//      dropped after it's taken out, so they can never go below zero. It means
+//      a worker can see a non-zero count while the task is not quite in the
+//      queue yet, but that just means it goes around one more time.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDLib_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Do our RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TThreadPoolTask,TObject)
+RTTIDecls(TThreadPool,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDLib_ThreadPool
+    {
+        // -----------------------------------------------------------------------
+        //  c4HelpWaitMSs
+        //      When a worker waits on a task and there's nothing else to run, how
+        //      long it blocks on the task before looking for work again.
+        //
+        //  c4IdleWaitMSs
+        //      How long an idle worker blocks before checking for a shutdown
+        //      request again, in case it misses being woken up.
+        //
+        //  c4MaxWorkers
+        //      A sanity limit on the worker count.
+        //
+        //  c4StatsFlushCnt
+        //      How many tasks a worker runs before it flushes its stats.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4HelpWaitMSs   = 2;
+        constexpr tCIDLib::TCard4   c4IdleWaitMSs   = 250;
+        constexpr tCIDLib::TCard4   c4MaxWorkers    = 256;
+        constexpr tCIDLib::TCard4   c4StatsFlushCnt = 64;
+
+
+        // -----------------------------------------------------------------------
+        //  The process wide stats. The queued count is across all pools, and
+        //  is updated atomically. The totals are only updated during flushes,
+        //  which are done under the stats lock.
+        // -----------------------------------------------------------------------
+        TAtomicFlag         atomStatsInit;
+        tCIDLib::TCard4     c4QueuedTotal = 0;
+        tCIDLib::TCard8     c8StealsTotal = 0;
+        tCIDLib::TCard8     c8TasksTotal = 0;
+        TStatsCacheItem     sciAvgLatency;
+        TStatsCacheItem     sciMaxLatency;
+        TStatsCacheItem     sciQueueDepth;
+        TStatsCacheItem     sciSteals;
+        TStatsCacheItem     sciTasksRun;
+
+        TCriticalSection* pcrsStats()
+        {
+            static TCriticalSection crsStats;
+            return &crsStats;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The shared pool. It's faulted in upon first use.
+        // -----------------------------------------------------------------------
+        TAtomicFlag         atomSharedInit;
+        TThreadPool*        ptpoolShared = nullptr;
+
+        TCriticalSection* pcrsShared()
+        {
+            static TCriticalSection crsShared;
+            return &crsShared;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  Local helpers
+// ---------------------------------------------------------------------------
+static tCIDLib::TBoolean bIsFinalState(const tCIDLib::ETaskStates eToCheck)
+{
+    return (eToCheck == tCIDLib::ETaskStates::Complete)
+        || (eToCheck == tCIDLib::ETaskStates::Failed)
+        || (eToCheck == tCIDLib::ETaskStates::Cancelled);
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPool::TWorker
+//  PREFIX: work
+//
+//  The per-worker data. The local queues are protected by the crit sec, since
+//  other workers steal from them. The stats and victim index are only touched
+//  by the worker itself.
+// ---------------------------------------------------------------------------
+struct TThreadPool::TWorker
+{
+    TWorker(const tCIDLib::TCard4 c4Index) :
+
+        m_c4Index(c4Index)
+        , m_c4NextVictim(0)
+        , m_c4StatSteals(0)
+        , m_c4StatTasks(0)
+        , m_c8StatLatency(0)
+        , m_c8StatMaxLatency(0)
+        , m_pthrWorker(nullptr)
+        , m_tidWorker(kCIDLib::tidInvalid)
+    {
+    }
+
+    TWorker(const TWorker&) = delete;
+    TWorker(TWorker&&) = delete;
+
+    ~TWorker()
+    {
+        delete m_pthrWorker;
+    }
+
+    TWorker& operator=(const TWorker&) = delete;
+    TWorker& operator=(TWorker&&) = delete;
+
+    tCIDLib::TCard4     m_c4Index;
+    tCIDLib::TCard4     m_c4NextVictim;
+    tCIDLib::TCard4     m_c4StatSteals;
+    tCIDLib::TCard4     m_c4StatTasks;
+    tCIDLib::TCard8     m_c8StatLatency;
+    tCIDLib::TCard8     m_c8StatMaxLatency;
+    TDeque<TTaskPtr>    m_colLocal[tCIDLib::c4EnumOrd(tCIDLib::ETaskPrios::Count)];
+    TCriticalSection    m_crsLocal;
+    TThread*            m_pthrWorker;
+    tCIDLib::TThreadId  m_tidWorker;
+};
+
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPoolTask
+//  PREFIX: task
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TThreadPoolTask: Destructor
+// ---------------------------------------------------------------------------
+TThreadPoolTask::~TThreadPoolTask()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPoolTask: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Anyone can check this, it just checks the flag
+tCIDLib::TBoolean TThreadPoolTask::bCancelRequested() const
+{
+    return m_atomCancel;
+}
+
+
+//
+//  This is only for the task itself to call while it's running. It also checks
+//  for a shutdown request on the worker thread, which is how pool shutdown gets
+//  running tasks to give up.
+//
+tCIDLib::TBoolean TThreadPoolTask::bCheckCancel()
+{
+    if (!m_bSawCancel)
+    {
+        if (m_atomCancel)
+            m_bSawCancel = kCIDLib::True;
+        else if (m_pthrRunning && m_pthrRunning->bCheckShutdownRequest())
+            m_bSawCancel = kCIDLib::True;
+    }
+    return m_bSawCancel;
+}
+
+
+tCIDLib::TBoolean TThreadPoolTask::bIsDone() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    return bIsFinalState(m_eState);
+}
+
+
+tCIDLib::TBoolean TThreadPoolTask::bWaitDone(const tCIDLib::TCard4 c4WaitMSs)
+{
+    TThreadPool* ptpoolOwner = nullptr;
+    {
+        TCritSecLocker crslSync(&m_crsSync);
+        if (bIsFinalState(m_eState))
+            return kCIDLib::True;
+        ptpoolOwner = m_ptpoolOwner;
+    }
+
+    //
+    //  If one of our pool's workers is waiting on us, it can't just block, since
+    //  enough of those could tie up all of the workers and we'd never get run.
+    //  So it runs other tasks while it waits.
+    //
+    if (ptpoolOwner && ptpoolOwner->bIsWorkerThread())
+        return ptpoolOwner->bHelpUntilDone(*this, c4WaitMSs);
+
+    return m_evDone.bWaitFor(c4WaitMSs);
+}
+
+
+tCIDLib::ETaskPrios TThreadPoolTask::ePriority() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    return m_ePrio;
+}
+
+
+tCIDLib::ETaskStates TThreadPoolTask::eState() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    return m_eState;
+}
+
+
+// Only meaningful if the state is failed
+TError TThreadPoolTask::errFailure() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    return m_errFailure;
+}
+
+
+tCIDLib::TVoid TThreadPoolTask::RequestCancel()
+{
+    m_atomCancel.Set();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPoolTask: Hidden constructors
+// ---------------------------------------------------------------------------
+TThreadPoolTask::TThreadPoolTask() :
+
+    m_bSawCancel(kCIDLib::False)
+    , m_c8QueuedAt(0)
+    , m_ePrio(tCIDLib::ETaskPrios::Normal)
+    , m_eState(tCIDLib::ETaskStates::Idle)
+    , m_evDone(tCIDLib::EEventStates::Reset)
+    , m_pthrRunning(nullptr)
+    , m_ptpoolOwner(nullptr)
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPoolTask: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The pool calls this when we are submitted. If we've already been submitted,
+//  we return false.
+//
+tCIDLib::TBoolean
+TThreadPoolTask::bMarkQueued(       TThreadPool* const      ptpoolOwner
+                            , const tCIDLib::ETaskPrios     ePrio
+                            , const tCIDLib::ETaskStates    eNewState)
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    if (m_eState != tCIDLib::ETaskStates::Idle)
+        return kCIDLib::False;
+
+    m_ePrio = ePrio;
+    m_eState = eNewState;
+    m_ptpoolOwner = ptpoolOwner;
+    return kCIDLib::True;
+}
+
+
+//
+//  Put us into a final state, wake up any waiters, and pass on any continuations
+//  to their pools. We don't hold the lock while queuing them up.
+//
+tCIDLib::TVoid
+TThreadPoolTask::Complete(  const   tCIDLib::ETaskStates    eFinalState
+                            , const TError* const           perrFailure)
+{
+    TVector<TCntPtr<TThreadPoolTask>> colConts;
+    {
+        TCritSecLocker crslSync(&m_crsSync);
+        m_eState = eFinalState;
+        if (perrFailure)
+            m_errFailure = *perrFailure;
+
+        if (!m_colConts.bIsEmpty())
+        {
+            colConts = tCIDLib::ForceMove(m_colConts);
+            m_colConts.RemoveAll();
+        }
+        m_evDone.Trigger();
+    }
+
+    const tCIDLib::TCard4 c4Count = colConts.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TCntPtr<TThreadPoolTask>& cptrCur = colConts[c4Index];
+        cptrCur->m_ptpoolOwner->Enqueue(cptrCur);
+    }
+}
+
+
+//
+//  The pool calls this to run us on a worker thread. We catch any exceptions
+//  and store them away for the waiting code to look at.
+//
+tCIDLib::TVoid TThreadPoolTask::Run(TThread& thrThis)
+{
+    // If cancelled before we ever got going, then we are done
+    if (m_atomCancel)
+    {
+        Complete(tCIDLib::ETaskStates::Cancelled, nullptr);
+        return;
+    }
+
+    {
+        TCritSecLocker crslSync(&m_crsSync);
+        m_eState = tCIDLib::ETaskStates::Running;
+    }
+
+    m_pthrRunning = &thrThis;
+    try
+    {
+        RunTask();
+    }
+
+    catch(TError& errToCatch)
+    {
+        m_pthrRunning = nullptr;
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        Complete(tCIDLib::ETaskStates::Failed, &errToCatch);
+        return;
+    }
+
+    catch(...)
+    {
+        m_pthrRunning = nullptr;
+        TError errUnknown
+        (
+            facCIDLib().strName()
+            , CID_FILE
+            , CID_LINE
+            , facCIDLib().strMsg(kCIDErrs::errcTPool_UnknownExcept)
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Unknown
+        );
+        Complete(tCIDLib::ETaskStates::Failed, &errUnknown);
+        return;
+    }
+
+    m_pthrRunning = nullptr;
+    Complete
+    (
+        m_bSawCancel ? tCIDLib::ETaskStates::Cancelled : tCIDLib::ETaskStates::Complete
+        , nullptr
+    );
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPool
+//  PREFIX: tpool
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TThreadPool: Public, static methods
+// ---------------------------------------------------------------------------
+TThreadPool& TThreadPool::tpoolShared()
+{
+    if (!CIDLib_ThreadPool::atomSharedInit)
+    {
+        TCritSecLocker crslInit(CIDLib_ThreadPool::pcrsShared());
+        if (!CIDLib_ThreadPool::atomSharedInit)
+        {
+            CIDLib_ThreadPool::ptpoolShared = new TThreadPool();
+            CIDLib_ThreadPool::atomSharedInit.Set();
+        }
+    }
+    return *CIDLib_ThreadPool::ptpoolShared;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPool: Constructors and Destructor
+// ---------------------------------------------------------------------------
+
+// This is used for the shared pool
+TThreadPool::TThreadPool() :
+
+    m_apworkList(nullptr)
+    , m_c4WorkerCount(0)
+    , m_strName(L"CIDPool")
+{
+    StartWorkers(0);
+}
+
+TThreadPool::TThreadPool(const TString& strName, const tCIDLib::TCard4 c4Workers) :
+
+    m_apworkList(nullptr)
+    , m_c4WorkerCount(0)
+    , m_strName(strName)
+{
+    StartWorkers(c4Workers);
+}
+
+TThreadPool::~TThreadPool()
+{
+    try
+    {
+        Shutdown();
+    }
+
+    catch(TError& errToCatch)
+    {
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        TModule::LogEventObj(errToCatch);
+    }
+
+    catch(...)
+    {
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4WorkerCount; c4Index++)
+        delete m_apworkList[c4Index];
+    delete [] m_apworkList;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPool: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TThreadPool::bIsWorkerThread() const
+{
+    return (pworkCaller() != nullptr);
+}
+
+
+tCIDLib::TCard4 TThreadPool::c4QueuedCount() const
+{
+    return m_scntQueued.c4Value();
+}
+
+
+tCIDLib::TCard4 TThreadPool::c4WorkerCount() const
+{
+    return m_c4WorkerCount;
+}
+
+
+const TString& TThreadPool::strName() const
+{
+    return m_strName;
+}
+
+
+//
+//  Stop the workers. Any running tasks will see a cancel via bCheckCancel().
+//  Any tasks still queued after the workers are gone are marked cancelled, so
+//  that anyone waiting on them will wake up.
+//
+tCIDLib::TVoid TThreadPool::Shutdown()
+{
+    // Set the shutdown flag under the lock, so no more shared queuing can happen
+    {
+        TCritSecLocker crslShared(&m_crsShared);
+        if (m_atomShutdown)
+            return;
+        m_atomShutdown.Set();
+    }
+
+    // Make one pass to ask them to stop, then wake up any that are idle
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4WorkerCount; c4Index++)
+        m_apworkList[c4Index]->m_pthrWorker->ReqShutdownNoSync();
+    {
+        TLocker lockIdle(&m_mtxIdle);
+        m_twlIdle.bReleaseAll(kCIDLib::c4TWLReason_All);
+    }
+
+    // And now wait for them to die
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4WorkerCount; c4Index++)
+    {
+        try
+        {
+            m_apworkList[c4Index]->m_pthrWorker->eWaitForDeath(10000);
+        }
+
+        catch(TError& errToCatch)
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+
+        catch(...)
+        {
+        }
+    }
+
+    //
+    //  Cancel anything left. Cancelling can queue continuations, but we are
+    //  shut down so Enqueue() will just cancel them as well.
+    //
+    TTaskPtr cptrCur;
+    for (tCIDLib::ETaskPrios ePrio = tCIDLib::ETaskPrios::Min;
+                                    ePrio <= tCIDLib::ETaskPrios::Max; ePrio++)
+    {
+        const tCIDLib::TCard4 c4Lane = tCIDLib::c4EnumOrd(ePrio);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4WorkerCount; c4Index++)
+        {
+            TWorker& workCur = *m_apworkList[c4Index];
+            while (workCur.m_colLocal[c4Lane].bPopTop(cptrCur))
+            {
+                m_scntQueued--;
+                TAtomic::c4SafeRelease(CIDLib_ThreadPool::c4QueuedTotal);
+                cptrCur->Complete(tCIDLib::ETaskStates::Cancelled, nullptr);
+            }
+        }
+
+        while (kCIDLib::True)
+        {
+            {
+                TCritSecLocker crslShared(&m_crsShared);
+                if (!m_colShared[c4Lane].bPopTop(cptrCur))
+                    break;
+            }
+            m_scntQueued--;
+            TAtomic::c4SafeRelease(CIDLib_ThreadPool::c4QueuedTotal);
+            cptrCur->Complete(tCIDLib::ETaskStates::Cancelled, nullptr);
+        }
+    }
+}
+
+
+tCIDLib::TVoid
+TThreadPool::Submit(const TTaskPtr& cptrToRun, const tCIDLib::ETaskPrios ePrio)
+{
+    CIDAssert(cptrToRun.pobjData() != nullptr, L"The thread pool task cannot be null");
+
+    if (m_atomShutdown)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcTPool_ShuttingDown
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::NotReady
+            , m_strName
+        );
+    }
+
+    // We need a non-const handle to update the task
+    TTaskPtr cptrRun(cptrToRun);
+    if (!cptrRun->bMarkQueued(this, ePrio, tCIDLib::ETaskStates::Queued))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcTPool_NotIdle
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Already
+        );
+    }
+    Enqueue(cptrRun);
+}
+
+
+//
+//  Queue up a task to run after another one completes. If the antecedent is
+//  already done, we queue it up now.
+//
+tCIDLib::TVoid
+TThreadPool::SubmitAfter(const  TTaskPtr&               cptrAnte
+                        , const TTaskPtr&               cptrToRun
+                        , const tCIDLib::ETaskPrios     ePrio)
+{
+    CIDAssert(cptrAnte.pobjData() != nullptr, L"The antecedent task cannot be null");
+    CIDAssert(cptrToRun.pobjData() != nullptr, L"The thread pool task cannot be null");
+
+    if (m_atomShutdown)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcTPool_ShuttingDown
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::NotReady
+            , m_strName
+        );
+    }
+
+    TTaskPtr cptrRun(cptrToRun);
+    if (!cptrRun->bMarkQueued(this, ePrio, tCIDLib::ETaskStates::Waiting))
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcTPool_NotIdle
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Already
+        );
+    }
+
+    {
+        TTaskPtr cptrWaitOn(cptrAnte);
+        TCritSecLocker crslAnte(&cptrWaitOn->m_crsSync);
+        if (!bIsFinalState(cptrWaitOn->m_eState))
+        {
+            cptrWaitOn->m_colConts.objAdd(cptrRun);
+            return;
+        }
+    }
+    Enqueue(cptrRun);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TThreadPool: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Look for a task for the passed worker to run. At each priority we check our
+//  own queue (newest first), then the shared queue, then try to steal from the
+//  other workers (oldest first.)
+//
+tCIDLib::TBoolean TThreadPool::bFindTask(TWorker& workSrc, TTaskPtr& cptrToFill)
+{
+    // If nothing is queued anywhere, don't bother locking everything
+    if (!m_scntQueued.c4Value())
+        return kCIDLib::False;
+
+    for (tCIDLib::ETaskPrios ePrio = tCIDLib::ETaskPrios::Min;
+                                    ePrio <= tCIDLib::ETaskPrios::Max; ePrio++)
+    {
+        const tCIDLib::TCard4 c4Lane = tCIDLib::c4EnumOrd(ePrio);
+        {
+            TCritSecLocker crslLocal(&workSrc.m_crsLocal);
+            if (workSrc.m_colLocal[c4Lane].bPopBottom(cptrToFill))
+                return kCIDLib::True;
+        }
+
+        {
+            TCritSecLocker crslShared(&m_crsShared);
+            if (m_colShared[c4Lane].bPopTop(cptrToFill))
+                return kCIDLib::True;
+        }
+
+        //
+        //  Rotate the starting point so that we don't all gang up on the same
+        //  worker.
+        //
+        for (tCIDLib::TCard4 c4Ofs = 1; c4Ofs < m_c4WorkerCount; c4Ofs++)
+        {
+            const tCIDLib::TCard4 c4At
+            (
+                (workSrc.m_c4Index + workSrc.m_c4NextVictim + c4Ofs) % m_c4WorkerCount
+            );
+            if (c4At == workSrc.m_c4Index)
+                continue;
+
+            TWorker& workVictim = *m_apworkList[c4At];
+            TCritSecLocker crslVictim(&workVictim.m_crsLocal);
+            if (workVictim.m_colLocal[c4Lane].bPopTop(cptrToFill))
+            {
+                workSrc.m_c4NextVictim++;
+                workSrc.m_c4StatSteals++;
+                return kCIDLib::True;
+            }
+        }
+    }
+    return kCIDLib::False;
+}
+
+
+//
+//  A worker is waiting on a task. We run other tasks until it is done or the
+//  wait time is used up. If nothing is available, we block briefly on the task
+//  and then check again.
+//
+tCIDLib::TBoolean
+TThreadPool::bHelpUntilDone(TThreadPoolTask& taskWait, const tCIDLib::TCard4 c4WaitMSs)
+{
+    TWorker* pworkMe = pworkCaller();
+    CIDAssert(pworkMe != nullptr, L"Only pool workers can help out while waiting");
+
+    const tCIDLib::TCard8 c8End
+    (
+        (c4WaitMSs == kCIDLib::c4MaxWait) ? kCIDLib::c8MaxCard
+                                          : TTime::c8Millis() + c4WaitMSs
+    );
+
+    while (!taskWait.bIsDone())
+    {
+        if (bRunOne(*pworkMe, *pworkMe->m_pthrWorker))
+            continue;
+
+        const tCIDLib::TCard8 c8Now = TTime::c8Millis();
+        if (c8Now >= c8End)
+            return kCIDLib::False;
+
+        const tCIDLib::TCard4 c4Wait = tCIDLib::TCard4
+        (
+            tCIDLib::MinVal(c8End - c8Now, tCIDLib::TCard8(CIDLib_ThreadPool::c4HelpWaitMSs))
+        );
+        if (taskWait.m_evDone.bWaitFor(c4Wait))
+            break;
+    }
+    return kCIDLib::True;
+}
+
+
+// Find a task and run it, updating the worker's stats
+tCIDLib::TBoolean TThreadPool::bRunOne(TWorker& workSrc, TThread& thrThis)
+{
+    TTaskPtr cptrRun;
+    if (!bFindTask(workSrc, cptrRun))
+        return kCIDLib::False;
+
+    m_scntQueued--;
+    TAtomic::c4SafeRelease(CIDLib_ThreadPool::c4QueuedTotal);
+
+    const tCIDLib::TCard8 c8Now = TTime::c8HPTimerUS();
+    const tCIDLib::TCard8 c8Latency
+    (
+        (c8Now > cptrRun->m_c8QueuedAt) ? c8Now - cptrRun->m_c8QueuedAt : 0
+    );
+    workSrc.m_c4StatTasks++;
+    workSrc.m_c8StatLatency += c8Latency;
+    if (c8Latency > workSrc.m_c8StatMaxLatency)
+        workSrc.m_c8StatMaxLatency = c8Latency;
+
+    cptrRun->Run(thrThis);
+    return kCIDLib::True;
+}
+
+
+tCIDLib::EExitCodes TThreadPool::eWorkerThread(TThread& thrThis, tCIDLib::TVoid* pData)
+{
+    TWorker& workMe = *static_cast<TWorker*>(pData);
+    workMe.m_tidWorker = TThread::tidCaller();
+
+    // Let the calling thread go
+    thrThis.Sync();
+
+    while (!thrThis.bCheckShutdownRequest())
+    {
+        try
+        {
+            if (bRunOne(workMe, thrThis))
+            {
+                if (workMe.m_c4StatTasks >= CIDLib_ThreadPool::c4StatsFlushCnt)
+                    FlushStats(workMe);
+                continue;
+            }
+
+            //
+            //  Nothing to do, so flush stats and block. We mark ourself idle
+            //  before checking the queued count, and queuing code bumps the
+            //  count before checking the idle count, so one or the other will
+            //  always see it.
+            //
+            FlushStats(workMe);
+
+            TLocker lockIdle(&m_mtxIdle);
+            m_scntIdle++;
+            try
+            {
+                if (!m_scntQueued.c4Value() && !m_atomShutdown)
+                {
+                    m_twlIdle.bWaitOnList
+                    (
+                        lockIdle
+                        , kCIDLib::c4TWLReason_WaitData
+                        , CIDLib_ThreadPool::c4IdleWaitMSs
+                    );
+                }
+            }
+
+            catch(...)
+            {
+                m_scntIdle--;
+                throw;
+            }
+            m_scntIdle--;
+        }
+
+        catch(TError& errToCatch)
+        {
+            if (facCIDLib().bTestLog(errToCatch, tCIDLib::ELogFlags::Threads))
+            {
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                TModule::LogEventObj(errToCatch);
+            }
+        }
+    }
+
+    FlushStats(workMe);
+    return tCIDLib::EExitCodes::Normal;
+}
+
+
+//
+//  Put a task that is ready to go onto the appropriate queue and wake up a
+//  worker if any are idle. If called from one of our workers, it goes on that
+//  worker's own queue. If we are shut down, it's just cancelled.
+//
+tCIDLib::TVoid TThreadPool::Enqueue(const TTaskPtr& cptrToRun)
+{
+    TTaskPtr cptrRun(cptrToRun);
+    {
+        TCritSecLocker crslSync(&cptrRun->m_crsSync);
+        cptrRun->m_eState = tCIDLib::ETaskStates::Queued;
+        cptrRun->m_c8QueuedAt = TTime::c8HPTimerUS();
+    }
+    const tCIDLib::TCard4 c4Lane = tCIDLib::c4EnumOrd(cptrRun->m_ePrio);
+
+    m_scntQueued++;
+    TAtomic::c4SafeAcquire(CIDLib_ThreadPool::c4QueuedTotal);
+
+    TWorker* pworkMe = pworkCaller();
+    if (pworkMe)
+    {
+        TCritSecLocker crslLocal(&pworkMe->m_crsLocal);
+        pworkMe->m_colLocal[c4Lane].objPushBottom(cptrRun);
+    }
+     else
+    {
+        tCIDLib::TBoolean bQueued = kCIDLib::False;
+        {
+            TCritSecLocker crslShared(&m_crsShared);
+            if (!m_atomShutdown)
+            {
+                m_colShared[c4Lane].objPushBottom(cptrRun);
+                bQueued = kCIDLib::True;
+            }
+        }
+
+        if (!bQueued)
+        {
+            m_scntQueued--;
+            TAtomic::c4SafeRelease(CIDLib_ThreadPool::c4QueuedTotal);
+            cptrRun->Complete(tCIDLib::ETaskStates::Cancelled, nullptr);
+            return;
+        }
+    }
+
+    if (m_scntIdle.c4Value())
+    {
+        TLocker lockIdle(&m_mtxIdle);
+        m_twlIdle.bReleaseOne(kCIDLib::c4TWLReason_WaitData);
+    }
+}
+
+
+//
+//  Push a worker's accumulated stats out to the stats cache, and reset them.
+//  The items are faulted in the first time.
+//
+tCIDLib::TVoid TThreadPool::FlushStats(TWorker& workSrc)
+{
+    if (!CIDLib_ThreadPool::atomStatsInit)
+    {
+        TCritSecLocker crslStats(CIDLib_ThreadPool::pcrsStats());
+        if (!CIDLib_ThreadPool::atomStatsInit)
+        {
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_TPool_AvgLatencyUS
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_ThreadPool::sciAvgLatency
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_TPool_MaxLatencyUS
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_ThreadPool::sciMaxLatency
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_TPool_QueueDepth
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_ThreadPool::sciQueueDepth
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_TPool_Steals
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_ThreadPool::sciSteals
+            );
+            TStatsCache::RegisterItem
+            (
+                kCIDLib::pszStat_TPool_TasksRun
+                , tCIDLib::EStatItemTypes::Value
+                , CIDLib_ThreadPool::sciTasksRun
+            );
+            CIDLib_ThreadPool::atomStatsInit.Set();
+        }
+    }
+
+    TCritSecLocker crslStats(CIDLib_ThreadPool::pcrsStats());
+    if (workSrc.m_c4StatTasks)
+    {
+        CIDLib_ThreadPool::c8TasksTotal += workSrc.m_c4StatTasks;
+        CIDLib_ThreadPool::c8StealsTotal += workSrc.m_c4StatSteals;
+
+        TStatsCache::SetValue
+        (
+            CIDLib_ThreadPool::sciAvgLatency
+            , workSrc.m_c8StatLatency / workSrc.m_c4StatTasks
+        );
+        TStatsCache::bSetIfHigher
+        (
+            CIDLib_ThreadPool::sciMaxLatency, workSrc.m_c8StatMaxLatency
+        );
+        TStatsCache::SetValue(CIDLib_ThreadPool::sciSteals, CIDLib_ThreadPool::c8StealsTotal);
+        TStatsCache::SetValue(CIDLib_ThreadPool::sciTasksRun, CIDLib_ThreadPool::c8TasksTotal);
+
+        workSrc.m_c4StatSteals = 0;
+        workSrc.m_c4StatTasks = 0;
+        workSrc.m_c8StatLatency = 0;
+        workSrc.m_c8StatMaxLatency = 0;
+    }
+
+    TStatsCache::SetValue
+    (
+        CIDLib_ThreadPool::sciQueueDepth
+        , TRawMem::c4CompareAndExchange(CIDLib_ThreadPool::c4QueuedTotal, 0, 0)
+    );
+}
+
+
+//
+//  If the calling thread is one of our workers, return its worker data. We just
+//  compare thread ids, which is cheap and there aren't many workers.
+//
+TThreadPool::TWorker* TThreadPool::pworkCaller() const
+{
+    const tCIDLib::TThreadId tidCaller = TThread::tidCaller();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4WorkerCount; c4Index++)
+    {
+        if (m_apworkList[c4Index]->m_tidWorker == tidCaller)
+            return m_apworkList[c4Index];
+    }
+    return nullptr;
+}
+
+
+//
+//  Create and start up our workers. Zero means one per CPU. Each thread gets
+//  its worker data as its startup data.
+//
+tCIDLib::TVoid TThreadPool::StartWorkers(const tCIDLib::TCard4 c4Workers)
+{
+    if (c4Workers > CIDLib_ThreadPool::c4MaxWorkers)
+    {
+        facCIDLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCIDErrs::errcTPool_BadWorkerCnt
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::BadParms
+            , TCardinal(c4Workers)
+            , TCardinal(CIDLib_ThreadPool::c4MaxWorkers)
+        );
+    }
+
+    tCIDLib::TCard4 c4Count = c4Workers;
+    if (!c4Count)
+    {
+        c4Count = tCIDLib::MinVal(TSysInfo::c4CPUCount(), CIDLib_ThreadPool::c4MaxWorkers);
+        if (!c4Count)
+            c4Count = 1;
+    }
+
+    //
+    //  Set up all of the worker data first, since workers can look at each
+    //  others' data once they start running.
+    //
+    m_apworkList = new TWorker*[c4Count];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        m_apworkList[c4Index] = new TWorker(c4Index);
+        m_apworkList[c4Index]->m_pthrWorker = new TThread
+        (
+            facCIDLib().strNextThreadName(m_strName)
+            , TMemberFunc<TThreadPool>(this, &TThreadPool::eWorkerThread)
+        );
+    }
+    m_c4WorkerCount = c4Count;
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        m_apworkList[c4Index]->m_pthrWorker->Start(m_apworkList[c4Index]);
+}
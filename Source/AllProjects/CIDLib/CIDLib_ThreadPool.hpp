@@ -0,0 +1,488 @@
+//
+// FILE NAME: CIDLib_ThreadPool.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDLib_ThreadPool.cpp file, which implements the
+//  TThreadPool and TThreadPoolTask classes. Code that wants to farm out work
+//  in the background has always had to spin up its own threads. That's fine
+//  for long lived things, but for short bits of work it's a lot of overhead and
+//  it leads to lots of threads all fighting over the CPUs. The thread pool
+//  provides a set of worker threads (by default one per CPU) that run tasks.
+//
+//  A task is a TThreadPoolTask derivative, which overrides RunTask(). For the
+//  common case of just wanting to run a lambda, there's a templatized derivative
+//  and cptrRun() on the pool which creates one and queues it up. Tasks are
+//  managed via counted pointers, so the caller can keep a handle to the task to
+//  wait for it, check the results, or cancel it, or just drop it and let the
+//  pool clean it up when it's done.
+//
+//  Each worker has its own queue for each priority. Tasks queued by a worker
+//  thread (i.e. a task queueing up sub-tasks) go onto that worker's own queue,
+//  where it will take the most recently added one first since that's the most
+//  likely to have hot cache data. Tasks queued from outside the pool go to a
+//  shared queue. When a worker runs out of work, it will steal the oldest task
+//  from another worker's queue. Higher priority tasks are always taken first.
+//
+//  A task can have continuations, other tasks that are queued up when it
+//  completes (whether it succeeded or not.) If a worker thread waits on a task,
+//  it will run other queued tasks while it's waiting, so that tasks can wait on
+//  sub-tasks without the risk of all of the workers being blocked.
+//
+//  Cancellation is cooperative. RequestCancel() sets a flag. If the task has not
+//  started yet, it will just be marked cancelled and never run. If it's running,
+//  the task has to check bCheckCancel() periodically, which also returns true if
+//  the worker thread has been asked to shut down, i.e. the pool is being shut
+//  down.
+//
+//  There is a process wide pool available via tpoolShared(), and generally that
+//  should be used. Other pools can be created if some subsystem needs to keep
+//  its work separate.
+//
+//  The pools maintain some stats in the stats cache, under the thread pool
+//  scope in the core stats scope. These are totals across all pools.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The shared pool is never destroyed, like other lazily faulted globals,
+//      so its threads are just left to be terminated when the process exits.
+//
+//  2)  A task can only be queued once. It cannot be reused once it completes.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+class TThreadPool;
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPoolTask
+//  PREFIX: task
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TThreadPoolTask : public TObject
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TThreadPoolTask(const TThreadPoolTask&) = delete;
+        TThreadPoolTask(TThreadPoolTask&&) = delete;
+
+        ~TThreadPoolTask();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TThreadPoolTask& operator=(const TThreadPoolTask&) = delete;
+        TThreadPoolTask& operator=(TThreadPoolTask&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCancelRequested() const;
+
+        tCIDLib::TBoolean bCheckCancel();
+
+        tCIDLib::TBoolean bIsDone() const;
+
+        tCIDLib::TBoolean bWaitDone
+        (
+            const   tCIDLib::TCard4         c4WaitMSs = kCIDLib::c4MaxWait
+        );
+
+        tCIDLib::ETaskPrios ePriority() const;
+
+        tCIDLib::ETaskStates eState() const;
+
+        TError errFailure() const;
+
+        tCIDLib::TVoid RequestCancel();
+
+
+    protected  :
+        // -------------------------------------------------------------------
+        //  The pool needs to be able to run us and update our state
+        // -------------------------------------------------------------------
+        friend class TThreadPool;
+
+
+        // -------------------------------------------------------------------
+        //  Hidden constructors
+        // -------------------------------------------------------------------
+        TThreadPoolTask();
+
+
+        // -------------------------------------------------------------------
+        //  Protected, virtual methods
+        // -------------------------------------------------------------------
+        virtual tCIDLib::TVoid RunTask() = 0;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bMarkQueued
+        (
+                    TThreadPool* const      ptpoolOwner
+            , const tCIDLib::ETaskPrios     ePrio
+            , const tCIDLib::ETaskStates    eNewState
+        );
+
+        tCIDLib::TVoid Complete
+        (
+            const   tCIDLib::ETaskStates    eFinalState
+            , const TError* const           perrFailure
+        );
+
+        tCIDLib::TVoid Run
+        (
+                    TThread&                thrThis
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_atomCancel
+        //      Set by RequestCancel(). Checked before the task is run and by
+        //      the task itself via bCheckCancel().
+        //
+        //  m_bSawCancel
+        //      Set if bCheckCancel() returns true while we are running, i.e. the
+        //      task saw the cancel and (presumably) gave up, so we end up in the
+        //      cancelled state instead of complete.
+        //
+        //  m_c8QueuedAt
+        //      The high res timer stamp when we were queued, for latency stats.
+        //
+        //  m_colConts
+        //      Any continuations that are waiting on us. When we complete, we
+        //      give them to the pool to queue up.
+        //
+        //  m_crsSync
+        //      Protects the state and continuation list.
+        //
+        //  m_ePrio
+        //      The priority we were queued at.
+        //
+        //  m_eState
+        //      Our current state.
+        //
+        //  m_errFailure
+        //      If we fail, the exception that was thrown.
+        //
+        //  m_evDone
+        //      A manual event that is triggered when we reach a final state.
+        //
+        //  m_pthrRunning
+        //      The worker thread running us, while we are running. This lets
+        //      bCheckCancel() check for a shutdown request.
+        //
+        //  m_ptpoolOwner
+        //      The pool we were queued on, which is where continuations go.
+        // -------------------------------------------------------------------
+        TAtomicFlag                     m_atomCancel;
+        tCIDLib::TBoolean               m_bSawCancel;
+        tCIDLib::TCard8                 m_c8QueuedAt;
+        TVector<TCntPtr<TThreadPoolTask>> m_colConts;
+        TCriticalSection                m_crsSync;
+        tCIDLib::ETaskPrios             m_ePrio;
+        tCIDLib::ETaskStates            m_eState;
+        TError                          m_errFailure;
+        TEvent                          m_evDone;
+        TThread*                        m_pthrRunning;
+        TThreadPool*                    m_ptpoolOwner;
+
+
+        // -------------------------------------------------------------------
+        //  Magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TThreadPoolTask,TObject)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPoolFuncTask
+//  PREFIX: task
+//
+//  A simple derivative that runs a function object, generally a lambda. It gets
+//  a reference to the task so that it can call bCheckCancel().
+// ---------------------------------------------------------------------------
+template <typename TFunc> class TThreadPoolFuncTask : public TThreadPoolTask
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TThreadPoolFuncTask(TFunc fnToRun) :
+
+            m_fnToRun(fnToRun)
+        {
+        }
+
+        TThreadPoolFuncTask(const TThreadPoolFuncTask&) = delete;
+        TThreadPoolFuncTask(TThreadPoolFuncTask&&) = delete;
+
+        ~TThreadPoolFuncTask()
+        {
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TThreadPoolFuncTask& operator=(const TThreadPoolFuncTask&) = delete;
+        TThreadPoolFuncTask& operator=(TThreadPoolFuncTask&&) = delete;
+
+
+    protected  :
+        // -------------------------------------------------------------------
+        //  Protected, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid RunTask() final
+        {
+            m_fnToRun(*this);
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_fnToRun
+        //      The function object we run.
+        // -------------------------------------------------------------------
+        TFunc   m_fnToRun;
+
+
+        // -------------------------------------------------------------------
+        //  Magic macros
+        // -------------------------------------------------------------------
+        TemplateRTTIDefs(TThreadPoolFuncTask<TFunc>,TThreadPoolTask)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TThreadPool
+//  PREFIX: tpool
+// ---------------------------------------------------------------------------
+class CIDLIBEXP TThreadPool : public TObject
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Public types
+        // -------------------------------------------------------------------
+        using TTaskPtr = TCntPtr<TThreadPoolTask>;
+
+
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static TThreadPool& tpoolShared();
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TThreadPool();
+
+        TThreadPool
+        (
+            const   TString&                strName
+            , const tCIDLib::TCard4         c4Workers = 0
+        );
+
+        TThreadPool(const TThreadPool&) = delete;
+        TThreadPool(TThreadPool&&) = delete;
+
+        ~TThreadPool();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TThreadPool& operator=(const TThreadPool&) = delete;
+        TThreadPool& operator=(TThreadPool&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsWorkerThread() const;
+
+        tCIDLib::TCard4 c4QueuedCount() const;
+
+        tCIDLib::TCard4 c4WorkerCount() const;
+
+        template <typename TFunc>
+        TTaskPtr cptrRun(       TFunc               fnToRun
+                        , const tCIDLib::ETaskPrios ePrio = tCIDLib::ETaskPrios::Normal)
+        {
+            TTaskPtr cptrRet(new TThreadPoolFuncTask<TFunc>(fnToRun));
+            Submit(cptrRet, ePrio);
+            return cptrRet;
+        }
+
+        template <typename TFunc>
+        TTaskPtr cptrRunAfter(  const   TTaskPtr&           cptrAnte
+                                ,       TFunc               fnToRun
+                                , const tCIDLib::ETaskPrios ePrio = tCIDLib::ETaskPrios::Normal)
+        {
+            TTaskPtr cptrRet(new TThreadPoolFuncTask<TFunc>(fnToRun));
+            SubmitAfter(cptrAnte, cptrRet, ePrio);
+            return cptrRet;
+        }
+
+        const TString& strName() const;
+
+        tCIDLib::TVoid Shutdown();
+
+        tCIDLib::TVoid Submit
+        (
+            const   TTaskPtr&               cptrToRun
+            , const tCIDLib::ETaskPrios     ePrio = tCIDLib::ETaskPrios::Normal
+        );
+
+        tCIDLib::TVoid SubmitAfter
+        (
+            const   TTaskPtr&               cptrAnte
+            , const TTaskPtr&               cptrToRun
+            , const tCIDLib::ETaskPrios     ePrio = tCIDLib::ETaskPrios::Normal
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  The task needs to call back to queue continuations and to help out
+        //  while a worker is waiting on a task.
+        // -------------------------------------------------------------------
+        friend class TThreadPoolTask;
+
+
+        // -------------------------------------------------------------------
+        //  Private types. The worker data is defined internally.
+        // -------------------------------------------------------------------
+        struct TWorker;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFindTask
+        (
+                    TWorker&                workSrc
+            ,       TTaskPtr&               cptrToFill
+        );
+
+        tCIDLib::TBoolean bHelpUntilDone
+        (
+                    TThreadPoolTask&        taskWait
+            , const tCIDLib::TCard4         c4WaitMSs
+        );
+
+        tCIDLib::TBoolean bRunOne
+        (
+                    TWorker&                workSrc
+            ,       TThread&                thrThis
+        );
+
+        tCIDLib::EExitCodes eWorkerThread
+        (
+                    TThread&                thrThis
+            ,       tCIDLib::TVoid*         pData
+        );
+
+        tCIDLib::TVoid Enqueue
+        (
+            const   TTaskPtr&               cptrToRun
+        );
+
+        tCIDLib::TVoid FlushStats
+        (
+                    TWorker&                workSrc
+        );
+
+        TWorker* pworkCaller() const;
+
+        tCIDLib::TVoid StartWorkers
+        (
+            const   tCIDLib::TCard4         c4Workers
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_apworkList
+        //      The worker data for each of our threads, m_c4WorkerCount of them.
+        //
+        //  m_atomShutdown
+        //      Set once we start shutting down, after which we reject new tasks.
+        //
+        //  m_c4WorkerCount
+        //      The number of workers we have.
+        //
+        //  m_colShared
+        //      The shared queues, one per priority, for tasks queued by threads
+        //      other than our workers.
+        //
+        //  m_crsShared
+        //      Protects the shared queues.
+        //
+        //  m_mtxIdle
+        //  m_twlIdle
+        //      Idle workers block on the wait list, and queueing code releases
+        //      one of them. The mutex is used with the wait list so that there
+        //      is no window where a wakeup can be missed.
+        //
+        //  m_scntIdle
+        //      The number of workers currently idle, so that queueing code can
+        //      skip waking anyone up if no one is waiting.
+        //
+        //  m_scntQueued
+        //      The number of tasks queued up in all of our queues.
+        //
+        //  m_strName
+        //      The name of the pool, which is used for the thread names.
+        // -------------------------------------------------------------------
+        TWorker**                   m_apworkList;
+        TAtomicFlag                 m_atomShutdown;
+        tCIDLib::TCard4             m_c4WorkerCount;
+        TDeque<TTaskPtr>            m_colShared[tCIDLib::c4EnumOrd(tCIDLib::ETaskPrios::Count)];
+        TCriticalSection            m_crsShared;
+        TMutex                      m_mtxIdle;
+        TSafeCard4Counter           m_scntIdle;
+        TSafeCard4Counter           m_scntQueued;
+        TString                     m_strName;
+        TThreadWaitList             m_twlIdle;
+
+
+        // -------------------------------------------------------------------
+        //  Magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TThreadPool,TObject)
+};
+
+#pragma CIDLIB_POPPACK
@@ -166,6 +166,36 @@ namespace tCIDLib
     };
 
 
+    // -----------------------------------------------------------------------
+    //  The priority lanes of the thread pool, and the states a thread pool task
+    //  goes through. Waiting means it's a continuation waiting for the task it
+    //  follows to complete. The last three are final states.
+    // -----------------------------------------------------------------------
+    enum class ETaskPrios
+    {
+        High
+        , Normal
+        , Low
+
+        , Count
+        , Min       = High
+        , Max       = Low
+    };
+
+    enum class ETaskStates
+    {
+        Idle
+        , Waiting
+        , Queued
+        , Running
+        , Complete
+        , Failed
+        , Cancelled
+
+        , Count
+    };
+
+
 
     // -----------------------------------------------------------------------
     //  Translation methods. In higher level code, these are generated by the IDL
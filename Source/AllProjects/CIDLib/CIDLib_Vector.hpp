@@ -640,7 +640,7 @@ class TVector : public TCollection<TElem>
         const TElem& operator[](const TIndex tIndex) const
         {
             const tCIDLib::TCard4 c4Index = tCIDLib::TCard4(tIndex);
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             this->CheckIndex(c4Index, m_c4CurCount, CID_FILE, CID_LINE);
             return *m_apElems[c4Index];
         }
@@ -666,13 +666,13 @@ class TVector : public TCollection<TElem>
 
         tCIDLib::TBoolean bIsEmpty() const final
         {
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             return (m_c4CurCount == 0);
         }
 
         tCIDLib::TCard4 c4ElemCount() const final
         {
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             return m_c4CurCount;
         }
 
@@ -706,7 +706,7 @@ class TVector : public TCollection<TElem>
 
         [[nodiscard]] TCursor* pcursNew() const final
         {
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             return new TCursor(this);
         }
 
@@ -937,7 +937,7 @@ class TVector : public TCollection<TElem>
 
         [[nodiscard]] tCIDLib::TCard4 c4CurAlloc() const
         {
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             return m_c4CurAlloc;
         }
 
@@ -962,7 +962,7 @@ class TVector : public TCollection<TElem>
 
         template <typename IterCB> tCIDLib::TBoolean bForEachI(IterCB iterCB) const
         {
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
             for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4CurCount; c4Index++)
             {
                 if (!iterCB(*m_apElems[c4Index], c4Index))
@@ -1118,7 +1118,7 @@ class TVector : public TCollection<TElem>
         const TElem& objAt(const TIndex tIndex) const
         {
             const tCIDLib::TCard4 c4Index = tCIDLib::TCard4(tIndex);
-            TLocker lockrCol(this);
+            TSharedLocker lockrCol(this);
             this->CheckIndex(c4Index, m_c4CurCount, CID_FILE, CID_LINE);
             return *m_apElems[c4Index];
         }
@@ -1166,6 +1166,31 @@ class TVector : public TCollection<TElem>
             return *m_apElems[m_c4CurCount - 1];
         }
 
+        //
+        //  Same as Sort() below, but the sort is spread across the shared thread
+        //  pool. If the count is below twice the grain size, it's just done
+        //  serially. The comparison function will be called from multiple threads.
+        //
+        template <typename TCompFunc>
+        tCIDLib::TVoid ParSort(         TCompFunc           pfnComp
+                                , const tCIDLib::TCard4     c4Grain = kCIDLib::c4DefParGrain)
+        {
+            TLocker lockrCol(this);
+
+            // If one or less, we are done
+            if (m_c4CurCount < 2)
+                return;
+
+            TArrayOps::TParSort<TElem*>
+            (
+                m_apElems
+                , m_c4CurCount
+                , [pfnComp](const TElem* pobj1, const TElem* pobj2)
+                  {return pfnComp(*pobj1, *pobj2); }
+                , c4Grain
+            );
+        }
+
 
         template <typename TCompFunc>
         TElem* pobjBinarySearch(const   TElem&          objToFind
@@ -1673,7 +1698,7 @@ class TVector : public TCollection<TElem>
         {
             const tCIDLib::TCard4 c4StartAt = tCIDLib::TCard4(tStartAt);
 
-            TLocker lockrThis(this);
+            TSharedLocker lockrThis(this);
 
 			//
 			//	We can allow the start index to be at the item past the end. We just
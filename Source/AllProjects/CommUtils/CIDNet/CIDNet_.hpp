@@ -40,4 +40,5 @@
 // ---------------------------------------------------------------------------
 #include    "CIDCrypto.hpp"
 #include    "CIDEncode.hpp"
+#include    "CIDZLib.hpp"
 
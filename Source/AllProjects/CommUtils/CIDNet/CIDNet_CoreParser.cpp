@@ -327,6 +327,7 @@ TNetCoreParser::bParseSrvFirstLn(const  TString&                strFirstLn
 // ---------------------------------------------------------------------------
 TNetCoreParser::~TNetCoreParser()
 {
+    delete m_pzpdCont;
 }
 
 
@@ -335,7 +336,10 @@ TNetCoreParser::~TNetCoreParser()
 // ---------------------------------------------------------------------------
 TNetCoreParser::TNetCoreParser(const TString& strHdrSep) :
 
-    m_mbufTmp(8192, 0x800000, 64 * 1024)
+    m_bDecodeCont(kCIDLib::False)
+    , m_bSniffDeflate(kCIDLib::False)
+    , m_mbufTmp(8192, 0x800000, 64 * 1024)
+    , m_pzpdCont(nullptr)
     , m_strHdrSep(strHdrSep)
 {
 }
@@ -369,6 +373,20 @@ TNetCoreParser::bParseHdrLine(TString& strHdrLn, TString& strValue)
 // ---------------------------------------------------------------------------
 //  TNetCoreParser: Protected, non-virtual methods
 // ---------------------------------------------------------------------------
+
+// Get or set the flag that enables decoding of gzip/deflate encoded content
+tCIDLib::TBoolean TNetCoreParser::bDecodeContent() const
+{
+    return m_bDecodeCont;
+}
+
+tCIDLib::TBoolean TNetCoreParser::bDecodeContent(const tCIDLib::TBoolean bToSet)
+{
+    m_bDecodeCont = bToSet;
+    return m_bDecodeCont;
+}
+
+
 tCIDNet::ENetPReadRes
 TNetCoreParser::eReadHdrLines(          TCIDDataSrc&            cdsSrc
                                 , const tCIDLib::TEncodedTime   enctEnd
@@ -540,6 +558,9 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
         //  If we got no specific length, then just pay the price of letting
         //  it expand as we copy stuff in.
         //
+        //  If we end up decoding the content, this only checks the encoded
+        //  size. The decoded data is checked as it's stored.
+        //
         if (c4ToRead != kCIDLib::c4MaxCard)
         {
             if (mbufCont.c4MaxSize() < c4ToRead)
@@ -575,6 +596,42 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
             bChunked = kCIDLib::True;
         }
 
+        //
+        //  If we've been asked to decode content, and it's gzip or deflate
+        //  encoded, then set up to decompress it as it comes in, so that we
+        //  never have to hold the compressed version. The decompressed data is
+        //  streamed straight into the caller's buffer.
+        //
+        TBinMBufOutStream* pstrmDecode = nullptr;
+        if (m_bDecodeCont
+        &&  bFindHdrLine(colHdrLines, THTTPClient::strHdr_ContEncoding, strTmp))
+        {
+            strTmp.StripWhitespace();
+            const tCIDLib::TBoolean bGZip
+            (
+                strTmp.bCompareI(L"gzip") || strTmp.bCompareI(L"x-gzip")
+            );
+            if (bGZip || strTmp.bCompareI(L"deflate"))
+            {
+                if (!m_pzpdCont)
+                    m_pzpdCont = new TZLibPushDecompressor(tCIDZLib::EFormats::GZip);
+                m_pzpdCont->Reset
+                (
+                    bGZip ? tCIDZLib::EFormats::GZip : tCIDZLib::EFormats::ZLib
+                );
+                m_bSniffDeflate = !bGZip;
+                pstrmDecode = new TBinMBufOutStream(&mbufCont);
+            }
+        }
+        TJanitor<TBinMBufOutStream> janDecode(pstrmDecode);
+
+        //
+        //  We have to count the raw bytes separately, since the content we store
+        //  may be decoded. And we remember if we saw the end of the body, since
+        //  we can only check for a complete encoded stream if so.
+        //
+        tCIDLib::TBoolean bBodyDone = kCIDLib::False;
+        tCIDLib::TCard4 c4RawLen = 0;
         if (bChunked)
         {
             while ((enctCur < enctEnd) && !thrCaller.bCheckShutdownRequest())
@@ -636,7 +693,10 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
 
                 // If it's zero, then we are done with the body text
                 if (!c4ChunkLen)
+                {
+                    bBodyDone = kCIDLib::True;
                     break;
+                }
 
                 // Now let's read this many bytes into our content buffer
                 tCIDLib::TCard4 c4SoFar = 0;
@@ -659,9 +719,10 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
 
                     if (c4NewBytes)
                     {
-                        mbufCont.CopyIn(m_mbufTmp, c4NewBytes, c4ContLen);
-                        c4ContLen += c4NewBytes;
+                        if (!bStoreContent(pstrmDecode, mbufCont, c4NewBytes, c4ContLen))
+                            return tCIDNet::ENetPReadRes::BufTooSmall;
                         c4SoFar += c4NewBytes;
+                        c4RawLen += c4NewBytes;
                     }
                      else
                     {
@@ -722,7 +783,7 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
             //  get an end of of input, or time out.
             //
             while ((enctCur < enctEnd)
-            &&     (c4ContLen < c4ToRead)
+            &&     (c4RawLen < c4ToRead)
             &&     !thrCaller.bCheckShutdownRequest())
             {
                 //
@@ -733,13 +794,14 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
                 //
                 const tCIDLib::TCard4 c4NewBytes = cdsSrc.c4ReadBytes
                 (
-                    m_mbufTmp, tCIDLib::MinVal(2048UL, c4ToRead - c4ContLen), enctEnd
+                    m_mbufTmp, tCIDLib::MinVal(2048UL, c4ToRead - c4RawLen), enctEnd
                 );
 
                 if (c4NewBytes)
                 {
-                    mbufCont.CopyIn(m_mbufTmp, c4NewBytes, c4ContLen);
-                    c4ContLen += c4NewBytes;
+                    if (!bStoreContent(pstrmDecode, mbufCont, c4NewBytes, c4ContLen))
+                        return tCIDNet::ENetPReadRes::BufTooSmall;
+                    c4RawLen += c4NewBytes;
                 }
                  else
                 {
@@ -759,8 +821,44 @@ TNetCoreParser::eGetMsg(        TCIDDataSrc&            cdsSrc
             //  If we got a content length to expect, but didn't get that many
             //  bytes, then we didn't get the whole message.
             //
-            if ((c4ToRead != kCIDLib::c4MaxCard) && (c4ContLen < c4ToRead))
+            if ((c4ToRead != kCIDLib::c4MaxCard) && (c4RawLen < c4ToRead))
                 return tCIDNet::ENetPReadRes::PartialMsg;
+
+            //
+            //  If we got the expected length, then we saw the end of the body.
+            //  If reading till the end, the read can't tell us if it stopped
+            //  because of the end of input or a timeout. So, if decoding, let
+            //  the decoder tell us if it saw the end of the encoded data.
+            //
+            if (c4ToRead != kCIDLib::c4MaxCard)
+                bBodyDone = kCIDLib::True;
+            else if (pstrmDecode)
+                bBodyDone = m_pzpdCont->bDone();
+        }
+
+        //
+        //  If we decoded the content, remove the encoding and length lines, since
+        //  they no longer describe what we are returning. The length gets put
+        //  back below with the decoded length.
+        //
+        //  If there was a whole body, make sure we saw the whole encoded stream.
+        //  If we got some of the body but not all of it, then it's a partial
+        //  msg. If no body at all, it falls through like any other empty body.
+        //
+        if (pstrmDecode)
+        {
+            DropHdrLine(colHdrLines, THTTPClient::strHdr_ContEncoding);
+            DropHdrLine(colHdrLines, THTTPClient::strHdr_ContLen);
+
+            if (c4RawLen)
+            {
+                if (bBodyDone)
+                    m_pzpdCont->Finish();
+                else if (c4ContLen)
+                    return tCIDNet::ENetPReadRes::PartialMsg;
+                else
+                    return tCIDNet::ENetPReadRes::Timeout;
+            }
         }
     }
      else
@@ -857,10 +955,104 @@ TNetCoreParser::SendMsg(        TCIDDataSrc&            cdsTar
 }
 
 
+// ---------------------------------------------------------------------------
+//  TNetCoreParser: Private, static methods
+// ---------------------------------------------------------------------------
+
+// Remove any header lines with the indicated name
+tCIDLib::TVoid
+TNetCoreParser::DropHdrLine(        tCIDLib::TKVPCollect&   colHdrLines
+                            , const TString&                strToDrop)
+{
+    if (!bHdrLineExists(colHdrLines, strToDrop))
+        return;
+
+    // Copy out the ones we are keeping, then put them back
+    tCIDLib::TKVPList colKeep(colHdrLines.c4ElemCount());
+    {
+        TColCursor<TKeyValuePair>* pcursHdrs = colHdrLines.pcursNew();
+        TJanitor<TColCursor<TKeyValuePair> > janCursor(pcursHdrs);
+        pcursHdrs->bReset();
+        do
+        {
+            const TKeyValuePair& kvalCur = pcursHdrs->objRCur();
+            if (!kvalCur.strKey().bCompareI(strToDrop))
+                colKeep.objAdd(kvalCur);
+        }   while (pcursHdrs->bNext());
+    }
+
+    colHdrLines.RemoveAll();
+    const tCIDLib::TCard4 c4Count = colKeep.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        colHdrLines.objAdd(colKeep[c4Index]);
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  TNetCoreParser: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  The body reading loops call this to store each chunk of content read into
+//  m_mbufTmp. If not decoding, we just append it to the caller's buffer. Else
+//  we push it through the decompressor, which writes out whatever it can
+//  decode to the caller's buffer via the passed stream. Either way, c4ContLen
+//  is updated to the bytes now in the caller's buffer.
+//
+//  If the decoded data won't fit in the caller's buffer, we return false. The
+//  encoded size was checked up front, but the decoded size can't be known
+//  until we get there.
+//
+tCIDLib::TBoolean
+TNetCoreParser::bStoreContent(       TBinOutStream* const    pstrmDecode
+                             ,       TMemBuf&                mbufCont
+                             , const tCIDLib::TCard4         c4NewBytes
+                             ,       tCIDLib::TCard4&        c4ContLen)
+{
+    if (!pstrmDecode)
+    {
+        mbufCont.CopyIn(m_mbufTmp, c4NewBytes, c4ContLen);
+        c4ContLen += c4NewBytes;
+        return kCIDLib::True;
+    }
+
+    //
+    //  If deflate, check the first byte. A zlib header always indicates the
+    //  deflate method in the low nibble, with a window size no larger than
+    //  32K in the high nibble. Else assume it's raw deflate data.
+    //
+    if (m_bSniffDeflate)
+    {
+        const tCIDLib::TCard1 c1CMF = m_mbufTmp[0];
+        if (((c1CMF & 0x0F) != 8) || ((c1CMF >> 4) > 7))
+            m_pzpdCont->Reset(tCIDZLib::EFormats::Raw);
+        m_bSniffDeflate = kCIDLib::False;
+    }
+
+    //
+    //  The stream won't write past the buffer's max size, and throws if it
+    //  can't write it all. So if it throws and the buffer is full, then it's
+    //  just too small. Anything else is a real error.
+    //
+    try
+    {
+        c4ContLen += m_pzpdCont->c4Feed(m_mbufTmp, c4NewBytes, *pstrmDecode);
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (mbufCont.c4Size() < mbufCont.c4MaxSize())
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            throw;
+        }
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
 //
 //  A common helper that will build up the header and the caller's content
 //  into our send buffer member and return the count of bytes. This is used
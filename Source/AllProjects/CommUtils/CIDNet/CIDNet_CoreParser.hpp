@@ -57,6 +57,7 @@
 
 
 class TNetPDataSrc;
+class TZLibPushDecompressor;
 
 
 // ---------------------------------------------------------------------------
@@ -167,6 +168,13 @@ class CIDNETEXP TNetCoreParser : public TObject
         // -------------------------------------------------------------------
         //  Protected, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bDecodeContent() const;
+
+        tCIDLib::TBoolean bDecodeContent
+        (
+            const   tCIDLib::TBoolean       bToSet
+        );
+
         tCIDNet::ENetPReadRes eGetMsg
         (
                     TCIDDataSrc&            cdsSrc
@@ -197,9 +205,27 @@ class CIDNETEXP TNetCoreParser : public TObject
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TVoid DropHdrLine
+        (
+                    tCIDLib::TKVPCollect&   colHdrLines
+            , const TString&                strToDrop
+        );
+
+
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bStoreContent
+        (
+                    TBinOutStream* const    pstrmDecode
+            ,       TMemBuf&                mbufCont
+            , const tCIDLib::TCard4         c4NewBytes
+            ,       tCIDLib::TCard4&        c4ContLen
+        );
+
         tCIDLib::TCard4 c4BuildMsg
         (
             const   TString&                strFirstLine
@@ -227,16 +253,34 @@ class CIDNETEXP TNetCoreParser : public TObject
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_bDecodeCont
+        //      If set, then any body content with a gzip or deflate content
+        //      encoding is decompressed as it is read in, and the content
+        //      encoding and length header lines are updated to match. Off by
+        //      default, since the derived class has to ask for such content.
+        //
+        //  m_bSniffDeflate
+        //      The deflate content encoding is supposed to be zlib framed, but
+        //      some servers send raw deflate data. So, for that encoding, this
+        //      is set until we see the first content byte and can tell which.
+        //
         //  m_mbufTmp
         //      A buffer for us to use for in/out msg handling, to avoid
         //      creating them over and over.
         //
+        //  m_pzpdCont
+        //      The decompressor used for encoded content. It's faulted in the
+        //      first time it's needed and reset for each msg after that.
+        //
         //  m_strHdrSep
         //      The derived class tells us what to put between the name and
         //      value of the header lines.
         // -------------------------------------------------------------------
-        THeapBuf    m_mbufTmp;
-        TString     m_strHdrSep;
+        tCIDLib::TBoolean       m_bDecodeCont;
+        tCIDLib::TBoolean       m_bSniffDeflate;
+        THeapBuf                m_mbufTmp;
+        TZLibPushDecompressor*  m_pzpdCont;
+        TString                 m_strHdrSep;
 
 
         // -------------------------------------------------------------------
@@ -55,9 +55,11 @@ const TString   THTTPClient::strCC_NoCache(L"no-cache");
 const TString   THTTPClient::strCC_NoStore(L"no-store");
 
 const TString   THTTPClient::strHdr_Accept(L"Accept");
+const TString   THTTPClient::strHdr_AcceptEncoding(L"Accept-Encoding");
 const TString   THTTPClient::strHdr_CacheControl(L"Cache-Control");
 const TString   THTTPClient::strHdr_Connection(L"Connection");
 const TString   THTTPClient::strHdr_ContDisposition(L"Content-Disposition");
+const TString   THTTPClient::strHdr_ContEncoding(L"Content-Encoding");
 const TString   THTTPClient::strHdr_ContLen(L"Content-Length");
 const TString   THTTPClient::strHdr_ContTransferEncoding(L"Content-Transfer-Encoding");
 const TString   THTTPClient::strHdr_ContType(L"Content-Type");
@@ -1336,6 +1338,23 @@ tCIDLib::TBoolean THTTPClient::bAutoAuth(const tCIDLib::TBoolean bToSet)
 }
 
 
+//
+//  Get or set the auto-decode flag. If set, we tell the server we accept gzip
+//  and deflate content encodings, and such replies are decompressed as they
+//  are read in. So the caller gets back the decoded content, and the reply
+//  header lines are adjusted to match.
+//
+tCIDLib::TBoolean THTTPClient::bAutoDecode() const
+{
+    return bDecodeContent();
+}
+
+tCIDLib::TBoolean THTTPClient::bAutoDecode(const tCIDLib::TBoolean bToSet)
+{
+    return bDecodeContent(bToSet);
+}
+
+
 
 //
 //  Handles getting a response back from the server in response to a GET or
@@ -2448,6 +2467,16 @@ THTTPClient::c4DoOp(        TCIDDataSrc* const      pcdsSrc
         if (pcdsSrc && !TNetCoreParser::bHdrLineExists(colInHdrLines, strHdr_TE))
             colExHdrs.objPlace(strHdr_TE, L"trailers, chunked");
 
+        //
+        //  If we are auto-decoding, and there's no explicit accept encoding line,
+        //  then indicate the ones we can decode.
+        //
+        if (bAutoDecode()
+        &&  !TNetCoreParser::bHdrLineExists(colInHdrLines, strHdr_AcceptEncoding))
+        {
+            colExHdrs.objPlace(strHdr_AcceptEncoding, L"gzip, deflate");
+        }
+
         //
         //  If outward body content have to add the content type. Either way we set
         //  the content length, insuring it's zero if the caller indicates no outward
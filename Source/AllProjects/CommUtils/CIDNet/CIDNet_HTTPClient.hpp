@@ -53,9 +53,11 @@ class CIDNETEXP THTTPClient : public TNetCoreParser
         static const TString    strCC_NoStore;
 
         static const TString    strHdr_Accept;
+        static const TString    strHdr_AcceptEncoding;
         static const TString    strHdr_CacheControl;
         static const TString    strHdr_Connection;
         static const TString    strHdr_ContDisposition;
+        static const TString    strHdr_ContEncoding;
         static const TString    strHdr_ContLen;
         static const TString    strHdr_ContTransferEncoding;
         static const TString    strHdr_ContType;
@@ -235,6 +237,13 @@ class CIDNETEXP THTTPClient : public TNetCoreParser
             const   tCIDLib::TBoolean       bToSet
         );
 
+        tCIDLib::TBoolean bAutoDecode() const;
+
+        tCIDLib::TBoolean bAutoDecode
+        (
+            const   tCIDLib::TBoolean       bToSet
+        );
+
         tCIDLib::TCard4 c4GetSrvReply
         (
                     TCIDDataSrc&            cdsSrc
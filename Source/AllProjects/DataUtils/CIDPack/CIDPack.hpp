@@ -52,6 +52,13 @@
 //  Each file's uncompressed data is MD5 hashed, so that we can be sure that we
 //  get back out what we put in.
 //
+//  Packing and extraction can be done in parallel. When packing, one thread
+//  reads the files in, a set of workers hash and compress them, and the calling
+//  thread writes them out in the original order, so the package is the same as
+//  a serially created one. When extracting, the calling thread reads the entries
+//  and the workers decompress, check and write out the files. In both cases the
+//  amount of file data in flight is bounded.
+//
 //
 // CAVEATS/GOTCHAS:
 //
@@ -95,6 +102,16 @@ namespace kCIDPack
         0x28, 0x43, 0x49, 0x44, 0x50, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x56, 0x31
     };
     const tCIDLib::TCard4 c4MarkerLen = tCIDLib::c4ArrayElems(ac1Marker);
+
+
+    // -----------------------------------------------------------------------
+    //  Limits for parallel packing and extraction. We never use more than the
+    //  max number of workers, and the amount of file data held in memory at
+    //  once is limited to the pipe bytes value (though a single file larger
+    //  than that is still allowed through on its own.)
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4MaxWorkers = 32;
+    constexpr tCIDLib::TCard8   c8MaxPipeBytes = 256 * 1024 * 1024;
 }
 
 
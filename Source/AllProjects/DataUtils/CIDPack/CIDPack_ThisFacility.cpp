@@ -38,6 +38,558 @@ RTTIDecls(TFacCIDPack,TFacility)
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and functions
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDPack_ThisFacility
+    {
+        // -----------------------------------------------------------------------
+        //  For parallel packing and extraction, each file in flight is in one of
+        //  these. The reading side loads it up, a worker processes it, and then
+        //  it goes back to be used for a later file. The buffers are kept across
+        //  files unless they get large, to avoid a lot of reallocation.
+        //
+        //  When packing, the path is the source file. When extracting, it's the
+        //  target file.
+        // -----------------------------------------------------------------------
+        struct TPackJob
+        {
+            tCIDLib::TBoolean       bDone = kCIDLib::False;
+            tCIDLib::TBoolean       bFailed = kCIDLib::False;
+            tCIDLib::TCard4         c4CompSz = 0;
+            tCIDLib::TCard4         c4OrgSz = 0;
+            tCIDLib::TCard8         c8Bytes = 0;
+            TError                  errFailure;
+            THeapBuf                mbufComp;
+            THeapBuf                mbufOrg;
+            TMD5Hash                mhashOrg;
+            TPathStr                pathFile;
+            TString                 strRelPath;
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The info shared by all of the threads involved in a parallel pack or
+        //  extract. The jobs are a ring. Files are loaded, claimed by workers, and
+        //  released back in order, so the counters below only ever go up and each
+        //  one's slot is its count modulo the slot count.
+        //
+        //  The events are manual reset ones. Waiters reset them while holding the
+        //  lock, after seeing that they need to wait, and they are only triggered
+        //  while holding the lock, so no wakeups can be lost.
+        // -----------------------------------------------------------------------
+        struct TPipeInfo
+        {
+            TPipeInfo(const tCIDLib::TCard4 c4SlotCnt) :
+
+                c4Slots(c4SlotCnt)
+                , evDone(tCIDLib::EEventStates::Reset)
+                , evFreed(tCIDLib::EEventStates::Reset)
+                , evLoaded(tCIDLib::EEventStates::Reset)
+                , objaJobs(c4SlotCnt)
+            {
+            }
+
+            tCIDLib::TBoolean                   bAbort = kCIDLib::False;
+            tCIDLib::TBoolean                   bNoMore = kCIDLib::False;
+            tCIDLib::TBoolean                   bOverwrite = kCIDLib::False;
+            tCIDLib::TCard4                     c4Claimed = 0;
+            tCIDLib::TCard4                     c4Loaded = 0;
+            tCIDLib::TCard4                     c4Released = 0;
+            const tCIDLib::TCard4               c4Slots;
+            tCIDLib::TCard8                     c8InFlight = 0;
+            TCriticalSection                    crsSync;
+            TError                              errFailure;
+            TEvent                              evDone;
+            TEvent                              evFreed;
+            TEvent                              evLoaded;
+            TObjArray<TPackJob>                 objaJobs;
+            const TRefVector<const TFindBuf>*   pcolFiles = nullptr;
+            TString                             strFailed;
+        };
+
+
+        // How long threads wait before checking again for an abort
+        constexpr tCIDLib::TCard4   c4WaitMSs = 500;
+
+
+        // -----------------------------------------------------------------------
+        //  Calculate the percent reduction for a compressed file, for status
+        //  output. It's never 100%, but rounding may make it that, so adjust.
+        // -----------------------------------------------------------------------
+        tCIDLib::TCard4
+        c4ReducedPercent(const tCIDLib::TCard4 c4CompSz, const tCIDLib::TCard4 c4OrgSz)
+        {
+            tCIDLib::TCard4 c4Percent
+            (
+                tCIDLib::TCard4
+                (
+                    (1.0 - (tCIDLib::TFloat4(c4CompSz) / tCIDLib::TFloat4(c4OrgSz))) * 100.0
+                )
+            );
+
+            if (c4Percent >= 100)
+                c4Percent = 99;
+            return c4Percent;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Make sure that a job buffer can hold the indicated number of bytes. If
+        //  it's too small, or it's gotten large and we need a lot less, we replace
+        //  it.
+        // -----------------------------------------------------------------------
+        tCIDLib::TVoid SizeBuf(THeapBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            if ((mbufTar.c4Size() < c4Bytes)
+            ||  ((mbufTar.c4Size() > kCIDLib::c4DefMaxBufferSz) && (mbufTar.c4Size() > c4Bytes)))
+            {
+                mbufTar = THeapBuf(c4Bytes, c4Bytes);
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Figure out how many workers to use. Zero means use one per CPU.
+        // -----------------------------------------------------------------------
+        tCIDLib::TCard4 c4WorkerCount(const tCIDLib::TCard4 c4MaxWorkers)
+        {
+            tCIDLib::TCard4 c4Ret = c4MaxWorkers ? c4MaxWorkers : TSysInfo::c4CPUCount();
+            if (c4Ret > kCIDPack::c4MaxWorkers)
+                c4Ret = kCIDPack::c4MaxWorkers;
+            return c4Ret;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The reading side calls this to get the next job slot to load, waiting
+        //  until there's a free one and the data in flight is under the limit. If
+        //  nothing is in flight, we let it go no matter how large. Returns null if
+        //  the pipe is aborted.
+        // -----------------------------------------------------------------------
+        TPackJob* pjobWaitForSlot(TPipeInfo& pipeInfo, const tCIDLib::TCard8 c8Bytes)
+        {
+            while (kCIDLib::True)
+            {
+                {
+                    TCritSecLocker lockSync(&pipeInfo.crsSync);
+                    if (pipeInfo.bAbort)
+                        return nullptr;
+
+                    const tCIDLib::TCard4 c4InFlight = pipeInfo.c4Loaded - pipeInfo.c4Released;
+                    if ((c4InFlight < pipeInfo.c4Slots)
+                    &&  (!c4InFlight || (pipeInfo.c8InFlight + c8Bytes <= kCIDPack::c8MaxPipeBytes)))
+                    {
+                        TPackJob& jobRet = pipeInfo.objaJobs[pipeInfo.c4Loaded % pipeInfo.c4Slots];
+                        jobRet.bDone = kCIDLib::False;
+                        jobRet.bFailed = kCIDLib::False;
+                        jobRet.c8Bytes = c8Bytes;
+                        return &jobRet;
+                    }
+                    pipeInfo.evFreed.Reset();
+                }
+                pipeInfo.evFreed.bWaitFor(c4WaitMSs);
+            }
+        }
+
+
+        //
+        //  The reading side calls this to make the job it just loaded available
+        //  to the workers. If it failed while loading, it's marked done so that
+        //  the workers will skip it.
+        //
+        tCIDLib::TVoid QueueJob(TPipeInfo& pipeInfo, TPackJob& jobLoaded)
+        {
+            TCritSecLocker lockSync(&pipeInfo.crsSync);
+            if (jobLoaded.bFailed)
+                jobLoaded.bDone = kCIDLib::True;
+
+            pipeInfo.c8InFlight += jobLoaded.c8Bytes;
+            pipeInfo.c4Loaded++;
+            pipeInfo.evLoaded.Trigger();
+            if (jobLoaded.bDone)
+                pipeInfo.evDone.Trigger();
+        }
+
+
+        //
+        //  The reading side calls this when there's nothing more to load, so that
+        //  the workers will exit once they've claimed all of the jobs.
+        //
+        tCIDLib::TVoid NoMoreJobs(TPipeInfo& pipeInfo)
+        {
+            TCritSecLocker lockSync(&pipeInfo.crsSync);
+            pipeInfo.bNoMore = kCIDLib::True;
+            pipeInfo.evLoaded.Trigger();
+        }
+
+
+        //
+        //  Workers call this to get the next job to process. They wait until one
+        //  is available. Returns null if there are no more or we were aborted.
+        //  Any that failed while being loaded are skipped.
+        //
+        TPackJob* pjobNextJob(TPipeInfo& pipeInfo)
+        {
+            while (kCIDLib::True)
+            {
+                {
+                    TCritSecLocker lockSync(&pipeInfo.crsSync);
+                    if (pipeInfo.bAbort)
+                        return nullptr;
+
+                    while (pipeInfo.c4Claimed < pipeInfo.c4Loaded)
+                    {
+                        TPackJob& jobRet = pipeInfo.objaJobs[pipeInfo.c4Claimed % pipeInfo.c4Slots];
+                        pipeInfo.c4Claimed++;
+                        if (!jobRet.bDone)
+                            return &jobRet;
+                    }
+
+                    if (pipeInfo.bNoMore)
+                        return nullptr;
+                    pipeInfo.evLoaded.Reset();
+                }
+                pipeInfo.evLoaded.bWaitFor(c4WaitMSs);
+            }
+        }
+
+
+        //
+        //  Release any jobs, in order, that are done, so that their slots can be
+        //  reused. If one failed, we abort the pipe, store the error and stop.
+        //  The lock must be held by the caller.
+        //
+        tCIDLib::TVoid ReleaseDone(TPipeInfo& pipeInfo)
+        {
+            while (pipeInfo.c4Released < pipeInfo.c4Loaded)
+            {
+                TPackJob& jobCur = pipeInfo.objaJobs[pipeInfo.c4Released % pipeInfo.c4Slots];
+                if (!jobCur.bDone)
+                    break;
+
+                if (jobCur.bFailed)
+                {
+                    if (!pipeInfo.bAbort)
+                    {
+                        pipeInfo.errFailure = jobCur.errFailure;
+                        pipeInfo.strFailed = jobCur.strRelPath;
+                        pipeInfo.bAbort = kCIDLib::True;
+                        pipeInfo.evLoaded.Trigger();
+                        pipeInfo.evDone.Trigger();
+                    }
+                    break;
+                }
+
+                pipeInfo.c8InFlight -= jobCur.c8Bytes;
+                pipeInfo.c4Released++;
+                pipeInfo.evFreed.Trigger();
+            }
+        }
+
+
+        //
+        //  Workers call this when they finish a job. If asked, we also release
+        //  any done jobs, which is how it's done for extraction, since there's no
+        //  ordered writer in that case.
+        //
+        tCIDLib::TVoid JobDone(         TPipeInfo&          pipeInfo
+                                ,       TPackJob&           jobDone
+                                , const tCIDLib::TBoolean   bRelease)
+        {
+            TCritSecLocker lockSync(&pipeInfo.crsSync);
+            jobDone.bDone = kCIDLib::True;
+            if (bRelease)
+                ReleaseDone(pipeInfo);
+            pipeInfo.evDone.Trigger();
+        }
+
+
+        //
+        //  Throw the failure stored in a job or the pipe. If a worker got some
+        //  unknown exception, there's no error info, so we throw our own.
+        //
+        [[noreturn]] tCIDLib::TVoid ThrowFailure(TError& errFailure, const TString& strFile)
+        {
+            if (!errFailure.errcId())
+            {
+                facCIDPack().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kPackErrs::errcDbg_WorkerFailed
+                    , strFile
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::Unknown
+                );
+            }
+            errFailure.AddStackLevel(CID_FILE, CID_LINE);
+            throw errFailure;
+        }
+
+
+        //
+        //  Shut down the pipe threads. If aborting, we tell them to stop where
+        //  they are, else they should already be on their way out.
+        //
+        tCIDLib::TVoid StopPipe(        TPipeInfo&          pipeInfo
+                                ,       TRefVector<TThread>& colThreads
+                                , const tCIDLib::TBoolean   bAbort)
+        {
+            {
+                TCritSecLocker lockSync(&pipeInfo.crsSync);
+                if (bAbort)
+                    pipeInfo.bAbort = kCIDLib::True;
+                pipeInfo.bNoMore = kCIDLib::True;
+                pipeInfo.evDone.Trigger();
+                pipeInfo.evFreed.Trigger();
+                pipeInfo.evLoaded.Trigger();
+            }
+
+            const tCIDLib::TCard4 c4Count = colThreads.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                if (colThreads[c4Index]->bIsRunning())
+                    colThreads[c4Index]->eWaitForDeath();
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The packing reader thread. It reads in the files, in order, and queues
+        //  them up for the workers. If a read fails, the job is marked failed and
+        //  we stop, and the writer will throw when it gets to that one.
+        // -----------------------------------------------------------------------
+        tCIDLib::EExitCodes ePackReadThread(TThread& thrThis, tCIDLib::TVoid* pData)
+        {
+            TPipeInfo& pipeInfo = *static_cast<TPipeInfo*>(pData);
+
+            // Let the calling thread go
+            thrThis.Sync();
+
+            const TRefVector<const TFindBuf>& colFiles = *pipeInfo.pcolFiles;
+            const tCIDLib::TCard4 c4Count = colFiles.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                const TFindBuf& fndbCur = *colFiles[c4Index];
+                const tCIDLib::TCard4 c4OrgSz(tCIDLib::TCard4(fndbCur.c8Size()));
+
+                TPackJob* pjobCur = pjobWaitForSlot(pipeInfo, c4OrgSz);
+                if (!pjobCur)
+                    break;
+
+                try
+                {
+                    pjobCur->c4OrgSz = c4OrgSz;
+                    pjobCur->pathFile = fndbCur.pathFileName();
+                    SizeBuf(pjobCur->mbufOrg, c4OrgSz);
+
+                    TBinaryFile bflSrc(pjobCur->pathFile);
+                    bflSrc.Open
+                    (
+                        tCIDLib::EAccessModes::Read
+                        , tCIDLib::ECreateActs::OpenIfExists
+                        , tCIDLib::EFilePerms::Default
+                        , tCIDLib::EFileFlags::SequentialScan
+                    );
+                    bflSrc.c4ReadBuffer
+                    (
+                        pjobCur->mbufOrg, c4OrgSz, tCIDLib::EAllData::FailIfNotAll
+                    );
+                }
+
+                catch(TError& errToCatch)
+                {
+                    pjobCur->errFailure = errToCatch;
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                catch(...)
+                {
+                    pjobCur->errFailure = TError();
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                QueueJob(pipeInfo, *pjobCur);
+                if (pjobCur->bFailed)
+                    break;
+            }
+
+            NoMoreJobs(pipeInfo);
+            return tCIDLib::EExitCodes::Normal;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The packing worker thread. For each job, we hash the data and then
+        //  compress it. As with serial packing, if ZLib chokes on already
+        //  compressed data, we just store it as is.
+        // -----------------------------------------------------------------------
+        tCIDLib::EExitCodes ePackWorkThread(TThread& thrThis, tCIDLib::TVoid* pData)
+        {
+            TPipeInfo& pipeInfo = *static_cast<TPipeInfo*>(pData);
+
+            // Let the calling thread go
+            thrThis.Sync();
+
+            TMessageDigest5         mdigHasher;
+            TZLibCompressor         zlibComp;
+            TChunkedBinOutStream    strmComp((1024 * 1024) * 200);
+
+            TPackJob* pjobCur = nullptr;
+            while ((pjobCur = pjobNextJob(pipeInfo)) != nullptr)
+            {
+                try
+                {
+                    const tCIDLib::TCard4 c4OrgSz = pjobCur->c4OrgSz;
+
+                    mdigHasher.StartNew();
+                    mdigHasher.DigestBuf(pjobCur->mbufOrg, c4OrgSz);
+                    mdigHasher.Complete(pjobCur->mhashOrg);
+
+                    TBinMBufInStream strmSrc(&pjobCur->mbufOrg, c4OrgSz);
+                    strmComp.Reset();
+                    tCIDLib::TCard4 c4CompSz = 0;
+                    try
+                    {
+                        c4CompSz = zlibComp.c4Compress(strmSrc, strmComp);
+                    }
+
+                    catch(TError& errToCatch)
+                    {
+                        if (!errToCatch.bCheckEvent(facCIDZLib().strName()
+                                                    , kZLibErrs::errcDbg_NegBlockStart))
+                        {
+                            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                            throw;
+                        }
+                        c4CompSz = c4OrgSz;
+                    }
+
+                    // If no reduction, we'll store the original data
+                    if (c4CompSz >= c4OrgSz)
+                    {
+                        c4CompSz = c4OrgSz;
+                    }
+                     else
+                    {
+                        SizeBuf(pjobCur->mbufComp, c4CompSz);
+                        TChunkedBinInStream strmCompSrc(strmComp);
+                        strmCompSrc.c4ReadBuffer(pjobCur->mbufComp, c4CompSz);
+                    }
+                    pjobCur->c4CompSz = c4CompSz;
+                }
+
+                catch(TError& errToCatch)
+                {
+                    pjobCur->errFailure = errToCatch;
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                catch(...)
+                {
+                    pjobCur->errFailure = TError();
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                JobDone(pipeInfo, *pjobCur, kCIDLib::False);
+            }
+            return tCIDLib::EExitCodes::Normal;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The extraction worker thread. For each job, we decompress if needed,
+        //  check the size and hash, and write the file out. The reader has already
+        //  made sure the target directory exists.
+        // -----------------------------------------------------------------------
+        tCIDLib::EExitCodes eExtractWorkThread(TThread& thrThis, tCIDLib::TVoid* pData)
+        {
+            TPipeInfo& pipeInfo = *static_cast<TPipeInfo*>(pData);
+
+            // Let the calling thread go
+            thrThis.Sync();
+
+            TMessageDigest5     mdigHasher;
+            TMD5Hash            mhashOrg;
+            TZLibCompressor     zlibComp;
+
+            TPackJob* pjobCur = nullptr;
+            while ((pjobCur = pjobNextJob(pipeInfo)) != nullptr)
+            {
+                try
+                {
+                    const tCIDLib::TCard4 c4OrgSz = pjobCur->c4OrgSz;
+                    if (pjobCur->c4CompSz != c4OrgSz)
+                    {
+                        SizeBuf(pjobCur->mbufOrg, c4OrgSz);
+                        TBinMBufInStream  strmComp(&pjobCur->mbufComp, pjobCur->c4CompSz);
+                        TBinMBufOutStream strmOrg(&pjobCur->mbufOrg);
+                        if (zlibComp.c4Decompress(strmComp, strmOrg) != c4OrgSz)
+                        {
+                            facCIDPack().ThrowErr
+                            (
+                                CID_FILE
+                                , CID_LINE
+                                , kPackErrs::errcDbg_NotOrgSize
+                                , pjobCur->strRelPath
+                                , tCIDLib::ESeverities::Failed
+                                , tCIDLib::EErrClasses::NotFound
+                            );
+                        }
+                    }
+
+                    mdigHasher.StartNew();
+                    mdigHasher.DigestBuf(pjobCur->mbufOrg, c4OrgSz);
+                    mdigHasher.Complete(mhashOrg);
+                    if (mhashOrg != pjobCur->mhashOrg)
+                    {
+                        facCIDPack().ThrowErr
+                        (
+                            CID_FILE
+                            , CID_LINE
+                            , kPackErrs::errcDbg_BadHash
+                            , pjobCur->strRelPath
+                            , tCIDLib::ESeverities::Failed
+                            , tCIDLib::EErrClasses::Format
+                        );
+                    }
+
+                    TBinFileOutStream strmTar
+                    (
+                        pjobCur->pathFile
+                        , pipeInfo.bOverwrite ? tCIDLib::ECreateActs::CreateAlways
+                                              : tCIDLib::ECreateActs::CreateIfNew
+                        , tCIDLib::EFilePerms::Default
+                        , tCIDLib::EFileFlags::SequentialScan
+                    );
+                    strmTar.c4WriteBuffer(pjobCur->mbufOrg, c4OrgSz);
+                    strmTar.Flush();
+                }
+
+                catch(TError& errToCatch)
+                {
+                    pjobCur->errFailure = errToCatch;
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                catch(...)
+                {
+                    pjobCur->errFailure = TError();
+                    pjobCur->bFailed = kCIDLib::True;
+                }
+
+                JobDone(pipeInfo, *pjobCur, kCIDLib::True);
+            }
+            return tCIDLib::EExitCodes::Normal;
+        }
+    }
+}
+
+
+
 
 // ---------------------------------------------------------------------------
 //   CLASS: TFacCIDPack
@@ -86,7 +638,8 @@ TFacCIDPack::CreatePackage( const   TString&                strTarFile
                             , const TString&                strNotes
                             ,       TTextOutStream* const   pstrmStatus
                             ,       tCIDLib::TCard4&        c4SoFar
-                            , const tCIDLib::TBoolean       bVerbose)
+                            , const tCIDLib::TBoolean       bVerbose
+                            , const tCIDLib::TCard4         c4MaxWorkers)
 {
     // The target file cannot be within the source tree
     if (strTarFile.bStartsWithI(strSrcPath))
@@ -144,24 +697,36 @@ TFacCIDPack::CreatePackage( const   TString&                strTarFile
 
     //
     //  Now let's iterate the files and process them. The order doesn't really
-    //  matter, but it'll do a simple in order iteration.
+    //  matter, but it'll do a simple in order iteration. If we have more than
+    //  one worker, we do it in parallel, else we just do them one at a time.
     //
-    TMessageDigest5         mdigHasher;
-    TZLibCompressor         zlibComp;
-    TChunkedBinOutStream    strmComp((1024 * 1024) * 200);
+    const tCIDLib::TCard4 c4Workers = CIDPack_ThisFacility::c4WorkerCount(c4MaxWorkers);
+    if ((c4Workers > 1) && (c4FileCount > 1))
+    {
+        PackFilesPar
+        (
+            strmTar, fndbTreeTop, strSrcPath, c4Workers, pstrmStatus, c4SoFar, bVerbose
+        );
+    }
+     else
+    {
+        TMessageDigest5         mdigHasher;
+        TZLibCompressor         zlibComp;
+        TChunkedBinOutStream    strmComp((1024 * 1024) * 200);
 
-    PackFiles
-    (
-        strmTar
-        , fndbTreeTop
-        , strSrcPath
-        , mdigHasher
-        , zlibComp
-        , strmComp
-        , pstrmStatus
-        , c4SoFar
-        , bVerbose
-    );
+        PackFiles
+        (
+            strmTar
+            , fndbTreeTop
+            , strSrcPath
+            , mdigHasher
+            , zlibComp
+            , strmComp
+            , pstrmStatus
+            , c4SoFar
+            , bVerbose
+        );
+    }
 
     // Flush the output stream and we are done
     strmTar.Flush();
@@ -230,7 +795,8 @@ TFacCIDPack::ExtractPackage(const   TString&                strSrcFile
                             ,       tCIDLib::TCard4&        c4TotalFiles
                             ,       TTextOutStream* const   pstrmStatus
                             ,       tCIDLib::TCard4&        c4SoFar
-                            , const tCIDLib::TBoolean       bVerbose)
+                            , const tCIDLib::TBoolean       bVerbose
+                            , const tCIDLib::TCard4         c4MaxWorkers)
 {
     c4SoFar = 0;
 
@@ -271,6 +837,23 @@ TFacCIDPack::ExtractPackage(const   TString&                strSrcFile
     c4TotalFiles = pkhdrLoad.c4FileCount();
     strNotes = pkhdrLoad.strUser();
 
+    // If we have more than one worker, do it in parallel
+    const tCIDLib::TCard4 c4Workers = CIDPack_ThisFacility::c4WorkerCount(c4MaxWorkers);
+    if ((c4Workers > 1) && (c4TotalFiles > 1))
+    {
+        ExtractFilesPar
+        (
+            strmSrc
+            , strTarPath
+            , bOverwrite
+            , c4TotalFiles
+            , c4Workers
+            , pstrmStatus
+            , c4SoFar
+            , bVerbose
+        );
+        return;
+    }
 
     // For all of the reported files, let's process them
     TPathStr            pathDir;
@@ -399,25 +982,181 @@ TFacCIDPack::CountFiles(const TFindBuf& fndbCurDir, tCIDLib::TCard4& c4ToSet)
 
 
 //
-//  Package a single file. We iterate the directory tree and for each file :
+//  This is called for parallel extraction, after the main header has been read.
+//  We read in each file's header and data, make sure its target directory exists,
+//  and queue it up for the workers, which decompress, check and write out the
+//  files. Since they can complete out of order, the file count we give back is
+//  just those that have been completed in order.
 //
-//  1.  Insure it's under the src path and remove the source path from it
-//      so that we store the relative path
-//  2.  Read in the file contents, and hash it
-//  3.  Compress it to a local buffer
-//  4.  Create the file header and write it out
-//  5.  Write out the compressed data.
+//  If any of them fail, the pipe is aborted and we throw the error once the
+//  threads are all stopped.
 //
 tCIDLib::TVoid
-TFacCIDPack::PackFile(          TBinOutStream&          strmTar
-                        , const TFindBuf&               fndbFile
+TFacCIDPack::ExtractFilesPar(       TBinInStream&           strmSrc
+                            , const TString&                strTarPath
+                            , const tCIDLib::TBoolean       bOverwrite
+                            , const tCIDLib::TCard4         c4TotalFiles
+                            , const tCIDLib::TCard4         c4Workers
+                            ,       TTextOutStream* const   pstrmStatus
+                            ,       tCIDLib::TCard4&        c4SoFar
+                            , const tCIDLib::TBoolean       bVerbose)
+{
+    CIDPack_ThisFacility::TPipeInfo pipeInfo(c4Workers * 2);
+    pipeInfo.bOverwrite = bOverwrite;
+
+    TRefVector<TThread> colThreads(tCIDLib::EAdoptOpts::Adopt, c4Workers);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Workers; c4Index++)
+    {
+        colThreads.Add
+        (
+            new TThread
+            (
+                facCIDLib().strNextThreadName(TString(L"CIDPackExtract"))
+                , CIDPack_ThisFacility::eExtractWorkThread
+            )
+        );
+    }
+
+    try
+    {
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Workers; c4Index++)
+            colThreads[c4Index]->Start(&pipeInfo);
+
+        TPathStr        pathDir;
+        TCIDPackFlHdr   pkfhdrCur;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TotalFiles; c4Index++)
+        {
+            // Read in the next file header
+            strmSrc >> pkfhdrCur;
+
+            if (bVerbose && pstrmStatus)
+                *pstrmStatus << L"   " << pkfhdrCur.strRelPath() << kCIDLib::EndLn;
+
+            //
+            //  Wait for a free job. We count both buffers towards the in flight
+            //  data. If we get nothing, a worker failed, so break out.
+            //
+            const tCIDLib::TCard4 c4CompSz = pkfhdrCur.c4CompBytes();
+            const tCIDLib::TCard4 c4OrgSz = pkfhdrCur.c4OrgBytes();
+            CIDPack_ThisFacility::TPackJob* pjobCur = CIDPack_ThisFacility::pjobWaitForSlot
+            (
+                pipeInfo
+                , (c4CompSz == c4OrgSz) ? c4OrgSz : tCIDLib::TCard8(c4CompSz) + c4OrgSz
+            );
+            if (!pjobCur)
+                break;
+
+            pjobCur->c4CompSz = c4CompSz;
+            pjobCur->c4OrgSz = c4OrgSz;
+            pjobCur->mhashOrg = pkfhdrCur.mhashOrg();
+            pjobCur->strRelPath = pkfhdrCur.strRelPath();
+            pjobCur->pathFile = strTarPath;
+            pjobCur->pathFile.AddLevel(pkfhdrCur.strRelPath());
+
+            // If not compressed, read it directly into the original data buffer
+            if (c4CompSz == c4OrgSz)
+            {
+                CIDPack_ThisFacility::SizeBuf(pjobCur->mbufOrg, c4OrgSz);
+                strmSrc.c4ReadBuffer(pjobCur->mbufOrg, c4OrgSz);
+            }
+             else
+            {
+                CIDPack_ThisFacility::SizeBuf(pjobCur->mbufComp, c4CompSz);
+                strmSrc.c4ReadBuffer(pjobCur->mbufComp, c4CompSz);
+            }
+
+            //
+            //  Make sure the path exists. We do it here, so that the workers
+            //  don't race to create the same directories.
+            //
+            pathDir = pjobCur->pathFile;
+            pathDir.bRemoveNameExt();
+            if (!TFileSys::bIsDirectory(pathDir))
+                TFileSys::MakePath(pathDir);
+
+            CIDPack_ThisFacility::QueueJob(pipeInfo, *pjobCur);
+
+            TCritSecLocker lockSync(&pipeInfo.crsSync);
+            c4SoFar = pipeInfo.c4Released;
+        }
+
+        // Let the workers know we are done and wait for them to finish up
+        CIDPack_ThisFacility::NoMoreJobs(pipeInfo);
+        while (kCIDLib::True)
+        {
+            {
+                TCritSecLocker lockSync(&pipeInfo.crsSync);
+                c4SoFar = pipeInfo.c4Released;
+                if (pipeInfo.bAbort || (pipeInfo.c4Released == pipeInfo.c4Loaded))
+                    break;
+                pipeInfo.evFreed.Reset();
+            }
+            pipeInfo.evFreed.bWaitFor(CIDPack_ThisFacility::c4WaitMSs);
+        }
+    }
+
+    catch(TError& errToCatch)
+    {
+        CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::True);
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        throw;
+    }
+
+    catch(...)
+    {
+        CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::True);
+        throw;
+    }
+
+    CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::False);
+
+    // If a worker failed, throw its error
+    if (pipeInfo.bAbort)
+        CIDPack_ThisFacility::ThrowFailure(pipeInfo.errFailure, pipeInfo.strFailed);
+}
+
+
+//
+//  For parallel packing, the reader thread needs the list of files up front, so
+//  we flatten the tree out into a list, in the same order that the serial
+//  version processes them. We get the relative paths at the same time, so that
+//  any bad ones are caught before we start.
+//
+tCIDLib::TVoid
+TFacCIDPack::LoadFileList(  const   TFindBuf&                   fndbCurDir
+                            , const TString&                    strSrcPath
+                            ,       TRefVector<const TFindBuf>& colFiles
+                            ,       tCIDLib::TStrList&          colRelPaths
+                            ,       TTextOutStream* const       pstrmStatus)
+{
+    TPathStr pathRel;
+    TFindBuf::TCursor cursCur = fndbCurDir.cursChildren();
+    for (; cursCur; ++cursCur)
+    {
+        const TFindBuf& fndbCur = *cursCur;
+        if (fndbCur.bIsDirectory())
+        {
+            LoadFileList(fndbCur, strSrcPath, colFiles, colRelPaths, pstrmStatus);
+        }
+         else
+        {
+            MakeRelPath(fndbCur, strSrcPath, pathRel, pstrmStatus);
+            colFiles.Add(&fndbCur);
+            colRelPaths.objAdd(pathRel);
+        }
+    }
+}
+
+
+//
+//  Insure that the file is under the source path and get the part relative to
+//  it, which is what we store in the package.
+//
+tCIDLib::TVoid
+TFacCIDPack::MakeRelPath(const  TFindBuf&               fndbFile
                         , const TString&                strSrcPath
-                        ,       TMessageDigest5&        mdigToUse
-                        ,       TZLibCompressor&        zlibToUse
-                        ,       TChunkedBinOutStream&   strmComp
-                        ,       TTextOutStream* const   pstrmStatus
-                        ,       tCIDLib::TCard4&        c4SoFar
-                        , const tCIDLib::TBoolean       bVerbose)
+                        ,       TPathStr&               pathToFill
+                        ,       TTextOutStream* const   pstrmStatus)
 {
     // The file path must be under the source path
     if (!fndbFile.pathFileName().bStartsWithI(strSrcPath))
@@ -440,11 +1179,11 @@ TFacCIDPack::PackFile(          TBinOutStream&          strmTar
         );
     }
 
-    TPathStr pathRel(fndbFile.pathFileName());
-    pathRel.Cut(0, strSrcPath.c4Length());
+    pathToFill = fndbFile.pathFileName();
+    pathToFill.Cut(0, strSrcPath.c4Length());
 
     // Make sure it didn't end up empty
-    if (pathRel.bIsEmpty())
+    if (pathToFill.bIsEmpty())
     {
         if (pstrmStatus)
         {
@@ -465,8 +1204,34 @@ TFacCIDPack::PackFile(          TBinOutStream&          strmTar
     }
 
     // And remove any leading slash
-    if (pathRel.chFirst() == kCIDLib::chBackSlash)
-        pathRel.Cut(0, 1);
+    if (pathToFill.chFirst() == kCIDLib::chBackSlash)
+        pathToFill.Cut(0, 1);
+}
+
+
+//
+//  Package a single file. We iterate the directory tree and for each file :
+//
+//  1.  Insure it's under the src path and remove the source path from it
+//      so that we store the relative path
+//  2.  Read in the file contents, and hash it
+//  3.  Compress it to a local buffer
+//  4.  Create the file header and write it out
+//  5.  Write out the compressed data.
+//
+tCIDLib::TVoid
+TFacCIDPack::PackFile(          TBinOutStream&          strmTar
+                        , const TFindBuf&               fndbFile
+                        , const TString&                strSrcPath
+                        ,       TMessageDigest5&        mdigToUse
+                        ,       TZLibCompressor&        zlibToUse
+                        ,       TChunkedBinOutStream&   strmComp
+                        ,       TTextOutStream* const   pstrmStatus
+                        ,       tCIDLib::TCard4&        c4SoFar
+                        , const tCIDLib::TBoolean       bVerbose)
+{
+    TPathStr pathRel;
+    MakeRelPath(fndbFile, strSrcPath, pathRel, pstrmStatus);
 
     const tCIDLib::TCard4 c4OrgSz(tCIDLib::TCard4(fndbFile.c8Size()));
 
@@ -543,20 +1308,12 @@ TFacCIDPack::PackFile(          TBinOutStream&          strmTar
     }
      else
     {
-        tCIDLib::TCard4 c4Percent
-        (
-            tCIDLib::TCard4
-            (
-                (1.0 - (tCIDLib::TFloat4(c4CompSz) / tCIDLib::TFloat4(c4OrgSz))) * 100.0
-            )
-        );
-
-        // It's never 100%, but rounding may make it that, so adjust
-        if (c4Percent >= 100)
-            c4Percent = 99;
-
         if (bVerbose && pstrmStatus)
-            *pstrmStatus << L"(" << c4Percent << L"% reduced)";
+        {
+            *pstrmStatus    << L"("
+                            << CIDPack_ThisFacility::c4ReducedPercent(c4CompSz, c4OrgSz)
+                            << L"% reduced)";
+        }
     }
 
     if (bVerbose && pstrmStatus)
@@ -650,3 +1407,131 @@ TFacCIDPack::PackFiles(         TBinOutStream&          strmTar
 }
 
 
+//
+//  The parallel version of PackFiles. We flatten the tree into a list, then start
+//  up a reader thread that loads the files and a set of workers that hash and
+//  compress them. We act as the writer, taking them in the original order as they
+//  complete, so the package comes out the same as when done serially.
+//
+tCIDLib::TVoid
+TFacCIDPack::PackFilesPar(          TBinOutStream&          strmTar
+                            , const TFindBuf&               fndbTreeTop
+                            , const TString&                strSrcPath
+                            , const tCIDLib::TCard4         c4Workers
+                            ,       TTextOutStream* const   pstrmStatus
+                            ,       tCIDLib::TCard4&        c4SoFar
+                            , const tCIDLib::TBoolean       bVerbose)
+{
+    TRefVector<const TFindBuf> colFiles(tCIDLib::EAdoptOpts::NoAdopt);
+    tCIDLib::TStrList colRelPaths;
+    LoadFileList(fndbTreeTop, strSrcPath, colFiles, colRelPaths, pstrmStatus);
+
+    CIDPack_ThisFacility::TPipeInfo pipeInfo(c4Workers * 2);
+    pipeInfo.pcolFiles = &colFiles;
+
+    // We need the reader, then the workers
+    TRefVector<TThread> colThreads(tCIDLib::EAdoptOpts::Adopt, c4Workers + 1);
+    colThreads.Add
+    (
+        new TThread
+        (
+            facCIDLib().strNextThreadName(TString(L"CIDPackRead"))
+            , CIDPack_ThisFacility::ePackReadThread
+        )
+    );
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Workers; c4Index++)
+    {
+        colThreads.Add
+        (
+            new TThread
+            (
+                facCIDLib().strNextThreadName(TString(L"CIDPackComp"))
+                , CIDPack_ThisFacility::ePackWorkThread
+            )
+        );
+    }
+
+    c4SoFar = 0;
+    try
+    {
+        const tCIDLib::TCard4 c4ThreadCnt = colThreads.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThreadCnt; c4Index++)
+            colThreads[c4Index]->Start(&pipeInfo);
+
+        const tCIDLib::TCard4 c4Count = colFiles.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            CIDPack_ThisFacility::TPackJob& jobCur
+            (
+                pipeInfo.objaJobs[c4Index % pipeInfo.c4Slots]
+            );
+
+            // Wait for this one to be loaded and processed
+            while (kCIDLib::True)
+            {
+                {
+                    TCritSecLocker lockSync(&pipeInfo.crsSync);
+                    if ((c4Index < pipeInfo.c4Loaded) && jobCur.bDone)
+                        break;
+                    pipeInfo.evDone.Reset();
+                }
+                pipeInfo.evDone.bWaitFor(CIDPack_ThisFacility::c4WaitMSs);
+            }
+
+            const TString& strRelPath = colRelPaths[c4Index];
+            if (jobCur.bFailed)
+                CIDPack_ThisFacility::ThrowFailure(jobCur.errFailure, strRelPath);
+
+            const tCIDLib::TCard4 c4CompSz = jobCur.c4CompSz;
+            const tCIDLib::TCard4 c4OrgSz = jobCur.c4OrgSz;
+            if (bVerbose && pstrmStatus)
+            {
+                *pstrmStatus    << facCIDPack().strMsg(kPackMsgs::midStatus_FileStart)
+                                << strRelPath << L" ... ";
+                if (c4CompSz == c4OrgSz)
+                {
+                    *pstrmStatus << L"(no reduction)";
+                }
+                 else
+                {
+                    *pstrmStatus    << L"("
+                                    << CIDPack_ThisFacility::c4ReducedPercent(c4CompSz, c4OrgSz)
+                                    << L"% reduced)";
+                }
+                *pstrmStatus << kCIDLib::EndLn;
+            }
+
+            // Write out the header and the original or compressed data
+            TCIDPackFlHdr pkfhdrNew(c4CompSz, c4OrgSz, jobCur.mhashOrg, strRelPath);
+            strmTar << pkfhdrNew;
+            if (c4CompSz == c4OrgSz)
+                strmTar.c4WriteBuffer(jobCur.mbufOrg, c4OrgSz);
+            else
+                strmTar.c4WriteBuffer(jobCur.mbufComp, c4CompSz);
+
+            // And release the job so the reader can reuse it
+            {
+                TCritSecLocker lockSync(&pipeInfo.crsSync);
+                pipeInfo.c8InFlight -= jobCur.c8Bytes;
+                pipeInfo.c4Released++;
+                pipeInfo.evFreed.Trigger();
+            }
+            c4SoFar++;
+        }
+    }
+
+    catch(TError& errToCatch)
+    {
+        CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::True);
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        throw;
+    }
+
+    catch(...)
+    {
+        CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::True);
+        throw;
+    }
+
+    CIDPack_ThisFacility::StopPipe(pipeInfo, colThreads, kCIDLib::False);
+}
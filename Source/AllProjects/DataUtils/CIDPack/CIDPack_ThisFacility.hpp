@@ -65,6 +65,7 @@ class CIDPACKEXP TFacCIDPack : public TFacility
             ,       TTextOutStream* const   pstrmStatus
             ,       tCIDLib::TCard4&        c4SoFar
             , const tCIDLib::TBoolean       bVerbose
+            , const tCIDLib::TCard4         c4MaxWorkers = 0
         );
 
         tCIDLib::TVoid ExtractDetails
@@ -88,6 +89,7 @@ class CIDPACKEXP TFacCIDPack : public TFacility
             ,       TTextOutStream* const   pstrmStatus
             ,       tCIDLib::TCard4&        c4SoFar
             , const tCIDLib::TBoolean       bVerbose
+            , const tCIDLib::TCard4         c4MaxWorkers = 0
         );
 
 
@@ -108,6 +110,35 @@ class CIDPACKEXP TFacCIDPack : public TFacility
             ,       tCIDLib::TCard4&        c4ToSet
         );
 
+        tCIDLib::TVoid ExtractFilesPar
+        (
+                    TBinInStream&           strmSrc
+            , const TString&                strTarPath
+            , const tCIDLib::TBoolean       bOverwrite
+            , const tCIDLib::TCard4         c4TotalFiles
+            , const tCIDLib::TCard4         c4Workers
+            ,       TTextOutStream* const   pstrmStatus
+            ,       tCIDLib::TCard4&        c4SoFar
+            , const tCIDLib::TBoolean       bVerbose
+        );
+
+        tCIDLib::TVoid LoadFileList
+        (
+            const   TFindBuf&               fndbCurDir
+            , const TString&                strSrcPath
+            ,       TRefVector<const TFindBuf>& colFiles
+            ,       tCIDLib::TStrList&      colRelPaths
+            ,       TTextOutStream* const   pstrmStatus
+        );
+
+        tCIDLib::TVoid MakeRelPath
+        (
+            const   TFindBuf&               fndbFile
+            , const TString&                strSrcPath
+            ,       TPathStr&               pathToFill
+            ,       TTextOutStream* const   pstrmStatus
+        );
+
         tCIDLib::TVoid PackFile
         (
                     TBinOutStream&          strmTar
@@ -134,6 +165,17 @@ class CIDPACKEXP TFacCIDPack : public TFacility
             , const tCIDLib::TBoolean       bVerbose
         );
 
+        tCIDLib::TVoid PackFilesPar
+        (
+                    TBinOutStream&          strmTar
+            , const TFindBuf&               fndbTreeTop
+            , const TString&                strSrcPath
+            , const tCIDLib::TCard4         c4Workers
+            ,       TTextOutStream* const   pstrmStatus
+            ,       tCIDLib::TCard4&        c4SoFar
+            , const tCIDLib::TBoolean       bVerbose
+        );
+
 
         // -------------------------------------------------------------------
         //  Do any needed magic macros
@@ -55,6 +55,7 @@
 #include    "CIDRegX_ThisFacility.hpp"
 #include    "CIDRegX_RegExNFA.hpp"
 #include    "CIDRegX_RegExEngine.hpp"
+#include    "CIDRegX_RegExSet.hpp"
 
 
 // ---------------------------------------------------------------------------
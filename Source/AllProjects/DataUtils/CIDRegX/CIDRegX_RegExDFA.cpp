@@ -0,0 +1,624 @@
+//
+// FILE NAME: CIDRegX_RegExDFA.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TRegExDFA class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include "CIDRegX_.hpp"
+#include "CIDRegX_RegExInternal_.hpp"
+#include "CIDRegX_RegExDFA_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TRegExDFA,TObject)
+
+
+namespace
+{
+    namespace CIDRegX_DFA
+    {
+        // -----------------------------------------------------------------------
+        //  Local, const data
+        //
+        //  c4MaxStates
+        //      The most DFA states we'll create per case mode before we give
+        //      up and let the NFA handle it.
+        //
+        //  c4TransCount
+        //      The number of characters we store transitions for in each
+        //      state. Chars at or above this are calculated each time.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxStates = 128;
+        constexpr tCIDLib::TCard4   c4TransCount = 256;
+    }
+}
+
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRegExDFA
+//  PREFIX: rxdfa
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TRegExDFA: Constructors and Destructor
+// ----------------------------------------------------------------------------
+TRegExDFA::TRegExDFA(const TRegExNFA& rxnfaSrc) :
+
+    m_bAccept(kCIDLib::False)
+    , m_c4NFACount(rxnfaSrc.c4StateCount())
+    , m_c4Pass(0)
+    , m_c4SetCount(0)
+    , m_c4StackTop(0)
+    , m_pc4Marks(nullptr)
+    , m_pc4Set(nullptr)
+    , m_pc4Stack(nullptr)
+    , m_rxnfaSrc(rxnfaSrc)
+{
+    m_pc4Marks = new tCIDLib::TCard4[m_c4NFACount];
+    TRawMem::SetMemBuf(m_pc4Marks, tCIDLib::TCard4(0), m_c4NFACount);
+    m_pc4Set = new tCIDLib::TCard4[m_c4NFACount];
+    m_pc4Stack = new tCIDLib::TCard4[m_c4NFACount];
+
+    InitCache(m_cacheCase, kCIDLib::True);
+    InitCache(m_cacheNoCase, kCIDLib::False);
+
+    // And get the prefilter literals out of the NFA
+    FindLiterals();
+}
+
+TRegExDFA::~TRegExDFA()
+{
+    TStateCache* apcacheList[2] = { &m_cacheCase, &m_cacheNoCase };
+    for (tCIDLib::TCard4 c4CacheInd = 0; c4CacheInd < 2; c4CacheInd++)
+    {
+        TStateCache& cacheCur = *apcacheList[c4CacheInd];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < cacheCur.c4StateCount; c4Index++)
+            delete [] cacheCur.pdstList[c4Index].pc4Trans;
+        delete [] cacheCur.pdstList;
+        cacheCur.pdstList = nullptr;
+    }
+
+    delete [] m_pc4Marks;
+    m_pc4Marks = nullptr;
+    delete [] m_pc4Set;
+    m_pc4Set = nullptr;
+    delete [] m_pc4Stack;
+    m_pc4Stack = nullptr;
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRegExDFA: Public, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  If we have a required literal, any match has to contain it, so if it's not
+//  in the input from the start position on, there cannot be a match.
+//
+tCIDLib::TBoolean
+TRegExDFA::bMightMatch( const   tCIDLib::TCh* const pszToSearch
+                        , const tCIDLib::TCard4     c4StartAt
+                        , const tCIDLib::TBoolean   bCaseSensitive) const
+{
+    if (m_strRequired.bIsEmpty())
+        return kCIDLib::True;
+
+    return TRawStr::pszFindSubStr
+    (
+        pszToSearch, m_strRequired.pszBuffer(), c4StartAt, bCaseSensitive
+    ) != nullptr;
+}
+
+
+//
+//  This does the same thing as the NFA search in TRegEx, i.e. at each start
+//  position it looks for the longest match, and returns the first non-empty
+//  one found. The caller has already checked the parameters.
+//
+TRegExDFA::ERes
+TRegExDFA::eFindMatch(  const   tCIDLib::TCh* const pszFindIn
+                        , const tCIDLib::TCard4     c4SearchLen
+                        , const tCIDLib::TCard4     c4StartAt
+                        , const tCIDLib::TBoolean   bOnlyAtStart
+                        , const tCIDLib::TBoolean   bCaseSensitive
+                        ,       tCIDLib::TCard4&    c4Ofs
+                        ,       tCIDLib::TCard4&    c4Len)
+{
+    TCritSecLocker crslSync(&m_crsSync);
+
+    TStateCache& cacheTar = bCaseSensitive ? m_cacheCase : m_cacheNoCase;
+    if (cacheTar.bOverflowed)
+        return ERes::Overflow;
+
+    const tCIDLib::TCard4 c4Start = c4StartState(cacheTar);
+    if (c4Start == kCIDLib::c4MaxCard)
+        return ERes::Overflow;
+
+    //
+    //  If we have a prefix, and we can move forward, we can skip right to the
+    //  next spot where the prefix is found, and not bother running the DFA
+    //  anywhere else.
+    //
+    const tCIDLib::TBoolean bSkipAhead = !bOnlyAtStart && !m_strPrefix.bIsEmpty();
+
+    tCIDLib::TCard4 c4MatchAt = c4StartAt;
+    while (c4MatchAt < c4SearchLen)
+    {
+        if (bSkipAhead)
+        {
+            const tCIDLib::TCh* pszNext = TRawStr::pszFindChar
+            (
+                pszFindIn, m_strPrefix[0], c4MatchAt, bCaseSensitive
+            );
+            if (!pszNext)
+                break;
+
+            c4MatchAt = tCIDLib::TCard4(pszNext - pszFindIn);
+            if (!bPrefixAt(pszNext, bCaseSensitive))
+            {
+                c4MatchAt++;
+                continue;
+            }
+        }
+
+        //
+        //  Run the DFA from here till it dies or we hit the end, remembering
+        //  the last place we hit the end of the pattern. We go one past the
+        //  end, to let the 'at end' matcher see the end.
+        //
+        tCIDLib::TCard4 c4LastMatch = kCIDLib::c4MaxCard;
+        tCIDLib::TCard4 c4CurState = c4Start;
+        if (cacheTar.pdstList[c4CurState].bAccept)
+            c4LastMatch = c4MatchAt;
+
+        for (tCIDLib::TCard4 c4Index = c4MatchAt; c4Index <= c4SearchLen; c4Index++)
+        {
+            c4CurState = c4NextState(cacheTar, c4CurState, pszFindIn, c4Index, c4SearchLen);
+            if (c4CurState == kCIDLib::c4MaxCard)
+                return ERes::Overflow;
+
+            // If we hit the dead state, no point going further
+            if (!c4CurState)
+                break;
+
+            if (cacheTar.pdstList[c4CurState].bAccept)
+                c4LastMatch = c4Index + 1;
+        }
+
+        //
+        //  As with the NFA, the 'at end' matcher can take us one past the
+        //  end, so clip it back. And we don't report zero length matches.
+        //
+        if (c4LastMatch != kCIDLib::c4MaxCard)
+        {
+            if (c4LastMatch > c4SearchLen)
+                c4LastMatch = c4SearchLen;
+
+            if (c4LastMatch > c4MatchAt)
+            {
+                c4Ofs = c4MatchAt;
+                c4Len = c4LastMatch - c4MatchAt;
+                return ERes::Match;
+            }
+        }
+
+        if (bOnlyAtStart)
+            break;
+        c4MatchAt++;
+    }
+    return ERes::NoMatch;
+}
+
+
+//
+//  We run the DFA across the whole input. If we have hit the end of the pattern
+//  at the end of the input, it matches. If not, we let the states see the end
+//  of the input, in case it's an 'at end' matcher.
+//
+TRegExDFA::ERes
+TRegExDFA::eFullyMatches(const  tCIDLib::TCh* const pszToTest
+                        , const tCIDLib::TCard4     c4SearchLen
+                        , const tCIDLib::TBoolean   bCaseSensitive)
+{
+    TCritSecLocker crslSync(&m_crsSync);
+
+    TStateCache& cacheTar = bCaseSensitive ? m_cacheCase : m_cacheNoCase;
+    if (cacheTar.bOverflowed)
+        return ERes::Overflow;
+
+    tCIDLib::TCard4 c4CurState = c4StartState(cacheTar);
+    if (c4CurState == kCIDLib::c4MaxCard)
+        return ERes::Overflow;
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SearchLen; c4Index++)
+    {
+        c4CurState = c4NextState(cacheTar, c4CurState, pszToTest, c4Index, c4SearchLen);
+        if (c4CurState == kCIDLib::c4MaxCard)
+            return ERes::Overflow;
+
+        if (!c4CurState)
+            return ERes::NoMatch;
+    }
+
+    if (cacheTar.pdstList[c4CurState].bAccept)
+        return ERes::Match;
+
+    c4CurState = c4NextState(cacheTar, c4CurState, pszToTest, c4SearchLen, c4SearchLen);
+    if (c4CurState == kCIDLib::c4MaxCard)
+        return ERes::Overflow;
+
+    return cacheTar.pdstList[c4CurState].bAccept ? ERes::Match : ERes::NoMatch;
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRegExDFA: Private, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  Push a target state on the work stack if not already seen in this pass.
+//  State zero, as a target, means the end of the pattern.
+//
+tCIDLib::TVoid TRegExDFA::AddTarget(const tCIDLib::TCard4 c4Target)
+{
+    if (!c4Target)
+    {
+        m_bAccept = kCIDLib::True;
+    }
+     else if (m_pc4Marks[c4Target] != m_c4Pass)
+    {
+        m_pc4Marks[c4Target] = m_c4Pass;
+        m_pc4Stack[m_c4StackTop++] = c4Target;
+    }
+}
+
+
+//
+//  Sees if every path through the NFA goes through the indicated state. We
+//  mark it up front, so it never gets pushed, and see if we can still get to
+//  the end.
+//
+tCIDLib::TBoolean TRegExDFA::bIsRequired(const tCIDLib::TCard4 c4ToCheck)
+{
+    NewPass();
+    m_pc4Marks[c4ToCheck] = m_c4Pass;
+
+    AddTarget(m_rxnfaSrc.c4State1At(0));
+    while (m_c4StackTop && !m_bAccept)
+    {
+        const tCIDLib::TCard4 c4Cur = m_pc4Stack[--m_c4StackTop];
+        const tCIDLib::TCard4 c41 = m_rxnfaSrc.c4State1At(c4Cur);
+        const tCIDLib::TCard4 c42 = m_rxnfaSrc.c4State2At(c4Cur);
+
+        AddTarget(c41);
+        if (c42 != c41)
+            AddTarget(c42);
+    }
+    return !m_bAccept;
+}
+
+
+// Checks whether our prefix is at the passed location
+tCIDLib::TBoolean
+TRegExDFA::bPrefixAt(const  tCIDLib::TCh* const pszToCheck
+                    , const tCIDLib::TBoolean   bCaseSensitive) const
+{
+    const tCIDLib::TCh* pszPrefix = m_strPrefix.pszBuffer();
+    const tCIDLib::TCh* pszCur = pszToCheck;
+    if (bCaseSensitive)
+    {
+        while (*pszPrefix)
+        {
+            if (*pszCur++ != *pszPrefix++)
+                return kCIDLib::False;
+        }
+    }
+     else
+    {
+        while (*pszPrefix)
+        {
+            if (TRawStr::chUpper(*pszCur++) != TRawStr::chUpper(*pszPrefix++))
+                return kCIDLib::False;
+        }
+    }
+    return kCIDLib::True;
+}
+
+
+//
+//  Looks for a state for the set left by the last CloseOver() call. If not found,
+//  we add one, if we have room. If not, we mark the cache as overflowed and
+//  return c4MaxCard.
+//
+tCIDLib::TCard4 TRegExDFA::c4AddOrFindState(TStateCache& cacheTar)
+{
+    tCIDLib::TCard4 c4Hash = m_bAccept ? 1 : 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4SetCount; c4Index++)
+        c4Hash = (c4Hash * 31) + m_pc4Set[c4Index];
+
+    const tCIDLib::TCard4* pc4Sets = cacheTar.fcolSets.ptElements();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < cacheTar.c4StateCount; c4Index++)
+    {
+        const TDState& dstCur = cacheTar.pdstList[c4Index];
+        if ((dstCur.c4Hash != c4Hash)
+        ||  (dstCur.bAccept != m_bAccept)
+        ||  (dstCur.c4SetCount != m_c4SetCount))
+        {
+            continue;
+        }
+
+        if (!m_c4SetCount
+        ||  TRawMem::bCompareMemBuf(&pc4Sets[dstCur.c4SetOfs]
+                                    , m_pc4Set
+                                    , m_c4SetCount * sizeof(tCIDLib::TCard4)))
+        {
+            return c4Index;
+        }
+    }
+
+    if (cacheTar.c4StateCount >= CIDRegX_DFA::c4MaxStates)
+    {
+        cacheTar.bOverflowed = kCIDLib::True;
+        return kCIDLib::c4MaxCard;
+    }
+
+    TDState& dstNew = cacheTar.pdstList[cacheTar.c4StateCount];
+    dstNew.bAccept = m_bAccept;
+    dstNew.c4Hash = c4Hash;
+    dstNew.c4SetOfs = cacheTar.fcolSets.c4ElemCount();
+    dstNew.c4SetCount = m_c4SetCount;
+    dstNew.pc4Trans = new tCIDLib::TCard4[CIDRegX_DFA::c4TransCount];
+    TRawMem::SetMemBuf(dstNew.pc4Trans, kCIDLib::c4MaxCard, CIDRegX_DFA::c4TransCount);
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4SetCount; c4Index++)
+        cacheTar.fcolSets.c4AddElement(m_pc4Set[c4Index]);
+
+    return cacheTar.c4StateCount++;
+}
+
+
+//
+//  Starting at a literal char state, we follow it as long as it leads to one
+//  other literal char state, and build up the text that represents. We return
+//  the length.
+//
+tCIDLib::TCard4
+TRegExDFA::c4LiteralRun(const tCIDLib::TCard4 c4FirstState, TString& strToFill)
+{
+    strToFill.Clear();
+
+    tCIDLib::TCard4 c4Cur = c4FirstState;
+    for (tCIDLib::TCard4 c4Count = 0; c4Count < m_c4NFACount; c4Count++)
+    {
+        const TRXCharMatcher* pmatchCur = pmatchLiteral(c4Cur);
+        if (!pmatchCur)
+            break;
+        strToFill.Append(pmatchCur->chToMatch());
+
+        NewPass();
+        const tCIDLib::TCard4 c41 = m_rxnfaSrc.c4State1At(c4Cur);
+        const tCIDLib::TCard4 c42 = m_rxnfaSrc.c4State2At(c4Cur);
+        AddTarget(c41);
+        if (c42 != c41)
+            AddTarget(c42);
+        CloseOver();
+
+        if (m_bAccept || (m_c4SetCount != 1))
+            break;
+        c4Cur = m_pc4Set[0];
+    }
+    return strToFill.c4Length();
+}
+
+
+//
+//  Moves from a state on the input char at the indicated position. If we have
+//  the transition already we just return it. Else we run the NFA states of
+//  the state on the character, and find or add the resulting DFA state. We
+//  don't store transitions at the start or end, see the header comments.
+//
+tCIDLib::TCard4
+TRegExDFA::c4NextState(         TStateCache&        cacheTar
+                        , const tCIDLib::TCard4     c4From
+                        , const tCIDLib::TCh* const pszInput
+                        , const tCIDLib::TCard4     c4At
+                        , const tCIDLib::TCard4     c4SearchLen)
+{
+    const tCIDLib::TCh chCur = pszInput[c4At];
+    const tCIDLib::TCard4 c4Char = tCIDLib::TCard4(chCur);
+    const tCIDLib::TBoolean bCacheable
+    (
+        c4At && (c4At < c4SearchLen) && (c4Char < CIDRegX_DFA::c4TransCount)
+    );
+
+    if (bCacheable)
+    {
+        const tCIDLib::TCard4 c4Ret = cacheTar.pdstList[c4From].pc4Trans[c4Char];
+        if (c4Ret != kCIDLib::c4MaxCard)
+            return c4Ret;
+    }
+
+    NewPass();
+    {
+        const TDState& dstFrom = cacheTar.pdstList[c4From];
+        const tCIDLib::TCard4* pc4Src = cacheTar.fcolSets.ptElements() + dstFrom.c4SetOfs;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < dstFrom.c4SetCount; c4Index++)
+        {
+            const tCIDLib::TCard4 c4NFAState = pc4Src[c4Index];
+            if (m_rxnfaSrc.matchAt(c4NFAState).bMatches(chCur
+                                                        , c4At
+                                                        , c4SearchLen
+                                                        , cacheTar.bCaseSensitive))
+            {
+                const tCIDLib::TCard4 c41 = m_rxnfaSrc.c4State1At(c4NFAState);
+                const tCIDLib::TCard4 c42 = m_rxnfaSrc.c4State2At(c4NFAState);
+                AddTarget(c41);
+                if (c42 != c41)
+                    AddTarget(c42);
+            }
+        }
+    }
+    CloseOver();
+
+    const tCIDLib::TCard4 c4Ret = c4AddOrFindState(cacheTar);
+    if (bCacheable && (c4Ret != kCIDLib::c4MaxCard))
+        cacheTar.pdstList[c4From].pc4Trans[c4Char] = c4Ret;
+    return c4Ret;
+}
+
+
+// Fault in the start state if not done yet
+tCIDLib::TCard4 TRegExDFA::c4StartState(TStateCache& cacheTar)
+{
+    if (cacheTar.c4StartState == kCIDLib::c4MaxCard)
+    {
+        NewPass();
+        AddTarget(m_rxnfaSrc.c4State1At(0));
+        CloseOver();
+        cacheTar.c4StartState = c4AddOrFindState(cacheTar);
+    }
+    return cacheTar.c4StartState;
+}
+
+
+//
+//  Follows all of the epsilon transitions from the states on the work stack,
+//  then puts all of the non-epsilon states marked in this pass into the set
+//  list. Going through the marks in order leaves the set sorted.
+//
+tCIDLib::TVoid TRegExDFA::CloseOver()
+{
+    while (m_c4StackTop)
+    {
+        const tCIDLib::TCard4 c4Cur = m_pc4Stack[--m_c4StackTop];
+        if (m_rxnfaSrc.bIsEpsilonState(c4Cur))
+        {
+            const tCIDLib::TCard4 c41 = m_rxnfaSrc.c4State1At(c4Cur);
+            const tCIDLib::TCard4 c42 = m_rxnfaSrc.c4State2At(c4Cur);
+            AddTarget(c41);
+            if (c42 != c41)
+                AddTarget(c42);
+        }
+    }
+
+    m_c4SetCount = 0;
+    for (tCIDLib::TCard4 c4Index = 1; c4Index < m_c4NFACount; c4Index++)
+    {
+        if ((m_pc4Marks[c4Index] == m_c4Pass) && !m_rxnfaSrc.bIsEpsilonState(c4Index))
+            m_pc4Set[m_c4SetCount++] = c4Index;
+    }
+}
+
+
+//
+//  The prefix is the literal run, if any, that starts from the start state, if
+//  it only leads to a single literal char state. The required literal is the
+//  longest literal run that starts with a state every match must go through.
+//  The prefix is one of those, so it's our starting point.
+//
+tCIDLib::TVoid TRegExDFA::FindLiterals()
+{
+    m_strPrefix.Clear();
+    NewPass();
+    AddTarget(m_rxnfaSrc.c4State1At(0));
+    CloseOver();
+    if (!m_bAccept && (m_c4SetCount == 1))
+        c4LiteralRun(m_pc4Set[0], m_strPrefix);
+
+    m_strRequired = m_strPrefix;
+
+    TString strRun;
+    for (tCIDLib::TCard4 c4Index = 1; c4Index < m_c4NFACount; c4Index++)
+    {
+        if (!pmatchLiteral(c4Index) || !bIsRequired(c4Index))
+            continue;
+
+        if (c4LiteralRun(c4Index, strRun) > m_strRequired.c4Length())
+            m_strRequired = strRun;
+    }
+}
+
+
+//
+//  Set up a cache. We create the dead state, which is the empty set with no
+//  accept, so it always ends up at index zero. All of its transitions are
+//  back to itself.
+//
+tCIDLib::TVoid
+TRegExDFA::InitCache(TStateCache& cacheTar, const tCIDLib::TBoolean bCaseSensitive)
+{
+    cacheTar.bCaseSensitive = bCaseSensitive;
+    cacheTar.bOverflowed = kCIDLib::False;
+    cacheTar.c4StartState = kCIDLib::c4MaxCard;
+    cacheTar.c4StateCount = 0;
+    cacheTar.pdstList = new TDState[CIDRegX_DFA::c4MaxStates];
+
+    NewPass();
+    const tCIDLib::TCard4 c4Dead = c4AddOrFindState(cacheTar);
+    TRawMem::SetMemBuf
+    (
+        cacheTar.pdstList[c4Dead].pc4Trans, c4Dead, CIDRegX_DFA::c4TransCount
+    );
+}
+
+
+//
+//  Start a new pass. Instead of clearing the marks, we just bump the pass
+//  number, and only have to clear them if it wraps.
+//
+tCIDLib::TVoid TRegExDFA::NewPass()
+{
+    m_c4Pass++;
+    if (!m_c4Pass)
+    {
+        TRawMem::SetMemBuf(m_pc4Marks, tCIDLib::TCard4(0), m_c4NFACount);
+        m_c4Pass = 1;
+    }
+    m_bAccept = kCIDLib::False;
+    m_c4SetCount = 0;
+    m_c4StackTop = 0;
+}
+
+
+// If the indicated state is a non-negated single char matcher, return it
+const TRXCharMatcher* TRegExDFA::pmatchLiteral(const tCIDLib::TCard4 c4At) const
+{
+    if (m_rxnfaSrc.bIsEpsilonState(c4At))
+        return nullptr;
+
+    const TRXMatcher& matchCur = m_rxnfaSrc.matchAt(c4At);
+    if (matchCur.clsIsA() != TRXCharMatcher::clsThis())
+        return nullptr;
+
+    const TRXCharMatcher* pmatchRet = static_cast<const TRXCharMatcher*>(&matchCur);
+    if (pmatchRet->bNot())
+        return nullptr;
+    return pmatchRet;
+}
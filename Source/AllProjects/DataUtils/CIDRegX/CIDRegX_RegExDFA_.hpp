@@ -0,0 +1,312 @@
+//
+// FILE NAME: CIDRegX_RegExDFA_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the internal header for the CIDRegX_RegExDFA.cpp file, which
+//  implements the TRegExDFA class. This is a lazily built DFA that sits on top
+//  of a completed TRegExNFA, and which TRegEx uses in preference to running
+//  the NFA directly.
+//
+//  Each DFA state represents the set of (non-epsilon) NFA states that can be
+//  active at some point, plus whether the end of the pattern was reached. We
+//  don't build them up front. We start with the state for the NFA's start
+//  state and, each time we need to move from a state on a character for which
+//  we don't have the transition yet, we run that one step of the NFA and
+//  remember the result. So, after a bit of warm up, each character of input
+//  is just a table lookup. Only transitions for characters under 256 are
+//  stored. Others are calculated each time, though they still result in a
+//  cached state.
+//
+//  The number of states is bounded. If a pattern needs more than that, the
+//  cache for that case mode is marked as overflowed and we just report that
+//  to the caller, who falls back to the NFA. That only happens for patterns
+//  that would explode combinatorially anyway.
+//
+//  We also extract two literal strings from the NFA when we are created. The
+//  prefix is the literal text that any match must start with, and the required
+//  literal is the longest literal text that any match must contain. The caller
+//  can use bMightMatch() to reject input that doesn't have the required text
+//  via a simple substring scan, and we use the prefix to quickly skip forward
+//  to possible match starting points when not searching only at the start.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The matchers can look at the position, i.e. the 'at end' matcher. We
+//      never cache a transition at the start or end of the input so that these
+//      are always correctly evaluated. All of the matchers only care about the
+//      position at those two points.
+//
+//  2)  TRegEx's matching methods are const and can be called by multiple
+//      threads, so we sync access to the state caches. The prefilter literals
+//      are set up in the ctor and never change, so they don't require any.
+//
+//  3)  This is an internal class, the outside world never sees it.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRegExDFA
+//  PREFIX: rxdfa
+// ----------------------------------------------------------------------------
+class TRegExDFA : public TObject
+{
+    public :
+        // --------------------------------------------------------------------
+        //  Public types
+        //
+        //  The results of a DFA search. Overflow means that we had to give up
+        //  because the state budget was used up, so the caller should use the
+        //  NFA.
+        // --------------------------------------------------------------------
+        enum class ERes
+        {
+            NoMatch
+            , Match
+            , Overflow
+        };
+
+
+        // --------------------------------------------------------------------
+        //  Constructors and Destructor
+        // --------------------------------------------------------------------
+        TRegExDFA() = delete;
+
+        TRegExDFA
+        (
+            const   TRegExNFA&              rxnfaSrc
+        );
+
+        TRegExDFA(const TRegExDFA&) = delete;
+        TRegExDFA(TRegExDFA&&) = delete;
+
+        ~TRegExDFA();
+
+
+        // --------------------------------------------------------------------
+        //  Public operators
+        // --------------------------------------------------------------------
+        TRegExDFA& operator=(const TRegExDFA&) = delete;
+        TRegExDFA& operator=(TRegExDFA&&) = delete;
+
+
+        // --------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TBoolean bMightMatch
+        (
+            const   tCIDLib::TCh* const     pszToSearch
+            , const tCIDLib::TCard4         c4StartAt
+            , const tCIDLib::TBoolean       bCaseSensitive
+        )   const;
+
+        ERes eFindMatch
+        (
+            const   tCIDLib::TCh* const     pszFindIn
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TCard4         c4StartAt
+            , const tCIDLib::TBoolean       bOnlyAtStart
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TCard4&        c4Ofs
+            ,       tCIDLib::TCard4&        c4Len
+        );
+
+        ERes eFullyMatches
+        (
+            const   tCIDLib::TCh* const     pszToTest
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+        const TString& strPrefix() const
+        {
+            return m_strPrefix;
+        }
+
+        const TString& strRequired() const
+        {
+            return m_strRequired;
+        }
+
+
+    private :
+        // --------------------------------------------------------------------
+        //  Private types
+        //
+        //  TDState
+        //      A single DFA state. The NFA states it represents are stored in
+        //      the cache's set list, starting at c4SetOfs, in sorted order. The
+        //      transition table is allocated when the state is created and
+        //      has an entry for each character under 256. Unknown entries are
+        //      c4MaxCard.
+        //
+        //  TStateCache
+        //      The DFA states for one case sensitivity mode. The first state
+        //      is always the dead state, the empty set with no accept, and
+        //      its transitions all go back to itself.
+        // --------------------------------------------------------------------
+        struct TDState
+        {
+            tCIDLib::TBoolean   bAccept;
+            tCIDLib::TCard4     c4Hash;
+            tCIDLib::TCard4     c4SetOfs;
+            tCIDLib::TCard4     c4SetCount;
+            tCIDLib::TCard4*    pc4Trans;
+        };
+
+        struct TStateCache
+        {
+            tCIDLib::TBoolean               bCaseSensitive;
+            tCIDLib::TBoolean               bOverflowed;
+            tCIDLib::TCard4                 c4StartState;
+            tCIDLib::TCard4                 c4StateCount;
+            TDState*                        pdstList;
+            TFundVector<tCIDLib::TCard4>    fcolSets;
+        };
+
+
+        // --------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TVoid AddTarget
+        (
+            const   tCIDLib::TCard4         c4Target
+        );
+
+        tCIDLib::TBoolean bIsRequired
+        (
+            const   tCIDLib::TCard4         c4ToCheck
+        );
+
+        tCIDLib::TBoolean bPrefixAt
+        (
+            const   tCIDLib::TCh* const     pszToCheck
+            , const tCIDLib::TBoolean       bCaseSensitive
+        )   const;
+
+        tCIDLib::TCard4 c4AddOrFindState
+        (
+                    TStateCache&            cacheTar
+        );
+
+        tCIDLib::TCard4 c4LiteralRun
+        (
+            const   tCIDLib::TCard4         c4FirstState
+            ,       TString&                strToFill
+        );
+
+        tCIDLib::TCard4 c4NextState
+        (
+                    TStateCache&            cacheTar
+            , const tCIDLib::TCard4         c4From
+            , const tCIDLib::TCh* const     pszInput
+            , const tCIDLib::TCard4         c4At
+            , const tCIDLib::TCard4         c4SearchLen
+        );
+
+        tCIDLib::TCard4 c4StartState
+        (
+                    TStateCache&            cacheTar
+        );
+
+        tCIDLib::TVoid CloseOver();
+
+        tCIDLib::TVoid FindLiterals();
+
+        tCIDLib::TVoid InitCache
+        (
+                    TStateCache&            cacheTar
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+        tCIDLib::TVoid NewPass();
+
+        const TRXCharMatcher* pmatchLiteral
+        (
+            const   tCIDLib::TCard4         c4At
+        )   const;
+
+
+        // --------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bAccept
+        //  m_c4SetCount
+        //  m_pc4Set
+        //      The results of the last CloseOver() call, i.e. whether the end
+        //      of the pattern was reached and the (sorted) non-epsilon NFA
+        //      states reached.
+        //
+        //  m_c4Pass
+        //  m_pc4Marks
+        //      Used to mark NFA states visited during a pass, so that we can
+        //      do a pass without having to clear the marks each time.
+        //
+        //  m_c4NFACount
+        //      The number of states in the NFA, to size our buffers.
+        //
+        //  m_c4StackTop
+        //  m_pc4Stack
+        //      The work stack used while finding the closure of a set of
+        //      states. States are marked when pushed, so it never needs to
+        //      hold more than the NFA state count.
+        //
+        //  m_cacheCase
+        //  m_cacheNoCase
+        //      The DFA states for case sensitive and insensitive searches,
+        //      since the transitions are different.
+        //
+        //  m_crsSync
+        //      Used to sync access to the caches and the work buffers.
+        //
+        //  m_rxnfaSrc
+        //      The NFA we are running, which must outlive us.
+        //
+        //  m_strPrefix
+        //  m_strRequired
+        //      The literal text all matches must start with and contain,
+        //      either of which can be empty. If there's a prefix, then the
+        //      required text is at least as long as it.
+        // --------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bAccept;
+        tCIDLib::TCard4         m_c4NFACount;
+        tCIDLib::TCard4         m_c4Pass;
+        tCIDLib::TCard4         m_c4SetCount;
+        tCIDLib::TCard4         m_c4StackTop;
+        TStateCache             m_cacheCase;
+        TStateCache             m_cacheNoCase;
+        TCriticalSection        m_crsSync;
+        tCIDLib::TCard4*        m_pc4Marks;
+        tCIDLib::TCard4*        m_pc4Set;
+        tCIDLib::TCard4*        m_pc4Stack;
+        const TRegExNFA&        m_rxnfaSrc;
+        TString                 m_strPrefix;
+        TString                 m_strRequired;
+
+
+        // --------------------------------------------------------------------
+        //  Magic macros
+        // --------------------------------------------------------------------
+        RTTIDefs(TRegExDFA,TObject)
+};
+
+#pragma CIDLIB_POPPACK
@@ -30,6 +30,7 @@
 // ---------------------------------------------------------------------------
 #include "CIDRegX_.hpp"
 #include "CIDRegX_RegExInternal_.hpp"
+#include "CIDRegX_RegExDFA_.hpp"
 
 
 // ---------------------------------------------------------------------------
@@ -50,6 +51,44 @@ namespace
         //      those for the next character.
         // -----------------------------------------------------------------------
         constexpr tCIDLib::TCard4    c4Scan = kCIDLib::c4MaxCard;
+
+
+        //
+        //  While running the NFA, states for the current char are added to the
+        //  front of the deque and states for the next char to the back. A state
+        //  should only be run once per char, but it can be pending for both
+        //  the current and next char at once, so just checking whether it's
+        //  already in the deque will drop needed states, and doesn't stop
+        //  epsilon loops from going around again once the state is taken off.
+        //
+        //  So we remember, for each state, the last index (plus one, so that
+        //  zero means never) it was queued for at the front and at the back.
+        //
+        inline tCIDLib::TVoid AddCurState(          TFundDeque<tCIDLib::TCard4>&    fcolStates
+                                            ,       tCIDLib::TCard4* const          pc4FrontMarks
+                                            , const tCIDLib::TCard4* const          pc4BackMarks
+                                            , const tCIDLib::TCard4                 c4State
+                                            , const tCIDLib::TCard4                 c4CurInd)
+        {
+            if ((pc4FrontMarks[c4State] != c4CurInd + 1)
+            &&  (pc4BackMarks[c4State] != c4CurInd + 1))
+            {
+                pc4FrontMarks[c4State] = c4CurInd + 1;
+                fcolStates.AddAtFront(c4State);
+            }
+        }
+
+        inline tCIDLib::TVoid AddNextState(         TFundDeque<tCIDLib::TCard4>&    fcolStates
+                                            ,       tCIDLib::TCard4* const          pc4BackMarks
+                                            , const tCIDLib::TCard4                 c4State
+                                            , const tCIDLib::TCard4                 c4CurInd)
+        {
+            if (pc4BackMarks[c4State] != c4CurInd + 2)
+            {
+                pc4BackMarks[c4State] = c4CurInd + 2;
+                fcolStates.AddAtBack(c4State);
+            }
+        }
     }
 }
 
@@ -67,8 +106,10 @@ TRegEx::TRegEx() :
 
     m_bEscaped(kCIDLib::False)
     , m_bLetter(kCIDLib::False)
+    , m_bUseDFA(kCIDLib::True)
     , m_c4CurInd(0)
     , m_c4CurState(0)
+    , m_prxdfaPattern(nullptr)
     , m_prxnfaPattern(nullptr)
     , m_strPattern()
 {
@@ -78,8 +119,10 @@ TRegEx::TRegEx(const TString& strExpression) :
 
     m_bEscaped(kCIDLib::False)
     , m_bLetter(kCIDLib::False)
+    , m_bUseDFA(kCIDLib::True)
     , m_c4CurInd(0)
     , m_c4CurState(0)
+    , m_prxdfaPattern(nullptr)
     , m_prxnfaPattern(nullptr)
     , m_strPattern()
 {
@@ -90,8 +133,10 @@ TRegEx::TRegEx(const tCIDLib::TCh* const pszExpression) :
 
     m_bEscaped(kCIDLib::False)
     , m_bLetter(kCIDLib::False)
+    , m_bUseDFA(kCIDLib::True)
     , m_c4CurInd(0)
     , m_c4CurState(0)
+    , m_prxdfaPattern(nullptr)
     , m_prxnfaPattern(nullptr)
     , m_strPattern()
 {
@@ -102,8 +147,10 @@ TRegEx::TRegEx(const TRegEx& regxSrc) :
 
     m_bEscaped(regxSrc.m_bEscaped)
     , m_bLetter(regxSrc.m_bLetter)
+    , m_bUseDFA(regxSrc.m_bUseDFA)
     , m_c4CurInd(regxSrc.m_c4CurInd)
     , m_c4CurState(regxSrc.m_c4CurState)
+    , m_prxdfaPattern(nullptr)
     , m_prxnfaPattern(nullptr)
 {
     // We don't try to dup the data, we just rebuild it
@@ -119,6 +166,8 @@ TRegEx::TRegEx(TRegEx&& regxSrc) :
 
 TRegEx::~TRegEx()
 {
+    // The DFA references the NFA, so it goes first
+    delete m_prxdfaPattern;
     delete m_prxnfaPattern;
 }
 
@@ -132,8 +181,10 @@ TRegEx& TRegEx::operator=(TRegEx&& regxSrc)
     {
         tCIDLib::Swap(m_bEscaped, regxSrc.m_bEscaped);
         tCIDLib::Swap(m_bLetter, regxSrc.m_bLetter);
+        tCIDLib::Swap(m_bUseDFA, regxSrc.m_bUseDFA);
         tCIDLib::Swap(m_c4CurInd, regxSrc.m_c4CurInd);
         tCIDLib::Swap(m_c4CurState, regxSrc.m_c4CurState);
+        tCIDLib::Swap(m_prxdfaPattern, regxSrc.m_prxdfaPattern);
         tCIDLib::Swap(m_prxnfaPattern, regxSrc.m_prxnfaPattern);
 
         m_strPattern = tCIDLib::ForceMove(regxSrc.m_strPattern);
@@ -147,6 +198,7 @@ TRegEx& TRegEx::operator=(const TRegEx& regxSrc)
     {
         m_bEscaped = regxSrc.m_bEscaped;
         m_bLetter = regxSrc.m_bLetter;
+        m_bUseDFA = regxSrc.m_bUseDFA;
         m_c4CurInd = regxSrc.m_c4CurInd;
         m_c4CurState = regxSrc.m_c4CurState;
         m_strPattern = regxSrc.m_strPattern;
@@ -251,6 +303,25 @@ TRegEx::bFindMatchAt(const  tCIDLib::TCh* const pszFindIn
         );
     }
 
+    //
+    //  If we have the DFA, check for any required literal text first, since
+    //  that's a quick way to reject the input. If that passes, let the DFA do
+    //  it. If it returns overflow, the pattern requires too many states, so
+    //  we fall through and run the NFA.
+    //
+    if (m_prxdfaPattern)
+    {
+        if (!m_prxdfaPattern->bMightMatch(pszFindIn, c4StartInd, bCaseSensitive))
+            return kCIDLib::False;
+
+        const TRegExDFA::ERes eRes = m_prxdfaPattern->eFindMatch
+        (
+            pszFindIn, c4SearchLen, c4StartInd, bOnlyAtStart, bCaseSensitive, c4Ofs, c4Len
+        );
+        if (eRes != TRegExDFA::ERes::Overflow)
+            return (eRes == TRegExDFA::ERes::Match);
+    }
+
     //
     //  Create a fundamental deque with enough states to hold the worst
     //  case scenario for our pattern.
@@ -260,6 +331,13 @@ TRegEx::bFindMatchAt(const  tCIDLib::TCh* const pszFindIn
         m_prxnfaPattern->c4StateCount() * c4SearchLen
     );
 
+    // And the per-state marks that keep us from queuing a state twice per char
+    const tCIDLib::TCard4 c4StateCount = m_prxnfaPattern->c4StateCount();
+    tCIDLib::TCard4* pc4FrontMarks = new tCIDLib::TCard4[c4StateCount];
+    TArrayJanitor<tCIDLib::TCard4> janFront(pc4FrontMarks);
+    tCIDLib::TCard4* pc4BackMarks = new tCIDLib::TCard4[c4StateCount];
+    TArrayJanitor<tCIDLib::TCard4> janBack(pc4BackMarks);
+
     //
     //  Each time we find a path to the end of the pattern, we save the
     //  current position here and keep going to see if we can find a longer
@@ -278,9 +356,11 @@ TRegEx::bFindMatchAt(const  tCIDLib::TCh* const pszFindIn
     const tCIDLib::TCard4 c4Iters = bOnlyAtStart ? 1 : c4SearchLen - c4StartInd;
     for (tCIDLib::TCard4 c4CurIter = 0; c4CurIter < c4Iters; c4CurIter++)
     {
-        // Set up the deque for the next run
+        // Set up the deque and marks for the next run
         fcolStates.RemoveAll();
         fcolStates.AddAtBack(CIDRegX_Engine::c4Scan);
+        TRawMem::SetMemBuf(pc4FrontMarks, tCIDLib::TCard4(0), c4StateCount);
+        TRawMem::SetMemBuf(pc4BackMarks, tCIDLib::TCard4(0), c4StateCount);
 
         // Set the starting position for this round
         tCIDLib::TCard4 c4CurInd = c4StartInd + c4CurIter;
@@ -310,36 +390,44 @@ TRegEx::bFindMatchAt(const  tCIDLib::TCh* const pszFindIn
                     //  If either of them is zero, then remember where we
                     //  are now, but don't add the zero state.
                     //
-                    fcolStates.bAddAtFrontIfNotAlready(c41);
+                    CIDRegX_Engine::AddCurState
+                    (
+                        fcolStates, pc4FrontMarks, pc4BackMarks, c41, c4CurInd
+                    );
                     if (c42 != c41)
-                        fcolStates.bAddAtFrontIfNotAlready(c42);
-                }
-                 else
-                {
-                    #if CID_DEBUG_ON
-                    if (c4CurInd > c4SearchLen)
                     {
-                        facCIDRegX().ThrowErr
+                        CIDRegX_Engine::AddCurState
                         (
-                            CID_FILE
-                            , CID_LINE
-                            , kRegXErrs::errcRegEx_PatternOverflow
-                            , tCIDLib::ESeverities::ProcFatal
-                            , tCIDLib::EErrClasses::Internal
+                            fcolStates, pc4FrontMarks, pc4BackMarks, c42, c4CurInd
                         );
                     }
-                    #endif
-
-                    if (m_prxnfaPattern->matchAt(c4CurState).bMatches
+                }
+                 else
+                {
+                    //
+                    //  A matcher that accepts the null at the end can take us one
+                    //  past the end. Nothing matches out there, but we still run
+                    //  the epsilon states to see if they get to the end.
+                    //
+                    if ((c4CurInd <= c4SearchLen)
+                    &&  m_prxnfaPattern->matchAt(c4CurState).bMatches
                     (
                         pszFindIn[c4CurInd]
                         , c4CurInd
                         , c4SearchLen
                         , bCaseSensitive))
                     {
-                        fcolStates.bAddAtBackIfNotAlready(c41);
+                        CIDRegX_Engine::AddNextState
+                        (
+                            fcolStates, pc4BackMarks, c41, c4CurInd
+                        );
                         if (c41 != c42)
-                            fcolStates.bAddAtBackIfNotAlready(c42);
+                        {
+                            CIDRegX_Engine::AddNextState
+                            (
+                                fcolStates, pc4BackMarks, c42, c4CurInd
+                            );
+                        }
                     }
                 }
             }
@@ -443,6 +531,20 @@ TRegEx::bFullyMatches(  const   tCIDLib::TCh* const pszToTest
     if (!c4SearchLen && !m_prxnfaPattern->bIsNullable())
         return kCIDLib::False;
 
+    // If we have the DFA, use it as in bFindMatchAt() above
+    if (m_prxdfaPattern)
+    {
+        if (!m_prxdfaPattern->bMightMatch(pszToTest, 0, bCaseSensitive))
+            return kCIDLib::False;
+
+        const TRegExDFA::ERes eRes = m_prxdfaPattern->eFullyMatches
+        (
+            pszToTest, c4SearchLen, bCaseSensitive
+        );
+        if (eRes != TRegExDFA::ERes::Overflow)
+            return (eRes == TRegExDFA::ERes::Match);
+    }
+
     //
     //  Create a fundamental deque with enough states to hold the worst
     //  case scenario for our pattern.
@@ -453,6 +555,15 @@ TRegEx::bFullyMatches(  const   tCIDLib::TCh* const pszToTest
     );
     fcolStates.AddAtBack(CIDRegX_Engine::c4Scan);
 
+    // And the per-state marks that keep us from queuing a state twice per char
+    const tCIDLib::TCard4 c4StateCount = m_prxnfaPattern->c4StateCount();
+    tCIDLib::TCard4* pc4FrontMarks = new tCIDLib::TCard4[c4StateCount];
+    TArrayJanitor<tCIDLib::TCard4> janFront(pc4FrontMarks);
+    TRawMem::SetMemBuf(pc4FrontMarks, tCIDLib::TCard4(0), c4StateCount);
+    tCIDLib::TCard4* pc4BackMarks = new tCIDLib::TCard4[c4StateCount];
+    TArrayJanitor<tCIDLib::TCard4> janBack(pc4BackMarks);
+    TRawMem::SetMemBuf(pc4BackMarks, tCIDLib::TCard4(0), c4StateCount);
+
     tCIDLib::TBoolean   bSuccess = kCIDLib::False;
     tCIDLib::TCard4     c4CurInd = 0;
     tCIDLib::TCard4     c4CurState = m_prxnfaPattern->c4State1At(0);
@@ -474,34 +585,37 @@ TRegEx::bFullyMatches(  const   tCIDLib::TCh* const pszToTest
 
             if (m_prxnfaPattern->bIsEpsilonState(c4CurState))
             {
-                fcolStates.bAddAtFrontIfNotAlready(c41);
+                CIDRegX_Engine::AddCurState
+                (
+                    fcolStates, pc4FrontMarks, pc4BackMarks, c41, c4CurInd
+                );
                 if (c42 != c41)
-                    fcolStates.bAddAtFrontIfNotAlready(c42);
-            }
-             else
-            {
-                #if CID_DEBUG_ON
-                if (c4CurInd > c4SearchLen)
                 {
-                    facCIDRegX().ThrowErr
+                    CIDRegX_Engine::AddCurState
                     (
-                        CID_FILE
-                        , CID_LINE
-                        , kRegXErrs::errcRegEx_PatternOverflow
-                        , tCIDLib::ESeverities::ProcFatal
-                        , tCIDLib::EErrClasses::Internal
+                        fcolStates, pc4FrontMarks, pc4BackMarks, c42, c4CurInd
                     );
                 }
-                #endif
-
-                if (m_prxnfaPattern->matchAt(c4CurState).bMatches
+            }
+             else
+            {
+                //
+                //  A matcher that accepts the null at the end can take us one
+                //  past the end. Nothing matches out there, but we still run
+                //  the epsilon states to see if they get to the end.
+                //
+                if ((c4CurInd <= c4SearchLen)
+                &&  m_prxnfaPattern->matchAt(c4CurState).bMatches
                 (
                     pszToTest[c4CurInd]
                     , c4CurInd
                     , c4SearchLen
                     , bCaseSensitive))
                 {
-                    fcolStates.bAddAtBackIfNotAlready(c41);
+                    CIDRegX_Engine::AddNextState
+                    (
+                        fcolStates, pc4BackMarks, c41, c4CurInd
+                    );
                 }
             }
         }
@@ -574,9 +688,35 @@ TRegEx::bReplaceAll(        TString&            strFindIn
 }
 
 
+tCIDLib::TBoolean TRegEx::bUseDFA() const
+{
+    return m_bUseDFA;
+}
+
+tCIDLib::TBoolean TRegEx::bUseDFA(const tCIDLib::TBoolean bToSet)
+{
+    m_bUseDFA = bToSet;
+
+    // Create or drop the DFA as needed
+    if (m_bUseDFA)
+    {
+        if (m_prxnfaPattern && !m_prxdfaPattern)
+            m_prxdfaPattern = new TRegExDFA(*m_prxnfaPattern);
+    }
+     else
+    {
+        delete m_prxdfaPattern;
+        m_prxdfaPattern = nullptr;
+    }
+    return m_bUseDFA;
+}
+
+
 // We just reset the pattern, so they have to set a new one
 tCIDLib::TVoid TRegEx::Reset()
 {
+    delete m_prxdfaPattern;
+    m_prxdfaPattern = nullptr;
     delete m_prxnfaPattern;
     m_prxnfaPattern = nullptr;
     m_strPattern.Clear();
@@ -607,6 +747,10 @@ tCIDLib::TVoid TRegEx::SetExpression(const TString& strToSet)
     //
     m_strPattern = strToSet;
     const tCIDLib::TCard4 c4NewLen = m_strPattern.c4Length();
+
+    // Any DFA we have references the NFA we are about to reset, so drop it
+    delete m_prxdfaPattern;
+    m_prxdfaPattern = nullptr;
     const tCIDLib::TCard4 c4NewEntries = (c4NewLen * 2) + 2;
 
     // If it's empty, then we just don't have a pattern anymore
@@ -664,6 +808,10 @@ tCIDLib::TVoid TRegEx::SetExpression(const TString& strToSet)
 
     // And call complete on it
     m_prxnfaPattern->Complete();
+
+    // And create the DFA over it if we are using that
+    if (m_bUseDFA)
+        m_prxdfaPattern = new TRegExDFA(*m_prxnfaPattern);
 }
 
 
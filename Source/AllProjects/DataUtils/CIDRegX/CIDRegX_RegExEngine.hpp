@@ -21,6 +21,14 @@
 //  NFA for its work (which is common for this type of regular expression
 //  engine.)
 //
+//  Once the NFA is built, we also create a TRegExDFA (an internal class) over
+//  it. It lazily builds up a DFA as the NFA is run, and also extracts literal
+//  text from the pattern that can be used to quickly reject input or skip
+//  forward to where a match could start. We use it for matching, and fall back
+//  to running the NFA directly if the pattern needs more DFA states than it
+//  allows. Both give the same results, the leftmost start and longest non-empty
+//  match from there. It can be disabled, mostly so that the two can be compared.
+//
 //  This class provides its own parser for the regular expression, so it has
 //  a fixed syntax similar to that of most grep programs. So you cannot give
 //  it an arbitarily built binary regular expression data structure. You can
@@ -36,6 +44,8 @@
 #pragma once
 
 
+class TRegExDFA;
+
 #pragma CIDLIB_PACK(CIDLIBPACK)
 
 
@@ -148,6 +158,13 @@ class CIDREGXEXP TRegEx : public TObject, public MFormattable
             , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
         )   const;
 
+        tCIDLib::TBoolean bUseDFA() const;
+
+        tCIDLib::TBoolean bUseDFA
+        (
+            const   tCIDLib::TBoolean       bToSet
+        );
+
         tCIDLib::TVoid Reset();
 
         TString strExpression() const;
@@ -174,6 +191,12 @@ class CIDREGXEXP TRegEx : public TObject, public MFormattable
 
 
     private :
+        // --------------------------------------------------------------------
+        //  The regex set runs our NFA directly, as part of its combined DFA
+        // --------------------------------------------------------------------
+        friend class TRegExSet;
+
+
         // --------------------------------------------------------------------
         //  Private, non-virtual methods
         // --------------------------------------------------------------------
@@ -195,6 +218,10 @@ class CIDREGXEXP TRegEx : public TObject, public MFormattable
         // --------------------------------------------------------------------
         //  Private data members
         //
+        //  m_bUseDFA
+        //      Whether we should use the DFA. It defaults to true. If false, we
+        //      don't create m_prxdfaPattern.
+        //
         //  m_strPattern
         //      A copy of the pattern string that is currently set up as our
         //      NFA. If it has not been set yet, then its still a null pointer.
@@ -202,9 +229,16 @@ class CIDREGXEXP TRegEx : public TObject, public MFormattable
         //  m_prxnfaPattern
         //      The NFA that contains the compiled pattern built up from parsing the
         //      expression that gets set on us.
+        //
+        //  m_prxdfaPattern
+        //      The lazy DFA we run over the NFA. Null if no pattern or if we
+        //      aren't using the DFA. It references the NFA so must be deleted
+        //      first, and before the NFA is reset.
         // --------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bUseDFA;
         TString                 m_strPattern;
         TRegExNFA*              m_prxnfaPattern;
+        TRegExDFA*              m_prxdfaPattern;
 
         // Only used during parsing of pattern
         tCIDLib::TBoolean       m_bEscaped;
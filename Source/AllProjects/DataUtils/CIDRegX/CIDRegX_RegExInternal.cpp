@@ -93,6 +93,20 @@ TRXCharMatcher::bMatches(const  tCIDLib::TCh        chToMatch
     return m_bNot;
 }
 
+
+// ----------------------------------------------------------------------------
+//  TRXCharMatcher: Public, non-virtual methods
+// ----------------------------------------------------------------------------
+tCIDLib::TBoolean TRXCharMatcher::bNot() const
+{
+    return m_bNot;
+}
+
+tCIDLib::TCh TRXCharMatcher::chToMatch() const
+{
+    return m_chToMatch;
+}
+
 tCIDLib::TVoid TRXCharMatcher::SetNot()
 {
     m_bNot = kCIDLib::True;
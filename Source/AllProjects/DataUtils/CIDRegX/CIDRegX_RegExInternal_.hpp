@@ -75,6 +75,10 @@ class TRXCharMatcher : public TRXMatcher
         // --------------------------------------------------------------------
         //  Public, non-virtual methods
         // --------------------------------------------------------------------
+        tCIDLib::TBoolean bNot() const;
+
+        tCIDLib::TCh chToMatch() const;
+
         tCIDLib::TVoid SetNot();
 
 
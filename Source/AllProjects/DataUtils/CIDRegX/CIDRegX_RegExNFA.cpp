@@ -305,14 +305,17 @@ tCIDLib::TVoid TRegExNFA::Complete()
     //
     //  And see if we are nullable. If there is a path through the NFA that is
     //  all epsilon nodes, then it's nullable. We have to use a stack to do this
-    //  since there are multiple possible such paths. Worst case we have to go
-    //  through both sides of every state, so 2*count is the max.
+    //  since there are multiple possible such paths. Nested closures can create
+    //  loops of epsilon nodes, so we only push each state once, which also means
+    //  count is the max.
     //
-    tCIDLib::TCardStack fcolStack(m_c4StateCount * 2);
+    tCIDLib::TCardStack fcolStack(m_c4StateCount);
+    tCIDLib::TBoolArray fcolSeen(m_c4StateCount, kCIDLib::False);
 
     // Start us off with the first state on the stack and nullable defaulted to false
     m_bNullable = kCIDLib::False;
     fcolStack.Push(m_pc4State1[0]);
+    fcolSeen[m_pc4State1[0]] = kCIDLib::True;
     while (!fcolStack.bIsEmpty())
     {
         // Get the next state off the stack
@@ -330,10 +333,20 @@ tCIDLib::TVoid TRegExNFA::Complete()
 
         if (bIsEpsilonState(c4CurState))
         {
-            // It's an epsilon state. Push the unique out states from here
-            fcolStack.Push(m_pc4State1[c4CurState]);
-            if (m_pc4State1[c4CurState] != m_pc4State2[c4CurState])
-                fcolStack.Push(m_pc4State2[c4CurState]);
+            // It's an epsilon state. Push the out states from here not seen yet
+            const tCIDLib::TCard4 c41 = m_pc4State1[c4CurState];
+            const tCIDLib::TCard4 c42 = m_pc4State2[c4CurState];
+            if (!fcolSeen[c41])
+            {
+                fcolSeen[c41] = kCIDLib::True;
+                fcolStack.Push(c41);
+            }
+
+            if (!fcolSeen[c42])
+            {
+                fcolSeen[c42] = kCIDLib::True;
+                fcolStack.Push(c42);
+            }
         }
          else
         {
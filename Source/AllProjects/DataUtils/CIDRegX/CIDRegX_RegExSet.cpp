@@ -0,0 +1,356 @@
+//
+// FILE NAME: CIDRegX_RegExSet.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TRegExSet class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include "CIDRegX_.hpp"
+#include "CIDRegX_RegExInternal_.hpp"
+#include "CIDRegX_RegExSet_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TRegExSet,TObject)
+
+
+namespace
+{
+    namespace CIDRegX_RegExSet
+    {
+        //
+        //  If the NFA is just a single path of literal char states, return the
+        //  text. Each state on such a path has both transitions to the same
+        //  place, and we can't visit more states than there are, else it's not
+        //  a single path.
+        //
+        tCIDLib::TBoolean bIsLiteral(const TRegExNFA& rxnfaSrc, TString& strToFill)
+        {
+            strToFill.Clear();
+
+            const tCIDLib::TCard4 c4Count = rxnfaSrc.c4StateCount();
+            tCIDLib::TCard4 c4Cur = rxnfaSrc.c4State1At(0);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                // If we got to the end, it's a literal if we got any text
+                if (!c4Cur)
+                    return !strToFill.bIsEmpty();
+
+                const tCIDLib::TCard4 c41 = rxnfaSrc.c4State1At(c4Cur);
+                if (rxnfaSrc.c4State2At(c4Cur) != c41)
+                    return kCIDLib::False;
+
+                if (!rxnfaSrc.bIsEpsilonState(c4Cur))
+                {
+                    const TRXMatcher& matchCur = rxnfaSrc.matchAt(c4Cur);
+                    if (matchCur.clsIsA() != TRXCharMatcher::clsThis())
+                        return kCIDLib::False;
+
+                    const TRXCharMatcher& matchChar = static_cast<const TRXCharMatcher&>(matchCur);
+                    if (matchChar.bNot())
+                        return kCIDLib::False;
+                    strToFill.Append(matchChar.chToMatch());
+                }
+                c4Cur = c41;
+            }
+            return kCIDLib::False;
+        }
+    }
+}
+
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRegExSet
+//  PREFIX: rxset
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TRegExSet: Constructors and Destructor
+// ----------------------------------------------------------------------------
+TRegExSet::TRegExSet() :
+
+    m_bReady(kCIDLib::False)
+    , m_c4MaskWords(0)
+    , m_colExprs(tCIDLib::EAdoptOpts::Adopt)
+    , m_prxlitsPats(nullptr)
+    , m_prxsdfaPats(nullptr)
+{
+}
+
+TRegExSet::~TRegExSet()
+{
+    // The matchers refer to the expressions' NFAs, so they go first
+    DropMatchers();
+    m_colExprs.RemoveAll();
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRegExSet: Public, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  Parse the pattern and add it. We return its index, which is how it's
+//  identified in the match results. The matchers are rebuilt on the next
+//  match.
+//
+tCIDLib::TCard4 TRegExSet::c4AddPattern(const TString& strPattern)
+{
+    TRegEx* pregxNew = new TRegEx(strPattern);
+    TJanitor<TRegEx> janNew(pregxNew);
+
+    // An empty pattern just leaves it with no NFA
+    if (!pregxNew->m_prxnfaPattern)
+    {
+        facCIDRegX().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kRegXErrs::errcRegEx_NoPattern
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::BadParms
+        );
+    }
+
+    DropMatchers();
+    m_colExprs.Add(janNew.pobjOrphan());
+    return m_colExprs.c4ElemCount() - 1;
+}
+
+
+tCIDLib::TCard4
+TRegExSet::c4FindMatches(const  TString&                        strFindIn
+                        ,       TFundVector<tCIDLib::TCard4>&   fcolMatches
+                        , const tCIDLib::TBoolean               bCaseSensitive) const
+{
+    return c4FindMatches(strFindIn.pszBuffer(), fcolMatches, bCaseSensitive);
+}
+
+tCIDLib::TCard4
+TRegExSet::c4FindMatches(const  tCIDLib::TCh* const             pszFindIn
+                        ,       TFundVector<tCIDLib::TCard4>&   fcolMatches
+                        , const tCIDLib::TBoolean               bCaseSensitive) const
+{
+    fcolMatches.RemoveAll();
+
+    // As with TRegEx, empty input never has a match
+    const tCIDLib::TCard4 c4SearchLen = TRawStr::c4StrLen(pszFindIn);
+    if (!c4SearchLen || m_colExprs.bIsEmpty())
+        return 0;
+
+    CheckReady();
+
+    tCIDLib::TCard4* pc4Mask = new tCIDLib::TCard4[m_c4MaskWords];
+    TArrayJanitor<tCIDLib::TCard4> janMask(pc4Mask);
+    TRawMem::SetMemBuf(pc4Mask, tCIDLib::TCard4(0), m_c4MaskWords);
+
+    if (m_prxlitsPats)
+        m_prxlitsPats->FindMatches(pszFindIn, c4SearchLen, bCaseSensitive, pc4Mask);
+
+    if (m_prxsdfaPats
+    &&  !m_prxsdfaPats->bFindMatches(pszFindIn, c4SearchLen, bCaseSensitive, pc4Mask))
+    {
+        // It overflowed, so run the patterns separately
+        const tCIDLib::TCard4 c4Count = m_fcolExprIds.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            const tCIDLib::TCard4 c4PatId = m_fcolExprIds[c4Index];
+            tCIDLib::TCard4 c4Ofs = 0;
+            tCIDLib::TCard4 c4Len = 0;
+            if (m_colExprs[c4PatId]->bFindMatch(pszFindIn, c4Ofs, c4Len, kCIDLib::False, bCaseSensitive))
+                pc4Mask[c4PatId >> 5] |= 0x1UL << (c4PatId & 0x1F);
+        }
+    }
+    return c4MaskToList(pc4Mask, fcolMatches);
+}
+
+
+tCIDLib::TCard4
+TRegExSet::c4FullMatches(const  TString&                        strToTest
+                        ,       TFundVector<tCIDLib::TCard4>&   fcolMatches
+                        , const tCIDLib::TBoolean               bCaseSensitive) const
+{
+    return c4FullMatches(strToTest.pszBuffer(), fcolMatches, bCaseSensitive);
+}
+
+tCIDLib::TCard4
+TRegExSet::c4FullMatches(const  tCIDLib::TCh* const             pszToTest
+                        ,       TFundVector<tCIDLib::TCard4>&   fcolMatches
+                        , const tCIDLib::TBoolean               bCaseSensitive) const
+{
+    fcolMatches.RemoveAll();
+
+    const tCIDLib::TCard4 c4PatCount = m_colExprs.c4ElemCount();
+    if (!c4PatCount)
+        return 0;
+
+    // Empty input is fully matched by the nullable patterns
+    const tCIDLib::TCard4 c4SearchLen = TRawStr::c4StrLen(pszToTest);
+    if (!c4SearchLen)
+    {
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PatCount; c4Index++)
+        {
+            if (m_colExprs[c4Index]->bIsNullable())
+                fcolMatches.c4AddElement(c4Index);
+        }
+        return fcolMatches.c4ElemCount();
+    }
+
+    CheckReady();
+
+    tCIDLib::TCard4* pc4Mask = new tCIDLib::TCard4[m_c4MaskWords];
+    TArrayJanitor<tCIDLib::TCard4> janMask(pc4Mask);
+    TRawMem::SetMemBuf(pc4Mask, tCIDLib::TCard4(0), m_c4MaskWords);
+
+    if (m_prxlitsPats)
+        m_prxlitsPats->FullMatches(pszToTest, c4SearchLen, bCaseSensitive, pc4Mask);
+
+    if (m_prxsdfaPats
+    &&  !m_prxsdfaPats->bFullMatches(pszToTest, c4SearchLen, bCaseSensitive, pc4Mask))
+    {
+        const tCIDLib::TCard4 c4Count = m_fcolExprIds.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            const tCIDLib::TCard4 c4PatId = m_fcolExprIds[c4Index];
+            if (m_colExprs[c4PatId]->bFullyMatches(pszToTest, bCaseSensitive))
+                pc4Mask[c4PatId >> 5] |= 0x1UL << (c4PatId & 0x1F);
+        }
+    }
+    return c4MaskToList(pc4Mask, fcolMatches);
+}
+
+
+// Return how many of the patterns are handled as literals
+tCIDLib::TCard4 TRegExSet::c4LiteralCount() const
+{
+    if (m_colExprs.bIsEmpty())
+        return 0;
+
+    CheckReady();
+    return m_prxlitsPats ? m_prxlitsPats->c4Count() : 0;
+}
+
+
+tCIDLib::TCard4 TRegExSet::c4PatternCount() const
+{
+    return m_colExprs.c4ElemCount();
+}
+
+
+tCIDLib::TVoid TRegExSet::Reset()
+{
+    DropMatchers();
+    m_colExprs.RemoveAll();
+}
+
+
+TString TRegExSet::strPatternAt(const tCIDLib::TCard4 c4At) const
+{
+    return m_colExprs[c4At]->strExpression();
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRegExSet: Private, non-virtual methods
+// ----------------------------------------------------------------------------
+
+// Fill in the list with the indices of the bits set in the mask
+tCIDLib::TCard4
+TRegExSet::c4MaskToList(const   tCIDLib::TCard4* const          pc4Mask
+                        ,       TFundVector<tCIDLib::TCard4>&   fcolToFill) const
+{
+    const tCIDLib::TCard4 c4PatCount = m_colExprs.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PatCount; c4Index++)
+    {
+        if (pc4Mask[c4Index >> 5] & (0x1UL << (c4Index & 0x1F)))
+            fcolToFill.c4AddElement(c4Index);
+    }
+    return fcolToFill.c4ElemCount();
+}
+
+
+//
+//  If the matchers haven't been built for the current patterns, do that now.
+//  We check the NFA of each pattern to see if it's just literal text. If so it
+//  goes into the literal set, else into the DFA.
+//
+tCIDLib::TVoid TRegExSet::CheckReady() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+    if (m_bReady)
+        return;
+
+    const tCIDLib::TCard4 c4PatCount = m_colExprs.c4ElemCount();
+    m_c4MaskWords = (c4PatCount + 31) / 32;
+    m_fcolExprIds.RemoveAll();
+
+    TJanitor<TRXLiteralSet> janLits(new TRXLiteralSet);
+    TJanitor<TRXSetDFA> janDFA(new TRXSetDFA(c4PatCount, m_c4MaskWords));
+
+    TString strLiteral;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PatCount; c4Index++)
+    {
+        const TRegExNFA& rxnfaCur = *m_colExprs[c4Index]->m_prxnfaPattern;
+        if (CIDRegX_RegExSet::bIsLiteral(rxnfaCur, strLiteral))
+        {
+            janLits->AddLiteral(strLiteral, c4Index);
+        }
+         else
+        {
+            janDFA->AddNFA(rxnfaCur, c4Index);
+            m_fcolExprIds.c4AddElement(c4Index);
+        }
+    }
+
+    if (janLits->c4Count())
+    {
+        janLits->Complete();
+        m_prxlitsPats = janLits.pobjOrphan();
+    }
+
+    if (janDFA->c4Count())
+    {
+        janDFA->Complete();
+        m_prxsdfaPats = janDFA.pobjOrphan();
+    }
+    m_bReady = kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TRegExSet::DropMatchers() const
+{
+    TCritSecLocker crslSync(&m_crsSync);
+
+    delete m_prxlitsPats;
+    m_prxlitsPats = nullptr;
+    delete m_prxsdfaPats;
+    m_prxsdfaPats = nullptr;
+
+    m_bReady = kCIDLib::False;
+}
@@ -0,0 +1,187 @@
+//
+// FILE NAME: CIDRegX_RegExSet.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDRegX_RegExSet.cpp file, which implements the
+//  TRegExSet class. This is for when some input has to be checked against a
+//  list of patterns, e.g. a list of filters or routing rules. Instead of
+//  running each pattern separately, which gets slower with each rule added,
+//  this class matches all of them in a single pass over the input and tells
+//  you which ones matched.
+//
+//  Patterns are added one at a time and are identified by the index at which
+//  they were added. Each one is parsed via TRegEx, so the syntax is the same.
+//  Patterns that are just literal text go into an Aho-Corasick automaton, and
+//  the rest are combined into one lazily built DFA. Both of those are built
+//  the first time a match is done after patterns are added.
+//
+//  The semantics are the same as running each pattern via TRegEx, i.e. a find
+//  reports the patterns for which bFindMatch() (not only at start) would find
+//  a match, and a full match reports those for which bFullyMatches() would
+//  return true.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The match methods can be called from multiple threads, but patterns
+//      must not be added or the set reset while that is happening.
+//
+//  2)  If the patterns need more combined DFA states than are allowed, we
+//      fall back to running the non-literal patterns separately. That will
+//      only happen for patterns that would explode combinatorially anyway.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+class TRXLiteralSet;
+class TRXSetDFA;
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRegExSet
+//  PREFIX: rxset
+// ----------------------------------------------------------------------------
+class CIDREGXEXP TRegExSet : public TObject
+{
+    public :
+        // --------------------------------------------------------------------
+        //  Constructors and Destructor
+        // --------------------------------------------------------------------
+        TRegExSet();
+
+        TRegExSet(const TRegExSet&) = delete;
+        TRegExSet(TRegExSet&&) = delete;
+
+        ~TRegExSet();
+
+
+        // --------------------------------------------------------------------
+        //  Public operators
+        // --------------------------------------------------------------------
+        TRegExSet& operator=(const TRegExSet&) = delete;
+        TRegExSet& operator=(TRegExSet&&) = delete;
+
+
+        // --------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TCard4 c4AddPattern
+        (
+            const   TString&                strPattern
+        );
+
+        tCIDLib::TCard4 c4FindMatches
+        (
+            const   TString&                strFindIn
+            , COP   TFundVector<tCIDLib::TCard4>& fcolMatches
+            , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
+        )   const;
+
+        tCIDLib::TCard4 c4FindMatches
+        (
+            const   tCIDLib::TCh* const     pszFindIn
+            , COP   TFundVector<tCIDLib::TCard4>& fcolMatches
+            , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
+        )   const;
+
+        tCIDLib::TCard4 c4FullMatches
+        (
+            const   TString&                strToTest
+            , COP   TFundVector<tCIDLib::TCard4>& fcolMatches
+            , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
+        )   const;
+
+        tCIDLib::TCard4 c4FullMatches
+        (
+            const   tCIDLib::TCh* const     pszToTest
+            , COP   TFundVector<tCIDLib::TCard4>& fcolMatches
+            , const tCIDLib::TBoolean       bCaseSensitive = kCIDLib::False
+        )   const;
+
+        tCIDLib::TCard4 c4LiteralCount() const;
+
+        tCIDLib::TCard4 c4PatternCount() const;
+
+        tCIDLib::TVoid Reset();
+
+        TString strPatternAt
+        (
+            const   tCIDLib::TCard4         c4At
+        )   const;
+
+
+    private :
+        // --------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TCard4 c4MaskToList
+        (
+            const   tCIDLib::TCard4* const  pc4Mask
+            ,       TFundVector<tCIDLib::TCard4>& fcolToFill
+        )   const;
+
+        tCIDLib::TVoid CheckReady() const;
+
+        tCIDLib::TVoid DropMatchers() const;
+
+
+        // --------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bReady
+        //      Set once the matchers have been built for the current list of
+        //      patterns. Adding a pattern clears it.
+        //
+        //  m_c4MaskWords
+        //      The number of TCard4 words needed for a bit mask with a bit for
+        //      each pattern.
+        //
+        //  m_colExprs
+        //      The parsed patterns, in the order added.
+        //
+        //  m_crsSync
+        //      Used to sync building the matchers.
+        //
+        //  m_fcolExprIds
+        //      The ids of the patterns in the DFA, so that we can run them
+        //      separately if the DFA overflows.
+        //
+        //  m_prxlitsPats
+        //  m_prxsdfaPats
+        //      The literal and DFA matchers, either of which can be null if
+        //      there are no patterns of that type.
+        // --------------------------------------------------------------------
+        mutable tCIDLib::TBoolean               m_bReady;
+        mutable tCIDLib::TCard4                 m_c4MaskWords;
+        TRefVector<TRegEx>                      m_colExprs;
+        TCriticalSection                        m_crsSync;
+        mutable TFundVector<tCIDLib::TCard4>    m_fcolExprIds;
+        mutable TRXLiteralSet*                  m_prxlitsPats;
+        mutable TRXSetDFA*                      m_prxsdfaPats;
+
+
+        // --------------------------------------------------------------------
+        //  Magic macros
+        // --------------------------------------------------------------------
+        RTTIDefs(TRegExSet,TObject)
+};
+
+#pragma CIDLIB_POPPACK
@@ -0,0 +1,897 @@
+//
+// FILE NAME: CIDRegX_RegExSetInternal.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the internal TRXLiteralSet and TRXSetDFA classes,
+//  which do the work for TRegExSet.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include "CIDRegX_.hpp"
+#include "CIDRegX_RegExSet_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TRXLiteralSet,TObject)
+RTTIDecls(TRXSetDFA,TObject)
+
+
+namespace
+{
+    namespace CIDRegX_RegExSetInternal
+    {
+        // -----------------------------------------------------------------------
+        //  Local, const data
+        //
+        //  c4MaxStates
+        //      The most DFA states we'll create per mode before we give up
+        //      and let the caller run the patterns separately. It's larger
+        //      than the single pattern DFA's, since it's shared by all of
+        //      the patterns.
+        //
+        //  c4RootTransCount
+        //  c4TransCount
+        //      The number of characters we store transitions for in the
+        //      literal trie root node, and in each DFA state. Chars at or
+        //      above this are looked up or calculated each time.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxStates = 512;
+        constexpr tCIDLib::TCard4   c4RootTransCount = 256;
+        constexpr tCIDLib::TCard4   c4TransCount = 256;
+    }
+}
+
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRXLiteralSet
+//  PREFIX: rxlits
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TRXLiteralSet: Constructors and Destructor
+// ----------------------------------------------------------------------------
+TRXLiteralSet::TRXLiteralSet()
+{
+    TRawMem::SetMemBuf(&m_trieCase, tCIDLib::TCard1(0), sizeof(TTrie));
+    TRawMem::SetMemBuf(&m_trieNoCase, tCIDLib::TCard1(0), sizeof(TTrie));
+}
+
+TRXLiteralSet::~TRXLiteralSet()
+{
+    CleanupTrie(m_trieCase);
+    CleanupTrie(m_trieNoCase);
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRXLiteralSet: Public, non-virtual methods
+// ----------------------------------------------------------------------------
+tCIDLib::TVoid
+TRXLiteralSet::AddLiteral(const TString& strLiteral, const tCIDLib::TCard4 c4PatId)
+{
+    CIDAssert(!strLiteral.bIsEmpty(), L"Empty literals cannot be added to a literal set");
+    m_colLiterals.objAdd(strLiteral);
+    m_fcolPatIds.c4AddElement(c4PatId);
+}
+
+
+// Build the tries once all of the literals are added
+tCIDLib::TVoid TRXLiteralSet::Complete()
+{
+    CleanupTrie(m_trieCase);
+    CleanupTrie(m_trieNoCase);
+
+    BuildTrie(m_trieCase, kCIDLib::True);
+    BuildTrie(m_trieNoCase, kCIDLib::False);
+}
+
+
+//
+//  This is the standard Aho-Corasick search. At each char we follow failure
+//  links until we find a node that can move on that char (or get back to the
+//  root), and then we report the literals that end on the node we moved to
+//  or any node in its dictionary chain.
+//
+tCIDLib::TVoid
+TRXLiteralSet::FindMatches( const   tCIDLib::TCh* const     pszToSearch
+                            , const tCIDLib::TCard4         c4SearchLen
+                            , const tCIDLib::TBoolean       bCaseSensitive
+                            ,       tCIDLib::TCard4* const  pc4Mask) const
+{
+    const TTrie& trieSrc = bCaseSensitive ? m_trieCase : m_trieNoCase;
+    const tCIDLib::TCard4 c4LitCount = m_colLiterals.c4ElemCount();
+
+    tCIDLib::TCard4 c4Found = 0;
+    tCIDLib::TCard4 c4Node = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SearchLen; c4Index++)
+    {
+        const tCIDLib::TCh chCur = bCaseSensitive ? pszToSearch[c4Index]
+                                                  : TRawStr::chUpper(pszToSearch[c4Index]);
+
+        tCIDLib::TCard4 c4Next = c4Goto(trieSrc, c4Node, chCur);
+        while (c4Node && (c4Next == kCIDLib::c4MaxCard))
+        {
+            c4Node = trieSrc.pnodeList[c4Node].c4Fail;
+            c4Next = c4Goto(trieSrc, c4Node, chCur);
+        }
+        c4Node = (c4Next == kCIDLib::c4MaxCard) ? 0 : c4Next;
+
+        tCIDLib::TCard4 c4OutNode = c4Node;
+        if (trieSrc.pnodeList[c4OutNode].c4FirstOut == kCIDLib::c4MaxCard)
+            c4OutNode = trieSrc.pnodeList[c4OutNode].c4DictLink;
+
+        while (c4OutNode != kCIDLib::c4MaxCard)
+        {
+            const TNode& nodeOut = trieSrc.pnodeList[c4OutNode];
+            tCIDLib::TCard4 c4Lit = nodeOut.c4FirstOut;
+            while (c4Lit != kCIDLib::c4MaxCard)
+            {
+                const tCIDLib::TCard4 c4PatId = m_fcolPatIds[c4Lit];
+                const tCIDLib::TCard4 c4Bit = 0x1UL << (c4PatId & 0x1F);
+                if (!(pc4Mask[c4PatId >> 5] & c4Bit))
+                {
+                    pc4Mask[c4PatId >> 5] |= c4Bit;
+                    c4Found++;
+                }
+                c4Lit = trieSrc.pc4OutNext[c4Lit];
+            }
+            c4OutNode = nodeOut.c4DictLink;
+        }
+
+        // If we've found them all, no need to go further
+        if (c4Found == c4LitCount)
+            break;
+    }
+}
+
+
+//
+//  For a full match, we just follow the trie from the root. If we get to the
+//  end of the input, any literals that end at that node match.
+//
+tCIDLib::TVoid
+TRXLiteralSet::FullMatches( const   tCIDLib::TCh* const     pszToTest
+                            , const tCIDLib::TCard4         c4SearchLen
+                            , const tCIDLib::TBoolean       bCaseSensitive
+                            ,       tCIDLib::TCard4* const  pc4Mask) const
+{
+    const TTrie& trieSrc = bCaseSensitive ? m_trieCase : m_trieNoCase;
+
+    tCIDLib::TCard4 c4Node = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SearchLen; c4Index++)
+    {
+        const tCIDLib::TCh chCur = bCaseSensitive ? pszToTest[c4Index]
+                                                  : TRawStr::chUpper(pszToTest[c4Index]);
+        c4Node = c4Goto(trieSrc, c4Node, chCur);
+        if (c4Node == kCIDLib::c4MaxCard)
+            return;
+    }
+
+    tCIDLib::TCard4 c4Lit = trieSrc.pnodeList[c4Node].c4FirstOut;
+    while (c4Lit != kCIDLib::c4MaxCard)
+    {
+        const tCIDLib::TCard4 c4PatId = m_fcolPatIds[c4Lit];
+        pc4Mask[c4PatId >> 5] |= 0x1UL << (c4PatId & 0x1F);
+        c4Lit = trieSrc.pc4OutNext[c4Lit];
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRXLiteralSet: Private, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  Builds the trie for the literals, upper casing them if not case sensitive,
+//  then does a breadth first pass to set up the failure and dictionary links.
+//  The node count can't be more than one per literal char plus the root, so
+//  we can allocate the lists up front.
+//
+tCIDLib::TVoid
+TRXLiteralSet::BuildTrie(TTrie& trieTar, const tCIDLib::TBoolean bCaseSensitive)
+{
+    const tCIDLib::TCard4 c4LitCount = m_colLiterals.c4ElemCount();
+    tCIDLib::TCard4 c4MaxNodes = 1;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LitCount; c4Index++)
+        c4MaxNodes += m_colLiterals[c4Index].c4Length();
+
+    trieTar.pnodeList = new TNode[c4MaxNodes];
+    trieTar.pedgeList = new TEdge[c4MaxNodes];
+    trieTar.pc4OutNext = new tCIDLib::TCard4[c4LitCount];
+    TRawMem::SetMemBuf
+    (
+        trieTar.ac4RootTrans, kCIDLib::c4MaxCard, CIDRegX_RegExSetInternal::c4RootTransCount
+    );
+
+    trieTar.c4EdgeCount = 0;
+    trieTar.c4NodeCount = 1;
+    TNode& nodeRoot = trieTar.pnodeList[0];
+    nodeRoot.c4DictLink = kCIDLib::c4MaxCard;
+    nodeRoot.c4Fail = 0;
+    nodeRoot.c4FirstEdge = kCIDLib::c4MaxCard;
+    nodeRoot.c4FirstOut = kCIDLib::c4MaxCard;
+
+    for (tCIDLib::TCard4 c4LitInd = 0; c4LitInd < c4LitCount; c4LitInd++)
+    {
+        const TString& strCur = m_colLiterals[c4LitInd];
+        const tCIDLib::TCard4 c4Len = strCur.c4Length();
+
+        tCIDLib::TCard4 c4Node = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Len; c4Index++)
+        {
+            const tCIDLib::TCh chCur = bCaseSensitive ? strCur[c4Index]
+                                                      : TRawStr::chUpper(strCur[c4Index]);
+
+            tCIDLib::TCard4 c4Next = c4Goto(trieTar, c4Node, chCur);
+            if (c4Next == kCIDLib::c4MaxCard)
+            {
+                c4Next = trieTar.c4NodeCount++;
+                TNode& nodeNew = trieTar.pnodeList[c4Next];
+                nodeNew.c4DictLink = kCIDLib::c4MaxCard;
+                nodeNew.c4Fail = 0;
+                nodeNew.c4FirstEdge = kCIDLib::c4MaxCard;
+                nodeNew.c4FirstOut = kCIDLib::c4MaxCard;
+
+                const tCIDLib::TCard4 c4Edge = trieTar.c4EdgeCount++;
+                TEdge& edgeNew = trieTar.pedgeList[c4Edge];
+                edgeNew.chLabel = chCur;
+                edgeNew.c4Next = trieTar.pnodeList[c4Node].c4FirstEdge;
+                edgeNew.c4Target = c4Next;
+                trieTar.pnodeList[c4Node].c4FirstEdge = c4Edge;
+
+                if (!c4Node && (tCIDLib::TCard4(chCur) < CIDRegX_RegExSetInternal::c4RootTransCount))
+                    trieTar.ac4RootTrans[chCur] = c4Next;
+            }
+            c4Node = c4Next;
+        }
+
+        // Link this literal into the out list of the node it ends on
+        trieTar.pc4OutNext[c4LitInd] = trieTar.pnodeList[c4Node].c4FirstOut;
+        trieTar.pnodeList[c4Node].c4FirstOut = c4LitInd;
+    }
+
+    //
+    //  And now do the breadth first pass. The root's children fail back to
+    //  the root, which was set above. We queue them up to start.
+    //
+    tCIDLib::TCard4* pc4Queue = new tCIDLib::TCard4[trieTar.c4NodeCount];
+    TArrayJanitor<tCIDLib::TCard4> janQueue(pc4Queue);
+    tCIDLib::TCard4 c4QHead = 0;
+    tCIDLib::TCard4 c4QTail = 0;
+
+    tCIDLib::TCard4 c4Edge = nodeRoot.c4FirstEdge;
+    while (c4Edge != kCIDLib::c4MaxCard)
+    {
+        pc4Queue[c4QTail++] = trieTar.pedgeList[c4Edge].c4Target;
+        c4Edge = trieTar.pedgeList[c4Edge].c4Next;
+    }
+
+    while (c4QHead < c4QTail)
+    {
+        const tCIDLib::TCard4 c4Node = pc4Queue[c4QHead++];
+
+        c4Edge = trieTar.pnodeList[c4Node].c4FirstEdge;
+        while (c4Edge != kCIDLib::c4MaxCard)
+        {
+            const TEdge& edgeCur = trieTar.pedgeList[c4Edge];
+
+            //
+            //  The child's failure node is where our failure chain can move
+            //  on the same char, or the root if none can.
+            //
+            tCIDLib::TCard4 c4Fail = trieTar.pnodeList[c4Node].c4Fail;
+            tCIDLib::TCard4 c4Target = c4Goto(trieTar, c4Fail, edgeCur.chLabel);
+            while (c4Fail && (c4Target == kCIDLib::c4MaxCard))
+            {
+                c4Fail = trieTar.pnodeList[c4Fail].c4Fail;
+                c4Target = c4Goto(trieTar, c4Fail, edgeCur.chLabel);
+            }
+
+            TNode& nodeChild = trieTar.pnodeList[edgeCur.c4Target];
+            nodeChild.c4Fail = (c4Target == kCIDLib::c4MaxCard) ? 0 : c4Target;
+
+            const TNode& nodeFail = trieTar.pnodeList[nodeChild.c4Fail];
+            if (nodeFail.c4FirstOut != kCIDLib::c4MaxCard)
+                nodeChild.c4DictLink = nodeChild.c4Fail;
+            else
+                nodeChild.c4DictLink = nodeFail.c4DictLink;
+
+            pc4Queue[c4QTail++] = edgeCur.c4Target;
+            c4Edge = edgeCur.c4Next;
+        }
+    }
+}
+
+
+//
+//  Returns the node we move to from the indicated node on the indicated char,
+//  or c4MaxCard if there's no edge for it.
+//
+tCIDLib::TCard4
+TRXLiteralSet::c4Goto(  const   TTrie&          trieSrc
+                        , const tCIDLib::TCard4 c4From
+                        , const tCIDLib::TCh    chOn) const
+{
+    if (!c4From && (tCIDLib::TCard4(chOn) < CIDRegX_RegExSetInternal::c4RootTransCount))
+        return trieSrc.ac4RootTrans[chOn];
+
+    tCIDLib::TCard4 c4Edge = trieSrc.pnodeList[c4From].c4FirstEdge;
+    while (c4Edge != kCIDLib::c4MaxCard)
+    {
+        const TEdge& edgeCur = trieSrc.pedgeList[c4Edge];
+        if (edgeCur.chLabel == chOn)
+            return edgeCur.c4Target;
+        c4Edge = edgeCur.c4Next;
+    }
+    return kCIDLib::c4MaxCard;
+}
+
+
+tCIDLib::TVoid TRXLiteralSet::CleanupTrie(TTrie& trieTar)
+{
+    delete [] trieTar.pc4OutNext;
+    trieTar.pc4OutNext = nullptr;
+    delete [] trieTar.pedgeList;
+    trieTar.pedgeList = nullptr;
+    delete [] trieTar.pnodeList;
+    trieTar.pnodeList = nullptr;
+
+    trieTar.c4EdgeCount = 0;
+    trieTar.c4NodeCount = 0;
+}
+
+
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRXSetDFA
+//  PREFIX: rxsdfa
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TRXSetDFA: Constructors and Destructor
+// ----------------------------------------------------------------------------
+TRXSetDFA::TRXSetDFA(const  tCIDLib::TCard4 c4MaxNFAs
+                    , const tCIDLib::TCard4 c4MaskWords) :
+
+    m_bAccept(kCIDLib::False)
+    , m_c4GlobalCount(0)
+    , m_c4MaskWords(c4MaskWords)
+    , m_c4MaxNFAs(c4MaxNFAs)
+    , m_c4NFACount(0)
+    , m_c4Pass(0)
+    , m_c4SetCount(0)
+    , m_c4StackTop(0)
+    , m_c4StartCount(0)
+    , m_pc4AccMask(nullptr)
+    , m_pc4AllMask(nullptr)
+    , m_pc4Bases(nullptr)
+    , m_pc4Marks(nullptr)
+    , m_pc4NFAOf(nullptr)
+    , m_pc4PatIds(nullptr)
+    , m_pc4Set(nullptr)
+    , m_pc4Stack(nullptr)
+    , m_pc4StartSet(nullptr)
+    , m_prxnfaList(nullptr)
+{
+    m_pc4AccMask = new tCIDLib::TCard4[m_c4MaskWords];
+    TRawMem::SetMemBuf(m_pc4AccMask, tCIDLib::TCard4(0), m_c4MaskWords);
+    m_pc4AllMask = new tCIDLib::TCard4[m_c4MaskWords];
+    TRawMem::SetMemBuf(m_pc4AllMask, tCIDLib::TCard4(0), m_c4MaskWords);
+
+    m_pc4Bases = new tCIDLib::TCard4[m_c4MaxNFAs];
+    m_pc4PatIds = new tCIDLib::TCard4[m_c4MaxNFAs];
+    m_prxnfaList = new const TRegExNFA*[m_c4MaxNFAs];
+
+    // The caches are set up in Complete()
+    TStateCache* apcacheList[4] =
+    {
+        &m_cacheFindCase, &m_cacheFindNoCase, &m_cacheFullCase, &m_cacheFullNoCase
+    };
+    for (tCIDLib::TCard4 c4CacheInd = 0; c4CacheInd < 4; c4CacheInd++)
+    {
+        apcacheList[c4CacheInd]->c4StateCount = 0;
+        apcacheList[c4CacheInd]->pdstList = nullptr;
+    }
+}
+
+TRXSetDFA::~TRXSetDFA()
+{
+    TStateCache* apcacheList[4] =
+    {
+        &m_cacheFindCase, &m_cacheFindNoCase, &m_cacheFullCase, &m_cacheFullNoCase
+    };
+    for (tCIDLib::TCard4 c4CacheInd = 0; c4CacheInd < 4; c4CacheInd++)
+    {
+        TStateCache& cacheCur = *apcacheList[c4CacheInd];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < cacheCur.c4StateCount; c4Index++)
+            delete [] cacheCur.pdstList[c4Index].pc4Trans;
+        delete [] cacheCur.pdstList;
+        cacheCur.pdstList = nullptr;
+    }
+
+    delete [] m_pc4AccMask;
+    delete [] m_pc4AllMask;
+    delete [] m_pc4Bases;
+    delete [] m_pc4Marks;
+    delete [] m_pc4NFAOf;
+    delete [] m_pc4PatIds;
+    delete [] m_pc4Set;
+    delete [] m_pc4Stack;
+    delete [] m_pc4StartSet;
+    delete [] m_prxnfaList;
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRXSetDFA: Public, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  Add another NFA. Its states are numbered globally after those of the ones
+//  already added.
+//
+tCIDLib::TVoid
+TRXSetDFA::AddNFA(const TRegExNFA& rxnfaToAdd, const tCIDLib::TCard4 c4PatId)
+{
+    CIDAssert(m_c4NFACount < m_c4MaxNFAs, L"Too many NFAs added to the set DFA");
+
+    m_prxnfaList[m_c4NFACount] = &rxnfaToAdd;
+    m_pc4Bases[m_c4NFACount] = m_c4GlobalCount;
+    m_pc4PatIds[m_c4NFACount] = c4PatId;
+    m_pc4AllMask[c4PatId >> 5] |= 0x1UL << (c4PatId & 0x1F);
+
+    m_c4GlobalCount += rxnfaToAdd.c4StateCount();
+    m_c4NFACount++;
+}
+
+
+//
+//  Run all of the patterns across the input, with the start states added in at
+//  each position, and OR in the ids of the patterns whose end is reached. We go
+//  one past the end, to let the 'at end' matchers see the end. We can stop once
+//  all of the patterns have matched.
+//
+tCIDLib::TBoolean
+TRXSetDFA::bFindMatches(const   tCIDLib::TCh* const     pszToSearch
+                        , const tCIDLib::TCard4         c4SearchLen
+                        , const tCIDLib::TBoolean       bCaseSensitive
+                        ,       tCIDLib::TCard4* const  pc4Mask)
+{
+    TCritSecLocker crslSync(&m_crsSync);
+
+    TStateCache& cacheTar = bCaseSensitive ? m_cacheFindCase : m_cacheFindNoCase;
+    if (cacheTar.bOverflowed)
+        return kCIDLib::False;
+
+    tCIDLib::TCard4 c4CurState = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index <= c4SearchLen; c4Index++)
+    {
+        c4CurState = c4NextState(cacheTar, c4CurState, pszToSearch, c4Index, c4SearchLen);
+        if (c4CurState == kCIDLib::c4MaxCard)
+            return kCIDLib::False;
+
+        if (cacheTar.pdstList[c4CurState].bAccept)
+        {
+            MergeMask(cacheTar, c4CurState, pc4Mask);
+            if (bAllFound(pc4Mask))
+                break;
+        }
+    }
+    return kCIDLib::True;
+}
+
+
+//
+//  Run all of the patterns across the whole input. Any that have reached the
+//  end at the end of the input match. As with TRegExDFA, we then let them see
+//  the end of the input, in case of 'at end' matchers. The caller handles the
+//  empty input case.
+//
+tCIDLib::TBoolean
+TRXSetDFA::bFullMatches(const   tCIDLib::TCh* const     pszToTest
+                        , const tCIDLib::TCard4         c4SearchLen
+                        , const tCIDLib::TBoolean       bCaseSensitive
+                        ,       tCIDLib::TCard4* const  pc4Mask)
+{
+    TCritSecLocker crslSync(&m_crsSync);
+
+    TStateCache& cacheTar = bCaseSensitive ? m_cacheFullCase : m_cacheFullNoCase;
+    if (cacheTar.bOverflowed)
+        return kCIDLib::False;
+
+    tCIDLib::TCard4 c4CurState = c4StartState(cacheTar);
+    if (c4CurState == kCIDLib::c4MaxCard)
+        return kCIDLib::False;
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SearchLen; c4Index++)
+    {
+        c4CurState = c4NextState(cacheTar, c4CurState, pszToTest, c4Index, c4SearchLen);
+        if (c4CurState == kCIDLib::c4MaxCard)
+            return kCIDLib::False;
+
+        // If we hit the dead state, nothing can match
+        if (!c4CurState)
+            return kCIDLib::True;
+    }
+    MergeMask(cacheTar, c4CurState, pc4Mask);
+
+    c4CurState = c4NextState(cacheTar, c4CurState, pszToTest, c4SearchLen, c4SearchLen);
+    if (c4CurState == kCIDLib::c4MaxCard)
+        return kCIDLib::False;
+    MergeMask(cacheTar, c4CurState, pc4Mask);
+
+    return kCIDLib::True;
+}
+
+
+//
+//  Once all of the NFAs are added, we can allocate the work buffers, find the
+//  start set, and set up the caches.
+//
+tCIDLib::TVoid TRXSetDFA::Complete()
+{
+    m_pc4NFAOf = new tCIDLib::TCard4[m_c4GlobalCount];
+    for (tCIDLib::TCard4 c4NFAInd = 0; c4NFAInd < m_c4NFACount; c4NFAInd++)
+    {
+        TRawMem::SetMemBuf
+        (
+            &m_pc4NFAOf[m_pc4Bases[c4NFAInd]]
+            , c4NFAInd
+            , m_prxnfaList[c4NFAInd]->c4StateCount()
+        );
+    }
+
+    m_pc4Marks = new tCIDLib::TCard4[m_c4GlobalCount];
+    TRawMem::SetMemBuf(m_pc4Marks, tCIDLib::TCard4(0), m_c4GlobalCount);
+    m_pc4Set = new tCIDLib::TCard4[m_c4GlobalCount];
+    m_pc4Stack = new tCIDLib::TCard4[m_c4GlobalCount];
+
+    NewPass();
+    for (tCIDLib::TCard4 c4NFAInd = 0; c4NFAInd < m_c4NFACount; c4NFAInd++)
+        AddTarget(c4NFAInd, m_prxnfaList[c4NFAInd]->c4State1At(0));
+    CloseOver();
+
+    m_c4StartCount = m_c4SetCount;
+    m_pc4StartSet = new tCIDLib::TCard4[m_c4GlobalCount];
+    TRawMem::CopyMemBuf(m_pc4StartSet, m_pc4Set, m_c4SetCount * sizeof(tCIDLib::TCard4));
+
+    InitCache(m_cacheFindCase, kCIDLib::False, kCIDLib::True);
+    InitCache(m_cacheFindNoCase, kCIDLib::False, kCIDLib::False);
+    InitCache(m_cacheFullCase, kCIDLib::True, kCIDLib::True);
+    InitCache(m_cacheFullNoCase, kCIDLib::True, kCIDLib::False);
+}
+
+
+// ----------------------------------------------------------------------------
+//  TRXSetDFA: Private, non-virtual methods
+// ----------------------------------------------------------------------------
+
+//
+//  Push a target state of an NFA on the work stack if not already seen in this
+//  pass. Zero means the end of that NFA's pattern, so we set its bit in the
+//  accept mask.
+//
+tCIDLib::TVoid
+TRXSetDFA::AddTarget(const tCIDLib::TCard4 c4NFAInd, const tCIDLib::TCard4 c4Target)
+{
+    if (!c4Target)
+    {
+        const tCIDLib::TCard4 c4PatId = m_pc4PatIds[c4NFAInd];
+        m_pc4AccMask[c4PatId >> 5] |= 0x1UL << (c4PatId & 0x1F);
+        m_bAccept = kCIDLib::True;
+        return;
+    }
+
+    const tCIDLib::TCard4 c4Global = m_pc4Bases[c4NFAInd] + c4Target;
+    if (m_pc4Marks[c4Global] != m_c4Pass)
+    {
+        m_pc4Marks[c4Global] = m_c4Pass;
+        m_pc4Stack[m_c4StackTop++] = c4Global;
+    }
+}
+
+
+// Returns true if all of our patterns' bits are set in the passed mask
+tCIDLib::TBoolean TRXSetDFA::bAllFound(const tCIDLib::TCard4* const pc4Mask) const
+{
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4MaskWords; c4Index++)
+    {
+        if ((pc4Mask[c4Index] & m_pc4AllMask[c4Index]) != m_pc4AllMask[c4Index])
+            return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
+//
+//  Looks for a state for the set and accept mask left by the last CloseOver()
+//  call. If not found, we add one, if we have room. If not, we mark the cache
+//  as overflowed and return c4MaxCard.
+//
+tCIDLib::TCard4 TRXSetDFA::c4AddOrFindState(TStateCache& cacheTar)
+{
+    tCIDLib::TCard4 c4Hash = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4MaskWords; c4Index++)
+        c4Hash = (c4Hash * 31) + m_pc4AccMask[c4Index];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4SetCount; c4Index++)
+        c4Hash = (c4Hash * 31) + m_pc4Set[c4Index];
+
+    const tCIDLib::TCard4 c4MaskBytes = m_c4MaskWords * sizeof(tCIDLib::TCard4);
+    const tCIDLib::TCard4* pc4Masks = cacheTar.fcolMasks.ptElements();
+    const tCIDLib::TCard4* pc4Sets = cacheTar.fcolSets.ptElements();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < cacheTar.c4StateCount; c4Index++)
+    {
+        const TDState& dstCur = cacheTar.pdstList[c4Index];
+        if ((dstCur.c4Hash != c4Hash) || (dstCur.c4SetCount != m_c4SetCount))
+            continue;
+
+        if (!TRawMem::bCompareMemBuf(&pc4Masks[dstCur.c4MaskOfs], m_pc4AccMask, c4MaskBytes))
+            continue;
+
+        if (!m_c4SetCount
+        ||  TRawMem::bCompareMemBuf(&pc4Sets[dstCur.c4SetOfs]
+                                    , m_pc4Set
+                                    , m_c4SetCount * sizeof(tCIDLib::TCard4)))
+        {
+            return c4Index;
+        }
+    }
+
+    if (cacheTar.c4StateCount >= CIDRegX_RegExSetInternal::c4MaxStates)
+    {
+        cacheTar.bOverflowed = kCIDLib::True;
+        return kCIDLib::c4MaxCard;
+    }
+
+    TDState& dstNew = cacheTar.pdstList[cacheTar.c4StateCount];
+    dstNew.bAccept = m_bAccept;
+    dstNew.c4Hash = c4Hash;
+    dstNew.c4MaskOfs = cacheTar.fcolMasks.c4ElemCount();
+    dstNew.c4SetOfs = cacheTar.fcolSets.c4ElemCount();
+    dstNew.c4SetCount = m_c4SetCount;
+    dstNew.pc4Trans = new tCIDLib::TCard4[CIDRegX_RegExSetInternal::c4TransCount];
+    TRawMem::SetMemBuf
+    (
+        dstNew.pc4Trans, kCIDLib::c4MaxCard, CIDRegX_RegExSetInternal::c4TransCount
+    );
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4MaskWords; c4Index++)
+        cacheTar.fcolMasks.c4AddElement(m_pc4AccMask[c4Index]);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4SetCount; c4Index++)
+        cacheTar.fcolSets.c4AddElement(m_pc4Set[c4Index]);
+
+    return cacheTar.c4StateCount++;
+}
+
+
+//
+//  Moves from a state on the input char at the indicated position. This is the
+//  same as in TRegExDFA, except that, for searches, the start set is also run
+//  on the char at every position within the input.
+//
+tCIDLib::TCard4
+TRXSetDFA::c4NextState(         TStateCache&        cacheTar
+                        , const tCIDLib::TCard4     c4From
+                        , const tCIDLib::TCh* const pszInput
+                        , const tCIDLib::TCard4     c4At
+                        , const tCIDLib::TCard4     c4SearchLen)
+{
+    const tCIDLib::TCh chCur = pszInput[c4At];
+    const tCIDLib::TCard4 c4Char = tCIDLib::TCard4(chCur);
+    const tCIDLib::TBoolean bCacheable
+    (
+        c4At
+        && (c4At < c4SearchLen)
+        && (c4Char < CIDRegX_RegExSetInternal::c4TransCount)
+    );
+
+    if (bCacheable)
+    {
+        const tCIDLib::TCard4 c4Ret = cacheTar.pdstList[c4From].pc4Trans[c4Char];
+        if (c4Ret != kCIDLib::c4MaxCard)
+            return c4Ret;
+    }
+
+    NewPass();
+    {
+        const TDState& dstFrom = cacheTar.pdstList[c4From];
+        StepStates
+        (
+            cacheTar.fcolSets.ptElements() + dstFrom.c4SetOfs
+            , dstFrom.c4SetCount
+            , chCur
+            , c4At
+            , c4SearchLen
+            , cacheTar.bCaseSensitive
+        );
+    }
+
+    if (!cacheTar.bFull && (c4At < c4SearchLen))
+    {
+        StepStates
+        (
+            m_pc4StartSet, m_c4StartCount, chCur, c4At, c4SearchLen, cacheTar.bCaseSensitive
+        );
+    }
+    CloseOver();
+
+    const tCIDLib::TCard4 c4Ret = c4AddOrFindState(cacheTar);
+    if (bCacheable && (c4Ret != kCIDLib::c4MaxCard))
+        cacheTar.pdstList[c4From].pc4Trans[c4Char] = c4Ret;
+    return c4Ret;
+}
+
+
+//
+//  Fault in the start state of a full match cache if not done yet. Unlike the
+//  start set, this one keeps the accept mask, for nullable patterns.
+//
+tCIDLib::TCard4 TRXSetDFA::c4StartState(TStateCache& cacheTar)
+{
+    if (cacheTar.c4StartState == kCIDLib::c4MaxCard)
+    {
+        NewPass();
+        for (tCIDLib::TCard4 c4NFAInd = 0; c4NFAInd < m_c4NFACount; c4NFAInd++)
+            AddTarget(c4NFAInd, m_prxnfaList[c4NFAInd]->c4State1At(0));
+        CloseOver();
+        cacheTar.c4StartState = c4AddOrFindState(cacheTar);
+    }
+    return cacheTar.c4StartState;
+}
+
+
+//
+//  Follows all of the epsilon transitions from the states on the work stack,
+//  then puts all of the non-epsilon global states marked in this pass into the
+//  set list, which leaves it sorted.
+//
+tCIDLib::TVoid TRXSetDFA::CloseOver()
+{
+    while (m_c4StackTop)
+    {
+        const tCIDLib::TCard4 c4Global = m_pc4Stack[--m_c4StackTop];
+        const tCIDLib::TCard4 c4NFAInd = m_pc4NFAOf[c4Global];
+        const TRegExNFA& rxnfaCur = *m_prxnfaList[c4NFAInd];
+        const tCIDLib::TCard4 c4Local = c4Global - m_pc4Bases[c4NFAInd];
+
+        if (rxnfaCur.bIsEpsilonState(c4Local))
+        {
+            const tCIDLib::TCard4 c41 = rxnfaCur.c4State1At(c4Local);
+            const tCIDLib::TCard4 c42 = rxnfaCur.c4State2At(c4Local);
+            AddTarget(c4NFAInd, c41);
+            if (c42 != c41)
+                AddTarget(c4NFAInd, c42);
+        }
+    }
+
+    m_c4SetCount = 0;
+    for (tCIDLib::TCard4 c4Global = 0; c4Global < m_c4GlobalCount; c4Global++)
+    {
+        if (m_pc4Marks[c4Global] != m_c4Pass)
+            continue;
+
+        const tCIDLib::TCard4 c4NFAInd = m_pc4NFAOf[c4Global];
+        const tCIDLib::TCard4 c4Local = c4Global - m_pc4Bases[c4NFAInd];
+        if (!m_prxnfaList[c4NFAInd]->bIsEpsilonState(c4Local))
+            m_pc4Set[m_c4SetCount++] = c4Global;
+    }
+}
+
+
+//
+//  Set up a cache. We create the empty set state, so it's always at index
+//  zero. For full matches, that's the dead state, so all of its transitions
+//  go back to itself. For searches it's where we start, since the start set
+//  is added in as we go.
+//
+tCIDLib::TVoid
+TRXSetDFA::InitCache(       TStateCache&        cacheTar
+                    , const tCIDLib::TBoolean   bFull
+                    , const tCIDLib::TBoolean   bCaseSensitive)
+{
+    cacheTar.bCaseSensitive = bCaseSensitive;
+    cacheTar.bFull = bFull;
+    cacheTar.bOverflowed = kCIDLib::False;
+    cacheTar.c4StartState = kCIDLib::c4MaxCard;
+    cacheTar.c4StateCount = 0;
+    cacheTar.pdstList = new TDState[CIDRegX_RegExSetInternal::c4MaxStates];
+
+    NewPass();
+    const tCIDLib::TCard4 c4Empty = c4AddOrFindState(cacheTar);
+    if (bFull)
+    {
+        TRawMem::SetMemBuf
+        (
+            cacheTar.pdstList[c4Empty].pc4Trans, c4Empty, CIDRegX_RegExSetInternal::c4TransCount
+        );
+    }
+}
+
+
+// OR the accept mask of the indicated state into the caller's mask
+tCIDLib::TVoid
+TRXSetDFA::MergeMask(const  TStateCache&            cacheSrc
+                    , const tCIDLib::TCard4         c4State
+                    ,       tCIDLib::TCard4* const  pc4Mask) const
+{
+    const TDState& dstSrc = cacheSrc.pdstList[c4State];
+    if (!dstSrc.bAccept)
+        return;
+
+    const tCIDLib::TCard4* pc4Src = cacheSrc.fcolMasks.ptElements() + dstSrc.c4MaskOfs;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4MaskWords; c4Index++)
+        pc4Mask[c4Index] |= pc4Src[c4Index];
+}
+
+
+//
+//  Start a new pass. As in TRegExDFA, we just bump the pass number instead of
+//  clearing the marks, unless it wraps.
+//
+tCIDLib::TVoid TRXSetDFA::NewPass()
+{
+    m_c4Pass++;
+    if (!m_c4Pass)
+    {
+        TRawMem::SetMemBuf(m_pc4Marks, tCIDLib::TCard4(0), m_c4GlobalCount);
+        m_c4Pass = 1;
+    }
+    m_bAccept = kCIDLib::False;
+    m_c4SetCount = 0;
+    m_c4StackTop = 0;
+    TRawMem::SetMemBuf(m_pc4AccMask, tCIDLib::TCard4(0), m_c4MaskWords);
+}
+
+
+// Run the passed global states on a char and push the targets of any that match
+tCIDLib::TVoid
+TRXSetDFA::StepStates(  const   tCIDLib::TCard4* const  pc4States
+                        , const tCIDLib::TCard4         c4Count
+                        , const tCIDLib::TCh            chCur
+                        , const tCIDLib::TCard4         c4At
+                        , const tCIDLib::TCard4         c4SearchLen
+                        , const tCIDLib::TBoolean       bCaseSensitive)
+{
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const tCIDLib::TCard4 c4Global = pc4States[c4Index];
+        const tCIDLib::TCard4 c4NFAInd = m_pc4NFAOf[c4Global];
+        const TRegExNFA& rxnfaCur = *m_prxnfaList[c4NFAInd];
+        const tCIDLib::TCard4 c4Local = c4Global - m_pc4Bases[c4NFAInd];
+
+        if (rxnfaCur.matchAt(c4Local).bMatches(chCur, c4At, c4SearchLen, bCaseSensitive))
+        {
+            const tCIDLib::TCard4 c41 = rxnfaCur.c4State1At(c4Local);
+            const tCIDLib::TCard4 c42 = rxnfaCur.c4State2At(c4Local);
+            AddTarget(c4NFAInd, c41);
+            if (c42 != c41)
+                AddTarget(c4NFAInd, c42);
+        }
+    }
+}
@@ -0,0 +1,464 @@
+//
+// FILE NAME: CIDRegX_RegExSet_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the internal header for the CIDRegX_RegExSetInternal.cpp file,
+//  which implements the two matchers that TRegExSet uses to match all of its
+//  patterns in a single pass over the input.
+//
+//  TRXLiteralSet handles patterns that are just literal text. It's an Aho-
+//  Corasick automaton, i.e. a trie of the literals with failure links, so
+//  that we can find all of the literals in one pass, no matter how many
+//  there are. There is a trie for case sensitive and one (upper cased) for
+//  case insensitive matching.
+//
+//  TRXSetDFA handles the rest. It's a lazily built DFA like TRegExDFA, but it
+//  runs the NFAs of all of the patterns at once. So each DFA state represents
+//  a set of states across all of the NFAs, and the patterns whose end has
+//  been reached. For searches (as opposed to full matches), the start states
+//  of all of the NFAs are added in at every position, so that one pass finds
+//  matches that start anywhere.
+//
+//  Both of them report results as a bit mask, where each bit represents the
+//  pattern id passed in when the literal or NFA was added. The caller sizes
+//  the mask for the whole set.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  As with TRegExDFA, transitions at the start and end of the input are
+//      never cached, since the position matchers care about them.
+//
+//  2)  TRXLiteralSet is not changed once Complete() is called, so it needs
+//      no sync. TRXSetDFA syncs access to its caches.
+//
+//  3)  Like TRegExDFA, the DFA has a state budget. If it's exceeded, the
+//      match methods return false and the caller has to fall back to
+//      running the patterns separately.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRXLiteralSet
+//  PREFIX: rxlits
+// ----------------------------------------------------------------------------
+class TRXLiteralSet : public TObject
+{
+    public :
+        // --------------------------------------------------------------------
+        //  Constructors and Destructor
+        // --------------------------------------------------------------------
+        TRXLiteralSet();
+
+        TRXLiteralSet(const TRXLiteralSet&) = delete;
+        TRXLiteralSet(TRXLiteralSet&&) = delete;
+
+        ~TRXLiteralSet();
+
+
+        // --------------------------------------------------------------------
+        //  Public operators
+        // --------------------------------------------------------------------
+        TRXLiteralSet& operator=(const TRXLiteralSet&) = delete;
+        TRXLiteralSet& operator=(TRXLiteralSet&&) = delete;
+
+
+        // --------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TVoid AddLiteral
+        (
+            const   TString&                strLiteral
+            , const tCIDLib::TCard4         c4PatId
+        );
+
+        tCIDLib::TCard4 c4Count() const
+        {
+            return m_colLiterals.c4ElemCount();
+        }
+
+        tCIDLib::TVoid Complete();
+
+        tCIDLib::TVoid FindMatches
+        (
+            const   tCIDLib::TCh* const     pszToSearch
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TCard4* const  pc4Mask
+        )   const;
+
+        tCIDLib::TVoid FullMatches
+        (
+            const   tCIDLib::TCh* const     pszToTest
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TCard4* const  pc4Mask
+        )   const;
+
+
+    private :
+        // --------------------------------------------------------------------
+        //  Private types
+        //
+        //  TEdge
+        //      A trie edge. The edges out of a node are a linked list, via
+        //      c4Next.
+        //
+        //  TNode
+        //      A trie node. c4FirstOut is the first literal that ends here,
+        //      and the others are linked via the trie's out list. c4DictLink
+        //      is the nearest node down the failure chain that has any
+        //      literals ending on it.
+        //
+        //  TTrie
+        //      A trie, its nodes, edges and out list. We also keep a direct
+        //      lookup table for the root node, which is where we spend much
+        //      of the time when there's no partial match in progress.
+        // --------------------------------------------------------------------
+        struct TEdge
+        {
+            tCIDLib::TCh        chLabel;
+            tCIDLib::TCard4     c4Next;
+            tCIDLib::TCard4     c4Target;
+        };
+
+        struct TNode
+        {
+            tCIDLib::TCard4     c4DictLink;
+            tCIDLib::TCard4     c4Fail;
+            tCIDLib::TCard4     c4FirstEdge;
+            tCIDLib::TCard4     c4FirstOut;
+        };
+
+        struct TTrie
+        {
+            tCIDLib::TCard4     ac4RootTrans[256];
+            tCIDLib::TCard4     c4EdgeCount;
+            tCIDLib::TCard4     c4NodeCount;
+            tCIDLib::TCard4*    pc4OutNext;
+            TEdge*              pedgeList;
+            TNode*              pnodeList;
+        };
+
+
+        // --------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TVoid BuildTrie
+        (
+                    TTrie&                  trieTar
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+        tCIDLib::TCard4 c4Goto
+        (
+            const   TTrie&                  trieSrc
+            , const tCIDLib::TCard4         c4From
+            , const tCIDLib::TCh            chOn
+        )   const;
+
+        tCIDLib::TVoid CleanupTrie
+        (
+                    TTrie&                  trieTar
+        );
+
+
+        // --------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_colLiterals
+        //  m_fcolPatIds
+        //      The literals added, and the pattern id of each one.
+        //
+        //  m_trieCase
+        //  m_trieNoCase
+        //      The tries for case sensitive and insensitive matching. The
+        //      latter is built from the upper cased literals. They are built
+        //      in Complete().
+        // --------------------------------------------------------------------
+        TVector<TString>                m_colLiterals;
+        TFundVector<tCIDLib::TCard4>    m_fcolPatIds;
+        TTrie                           m_trieCase;
+        TTrie                           m_trieNoCase;
+
+
+        // --------------------------------------------------------------------
+        //  Magic macros
+        // --------------------------------------------------------------------
+        RTTIDefs(TRXLiteralSet,TObject)
+};
+
+
+
+// ----------------------------------------------------------------------------
+//   CLASS: TRXSetDFA
+//  PREFIX: rxsdfa
+// ----------------------------------------------------------------------------
+class TRXSetDFA : public TObject
+{
+    public :
+        // --------------------------------------------------------------------
+        //  Constructors and Destructor
+        // --------------------------------------------------------------------
+        TRXSetDFA() = delete;
+
+        TRXSetDFA
+        (
+            const   tCIDLib::TCard4         c4MaxNFAs
+            , const tCIDLib::TCard4         c4MaskWords
+        );
+
+        TRXSetDFA(const TRXSetDFA&) = delete;
+        TRXSetDFA(TRXSetDFA&&) = delete;
+
+        ~TRXSetDFA();
+
+
+        // --------------------------------------------------------------------
+        //  Public operators
+        // --------------------------------------------------------------------
+        TRXSetDFA& operator=(const TRXSetDFA&) = delete;
+        TRXSetDFA& operator=(TRXSetDFA&&) = delete;
+
+
+        // --------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TVoid AddNFA
+        (
+            const   TRegExNFA&              rxnfaToAdd
+            , const tCIDLib::TCard4         c4PatId
+        );
+
+        tCIDLib::TBoolean bFindMatches
+        (
+            const   tCIDLib::TCh* const     pszToSearch
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TCard4* const  pc4Mask
+        );
+
+        tCIDLib::TBoolean bFullMatches
+        (
+            const   tCIDLib::TCh* const     pszToTest
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TCard4* const  pc4Mask
+        );
+
+        tCIDLib::TCard4 c4Count() const
+        {
+            return m_c4NFACount;
+        }
+
+        tCIDLib::TVoid Complete();
+
+
+    private :
+        // --------------------------------------------------------------------
+        //  Private types
+        //
+        //  TDState
+        //      A single DFA state. The global NFA states it represents are
+        //      in the cache's set list, and the pattern ids whose end it
+        //      represents are in the cache's mask list. bAccept is set if
+        //      any bits are set in the mask.
+        //
+        //  TStateCache
+        //      The DFA states for one mode, i.e. search or full match, case
+        //      sensitive or not. The first state is the empty set, which for
+        //      full matches is the dead state and for searches is where we
+        //      start.
+        // --------------------------------------------------------------------
+        struct TDState
+        {
+            tCIDLib::TBoolean   bAccept;
+            tCIDLib::TCard4     c4Hash;
+            tCIDLib::TCard4     c4MaskOfs;
+            tCIDLib::TCard4     c4SetOfs;
+            tCIDLib::TCard4     c4SetCount;
+            tCIDLib::TCard4*    pc4Trans;
+        };
+
+        struct TStateCache
+        {
+            tCIDLib::TBoolean               bCaseSensitive;
+            tCIDLib::TBoolean               bFull;
+            tCIDLib::TBoolean               bOverflowed;
+            tCIDLib::TCard4                 c4StartState;
+            tCIDLib::TCard4                 c4StateCount;
+            TDState*                        pdstList;
+            TFundVector<tCIDLib::TCard4>    fcolMasks;
+            TFundVector<tCIDLib::TCard4>    fcolSets;
+        };
+
+
+        // --------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // --------------------------------------------------------------------
+        tCIDLib::TVoid AddTarget
+        (
+            const   tCIDLib::TCard4         c4NFAInd
+            , const tCIDLib::TCard4         c4Target
+        );
+
+        tCIDLib::TBoolean bAllFound
+        (
+            const   tCIDLib::TCard4* const  pc4Mask
+        )   const;
+
+        tCIDLib::TCard4 c4AddOrFindState
+        (
+                    TStateCache&            cacheTar
+        );
+
+        tCIDLib::TCard4 c4NextState
+        (
+                    TStateCache&            cacheTar
+            , const tCIDLib::TCard4         c4From
+            , const tCIDLib::TCh* const     pszInput
+            , const tCIDLib::TCard4         c4At
+            , const tCIDLib::TCard4         c4SearchLen
+        );
+
+        tCIDLib::TCard4 c4StartState
+        (
+                    TStateCache&            cacheTar
+        );
+
+        tCIDLib::TVoid CloseOver();
+
+        tCIDLib::TVoid InitCache
+        (
+                    TStateCache&            cacheTar
+            , const tCIDLib::TBoolean       bFull
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+        tCIDLib::TVoid MergeMask
+        (
+            const   TStateCache&            cacheSrc
+            , const tCIDLib::TCard4         c4State
+            ,       tCIDLib::TCard4* const  pc4Mask
+        )   const;
+
+        tCIDLib::TVoid NewPass();
+
+        tCIDLib::TVoid StepStates
+        (
+            const   tCIDLib::TCard4* const  pc4States
+            , const tCIDLib::TCard4         c4Count
+            , const tCIDLib::TCh            chCur
+            , const tCIDLib::TCard4         c4At
+            , const tCIDLib::TCard4         c4SearchLen
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+
+        // --------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bAccept
+        //  m_c4SetCount
+        //  m_pc4AccMask
+        //  m_pc4Set
+        //      The results of the last CloseOver() call, i.e. whether the end
+        //      of any patterns were reached and which ones, and the (sorted)
+        //      global non-epsilon NFA states reached.
+        //
+        //  m_c4GlobalCount
+        //      The total of the state counts of the NFAs. Each NFA's states
+        //      are given global numbers, starting at its base.
+        //
+        //  m_c4MaskWords
+        //      The number of TCard4 words in the pattern masks.
+        //
+        //  m_c4MaxNFAs
+        //  m_c4NFACount
+        //  m_pc4Bases
+        //  m_pc4PatIds
+        //  m_prxnfaList
+        //      The NFAs we run, which must outlive us, the global state number
+        //      of each one's first state, and its pattern id.
+        //
+        //  m_c4Pass
+        //  m_pc4Marks
+        //      Used to mark global states visited during a pass.
+        //
+        //  m_c4StackTop
+        //  m_pc4Stack
+        //      The work stack used while finding the closure.
+        //
+        //  m_c4StartCount
+        //  m_pc4StartSet
+        //      The non-epsilon states reachable from the start states of all
+        //      of the NFAs. For searches, these are added in at each position.
+        //
+        //  m_cacheFindCase
+        //  m_cacheFindNoCase
+        //  m_cacheFullCase
+        //  m_cacheFullNoCase
+        //      The DFA states for each of our modes.
+        //
+        //  m_crsSync
+        //      Used to sync access to the caches and the work buffers.
+        //
+        //  m_pc4AllMask
+        //      The bits of all of our pattern ids, so that we can stop a search
+        //      once all of them have matched.
+        //
+        //  m_pc4NFAOf
+        //      For each global state, the index of the NFA it belongs to.
+        // --------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bAccept;
+        tCIDLib::TCard4         m_c4GlobalCount;
+        tCIDLib::TCard4         m_c4MaskWords;
+        tCIDLib::TCard4         m_c4MaxNFAs;
+        tCIDLib::TCard4         m_c4NFACount;
+        tCIDLib::TCard4         m_c4Pass;
+        tCIDLib::TCard4         m_c4SetCount;
+        tCIDLib::TCard4         m_c4StackTop;
+        tCIDLib::TCard4         m_c4StartCount;
+        TStateCache             m_cacheFindCase;
+        TStateCache             m_cacheFindNoCase;
+        TStateCache             m_cacheFullCase;
+        TStateCache             m_cacheFullNoCase;
+        TCriticalSection        m_crsSync;
+        tCIDLib::TCard4*        m_pc4AccMask;
+        tCIDLib::TCard4*        m_pc4AllMask;
+        tCIDLib::TCard4*        m_pc4Bases;
+        tCIDLib::TCard4*        m_pc4Marks;
+        tCIDLib::TCard4*        m_pc4NFAOf;
+        tCIDLib::TCard4*        m_pc4PatIds;
+        tCIDLib::TCard4*        m_pc4Set;
+        tCIDLib::TCard4*        m_pc4Stack;
+        tCIDLib::TCard4*        m_pc4StartSet;
+        const TRegExNFA**       m_prxnfaList;
+
+
+        // --------------------------------------------------------------------
+        //  Magic macros
+        // --------------------------------------------------------------------
+        RTTIDefs(TRXSetDFA,TObject)
+};
+
+#pragma CIDLIB_POPPACK
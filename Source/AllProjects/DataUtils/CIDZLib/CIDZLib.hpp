@@ -55,6 +55,7 @@
 #include    "CIDZLib_Type.hpp"
 #include    "CIDZLib_ErrorIds.hpp"
 #include    "CIDZLib_Compressor.hpp"
+#include    "CIDZLib_PushComp.hpp"
 #include    "CIDZLib_ThisFacility.hpp"
 
 
@@ -130,10 +130,21 @@ namespace tCIDZLib_
     //      Lit      : o: Waiting for output space to write literal
     //      Check    : i: Waiting for 32-bit check value
     //      Done     : Finished check, done -- remain here until reset
+    //
+    //  And these are for the gzip framing
+    //      GZHead   : i: Waiting for the fixed part of the header
+    //      GZFlags  : Decide what optional header fields are next
+    //      GZSkip   : i: Skipping bytes of the header we don't care about
+    //      GZString : i: Skipping a null terminated name or comment
+    //      GZSize   : i: Waiting for 32-bit uncompressed length
     // -----------------------------------------------------------------------
     enum class EInfModes
     {
         Head
+        , GZHead
+        , GZFlags
+        , GZSkip
+        , GZString
         , DictId
         , Dict
         , Type
@@ -149,10 +160,23 @@ namespace tCIDZLib_
         , Match
         , Lit
         , Check
+        , GZSize
         , Done
     };
 
 
+    // -----------------------------------------------------------------------
+    //  When we are being fed input in chunks, the inflate code throws this
+    //  when it runs out, so that it can unwind back out to the feeding code.
+    //  The state machine picks up where it left off next time. It never gets
+    //  out of the compressor impl class.
+    // -----------------------------------------------------------------------
+    enum class EInflSignals
+    {
+        NeedInput
+    };
+
+
     // -----------------------------------------------------------------------
     //  Used by InflateTable, to indicate to it what type of table to inflate.
     // -----------------------------------------------------------------------
@@ -252,9 +276,25 @@ namespace kCIDZLib_
 
 
     // -----------------------------------------------------------------------
-    //  Some buffer sizes
+    //  Some buffer sizes. The inflate table size is the worst case number of
+    //  entries needed for the length and distance code tables.
     // -----------------------------------------------------------------------
     constexpr tCIDLib::TCard4   c4LitBufSz      = 0x4000;
+    constexpr tCIDLib::TCard4   c4InflTblSz     = 1440;
+    constexpr tCIDLib::TCard4   c4InflLensSz    = 320;
+
+
+    // -----------------------------------------------------------------------
+    //  The gzip header magic bytes (in the order read as a little endian
+    //  short) and the flag bits of the header.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard2   c2GZipMagic     = 0x8B1F;
+    constexpr tCIDLib::TCard4   c4GZFlag_Text   = 0x01;
+    constexpr tCIDLib::TCard4   c4GZFlag_HdrCRC = 0x02;
+    constexpr tCIDLib::TCard4   c4GZFlag_Extra  = 0x04;
+    constexpr tCIDLib::TCard4   c4GZFlag_Name   = 0x08;
+    constexpr tCIDLib::TCard4   c4GZFlag_Comment= 0x10;
+    constexpr tCIDLib::TCard4   c4GZFlag_Resvd  = 0xE0;
 
 
     // -----------------------------------------------------------------------
@@ -314,6 +354,40 @@ namespace kCIDZLib_
 }
 
 
+// ---------------------------------------------------------------------------
+//  These types need to see the constants above
+// ---------------------------------------------------------------------------
+namespace tCIDZLib_
+{
+    // -----------------------------------------------------------------------
+    //  The state of the inflate state machine. This has to persist across
+    //  calls when we are being fed input in chunks, so it's kept by the impl
+    //  class instead of being locals of the inflate method. The pointers point
+    //  into the decoding table here, or at the fixed tables.
+    // -----------------------------------------------------------------------
+    struct TInflState
+    {
+        EInfModes           eState;
+        TCode               acdTable[kCIDZLib_::c4InflTblSz];
+        tCIDLib::TCard2     ac2Lens[kCIDZLib_::c4InflLensSz];
+        tCIDLib::TBoolean   bLastBlock;
+        tCIDLib::TCard4     c4DistBits;
+        tCIDLib::TCard4     c4Extra;
+        tCIDLib::TCard4     c4GZFlags;
+        tCIDLib::TCard4     c4Length;
+        tCIDLib::TCard4     c4LenBits;
+        tCIDLib::TCard4     c4LensCount;
+        tCIDLib::TCard4     c4NumCodes;
+        tCIDLib::TCard4     c4NumLens;
+        tCIDLib::TCard4     c4NumDists;
+        tCIDLib::TCard4     c4Offset;
+        const TCode*        pcdDist;
+        const TCode*        pcdLen;
+        TCode*              pcdNext;
+    };
+}
+
+
 // ---------------------------------------------------------------------------
 //  This header needs to see the constants above
 // ---------------------------------------------------------------------------
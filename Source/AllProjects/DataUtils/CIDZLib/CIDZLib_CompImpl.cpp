@@ -46,21 +46,102 @@ RTTIDecls(TZLibCompImpl,TObject)
 // PREFIX: zlib
 // ---------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------
+//  TZLibCompImpl: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Given the Adler-32 of two consecutive chunks of data, and the length of the
+//  second one, calculate the Adler-32 of the whole thing. This lets parallel
+//  compression hash each segment separately. The math is the same as zlib's
+//  adler32_combine().
+//
+tCIDLib::TCard4
+TZLibCompImpl::c4CombineAdler32(const   tCIDLib::TCard4 c4Adler1
+                                , const tCIDLib::TCard4 c4Adler2
+                                , const tCIDLib::TCard4 c4Len2)
+{
+    constexpr tCIDLib::TCard4 c4Base = 65521;
+
+    const tCIDLib::TCard4 c4Rem = c4Len2 % c4Base;
+    tCIDLib::TCard4 c4Sum1 = c4Adler1 & 0xFFFF;
+    tCIDLib::TCard4 c4Sum2 = (c4Rem * c4Sum1) % c4Base;
+
+    c4Sum1 += (c4Adler2 & 0xFFFF) + c4Base - 1;
+    c4Sum2 += (c4Adler1 >> 16) + (c4Adler2 >> 16) + c4Base - c4Rem;
+
+    if (c4Sum1 >= c4Base)
+        c4Sum1 -= c4Base;
+    if (c4Sum1 >= c4Base)
+        c4Sum1 -= c4Base;
+    if (c4Sum2 >= (c4Base << 1))
+        c4Sum2 -= (c4Base << 1);
+    if (c4Sum2 >= c4Base)
+        c4Sum2 -= c4Base;
+
+    return c4Sum1 | (c4Sum2 << 16);
+}
+
+
+//
+//  Writes out the trailer for the indicated format. The check value is the
+//  Adler-32 for zlib or the (final) CRC-32 for gzip. The length is only used
+//  by gzip. We return the number of bytes written.
+//
+tCIDLib::TCard4
+TZLibCompImpl::c4PutStreamTrailer(          TBinOutStream&      strmOutput
+                                    , const tCIDZLib::EFormats  eFormat
+                                    , const tCIDLib::TCard4     c4Check
+                                    , const tCIDLib::TCard4     c4DataLen)
+{
+    if (eFormat == tCIDZLib::EFormats::ZLib)
+    {
+        strmOutput  << tCIDLib::TCard1(c4Check >> 24)
+                    << tCIDLib::TCard1((c4Check >> 16) & 0xFF)
+                    << tCIDLib::TCard1((c4Check >> 8) & 0xFF)
+                    << tCIDLib::TCard1(c4Check & 0xFF);
+        return 4;
+    }
+
+    if (eFormat == tCIDZLib::EFormats::GZip)
+    {
+        strmOutput  << tCIDLib::TCard1(c4Check & 0xFF)
+                    << tCIDLib::TCard1((c4Check >> 8) & 0xFF)
+                    << tCIDLib::TCard1((c4Check >> 16) & 0xFF)
+                    << tCIDLib::TCard1(c4Check >> 24)
+                    << tCIDLib::TCard1(c4DataLen & 0xFF)
+                    << tCIDLib::TCard1((c4DataLen >> 8) & 0xFF)
+                    << tCIDLib::TCard1((c4DataLen >> 16) & 0xFF)
+                    << tCIDLib::TCard1(c4DataLen >> 24);
+        return 8;
+    }
+
+    // Raw has no trailer
+    return 0;
+}
+
+
 // ---------------------------------------------------------------------------
 //  TZLibCompImpl: Constructors and Destructor
 // ---------------------------------------------------------------------------
 TZLibCompImpl::TZLibCompImpl(const  tCIDZLib::ECompLevels   eLevel
                             , const tCIDZLib_::EStrategies  eStrategy) :
     m_bEndOfInput(kCIDLib::True)
+    , m_bFeedMode(kCIDLib::False)
+    , m_bFinalSeg(kCIDLib::True)
     , m_bInitialized(kCIDLib::False)
     , m_c2BitBuf(0)
     , m_c4BitCount(0)
     , m_c2LastEOBLen(0)
     , m_c4Adler(1)
     , m_c4BytesAvail(0)
+    , m_c4CRC(kCIDLib::c4MaxCard)
     , m_c4CurOfs(0)
+    , m_c4FeedOfs(0)
+    , m_c4FeedSz(0)
     , m_c4GoodLen(0)
     , m_c4InflBuf(0)
+    , m_c4InflFlushed(0)
     , m_c4InputBytes(0)
     , m_c4MaxChainLen(0)
     , m_c4MaxLazyLen(0)
@@ -69,6 +150,7 @@ TZLibCompImpl::TZLibCompImpl(const  tCIDZLib::ECompLevels   eLevel
     , m_c4TotalOut(0)
     , m_eCompLevel(eLevel)
     , m_eDataType(tCIDZLib_::EDataTypes::Unknown)
+    , m_eFormat(tCIDZLib::EFormats::ZLib)
     , m_eMode(tCIDZLib_::EModes::Compress)
     , m_eStrategy(eStrategy)
     , m_pc1LLAccum(nullptr)
@@ -76,6 +158,8 @@ TZLibCompImpl::TZLibCompImpl(const  tCIDZLib::ECompLevels   eLevel
     , m_pc2DistAccum(nullptr)
     , m_pc2HashPrev(nullptr)
     , m_pc2HashTbl(nullptr)
+    , m_pc1FeedBuf(nullptr)
+    , m_pc1SrcBuf(nullptr)
     , m_tdDynBitLen((kCIDZLib_::c4BitLenCodes * 2) + 1, &s_stdBitLen)
     , m_tdDynDist((kCIDZLib_::c4DistCodes * 2) + 1, &s_stdDist)
     , m_tdDynLens(kCIDZLib_::c4HeapSz, &s_stdLens)
@@ -89,6 +173,9 @@ TZLibCompImpl::TZLibCompImpl(const  tCIDZLib::ECompLevels   eLevel
     m_c4MaxLazyLen = kCIDZLib_::aStratTable[c4TblIndex].c4MaxLazyLen;
     m_c4NiceLen = kCIDZLib_::aStratTable[c4TblIndex].c4NiceLen;
 
+    // Make sure the inflate state is sane until we actually start one
+    InitInflate();
+
     // Allocate our major buffers
     m_pc1LLAccum   = new tCIDLib::TCard1[kCIDZLib_::c4WndSz];
     m_pc2DistAccum = new tCIDLib::TCard2[kCIDZLib_::c4WndSz];
@@ -111,6 +198,54 @@ TZLibCompImpl::~TZLibCompImpl()
 // ---------------------------------------------------------------------------
 //  TZLibCompImpl: Public, non-virtual methods
 // ---------------------------------------------------------------------------
+
+//
+//  In feed mode, this is called with each new chunk of compressed input. We
+//  decompress as much as we can, write out everything we decoded, and return
+//  true once we've seen the end of the stream. StartFeedInflate() must be
+//  called first. Once the end is seen, any further input is just ignored.
+//
+tCIDLib::TBoolean
+TZLibCompImpl::bFeedInflate(const   tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4Count
+                            ,       TBinOutStream&          strmOutput)
+{
+    if (m_infsCur.eState == tCIDZLib_::EInfModes::Done)
+        return kCIDLib::True;
+
+    m_pstrmOut = &strmOutput;
+    m_pc1FeedBuf = pc1Data;
+    m_c4FeedSz = c4Count;
+    m_c4FeedOfs = 0;
+
+    try
+    {
+        Inflate(kCIDLib::False);
+    }
+
+    catch(const tCIDZLib_::EInflSignals&)
+    {
+        //
+        //  We ran out of input, which is fine. The state machine will pick up
+        //  where it left off next time.
+        //
+    }
+
+    //
+    //  Write out everything we have so far. It stays in the window for any
+    //  back references, but the caller gets all the data the input so far
+    //  has produced.
+    //
+    WriteInflOut(m_c4BytesAvail);
+
+    m_pc1FeedBuf = nullptr;
+    m_c4FeedSz = 0;
+    m_c4FeedOfs = 0;
+
+    return (m_infsCur.eState == tCIDZLib_::EInfModes::Done);
+}
+
+
 tCIDLib::TCard4
 TZLibCompImpl::c4Compress(          TBinInStream&   strmInput
                             ,       TBinOutStream&  strmOutput
@@ -122,7 +257,9 @@ TZLibCompImpl::c4Compress(          TBinInStream&   strmInput
     // Store the stream info for use by the various methods
     m_pstrmIn = &strmInput;
     m_pstrmOut = &strmOutput;
+    m_pc1SrcBuf = nullptr;
     m_c4InputBytes = c4InputBytes;
+    m_bFinalSeg = kCIDLib::True;
 
     // Reset for a new compression run and then do it
     Reset();
@@ -132,6 +269,60 @@ TZLibCompImpl::c4Compress(          TBinInStream&   strmInput
 }
 
 
+//
+//  Compresses one segment of a parallel compression operation. The output is raw
+//  deflate data, no stream header or trailer, since the caller is going to stitch
+//  the segments together. The dictionary is the (up to) 32K of input that came
+//  before this segment, so that we can still find matches that reach back into
+//  the previous segment.
+//
+//  If this is not the last segment, we end with an empty stored block (a sync
+//  flush in zlib terms) so that the output is byte aligned and the next segment
+//  can just be appended.
+//
+//  We return the Adler-32 of the data, which the caller combines with the others.
+//
+tCIDLib::TCard4
+TZLibCompImpl::c4CompressSeg(const  tCIDLib::TCard1* const  pc1Dict
+                            , const tCIDLib::TCard4         c4DictSz
+                            , const tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4DataSz
+                            , const tCIDLib::TBoolean       bLastSeg
+                            ,       TBinOutStream&          strmOutput)
+{
+    m_eMode = tCIDZLib_::EModes::Compress;
+
+    // We read from the memory buffer, not a stream
+    m_pstrmIn = nullptr;
+    m_pstrmOut = &strmOutput;
+    m_pc1SrcBuf = pc1Data;
+    m_c4InputBytes = c4DataSz;
+    m_bFinalSeg = bLastSeg;
+
+    Reset();
+    if (c4DictSz)
+        PrimeDict(pc1Dict, c4DictSz);
+
+    CompressData();
+
+    if (!bLastSeg)
+    {
+        SendBits(kCIDZLib_::c1NoComp << 1, 3);
+        FlushBitBuf();
+        PutShortLSB(0);
+        PutShortLSB(0xFFFF);
+    }
+     else
+    {
+        FlushBitBuf();
+    }
+
+    m_pc1SrcBuf = nullptr;
+    strmOutput.Flush();
+    return m_c4Adler;
+}
+
+
 tCIDLib::TCard4
 TZLibCompImpl::c4Decompress(        TBinInStream&   strmInput
                             ,       TBinOutStream&  strmOutput
@@ -143,10 +334,13 @@ TZLibCompImpl::c4Decompress(        TBinInStream&   strmInput
     // Store the stream info for use by the various methods
     m_pstrmIn = &strmInput;
     m_pstrmOut = &strmOutput;
+    m_pc1SrcBuf = nullptr;
     m_c4InputBytes = c4InputBytes;
 
     // Reset for a new decompression run, and then do it
+    m_bFeedMode = kCIDLib::False;
     Reset();
+    InitInflate();
 
     // Indicate no dictionary
     Inflate(kCIDLib::False);
@@ -155,6 +349,121 @@ TZLibCompImpl::c4Decompress(        TBinInStream&   strmInput
 }
 
 
+//
+//  Writes out the stream header for our format, and returns the number of
+//  bytes written. The parallel and push compressors need to write this
+//  themselves since they stitch together segments.
+//
+tCIDLib::TCard4 TZLibCompImpl::c4PutStreamHeader(TBinOutStream& strmOutput) const
+{
+    if (m_eFormat == tCIDZLib::EFormats::ZLib)
+    {
+        const tCIDLib::TCard2 c2Header = c2StreamHeader();
+        strmOutput  << tCIDLib::TCard1(c2Header >> 8)
+                    << tCIDLib::TCard1(c2Header & 0xFF);
+        return 2;
+    }
+
+    if (m_eFormat == tCIDZLib::EFormats::GZip)
+    {
+        // The extra flags byte indicates max compression or fastest
+        tCIDLib::TCard1 c1XFlags = 0;
+        if (m_eCompLevel == tCIDZLib::ECompLevels::BestCompr)
+            c1XFlags = 2;
+        else if (m_eCompLevel == tCIDZLib::ECompLevels::BestSpeed)
+            c1XFlags = 4;
+
+        //
+        //  Magic bytes, method, no flags, no time stamp, extra flags, and
+        //  an unknown OS.
+        //
+        strmOutput  << tCIDLib::TCard1(kCIDZLib_::c2GZipMagic & 0xFF)
+                    << tCIDLib::TCard1(kCIDZLib_::c2GZipMagic >> 8)
+                    << tCIDLib::TCard1(tCIDZLib_::ECompMethods::Deflated)
+                    << tCIDLib::TCard1(0)
+                    << tCIDLib::TCard1(0)
+                    << tCIDLib::TCard1(0)
+                    << tCIDLib::TCard1(0)
+                    << tCIDLib::TCard1(0)
+                    << c1XFlags
+                    << tCIDLib::TCard1(0xFF);
+        return 10;
+    }
+
+    // Raw has no header
+    return 0;
+}
+
+
+//
+//  Builds the two byte zlib stream header for our compression level and
+//  strategy.
+//
+tCIDLib::TCard2 TZLibCompImpl::c2StreamHeader() const
+{
+    tCIDLib::TCard2 c2Header = tCIDLib::TCard2
+    (
+        (tCIDLib::TCard2(tCIDZLib_::ECompMethods::Deflated) + ((kCIDZLib_::c4WndBits - 8) << 4)) << 8
+    );
+
+    tCIDLib::TCard2 c2LvlFlags;
+    if ((m_eStrategy >= tCIDZLib_::EStrategies::HuffmanOnly)
+    ||  (m_eCompLevel < tCIDZLib::ECompLevels::L2))
+    {
+        c2LvlFlags = 0;
+    }
+     else if (m_eCompLevel < tCIDZLib::ECompLevels::L6)
+    {
+        c2LvlFlags = 1;
+    }
+     else if (m_eCompLevel == tCIDZLib::ECompLevels::L6)
+    {
+        c2LvlFlags = 2;
+    }
+     else
+    {
+        c2LvlFlags = 3;
+    }
+
+    c2Header |= (c2LvlFlags << 6);
+    c2Header += 31 - (c2Header % 31);
+    return c2Header;
+}
+
+
+tCIDZLib::EFormats TZLibCompImpl::eFormat() const
+{
+    return m_eFormat;
+}
+
+tCIDZLib::EFormats TZLibCompImpl::eFormat(const tCIDZLib::EFormats eToSet)
+{
+    m_eFormat = eToSet;
+    return m_eFormat;
+}
+
+
+//
+//  Sets us up to decompress a new stream in feed mode. The input will come
+//  to us in chunks via bFeedInflate().
+//
+tCIDLib::TVoid TZLibCompImpl::StartFeedInflate()
+{
+    m_eMode = tCIDZLib_::EModes::Decompress;
+    m_pstrmIn = nullptr;
+    m_pstrmOut = nullptr;
+    m_pc1SrcBuf = nullptr;
+    m_pc1FeedBuf = nullptr;
+    m_c4FeedOfs = 0;
+    m_c4FeedSz = 0;
+    m_c4InputBytes = kCIDLib::c4MaxCard;
+
+    Reset();
+    InitInflate();
+    m_bFeedMode = kCIDLib::True;
+}
+
+
 
 // ---------------------------------------------------------------------------
 //  TZLibCompImpl: Private, static data members
@@ -225,20 +534,33 @@ TZLibCompImpl::c4ReadBuf(       tCIDLib::TCard1* const  pc1ToFill
             c4Actual = m_c4InputBytes - m_c4TotalIn;
     }
 
-    // Read up to the requested bytes
+    //
+    //  Read up to the requested bytes. If we are doing a segment, it's already
+    //  in memory so we can just copy it.
+    //
     tCIDLib::TCard4 c4Ret = 0;
     if (c4Actual)
-        c4Ret = m_pstrmIn->c4ReadRawBuffer(pc1ToFill, c4Actual, tCIDLib::EAllData::OkIfNotAll);
+    {
+        if (m_pc1SrcBuf)
+        {
+            TRawMem::CopyMemBuf(pc1ToFill, m_pc1SrcBuf + m_c4TotalIn, c4Actual);
+            c4Ret = c4Actual;
+        }
+         else
+        {
+            c4Ret = m_pstrmIn->c4ReadRawBuffer(pc1ToFill, c4Actual, tCIDLib::EAllData::OkIfNotAll);
+        }
+    }
 
     //
-    //  If we got more data, so update the adler hash which is kept for
+    //  If we got more data, so update the check value which is kept for
     //  the whole input stream, and stored at the end so that the decomp
     //  can validate the resulting decompressed data. And bump the count
     //  of bytes eaten.
     //
     if (c4Ret)
     {
-        m_c4Adler = TRawMem::hshHashBufferAdler32(m_c4Adler, pc1ToFill, c4Ret);
+        UpdateCheck(pc1ToFill, c4Ret);
         m_c4TotalIn += c4Ret;
     }
 
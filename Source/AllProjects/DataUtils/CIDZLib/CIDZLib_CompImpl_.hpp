@@ -42,6 +42,25 @@
 class TZLibCompImpl : public TObject
 {
     public :
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TCard4 c4CombineAdler32
+        (
+            const   tCIDLib::TCard4         c4Adler1
+            , const tCIDLib::TCard4         c4Adler2
+            , const tCIDLib::TCard4         c4Len2
+        );
+
+        static tCIDLib::TCard4 c4PutStreamTrailer
+        (
+                    TBinOutStream&          strmOutput
+            , const tCIDZLib::EFormats      eFormat
+            , const tCIDLib::TCard4         c4Check
+            , const tCIDLib::TCard4         c4DataLen
+        );
+
+
         // -------------------------------------------------------------------
         //  Constructors and Destructor
         // -------------------------------------------------------------------
@@ -65,6 +84,13 @@ class TZLibCompImpl : public TObject
         // -------------------------------------------------------------------
         //  Public, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFeedInflate
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4Count
+            ,       TBinOutStream&          strmOutput
+        );
+
         tCIDLib::TCard4 c4Compress
         (
                     TBinInStream&           strmInput
@@ -72,6 +98,16 @@ class TZLibCompImpl : public TObject
             , const tCIDLib::TCard4         c4MaxInput = kCIDLib::c4MaxCard
         );
 
+        tCIDLib::TCard4 c4CompressSeg
+        (
+            const   tCIDLib::TCard1* const  pc1Dict
+            , const tCIDLib::TCard4         c4DictSz
+            , const tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4DataSz
+            , const tCIDLib::TBoolean       bLastSeg
+            ,       TBinOutStream&          strmOutput
+        );
+
         tCIDLib::TCard4 c4Decompress
         (
                     TBinInStream&           strmInput
@@ -79,6 +115,22 @@ class TZLibCompImpl : public TObject
             , const tCIDLib::TCard4         c4MaxInput = kCIDLib::c4MaxCard
         );
 
+        tCIDLib::TCard4 c4PutStreamHeader
+        (
+                    TBinOutStream&          strmOutput
+        )   const;
+
+        tCIDLib::TCard2 c2StreamHeader() const;
+
+        tCIDZLib::EFormats eFormat() const;
+
+        tCIDZLib::EFormats eFormat
+        (
+            const   tCIDZLib::EFormats      eToSet
+        );
+
+        tCIDLib::TVoid StartFeedInflate();
+
 
     private :
         // -------------------------------------------------------------------
@@ -102,6 +154,8 @@ class TZLibCompImpl : public TObject
             const   tCIDLib::TCard4         c4ToGet
         );
 
+        tCIDLib::TCard1 c1NextCompByte();
+
         tCIDLib::TCard4 c4PeekInflBits
         (
             const   tCIDLib::TCard4         c4ToGet
@@ -131,6 +185,8 @@ class TZLibCompImpl : public TObject
             , const tCIDLib::TCard4         c4ReadUpTo
         );
 
+        tCIDLib::TVoid CompressData();
+
         tCIDLib::TVoid CompressBlock
         (
             const   TZTree&                 treeLits
@@ -140,7 +196,7 @@ class TZLibCompImpl : public TObject
 
         tCIDLib::TVoid CopyInflBlock
         (
-            const   tCIDLib::TCard4         c4Length
+                    tCIDLib::TCard4&        c4Length
         );
 
         tCIDLib::TVoid CopyInflBytes
@@ -176,6 +232,8 @@ class TZLibCompImpl : public TObject
             const   tCIDLib::TBoolean       bHaveDict
         );
 
+        tCIDLib::TVoid InitInflate();
+
         tCIDLib::TVoid InflateTable
         (
             const   tCIDZLib_::EInflTbls    eTable
@@ -187,6 +245,12 @@ class TZLibCompImpl : public TObject
 
         tCIDLib::TVoid PerBlockReset();
 
+        tCIDLib::TVoid PrimeDict
+        (
+            const   tCIDLib::TCard1* const  pc1Dict
+            , const tCIDLib::TCard4         c4DictSz
+        );
+
         tCIDLib::TVoid PullCompByte();
 
         tCIDLib::TVoid PutByte
@@ -258,8 +322,19 @@ class TZLibCompImpl : public TObject
 
         tCIDLib::TVoid SyncInflStream();
 
+        tCIDLib::TVoid UpdateCheck
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4Count
+        );
+
         tCIDLib::TVoid UpdateDecompBuf();
 
+        tCIDLib::TVoid WriteInflOut
+        (
+            const   tCIDLib::TCard4         c4UpTo
+        );
+
 
         // -------------------------------------------------------------------
         //  Private, static data members
@@ -277,6 +352,19 @@ class TZLibCompImpl : public TObject
         //      input stream, we set this so that we know that no more data
         //      is coming and that we have to just finish off what we've got.
         //
+        //  m_bFeedMode
+        //      When decompressing, we can either read from an input stream or
+        //      be fed chunks of input via bFeedInflate(). In the latter case,
+        //      this is set, and running out of input just means we unwind and
+        //      wait for more, instead of it being an error.
+        //
+        //  m_bFinalSeg
+        //      Normally we compress a whole stream and the last block we
+        //      flush is marked as the final one. When compressing one segment
+        //      of a parallel compression, only the last segment can do that,
+        //      the others end with an empty stored block so that they end on
+        //      a byte boundary and can just be concatenated.
+        //
         //  m_bInitialized
         //      This is used to lazy init the data that depends on the
         //      aggreesiveness of compresion. If they don't explicitly init
@@ -293,7 +381,10 @@ class TZLibCompImpl : public TObject
         //      The last end of block length we wrote out.
         //
         //  m_c4Adler
-        //      A running hash of the uncompressed data.
+        //  m_c4CRC
+        //      Running hashes of the uncompressed data. Which one we use depends
+        //      on the format. The CRC is kept in its raw form and has to be
+        //      inverted to get the actual CRC-32 value.
         //
         //  m_c4BytesAvail
         //  m_c4CurOfs
@@ -302,10 +393,22 @@ class TZLibCompImpl : public TObject
         //      amount of lookahead we can do.) For decompression, the bytes
         //      avail is used to keep up with the bytes in the sliding window.
         //
+        //  m_c4FeedOfs
+        //  m_c4FeedSz
+        //  m_pc1FeedBuf
+        //      In feed mode, the chunk of input we are currently working
+        //      through, its size, and how far into it we've gotten.
+        //
         //  m_c4InflBuf
         //      Used to read in compressed data for deflation, and we pull
         //      out bits from it as we go.
         //
+        //  m_c4InflFlushed
+        //      In feed mode we write out all the decompressed data we have at
+        //      the end of each feed, but it still has to stay in the window
+        //      for back references. This is how many bytes at the start of the
+        //      window have already been written out.
+        //
         //  m_c4InputBytes
         //      Indicates how many bytes to pull from the input stream and
         //      compress/decompress. If they give us kCIDLib::c4MaxCard, we
@@ -335,12 +438,20 @@ class TZLibCompImpl : public TObject
         //  m_eDataType
         //      We make a best guess at whether the data is text or data.
         //
+        //  m_eFormat
+        //      The framing we put around the compressed data, or expect to
+        //      see when decompressing.
+        //
         //  m_eMode
         //      The overall comp/decomp mode that we are in.
         //
         //  m_eStrategy
         //      The compression strategy to use
         //
+        //  m_infsCur
+        //      The state of the inflate state machine, kept here so that we
+        //      can exit and resume when fed input in chunks.
+        //
         //  m_pc1WndBuf
         //      Our actual working buffer, which is twice the size of the
         //      32K sliding buffer so that we can deal with the issue of
@@ -361,6 +472,12 @@ class TZLibCompImpl : public TObject
         //      The values stored are indices into the sliding buffer. We also
         //      keep up with up to 1 previous string with the same hash.
         //
+        //  m_pc1SrcBuf
+        //      When compressing a segment for parallel compression, the input
+        //      is already in memory, so we just read from this buffer instead
+        //      of from m_pstrmIn. m_c4InputBytes is the size of the buffer.
+        //      It is null for regular stream based compression.
+        //
         //  m_pstrmIn
         //  m_pstrmOut
         //      Pointers to the in and output streams that provide the
@@ -374,15 +491,21 @@ class TZLibCompImpl : public TObject
         //      The dymamic trees for bit lengths, distances, and code lengths.
         // -------------------------------------------------------------------
         tCIDLib::TBoolean       m_bEndOfInput;
+        tCIDLib::TBoolean       m_bFeedMode;
+        tCIDLib::TBoolean       m_bFinalSeg;
         tCIDLib::TBoolean       m_bInitialized;
         tCIDLib::TCard2         m_c2BitBuf;
         tCIDLib::TCard4         m_c4BitCount;
         tCIDLib::TCard4         m_c2LastEOBLen;
         tCIDLib::TCard4         m_c4Adler;
         tCIDLib::TCard4         m_c4BytesAvail;
+        tCIDLib::TCard4         m_c4CRC;
         tCIDLib::TCard4         m_c4CurOfs;
+        tCIDLib::TCard4         m_c4FeedOfs;
+        tCIDLib::TCard4         m_c4FeedSz;
         tCIDLib::TCard4         m_c4GoodLen;
         tCIDLib::TCard4         m_c4InflBuf;
+        tCIDLib::TCard4         m_c4InflFlushed;
         tCIDLib::TCard4         m_c4InputBytes;
         tCIDLib::TCard4         m_c4MaxChainLen;
         tCIDLib::TCard4         m_c4MaxLazyLen;
@@ -391,13 +514,17 @@ class TZLibCompImpl : public TObject
         tCIDLib::TCard4         m_c4TotalOut;
         tCIDZLib::ECompLevels   m_eCompLevel;
         tCIDZLib_::EDataTypes   m_eDataType;
+        tCIDZLib::EFormats      m_eFormat;
         tCIDZLib_::EModes       m_eMode;
         tCIDZLib_::EStrategies  m_eStrategy;
+        tCIDZLib_::TInflState   m_infsCur;
         tCIDLib::TCard1*        m_pc1LLAccum;
         tCIDLib::TCard1*        m_pc1WndBuf;
         tCIDLib::TCard2*        m_pc2DistAccum;
         tCIDLib::TCard2*        m_pc2HashPrev;
         tCIDLib::TCard2*        m_pc2HashTbl;
+        const tCIDLib::TCard1*  m_pc1FeedBuf;
+        const tCIDLib::TCard1*  m_pc1SrcBuf;
         TBinInStream*           m_pstrmIn;
         TBinOutStream*          m_pstrmOut;
         TZTreeDescr             m_tdDynBitLen;
@@ -39,6 +39,108 @@
 RTTIDecls(TZLibCompressor,TObject)
 
 
+
+// ---------------------------------------------------------------------------
+//  Local types and functions
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDZLib_Compressor
+    {
+        // -----------------------------------------------------------------------
+        //  For parallel compression, each worker thread gets one of these. It
+        //  has the segment info going in and the results coming out. If the
+        //  worker fails, it stores the error for the calling thread to throw.
+        // -----------------------------------------------------------------------
+        struct TParSeg
+        {
+            const tCIDLib::TCard1*  pc1Dict = nullptr;
+            tCIDLib::TCard4         c4DictSz = 0;
+            const tCIDLib::TCard1*  pc1Data = nullptr;
+            tCIDLib::TCard4         c4DataSz = 0;
+            tCIDLib::TBoolean       bLast = kCIDLib::False;
+            tCIDLib::TCard4         c4Adler = 0;
+            tCIDLib::TBoolean       bFailed = kCIDLib::False;
+            TError                  errFailure;
+            TZLibCompImpl*          pzimplSeg = nullptr;
+            TBinMBufOutStream*      pstrmSeg = nullptr;
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The worker thread entry point. It just compresses its segment into
+        //  its own output stream.
+        // -----------------------------------------------------------------------
+        tCIDLib::EExitCodes eParSegThread(TThread& thrThis, tCIDLib::TVoid* pData)
+        {
+            TParSeg* pSeg = static_cast<TParSeg*>(pData);
+
+            // Let the calling thread go
+            thrThis.Sync();
+
+            try
+            {
+                pSeg->pstrmSeg->Reset();
+                pSeg->c4Adler = pSeg->pzimplSeg->c4CompressSeg
+                (
+                    pSeg->pc1Dict
+                    , pSeg->c4DictSz
+                    , pSeg->pc1Data
+                    , pSeg->c4DataSz
+                    , pSeg->bLast
+                    , *pSeg->pstrmSeg
+                );
+            }
+
+            catch(TError& errToCatch)
+            {
+                pSeg->errFailure = errToCatch;
+                pSeg->bFailed = kCIDLib::True;
+            }
+
+            catch(...)
+            {
+                pSeg->bFailed = kCIDLib::True;
+            }
+            return tCIDLib::EExitCodes::Normal;
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Read up to the indicated number of bytes, respecting the max input we
+        //  were given. We keep reading until we get what we asked for or hit the
+        //  end of input.
+        // -----------------------------------------------------------------------
+        tCIDLib::TCard4 c4ReadInput(        TBinInStream&       strmInput
+                                    ,       tCIDLib::TCard1*    pc1ToFill
+                                    , const tCIDLib::TCard4     c4Wanted
+                                    ,       tCIDLib::TCard4&    c4LeftToRead)
+        {
+            tCIDLib::TCard4 c4Got = 0;
+            while ((c4Got < c4Wanted) && c4LeftToRead && !strmInput.bEndOfStream())
+            {
+                tCIDLib::TCard4 c4ThisTime = c4Wanted - c4Got;
+                if (c4ThisTime > c4LeftToRead)
+                    c4ThisTime = c4LeftToRead;
+
+                const tCIDLib::TCard4 c4Read = strmInput.c4ReadRawBuffer
+                (
+                    pc1ToFill + c4Got, c4ThisTime, tCIDLib::EAllData::OkIfNotAll
+                );
+                if (!c4Read)
+                    break;
+
+                c4Got += c4Read;
+                if (c4LeftToRead != kCIDLib::c4MaxCard)
+                    c4LeftToRead -= c4Read;
+            }
+            return c4Got;
+        }
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TZLibCompressor
 // PREFIX: zlib
@@ -49,7 +151,15 @@ RTTIDecls(TZLibCompressor,TObject)
 // ---------------------------------------------------------------------------
 TZLibCompressor::TZLibCompressor() :
 
-    m_pzimplThis(nullptr)
+    m_eFormat(tCIDZLib::EFormats::ZLib)
+    , m_pzimplThis(nullptr)
+{
+}
+
+TZLibCompressor::TZLibCompressor(const tCIDZLib::EFormats eFormat) :
+
+    m_eFormat(eFormat)
+    , m_pzimplThis(nullptr)
 {
 }
 
@@ -68,19 +178,6 @@ TZLibCompressor::c4Compress(        TBinInStream&   strmInput
                             ,       TBinOutStream&  strmOutput
                             , const tCIDLib::TCard4 c4InputBytes)
 {
-    //
-    //  If it's not been initialized yet, then go ahead and initialize it
-    //  with default values.
-    //
-    if (!m_pzimplThis)
-    {
-        m_pzimplThis = new TZLibCompImpl
-        (
-            tCIDZLib::ECompLevels::Default
-            , tCIDZLib_::EStrategies::Default
-        );
-    }
-
     //
     //  Flush the output stream and remember the offset. This lets us figure out
     //  how much data was written.
@@ -89,7 +186,7 @@ TZLibCompressor::c4Compress(        TBinInStream&   strmInput
     const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
 
     // Do the compression
-    m_pzimplThis->c4Compress(strmInput, strmOutput, c4InputBytes);
+    zimplThis().c4Compress(strmInput, strmOutput, c4InputBytes);
 
     // Now flush it again and return the difference
     strmOutput.Flush();
@@ -97,24 +194,185 @@ TZLibCompressor::c4Compress(        TBinInStream&   strmInput
 }
 
 
+//
+//  This does the same as c4Compress above, but splits the input into segments and
+//  compresses them on multiple threads. We read a batch of segments at a time, so
+//  memory use is bounded by the thread count times the segment size. We keep the
+//  last 32K of each batch at the start of the buffer, so that it's available as
+//  the dictionary for the first segment of the next batch.
+//
+//  If they pass zero for max threads, we use one per CPU. If we end up with one
+//  thread, we just do a regular compress, since it's the same thing.
+//
+//  For zlib we combine the segments' Adler-32 values. For gzip we need a CRC-32
+//  of the whole input, which we calculate on this thread while the workers are
+//  busy with the batch.
+//
 tCIDLib::TCard4
-TZLibCompressor::c4Decompress(          TBinInStream&   strmInput
+TZLibCompressor::c4CompressPar(         TBinInStream&   strmInput
                                 ,       TBinOutStream&  strmOutput
-                                , const tCIDLib::TCard4 c4InputBytes)
+                                , const tCIDLib::TCard4 c4InputBytes
+                                , const tCIDLib::TCard4 c4MaxThreads)
 {
+    tCIDLib::TCard4 c4ThreadCnt = c4MaxThreads ? c4MaxThreads : TSysInfo::c4CPUCount();
+    if (c4ThreadCnt > kCIDZLib::c4MaxParThreads)
+        c4ThreadCnt = kCIDZLib::c4MaxParThreads;
+
+    if (c4ThreadCnt < 2)
+        return c4Compress(strmInput, strmOutput, c4InputBytes);
+
     //
-    //  If it's not been initialized yet, then go ahead and initialize it
-    //  with default values.
+    //  Allocate a buffer big enough for a window's worth of dictionary, plus
+    //  a segment for each thread.
     //
-    if (!m_pzimplThis)
+    const tCIDLib::TCard4 c4DictMax = 0x8000;
+    const tCIDLib::TCard4 c4BatchSz = c4ThreadCnt * kCIDZLib::c4ParSegSz;
+    TArrayJanitor<tCIDLib::TCard1> janBuf(c4DictMax + c4BatchSz);
+    tCIDLib::TCard1* const pc1Buf = janBuf.paThis();
+
+    //
+    //  Set up the per-thread stuff. Each one needs its own compressor impl and
+    //  an output stream to compress into.
+    //
+    TRefVector<TZLibCompImpl> colImpls(tCIDLib::EAdoptOpts::Adopt, c4ThreadCnt);
+    TRefVector<TBinMBufOutStream> colOutStrms(tCIDLib::EAdoptOpts::Adopt, c4ThreadCnt);
+    TRefVector<TThread> colThreads(tCIDLib::EAdoptOpts::Adopt, c4ThreadCnt);
+    TObjArray<CIDZLib_Compressor::TParSeg> objaSegs(c4ThreadCnt);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThreadCnt; c4Index++)
     {
-        m_pzimplThis = new TZLibCompImpl
+        colImpls.Add
         (
-            tCIDZLib::ECompLevels::Default
-            , tCIDZLib_::EStrategies::Default
+            new TZLibCompImpl(tCIDZLib::ECompLevels::Default, tCIDZLib_::EStrategies::Default)
+        );
+        colOutStrms.Add(new TBinMBufOutStream(kCIDZLib::c4ParSegSz + 1024));
+        colThreads.Add
+        (
+            new TThread
+            (
+                facCIDLib().strNextThreadName(TString(L"ZLibParComp"))
+                , CIDZLib_Compressor::eParSegThread
+            )
         );
+
+        objaSegs[c4Index].pzimplSeg = colImpls[c4Index];
+        objaSegs[c4Index].pstrmSeg = colOutStrms[c4Index];
     }
 
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
+
+    // Write out the stream header for our format
+    colImpls[0]->eFormat(m_eFormat);
+    colImpls[0]->c4PutStreamHeader(strmOutput);
+    colImpls[0]->eFormat(tCIDZLib::EFormats::ZLib);
+
+    tCIDLib::TCard4 c4Adler = TRawMem::hshHashBufferAdler32(0, 0, 0);
+    tCIDLib::TCard4 c4CRC = kCIDLib::c4MaxCard;
+    tCIDLib::TCard4 c4TotalIn = 0;
+    tCIDLib::TCard4 c4DictSz = 0;
+    tCIDLib::TCard4 c4LeftToRead = c4InputBytes;
+    tCIDLib::TBoolean bDone = kCIDLib::False;
+    while (!bDone)
+    {
+        const tCIDLib::TCard4 c4Got = CIDZLib_Compressor::c4ReadInput
+        (
+            strmInput, pc1Buf + c4DictSz, c4BatchSz, c4LeftToRead
+        );
+
+        //
+        //  If we got less than a full batch, this is the last one. If we got
+        //  nothing, we have to put out an empty final block, since the last
+        //  batch ended with a non-final one.
+        //
+        bDone = (c4Got < c4BatchSz);
+        if (!c4Got)
+        {
+            TZLibCompImpl& zimplLast = *colImpls[0];
+            TBinMBufOutStream& strmLast = *colOutStrms[0];
+            strmLast.Reset();
+            zimplLast.c4CompressSeg(nullptr, 0, nullptr, 0, kCIDLib::True, strmLast);
+            strmOutput.c4WriteBuffer(strmLast.mbufData(), strmLast.c4CurSize());
+            break;
+        }
+
+        // Set up the segments for this round and start them
+        tCIDLib::TCard4 c4SegCnt = 0;
+        tCIDLib::TCard4 c4SegOfs = c4DictSz;
+        const tCIDLib::TCard4 c4End = c4DictSz + c4Got;
+        while (c4SegOfs < c4End)
+        {
+            CIDZLib_Compressor::TParSeg& segCur = objaSegs[c4SegCnt];
+
+            segCur.c4DataSz = tCIDLib::MinVal(kCIDZLib::c4ParSegSz, c4End - c4SegOfs);
+            segCur.pc1Data = pc1Buf + c4SegOfs;
+            segCur.c4DictSz = tCIDLib::MinVal(c4DictMax, c4SegOfs);
+            segCur.pc1Dict = segCur.pc1Data - segCur.c4DictSz;
+            segCur.bLast = bDone && (c4SegOfs + segCur.c4DataSz == c4End);
+            segCur.bFailed = kCIDLib::False;
+
+            colThreads[c4SegCnt]->Start(&segCur);
+
+            c4SegOfs += segCur.c4DataSz;
+            c4SegCnt++;
+        }
+
+        // While they work, do the CRC if needed
+        c4TotalIn += c4Got;
+        if (m_eFormat == tCIDZLib::EFormats::GZip)
+            c4CRC = TRawMem::hshHashBuffer3309(c4CRC, pc1Buf + c4DictSz, c4Got);
+
+        // Wait for them all to complete
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SegCnt; c4Index++)
+            colThreads[c4Index]->eWaitForDeath();
+
+        //
+        //  Check for failures. If none, write out the segments in order and
+        //  combine their hashes.
+        //
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SegCnt; c4Index++)
+        {
+            CIDZLib_Compressor::TParSeg& segCur = objaSegs[c4Index];
+            if (segCur.bFailed)
+            {
+                segCur.errFailure.AddStackLevel(CID_FILE, CID_LINE);
+                throw segCur.errFailure;
+            }
+
+            c4Adler = TZLibCompImpl::c4CombineAdler32(c4Adler, segCur.c4Adler, segCur.c4DataSz);
+            strmOutput.c4WriteBuffer(segCur.pstrmSeg->mbufData(), segCur.pstrmSeg->c4CurSize());
+        }
+
+        //
+        //  Move the last window's worth of data down to the start of the buffer
+        //  to be the dictionary for the next round.
+        //
+        if (!bDone)
+        {
+            const tCIDLib::TCard4 c4NewDictSz = tCIDLib::MinVal(c4DictMax, c4End);
+            TRawMem::MoveMemBuf(pc1Buf, pc1Buf + (c4End - c4NewDictSz), c4NewDictSz);
+            c4DictSz = c4NewDictSz;
+        }
+    }
+
+    // Write out the trailer info
+    TZLibCompImpl::c4PutStreamTrailer
+    (
+        strmOutput
+        , m_eFormat
+        , (m_eFormat == tCIDZLib::EFormats::GZip) ? (c4CRC ^ kCIDLib::c4MaxCard) : c4Adler
+        , c4TotalIn
+    );
+
+    strmOutput.Flush();
+    return strmOutput.c4CurPos() - c4OrgPos;
+}
+
+
+tCIDLib::TCard4
+TZLibCompressor::c4Decompress(          TBinInStream&   strmInput
+                                ,       TBinOutStream&  strmOutput
+                                , const tCIDLib::TCard4 c4InputBytes)
+{
     //
     //  Flush the output stream and remember the offset. This lets us figure out
     //  how much data was written.
@@ -122,10 +380,45 @@ TZLibCompressor::c4Decompress(          TBinInStream&   strmInput
     strmOutput.Flush();
     const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
 
-    m_pzimplThis->c4Decompress(strmInput, strmOutput, c4InputBytes);
+    zimplThis().c4Decompress(strmInput, strmOutput, c4InputBytes);
 
     // Now flush it again and return the difference
     strmOutput.Flush();
     return strmOutput.c4CurPos() - c4OrgPos;
 }
 
+
+tCIDZLib::EFormats TZLibCompressor::eFormat() const
+{
+    return m_eFormat;
+}
+
+tCIDZLib::EFormats TZLibCompressor::eFormat(const tCIDZLib::EFormats eToSet)
+{
+    m_eFormat = eToSet;
+    return m_eFormat;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TZLibCompressor: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  If it's not been initialized yet, then go ahead and initialize it with
+//  default values. And make sure it's using our current format.
+//
+TZLibCompImpl& TZLibCompressor::zimplThis()
+{
+    if (!m_pzimplThis)
+    {
+        m_pzimplThis = new TZLibCompImpl
+        (
+            tCIDZLib::ECompLevels::Default
+            , tCIDZLib_::EStrategies::Default
+        );
+    }
+    m_pzimplThis->eFormat(m_eFormat);
+    return *m_pzimplThis;
+}
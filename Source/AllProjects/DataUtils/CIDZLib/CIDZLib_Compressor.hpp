@@ -22,6 +22,17 @@
 //  This guy works in terms of streams. A binary input stream provides input
 //  for the process, and a binary output stream accepts the results.
 //
+//  c4CompressPar() is a parallel version of compression. It breaks the input
+//  into segments and deflates them on multiple threads, each one primed with
+//  the 32K of input before it so we don't lose matches across the boundaries.
+//  The results are stitched into a single, standard zlib stream, so anything
+//  that can decompress regular output can decompress this.
+//
+//  By default we use the zlib format, but gzip or raw deflate framing can be
+//  set via the constructor or eFormat(). That applies to both directions.
+//  For incremental work, where data shows up in chunks, see the push style
+//  compressor classes.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -47,12 +58,19 @@ class CIDZLIBEXP TZLibCompressor : public TObject
         // -------------------------------------------------------------------
         TZLibCompressor();
 
+        TZLibCompressor
+        (
+            const   tCIDZLib::EFormats      eFormat
+        );
+
         TZLibCompressor(const TZLibCompressor&) = delete;
 
         TZLibCompressor(TZLibCompressor&& zlibSrc) :
 
-            m_pzimplThis(nullptr)
+            m_eFormat(tCIDZLib::EFormats::ZLib)
+            , m_pzimplThis(nullptr)
         {
+            tCIDLib::Swap(m_eFormat, zlibSrc.m_eFormat);
             tCIDLib::Swap(m_pzimplThis, zlibSrc.m_pzimplThis);
         }
 
@@ -68,6 +86,7 @@ class CIDZLIBEXP TZLibCompressor : public TObject
         {
             if (&zlibSrc  != this)
             {
+                tCIDLib::Swap(m_eFormat, zlibSrc.m_eFormat);
                 tCIDLib::Swap(m_pzimplThis, zlibSrc.m_pzimplThis);
             }
             return *this;
@@ -84,6 +103,14 @@ class CIDZLIBEXP TZLibCompressor : public TObject
             , const tCIDLib::TCard4         c4MaxInput = kCIDLib::c4MaxCard
         );
 
+        tCIDLib::TCard4 c4CompressPar
+        (
+                    TBinInStream&           strmInput
+            ,       TBinOutStream&          strmOutput
+            , const tCIDLib::TCard4         c4MaxInput = kCIDLib::c4MaxCard
+            , const tCIDLib::TCard4         c4MaxThreads = 0
+        );
+
         tCIDLib::TCard4 c4Decompress
         (
                     TBinInStream&           strmInput
@@ -91,16 +118,33 @@ class CIDZLIBEXP TZLibCompressor : public TObject
             , const tCIDLib::TCard4         c4MaxInput = kCIDLib::c4MaxCard
         );
 
+        tCIDZLib::EFormats eFormat() const;
+
+        tCIDZLib::EFormats eFormat
+        (
+            const   tCIDZLib::EFormats      eToSet
+        );
+
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        TZLibCompImpl& zimplThis();
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_eFormat
+        //      The framing format we create and expect, zlib by default.
+        //
         //  m_pzimplThis
         //      The actual code is all in an internal implementation class
         //      so that we don't have to expose lots of constants and whatnot.
         // -------------------------------------------------------------------
-        TZLibCompImpl*  m_pzimplThis;
+        tCIDZLib::EFormats  m_eFormat;
+        TZLibCompImpl*      m_pzimplThis;
 
 
         // -------------------------------------------------------------------
@@ -30,5 +30,20 @@
 
 namespace kCIDZLib
 {
+    // -----------------------------------------------------------------------
+    //  Parallel compression breaks the input into segments of this size, each
+    //  of which is deflated independently (primed with the 32K of input that
+    //  precedes it) and the results stitched back into a single stream. We
+    //  also cap the number of worker threads we'll use.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4ParSegSz      = 0x20000;
+    constexpr tCIDLib::TCard4   c4MaxParThreads = 64;
+
+
+    // -----------------------------------------------------------------------
+    //  The push compressor buffers up to this much fed data before it has to
+    //  compress it and write it out.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4PushBufSz     = 0x10000;
 }
 
@@ -189,47 +189,13 @@ TZLibCompImpl::CompressBlock(const  TZTree&             treeLits
 
 
 //
-//  The main deflation entry point. The pass us the compression method to
-//  use, which controls some performance flags and the particular compression
-//  scheme we use.
+//  Calls the correct deflation method based on compression level. This does
+//  the raw deflate data, without any header or trailer, so it's used both for
+//  regular streams and for parallel segments.
 //
-tCIDLib::TVoid
-TZLibCompImpl::Deflate(const tCIDZLib_::ECompMethods eMethod)
+tCIDLib::TVoid TZLibCompImpl::CompressData()
 {
-    // Write out the header
-    tCIDLib::TCard2 c2Header = tCIDLib::TCard2
-    (
-        (tCIDLib::TCard2(eMethod) + ((kCIDZLib_::c4WndBits - 8) << 4)) << 8
-    );
-
-    tCIDLib::TCard2 c2LvlFlags;
-    if ((m_eStrategy >= tCIDZLib_::EStrategies::HuffmanOnly)
-    ||  (m_eCompLevel < tCIDZLib::ECompLevels::L2))
-    {
-        c2LvlFlags = 0;
-    }
-     else if (m_eCompLevel < tCIDZLib::ECompLevels::L6)
-    {
-        c2LvlFlags = 1;
-    }
-     else if (m_eCompLevel == tCIDZLib::ECompLevels::L6)
-    {
-        c2LvlFlags = 2;
-    }
-     else
-    {
-        c2LvlFlags = 3;
-    }
-
-    c2Header |= (c2LvlFlags << 6);
-    c2Header += 31 - (c2Header % 31);
-    PutShortMSB(c2Header);
-
-    // Reset the adler hash value now
-    m_c4Adler = TRawMem::hshHashBufferAdler32(0, 0, 0);
-
-    // Call the correct deflation method based on compression level
-    tCIDZLib_::ECompFuncs eFunc
+    const tCIDZLib_::ECompFuncs eFunc
     (
         kCIDZLib_::aStratTable[tCIDLib::c4EnumOrd(m_eCompLevel)].eFunc
     );
@@ -240,13 +206,41 @@ TZLibCompImpl::Deflate(const tCIDZLib_::ECompMethods eMethod)
         DeflateFast();
     else
         DeflateSlow();
+}
+
+
+//
+//  The main deflation entry point. The pass us the compression method to
+//  use, which controls some performance flags and the particular compression
+//  scheme we use.
+//
+tCIDLib::TVoid
+TZLibCompImpl::Deflate(const tCIDZLib_::ECompMethods eMethod)
+{
+    // Deflate is the only method defined, so it's implied by the header
+    CIDAssert(eMethod == tCIDZLib_::ECompMethods::Deflated, L"Unknown zlib compression method");
+
+    // Write out the header for our format
+    m_c4TotalOut += c4PutStreamHeader(*m_pstrmOut);
+
+    // Reset the check values now
+    m_c4Adler = TRawMem::hshHashBufferAdler32(0, 0, 0);
+    m_c4CRC = kCIDLib::c4MaxCard;
+
+    // Do the actual compression
+    CompressData();
 
     // Get any remain bits out and align on byte boundary
     FlushBitBuf();
 
     // Write out the trailer info
-    PutShortMSB(TRawBits::c2High16From32(m_c4Adler));
-    PutShortMSB(TRawBits::c2Low16From32(m_c4Adler));
+    m_c4TotalOut += c4PutStreamTrailer
+    (
+        *m_pstrmOut
+        , m_eFormat
+        , (m_eFormat == tCIDZLib::EFormats::GZip) ? (m_c4CRC ^ kCIDLib::c4MaxCard) : m_c4Adler
+        , m_c4TotalIn
+    );
 }
 
 
@@ -304,10 +298,14 @@ tCIDLib::TVoid TZLibCompImpl::DeflateSlow()
             if (!m_c4BytesAvail)
                 break;
 
-            // If the first read, then init the hash with the first two bytes
+            //
+            //  If the first read, then init the hash with the first two bytes.
+            //  Note that the current offset isn't zero if we were primed with
+            //  a dictionary.
+            //
             if (bFirst && (m_c4BytesAvail > kCIDZLib_::c4MinMatch))
             {
-                c2InsHash = m_pc1WndBuf[0];
+                c2InsHash = m_pc1WndBuf[m_c4CurOfs];
                 c2InsHash = ((c2InsHash << kCIDZLib_::c4HashShift)
                             ^ m_pc1WndBuf[m_c4CurOfs + 1])
                             & kCIDZLib_::c4HashMask;
@@ -513,8 +511,11 @@ tCIDLib::TVoid TZLibCompImpl::DeflateSlow()
         m_tdDynLens.treeData().BumpFreq(m_pc1WndBuf[m_c4CurOfs - 1]);
     }
 
-    // Flush any remaining dta into a last block
-    FlushBlock(i4LastBlock, c4LitInd, kCIDLib::True);
+    //
+    //  Flush any remaining dta into a last block. If we are doing a parallel
+    //  segment that isn't the last one, it's not marked as the final block.
+    //
+    FlushBlock(i4LastBlock, c4LitInd, m_bFinalSeg);
     i4LastBlock = tCIDLib::TInt4(m_c4CurOfs);
     c4LitInd = 0;
 }
@@ -613,9 +614,10 @@ TZLibCompImpl::FlushBlock(  const   tCIDLib::TInt4      i4LastBlock
 
         //
         //  Copy the indicated bytes from the window buffer to the output
-        //  stream.
+        //  stream. If the block start has been slid out of the window we
+        //  can't do it.
         //
-        if (i4LastBlock)
+        if (i4LastBlock < 0)
         {
             facCIDZLib().ThrowErr
             (
@@ -40,9 +40,9 @@ namespace
 {
     namespace CIDZLib_Inflate
     {
-        constexpr tCIDLib::TCard4   c4Enough = 1440;
+        constexpr tCIDLib::TCard4   c4Enough = kCIDZLib_::c4InflTblSz;
         constexpr tCIDLib::TCard4   c4MaxD = 154;
-        constexpr tCIDLib::TCard4   c4Lens = 320;
+        constexpr tCIDLib::TCard4   c4Lens = kCIDZLib_::c4InflLensSz;
 
         // -----------------------------------------------------------------------
         //  Tables for fixed table decoding
@@ -167,6 +167,30 @@ static tCIDLib::TVoid CheckIndex(const  tCIDLib::TCard4     c4Line
 //  TZLibCompImpl: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  All compressed input comes through here. We either read from the input
+//  stream or, in feed mode, from the current chunk of fed input. If we run out
+//  in feed mode, we throw a signal to get back out to the feed method, leaving
+//  the inflate state where it was, so we can resume when more shows up.
+//
+tCIDLib::TCard1 TZLibCompImpl::c1NextCompByte()
+{
+    tCIDLib::TCard1 c1Ret;
+    if (m_bFeedMode)
+    {
+        if (m_c4FeedOfs >= m_c4FeedSz)
+            throw tCIDZLib_::EInflSignals::NeedInput;
+        c1Ret = m_pc1FeedBuf[m_c4FeedOfs++];
+    }
+     else
+    {
+        *m_pstrmIn >> c1Ret;
+    }
+    m_c4TotalIn++;
+    return c1Ret;
+}
+
+
 //
 //  Pulls out bits of the decompressed data in the accumulator. We use the
 //  same valid bit counter as the compression side, but we have to use a
@@ -276,24 +300,44 @@ TZLibCompImpl::c4PeekInflBitsNC(const tCIDLib::TCard4 c4ToGet)
 }
 
 
-tCIDLib::TVoid TZLibCompImpl::CopyInflBlock(const tCIDLib::TCard4 c4Length)
+//
+//  Copies a stored block's bytes from the input to the output. We count down
+//  the length as we go, since in feed mode we may run out of input part way
+//  through and have to pick up here again later.
+//
+tCIDLib::TVoid TZLibCompImpl::CopyInflBlock(tCIDLib::TCard4& c4Length)
 {
-    //
-    //  Start blasting in bytes from the input stream, flushing the window
-    //  buffer as required.
-    //
-    tCIDLib::TCard1 c1Tmp;
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Length; c4Index++)
+    while (c4Length)
     {
+        //
+        //  Flush the window buffer as required. Then, if we are being fed, we
+        //  can just copy as much as is available in one shot. Else, blast in
+        //  bytes from the input stream.
+        //
         if (m_c4BytesAvail + 1 >= kCIDZLib_::c4WndBufSz)
             UpdateDecompBuf();
 
-        *m_pstrmIn >> c1Tmp;
+        if (m_bFeedMode && (m_c4FeedOfs < m_c4FeedSz))
+        {
+            tCIDLib::TCard4 c4Count = tCIDLib::MinVal(c4Length, m_c4FeedSz - m_c4FeedOfs);
+            c4Count = tCIDLib::MinVal(c4Count, (kCIDZLib_::c4WndBufSz - 1) - m_c4BytesAvail);
+
+            TRawMem::CopyMemBuf(m_pc1WndBuf + m_c4BytesAvail, m_pc1FeedBuf + m_c4FeedOfs, c4Count);
+            m_c4FeedOfs += c4Count;
+            m_c4BytesAvail += c4Count;
+            m_c4TotalIn += c4Count;
+            c4Length -= c4Count;
+        }
+         else
+        {
+            const tCIDLib::TCard1 c1Tmp = c1NextCompByte();
 
-        #if CID_DEBUG_ON
-        CheckIndex(CID_LINE, L"WndBuf", m_c4BytesAvail, kCIDZLib_::c4WndBufSz);
-        #endif
-        m_pc1WndBuf[m_c4BytesAvail++] = c1Tmp;
+            #if CID_DEBUG_ON
+            CheckIndex(CID_LINE, L"WndBuf", m_c4BytesAvail, kCIDZLib_::c4WndBufSz);
+            #endif
+            m_pc1WndBuf[m_c4BytesAvail++] = c1Tmp;
+            c4Length--;
+        }
     }
 }
 
@@ -357,6 +401,11 @@ TZLibCompImpl::DropInflBits(const tCIDLib::TCard4 c4ToDrop)
 //  32K of output because references to previously matched strings can go
 //  back that far.
 //
+//  The state is all kept in m_infsCur, so that we can be called again in
+//  feed mode after running out of input. InitInflate() must be called to
+//  set up for a new stream. The locals here are just aliases for the state
+//  members, to keep the code below readable.
+//
 tCIDLib::TVoid TZLibCompImpl::Inflate(const tCIDLib::TBoolean bHaveDict)
 {
     // A permutation of the code lengths
@@ -366,28 +415,29 @@ tCIDLib::TVoid TZLibCompImpl::Inflate(const tCIDLib::TBoolean bHaveDict)
     };
 
     // We use a state machine to do the decoding
-    tCIDZLib_::EInfModes eState = tCIDZLib_::EInfModes::Head;
+    tCIDZLib_::EInfModes&   eState = m_infsCur.eState;
 
     // Some tables to hold decoding info
-    tCIDZLib_::TCode        acdTable[CIDZLib_Inflate::c4Enough];
-    tCIDLib::TCard2         ac2Lens[CIDZLib_Inflate::c4Lens];
-
-    tCIDLib::TBoolean       bLastBlock = kCIDLib::False;
-    tCIDLib::TCard4         c4DistBits;
-    tCIDLib::TCard4         c4Extra;
-    tCIDLib::TCard4         c4Length;
-    tCIDLib::TCard4         c4LenBits;
-    tCIDLib::TCard4         c4LensCount;
-    tCIDLib::TCard4         c4NumCodes;
-    tCIDLib::TCard4         c4NumLens;
-    tCIDLib::TCard4         c4NumDists;
-    tCIDLib::TCard4         c4Offset;
+    tCIDZLib_::TCode        (&acdTable)[CIDZLib_Inflate::c4Enough] = m_infsCur.acdTable;
+    tCIDLib::TCard2         (&ac2Lens)[CIDZLib_Inflate::c4Lens] = m_infsCur.ac2Lens;
+
+    tCIDLib::TBoolean&      bLastBlock = m_infsCur.bLastBlock;
+    tCIDLib::TCard4&        c4DistBits = m_infsCur.c4DistBits;
+    tCIDLib::TCard4&        c4Extra = m_infsCur.c4Extra;
+    tCIDLib::TCard4&        c4GZFlags = m_infsCur.c4GZFlags;
+    tCIDLib::TCard4&        c4Length = m_infsCur.c4Length;
+    tCIDLib::TCard4&        c4LenBits = m_infsCur.c4LenBits;
+    tCIDLib::TCard4&        c4LensCount = m_infsCur.c4LensCount;
+    tCIDLib::TCard4&        c4NumCodes = m_infsCur.c4NumCodes;
+    tCIDLib::TCard4&        c4NumLens = m_infsCur.c4NumLens;
+    tCIDLib::TCard4&        c4NumDists = m_infsCur.c4NumDists;
+    tCIDLib::TCard4&        c4Offset = m_infsCur.c4Offset;
     tCIDZLib_::TCode        cdLast;
     tCIDZLib_::TCode        cdThis;
 
-    const tCIDZLib_::TCode* pcdDist = nullptr;
-    const tCIDZLib_::TCode* pcdLen = nullptr;
-    tCIDZLib_::TCode*       pcdNext = nullptr;
+    const tCIDZLib_::TCode*& pcdDist = m_infsCur.pcdDist;
+    const tCIDZLib_::TCode*& pcdLen = m_infsCur.pcdLen;
+    tCIDZLib_::TCode*&       pcdNext = m_infsCur.pcdNext;
 
     tCIDLib::TBoolean bDone = kCIDLib::False;
     while (!bDone)
@@ -445,6 +495,119 @@ tCIDLib::TVoid TZLibCompImpl::Inflate(const tCIDLib::TBoolean bHaveDict)
                 break;
             }
 
+            case tCIDZLib_::EInfModes::GZHead :
+            {
+                //
+                //  Get the magic bytes, compression method and flags. We are
+                //  at the start so this is a clean 32 bits.
+                //
+                ReserveInflBits(32);
+                if ((m_c4InflBuf & 0xFFFF) != kCIDZLib_::c2GZipMagic)
+                {
+                    facCIDZLib().ThrowErr
+                    (
+                        CID_FILE
+                        , CID_LINE
+                        , kZLibErrs::errcInfl_BadGZipHdr
+                        , tCIDLib::ESeverities::Failed
+                        , tCIDLib::EErrClasses::Format
+                    );
+                }
+
+                if (((m_c4InflBuf >> 16) & 0xFF) != tCIDLib::c4EnumOrd(tCIDZLib_::ECompMethods::Deflated))
+                {
+                    facCIDZLib().ThrowErr
+                    (
+                        CID_FILE
+                        , CID_LINE
+                        , kZLibErrs::errcInfl_BadCompType
+                        , tCIDLib::ESeverities::Failed
+                        , tCIDLib::EErrClasses::Format
+                    );
+                }
+
+                c4GZFlags = m_c4InflBuf >> 24;
+                if (c4GZFlags & kCIDZLib_::c4GZFlag_Resvd)
+                {
+                    facCIDZLib().ThrowErr
+                    (
+                        CID_FILE
+                        , CID_LINE
+                        , kZLibErrs::errcInfl_BadGZipHdr
+                        , tCIDLib::ESeverities::Failed
+                        , tCIDLib::EErrClasses::Format
+                    );
+                }
+                ResetInflBitBuf();
+
+                // We don't care about the time, extra flags, or OS bytes
+                c4Extra = 6;
+                eState = tCIDZLib_::EInfModes::GZSkip;
+                break;
+            }
+
+            case tCIDZLib_::EInfModes::GZFlags :
+            {
+                //
+                //  Each optional field we process clears its flag and comes
+                //  back here, until there are none left.
+                //
+                if (c4GZFlags & kCIDZLib_::c4GZFlag_Extra)
+                {
+                    ReserveInflBits(16);
+                    c4Extra = c4GetInflBits(16);
+                    c4GZFlags &= ~kCIDZLib_::c4GZFlag_Extra;
+                    eState = tCIDZLib_::EInfModes::GZSkip;
+                }
+                 else if (c4GZFlags & (kCIDZLib_::c4GZFlag_Name | kCIDZLib_::c4GZFlag_Comment))
+                {
+                    eState = tCIDZLib_::EInfModes::GZString;
+                }
+                 else if (c4GZFlags & kCIDZLib_::c4GZFlag_HdrCRC)
+                {
+                    c4Extra = 2;
+                    c4GZFlags &= ~kCIDZLib_::c4GZFlag_HdrCRC;
+                    eState = tCIDZLib_::EInfModes::GZSkip;
+                }
+                 else
+                {
+                    eState = tCIDZLib_::EInfModes::Type;
+                }
+                break;
+            }
+
+            case tCIDZLib_::EInfModes::GZSkip :
+            {
+                while (c4Extra)
+                {
+                    ReserveInflBits(8);
+                    DropInflBits(8);
+                    c4Extra--;
+                }
+                eState = tCIDZLib_::EInfModes::GZFlags;
+                break;
+            }
+
+            case tCIDZLib_::EInfModes::GZString :
+            {
+                // Eat up to and including the terminating null
+                while (kCIDLib::True)
+                {
+                    ReserveInflBits(8);
+                    if (!c4GetInflBits(8))
+                        break;
+                }
+
+                // The name comes first if both are present
+                if (c4GZFlags & kCIDZLib_::c4GZFlag_Name)
+                    c4GZFlags &= ~kCIDZLib_::c4GZFlag_Name;
+                else
+                    c4GZFlags &= ~kCIDZLib_::c4GZFlag_Comment;
+
+                eState = tCIDZLib_::EInfModes::GZFlags;
+                break;
+            }
+
             case tCIDZLib_::EInfModes::DictId :
             {
                 // Eat the next 32 bits and reset buffer
@@ -550,7 +713,7 @@ tCIDLib::TVoid TZLibCompImpl::Inflate(const tCIDLib::TBoolean bHaveDict)
 
             case tCIDZLib_::EInfModes::Copy :
             {
-                // Copy bytes from the input to the output
+                // Copy bytes from the input to the output, counting down the length
                 CopyInflBlock(c4Length);
 
                 // And go back to looking for a block type
@@ -905,35 +1068,79 @@ tCIDLib::TVoid TZLibCompImpl::Inflate(const tCIDLib::TBoolean bHaveDict)
                 // Flush any remaining window data to the output stream
                 if (m_c4BytesAvail)
                 {
-                    m_pstrmOut->c4WriteRawBuffer(m_pc1WndBuf, m_c4BytesAvail);
-                    m_c4Adler = TRawMem::hshHashBufferAdler32
-                    (
-                        m_c4Adler
-                        , m_pc1WndBuf
-                        , m_c4BytesAvail
-                    );
-                    m_c4TotalOut += m_c4BytesAvail;
+                    WriteInflOut(m_c4BytesAvail);
                     m_c4BytesAvail = 0;
+                    m_c4InflFlushed = 0;
+                }
+
+                // Raw streams have no trailer
+                if (m_eFormat == tCIDZLib::EFormats::Raw)
+                {
+                    eState = tCIDZLib_::EInfModes::Done;
+                    break;
                 }
 
                 //
-                //  Get the next 32 bits (which should be the Adler sum). We
-                //  synced the input stream before getting here, so this
+                //  Get the next 32 bits (which should be the Adler sum or CRC).
+                //  We synced the input stream before getting here, so this
                 //  should get a clean 32 aligned bits.
                 //
                 ReserveInflBits(32);
 
-                if (TRawBits::c4SwapBytes(m_c4InflBuf) != m_c4Adler)
+                if (m_eFormat == tCIDZLib::EFormats::ZLib)
+                {
+                    if (TRawBits::c4SwapBytes(m_c4InflBuf) != m_c4Adler)
+                    {
+                        facCIDZLib().ThrowErr
+                        (
+                            CID_FILE
+                            , CID_LINE
+                            , kZLibErrs::errcInfl_BadCheckSum
+                            , tCIDLib::ESeverities::Failed
+                            , tCIDLib::EErrClasses::Format
+                        );
+                    }
+                    eState = tCIDZLib_::EInfModes::Done;
+                    break;
+                }
+
+                // It's gzip, so it's a little endian CRC, and then the length
+                if (m_c4InflBuf != (m_c4CRC ^ kCIDLib::c4MaxCard))
+                {
+                    facCIDZLib().ThrowErr
+                    (
+                        CID_FILE
+                        , CID_LINE
+                        , kZLibErrs::errcInfl_BadCRC
+                        , tCIDLib::ESeverities::Failed
+                        , tCIDLib::EErrClasses::Format
+                    );
+                }
+                ResetInflBitBuf();
+
+                // Set the new state and just fall through
+                eState = tCIDZLib_::EInfModes::GZSize;
+                [[fallthrough]];
+            }
+
+            case tCIDZLib_::EInfModes::GZSize :
+            {
+                // The length is modulo 2^32, which is what our count will be
+                ReserveInflBits(32);
+                if (m_c4InflBuf != m_c4TotalOut)
                 {
                     facCIDZLib().ThrowErr
                     (
                         CID_FILE
                         , CID_LINE
-                        , kZLibErrs::errcInfl_BadCheckSum
+                        , kZLibErrs::errcInfl_BadLength
                         , tCIDLib::ESeverities::Failed
                         , tCIDLib::EErrClasses::Format
+                        , TCardinal(m_c4TotalOut)
+                        , TCardinal(m_c4InflBuf)
                     );
                 }
+                ResetInflBitBuf();
 
                 eState = tCIDZLib_::EInfModes::Done;
                 break;
@@ -1281,6 +1488,38 @@ TZLibCompImpl::InflateTable(const   tCIDZLib_::EInflTbls    eTable
 }
 
 
+//
+//  Sets up the inflate state machine for a new stream, based on the format
+//  we are expecting.
+//
+tCIDLib::TVoid TZLibCompImpl::InitInflate()
+{
+    if (m_eFormat == tCIDZLib::EFormats::GZip)
+        m_infsCur.eState = tCIDZLib_::EInfModes::GZHead;
+    else if (m_eFormat == tCIDZLib::EFormats::Raw)
+        m_infsCur.eState = tCIDZLib_::EInfModes::Type;
+    else
+        m_infsCur.eState = tCIDZLib_::EInfModes::Head;
+
+    m_infsCur.bLastBlock = kCIDLib::False;
+    m_infsCur.c4DistBits = 0;
+    m_infsCur.c4Extra = 0;
+    m_infsCur.c4GZFlags = 0;
+    m_infsCur.c4Length = 0;
+    m_infsCur.c4LenBits = 0;
+    m_infsCur.c4LensCount = 0;
+    m_infsCur.c4NumCodes = 0;
+    m_infsCur.c4NumLens = 0;
+    m_infsCur.c4NumDists = 0;
+    m_infsCur.c4Offset = 0;
+    m_infsCur.pcdDist = nullptr;
+    m_infsCur.pcdLen = nullptr;
+    m_infsCur.pcdNext = nullptr;
+
+    m_c4InflFlushed = 0;
+}
+
+
 tCIDLib::TVoid TZLibCompImpl::PutInflByte(const tCIDLib::TCard1 c1ToPut)
 {
     //
@@ -1315,9 +1554,7 @@ tCIDLib::TVoid TZLibCompImpl::PullCompByte()
 {
     if (m_c4BitCount <= 24)
     {
-        tCIDLib::TCard1 c1Tmp;
-        *m_pstrmIn >> c1Tmp;
-        m_c4TotalIn++;
+        const tCIDLib::TCard1 c1Tmp = c1NextCompByte();
         m_c4InflBuf |= tCIDLib::TCard4(c1Tmp) << m_c4BitCount;
         m_c4BitCount += 8;
     }
@@ -1333,9 +1570,7 @@ TZLibCompImpl::ReserveInflBits(const tCIDLib::TCard4 c4ToRes)
 {
     while (m_c4BitCount < c4ToRes)
     {
-        tCIDLib::TCard1 c1Tmp;
-        *m_pstrmIn >> c1Tmp;
-        m_c4TotalIn++;
+        const tCIDLib::TCard1 c1Tmp = c1NextCompByte();
         m_c4InflBuf |= tCIDLib::TCard4(c1Tmp) << m_c4BitCount;
         m_c4BitCount += 8;
     }
@@ -1363,32 +1598,46 @@ tCIDLib::TVoid TZLibCompImpl::SyncInflStream()
 //  to the bottom of the buffer again, insuring that we keep 32K in there
 //  to handle any back references.
 //
-//  m_c4BytesAvail contains the number of valid bytes in the buffer.
+//  m_c4BytesAvail contains the number of valid bytes in the buffer. In feed
+//  mode some of the bytes may have already been written out, so we only
+//  write any that haven't.
 //
 tCIDLib::TVoid TZLibCompImpl::UpdateDecompBuf()
 {
     if (m_c4BytesAvail > kCIDZLib_::c4WndSz)
     {
         const tCIDLib::TCard4 c4ToWrite = m_c4BytesAvail - kCIDZLib_::c4WndSz;
-        m_pstrmOut->c4WriteRawBuffer(m_pc1WndBuf, c4ToWrite);
-
-        //
-        //  Before we overwrite the stuff we wrote out, add their bytes
-        //  to the Adler CRC so we can test at the end.
-        //
-        m_c4Adler = TRawMem::hshHashBufferAdler32(m_c4Adler, m_pc1WndBuf, c4ToWrite);
+        if (c4ToWrite > m_c4InflFlushed)
+            WriteInflOut(c4ToWrite);
 
         // Move the rest down
         TRawMem::MoveMemBuf(m_pc1WndBuf, &m_pc1WndBuf[c4ToWrite], m_c4BytesAvail - c4ToWrite);
 
         //
         //  Reduce the amount of bytes available in the buffer by the bytes
-        //  we wrote, and bump up the current offset by that much, because
-        //  it represents the index (into the output stream) of the base of
-        //  the buffer.
+        //  we wrote, and adjust the flushed count to match.
         //
         m_c4BytesAvail -= c4ToWrite;
-        m_c4TotalOut += c4ToWrite;
+        m_c4InflFlushed -= c4ToWrite;
     }
 }
 
+
+//
+//  Writes out any bytes in the window, up to the indicated index, that
+//  haven't already been written. Before they go out, we add them to the
+//  running check value so we can test it at the end.
+//
+tCIDLib::TVoid TZLibCompImpl::WriteInflOut(const tCIDLib::TCard4 c4UpTo)
+{
+    if (c4UpTo <= m_c4InflFlushed)
+        return;
+
+    const tCIDLib::TCard4 c4Count = c4UpTo - m_c4InflFlushed;
+    const tCIDLib::TCard1* pc1Start = m_pc1WndBuf + m_c4InflFlushed;
+    m_pstrmOut->c4WriteRawBuffer(pc1Start, c4Count);
+    UpdateCheck(pc1Start, c4Count);
+
+    m_c4TotalOut += c4Count;
+    m_c4InflFlushed = c4UpTo;
+}
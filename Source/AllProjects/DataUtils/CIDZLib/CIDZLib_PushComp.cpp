@@ -0,0 +1,411 @@
+//
+// FILE NAME: CIDZLib_PushComp.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the push style compressor and decompressor classes.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDZLib_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Do our RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TZLibPushCompressor,TObject)
+RTTIDecls(TZLibPushDecompressor,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibPushCompressor
+// PREFIX: zpc
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TZLibPushCompressor: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TZLibPushCompressor::TZLibPushCompressor(const  tCIDZLib::EFormats      eFormat
+                                        , const tCIDZLib::ECompLevels   eLevel) :
+
+    m_bFinished(kCIDLib::False)
+    , m_bHdrDone(kCIDLib::False)
+    , m_c4Check(0)
+    , m_c4DictSz(0)
+    , m_c4PendSz(0)
+    , m_c4TotalIn(0)
+    , m_c4TotalOut(0)
+    , m_eFormat(eFormat)
+    , m_pc1Buf(nullptr)
+    , m_pzimplThis(nullptr)
+{
+    m_pzimplThis = new TZLibCompImpl(eLevel, tCIDZLib_::EStrategies::Default);
+
+    //
+    //  The impl only does segments for us, which are raw deflate data, and
+    //  we do the framing. So leave it in the default format.
+    //
+    m_pc1Buf = new tCIDLib::TCard1[kCIDZLib_::c4WndSz + kCIDZLib::c4PushBufSz];
+    Reset();
+}
+
+TZLibPushCompressor::~TZLibPushCompressor()
+{
+    delete [] m_pc1Buf;
+    delete m_pzimplThis;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TZLibPushCompressor: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TZLibPushCompressor::bFinished() const
+{
+    return m_bFinished;
+}
+
+
+//
+//  Add the new data to our pending buffer. Each time it fills up, we compress
+//  it and write it out. We return the number of compressed bytes written,
+//  which will often be zero.
+//
+tCIDLib::TCard4
+TZLibPushCompressor::c4Feed(const   tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4Count
+                            ,       TBinOutStream&          strmOutput)
+{
+    CheckNotFinished(CID_LINE);
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
+
+    // Add it to the check value up front, since it's all going in
+    if (m_eFormat == tCIDZLib::EFormats::ZLib)
+        m_c4Check = TRawMem::hshHashBufferAdler32(m_c4Check, pc1Data, c4Count);
+    else if (m_eFormat == tCIDZLib::EFormats::GZip)
+        m_c4Check = TRawMem::hshHashBuffer3309(m_c4Check, pc1Data, c4Count);
+    m_c4TotalIn += c4Count;
+
+    tCIDLib::TCard4 c4Done = 0;
+    while (c4Done < c4Count)
+    {
+        const tCIDLib::TCard4 c4ThisTime = tCIDLib::MinVal
+        (
+            c4Count - c4Done, kCIDZLib::c4PushBufSz - m_c4PendSz
+        );
+
+        TRawMem::CopyMemBuf
+        (
+            m_pc1Buf + m_c4DictSz + m_c4PendSz, pc1Data + c4Done, c4ThisTime
+        );
+        m_c4PendSz += c4ThisTime;
+        c4Done += c4ThisTime;
+
+        if (m_c4PendSz == kCIDZLib::c4PushBufSz)
+            CompressPending(strmOutput, kCIDLib::False);
+    }
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4Ret = strmOutput.c4CurPos() - c4OrgPos;
+    m_c4TotalOut += c4Ret;
+    return c4Ret;
+}
+
+tCIDLib::TCard4
+TZLibPushCompressor::c4Feed(const   TMemBuf&        mbufData
+                            , const tCIDLib::TCard4 c4Count
+                            ,       TBinOutStream&  strmOutput)
+{
+    return c4Feed(mbufData.pc1Data(), c4Count, strmOutput);
+}
+
+
+//
+//  Compress any pending data as the last segment, and write out the trailer.
+//  After this we have to be reset before being used again.
+//
+tCIDLib::TCard4 TZLibPushCompressor::c4Finish(TBinOutStream& strmOutput)
+{
+    CheckNotFinished(CID_LINE);
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
+
+    CompressPending(strmOutput, kCIDLib::True);
+    TZLibCompImpl::c4PutStreamTrailer
+    (
+        strmOutput
+        , m_eFormat
+        , (m_eFormat == tCIDZLib::EFormats::GZip) ? (m_c4Check ^ kCIDLib::c4MaxCard) : m_c4Check
+        , m_c4TotalIn
+    );
+    m_bFinished = kCIDLib::True;
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4Ret = strmOutput.c4CurPos() - c4OrgPos;
+    m_c4TotalOut += c4Ret;
+    return c4Ret;
+}
+
+
+//
+//  Force out any pending data, ending on a byte boundary, so that the other
+//  side can decompress everything we've been fed so far. If nothing is pending
+//  then everything has already gone out, so there's nothing to do.
+//
+tCIDLib::TCard4 TZLibPushCompressor::c4Flush(TBinOutStream& strmOutput)
+{
+    CheckNotFinished(CID_LINE);
+
+    if (!m_c4PendSz)
+        return 0;
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
+
+    CompressPending(strmOutput, kCIDLib::False);
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4Ret = strmOutput.c4CurPos() - c4OrgPos;
+    m_c4TotalOut += c4Ret;
+    return c4Ret;
+}
+
+
+tCIDLib::TCard4 TZLibPushCompressor::c4TotalIn() const
+{
+    return m_c4TotalIn;
+}
+
+tCIDLib::TCard4 TZLibPushCompressor::c4TotalOut() const
+{
+    return m_c4TotalOut;
+}
+
+
+tCIDZLib::EFormats TZLibPushCompressor::eFormat() const
+{
+    return m_eFormat;
+}
+
+
+// Get ready to start a new stream
+tCIDLib::TVoid TZLibPushCompressor::Reset()
+{
+    m_bFinished = kCIDLib::False;
+    m_bHdrDone = kCIDLib::False;
+    m_c4DictSz = 0;
+    m_c4PendSz = 0;
+    m_c4TotalIn = 0;
+    m_c4TotalOut = 0;
+
+    if (m_eFormat == tCIDZLib::EFormats::GZip)
+        m_c4Check = kCIDLib::c4MaxCard;
+    else
+        m_c4Check = TRawMem::hshHashBufferAdler32(0, 0, 0);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TZLibPushCompressor: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TVoid
+TZLibPushCompressor::CheckNotFinished(const tCIDLib::TCard4 c4Line) const
+{
+    if (m_bFinished)
+    {
+        facCIDZLib().ThrowErr
+        (
+            CID_FILE
+            , c4Line
+            , kZLibErrs::errcPush_Finished
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::NotReady
+        );
+    }
+}
+
+
+//
+//  Compress the pending data as a segment, primed with the previous window's
+//  worth of data. Then move the last window's worth of data down to the start
+//  of the buffer to be the dictionary for the next round. If this is not the
+//  last one, the impl ends it with a sync flush, so it's byte aligned and the
+//  next one can just follow it.
+//
+tCIDLib::TVoid
+TZLibPushCompressor::CompressPending(       TBinOutStream&      strmOutput
+                                    , const tCIDLib::TBoolean   bLast)
+{
+    if (!m_bHdrDone)
+    {
+        m_pzimplThis->eFormat(m_eFormat);
+        m_pzimplThis->c4PutStreamHeader(strmOutput);
+        m_pzimplThis->eFormat(tCIDZLib::EFormats::ZLib);
+        m_bHdrDone = kCIDLib::True;
+    }
+
+    m_pzimplThis->c4CompressSeg
+    (
+        m_pc1Buf, m_c4DictSz, m_pc1Buf + m_c4DictSz, m_c4PendSz, bLast, strmOutput
+    );
+
+    const tCIDLib::TCard4 c4End = m_c4DictSz + m_c4PendSz;
+    const tCIDLib::TCard4 c4NewDictSz = tCIDLib::MinVal(kCIDZLib_::c4WndSz, c4End);
+    TRawMem::MoveMemBuf(m_pc1Buf, m_pc1Buf + (c4End - c4NewDictSz), c4NewDictSz);
+    m_c4DictSz = c4NewDictSz;
+    m_c4PendSz = 0;
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibPushDecompressor
+// PREFIX: zpd
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TZLibPushDecompressor: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TZLibPushDecompressor::TZLibPushDecompressor(const tCIDZLib::EFormats eFormat) :
+
+    m_bDone(kCIDLib::False)
+    , m_c4TotalIn(0)
+    , m_c4TotalOut(0)
+    , m_eFormat(eFormat)
+    , m_pzimplThis(nullptr)
+{
+    m_pzimplThis = new TZLibCompImpl
+    (
+        tCIDZLib::ECompLevels::Default, tCIDZLib_::EStrategies::Default
+    );
+    m_pzimplThis->eFormat(m_eFormat);
+    Reset();
+}
+
+TZLibPushDecompressor::~TZLibPushDecompressor()
+{
+    delete m_pzimplThis;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TZLibPushDecompressor: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TZLibPushDecompressor::bDone() const
+{
+    return m_bDone;
+}
+
+
+//
+//  Decompress as much as we can from the new data, and write it all out. We
+//  return the number of decompressed bytes written. Anything after the end of
+//  the stream is ignored.
+//
+tCIDLib::TCard4
+TZLibPushDecompressor::c4Feed(  const   tCIDLib::TCard1* const  pc1Data
+                                , const tCIDLib::TCard4         c4Count
+                                ,       TBinOutStream&          strmOutput)
+{
+    if (m_bDone)
+        return 0;
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4OrgPos = strmOutput.c4CurPos();
+
+    m_bDone = m_pzimplThis->bFeedInflate(pc1Data, c4Count, strmOutput);
+    m_c4TotalIn += c4Count;
+
+    strmOutput.Flush();
+    const tCIDLib::TCard4 c4Ret = strmOutput.c4CurPos() - c4OrgPos;
+    m_c4TotalOut += c4Ret;
+    return c4Ret;
+}
+
+tCIDLib::TCard4
+TZLibPushDecompressor::c4Feed(  const   TMemBuf&        mbufData
+                                , const tCIDLib::TCard4 c4Count
+                                ,       TBinOutStream&  strmOutput)
+{
+    return c4Feed(mbufData.pc1Data(), c4Count, strmOutput);
+}
+
+
+tCIDLib::TCard4 TZLibPushDecompressor::c4TotalIn() const
+{
+    return m_c4TotalIn;
+}
+
+tCIDLib::TCard4 TZLibPushDecompressor::c4TotalOut() const
+{
+    return m_c4TotalOut;
+}
+
+
+tCIDZLib::EFormats TZLibPushDecompressor::eFormat() const
+{
+    return m_eFormat;
+}
+
+
+//
+//  The caller has no more data for us. If we didn't see the end of the stream,
+//  then it was truncated.
+//
+tCIDLib::TVoid TZLibPushDecompressor::Finish()
+{
+    if (!m_bDone)
+    {
+        facCIDZLib().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kZLibErrs::errcInfl_Truncated
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+        );
+    }
+}
+
+
+// Get ready to start a new stream
+tCIDLib::TVoid TZLibPushDecompressor::Reset()
+{
+    m_bDone = kCIDLib::False;
+    m_c4TotalIn = 0;
+    m_c4TotalOut = 0;
+    m_pzimplThis->StartFeedInflate();
+}
+
+// Get ready to start a new stream, which may be in a different format
+tCIDLib::TVoid TZLibPushDecompressor::Reset(const tCIDZLib::EFormats eFormat)
+{
+    m_eFormat = eFormat;
+    m_pzimplThis->eFormat(m_eFormat);
+    Reset();
+}
@@ -0,0 +1,283 @@
+//
+// FILE NAME: CIDZLib_PushComp.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header file for the CIDZLib_PushComp.Cpp file. This file
+//  implements push style compression and decompression, for when the data
+//  shows up in chunks (network streams, HTTP bodies, logs being written) and
+//  we don't want to have to buffer it all up to do it in one shot.
+//
+//  TZLibPushCompressor is fed chunks of data, and writes out compressed data
+//  as it goes. Flush forces out everything fed so far, in a way that the other
+//  side can decompress it all (a sync flush), and Finish ends the stream and
+//  writes out the trailer. It buffers up to kCIDZLib::c4PushBufSz bytes of
+//  input, plus a window's worth of previous data so we don't lose matches
+//  across buffer boundaries.
+//
+//  TZLibPushDecompressor is fed chunks of compressed data, and writes out all
+//  of the data it can decompress from them on each call. So there's nothing to
+//  flush. Finish just confirms that we saw the whole stream.
+//
+//  Both support the zlib, gzip, and raw deflate formats.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Once finished, they must be reset before they can be used again.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+class TZLibCompImpl;
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibPushCompressor
+// PREFIX: zpc
+// ---------------------------------------------------------------------------
+class CIDZLIBEXP TZLibPushCompressor : public TObject
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TZLibPushCompressor
+        (
+            const   tCIDZLib::EFormats      eFormat = tCIDZLib::EFormats::ZLib
+            , const tCIDZLib::ECompLevels   eLevel = tCIDZLib::ECompLevels::Default
+        );
+
+        TZLibPushCompressor(const TZLibPushCompressor&) = delete;
+        TZLibPushCompressor(TZLibPushCompressor&&) = delete;
+
+        ~TZLibPushCompressor();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TZLibPushCompressor& operator=(const TZLibPushCompressor&) = delete;
+        TZLibPushCompressor& operator=(TZLibPushCompressor&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFinished() const;
+
+        tCIDLib::TCard4 c4Feed
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4Count
+            ,       TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4Feed
+        (
+            const   TMemBuf&                mbufData
+            , const tCIDLib::TCard4         c4Count
+            ,       TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4Finish
+        (
+                    TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4Flush
+        (
+                    TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4TotalIn() const;
+
+        tCIDLib::TCard4 c4TotalOut() const;
+
+        tCIDZLib::EFormats eFormat() const;
+
+        tCIDLib::TVoid Reset();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid CheckNotFinished
+        (
+            const   tCIDLib::TCard4         c4Line
+        )   const;
+
+        tCIDLib::TVoid CompressPending
+        (
+                    TBinOutStream&          strmOutput
+            , const tCIDLib::TBoolean       bLast
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bFinished
+        //      Set once we've been finished, after which we have to be reset
+        //      before we can be used again.
+        //
+        //  m_bHdrDone
+        //      We don't write out the stream header until we first write out
+        //      compressed data, so this remembers if it's been done yet.
+        //
+        //  m_c4Check
+        //      The running check value of the input data, Adler-32 or the raw
+        //      (not yet inverted) CRC-32 depending on the format.
+        //
+        //  m_c4DictSz
+        //  m_c4PendSz
+        //  m_pc1Buf
+        //      The buffer holds the previous window's worth of data, which is
+        //      used to prime the next segment, followed by the data fed to us
+        //      but not yet compressed.
+        //
+        //  m_c4TotalIn
+        //  m_c4TotalOut
+        //      The bytes fed to us and compressed bytes written out, since the
+        //      last reset.
+        //
+        //  m_eFormat
+        //      The framing format we are creating.
+        //
+        //  m_pzimplThis
+        //      The compression impl object that does the real work.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean   m_bFinished;
+        tCIDLib::TBoolean   m_bHdrDone;
+        tCIDLib::TCard4     m_c4Check;
+        tCIDLib::TCard4     m_c4DictSz;
+        tCIDLib::TCard4     m_c4PendSz;
+        tCIDLib::TCard4     m_c4TotalIn;
+        tCIDLib::TCard4     m_c4TotalOut;
+        tCIDZLib::EFormats  m_eFormat;
+        tCIDLib::TCard1*    m_pc1Buf;
+        TZLibCompImpl*      m_pzimplThis;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TZLibPushCompressor,TObject)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibPushDecompressor
+// PREFIX: zpd
+// ---------------------------------------------------------------------------
+class CIDZLIBEXP TZLibPushDecompressor : public TObject
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TZLibPushDecompressor
+        (
+            const   tCIDZLib::EFormats      eFormat = tCIDZLib::EFormats::ZLib
+        );
+
+        TZLibPushDecompressor(const TZLibPushDecompressor&) = delete;
+        TZLibPushDecompressor(TZLibPushDecompressor&&) = delete;
+
+        ~TZLibPushDecompressor();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TZLibPushDecompressor& operator=(const TZLibPushDecompressor&) = delete;
+        TZLibPushDecompressor& operator=(TZLibPushDecompressor&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bDone() const;
+
+        tCIDLib::TCard4 c4Feed
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4Count
+            ,       TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4Feed
+        (
+            const   TMemBuf&                mbufData
+            , const tCIDLib::TCard4         c4Count
+            ,       TBinOutStream&          strmOutput
+        );
+
+        tCIDLib::TCard4 c4TotalIn() const;
+
+        tCIDLib::TCard4 c4TotalOut() const;
+
+        tCIDZLib::EFormats eFormat() const;
+
+        tCIDLib::TVoid Finish();
+
+        tCIDLib::TVoid Reset();
+
+        tCIDLib::TVoid Reset
+        (
+            const   tCIDZLib::EFormats      eFormat
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bDone
+        //      Set once we've seen the end of the compressed stream. Anything
+        //      fed to us after that is ignored.
+        //
+        //  m_c4TotalIn
+        //  m_c4TotalOut
+        //      The compressed bytes fed to us and the decompressed bytes we've
+        //      written out, since the last reset.
+        //
+        //  m_eFormat
+        //      The framing format we expect.
+        //
+        //  m_pzimplThis
+        //      The compression impl object that does the real work. It keeps
+        //      all of the inflate state between feeds.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean   m_bDone;
+        tCIDLib::TCard4     m_c4TotalIn;
+        tCIDLib::TCard4     m_c4TotalOut;
+        tCIDZLib::EFormats  m_eFormat;
+        TZLibCompImpl*      m_pzimplThis;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TZLibPushDecompressor,TObject)
+};
+
+#pragma CIDLIB_POPPACK
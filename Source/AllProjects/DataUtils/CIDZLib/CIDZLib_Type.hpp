@@ -51,5 +51,21 @@ namespace tCIDZLib
         , BestCompr = 9
         , Default   = 6
     };
+
+
+    // -----------------------------------------------------------------------
+    //  The framing put around the deflated data. ZLib is the original format
+    //  with a two byte header and Adler-32 trailer. GZip has a larger header
+    //  and a CRC-32 plus length trailer, and is what files and HTTP use. Raw
+    //  is just the deflate data with no framing or check value at all.
+    // -----------------------------------------------------------------------
+    enum class EFormats
+    {
+        ZLib
+        , GZip
+        , Raw
+
+        , Count
+    };
 }
 
@@ -213,6 +213,49 @@ tCIDLib::TVoid TZLibCompImpl::PerBlockReset()
 }
 
 
+//
+//  Loads a preset dictionary into the bottom of the window and puts all of its
+//  strings into the hash table, so that the first bytes of real data can find
+//  matches in it. The current offset is left just past the dictionary, so the
+//  dictionary itself is never output. Only the last window's worth is useful,
+//  so any more than that is ignored.
+//
+tCIDLib::TVoid
+TZLibCompImpl::PrimeDict(const  tCIDLib::TCard1* const  pc1Dict
+                        , const tCIDLib::TCard4         c4DictSz)
+{
+    tCIDLib::TCard4 c4Count = c4DictSz;
+    const tCIDLib::TCard1* pc1Src = pc1Dict;
+    if (c4Count > kCIDZLib_::c4WndSz)
+    {
+        pc1Src += c4Count - kCIDZLib_::c4WndSz;
+        c4Count = kCIDZLib_::c4WndSz;
+    }
+
+    TRawMem::CopyMemBuf(m_pc1WndBuf, pc1Src, c4Count);
+    m_c4CurOfs = c4Count;
+
+    // If not enough for even one string, then nothing to hash
+    if (c4Count < kCIDZLib_::c4MinMatch)
+        return;
+
+    tCIDLib::TCard2 c2InsHash = m_pc1WndBuf[0];
+    c2InsHash = ((c2InsHash << kCIDZLib_::c4HashShift) ^ m_pc1WndBuf[1])
+                & kCIDZLib_::c4HashMask;
+
+    const tCIDLib::TCard4 c4Last = c4Count - kCIDZLib_::c4MinMatch;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index <= c4Last; c4Index++)
+    {
+        c2InsHash = ((c2InsHash << kCIDZLib_::c4HashShift)
+                    ^ m_pc1WndBuf[c4Index + (kCIDZLib_::c4MinMatch - 1)])
+                    & kCIDZLib_::c4HashMask;
+
+        m_pc2HashPrev[c4Index & kCIDZLib_::c4WndMask] = m_pc2HashTbl[c2InsHash];
+        m_pc2HashTbl[c2InsHash] = tCIDLib::TCard2(c4Index);
+    }
+}
+
+
 // Dumps a byte to the output stream and bumps the out count
 tCIDLib::TVoid TZLibCompImpl::PutByte(const tCIDLib::TCard1 c1ToPut)
 {
@@ -245,6 +288,7 @@ tCIDLib::TVoid TZLibCompImpl::Reset()
     m_bEndOfInput = kCIDLib::False;
     m_c2LastEOBLen = 8;
     m_c4Adler = TRawMem::hshHashBufferAdler32(0, 0, 0);
+    m_c4CRC = kCIDLib::c4MaxCard;
     m_c4BitCount = 0;
     m_c4BytesAvail = 0;
     m_c4CurOfs = 0;
@@ -442,3 +486,17 @@ tCIDLib::TVoid TZLibCompImpl::SendTree(const TZTreeDescr& tdToSend)
 }
 
 
+//
+//  Adds data to the running check value for our format. For compression this
+//  is the input and for decompression the output. Raw streams have no check
+//  value so we don't waste the time.
+//
+tCIDLib::TVoid
+TZLibCompImpl::UpdateCheck( const   tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4Count)
+{
+    if (m_eFormat == tCIDZLib::EFormats::ZLib)
+        m_c4Adler = TRawMem::hshHashBufferAdler32(m_c4Adler, pc1Data, c4Count);
+    else if (m_eFormat == tCIDZLib::EFormats::GZip)
+        m_c4CRC = TRawMem::hshHashBuffer3309(m_c4CRC, pc1Data, c4Count);
+}
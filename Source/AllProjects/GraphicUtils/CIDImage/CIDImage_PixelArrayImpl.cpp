@@ -46,6 +46,569 @@ namespace
         //      and added new formats to cover the full range of PNG images.
         // -----------------------------------------------------------------------
         constexpr tCIDLib::TCard2   c2FmtVersion = 2;
+
+
+        // -----------------------------------------------------------------------
+        //  The row band stuff below won't split an operation across threads
+        //  unless it's at least this many pixels, and it won't create bands of
+        //  fewer than this many rows. Below that queuing up the bands costs more
+        //  than it saves.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MinBandPixels = 256 * 1024;
+        constexpr tCIDLib::TCard4   c4MinBandRows = 32;
+
+
+        // -----------------------------------------------------------------------
+        //  Each row band gets one of these. It has the range of rows to process
+        //  and the operation to do. If the operation fails, it stores the error
+        //  for the calling thread to throw.
+        // -----------------------------------------------------------------------
+        template <typename TBandOp> struct TRowBand
+        {
+            const TBandOp*      popBand = nullptr;
+            tCIDLib::TCard4     c4FirstRow = 0;
+            tCIDLib::TCard4     c4EndRow = 0;
+            tCIDLib::TBoolean   bFailed = kCIDLib::False;
+            TError              errFailure;
+        };
+
+        template <typename TBandOp> tCIDLib::TVoid RunRowBand(TRowBand<TBandOp>& bandRun)
+        {
+            try
+            {
+                (*bandRun.popBand)(bandRun.c4FirstRow, bandRun.c4EndRow);
+            }
+
+            catch(TError& errToCatch)
+            {
+                bandRun.errFailure = errToCatch;
+                bandRun.bFailed = kCIDLib::True;
+            }
+
+            catch(...)
+            {
+                bandRun.bFailed = kCIDLib::True;
+            }
+        }
+
+        // -----------------------------------------------------------------------
+        //  Runs a row oriented operation over the rows from c4FirstRow up to but
+        //  not including c4EndRow. If the image is large enough it's split into
+        //  bands of rows which are queued on the shared thread pool, with the
+        //  calling thread doing the last band. The operation is called with the
+        //  range of rows to do, and must only write to those rows of its target.
+        //
+        //  The bands refer to our local data, so we have to wait for every band
+        //  that got queued before we can return, even if something fails. If a
+        //  band's task got cancelled before it ran (the pool is shutting down)
+        //  we just do that band ourself.
+        // -----------------------------------------------------------------------
+        template <typename TBandOp>
+        tCIDLib::TVoid DoRowBands(  const   tCIDLib::TCard4 c4FirstRow
+                                    , const tCIDLib::TCard4 c4EndRow
+                                    , const tCIDLib::TCard4 c4Width
+                                    , const TBandOp&        opBand)
+        {
+            if (c4FirstRow >= c4EndRow)
+                return;
+
+            const tCIDLib::TCard4 c4Rows = c4EndRow - c4FirstRow;
+            tCIDLib::TCard4 c4BandCnt = 1;
+            if (c4Rows * c4Width >= c4MinBandPixels)
+            {
+                c4BandCnt = tCIDLib::MinVal
+                (
+                    TSysInfo::c4CPUCount(), c4Rows / c4MinBandRows
+                );
+            }
+
+            if (c4BandCnt < 2)
+            {
+                opBand(c4FirstRow, c4EndRow);
+                return;
+            }
+
+            TObjArray<TRowBand<TBandOp>> objaBands(c4BandCnt);
+            TVector<TThreadPool::TTaskPtr> colTasks(c4BandCnt);
+
+            const tCIDLib::TCard4 c4PerBand = c4Rows / c4BandCnt;
+            tCIDLib::TCard4 c4CurRow = c4FirstRow;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BandCnt; c4Index++)
+            {
+                TRowBand<TBandOp>& bandCur = objaBands[c4Index];
+                bandCur.popBand = &opBand;
+                bandCur.c4FirstRow = c4CurRow;
+                if (c4Index + 1 == c4BandCnt)
+                    c4CurRow = c4EndRow;
+                else
+                    c4CurRow += c4PerBand;
+                bandCur.c4EndRow = c4CurRow;
+            }
+
+            // Queue up all but the last band on the shared pool
+            TThreadPool& tpoolBands = TThreadPool::tpoolShared();
+            try
+            {
+                for (tCIDLib::TCard4 c4Index = 0; c4Index + 1 < c4BandCnt; c4Index++)
+                {
+                    TRowBand<TBandOp>* pbandCur = &objaBands[c4Index];
+                    colTasks.objAdd
+                    (
+                        tpoolBands.cptrRun
+                        (
+                            [pbandCur](TThreadPoolTask&) { RunRowBand(*pbandCur); }
+                        )
+                    );
+                }
+            }
+
+            catch(TError& errToCatch)
+            {
+                // We can still do the rest ourself below, so just log it
+                if (!errToCatch.bLogged())
+                {
+                    errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                    TModule::LogEventObj(errToCatch);
+                }
+            }
+
+            //
+            //  If we couldn't queue them all, do the rest here. Either way we do
+            //  the last one ourself, then wait for the queued ones.
+            //
+            for (tCIDLib::TCard4 c4Index = colTasks.c4ElemCount(); c4Index < c4BandCnt; c4Index++)
+                RunRowBand(objaBands[c4Index]);
+
+            const tCIDLib::TCard4 c4Queued = colTasks.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Queued; c4Index++)
+            {
+                colTasks[c4Index]->bWaitDone();
+                if (colTasks[c4Index]->eState() == tCIDLib::ETaskStates::Cancelled)
+                    RunRowBand(objaBands[c4Index]);
+            }
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BandCnt; c4Index++)
+            {
+                TRowBand<TBandOp>& bandCur = objaBands[c4Index];
+                if (bandCur.bFailed)
+                {
+                    bandCur.errFailure.AddStackLevel(CID_FILE, CID_LINE);
+                    throw bandCur.errFailure;
+                }
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  A fast divide by 255 for values up to 255 * 255, which gives the same
+        //  truncated result as a real divide. This is what gets used for all of
+        //  the 8 bit alpha scaling.
+        // -----------------------------------------------------------------------
+        inline tCIDLib::TCard1 c1DivBy255(const tCIDLib::TCard4 c4Val)
+        {
+            return tCIDLib::TCard1((c4Val + 1 + (c4Val >> 8)) >> 8);
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Row kernels for the 8 bit per component formats. These work on a whole
+        //  row at a time directly on the pixel data. They are written with simple
+        //  loops of fixed stride and no branches, so that the compiler can keep
+        //  them in vector registers.
+        // -----------------------------------------------------------------------
+
+        // Pre-multiply a row of BGRA pixels by their own alpha
+        inline tCIDLib::TVoid
+        PremulRow4(tCIDLib::TCard1* const pc1Row, const tCIDLib::TCard4 c4Pixels)
+        {
+            tCIDLib::TCard1* pc1Cur = pc1Row;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pixels; c4Index++)
+            {
+                const tCIDLib::TCard4 c4Alpha = pc1Cur[3];
+                pc1Cur[0] = c1DivBy255(pc1Cur[0] * c4Alpha);
+                pc1Cur[1] = c1DivBy255(pc1Cur[1] * c4Alpha);
+                pc1Cur[2] = c1DivBy255(pc1Cur[2] * c4Alpha);
+                pc1Cur += 4;
+            }
+        }
+
+        //
+        //  Scale a component by an alpha value, for 8 and 16 bit components. It
+        //  truncates, as the original per-pixel code did.
+        //
+        inline tCIDLib::TCard1
+        tScaleByAlpha(const tCIDLib::TCard1 c1Val, const tCIDLib::TCard1 c1Alpha)
+        {
+            return c1DivBy255(tCIDLib::TCard4(c1Val) * c1Alpha);
+        }
+
+        inline tCIDLib::TCard2
+        tScaleByAlpha(const tCIDLib::TCard2 c2Val, const tCIDLib::TCard2 c2Alpha)
+        {
+            return tCIDLib::TCard2((tCIDLib::TCard4(c2Val) * c2Alpha) / 0xFFFF);
+        }
+
+        //
+        //  Set the alpha of a row of pixels of c4Comps components each, with the
+        //  alpha in the last one, optionally pre-multiplying the other components
+        //  by the new alpha. One sets them all to the same alpha, the other takes
+        //  an alpha per pixel.
+        //
+        template <typename TElem, tCIDLib::TCard4 c4Comps> tCIDLib::TVoid
+        SetAlphaRow(        TElem* const            ptRow
+                    , const tCIDLib::TCard4         c4Pixels
+                    , const TElem                   tAlpha
+                    , const tCIDLib::TBoolean       bPremul)
+        {
+            TElem* ptCur = ptRow;
+            if (bPremul)
+            {
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pixels; c4Index++)
+                {
+                    for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4Comps - 1; c4CInd++)
+                        ptCur[c4CInd] = tScaleByAlpha(ptCur[c4CInd], tAlpha);
+                    ptCur[c4Comps - 1] = tAlpha;
+                    ptCur += c4Comps;
+                }
+            }
+             else
+            {
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pixels; c4Index++)
+                {
+                    ptCur[c4Comps - 1] = tAlpha;
+                    ptCur += c4Comps;
+                }
+            }
+        }
+
+        template <typename TElem, tCIDLib::TCard4 c4Comps> tCIDLib::TVoid
+        SetAlphaSpan(       TElem* const            ptRow
+                    , const tCIDLib::TCard4         c4Pixels
+                    , const TElem* const            ptAlphas
+                    , const tCIDLib::TBoolean       bPremul)
+        {
+            TElem* ptCur = ptRow;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pixels; c4Index++)
+            {
+                const TElem tAlpha = ptAlphas[c4Index];
+                if (bPremul)
+                {
+                    for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4Comps - 1; c4CInd++)
+                        ptCur[c4CInd] = tScaleByAlpha(ptCur[c4CInd], tAlpha);
+                }
+                ptCur[c4Comps - 1] = tAlpha;
+                ptCur += c4Comps;
+            }
+        }
+
+        //
+        //  Apply an alpha ramp to a range of rows or columns. The levels are from
+        //  0 to 1, one per row/col starting at c4First, and are scaled up to the
+        //  max alpha for the component size.
+        //
+        template <typename TElem, tCIDLib::TCard4 c4Comps> tCIDLib::TVoid
+        ApplyAlphaRamp(         TPixelArrayImpl&        pixaiTar
+                        , const tCIDLib::TBoolean       bHorz
+                        , const tCIDLib::TCard4         c4First
+                        , const tCIDLib::TCard4         c4Count
+                        , const tCIDLib::TFloat8* const pf8Levels
+                        , const tCIDLib::TCard4         c4MaxAlpha
+                        , const tCIDLib::TBoolean       bPremul)
+        {
+            // Clip the range to the image
+            const tCIDLib::TCard4 c4Limit = bHorz ? pixaiTar.c4Width() : pixaiTar.c4Height();
+            if (c4First >= c4Limit)
+                return;
+            const tCIDLib::TCard4 c4RealCnt = tCIDLib::MinVal(c4Count, c4Limit - c4First);
+
+            TElem* ptAlphas = new TElem[c4RealCnt];
+            TArrayJanitor<TElem> janAlphas(ptAlphas);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4RealCnt; c4Index++)
+                ptAlphas[c4Index] = TElem(pf8Levels[c4Index] * c4MaxAlpha);
+
+            tCIDLib::TCard1* const pc1Pixels = pixaiTar.pc1Buffer();
+            const tCIDLib::TCard4 c4LineWidth = pixaiTar.c4LineWidth();
+            const tCIDLib::TCard4 c4Width = pixaiTar.c4Width();
+            if (bHorz)
+            {
+                DoRowBands
+                (
+                    0
+                    , pixaiTar.c4Height()
+                    , c4Width
+                    , [=](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
+                    {
+                        for (tCIDLib::TCard4 c4Row = c4FirstRow; c4Row < c4EndRow; c4Row++)
+                        {
+                            TElem* ptRow = reinterpret_cast<TElem*>
+                            (
+                                pc1Pixels + (c4Row * c4LineWidth)
+                            );
+                            SetAlphaSpan<TElem, c4Comps>
+                            (
+                                ptRow + (c4First * c4Comps), c4RealCnt, ptAlphas, bPremul
+                            );
+                        }
+                    }
+                );
+            }
+             else
+            {
+                DoRowBands
+                (
+                    c4First
+                    , c4First + c4RealCnt
+                    , c4Width
+                    , [=](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
+                    {
+                        for (tCIDLib::TCard4 c4Row = c4FirstRow; c4Row < c4EndRow; c4Row++)
+                        {
+                            SetAlphaRow<TElem, c4Comps>
+                            (
+                                reinterpret_cast<TElem*>(pc1Pixels + (c4Row * c4LineWidth))
+                                , c4Width
+                                , ptAlphas[c4Row - c4First]
+                                , bPremul
+                            );
+                        }
+                    }
+                );
+            }
+        }
+
+        //
+        //  Convert a row of BGR or BGRA pixels to gray scale in place, leaving
+        //  the alpha alone. It uses the same float weights as the generic pixel
+        //  by pixel code, so the results are identical.
+        //
+        template <tCIDLib::TCard4 c4Bpp> tCIDLib::TVoid
+        GrayRow(tCIDLib::TCard1* const pc1Row, const tCIDLib::TCard4 c4Pixels)
+        {
+            tCIDLib::TCard1* pc1Cur = pc1Row;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pixels; c4Index++)
+            {
+                const tCIDLib::TFloat4 f4Tmp = (pc1Cur[2] * 0.299F)
+                                               + (pc1Cur[1] * 0.587F)
+                                               + (pc1Cur[0] * 0.114F);
+                const tCIDLib::TCard1 c1Gray
+                (
+                    (f4Tmp > 255.0F) ? 255 : tCIDLib::TCard1(f4Tmp)
+                );
+                pc1Cur[0] = c1Gray;
+                pc1Cur[1] = c1Gray;
+                pc1Cur[2] = c1Gray;
+                pc1Cur += c4Bpp;
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The separable blur kernels. They work on components, either 8 or 16 bit,
+        //  and treat the row as a flat list of components, c4CCnt per pixel. The
+        //  accumulators are 32 bit, which is plenty for the largest kernel on 16
+        //  bit data. Instead of dividing we multiply by a 40 bit fixed point
+        //  reciprocal of the divisor, which is exact for any divisor up to 4K over
+        //  the full range of sums that can be seen.
+        // -----------------------------------------------------------------------
+        inline tCIDLib::TCard8 c8BlurRecip(const tCIDLib::TCard4 c4Divisor)
+        {
+            return ((tCIDLib::TCard8(1) << 40) + c4Divisor - 1) / c4Divisor;
+        }
+
+        template <typename TElem> tCIDLib::TVoid
+        StoreBlurAccum( const   tCIDLib::TCard4* const  pc4Accum
+                        ,       TElem* const            ptTar
+                        , const tCIDLib::TCard4         c4Count
+                        , const tCIDLib::TCard8         c8Recip)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+                ptTar[c4Index] = TElem((pc4Accum[c4Index] * c8Recip) >> 40);
+        }
+
+        //
+        //  Do the horizontal pass for one row. The source row is copied into a
+        //  padded buffer with zeros on either side, so that the taps that fall
+        //  off the ends contribute nothing (as the original per-pixel version
+        //  did) without any checks in the inner loop. It's done for every pixel
+        //  but the first and last, as the original did.
+        //
+        template <typename TElem> tCIDLib::TVoid
+        BlurRowH(const  TElem* const            ptSrc
+                ,       TElem* const            ptTar
+                , const tCIDLib::TCard4         c4Pixels
+                , const tCIDLib::TCard4         c4CCnt
+                , const tCIDLib::TInt4* const   pi4Factors
+                , const tCIDLib::TCard4         c4Taps
+                , const tCIDLib::TCard4         c4Half
+                , const tCIDLib::TCard8         c8Recip
+                ,       TElem* const            ptPad
+                ,       tCIDLib::TCard4* const  pc4Accum)
+        {
+            // Zero the pad areas and copy the source into the middle
+            const tCIDLib::TCard4 c4PadCnt = (c4Pixels + c4Taps) * c4CCnt;
+            const tCIDLib::TCard4 c4LeadCnt = c4Half * c4CCnt;
+            const tCIDLib::TCard4 c4SrcCnt = c4Pixels * c4CCnt;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LeadCnt; c4Index++)
+                ptPad[c4Index] = 0;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SrcCnt; c4Index++)
+                ptPad[c4LeadCnt + c4Index] = ptSrc[c4Index];
+            for (tCIDLib::TCard4 c4Index = c4LeadCnt + c4SrcCnt; c4Index < c4PadCnt; c4Index++)
+                ptPad[c4Index] = 0;
+
+            //
+            //  The output starts at the second pixel, whose first tap is at the
+            //  start of the padded buffer plus one pixel.
+            //
+            const tCIDLib::TCard4 c4OutCnt = (c4Pixels - 2) * c4CCnt;
+            const TElem* ptTap = ptPad + c4CCnt;
+            tCIDLib::TCard4 c4Factor = tCIDLib::TCard4(pi4Factors[0]);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OutCnt; c4Index++)
+                pc4Accum[c4Index] = ptTap[c4Index] * c4Factor;
+
+            for (tCIDLib::TCard4 c4TInd = 1; c4TInd < c4Taps; c4TInd++)
+            {
+                ptTap += c4CCnt;
+                c4Factor = tCIDLib::TCard4(pi4Factors[c4TInd]);
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OutCnt; c4Index++)
+                    pc4Accum[c4Index] += ptTap[c4Index] * c4Factor;
+            }
+            StoreBlurAccum(pc4Accum, ptTar + c4CCnt, c4OutCnt, c8Recip);
+        }
+
+        //
+        //  Do the vertical pass for one row. The caller gives us the source rows
+        //  for each tap, with null for those that fall off the top or bottom,
+        //  which are skipped as the original did. Again, the first and last
+        //  pixels are left alone.
+        //
+        template <typename TElem> tCIDLib::TVoid
+        BlurRowV(const  TElem* const* const     pptSrcRows
+                ,       TElem* const            ptTar
+                , const tCIDLib::TCard4         c4Pixels
+                , const tCIDLib::TCard4         c4CCnt
+                , const tCIDLib::TInt4* const   pi4Factors
+                , const tCIDLib::TCard4         c4Taps
+                , const tCIDLib::TCard8         c8Recip
+                ,       tCIDLib::TCard4* const  pc4Accum)
+        {
+            const tCIDLib::TCard4 c4OutCnt = (c4Pixels - 2) * c4CCnt;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OutCnt; c4Index++)
+                pc4Accum[c4Index] = 0;
+
+            for (tCIDLib::TCard4 c4TInd = 0; c4TInd < c4Taps; c4TInd++)
+            {
+                if (!pptSrcRows[c4TInd])
+                    continue;
+
+                const TElem* ptTap = pptSrcRows[c4TInd] + c4CCnt;
+                const tCIDLib::TCard4 c4Factor = tCIDLib::TCard4(pi4Factors[c4TInd]);
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OutCnt; c4Index++)
+                    pc4Accum[c4Index] += ptTap[c4Index] * c4Factor;
+            }
+            StoreBlurAccum(pc4Accum, ptTar + c4CCnt, c4OutCnt, c8Recip);
+        }
+
+
+        //
+        //  Do both blur passes over the indicated area of a pixel array. The
+        //  horizontal pass goes from the source to the temp, and the vertical
+        //  one from the temp back to the source. Each pass is done a row at a
+        //  time, so the vertical pass walks memory in order instead of down the
+        //  columns. The outer pixels are not changed, as the original per-pixel
+        //  version didn't change them.
+        //
+        template <typename TElem> tCIDLib::TVoid
+        BlurPasses(         TPixelArrayImpl&        pixaiSrc
+                    ,       TPixelArrayImpl&        pixaiTmp
+                    , const tCIDLib::TCard4         c4Width
+                    , const tCIDLib::TCard4         c4Height
+                    , const tCIDLib::TCard4         c4CCnt
+                    , const tCIDLib::TInt4* const   pi4Factors
+                    , const tCIDLib::TCard4         c4Taps
+                    , const tCIDLib::TCard4         c4Half
+                    , const tCIDLib::TCard4         c4Divisor)
+        {
+            const tCIDLib::TCard8 c8Recip = c8BlurRecip(c4Divisor);
+
+            DoRowBands
+            (
+                1
+                , c4Height - 1
+                , c4Width
+                , [&](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
+                {
+                    TElem* ptPad = new TElem[(c4Width + c4Taps) * c4CCnt];
+                    TArrayJanitor<TElem> janPad(ptPad);
+                    tCIDLib::TCard4* pc4Accum = new tCIDLib::TCard4[c4Width * c4CCnt];
+                    TArrayJanitor<tCIDLib::TCard4> janAccum(pc4Accum);
+
+                    for (tCIDLib::TCard4 c4Row = c4FirstRow; c4Row < c4EndRow; c4Row++)
+                    {
+                        BlurRowH<TElem>
+                        (
+                            reinterpret_cast<const TElem*>(pixaiSrc.pc1RowPtr(c4Row))
+                            , reinterpret_cast<TElem*>(pixaiTmp.pc1RowPtr(c4Row))
+                            , c4Width
+                            , c4CCnt
+                            , pi4Factors
+                            , c4Taps
+                            , c4Half
+                            , c8Recip
+                            , ptPad
+                            , pc4Accum
+                        );
+                    }
+                }
+            );
+
+            DoRowBands
+            (
+                1
+                , c4Height - 1
+                , c4Width
+                , [&](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
+                {
+                    tCIDLib::TCard4* pc4Accum = new tCIDLib::TCard4[c4Width * c4CCnt];
+                    TArrayJanitor<tCIDLib::TCard4> janAccum(pc4Accum);
+
+                    const TElem* aptRows[16];
+                    for (tCIDLib::TCard4 c4Row = c4FirstRow; c4Row < c4EndRow; c4Row++)
+                    {
+                        // Get the rows for each tap, null if off the top or bottom
+                        for (tCIDLib::TCard4 c4TInd = 0; c4TInd < c4Taps; c4TInd++)
+                        {
+                            const tCIDLib::TInt4 i4TapRow
+                            (
+                                tCIDLib::TInt4(c4Row + c4TInd) - tCIDLib::TInt4(c4Half)
+                            );
+                            if ((i4TapRow < 0) || (i4TapRow >= tCIDLib::TInt4(c4Height)))
+                            {
+                                aptRows[c4TInd] = nullptr;
+                            }
+                             else
+                            {
+                                aptRows[c4TInd] = reinterpret_cast<const TElem*>
+                                (
+                                    pixaiTmp.pc1RowPtr(tCIDLib::TCard4(i4TapRow))
+                                );
+                            }
+                        }
+
+                        BlurRowV<TElem>
+                        (
+                            aptRows
+                            , reinterpret_cast<TElem*>(pixaiSrc.pc1RowPtr(c4Row))
+                            , c4Width
+                            , c4CCnt
+                            , pi4Factors
+                            , c4Taps
+                            , c8Recip
+                            , pc4Accum
+                        );
+                    }
+                }
+            );
+        }
     }
 }
 
@@ -755,15 +1318,6 @@ TPixelArrayImpl::BSplineScaleTo(        TPixelArrayImpl&    pixaiTar
     tCIDLib::TFloat8* pf8Col = new tCIDLib::TFloat8[m_c4Height];
     TArrayJanitor<tCIDLib::TFloat8> janCol(pf8Col);
 
-    //
-    //  And we'll need a buffer to load interpolated rows back into so
-    //  that we can load them back into the pixel array. This one has to
-    //  be one row in size (of the TARGET array) and TCard2, since the
-    //  largest single component we can have is 16 bit gray scale/alpha.
-    //
-    tCIDLib::TCard2* pc2Buf = new tCIDLib::TCard2[szTar.c4Width()];
-    TArrayJanitor<tCIDLib::TCard2> janLoad(pc2Buf);
-
     //
     //  If it's gray scale, do the gray scale component, else do the three
     //  color components separately.
@@ -771,25 +1325,25 @@ TPixelArrayImpl::BSplineScaleTo(        TPixelArrayImpl&    pixaiTar
     if (tCIDLib::bAllBitsOn(m_eFmt, tCIDImage::EPixFmts::Color))
     {
         LoadCoefs(tCIDLib::EClrComps::Red, pf4Cof, pf8Row, pf8Col, c4Degree, palToUse);
-        InterpComp(tCIDLib::EClrComps::Red, pf4Cof, pc2Buf, pixaiTar, c4Degree, c2Max);
+        InterpComp(tCIDLib::EClrComps::Red, pf4Cof, pixaiTar, c4Degree, c2Max);
 
         LoadCoefs(tCIDLib::EClrComps::Green, pf4Cof, pf8Row, pf8Col, c4Degree, palToUse);
-        InterpComp(tCIDLib::EClrComps::Green, pf4Cof, pc2Buf, pixaiTar, c4Degree, c2Max);
+        InterpComp(tCIDLib::EClrComps::Green, pf4Cof, pixaiTar, c4Degree, c2Max);
 
         LoadCoefs(tCIDLib::EClrComps::Blue, pf4Cof, pf8Row, pf8Col, c4Degree, palToUse);
-        InterpComp(tCIDLib::EClrComps::Blue, pf4Cof, pc2Buf, pixaiTar, c4Degree, c2Max);
+        InterpComp(tCIDLib::EClrComps::Blue, pf4Cof, pixaiTar, c4Degree, c2Max);
     }
      else
     {
         LoadCoefs(tCIDLib::EClrComps::Gray, pf4Cof, pf8Row, pf8Col, c4Degree, palToUse);
-        InterpComp(tCIDLib::EClrComps::Gray, pf4Cof, pc2Buf, pixaiTar, c4Degree, c2Max);
+        InterpComp(tCIDLib::EClrComps::Gray, pf4Cof, pixaiTar, c4Degree, c2Max);
     }
 
     // If alpha is available do it too
     if (tCIDLib::bAllBitsOn(m_eFmt, tCIDImage::EPixFmts::Alpha))
     {
         LoadCoefs(tCIDLib::EClrComps::Alpha, pf4Cof, pf8Row, pf8Col, c4Degree, palToUse);
-        InterpComp(tCIDLib::EClrComps::Alpha, pf4Cof, pc2Buf, pixaiTar, c4Degree, c2Max);
+        InterpComp(tCIDLib::EClrComps::Alpha, pf4Cof, pixaiTar, c4Degree, c2Max);
     }
 }
 
@@ -991,6 +1545,35 @@ tCIDLib::TCard4 TPixelArrayImpl::c4Unused(const TClrPalette& palToUse) const
 //
 tCIDLib::TVoid TPixelArrayImpl::CvtToGrayScale(TClrPalette& palToUse)
 {
+    //
+    //  The 8 bit true color formats are by far the most common, so we do them
+    //  a row at a time directly on the pixel data.
+    //
+    if ((m_eBitDepth == tCIDImage::EBitDepths::Eight)
+    &&  ((m_eFmt == tCIDImage::EPixFmts::TrueClr)
+    ||   (m_eFmt == tCIDImage::EPixFmts::TrueAlpha)))
+    {
+        const tCIDLib::TBoolean bAlpha = (m_eFmt == tCIDImage::EPixFmts::TrueAlpha);
+        CIDImage_PixelArrayImpl::DoRowBands
+        (
+            0
+            , m_c4Height
+            , m_c4Width
+            , [this, bAlpha](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
+            {
+                for (tCIDLib::TCard4 c4Row = c4FirstRow; c4Row < c4EndRow; c4Row++)
+                {
+                    tCIDLib::TCard1* pc1Row = m_pc1Pixels + (c4Row * m_c4LineWidth);
+                    if (bAlpha)
+                        CIDImage_PixelArrayImpl::GrayRow<4>(pc1Row, m_c4Width);
+                    else
+                        CIDImage_PixelArrayImpl::GrayRow<3>(pc1Row, m_c4Width);
+                }
+            }
+        );
+        return;
+    }
+
     //
     //  It's a color component based format, so we have to go through the
     //  color data and convert them all to equiv gray scale.
@@ -1379,21 +1962,6 @@ TPixelArrayImpl::GaussianBlur(  const   tCIDLib::TCard4         c4Order
     const tCIDLib::TInt4 i4HLim = tCIDLib::TInt4(c4MaxWidth - 1);
     const tCIDLib::TInt4 i4VLim = tCIDLib::TInt4(c4MaxHeight - 1);
 
-    //
-    //  For the two passes, the ingoing data is not changed as we go, so we
-    //  we can pre-multiply the values in each row/col by the current factor
-    /// and avoid many multiplications since they are done very redundantly.
-    //  So allocate an array big enough to hold a pre-multiplied value for
-    //  each pixel in the biggest axis of ours.
-    //
-    //  This can save millions of multiplies in a large, 32 bit image and
-    //  vastly speed up the operation.
-    //
-    const tCIDLib::TCard4 c4MaxAxis = tCIDLib::MaxVal(c4MaxWidth, c4MaxHeight);
-    tCIDLib::TInt4* pi4TableBuf = new tCIDLib::TInt4[i4GWidth * c4MaxAxis];
-    TArrayJanitor<tCIDLib::TInt4> janTableBuf(pi4TableBuf);
-    tCIDLib::TInt4* api4TableSlots[c4MaxOrder];
-
     if (m_eBitDepth == tCIDImage::EBitDepths::Five)
     {
         //
@@ -1410,7 +1978,7 @@ TPixelArrayImpl::GaussianBlur(  const   tCIDLib::TCard4         c4Order
         {
             for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
             {
-                i4C1 = 0; i4C2 = 0; i4C2 = 0;
+                i4C1 = 0; i4C2 = 0; i4C3 = 0;
                 for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
                 {
                     c4Clr = c4GetBoundaryPixel(i4HInd - i4GWidth2 + i4KInd, i4VInd, CID_LINE);
@@ -1435,7 +2003,7 @@ TPixelArrayImpl::GaussianBlur(  const   tCIDLib::TCard4         c4Order
         {
             for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
             {
-                i4C1 = 0; i4C2 = 0; i4C2 = 0;
+                i4C1 = 0; i4C2 = 0; i4C3 = 0;
                 for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
                 {
                     c4Clr = ppixaiOut->c4GetBoundaryPixel(i4HInd, i4VInd - i4GWidth2 + i4KInd, CID_LINE);
@@ -1456,14 +2024,16 @@ TPixelArrayImpl::GaussianBlur(  const   tCIDLib::TCard4         c4Order
             }
         }
     }
-     else if (m_eBitDepth == tCIDImage::EBitDepths::Eight)
+     else if ((m_eBitDepth == tCIDImage::EBitDepths::Eight)
+          ||  (m_eBitDepth == tCIDImage::EBitDepths::Sixteen))
     {
         //
-        //  These are all byte or oriented, so we can do a generic algorithm
-        //  that will handle them all. We just need to set up some counters
-        //  that represent the number of bytes per pixel.
+        //  These are all byte or word oriented, so we can do a generic algorithm
+        //  that will handle them all, treating each row as a flat list of
+        //  components. We just need to know the components per pixel. Palette
+        //  based images can't be blurred since the values are indices.
         //
-        tCIDLib::TCard4 c4CCnt;
+        tCIDLib::TCard4 c4CCnt = 0;
         switch(m_eFmt)
         {
             case tCIDImage::EPixFmts::TrueClr :
@@ -1481,201 +2051,43 @@ TPixelArrayImpl::GaussianBlur(  const   tCIDLib::TCard4         c4Order
             case tCIDImage::EPixFmts::GrayAlpha :
                 c4CCnt = 2;
                 break;
-        };
-        tCIDLib::TInt4 i4Accum;
-
-        // Divide the pre-mul table up for horizontal use
-        for (tCIDLib::TInt4 i4Index = 0; i4Index < i4GWidth; i4Index++)
-            api4TableSlots[i4Index] = pi4TableBuf + (i4Index * c4MaxWidth);
-
-        for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
-        {
-            tCIDLib::TCard1* pc1BaseTPtr = ppixaiOut->pc1RowPtr(i4VInd) + c4CCnt;
-            tCIDLib::TCard1* pc1BaseRow = pc1RowPtr(i4VInd);
-            for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
-            {
-                tCIDLib::TCard1* pc1CompPtr = pc1BaseRow + c4CInd;
-                tCIDLib::TCard1* pc1TPtr = pc1BaseTPtr + c4CInd;
-                for (tCIDLib::TInt4 i4FInd = 0; i4FInd < i4GWidth; i4FInd++)
-                {
-                    tCIDLib::TInt4* pi4FRow = api4TableSlots[i4FInd];
-
-                    const tCIDLib::TInt4 i4Factor = pi4GFactors[i4FInd];
-                    tCIDLib::TCard1* pc1MPtr = pc1CompPtr;
-                    for (tCIDLib::TCard4 c4RInd = 0; c4RInd < c4MaxWidth; c4RInd++)
-                    {
-                        *pi4FRow++ = tCIDLib::TInt4(*pc1MPtr) * i4Factor;
-                        pc1MPtr += c4CCnt;
-                    }
-                }
-
-                for (tCIDLib::TInt4 i4HInd = 1; i4HInd < i4HLim; i4HInd++)
-                {
-                    tCIDLib::TInt4 i4HOfs = i4HInd - i4GWidth2;
-                    i4Accum = 0;
-                    for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
-                    {
-                        if ((i4HOfs >= 0) && (i4HOfs <= i4HLim))
-                            i4Accum += api4TableSlots[i4KInd][i4HOfs];
-                        i4HOfs++;
-                    }
-                    i4Accum /= i4Divisor;
-                    *pc1TPtr = tCIDLib::TCard1(i4Accum);
-                    pc1TPtr += c4CCnt;
-                }
-            }
-        }
-
-        // Divide the pre-mul table up for vertical use
-        for (tCIDLib::TInt4 i4Index = 0; i4Index < i4GWidth; i4Index++)
-            api4TableSlots[i4Index] = pi4TableBuf + (i4Index * c4MaxHeight);
-
-        for (tCIDLib::TInt4 i4HInd = 1; i4HInd < i4HLim; i4HInd++)
-        {
-            // The current horizontal offset (the component column)
-            tCIDLib::TCard4 c4HOfs = (i4HInd * c4CCnt);
-            for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
-            {
-                // Get a pointer to the current source byte column
-                tCIDLib::TCard1* pc1CompPtr = ppixaiOut->m_pc1Pixels
-                                              + c4HOfs + c4CInd;
-                for (tCIDLib::TInt4 i4FInd = 0; i4FInd < i4GWidth; i4FInd++)
-                {
-                    tCIDLib::TCard1* pc1MPtr = pc1CompPtr;
-                    tCIDLib::TInt4* pi4FRow = api4TableSlots[i4FInd];
-                    const tCIDLib::TInt4 i4Factor = pi4GFactors[i4FInd];
-                    for (tCIDLib::TCard4 c4VInd = 0; c4VInd < c4MaxHeight; c4VInd++)
-                    {
-                        *pi4FRow++ = tCIDLib::TInt4(*pc1MPtr) * i4Factor;
-                        pc1MPtr += ppixaiOut->m_c4LineWidth;
-                    }
-                }
 
-                tCIDLib::TCard1* pc1TPtr = m_pc1Pixels + c4HOfs + c4CInd;
-                for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
-                {
-                    tCIDLib::TInt4 i4VOfs = i4VInd - i4GWidth2;
-                    i4Accum = 0;
-                    for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
-                    {
-                        if ((i4VOfs >= 0) && (i4VOfs <= i4VLim))
-                            i4Accum += api4TableSlots[i4KInd][i4VOfs];
-                        i4VOfs++;
-                    }
-                    i4Accum /= i4Divisor;
-                    *pc1TPtr = tCIDLib::TCard1(i4Accum);
-                    pc1TPtr += m_c4LineWidth;
-                }
-            }
-        }
-    }
-     else if (m_eBitDepth == tCIDImage::EBitDepths::Sixteen)
-    {
-        // These are word oriented, so we can do a single generic one for these
-        tCIDLib::TCard4 c4CCnt;
-        if (m_eFmt == tCIDImage::EPixFmts::GrayScale)
-            c4CCnt = 1;
-        else if (m_eFmt == tCIDImage::EPixFmts::GrayAlpha)
-            c4CCnt = 2;
-        tCIDLib::TInt4 i4Accum;
+            default :
+                break;
+        };
 
-        // Divide the pre-mul table up for horizontal use
-        for (tCIDLib::TInt4 i4Index = 0; i4Index < i4GWidth; i4Index++)
-            api4TableSlots[i4Index] = pi4TableBuf + (i4Index * c4MaxWidth);
+        if (!c4CCnt || (i4HLim < 2) || (i4VLim < 2))
+            return;
 
-        for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
+        if (m_eBitDepth == tCIDImage::EBitDepths::Eight)
         {
-            tCIDLib::TCard2* pc2BaseTPtr = reinterpret_cast<tCIDLib::TCard2*>
+            CIDImage_PixelArrayImpl::BlurPasses<tCIDLib::TCard1>
             (
-                ppixaiOut->pc1RowPtr(i4VInd) + c4CCnt
+                *this
+                , *ppixaiOut
+                , c4MaxWidth
+                , c4MaxHeight
+                , c4CCnt
+                , pi4GFactors
+                , tCIDLib::TCard4(i4GWidth)
+                , tCIDLib::TCard4(i4GWidth2)
+                , tCIDLib::TCard4(i4Divisor)
             );
-            tCIDLib::TCard2* pc2BaseRow = reinterpret_cast<tCIDLib::TCard2*>
-            (
-                pc1RowPtr(i4VInd)
-            );
-            for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
-            {
-                tCIDLib::TCard2* pc2CompPtr = pc2BaseRow + c4CInd;
-                tCIDLib::TCard2* pc2TPtr = pc2BaseTPtr + c4CInd;
-                for (tCIDLib::TInt4 i4FInd = 0; i4FInd < i4GWidth; i4FInd++)
-                {
-                    tCIDLib::TInt4* pi4FRow = api4TableSlots[i4FInd];
-
-                    const tCIDLib::TInt4 i4Factor = pi4GFactors[i4FInd];
-                    tCIDLib::TCard2* pc2MPtr = pc2CompPtr;
-                    for (tCIDLib::TCard4 c4RInd = 0; c4RInd < c4MaxWidth; c4RInd++)
-                    {
-                        *pi4FRow++ = tCIDLib::TInt4(*pc2MPtr) * i4Factor;
-                        pc2MPtr += c4CCnt;
-                    }
-                }
-
-                for (tCIDLib::TInt4 i4HInd = 1; i4HInd < i4HLim; i4HInd++)
-                {
-                    tCIDLib::TInt4 i4HOfs = i4HInd - i4GWidth2;
-                    i4Accum = 0;
-                    for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
-                    {
-                        if ((i4HOfs >= 0) && (i4HOfs <= i4HLim))
-                            i4Accum += api4TableSlots[i4KInd][i4HOfs];
-                        i4HOfs++;
-                    }
-                    i4Accum /= i4Divisor;
-                    *pc2TPtr = tCIDLib::TCard2(i4Accum);
-                    pc2TPtr += c4CCnt;
-                }
-            }
         }
-
-        // Divide the pre-mul table up for vertical use
-        for (tCIDLib::TInt4 i4Index = 0; i4Index < i4GWidth; i4Index++)
-            api4TableSlots[i4Index] = pi4TableBuf + (i4Index * c4MaxHeight);
-
-        for (tCIDLib::TInt4 i4HInd = 1; i4HInd < i4HLim; i4HInd++)
+         else
         {
-            // The current horizontal offset (the component column)
-            tCIDLib::TCard4 c4HOfs = (i4HInd * c4CCnt);
-            for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
-            {
-                // Get a pointer to the current source byte column
-                tCIDLib::TCard2* pc2CompPtr = reinterpret_cast<tCIDLib::TCard2*>
-                (
-                    ppixaiOut->m_pc1Pixels + c4HOfs + c4CInd
-                );
-
-                // Create the pre-mul table
-                for (tCIDLib::TInt4 i4FInd = 0; i4FInd < i4GWidth; i4FInd++)
-                {
-                    tCIDLib::TCard2* pc2MPtr = pc2CompPtr;
-                    tCIDLib::TInt4* pi4FRow = api4TableSlots[i4FInd];
-                    const tCIDLib::TInt4 i4Factor = pi4GFactors[i4FInd];
-                    for (tCIDLib::TCard4 c4VInd = 0; c4VInd < c4MaxHeight; c4VInd++)
-                    {
-                        *pi4FRow++ = tCIDLib::TInt4(*pc2MPtr) * i4Factor;
-                        pc2MPtr += ppixaiOut->m_c4LineWidth;
-                    }
-                }
-
-                // Set the target byte column pointer for output
-                tCIDLib::TCard2* pc2TPtr = reinterpret_cast<tCIDLib::TCard2*>
-                (
-                    m_pc1Pixels + m_c4LineWidth + c4HOfs + c4CInd
-                );
-                for (tCIDLib::TInt4 i4VInd = 1; i4VInd < i4VLim; i4VInd++)
-                {
-                    tCIDLib::TInt4 i4VOfs = i4VInd - i4GWidth2;
-                    i4Accum = 0;
-                    for (tCIDLib::TInt4 i4KInd = 0; i4KInd < i4GWidth; i4KInd++)
-                    {
-                        if ((i4VOfs >= 0) && (i4VOfs <= i4VLim))
-                            i4Accum += api4TableSlots[i4KInd][i4VOfs];
-                        i4VOfs++;
-                    }
-                    i4Accum /= i4Divisor;
-                    *pc2TPtr = tCIDLib::TCard2(i4Accum);
-                    pc2TPtr += m_c4LineWidth;
-                }
-            }
+            CIDImage_PixelArrayImpl::BlurPasses<tCIDLib::TCard2>
+            (
+                *this
+                , *ppixaiOut
+                , c4MaxWidth
+                , c4MaxHeight
+                , c4CCnt
+                , pi4GFactors
+                , tCIDLib::TCard4(i4GWidth)
+                , tCIDLib::TCard4(i4GWidth2)
+                , tCIDLib::TCard4(i4Divisor)
+            );
         }
     }
 }
@@ -2053,54 +2465,22 @@ tCIDLib::TCard1* TPixelArrayImpl::pc1RowPtr(const tCIDLib::TCard4 c4Row)
 //
 tCIDLib::TVoid TPixelArrayImpl::Premultiply()
 {
-    tCIDLib::TCard1* pc1Dest = m_pc1Pixels;
-    for (tCIDLib::TCard4 c4RowInd = 0; c4RowInd < m_c4Height; c4RowInd++)
-    {
-        tCIDLib::TCard1* pc1Cur = pc1Dest;
-        for (tCIDLib::TCard4 c4ColInd = 0; c4ColInd < m_c4Width; c4ColInd++)
+    CIDImage_PixelArrayImpl::DoRowBands
+    (
+        0
+        , m_c4Height
+        , m_c4Width
+        , [this](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
         {
-            // Get the alpha out first
-            const tCIDLib::TCard1 c1Alpha = *(pc1Cur + 3);
-
-            //
-            //  If it's zero just zero the pixel. If it's 0xFF, do nothing since
-            //  it won't have any effect. Else do the pre-mul.
-            //
-            if (c1Alpha == 0)
+            for (tCIDLib::TCard4 c4RowInd = c4FirstRow; c4RowInd < c4EndRow; c4RowInd++)
             {
-                *pc1Cur++ = 0;
-                *pc1Cur++ = 0;
-                *pc1Cur++ = 0;
-                pc1Cur++;
-            }
-             else if (c1Alpha == 0xFF)
-            {
-                pc1Cur += 4;
-            }
-             else
-            {
-                tCIDLib::TCard2 c2Val = *pc1Cur;
-                c2Val *= c1Alpha;
-                c2Val /= 0xFF;
-                *pc1Cur++ = tCIDLib::TCard1(c2Val);
-
-                c2Val = *pc1Cur;
-                c2Val *= c1Alpha;
-                c2Val /= 0xFF;
-                *pc1Cur++ = tCIDLib::TCard1(c2Val);
-
-                c2Val = *pc1Cur;
-                c2Val *= c1Alpha;
-                c2Val /= 0xFF;
-                *pc1Cur++ = tCIDLib::TCard1(c2Val);
-
-                pc1Cur++;
+                CIDImage_PixelArrayImpl::PremulRow4
+                (
+                    m_pc1Pixels + (c4RowInd * m_c4LineWidth), m_c4Width
+                );
             }
         }
-
-        // Move our base pointer up a line
-        pc1Dest += m_c4LineWidth;
-    }
+    );
 }
 
 
@@ -2309,32 +2689,21 @@ TPixelArrayImpl::ScaleAlpha(        tCIDLib::EDirs      eDir
                             , const tCIDLib::TCard4     c4EndInd
                             , const tCIDLib::TBoolean   bPremultiply)
 {
-    // Copy to some locals since we mway want to flip them based on direction
-    tCIDLib::TCard4 c4Low = c4StartInd;
-    tCIDLib::TCard4 c4High = c4EndInd;
-
     //
     //  We use a sinusoidal function to get a smooth ramp, going more slowly
     //  at first and then more rapidly. We go from 0 to 90 degrees, i.e. one
     //  quadrant of the sine wave, or 0 to 1.57 radians.
     //
     //  For down and right, we go from the low to high line/col. For up and
-    //  left we go from high to low, so we set offset values that we'll use
-    //  to adjust the index and buffer pointer.
-    //
-    tCIDLib::TBoolean   bHorz = kCIDLib::True;
-    tCIDLib::TFloat4    f4CurRad = 0;
-    tCIDLib::TFloat4    f4IncPer = 1.57F / (c4High - c4Low);
-    tCIDLib::TInt4      i4IndOfs = 1;
-    tCIDLib::TInt4      i4BufOfs = m_c4LineWidth;
+    //  left we go from the high line/col back down, not including the low one.
+    //
+    tCIDLib::TBoolean bHorz = kCIDLib::True;
+    tCIDLib::TBoolean bReverse = kCIDLib::False;
     switch(eDir)
     {
         case tCIDLib::EDirs::Up :
             bHorz = kCIDLib::False;
-            c4Low = c4EndInd;
-            c4High = c4StartInd;
-            i4IndOfs = -1;
-            i4BufOfs *= -1;
+            bReverse = kCIDLib::True;
             break;
 
         case tCIDLib::EDirs::Down :
@@ -2342,144 +2711,61 @@ TPixelArrayImpl::ScaleAlpha(        tCIDLib::EDirs      eDir
             break;
 
         case tCIDLib::EDirs::Left :
-            c4Low = c4EndInd;
-            c4High = c4StartInd;
-            i4IndOfs = -1;
-            i4BufOfs *= -1;
+            bReverse = kCIDLib::True;
             break;
 
         case tCIDLib::EDirs::Right :
             break;
     };
 
-    if (bHorz)
+    //
+    //  Build up the ramp levels, in the order we move through the lines/cols.
+    //  Then, if reversed, flip them so that they are in line/col order, which is
+    //  what the row kernels want.
+    //
+    const tCIDLib::TCard4 c4Count = c4EndInd - c4StartInd;
+    tCIDLib::TFloat8* pf8Levels = new tCIDLib::TFloat8[c4Count];
+    TArrayJanitor<tCIDLib::TFloat8> janLevels(pf8Levels);
     {
-        #pragma message(CodeReminder "Implement horz alpha scaling")
+        const tCIDLib::TFloat4 f4IncPer = 1.57F / c4Count;
+        tCIDLib::TFloat4 f4CurRad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            const tCIDLib::TCard4 c4LevelInd = bReverse ? (c4Count - 1) - c4Index : c4Index;
+            pf8Levels[c4LevelInd] = 1.0 - TMathLib::f4Sine(f4CurRad);
+            f4CurRad += f4IncPer;
+        }
     }
-     else
+    const tCIDLib::TCard4 c4First = bReverse ? c4StartInd + 1 : c4StartInd;
+
+    //
+    //  There are really only 3 scenarios, 8 bit gray/alpha, 16 bit gray/alpha,
+    //  and true alpha. So we do each one separately.
+    //
+    if (m_eBitDepth == tCIDImage::EBitDepths::Eight)
     {
-        //
-        //  We can optimize here since there are really only 3 scenarios, 8
-        //  bit gray/alpha, 16 bit gray/alpha, and true alpha. So we do each
-        //  one separately.
-        //
-        //  The algorith is:
-        //
-        //      get a pointer to the starting row
-        //      for each line
-        //          set the scaling factor
-        //          get a pointer to the line buffer
-        //          for each pixel
-        //              scale each color component
-        //         adjust row and index
-        //      endfor
-        //
-        //  We optimize the highest value version, the 32 bit one, with an
-        //  assembly language version.
-        //
-        if (tCIDLib::c4EnumOrd(m_eBitDepth) == 8)
+        if (m_eFmt == tCIDImage::EPixFmts::TrueAlpha)
         {
-            if (m_eFmt == tCIDImage::EPixFmts::TrueAlpha)
-            {
-                tCIDLib::TCard1* pc1Row = m_pc1Pixels + (c4Low * m_c4LineWidth);
-                while (c4Low != c4High)
-                {
-                    const tCIDLib::TCard1 c1Alpha = tCIDLib::TCard1
-                    (
-                        (1.0 - TMathLib::f4Sine(f4CurRad)) * 0xFF
-                    );
-                    f4CurRad += f4IncPer;
-
-                    tCIDLib::TCard1* pc1Cur = pc1Row;
-                    for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
-                    {
-                        if (bPremultiply)
-                        {
-                            tCIDLib::TCard2 c2Val = *pc1Cur;
-                            c2Val *= c1Alpha;
-                            c2Val /= 0xFF;
-                            *pc1Cur++ = tCIDLib::TCard1(c2Val);
-
-                            c2Val = *pc1Cur;
-                            c2Val *= c1Alpha;
-                            c2Val /= 0xFF;
-                            *pc1Cur++ = tCIDLib::TCard1(c2Val);
-
-                            c2Val = *pc1Cur;
-                            c2Val *= c1Alpha;
-                            c2Val /= 0xFF;
-                            *pc1Cur++ = tCIDLib::TCard1(c2Val);
-                        }
-                         else
-                        {
-                            pc1Cur += 3;
-                        }
-
-                        *pc1Cur++ = c1Alpha;
-                    }
-                    pc1Row += i4BufOfs;
-                    c4Low += i4IndOfs;
-                }
-            }
-             else if (m_eFmt == tCIDImage::EPixFmts::GrayAlpha)
-            {
-                tCIDLib::TCard1* pc1Row = m_pc1Pixels + (c4Low * m_c4LineWidth);
-                while (c4Low != c4High)
-                {
-                    const tCIDLib::TCard1 c1Alpha = tCIDLib::TCard1
-                    (
-                        (1.0 - TMathLib::f4Sine(f4CurRad)) * 0xFF
-                    );
-                    f4CurRad += f4IncPer;
-                    tCIDLib::TCard1* pc1Pix = pc1Row;
-                    for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
-                    {
-                        if (bPremultiply)
-                        {
-                            tCIDLib::TCard2 c2Val = *pc1Pix;
-                            c2Val *= c1Alpha;
-                            c2Val /= 0xFF;
-                            *pc1Pix = tCIDLib::TCard1(c2Val);
-                        }
-                        pc1Pix++;
-                        *pc1Pix++ = c1Alpha;
-                    }
-                    pc1Row += i4BufOfs;
-                    c4Low += i4IndOfs;
-                }
-            }
+            CIDImage_PixelArrayImpl::ApplyAlphaRamp<tCIDLib::TCard1, 4>
+            (
+                *this, bHorz, c4First, c4Count, pf8Levels, 0xFF, bPremultiply
+            );
         }
-         else
+         else if (m_eFmt == tCIDImage::EPixFmts::GrayAlpha)
         {
-            tCIDLib::TCard2* pc2Row = reinterpret_cast<tCIDLib::TCard2*>
+            CIDImage_PixelArrayImpl::ApplyAlphaRamp<tCIDLib::TCard1, 2>
             (
-                m_pc1Pixels + (c4Low * m_c4LineWidth)
+                *this, bHorz, c4First, c4Count, pf8Levels, 0xFF, bPremultiply
             );
-            while (c4Low != c4High)
-            {
-                const tCIDLib::TCard2 c2Alpha = tCIDLib::TCard2
-                (
-                    (1.0 - TMathLib::f4Sine(f4CurRad)) * 0xFFFF
-                );
-                f4CurRad += f4IncPer;
-                tCIDLib::TCard2* pc2Pix = pc2Row;
-                for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
-                {
-                    if (bPremultiply)
-                    {
-                        tCIDLib::TCard4 c4Tmp = *pc2Pix;
-                        c4Tmp *= c2Alpha;
-                        c4Tmp /= 0xFFFF;
-                        *pc2Pix = tCIDLib::TCard2(c4Tmp);
-                    }
-                    pc2Pix++;
-                    *pc2Pix++ = c2Alpha;
-                }
-                pc2Row = tCIDLib::pOffsetNCPtr(pc2Row, i4BufOfs);
-                c4Low += i4IndOfs;
-            }
         }
     }
+     else if (m_eBitDepth == tCIDImage::EBitDepths::Sixteen)
+    {
+        CIDImage_PixelArrayImpl::ApplyAlphaRamp<tCIDLib::TCard2, 2>
+        (
+            *this, bHorz, c4First, c4Count, pf8Levels, 0xFFFF, bPremultiply
+        );
+    }
 }
 
 
@@ -2499,47 +2785,54 @@ tCIDLib::TVoid TPixelArrayImpl::SetAll(const tCIDLib::TCard4 c4ToSet)
 //
 tCIDLib::TVoid TPixelArrayImpl::SetAllAlpha(const tCIDLib::TCard4 c4Alpha)
 {
-    for (tCIDLib::TCard4 c4VInd = 0; c4VInd < m_c4Height; c4VInd++)
-    {
-        tCIDLib::TCard1* pc1Row = m_pc1Pixels + (c4VInd * m_c4LineWidth);
-        if (tCIDLib::bAllBitsOn(m_eFmt, tCIDImage::EPixFmts::Color))
-        {
-            //
-            //  It has to be true alpha, so move up 3 bytes and then do every
-            //  4th byte.
-            //
-            tCIDLib::TCard1 c1Alpha = tCIDLib::TCard1(c4Alpha);
-            pc1Row += 3;
-            for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
-            {
-                *pc1Row = c1Alpha;
-                pc1Row += 4;
-            }
-        }
-         else if (m_eBitDepth == tCIDImage::EBitDepths::Eight)
-        {
-            // Has to be 8 bit gray/alpha, so do every other byte
-            tCIDLib::TCard1 c1Alpha = tCIDLib::TCard1(c4Alpha);
-            pc1Row++;
-            for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
-            {
-                *pc1Row = c1Alpha;
-                pc1Row += 2;
-            }
-        }
-         else
+    //
+    //  If color it has to be true alpha, so we do every 4th byte. Else, if 8 bit
+    //  it has to be gray/alpha so we do every other byte. Else it has to be 16
+    //  bit gray/alpha, so every other word.
+    //
+    const tCIDLib::TBoolean bColor = tCIDLib::bAllBitsOn
+    (
+        m_eFmt, tCIDImage::EPixFmts::Color
+    );
+    const tCIDLib::TBoolean b8Bit = (m_eBitDepth == tCIDImage::EBitDepths::Eight);
+    CIDImage_PixelArrayImpl::DoRowBands
+    (
+        0
+        , m_c4Height
+        , m_c4Width
+        , [this, c4Alpha, bColor, b8Bit](const  tCIDLib::TCard4 c4FirstRow
+                                        , const tCIDLib::TCard4 c4EndRow)
         {
-            // Has to be 16 bit gray/alpha
-            tCIDLib::TCard2* pc2Row = reinterpret_cast<tCIDLib::TCard2*>(pc1Row);
-            tCIDLib::TCard2 c2Alpha = tCIDLib::TCard2(c4Alpha);
-            pc2Row++;
-            for (tCIDLib::TCard4 c4HInd = 0; c4HInd < m_c4Width; c4HInd++)
+            for (tCIDLib::TCard4 c4VInd = c4FirstRow; c4VInd < c4EndRow; c4VInd++)
             {
-                *pc2Row = c2Alpha;
-                pc2Row += 2;
+                tCIDLib::TCard1* pc1Row = m_pc1Pixels + (c4VInd * m_c4LineWidth);
+                if (bColor)
+                {
+                    CIDImage_PixelArrayImpl::SetAlphaRow<tCIDLib::TCard1, 4>
+                    (
+                        pc1Row, m_c4Width, tCIDLib::TCard1(c4Alpha), kCIDLib::False
+                    );
+                }
+                 else if (b8Bit)
+                {
+                    CIDImage_PixelArrayImpl::SetAlphaRow<tCIDLib::TCard1, 2>
+                    (
+                        pc1Row, m_c4Width, tCIDLib::TCard1(c4Alpha), kCIDLib::False
+                    );
+                }
+                 else
+                {
+                    CIDImage_PixelArrayImpl::SetAlphaRow<tCIDLib::TCard2, 2>
+                    (
+                        reinterpret_cast<tCIDLib::TCard2*>(pc1Row)
+                        , m_c4Width
+                        , tCIDLib::TCard2(c4Alpha)
+                        , kCIDLib::False
+                    );
+                }
             }
         }
-    }
+    );
 }
 
 
@@ -2836,6 +3129,47 @@ TPixelArrayImpl::StoreCompRow(          tCIDLib::TCard2* const  pc2ToStore
                                 , const tCIDLib::TCard4         c4Row
                                 , const tCIDLib::EClrComps      eComp)
 {
+    //
+    //  As with LoadCompRow, special case the 8 bit true color formats and just
+    //  store the component directly into each pixel of the row.
+    //
+    if ((m_eBitDepth == tCIDImage::EBitDepths::Eight)
+    &&  ((m_eFmt == tCIDImage::EPixFmts::TrueClr)
+    ||   (m_eFmt == tCIDImage::EPixFmts::TrueAlpha)))
+    {
+        const tCIDLib::TCard4 c4Comps
+        (
+            (m_eFmt == tCIDImage::EPixFmts::TrueAlpha) ? 4 : 3
+        );
+        tCIDLib::TCard1* pc1Ptr = m_pc1Pixels + (c4Row * m_c4LineWidth);
+        switch(eComp)
+        {
+            case tCIDLib::EClrComps::Alpha :
+                // If no alpha channel, there's nothing to store
+                if (c4Comps == 3)
+                    return;
+                pc1Ptr += 3;
+                break;
+
+            case tCIDLib::EClrComps::Green :
+                pc1Ptr++;
+                break;
+
+            case tCIDLib::EClrComps::Red :
+                pc1Ptr += 2;
+                break;
+
+            default :
+                break;
+        };
+        for (tCIDLib::TCard4 c4Col = 0; c4Col < m_c4Width; c4Col++)
+        {
+            *pc1Ptr = tCIDLib::TCard1(pc2ToStore[c4Col]);
+            pc1Ptr += c4Comps;
+        }
+        return;
+    }
+
     tCIDLib::TCard4 c4Shift;
     tCIDLib::TCard4 c2Cur;
     tCIDLib::TCard4 c4Cur;
@@ -3660,20 +3994,17 @@ TPixelArrayImpl::f8InitCausalCoefs(         tCIDLib::TFloat8* const pf8ToCvt
 //  to fill in, along with the spline degree and the maximum value our current
 //  component can have, so that we can clip the values correctly.
 //
-//  The caller provides us with a buffer of width TCard2 values (the max
-//  size of a single component is 16 bits, for 16 bit gray scale and the same
-//  with alpha.)
+//  The rows are built up in buffers of TCard2 values (the max size of a
+//  single component is 16 bits, for 16 bit gray scale and the same with
+//  alpha.)
 //
 tCIDLib::TVoid
 TPixelArrayImpl::InterpComp(const   tCIDLib::EClrComps      eComp
                             , const tCIDLib::TFloat4* const pf4Coefs
-                            ,       tCIDLib::TCard2* const  pc2LoadBuf
                             ,       TPixelArrayImpl&        pixaiToFill
                             , const tCIDLib::TCard4         c4Degree
                             , const tCIDLib::TCard2         c2MaxVal) const
 {
-    const tCIDImage::EBitDepths eDepth = pixaiToFill.eBitDepth();
-
     //
     //  We have to scale the outgoing coordinates to the incoming coordinate
     //  system, so that when we interpolate against the data (which was built
@@ -3700,46 +4031,61 @@ TPixelArrayImpl::InterpComp(const   tCIDLib::EClrComps      eComp
     //  time and then ask the pixel array to suck them back in and store them
     //  based on it's format.
     //
-    tCIDLib::TFloat8 f8Cur;
-    for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4TH; c4YInd++)
-    {
-        tCIDLib::TFloat8 f8YInd = (tCIDLib::TFloat8(c4YInd) + 0.5) * f8YScale;
-        if (f8YInd >= m_c4Height)
-            f8YInd = m_c4Height - 1.0;
-
-        for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4TW; c4XInd++)
+    //  Each target row is independent, so large images are done in bands of
+    //  rows on separate threads, each with its own load buffer.
+    //
+    CIDImage_PixelArrayImpl::DoRowBands
+    (
+        0
+        , c4TH
+        , c4TW
+        , [&](const tCIDLib::TCard4 c4FirstRow, const tCIDLib::TCard4 c4EndRow)
         {
-            tCIDLib::TFloat8 f8XInd = (tCIDLib::TFloat8(c4XInd) + 0.5) * f8XScale;
-            if (f8XInd >= m_c4Width)
-                f8XInd = m_c4Width - 1.0;
+            tCIDLib::TCard2* pc2LoadBuf = new tCIDLib::TCard2[c4TW];
+            TArrayJanitor<tCIDLib::TCard2> janLoad(pc2LoadBuf);
 
-            // Interpolate the new point
-            f8Cur = f8InterpolatePoint
-            (
-                pf4Coefs
-                , m_c4Width
-                , m_c4Height
-                , f8XInd
-                , f8YInd
-                , c4Degree
-            );
-
-            // And clip it and store in the load buffer
-            if (f8Cur < 0.0)
+            tCIDLib::TFloat8 f8Cur;
+            for (tCIDLib::TCard4 c4YInd = c4FirstRow; c4YInd < c4EndRow; c4YInd++)
             {
-                pc2LoadBuf[c4XInd] = 0;
-            }
-             else
-            {
-                f8Cur = TMathLib::f8Floor(f8Cur + 0.5);
-                if (f8Cur > f8MaxVal)
-                    pc2LoadBuf[c4XInd] = c2MaxVal;
-                else
-                    pc2LoadBuf[c4XInd] = tCIDLib::TCard2(f8Cur);
+                tCIDLib::TFloat8 f8YInd = (tCIDLib::TFloat8(c4YInd) + 0.5) * f8YScale;
+                if (f8YInd >= m_c4Height)
+                    f8YInd = m_c4Height - 1.0;
+
+                for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4TW; c4XInd++)
+                {
+                    tCIDLib::TFloat8 f8XInd = (tCIDLib::TFloat8(c4XInd) + 0.5) * f8XScale;
+                    if (f8XInd >= m_c4Width)
+                        f8XInd = m_c4Width - 1.0;
+
+                    // Interpolate the new point
+                    f8Cur = f8InterpolatePoint
+                    (
+                        pf4Coefs
+                        , m_c4Width
+                        , m_c4Height
+                        , f8XInd
+                        , f8YInd
+                        , c4Degree
+                    );
+
+                    // And clip it and store in the load buffer
+                    if (f8Cur < 0.0)
+                    {
+                        pc2LoadBuf[c4XInd] = 0;
+                    }
+                     else
+                    {
+                        f8Cur = TMathLib::f8Floor(f8Cur + 0.5);
+                        if (f8Cur > f8MaxVal)
+                            pc2LoadBuf[c4XInd] = c2MaxVal;
+                        else
+                            pc2LoadBuf[c4XInd] = tCIDLib::TCard2(f8Cur);
+                    }
+                }
+                pixaiToFill.StoreCompRow(pc2LoadBuf, c4YInd, eComp);
             }
         }
-        pixaiToFill.StoreCompRow(pc2LoadBuf, c4YInd, eComp);
-    }
+    );
 }
 
 
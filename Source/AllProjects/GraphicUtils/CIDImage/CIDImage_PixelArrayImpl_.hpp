@@ -470,8 +470,7 @@ class TPixelArrayImpl : public TObject, public MStreamable
         (
             const   tCIDLib::EClrComps      eComp
             , const tCIDLib::TFloat4* const pf4Coefs
-            ,       tCIDLib::TCard2* const  pc2LoadBuf
-            ,       TPixelArrayImpl&            pixaiToFill
+            ,       TPixelArrayImpl&        pixaiToFill
             , const tCIDLib::TCard4         c4Degree
             , const tCIDLib::TCard2         c2MaxVal
         )   const;
@@ -97,6 +97,7 @@ TJPEGImage::TJPEGImage() :
     , m_bFastDecode(kCIDLib::False)
     , m_bOptimalEncoding(kCIDLib::False)
     , m_c4CompQuality(75)
+    , m_eDecScale(tCIDJPEG::EDecScales::Full)
     , m_eOutSample(tCIDJPEG::EOutSamples::F4_2_2)
     , m_pc1DecContext(nullptr)
     , m_pc1EncContext(nullptr)
@@ -109,6 +110,7 @@ TJPEGImage::TJPEGImage(const TPixelArray& pixaBits) :
     , m_bFastDecode(kCIDLib::False)
     , m_bOptimalEncoding(kCIDLib::False)
     , m_c4CompQuality(75)
+    , m_eDecScale(tCIDJPEG::EDecScales::Full)
     , m_eOutSample(tCIDJPEG::EOutSamples::F4_2_2)
     , m_pc1DecContext(nullptr)
     , m_pc1EncContext(nullptr)
@@ -133,6 +135,7 @@ TJPEGImage::TJPEGImage( const   TPixelArray&    pixaBits
     , m_bFastDecode(kCIDLib::False)
     , m_bOptimalEncoding(kCIDLib::False)
     , m_c4CompQuality(75)
+    , m_eDecScale(tCIDJPEG::EDecScales::Full)
     , m_eOutSample(tCIDJPEG::EOutSamples::F4_2_2)
     , m_pc1DecContext(nullptr)
     , m_pc1EncContext(nullptr)
@@ -147,6 +150,7 @@ TJPEGImage::TJPEGImage(const TCIDImage& imgSrc) :
     , m_bFastDecode(kCIDLib::False)
     , m_bOptimalEncoding(kCIDLib::False)
     , m_c4CompQuality(75)
+    , m_eDecScale(tCIDJPEG::EDecScales::Full)
     , m_eOutSample(tCIDJPEG::EOutSamples::F4_2_2)
     , m_pc1DecContext(nullptr)
     , m_pc1EncContext(nullptr)
@@ -161,6 +165,7 @@ TJPEGImage::TJPEGImage(const TJPEGImage& imgSrc) :
     , m_bFastDecode(imgSrc.m_bFastDecode)
     , m_bOptimalEncoding(imgSrc.m_bOptimalEncoding)
     , m_c4CompQuality(imgSrc.m_c4CompQuality)
+    , m_eDecScale(imgSrc.m_eDecScale)
     , m_eOutSample(imgSrc.m_eOutSample)
     , m_pc1DecContext(nullptr)
     , m_pc1EncContext(nullptr)
@@ -212,6 +217,7 @@ TJPEGImage& TJPEGImage::operator=(const TJPEGImage& imgSrc)
         m_bFastDecode       = imgSrc.m_bFastDecode;
         m_bOptimalEncoding  = imgSrc.m_bOptimalEncoding;
         m_c4CompQuality     = imgSrc.m_c4CompQuality;
+        m_eDecScale         = imgSrc.m_eDecScale;
         m_eOutSample        = imgSrc.m_eOutSample;
     }
     return *this;
@@ -226,6 +232,7 @@ TJPEGImage& TJPEGImage::operator=(TJPEGImage&& imgSrc)
         tCIDLib::Swap(m_bFastDecode, imgSrc.m_bFastDecode);
         tCIDLib::Swap(m_bOptimalEncoding, imgSrc.m_bOptimalEncoding);
         tCIDLib::Swap(m_c4CompQuality, imgSrc.m_c4CompQuality);
+        tCIDLib::Swap(m_eDecScale, imgSrc.m_eDecScale);
         tCIDLib::Swap(m_eOutSample, imgSrc.m_eOutSample);
         tCIDLib::Swap(m_pc1DecContext, imgSrc.m_pc1DecContext);
         tCIDLib::Swap(m_pc1EncContext, imgSrc.m_pc1EncContext);
@@ -273,6 +280,33 @@ tCIDLib::TCard4 TJPEGImage::c4CompQuality(const tCIDLib::TCard4 c4ToSet)
 }
 
 
+//
+//  Decode the image a scan line at a time to the caller's sink, instead of into
+//  our pixel array, which is left unchanged. The sink's StartImage() is called
+//  once the header is read, with the (possibly scaled) output size and format,
+//  then bStoreRow() is called for each row, top down. The rows are in the same
+//  format that the pixel array would have. If the sink returns False, we stop
+//  decoding there.
+//
+tCIDLib::TVoid
+TJPEGImage::DecodeTo(TBinInStream& strmToReadFrom, MJPEGRowSink& mjrsTar)
+{
+    Decode(strmToReadFrom, &mjrsTar);
+}
+
+
+tCIDJPEG::EDecScales TJPEGImage::eDecScale() const
+{
+    return m_eDecScale;
+}
+
+tCIDJPEG::EDecScales TJPEGImage::eDecScale(const tCIDJPEG::EDecScales eToSet)
+{
+    m_eDecScale = eToSet;
+    return m_eDecScale;
+}
+
+
 tCIDJPEG::EOutSamples TJPEGImage::eOutSample() const
 {
     return m_eOutSample;
@@ -290,128 +324,7 @@ tCIDJPEG::EOutSamples TJPEGImage::eOutSample(const tCIDJPEG::EOutSamples eToSet)
 // ---------------------------------------------------------------------------
 tCIDLib::TVoid TJPEGImage::StreamFrom(TBinInStream& strmToReadFrom)
 {
-    jpeg_decompress_struct* pcinfo = nullptr;
-    try
-    {
-        //
-        //  Create the structures we need. If we've not created the
-        //  decompression context yet, then do that.
-        //
-        if (!m_pc1DecContext)
-        {
-            m_pc1DecContext = new tCIDLib::TCard1[sizeof(jpeg_decompress_struct)];
-            jpeg_create_decompress((jpeg_decompress_struct*)m_pc1DecContext);
-        }
-        pcinfo = (jpeg_decompress_struct*)m_pc1DecContext;
-
-        // Set up our error structure. We override the default handler
-        MyErrorMgr jerr;
-        jerr.msg_buf[0] = 0;
-        pcinfo->err = jpeg_std_error((jpeg_error_mgr*)&jerr);
-        jerr.pub.error_exit = my_error_exit;
-
-        //
-        //  We use a jump error recovery, because we can't throw a C++
-        //  exception back through the C code that calls us back.
-        //
-        if (setjmp(jerr.setjmp_buffer))
-        {
-            //
-            //  If we get here, then there was an error and the message text
-            //  is in the buffer. So we'll throw an error based on that.
-            //
-            facCIDJPEG().ThrowErr
-            (
-                CID_FILE
-                , CID_LINE
-                , kJPEGErrs::errcFile_ReadFailed
-                , TString(jerr.msg_buf)
-                , tCIDLib::ESeverities::Failed
-                , tCIDLib::EErrClasses::Format
-            );
-        }
-
-        jpeg_stdio_src(pcinfo, &strmToReadFrom);
-
-        // Read the header data
-        jpeg_read_header(pcinfo, TRUE);
-
-        // Start the decompression operation
-        jpeg_start_decompress(pcinfo);
-
-        //
-        //  If our fast decode flag is set, then we'll turn off some stuff
-        //  that is used to create higher quality images.
-        //
-        if (m_bFastDecode)
-        {
-            pcinfo->do_fancy_upsampling = 0;
-            pcinfo->do_block_smoothing = 0;
-            pcinfo->dither_mode = JDITHER_NONE;
-        }
-
-        //
-        //  At this point, we can call our parent class to set up the image
-        //  attributes. This will set up the pixel array and we can then
-        //  just have the JPEG guy write straight into our buffer.
-        //
-        TSize szImg(pcinfo->image_width, pcinfo->image_height);
-        tCIDImage::EBitDepths   eDepth;
-        tCIDImage::EPixFmts     eFmt;
-        if (pcinfo->output_components == 1)
-        {
-            // It's gray scale
-            eFmt = tCIDImage::EPixFmts::GrayScale;
-            eDepth = tCIDImage::EBitDepths::Eight;
-        }
-         else if (pcinfo->num_components == 3)
-        {
-            // It's a true color image
-            eFmt = tCIDImage::EPixFmts::TrueClr;
-            eDepth = tCIDImage::EBitDepths::Eight;
-        }
-         else
-        {
-            // No other formats are supported by JPEG, so freak out
-            facCIDJPEG().ThrowErr
-            (
-                CID_FILE
-                , CID_LINE
-                , kJPEGErrs::errcFile_UnsupportedFmt
-                , tCIDLib::ESeverities::Failed
-                , tCIDLib::EErrClasses::Format
-            );
-        }
-        Set(eFmt, eDepth, tCIDImage::ERowOrders::TopDown, szImg, 0, 0);
-
-        // Get the pixel array out so that we can load up scan lines into it
-        TPixelArray& pixaTar = pixaNCBits();
-
-        // And read all the scan lines in
-        while (pcinfo->output_scanline < pcinfo->output_height)
-        {
-            // We let it load directly into our pixel array
-            tCIDLib::TCard1* pc1Cur = pixaTar.pc1RowPtr(pcinfo->output_scanline);
-            jpeg_read_scanlines(pcinfo, &pc1Cur, 1);
-        }
-
-        // Clean up the decompression operations
-        jpeg_finish_decompress(pcinfo);
-    }
-
-    catch(TError& errToCatch)
-    {
-        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
-
-        // Force a full cleanup, so we have to recreate next time, and rethrow
-        if (pcinfo)
-        {
-            jpeg_destroy_decompress(pcinfo);
-            delete [] m_pc1DecContext;
-            m_pc1DecContext = 0;
-        }
-        throw;
-    }
+    Decode(strmToReadFrom, nullptr);
 }
 
 
@@ -725,3 +638,218 @@ tCIDLib::TVoid TJPEGImage::StreamTo(TBinOutStream& strmToWriteTo) const
 }
 
 
+
+
+
+// ---------------------------------------------------------------------------
+//  TJPEGImage: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  This does the actual decoding for StreamFrom() and DecodeTo(). If we get a
+//  sink, the scan lines go to it. Else we set up our pixel array and load the
+//  scan lines straight into it.
+//
+tCIDLib::TVoid
+TJPEGImage::Decode(TBinInStream& strmToReadFrom, MJPEGRowSink* const pmjrsTar)
+{
+    jpeg_decompress_struct* pcinfo = nullptr;
+    try
+    {
+        //
+        //  Create the structures we need. If we've not created the
+        //  decompression context yet, then do that.
+        //
+        if (!m_pc1DecContext)
+        {
+            m_pc1DecContext = new tCIDLib::TCard1[sizeof(jpeg_decompress_struct)];
+            jpeg_create_decompress((jpeg_decompress_struct*)m_pc1DecContext);
+        }
+        pcinfo = (jpeg_decompress_struct*)m_pc1DecContext;
+
+        // Set up our error structure. We override the default handler
+        MyErrorMgr jerr;
+        jerr.msg_buf[0] = 0;
+        pcinfo->err = jpeg_std_error((jpeg_error_mgr*)&jerr);
+        jerr.pub.error_exit = my_error_exit;
+
+        //
+        //  We use a jump error recovery, because we can't throw a C++
+        //  exception back through the C code that calls us back.
+        //
+        if (setjmp(jerr.setjmp_buffer))
+        {
+            //
+            //  If we get here, then there was an error and the message text
+            //  is in the buffer. So we'll throw an error based on that.
+            //
+            facCIDJPEG().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kJPEGErrs::errcFile_ReadFailed
+                , TString(jerr.msg_buf)
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+            );
+        }
+
+        jpeg_stdio_src(pcinfo, &strmToReadFrom);
+
+        // Read the header data
+        jpeg_read_header(pcinfo, TRUE);
+
+        //
+        //  Set up the decoding options. These have to be done before we start
+        //  the decompression, since that's when it picks the IDCT and such.
+        //
+        //  The scaling is done in the IDCT, using the reduced size ones, which
+        //  is far faster than decoding all of the pixels and scaling after.
+        //
+        pcinfo->scale_num = 1;
+        switch(m_eDecScale)
+        {
+            case tCIDJPEG::EDecScales::Half :
+                pcinfo->scale_denom = 2;
+                break;
+
+            case tCIDJPEG::EDecScales::Quarter :
+                pcinfo->scale_denom = 4;
+                break;
+
+            case tCIDJPEG::EDecScales::Eighth :
+                pcinfo->scale_denom = 8;
+                break;
+
+            case tCIDJPEG::EDecScales::Full :
+            default :
+                pcinfo->scale_denom = 1;
+                break;
+        };
+
+        //
+        //  If our fast decode flag is set, then we'll turn off some stuff
+        //  that is used to create higher quality images, and use the fast
+        //  integer IDCT.
+        //
+        if (m_bFastDecode)
+        {
+            pcinfo->dct_method = JDCT_IFAST;
+            pcinfo->do_fancy_upsampling = 0;
+            pcinfo->do_block_smoothing = 0;
+            pcinfo->dither_mode = JDITHER_NONE;
+        }
+
+        // Start the decompression operation
+        jpeg_start_decompress(pcinfo);
+
+        //
+        //  Now we know the output format and size (which will be the scaled
+        //  size if we are scaling.)
+        //
+        TSize szImg(pcinfo->output_width, pcinfo->output_height);
+        tCIDImage::EBitDepths   eDepth;
+        tCIDImage::EPixFmts     eFmt;
+        if (pcinfo->output_components == 1)
+        {
+            // It's gray scale
+            eFmt = tCIDImage::EPixFmts::GrayScale;
+            eDepth = tCIDImage::EBitDepths::Eight;
+        }
+         else if (pcinfo->num_components == 3)
+        {
+            // It's a true color image
+            eFmt = tCIDImage::EPixFmts::TrueClr;
+            eDepth = tCIDImage::EBitDepths::Eight;
+        }
+         else
+        {
+            // No other formats are supported by JPEG, so freak out
+            facCIDJPEG().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kJPEGErrs::errcFile_UnsupportedFmt
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+            );
+        }
+
+        if (pmjrsTar)
+        {
+            pmjrsTar->StartImage(szImg, eFmt, eDepth);
+
+            //
+            //  We need a scan line buffer. We get the library to allocate it
+            //  from its per-image pool, so that it gets cleaned up even if we
+            //  long jump out on an error.
+            //
+            JSAMPARRAY pRows = (*pcinfo->mem->alloc_sarray)
+            (
+                (j_common_ptr)pcinfo
+                , JPOOL_IMAGE
+                , pcinfo->output_width * pcinfo->output_components
+                , 1
+            );
+
+            //
+            //  Read the scan lines in and pass them to the sink. If it tells
+            //  us to stop, we abort the decompression, since finish would
+            //  complain that we didn't read all the lines.
+            //
+            tCIDLib::TBoolean bStopped = kCIDLib::False;
+            while (pcinfo->output_scanline < pcinfo->output_height)
+            {
+                const tCIDLib::TCard4 c4Row = pcinfo->output_scanline;
+                jpeg_read_scanlines(pcinfo, pRows, 1);
+                if (!pmjrsTar->bStoreRow(pRows[0], c4Row))
+                {
+                    bStopped = kCIDLib::True;
+                    break;
+                }
+            }
+
+            if (bStopped)
+                jpeg_abort_decompress(pcinfo);
+            else
+                jpeg_finish_decompress(pcinfo);
+        }
+         else
+        {
+            //
+            //  At this point, we can call our parent class to set up the image
+            //  attributes. This will set up the pixel array and we can then
+            //  just have the JPEG guy write straight into our buffer.
+            //
+            Set(eFmt, eDepth, tCIDImage::ERowOrders::TopDown, szImg, 0, 0);
+
+            // Get the pixel array out so that we can load up scan lines into it
+            TPixelArray& pixaTar = pixaNCBits();
+
+            // And read all the scan lines in
+            while (pcinfo->output_scanline < pcinfo->output_height)
+            {
+                // We let it load directly into our pixel array
+                tCIDLib::TCard1* pc1Cur = pixaTar.pc1RowPtr(pcinfo->output_scanline);
+                jpeg_read_scanlines(pcinfo, &pc1Cur, 1);
+            }
+
+            // Clean up the decompression operations
+            jpeg_finish_decompress(pcinfo);
+        }
+    }
+
+    catch(TError& errToCatch)
+    {
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+
+        // Force a full cleanup, so we have to recreate next time, and rethrow
+        if (pcinfo)
+        {
+            jpeg_destroy_decompress(pcinfo);
+            delete [] m_pc1DecContext;
+            m_pc1DecContext = 0;
+        }
+        throw;
+    }
+}
@@ -20,6 +20,11 @@
 //  class is derived from TCIDImage so it can be dealt with polymorphically
 //  via that standard image interface.
 //
+//  It also defines the MJPEGRowSink mixin. For large images that are just
+//  going to be processed and thrown away (generating thumbnails and such),
+//  the image can be decoded straight to a sink a scan line at a time, so the
+//  whole image never has to be in memory.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -31,6 +36,46 @@
 
 #pragma CIDLIB_PACK(CIDLIBPACK)
 
+// ---------------------------------------------------------------------------
+//  CLASS: MJPEGRowSink
+// PREFIX: mjrs
+// ---------------------------------------------------------------------------
+class CIDJPEGEXP MJPEGRowSink
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        virtual ~MJPEGRowSink() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public, virtual methods
+        // -------------------------------------------------------------------
+        virtual tCIDLib::TBoolean bStoreRow
+        (
+            const   tCIDLib::TCard1* const  pc1Row
+            , const tCIDLib::TCard4         c4Row
+        ) = 0;
+
+        virtual tCIDLib::TVoid StartImage
+        (
+            const   TSize&                  szImage
+            , const tCIDImage::EPixFmts     eFmt
+            , const tCIDImage::EBitDepths   eDepth
+        ) = 0;
+
+
+    protected :
+        // -------------------------------------------------------------------
+        //  Hidden constructors and operators
+        // -------------------------------------------------------------------
+        MJPEGRowSink() = default;
+        MJPEGRowSink(const MJPEGRowSink&) = default;
+        MJPEGRowSink& operator=(const MJPEGRowSink&) = default;
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TJPEGImage
 // PREFIX: img
@@ -112,6 +157,19 @@ class CIDJPEGEXP TJPEGImage : public TCIDImage
             const   tCIDLib::TCard4         c4ToSet
         );
 
+        tCIDLib::TVoid DecodeTo
+        (
+                    TBinInStream&           strmToReadFrom
+            ,       MJPEGRowSink&           mjrsTar
+        );
+
+        tCIDJPEG::EDecScales eDecScale() const;
+
+        tCIDJPEG::EDecScales eDecScale
+        (
+            const   tCIDJPEG::EDecScales    eToSet
+        );
+
         tCIDJPEG::EOutSamples eOutSample() const;
 
         tCIDJPEG::EOutSamples eOutSample
@@ -139,6 +197,11 @@ class CIDJPEGEXP TJPEGImage : public TCIDImage
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Decode
+        (
+                    TBinInStream&           strmToReadFrom
+            ,       MJPEGRowSink* const     pmjrsTar
+        );
 
 
         // -------------------------------------------------------------------
@@ -157,6 +220,11 @@ class CIDJPEGEXP TJPEGImage : public TCIDImage
         //      This is runtime only, and indicates what quality level we
         //      should use when writing out. It is 0 to 100.
         //
+        //  m_eDecScale
+        //      This is runtime only, and indicates the scaling to do when
+        //      decoding. The image ends up being the scaled size, rounded up.
+        //      Defaults to full size.
+        //
         //  m_eOutSample
         //      Controls the sampling factors in the output (for YCrPr type
         //      output, which is almost always the case.)
@@ -171,6 +239,7 @@ class CIDJPEGEXP TJPEGImage : public TCIDImage
         tCIDLib::TBoolean           m_bFastDecode;
         tCIDLib::TBoolean           m_bOptimalEncoding;
         tCIDLib::TCard4             m_c4CompQuality;
+        tCIDJPEG::EDecScales        m_eDecScale;
         tCIDJPEG::EOutSamples       m_eOutSample;
         tCIDLib::TCard1*            m_pc1DecContext;
         mutable tCIDLib::TCard1*    m_pc1EncContext;
@@ -28,6 +28,19 @@
 
 namespace tCIDJPEG
 {
+    //
+    //  Indicates the scaling to do when decoding. The reduction is done as part
+    //  of the inverse DCT, so it's much faster than decoding at full size and
+    //  then scaling the image down.
+    //
+    enum class EDecScales
+    {
+        Full
+        , Half
+        , Quarter
+        , Eighth
+    };
+
     // Indicates the sampling used for compression
     enum class EOutSamples
     {
@@ -164,31 +164,259 @@ namespace
 //  Local methods
 // ---------------------------------------------------------------------------
 
-// An inlined Paeth predictor method for speed.
-inline tCIDLib::TCard4 c4PaethAbs(  const   tCIDLib::TCard4 c4Lhs
-                                    , const tCIDLib::TCard4 c4Rhs)
+//
+//  The scan line filter kernels. These are templatized on the bytes per pixel,
+//  which is the look back distance for the left hand pixel. That lets the
+//  compiler unroll and vectorize them for each pixel size, instead of having
+//  the generic per-byte loop with the filter type switch and first pixel and
+//  first line checks inside it. DefilterScanLine() dispatches to the correct
+//  instantiation based on the pixel size of the image.
+//
+//  The filtered line data does not include the leading filter type byte. The
+//  previous line pointer is null for the first line, where the line above is
+//  defined to be all zeros.
+//
+inline tCIDLib::TCard1
+c1PaethPred(const   tCIDLib::TInt4  i4Left
+            , const tCIDLib::TInt4  i4Above
+            , const tCIDLib::TInt4  i4AboveLeft)
+{
+    //
+    //  The estimate is left + above - above left, and we want whichever of the
+    //  three is closest to it. Rearranged so that we don't need the estimate
+    //  itself, and there are no branches other than the selects at the end,
+    //  which compile to conditional moves.
+    //
+    tCIDLib::TInt4 i4PA = i4Above - i4AboveLeft;
+    tCIDLib::TInt4 i4PB = i4Left - i4AboveLeft;
+    tCIDLib::TInt4 i4PC = i4PA + i4PB;
+    i4PA = (i4PA < 0) ? -i4PA : i4PA;
+    i4PB = (i4PB < 0) ? -i4PB : i4PB;
+    i4PC = (i4PC < 0) ? -i4PC : i4PC;
+
+    // Use & not && here, to avoid the short circuit branch
+    const tCIDLib::TInt4 i4NotLeft = (i4PB <= i4PC) ? i4Above : i4AboveLeft;
+    return tCIDLib::TCard1(((i4PA <= i4PB) & (i4PA <= i4PC)) ? i4Left : i4NotLeft);
+}
+
+template <const tCIDLib::TCard4 c4Bpp> tCIDLib::TVoid
+UnfilterSub(tCIDLib::TCard1* const pc1Ln, const tCIDLib::TCard4 c4Bytes)
+{
+    for (tCIDLib::TCard4 c4Ind = c4Bpp; c4Ind < c4Bytes; c4Ind++)
+        pc1Ln[c4Ind] += pc1Ln[c4Ind - c4Bpp];
+}
+
+inline tCIDLib::TVoid
+UnfilterUp(         tCIDLib::TCard1* const  pc1Ln
+            , const tCIDLib::TCard1* const  pc1Prev
+            , const tCIDLib::TCard4         c4Bytes)
+{
+    for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4Bytes; c4Ind++)
+        pc1Ln[c4Ind] += pc1Prev[c4Ind];
+}
+
+template <const tCIDLib::TCard4 c4Bpp> tCIDLib::TVoid
+UnfilterAvg(        tCIDLib::TCard1* const  pc1Ln
+            , const tCIDLib::TCard1* const  pc1Prev
+            , const tCIDLib::TCard4         c4Bytes)
+{
+    const tCIDLib::TCard4 c4First = tCIDLib::MinVal(c4Bpp, c4Bytes);
+    tCIDLib::TCard4 c4Ind = 0;
+    if (pc1Prev)
+    {
+        for (; c4Ind < c4First; c4Ind++)
+            pc1Ln[c4Ind] += pc1Prev[c4Ind] >> 1;
+
+        for (; c4Ind < c4Bytes; c4Ind++)
+        {
+            pc1Ln[c4Ind] += tCIDLib::TCard1
+            (
+                (tCIDLib::TCard4(pc1Ln[c4Ind - c4Bpp]) + pc1Prev[c4Ind]) >> 1
+            );
+        }
+    }
+     else
+    {
+        for (c4Ind = c4First; c4Ind < c4Bytes; c4Ind++)
+            pc1Ln[c4Ind] += pc1Ln[c4Ind - c4Bpp] >> 1;
+    }
+}
+
+template <const tCIDLib::TCard4 c4Bpp> tCIDLib::TVoid
+UnfilterPaeth(          tCIDLib::TCard1* const  pc1Ln
+                , const tCIDLib::TCard1* const  pc1Prev
+                , const tCIDLib::TCard4         c4Bytes)
+{
+    // On the first line Paeth always picks the left pixel, so it's just Sub
+    if (!pc1Prev)
+    {
+        UnfilterSub<c4Bpp>(pc1Ln, c4Bytes);
+        return;
+    }
+
+    // For the first pixel it always picks the one above
+    const tCIDLib::TCard4 c4First = tCIDLib::MinVal(c4Bpp, c4Bytes);
+    tCIDLib::TCard4 c4Ind = 0;
+    for (; c4Ind < c4First; c4Ind++)
+        pc1Ln[c4Ind] += pc1Prev[c4Ind];
+
+    for (; c4Ind < c4Bytes; c4Ind++)
+    {
+        pc1Ln[c4Ind] += c1PaethPred
+        (
+            pc1Ln[c4Ind - c4Bpp], pc1Prev[c4Ind], pc1Prev[c4Ind - c4Bpp]
+        );
+    }
+}
+
+template <const tCIDLib::TCard4 c4Bpp> tCIDLib::TVoid
+UnfilterLine(const  tCIDLib::TCard1         c1Filter
+            ,       tCIDLib::TCard1* const  pc1Ln
+            , const tCIDLib::TCard1* const  pc1Prev
+            , const tCIDLib::TCard4         c4Bytes)
 {
-    tCIDLib::TInt4 i4Res = tCIDLib::TInt4(c4Lhs) - tCIDLib::TInt4(c4Rhs);
-    if (i4Res < 0)
-        i4Res *= -1;
-    return tCIDLib::TCard4(i4Res);
+    switch(c1Filter)
+    {
+        case CIDPNG_Image::c1Filter_Sub :
+            UnfilterSub<c4Bpp>(pc1Ln, c4Bytes);
+            break;
+
+        case CIDPNG_Image::c1Filter_Up :
+            // On the first line, adding zeros does nothing
+            if (pc1Prev)
+                UnfilterUp(pc1Ln, pc1Prev, c4Bytes);
+            break;
+
+        case CIDPNG_Image::c1Filter_Avg :
+            UnfilterAvg<c4Bpp>(pc1Ln, pc1Prev, c4Bytes);
+            break;
+
+        case CIDPNG_Image::c1Filter_Paeth :
+            UnfilterPaeth<c4Bpp>(pc1Ln, pc1Prev, c4Bytes);
+            break;
+
+        default :
+            break;
+    };
 }
 
-inline tCIDLib::TCard4
-c4PaethPredictor(const  tCIDLib::TCard4 c4Prev
-                , const tCIDLib::TCard4 c4Above
-                , const tCIDLib::TCard4 c4AbovePrev)
+
+//
+//  On the encode side, this is called with the buffer of unfiltered scan lines,
+//  each with a leading filter type byte. For each line we pick the filter that
+//  gives the smallest sum of absolute differences (taking the filtered bytes as
+//  signed values), which is the standard heuristic and does a good job of
+//  picking the filter that compresses best.
+//
+//  We do the lines bottom up and each line right to left, filtering in place.
+//  That way the left, above, and above left bytes we need are still the
+//  original values when we get to them.
+//
+tCIDLib::TVoid
+FilterScanLines(        tCIDLib::TCard1* const  pc1Buf
+                , const tCIDLib::TCard4         c4LineBytes
+                , const tCIDLib::TCard4         c4Bpp
+                , const tCIDLib::TCard4         c4Lines)
 {
-    tCIDLib::TCard4 c4Est = c4Prev + c4Above - c4AbovePrev;
-    tCIDLib::TCard4 c4PEst = c4PaethAbs(c4Est, c4Prev);
-    tCIDLib::TCard4 c4AEst = c4PaethAbs(c4Est, c4Above);
-    tCIDLib::TCard4 c4APEst = c4PaethAbs(c4Est, c4AbovePrev);
-
-    if ((c4PEst <= c4AEst) && (c4PEst <= c4APEst))
-        return c4Prev;
-    else if (c4AEst <= c4APEst)
-        return c4Above;
-    return c4AbovePrev;
+    const tCIDLib::TCard4 c4Stride = c4LineBytes + 1;
+    tCIDLib::TCard4 c4LInd = c4Lines;
+    while (c4LInd)
+    {
+        c4LInd--;
+        tCIDLib::TCard1* const pc1Ln = pc1Buf + (c4LInd * c4Stride) + 1;
+        const tCIDLib::TCard1* const pc1Prev = c4LInd ? (pc1Ln - c4Stride) : nullptr;
+
+        //
+        //  Sum up the results of each filter type. To keep the loop simple we
+        //  get all four neighbours on each round, with zeros for any that are
+        //  off the left edge or above the first line.
+        //
+        tCIDLib::TCard4 ac4Sums[5] = { 0, 0, 0, 0, 0 };
+        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4LineBytes; c4Ind++)
+        {
+            const tCIDLib::TInt4 i4Cur = pc1Ln[c4Ind];
+            tCIDLib::TInt4 i4Left = 0;
+            tCIDLib::TInt4 i4Above = 0;
+            tCIDLib::TInt4 i4AboveLeft = 0;
+            if (c4Ind >= c4Bpp)
+                i4Left = pc1Ln[c4Ind - c4Bpp];
+            if (pc1Prev)
+            {
+                i4Above = pc1Prev[c4Ind];
+                if (c4Ind >= c4Bpp)
+                    i4AboveLeft = pc1Prev[c4Ind - c4Bpp];
+            }
+
+            const tCIDLib::TInt1 ai1Res[5] =
+            {
+                tCIDLib::TInt1(i4Cur)
+                , tCIDLib::TInt1(i4Cur - i4Left)
+                , tCIDLib::TInt1(i4Cur - i4Above)
+                , tCIDLib::TInt1(i4Cur - ((i4Left + i4Above) >> 1))
+                , tCIDLib::TInt1(i4Cur - c1PaethPred(i4Left, i4Above, i4AboveLeft))
+            };
+            for (tCIDLib::TCard4 c4FInd = 0; c4FInd < 5; c4FInd++)
+            {
+                ac4Sums[c4FInd] += tCIDLib::TCard4
+                (
+                    (ai1Res[c4FInd] < 0) ? -ai1Res[c4FInd] : ai1Res[c4FInd]
+                );
+            }
+        }
+
+        // Take the lowest, favoring the simpler filters on a tie
+        tCIDLib::TCard1 c1Filter = CIDPNG_Image::c1Filter_None;
+        for (tCIDLib::TCard1 c1FInd = 1; c1FInd < 5; c1FInd++)
+        {
+            if (ac4Sums[c1FInd] < ac4Sums[c1Filter])
+                c1Filter = c1FInd;
+        }
+        pc1Ln[-1] = c1Filter;
+        if (c1Filter == CIDPNG_Image::c1Filter_None)
+            continue;
+
+        // And now apply it, right to left
+        tCIDLib::TCard4 c4Ind = c4LineBytes;
+        while (c4Ind)
+        {
+            c4Ind--;
+            tCIDLib::TCard4 c4Left = 0;
+            tCIDLib::TCard4 c4Above = 0;
+            tCIDLib::TCard4 c4AboveLeft = 0;
+            if (c4Ind >= c4Bpp)
+                c4Left = pc1Ln[c4Ind - c4Bpp];
+            if (pc1Prev)
+            {
+                c4Above = pc1Prev[c4Ind];
+                if (c4Ind >= c4Bpp)
+                    c4AboveLeft = pc1Prev[c4Ind - c4Bpp];
+            }
+
+            tCIDLib::TCard4 c4Pred = 0;
+            switch(c1Filter)
+            {
+                case CIDPNG_Image::c1Filter_Sub :
+                    c4Pred = c4Left;
+                    break;
+
+                case CIDPNG_Image::c1Filter_Up :
+                    c4Pred = c4Above;
+                    break;
+
+                case CIDPNG_Image::c1Filter_Avg :
+                    c4Pred = (c4Left + c4Above) >> 1;
+                    break;
+
+                case CIDPNG_Image::c1Filter_Paeth :
+                    c4Pred = c1PaethPred(c4Left, c4Above, c4AboveLeft);
+                    break;
+
+                default :
+                    break;
+            };
+            pc1Ln[c4Ind] = tCIDLib::TCard1(pc1Ln[c4Ind] - c4Pred);
+        }
+    }
 }
 
 
@@ -1438,18 +1666,17 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
     THeapBuf mbufUncomp(c4UncompSz, c4UncompSz);
 
     //
-    //  And now load up the data into the buffer. This is fairly complex and involves
-    //  filtering and all that.
+    //  And now load up the data into the buffer. We put out each scan line
+    //  unfiltered first, converting to the target format as we go. Then we go
+    //  back and pick the best filter for each line below, which is much simpler
+    //  than trying to filter on the fly for each format. Each line gets a filter
+    //  type byte, which we just leave as None for now.
     //
     tCIDLib::TCard4 c4TarInd = 0;
 
     if (tCIDLib::bAllBitsOn(eSrcFmt, tCIDImage::EPixFmts::Palette)
     ||  ((eSrcFmt == tCIDImage::EPixFmts::GrayScale) && (tCIDLib::c4EnumOrd(eSrcDepth) < 16)))
     {
-        tCIDLib::TCard4 c4Bits;
-        tCIDLib::TCard1 c1Cur;
-        tCIDLib::TCard1 c1Prev;
-
         //
         //  It's palette based or it's one of the gray scales less than
         //  16 bits and without alpha. We can treat all of these the same
@@ -1464,16 +1691,15 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
         //  sample generic loop, but we do the 8 bit version separately
         //  for better efficiency.
         //
-        //  We do sub type filtering on all these.
-        //
         if (eTarDepth < tCIDImage::EBitDepths::Eight)
         {
+            tCIDLib::TCard4 c4Bits;
+            tCIDLib::TCard1 c1Cur;
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
+                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_None, c4TarInd++);
                 c4Bits = 0;
                 c1Cur = 0;
-                c1Prev = 0;
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
                     c1Cur <<= tCIDLib::TCard1(eTarDepth);
@@ -1482,16 +1708,16 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
 
                     if (c4Bits == 8)
                     {
-                        mbufUncomp.PutCard1(c1Cur - c1Prev, c4TarInd++);
+                        mbufUncomp.PutCard1(c1Cur, c4TarInd++);
                         c4Bits = 0;
-                        c1Prev = c1Cur;
+                        c1Cur = 0;
                     }
                 }
 
-                // If any spare bits left over, put them out
+                // If any spare bits left over, left justify them and put them out
                 if (c4Bits)
                 {
-                    c1Cur <<= tCIDLib::TCard1(eTarDepth);
+                    c1Cur <<= tCIDLib::TCard1(8 - c4Bits);
                     mbufUncomp.PutCard1(c1Cur, c4TarInd++);
                 }
             }
@@ -1500,13 +1726,13 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
         {
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
-                c1Prev = 0;
+                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_None, c4TarInd++);
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
-                    c1Cur = tCIDLib::TCard1(pixaSrc.c4At(c4XInd, c4YInd));
-                    mbufUncomp.PutCard1(c1Cur - c1Prev, c4TarInd++);
-                    c1Prev = c1Cur;
+                    mbufUncomp.PutCard1
+                    (
+                        tCIDLib::TCard1(pixaSrc.c4At(c4XInd, c4YInd)), c4TarInd++
+                    );
                 }
             }
         }
@@ -1519,385 +1745,60 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
         //  support 5 bit type color, so we'll extend it out to make it
         //  24 bit RGB.
         //
+        //  Note that the data in the pixel array is in native bit color
+        //  format, so we cannot just copy over bytes directly one for one.
+        //  We have to do an out of order operation on each pixel.
+        //
+        tCIDLib::TCard1* pc1Tar = mbufUncomp.pc1Data();
         if (eSrcDepth == tCIDImage::EBitDepths::Five)
         {
-            // Current pixel color
-            tCIDLib::TCard1 c1CurBlue;
-            tCIDLib::TCard1 c1CurGreen;
-            tCIDLib::TCard1 c1CurRed;
-
-            // From the row above
-            tCIDLib::TCard1 c1PriorBlue;
-            tCIDLib::TCard1 c1PriorGreen;
-            tCIDLib::TCard1 c1PriorRed;
-
-            // From the previous pixel to the left
-            tCIDLib::TCard1 c1PrevBlue;
-            tCIDLib::TCard1 c1PrevGreen;
-            tCIDLib::TCard1 c1PrevRed;
-
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                //
-                //  On the first line we'll do sub, and on the subsequent
-                //  ones we'll do average.
-                //
-                tCIDLib::TCard2* pc2Prior;
-                if (c4YInd)
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Avg, c4TarInd++);
-                    pc2Prior = (tCIDLib::TCard2*)pixaSrc.pc1RowPtr(c4YInd - 1);
-                }
-                 else
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
-                    pc2Prior = 0;
-                }
-
+                pc1Tar[c4TarInd++] = CIDPNG_Image::c1Filter_None;
                 const tCIDLib::TCard2* pc2Cur = (tCIDLib::TCard2*)pixaSrc.pc1RowPtr(c4YInd);
-
-                //
-                //  Do an initial pulling out of the color values. After this,
-                //  we'll only update them as requireda t the bottom of the
-                //  inner loop instead of pulling them all back out each time.
-                //
-                if (pc2Prior)
-                {
-                    c1PriorRed = tCIDLib::TCard1((*pc2Prior >> 10) & 0x1F) << 3;
-                    c1PriorGreen = tCIDLib::TCard1((*pc2Prior >> 5) & 0x1F) << 3;
-                    c1PriorBlue = tCIDLib::TCard1((*pc2Prior & 0x1F)) << 3;
-                }
-                 else
-                {
-                    c1PriorRed = 0;
-                    c1PriorGreen = 0;
-                    c1PriorBlue = 0;
-                }
-
-                c1CurRed = tCIDLib::TCard1((*pc2Cur >> 10) & 0x1F) << 3;
-                c1CurGreen = tCIDLib::TCard1((*pc2Cur >> 5) & 0x1F) << 3;
-                c1CurBlue = tCIDLib::TCard1((*pc2Cur & 0x1F)) << 3;
-
-                c1PrevRed = c1CurRed;
-                c1PrevGreen = c1CurGreen;
-                c1PrevBlue = c1CurBlue;
-
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
-                    if (!c4YInd && !c4XInd)
-                    {
-                        //
-                        //  We can't do either filter or sub here since we
-                        //  we aren't far enough along.
-                        //
-                        mbufUncomp.PutCard1(c1CurRed, c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurGreen, c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurBlue, c4TarInd++);
-                    }
-                     else if (!c4YInd && c4XInd)
-                    {
-                        //
-                        //  We can do sub filter since we are past the first
-                        //  horizontal sample but not average since there's
-                        //  no previous line yet.
-                        //
-                        mbufUncomp.PutCard1(c1CurRed - c1PrevRed, c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurGreen - c1PrevGreen, c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurBlue - c1PrevBlue, c4TarInd++);
-                    }
-                     else if (c4YInd && !c4XInd)
-                    {
-                        //
-                        //  Here we have a prior scan line but not a prior
-                        //  sample so we can do a simple version of average.
-                        //
-                        mbufUncomp.PutCard1(c1CurRed - (c1PriorRed >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurGreen - (c1PriorGreen >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(c1CurBlue - (c1PriorBlue >> 1), c4TarInd++);
-                    }
-                     else
-                    {
-                        //
-                        //  Here we have both a prior scan line and a previous
-                        //  sample, so we do average filtering here.
-                        //
-                        mbufUncomp.PutCard1
-                        (
-                            c1CurRed - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(c1PrevRed)
-                                 + tCIDLib::TCard2(c1PriorRed)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            c1CurGreen - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(c1PrevGreen)
-                                 + tCIDLib::TCard2(c1PriorGreen)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            c1CurBlue - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(c1PrevBlue)
-                                 + tCIDLib::TCard2(c1PriorBlue)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-                    }
-
-                    //
-                    //  Move our pointers forward and get new values out. Save
-                    //  the current as the previous before we change them.
-                    //
-                    c1PrevRed = c1CurRed;
-                    c1PrevGreen = c1CurGreen;
-                    c1PrevBlue = c1CurBlue;
-
-                    // Now move the current up and get the values out
-                    pc2Cur++;
-                    c1CurRed = tCIDLib::TCard1((*pc2Cur >> 10) & 0x1F) << 3;
-                    c1CurGreen = tCIDLib::TCard1((*pc2Cur >> 5) & 0x1F) << 3;
-                    c1CurBlue = tCIDLib::TCard1((*pc2Cur & 0x1F)) << 3;
-
-                    if (pc2Prior)
-                    {
-                        pc2Prior++;
-                        c1PriorRed = tCIDLib::TCard1((*pc2Prior >> 10) & 0x1F) << 3;
-                        c1PriorGreen = tCIDLib::TCard1((*pc2Prior >> 5) & 0x1F) << 3;
-                        c1PriorBlue = tCIDLib::TCard1((*pc2Prior & 0x1F)) << 3;
-                    }
+                    const tCIDLib::TCard2 c2Cur = *pc2Cur++;
+                    pc1Tar[c4TarInd++] = tCIDLib::TCard1((c2Cur >> 10) & 0x1F) << 3;
+                    pc1Tar[c4TarInd++] = tCIDLib::TCard1((c2Cur >> 5) & 0x1F) << 3;
+                    pc1Tar[c4TarInd++] = tCIDLib::TCard1(c2Cur & 0x1F) << 3;
                 }
             }
         }
          else if (tCIDLib::bAllBitsOn(eSrcFmt, tCIDImage::EPixFmts::Alpha))
         {
-            TPixelArray::TRGBQuad* pqPrior;
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                //
-                //  On the first line we'll do sub, and on the subsequent
-                //  ones we'll do average.
-                //
-                if (c4YInd)
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Avg, c4TarInd++);
-                    pqPrior = (TPixelArray::TRGBQuad*)pixaSrc.pc1RowPtr(c4YInd - 1);
-                }
-                 else
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
-                    pqPrior = 0;
-                }
-
-                TPixelArray::TRGBQuad* pqCur = (TPixelArray::TRGBQuad*)pixaSrc.pc1RowPtr(c4YInd);
-                TPixelArray::TRGBQuad* pqPrev = pqCur;
+                pc1Tar[c4TarInd++] = CIDPNG_Image::c1Filter_None;
+                const TPixelArray::TRGBQuad* pqCur
+                (
+                    (const TPixelArray::TRGBQuad*)pixaSrc.pc1RowPtr(c4YInd)
+                );
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
-                    //
-                    //  Note that the data in the pixel array is in native
-                    //  bit color format, so we cannot just copy over bytes
-                    //  directly one for one. We have to do an out of order
-                    //  operation on each pixel pass.
-                    //
-                    if (!c4YInd && !c4XInd)
-                    {
-                        //
-                        //  We can't do either filter or sub here since we
-                        //  we aren't far enough along.
-                        //
-                        mbufUncomp.PutCard1(pqCur->c1Red, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Green, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Blue, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Alpha, c4TarInd++);
-                    }
-                     else if (!c4YInd && c4XInd)
-                    {
-                        //
-                        //  We can do sub filter since we are past the first
-                        //  horizontal sample but not average since there's
-                        //  no previous line yet.
-                        //
-                        mbufUncomp.PutCard1(pqCur->c1Red - pqPrev->c1Red, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Green - pqPrev->c1Green, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Blue - pqPrev->c1Blue, c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Alpha - pqPrev->c1Alpha, c4TarInd++);
-                    }
-                     else if (c4YInd && !c4XInd)
-                    {
-                        //
-                        //  Here we have a prior scan line but not a prior
-                        //  sample so we can do a simple version of average.
-                        //
-                        mbufUncomp.PutCard1(pqCur->c1Red - (pqPrior->c1Red >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Green - (pqPrior->c1Green >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Blue - (pqPrior->c1Blue >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(pqCur->c1Alpha - (pqPrior->c1Alpha >> 1), c4TarInd++);
-                    }
-                     else
-                    {
-                        //
-                        //  Here we have both a prior scan line and a previous
-                        //  sample, so we do average filtering here.
-                        //
-                        mbufUncomp.PutCard1
-                        (
-                            pqCur->c1Red - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(pqPrev->c1Red)
-                                 + tCIDLib::TCard2(pqPrior->c1Red)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            pqCur->c1Green - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(pqPrev->c1Green)
-                                 + tCIDLib::TCard2(pqPrior->c1Green)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            pqCur->c1Blue - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(pqPrev->c1Blue)
-                                 + tCIDLib::TCard2(pqPrior->c1Blue)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            pqCur->c1Alpha - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(pqPrev->c1Alpha)
-                                 + tCIDLib::TCard2(pqPrior->c1Alpha)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-                    }
-
+                    pc1Tar[c4TarInd++] = pqCur->c1Red;
+                    pc1Tar[c4TarInd++] = pqCur->c1Green;
+                    pc1Tar[c4TarInd++] = pqCur->c1Blue;
+                    pc1Tar[c4TarInd++] = pqCur->c1Alpha;
                     pqCur++;
-                    if (c4XInd)
-                        pqPrev++;
-                    if (pqPrior)
-                        pqPrior++;
                 }
             }
         }
          else
         {
-            TPixelArray::TRGBTriple* ptPrior;
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                //
-                //  On the first line we'll do sub, and on the subsequent
-                //  ones we'll do average.
-                //
-                if (c4YInd)
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Avg, c4TarInd++);
-                    ptPrior = (TPixelArray::TRGBTriple*)pixaSrc.pc1RowPtr(c4YInd - 1);
-                }
-                 else
-                {
-                    mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
-                    ptPrior = 0;
-                }
-
-                TPixelArray::TRGBTriple* ptCur = (TPixelArray::TRGBTriple*)pixaSrc.pc1RowPtr(c4YInd);
-                TPixelArray::TRGBTriple* ptPrev = ptCur;
+                pc1Tar[c4TarInd++] = CIDPNG_Image::c1Filter_None;
+                const TPixelArray::TRGBTriple* ptCur
+                (
+                    (const TPixelArray::TRGBTriple*)pixaSrc.pc1RowPtr(c4YInd)
+                );
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
-                    //
-                    //  Note that the data in the pixel array is in native
-                    //  bit color format, so we cannot just copy over bytes
-                    //  directly one for one. We have to do an out of order
-                    //  operation on each pixel pass.
-                    //
-                    if (!c4YInd && !c4XInd)
-                    {
-                        //
-                        //  We can't do either filter or sub here since we
-                        //  we aren't far enough along.
-                        //
-                        mbufUncomp.PutCard1(ptCur->c1Red, c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Green, c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Blue, c4TarInd++);
-                    }
-                     else if (!c4YInd && c4XInd)
-                    {
-                        //
-                        //  We can do sub filter since we are past the first
-                        //  horizontal sample but not average since there's
-                        //  no previous line yet.
-                        //
-                        mbufUncomp.PutCard1(ptCur->c1Red - ptPrev->c1Red, c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Green - ptPrev->c1Green, c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Blue - ptPrev->c1Blue, c4TarInd++);
-                    }
-                     else if (c4YInd && !c4XInd)
-                    {
-                        //
-                        //  Here we have a prior scan line but not a prior
-                        //  sample so we can do a simple version of average.
-                        //
-                        mbufUncomp.PutCard1(ptCur->c1Red - (ptPrior->c1Red >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Green - (ptPrior->c1Green >> 1), c4TarInd++);
-                        mbufUncomp.PutCard1(ptCur->c1Blue - (ptPrior->c1Blue >> 1), c4TarInd++);
-                    }
-                     else
-                    {
-                        //
-                        //  Here we have both a prior scan line and a previous
-                        //  sample, so we do average filtering here.
-                        //
-                        mbufUncomp.PutCard1
-                        (
-                            ptCur->c1Red - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(ptPrev->c1Red)
-                                 + tCIDLib::TCard2(ptPrior->c1Red)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            ptCur->c1Green - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(ptPrev->c1Green)
-                                 + tCIDLib::TCard2(ptPrior->c1Green)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-
-                        mbufUncomp.PutCard1
-                        (
-                            ptCur->c1Blue - tCIDLib::TCard1
-                            (
-                                (tCIDLib::TCard2(ptPrev->c1Blue)
-                                 + tCIDLib::TCard2(ptPrior->c1Blue)) >> 1
-                            )
-                            , c4TarInd++
-                        );
-                    }
-
+                    pc1Tar[c4TarInd++] = ptCur->c1Red;
+                    pc1Tar[c4TarInd++] = ptCur->c1Green;
+                    pc1Tar[c4TarInd++] = ptCur->c1Blue;
                     ptCur++;
-                    if (c4XInd)
-                        ptPrev++;
-                    if (ptPrior)
-                        ptPrior++;
                 }
             }
         }
@@ -1918,22 +1819,14 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
         {
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
+                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_None, c4TarInd++);
 
-                tCIDLib::TCard1 c1V1;
-                tCIDLib::TCard1 c1V2;
-                tCIDLib::TCard1 c1PV1 = 0;
-                tCIDLib::TCard1 c1PV2 = 0;
                 tCIDLib::TCard4 c4Cur;
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
                     c4Cur = pixaSrc.c4At(c4XInd, c4YInd);
-                    c1V1 = tCIDLib::TCard1(c4Cur >> 8);
-                    c1V2 = tCIDLib::TCard1(c4Cur & 0xFF);
-                    mbufUncomp.PutCard1(c1V1 - c1PV1, c4TarInd++);
-                    mbufUncomp.PutCard1(c1V2 - c1PV2, c4TarInd++);
-                    c1PV1 = c1V1;
-                    c1PV2 = c1V2;
+                    mbufUncomp.PutCard1(tCIDLib::TCard1(c4Cur >> 8), c4TarInd++);
+                    mbufUncomp.PutCard1(tCIDLib::TCard1(c4Cur & 0xFF), c4TarInd++);
                 }
             }
         }
@@ -1942,42 +1835,48 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
             // It's 16 bit with alpha
             for (tCIDLib::TCard4 c4YInd = 0; c4YInd < c4CY; c4YInd++)
             {
-                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_Sub, c4TarInd++);
-
-                tCIDLib::TCard1 c1V1;
-                tCIDLib::TCard1 c1V2;
-                tCIDLib::TCard1 c1V3;
-                tCIDLib::TCard1 c1V4;
-
-                tCIDLib::TCard1 c1PV1 = 0;
-                tCIDLib::TCard1 c1PV2 = 0;
-                tCIDLib::TCard1 c1PV3 = 0;
-                tCIDLib::TCard1 c1PV4 = 0;
+                mbufUncomp.PutCard1(CIDPNG_Image::c1Filter_None, c4TarInd++);
 
                 tCIDLib::TCard4 c4Cur;
                 for (tCIDLib::TCard4 c4XInd = 0; c4XInd < c4CX; c4XInd++)
                 {
                     c4Cur = pixaSrc.c4At(c4XInd, c4YInd);
-
-                    c1V1 = tCIDLib::TCard1(c4Cur >> 24);
-                    c1V2 = tCIDLib::TCard1((c4Cur >> 16) & 0xFF);
-                    c1V3 = tCIDLib::TCard1((c4Cur >> 8) & 0xFF);
-                    c1V4 = tCIDLib::TCard1(c4Cur & 0xFF);
-
-                    mbufUncomp.PutCard1(c1V1 - c1PV1, c4TarInd++);
-                    mbufUncomp.PutCard1(c1V2 - c1PV2, c4TarInd++);
-                    mbufUncomp.PutCard1(c1V3 - c1PV3, c4TarInd++);
-                    mbufUncomp.PutCard1(c1V4 - c1PV4, c4TarInd++);
-
-                    c1PV1 = c1V1;
-                    c1PV2 = c1V2;
-                    c1PV3 = c1V3;
-                    c1PV4 = c1V4;
+                    mbufUncomp.PutCard1(tCIDLib::TCard1(c4Cur >> 24), c4TarInd++);
+                    mbufUncomp.PutCard1(tCIDLib::TCard1((c4Cur >> 16) & 0xFF), c4TarInd++);
+                    mbufUncomp.PutCard1(tCIDLib::TCard1((c4Cur >> 8) & 0xFF), c4TarInd++);
+                    mbufUncomp.PutCard1(tCIDLib::TCard1(c4Cur & 0xFF), c4TarInd++);
                 }
             }
         }
     }
 
+    //
+    //  Now go back and filter the lines. Every line is the same size, so we can
+    //  get that from how much we stored. The filter distance is the bytes per
+    //  pixel.
+    //
+    //  Palette and sub-byte images are left with filter None, as the PNG spec
+    //  recommends. Their values are indices or packed samples, so differences
+    //  between them mean nothing, and filtering them usually makes them compress
+    //  worse.
+    //
+    const tCIDLib::TBoolean bNoFilter
+    (
+        tCIDLib::bAllBitsOn(eTarFmt, tCIDImage::EPixFmts::Palette)
+        || (eTarDepth < tCIDImage::EBitDepths::Eight)
+    );
+    if (c4CY && !bNoFilter)
+    {
+        const tCIDLib::TCard4 c4BitsPer = TPixelArray::c4CalcBitsPerPixel(eTarFmt, eTarDepth);
+        FilterScanLines
+        (
+            mbufUncomp.pc1Data()
+            , (c4TarInd / c4CY) - 1
+            , c4BitsPer / 8
+            , c4CY
+        );
+    }
+
     //
     //  Set up the streams and compress the data to the caller's buffer. The
     //  calculated buffer size may be larger than what we actually used so
@@ -2010,7 +1909,9 @@ TPNGImage::c4StoreCompBuf(          THeapBuf&               mbufToFill
 
 //
 //  Does a reverse filter transformation of a scan line. The line is updated
-//  in place.
+//  in place. We just dispatch to the kernel instantiation for the pixel size.
+//  PNG only has the sizes below, so anything else cannot happen unless the
+//  header parsing let through a bad format.
 //
 tCIDLib::TVoid
 TPNGImage::DefilterScanLine(        tCIDLib::TCard1*    pc1Ln
@@ -2018,76 +1919,45 @@ TPNGImage::DefilterScanLine(        tCIDLib::TCard1*    pc1Ln
                             , const tCIDLib::TCard4     c4Back
                             , const tCIDLib::TCard4     c4LineInd)
 {
-    const tCIDLib::TCard1* pc1Prev = pc1Ln - c4LineBytes;
     const tCIDLib::TCard1 c1Filter = *pc1Ln++;
     if (!c1Filter)
         return;
 
-    //
-    //  We are filtered, so process the bytes in this line, doing
-    //  the filter operation on each byte.
-    //
-    for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4LineBytes; c4Ind++)
+    // The previous line's data, if there is one, is a line plus filter byte back
+    const tCIDLib::TCard1* pc1Prev = nullptr;
+    if (c4LineInd)
+        pc1Prev = pc1Ln - (c4LineBytes + 1);
+
+    switch(c4Back)
     {
-        switch(c1Filter)
-        {
-            case CIDPNG_Image::c1Filter_Sub :
-            {
-                // We do nothing for the first pixel's worth
-                if (c4Ind >= c4Back)
-                    *pc1Ln += tCIDLib::TCard1(*(pc1Ln - c4Back));
-                break;
-            }
+        case 1 :
+            UnfilterLine<1>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
 
-            case CIDPNG_Image::c1Filter_Up :
-            {
-                if (c4LineInd)
-                    *pc1Ln += *pc1Prev;
-                break;
-            }
+        case 2 :
+            UnfilterLine<2>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
 
-            case CIDPNG_Image::c1Filter_Avg :
-            {
-                tCIDLib::TCard2 c2Tmp = 0;
-                if (c4Ind >= c4Back)
-                    c2Tmp = *(pc1Ln - c4Back);
-                if (c4LineInd)
-                    c2Tmp += *pc1Prev;
-                *pc1Ln += tCIDLib::TCard1(c2Tmp >> 1);
-                break;
-            }
+        case 3 :
+            UnfilterLine<3>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
 
-            case CIDPNG_Image::c1Filter_Paeth :
-            {
-                tCIDLib::TCard4 c4Prev = 0;
-                tCIDLib::TCard4 c4Above = 0;
-                tCIDLib::TCard4 c4AbovePrev = 0;
-                if (c4Ind >= c4Back)
-                    c4Prev = *(pc1Ln - c4Back);
-                if (c4LineInd)
-                {
-                    if (c4Ind >= c4Back)
-                        c4AbovePrev = *(pc1Prev - c4Back);
-                    c4Above = *pc1Prev;
-                }
-                *pc1Ln = tCIDLib::TCard1
-                (
-                    tCIDLib::TCard4
-                    (
-                        *pc1Ln + c4PaethPredictor(c4Prev, c4Above, c4AbovePrev)
-                    )
-                );
-                break;
-            }
+        case 4 :
+            UnfilterLine<4>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
 
-            default :
-                break;
-        };
+        case 6 :
+            UnfilterLine<6>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
 
-        // Move both pointers up
-        pc1Ln++;
-        pc1Prev++;
-    }
+        case 8 :
+            UnfilterLine<8>(c1Filter, pc1Ln, pc1Prev, c4LineBytes);
+            break;
+
+        default :
+            CIDAssert2(L"Unsupported PNG pixel size");
+            break;
+    };
 }
 
 
@@ -128,7 +128,9 @@ namespace tCIDMacroEng
 #include    "CIDMacroEng_ClassManager.hpp"
 #include    "CIDMacroEng_CallStackItem.hpp"
 #include    "CIDMacroEng_DebugIntf.hpp"
+#include    "CIDMacroEng_Profiler.hpp"
 #include    "CIDMacroEng_StdClass.hpp"
+#include    "CIDMacroEng_ClassSet.hpp"
 #include    "CIDMacroEng_Engine.hpp"
 
 #include    "CIDMacroEng_FlowCtrlItem.hpp"
@@ -32,14 +32,22 @@
 //  Bring in any other facility headers that we only need internally.
 // ---------------------------------------------------------------------------
 #include    "CIDMath.hpp"
-#include    "CIDDBase.hpp"
 #include    "CIDCrypto.hpp"
 #include    "CIDEncode.hpp"
 #include    "CIDComm.hpp"
 #include    "CIDSock.hpp"
-#include    "CIDNet.hpp"
 #include    "CIDXML.hpp"
 
+//
+//  The database and HTTP/JSON classes depend on facilities that are only built
+//  for Windows at this point, so they are only included there.
+//
+#if defined(WIN32)
+#define     CIDMACROENG_NETDBCLASSES
+#include    "CIDDBase.hpp"
+#include    "CIDNet.hpp"
+#endif
+
 
 // ---------------------------------------------------------------------------
 //  Include our own public header and any internal headers we need
@@ -54,7 +62,6 @@
 #include    "CIDMacroEng_MD5Classes_.hpp"
 #include    "CIDMacroEng_SHA1Classes_.hpp"
 #include    "CIDMacroEng_SpeechClass_.hpp"
-#include    "CIDMacroEng_DBaseClasses_.hpp"
 #include    "CIDMacroEng_StringTokClass_.hpp"
 #include    "CIDMacroEng_SysInfoClass_.hpp"
 #include    "CIDMacroEng_FileSysClass_.hpp"
@@ -62,15 +69,19 @@
 #include    "CIDMacroEng_BinFileClass_.hpp"
 #include    "CIDMacroEng_USB_HID_.hpp"
 #include    "CIDMacroEng_NetClasses_.hpp"
-#include    "CIDMacroEng_AsyncHTTP_.hpp"
 #include    "CIDMacroEng_MPartMIME_.hpp"
-#include    "CIDMacroEng_JSONClasses_.hpp"
 #include    "CIDMacroEng_CommClasses_.hpp"
 #include    "CIDMacroEng_SockClasses_.hpp"
 #include    "CIDMacroEng_RandomClasses_.hpp"
 #include    "CIDMacroEng_XMLClasses_.hpp"
 #include    "CIDMacroEng_ZLib_.hpp"
 
+#if defined(CIDMACROENG_NETDBCLASSES)
+#include    "CIDMacroEng_DBaseClasses_.hpp"
+#include    "CIDMacroEng_AsyncHTTP_.hpp"
+#include    "CIDMacroEng_JSONClasses_.hpp"
+#endif
+
 
 // ---------------------------------------------------------------------------
 //  This is the intra-facilities constants namespace.
@@ -78,6 +89,13 @@
 namespace kCIDMacroEng_
 {
     const tCIDLib::TCh* const   pszNoParentClass = L"$NoParentClass$";
+
+
+    // -----------------------------------------------------------------------
+    //  The format version of the compiled class cache data. Bump this if the
+    //  cache format or the opcode set changes, so that old data is rejected.
+    // -----------------------------------------------------------------------
+    const tCIDLib::TCard1       c1CacheFmtVersion = 2;
 }
 
 
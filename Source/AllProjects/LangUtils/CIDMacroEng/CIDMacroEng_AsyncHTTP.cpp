@@ -32,6 +32,9 @@
 // ---------------------------------------------------------------------------
 #include    "CIDMacroEng_.hpp"
 
+// These are only available where the facilities they wrap are
+#if defined(CIDMACROENG_NETDBCLASSES)
+
 
 // ---------------------------------------------------------------------------
 //  Magic RTTI macros
@@ -679,3 +682,5 @@ TMEngAsyncHTTPClInfo::ThrowAnErr(       TCIDMacroEngine&    meOwner
     // And throw the excpetion that represents a macro level exception
     throw TExceptException();
 }
+
+#endif
@@ -55,6 +55,15 @@ MMEngClassMgr::~MMEngClassMgr()
 // ---------------------------------------------------------------------------
 //  MMEngClassMgr: Public, non-virtual methods
 // ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+MMEngClassMgr::bLoadCompiled(const  TString&            strClassPath
+                            ,       TMemBuf&            mbufToFill
+                            ,       tCIDLib::TCard4&    c4Bytes)
+{
+    return bDoLoadCompiled(strClassPath, mbufToFill, c4Bytes);
+}
+
+
 tCIDLib::TBoolean MMEngClassMgr::bMacroExists(const TString& strToCheck)
 {
     return bCheckIfExists(strToCheck);
@@ -97,6 +106,15 @@ MMEngClassMgr::StoreClass(  const   TString&                strClassPath
 }
 
 
+tCIDLib::TVoid
+MMEngClassMgr::StoreCompiled(const  TString&                strClassPath
+                            , const TMemBuf&                mbufData
+                            , const tCIDLib::TCard4         c4Bytes)
+{
+    DoStoreCompiled(strClassPath, mbufData, c4Bytes);
+}
+
+
 tCIDLib::TVoid MMEngClassMgr::UndoWriteMode(const TString& strClassPath)
 {
     //
@@ -116,6 +134,27 @@ MMEngClassMgr::MMEngClassMgr()
 }
 
 
+// ---------------------------------------------------------------------------
+//  MMEngClassMgr: Protected, virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Compiled class caching is optional, so these are not pure. By default we
+//  just say there's nothing cached and throw away anything we are given.
+//
+tCIDLib::TBoolean
+MMEngClassMgr::bDoLoadCompiled(const TString&, TMemBuf&, tCIDLib::TCard4& c4Bytes)
+{
+    c4Bytes = 0;
+    return kCIDLib::False;
+}
+
+tCIDLib::TVoid
+MMEngClassMgr::DoStoreCompiled(const TString&, const TMemBuf&, const tCIDLib::TCard4)
+{
+}
+
+
 
 // ---------------------------------------------------------------------------
 //  CLASS: TMEngFixedBaseClassMgr
@@ -162,24 +201,63 @@ const TString& TMEngFixedBaseClassMgr::strBasePath(const TString& strToSet)
 }
 
 
+const TString& TMEngFixedBaseClassMgr::strCachePath() const
+{
+    return m_strCachePath;
+}
+
+const TString& TMEngFixedBaseClassMgr::strCachePath(const TString& strToSet)
+{
+    m_strCachePath = strToSet;
+    return m_strCachePath;
+}
+
+
 // ---------------------------------------------------------------------------
 //  TMEngFixedBaseClassMgr: Private, inherited methods
 // ---------------------------------------------------------------------------
 tCIDLib::TBoolean
 TMEngFixedBaseClassMgr::bCheckIfExists(const TString& strToCheck)
 {
-    m_pathTmp1 = m_strBasePath;
-
-    // Get the path, cut off MEng, replace periods, and add an extension
-    m_pathTmp2 = strToCheck;
-    m_pathTmp2.Cut(0, 4);
-    m_pathTmp2.bReplaceChar(kCIDLib::chPeriod, L'\\');
-    m_pathTmp1.AddLevel(m_pathTmp2);
-    m_pathTmp1.AppendExt(L".mengc");
+    BuildPath(m_strBasePath, strToCheck, L".mengc");
     return TFileSys::bExists(m_pathTmp1);
 }
 
 
+//
+//  If we have a cache path, see if there's a compiled file for this class and
+//  read it in if so. The parser will decide if it's still good.
+//
+tCIDLib::TBoolean
+TMEngFixedBaseClassMgr::bDoLoadCompiled(const   TString&            strClassPath
+                                        ,       TMemBuf&            mbufToFill
+                                        ,       tCIDLib::TCard4&    c4Bytes)
+{
+    c4Bytes = 0;
+    if (m_strCachePath.bIsEmpty())
+        return kCIDLib::False;
+
+    BuildPath(m_strCachePath, strClassPath, L".mengx");
+    if (!TFileSys::bExists(m_pathTmp1))
+        return kCIDLib::False;
+
+    TBinaryFile flSrc(m_pathTmp1);
+    flSrc.Open
+    (
+        tCIDLib::EAccessModes::Read
+        , tCIDLib::ECreateActs::OpenIfExists
+        , tCIDLib::EFilePerms::Default
+        , tCIDLib::EFileFlags::SequentialScan
+    );
+    c4Bytes = tCIDLib::TCard4(flSrc.c8CurSize());
+    if (!c4Bytes)
+        return kCIDLib::False;
+
+    flSrc.c4ReadBuffer(mbufToFill, c4Bytes);
+    return kCIDLib::True;
+}
+
+
 tCIDLib::EOpenRes
 TMEngFixedBaseClassMgr::eDoSelect(TString&, const tCIDMacroEng::EResModes)
 {
@@ -193,14 +271,7 @@ TMEngFixedBaseClassMgr::DoStore(const   TString&    strClassPath
                                 , const TString&    strText)
 {
     // Build up the path to the classes hierarchy
-    m_pathTmp1 = m_strBasePath;
-
-    // Get the path, cut off MEng, replace periods, and add an extension
-    m_pathTmp2 = strClassPath;
-    m_pathTmp2.Cut(0, 4);
-    m_pathTmp2.bReplaceChar(kCIDLib::chPeriod, L'\\');
-    m_pathTmp1.AddLevel(m_pathTmp2);
-    m_pathTmp1.AppendExt(L".mengc");
+    BuildPath(m_strBasePath, strClassPath, L".mengc");
 
     //
     //  Create an output file stream for this file, always creating so that
@@ -230,6 +301,32 @@ TMEngFixedBaseClassMgr::DoStore(const   TString&    strClassPath
 }
 
 
+tCIDLib::TVoid
+TMEngFixedBaseClassMgr::DoStoreCompiled(const   TString&        strClassPath
+                                        , const TMemBuf&        mbufData
+                                        , const tCIDLib::TCard4 c4Bytes)
+{
+    if (m_strCachePath.bIsEmpty())
+        return;
+
+    // Make sure the directory is there, then write it out
+    BuildPath(m_strCachePath, strClassPath, L".mengx");
+    TString strDir;
+    if (m_pathTmp1.bQueryPath(strDir))
+        TFileSys::MakePath(strDir);
+
+    TBinaryFile flTar(m_pathTmp1);
+    flTar.Open
+    (
+        tCIDLib::EAccessModes::Excl_Write
+        , tCIDLib::ECreateActs::CreateAlways
+        , tCIDLib::EFilePerms::Default
+        , tCIDLib::EFileFlags::SequentialScan
+    );
+    flTar.c4WriteBuffer(mbufData, c4Bytes);
+}
+
+
 tCIDLib::TVoid
 TMEngFixedBaseClassMgr::DoUndoWriteMode(const TString&)
 {
@@ -242,14 +339,7 @@ TMEngFixedBaseClassMgr::pstrmDoLoad(const   TString&             strClassPath
                                     , const tCIDMacroEng::EResModes )
 {
     // Build up the path to the classes hierarchy
-    m_pathTmp1 = m_strBasePath;
-
-    // Get the path, cut off MEng, replace periods, and add an extension
-    m_pathTmp2 = strClassPath;
-    m_pathTmp2.Cut(0, 4);
-    m_pathTmp2.bReplaceChar(kCIDLib::chPeriod, L'\\');
-    m_pathTmp1.AddLevel(m_pathTmp2);
-    m_pathTmp1.AppendExt(L".mengc");
+    BuildPath(m_strBasePath, strClassPath, L".mengc");
 
     return new TTextFileInStream
     (
@@ -263,6 +353,29 @@ TMEngFixedBaseClassMgr::pstrmDoLoad(const   TString&             strClassPath
 }
 
 
+// ---------------------------------------------------------------------------
+//  TMEngFixedBaseClassMgr: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Builds up the file path for a class under the passed base path into the
+//  m_pathTmp1 member. We cut off the MEng part, and replace periods with path
+//  separators, then add the extension.
+//
+tCIDLib::TVoid
+TMEngFixedBaseClassMgr::BuildPath(  const   TString&            strBase
+                                    , const TString&            strClassPath
+                                    , const tCIDLib::TCh* const pszExt)
+{
+    m_pathTmp1 = strBase;
+    m_pathTmp2 = strClassPath;
+    m_pathTmp2.Cut(0, 4);
+    m_pathTmp2.bReplaceChar(kCIDLib::chPeriod, kCIDLib::chPathSep);
+    m_pathTmp1.AddLevel(m_pathTmp2);
+    m_pathTmp1.AppendExt(pszExt);
+}
+
+
 
 // ---------------------------------------------------------------------------
 //  CLASS: MMEngExtClassLoader
@@ -31,6 +31,12 @@
 //  selection, you have to derive yet again. But since many uses won't require
 //  selection, we want to let people use this class directly.
 //
+//  The parser can also ask the manager to store and load a compiled form of
+//  a class (and everything it pulled in), so that it doesn't have to parse
+//  it again if nothing has changed. The parser deals with the format and
+//  checking whether it's still valid, the manager just stores the bytes. By
+//  default this isn't supported, so derived classes have to opt in.
+//
 //  We also define an interface for loading 'internal' classes, i.e. those
 //  classes that don't need to be compiled because they are just wrappers
 //  around C++ classes. The standard runtime classes are of this type, and
@@ -74,6 +80,13 @@ class CIDMACROENGEXP MMEngClassMgr
         // -------------------------------------------------------------------
         //  Public, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bLoadCompiled
+        (
+            const   TString&                strClassPath
+            ,       TMemBuf&                mbufToFill
+            ,       tCIDLib::TCard4&        c4Bytes
+        );
+
         tCIDLib::TBoolean bMacroExists
         (
             const   TString&                strToCheck
@@ -97,6 +110,13 @@ class CIDMACROENGEXP MMEngClassMgr
             , const TString&                strText
         );
 
+        tCIDLib::TVoid StoreCompiled
+        (
+            const   TString&                strClassPath
+            , const TMemBuf&                mbufData
+            , const tCIDLib::TCard4         c4Bytes
+        );
+
         tCIDLib::TVoid UndoWriteMode
         (
             const   TString&                strClassPath
@@ -124,11 +144,25 @@ class CIDMACROENGEXP MMEngClassMgr
             , const TString&                strText
         ) = 0;
 
+        virtual tCIDLib::TBoolean bDoLoadCompiled
+        (
+            const   TString&                strClassPath
+            ,       TMemBuf&                mbufToFill
+            ,       tCIDLib::TCard4&        c4Bytes
+        );
+
         virtual tCIDLib::TVoid DoUndoWriteMode
         (
             const   TString&                strClassPath
         ) = 0;
 
+        virtual tCIDLib::TVoid DoStoreCompiled
+        (
+            const   TString&                strClassPath
+            , const TMemBuf&                mbufData
+            , const tCIDLib::TCard4         c4Bytes
+        );
+
         virtual tCIDLib::EOpenRes eDoSelect
         (
                     TString&                strToFill
@@ -189,6 +223,13 @@ class CIDMACROENGEXP TMEngFixedBaseClassMgr
             const   TString&                strToSet
         );
 
+        const TString& strCachePath() const;
+
+        const TString& strCachePath
+        (
+            const   TString&                strToSet
+        );
+
 
     protected :
         // -------------------------------------------------------------------
@@ -199,12 +240,26 @@ class CIDMACROENGEXP TMEngFixedBaseClassMgr
             const   TString&                strToCheck
         )   override;
 
+        tCIDLib::TBoolean bDoLoadCompiled
+        (
+            const   TString&                strClassPath
+            ,       TMemBuf&                mbufToFill
+            ,       tCIDLib::TCard4&        c4Bytes
+        )   override;
+
         tCIDLib::TVoid DoStore
         (
             const   TString&                strClassPath
             , const TString&                strText
         )   override;
 
+        tCIDLib::TVoid DoStoreCompiled
+        (
+            const   TString&                strClassPath
+            , const TMemBuf&                mbufData
+            , const tCIDLib::TCard4         c4Bytes
+        )   override;
+
         tCIDLib::TVoid DoUndoWriteMode
         (
             const   TString&                strClassPath
@@ -224,6 +279,17 @@ class CIDMACROENGEXP TMEngFixedBaseClassMgr
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid BuildPath
+        (
+            const   TString&                strBase
+            , const TString&                strClassPath
+            , const tCIDLib::TCh* const     pszExt
+        );
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -236,10 +302,16 @@ class CIDMACROENGEXP TMEngFixedBaseClassMgr
         //
         //  m_strBasePath
         //      This is the base path to which class paths are appended.
+        //
+        //  m_strCachePath
+        //      The base path under which compiled class data is stored, using
+        //      the same hierarchy as the source. If empty, which is the default,
+        //      we don't do any caching.
         // -------------------------------------------------------------------
         TPathStr    m_pathTmp1;
         TPathStr    m_pathTmp2;
         TString     m_strBasePath;
+        TString     m_strCachePath;
 
 
         // -------------------------------------------------------------------
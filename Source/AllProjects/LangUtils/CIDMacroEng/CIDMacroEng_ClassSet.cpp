@@ -0,0 +1,98 @@
+//
+// FILE NAME: CIDMacroEng_ClassSet.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TMEngClassSet class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDMacroEng_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TMEngClassSet,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TMEngClassSet
+// PREFIX: mecs
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TMEngClassSet: Destructor
+// ---------------------------------------------------------------------------
+TMEngClassSet::~TMEngClassSet()
+{
+    //
+    //  Delete the classes in the reverse order they were added, since the
+    //  later ones can refer to earlier ones. Our parent is released after
+    //  this, so its classes outlive ours.
+    //
+    tCIDLib::TCard4 c4Index = m_colClasses.c4ElemCount();
+    while (c4Index)
+    {
+        c4Index--;
+        m_colClasses.RemoveAt(c4Index);
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMEngClassSet: Private constructors
+// ---------------------------------------------------------------------------
+
+//
+//  The caller passes us the classes to adopt, which must be in id order and
+//  have ids that start right after the last one of the parent set. We check
+//  them all before we take any, and the list is pre-sized, so we won't
+//  fail once we start adopting them.
+//
+TMEngClassSet::TMEngClassSet(const  TPtr&                       cptrParent
+                            , const TRefVector<TMEngClassInfo>& colToAdopt
+                            , const tCIDLib::TCard2             c2ArrayId
+                            , const tCIDLib::TCard2             c2VectorId) :
+
+    m_c2ArrayId(c2ArrayId)
+    , m_c2VectorId(c2VectorId)
+    , m_c4FirstId(cptrParent ? cptrParent->c4Count() : 0)
+    , m_colClasses(tCIDLib::EAdoptOpts::Adopt, colToAdopt.c4ElemCount())
+    , m_cptrParent(cptrParent)
+{
+    const tCIDLib::TCard4 c4Count = colToAdopt.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        CIDAssert
+        (
+            colToAdopt[c4Index]->c2Id() == m_c4FirstId + c4Index
+            , L"Classes added to a CML class set are not in id order"
+        );
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        m_colClasses.Add(const_cast<TMEngClassInfo*>(colToAdopt[c4Index]));
+}
@@ -0,0 +1,167 @@
+//
+// FILE NAME: CIDMacroEng_ClassSet.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDMacroEng_ClassSet.cpp file, which implements
+//  the TMEngClassSet class. A class set is an immutable, shareable set of
+//  class info objects (and, via them, their method info and compiled opcodes.)
+//  Engines reference these via a counted pointer and so any number of engines
+//  can use the same class info objects, with only their per-run state (the
+//  call stack, the temp pool, the values of the objects they create) being
+//  per-engine.
+//
+//  Sets are layered. There is a single, process wide, set of the built in
+//  classes, which is created by the first engine that is created. All
+//  engines use it. And an engine can share the classes it has loaded above
+//  those (i.e. the classes of a parsed macro) via a new set whose parent is
+//  the one it was already using. Other engines can then use that set and
+//  run the macro without having to parse it.
+//
+//  Class ids are indices into the engine's by id list, and the classes in a
+//  set have the same ids in all the engines that use it. So the classes of
+//  each set start at the id past the last one of its parent.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Only the engine can create these. Once created, nothing in them can
+//      be changed. It's on the class info derivatives to not modify their
+//      members at runtime, since they can be in use by multiple threads.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//  CLASS: TMEngClassSet
+// PREFIX: mecs
+// ---------------------------------------------------------------------------
+class CIDMACROENGEXP TMEngClassSet : public TObject
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public class types
+        // -------------------------------------------------------------------
+        using TPtr = TCntPtr<TMEngClassSet>;
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMEngClassSet() = delete;
+
+        TMEngClassSet(const TMEngClassSet&) = delete;
+
+        ~TMEngClassSet();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMEngClassSet& operator=(const TMEngClassSet&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsBuiltIns() const
+        {
+            return !m_cptrParent;
+        }
+
+        tCIDLib::TCard2 c2ArrayId() const
+        {
+            return m_c2ArrayId;
+        }
+
+        tCIDLib::TCard2 c2VectorId() const
+        {
+            return m_c2VectorId;
+        }
+
+        tCIDLib::TCard4 c4Count() const
+        {
+            return m_c4FirstId + m_colClasses.c4ElemCount();
+        }
+
+        tCIDLib::TCard4 c4FirstId() const
+        {
+            return m_c4FirstId;
+        }
+
+        const TPtr& cptrParent() const
+        {
+            return m_cptrParent;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  The engine is the only one who can create these
+        // -------------------------------------------------------------------
+        friend class TCIDMacroEngine;
+
+
+        // -------------------------------------------------------------------
+        //  Private constructors
+        // -------------------------------------------------------------------
+        TMEngClassSet
+        (
+            const   TPtr&                   cptrParent
+            , const TRefVector<TMEngClassInfo>& colToAdopt
+            , const tCIDLib::TCard2         c2ArrayId
+            , const tCIDLib::TCard2         c2VectorId
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c2ArrayId
+        //  m_c2VectorId
+        //      The ids of the built in collection classes, which the engine
+        //      needs. These are the same for all sets.
+        //
+        //  m_c4FirstId
+        //      The id of our first class, which is the count of classes in
+        //      our parent set (and its parents.)
+        //
+        //  m_colClasses
+        //      The classes in this set, in id order. We own them.
+        //
+        //  m_cptrParent
+        //      The set our classes are layered on, or null if we are the built
+        //      in set. We keep it alive as long as we are alive, since our
+        //      classes refer to those in it.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard2             m_c2ArrayId;
+        tCIDLib::TCard2             m_c2VectorId;
+        tCIDLib::TCard4             m_c4FirstId;
+        TRefVector<TMEngClassInfo>  m_colClasses;
+        TPtr                        m_cptrParent;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TMEngClassSet,TObject)
+};
+
+#pragma CIDLIB_POPPACK
@@ -30,6 +30,9 @@
 // ---------------------------------------------------------------------------
 #include    "CIDMacroEng_.hpp"
 
+// These are only available where the facilities they wrap are
+#if defined(CIDMACROENG_NETDBCLASSES)
+
 
 // ---------------------------------------------------------------------------
 //  Magic RTTI macros
@@ -1442,4 +1445,4 @@ TMEngDBStmtInfo::ThrowAnErr(        TCIDMacroEngine&    meOwner
     throw TExceptException();
 }
 
-
+#endif
@@ -51,6 +51,16 @@ namespace
         TAtomicFlag         atomInitDone;
 
 
+        // -----------------------------------------------------------------------
+        //  The shared set of built in classes. The first engine created builds
+        //  them and all engines after that just reference them. Once the flag is
+        //  set, the pointer can be read without sync. They live for the life of
+        //  the process.
+        // -----------------------------------------------------------------------
+        TAtomicFlag             atomBuiltInsDone;
+        TMEngClassSet::TPtr*    pcptrBuiltIns = nullptr;
+
+
         // -----------------------------------------------------------------------
         //  Some stats cache items we maintain
         // -----------------------------------------------------------------------
@@ -112,6 +122,7 @@ TCIDMacroEngine::TCIDMacroEngine() :
 
     m_bDebugMode(kCIDLib::False)
     , m_bInIDE(kCIDLib::False)
+    , m_bProfiling(kCIDLib::False)
     , m_bValidation(kCIDLib::False)
     , m_c2ArrayId(kCIDMacroEng::c2BadId)
     , m_c2NextClassId(0)
@@ -127,13 +138,14 @@ TCIDMacroEngine::TCIDMacroEngine() :
         , TStringKeyOps()
         , &TMEngClassInfo::strKey
       )
-    , m_colClassesById(tCIDLib::EAdoptOpts::Adopt, 128)
+    , m_colClassesById(tCIDLib::EAdoptOpts::NoAdopt, 128)
     , m_colTempPool(32)
     , m_eExceptReport(tCIDMacroEng::EExceptReps::NotHandled)
     , m_pcuctxRights(nullptr)
     , m_pmedbgToUse(nullptr)
     , m_pmeehToUse(nullptr)
     , m_pmefrToUse(nullptr)
+    , m_pmeprfData(nullptr)
     , m_pmecvThrown(nullptr)
     , m_pstrmConsole(nullptr)
 {
@@ -157,10 +169,10 @@ TCIDMacroEngine::TCIDMacroEngine() :
     }
 
     //
-    //  Register the small number of instrinc classes that are always
-    //  available without being asked for.
+    //  Load the small number of instrinc classes that are always available
+    //  without being asked for. These are shared by all engines.
     //
-    RegisterBuiltInClasses();
+    LoadBuiltInClasses();
 
     // Increment the count of registered engines
     TStatsCache::c8IncCounter(CIDMacroEng_Engine::sciMacroEngCount);
@@ -188,6 +200,7 @@ TCIDMacroEngine::~TCIDMacroEngine()
         //  the console stream.
         //
         delete m_pmecvThrown;
+        delete m_pmeprfData;
     }
 
     catch(TError& errToCatch)
@@ -435,13 +448,16 @@ TCIDMacroEngine::bInvokeDefCtor(        TMEngClassVal&      mecvTarget
         //
         PushPoolValue(tCIDMacroEng::EIntrinsics::Void, tCIDMacroEng::EConstTypes::Const);
         meciPushMethodCall(meciTarget.c2Id(), pmethiDefCtor->c2Id());
-        meciTarget.Invoke
-        (
-            *this
-            , mecvTarget
-            , pmethiDefCtor->c2Id()
-            , tCIDMacroEng::EDispatch::Mono
-        );
+        {
+            TMEngProfJanitor janProfile(pmeprfActive(), meciTarget.c2Id(), pmethiDefCtor->c2Id());
+            meciTarget.Invoke
+            (
+                *this
+                , mecvTarget
+                , pmethiDefCtor->c2Id()
+                , tCIDMacroEng::EDispatch::Mono
+            );
+        }
 
         // We have to pop the method call and return off
         MultiPop(2);
@@ -565,6 +581,19 @@ TCIDMacroEngine::bIsLiteralClass(const tCIDLib::TCard2 c2IdToCheck) const
 }
 
 
+//
+//  Turn profiling on or off. This can be done while a macro is running. We
+//  fault in the profiler the first time it's enabled.
+//
+tCIDLib::TBoolean TCIDMacroEngine::bProfiling(const tCIDLib::TBoolean bToSet)
+{
+    if (bToSet && !m_pmeprfData)
+        m_pmeprfData = new TMEngProfiler();
+    m_bProfiling = bToSet;
+    return m_bProfiling;
+}
+
+
 tCIDLib::TBoolean
 TCIDMacroEngine::bStackValAt(const  tCIDLib::TCard4     c4Index
                             , const tCIDLib::TBoolean   bCheckType) const
@@ -921,6 +950,45 @@ TCIDMacroEngine::colStackValAt( const   tCIDLib::TCard4     c4Index
 }
 
 
+//
+//  Moves the classes we've loaded above the shared ones we are using (i.e.
+//  those of the last parsed macro) into a new shared set, which we then use
+//  ourself, and return it. Other engines can pass it to UseClassSet() to run
+//  the same macro without parsing it. If we have none of our own, we just
+//  return the set we are already using.
+//
+TMEngClassSet::TPtr TCIDMacroEngine::cptrShareClasses()
+{
+    if (m_c4CallStackTop)
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcEng_ClassSetBusy
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Busy
+        );
+    }
+
+    const tCIDLib::TCard4 c4First = m_cptrClassSet->c4Count();
+    const tCIDLib::TCard4 c4Count = m_colClassesById.c4ElemCount();
+    if (c4First == c4Count)
+        return m_cptrClassSet;
+
+    TClassIdList colNew(tCIDLib::EAdoptOpts::NoAdopt, c4Count - c4First);
+    for (tCIDLib::TCard4 c4Index = c4First; c4Index < c4Count; c4Index++)
+        colNew.Add(m_colClassesById[c4Index]);
+
+    // The new set now owns them, and we just reference them like the others
+    m_cptrClassSet = TMEngClassSet::TPtr
+    (
+        new TMEngClassSet(m_cptrClassSet, colNew, m_c2ArrayId, m_c2VectorId)
+    );
+    return m_cptrClassSet;
+}
+
+
 //
 //  Provide access to any user rights context that the user code may have set
 //  on us. We don't care what it is, it's purely a passthrough for user code.
@@ -1093,44 +1161,44 @@ TCIDMacroEngine::Cleanup(const tCIDLib::TBoolean bRemoveBuiltIns)
         // We flush the by name list either way
         m_colClasses.RemoveAll();
 
-        if (bRemoveBuiltIns)
+        //
+        //  Delete the classes we own, which are any past the ones in the shared
+        //  set we are using. Go backwards, since later ones can refer to earlier
+        //  ones, and to avoid recompaction every time.
+        //
+        const tCIDLib::TCard4 c4SharedCnt = m_cptrClassSet ? m_cptrClassSet->c4Count() : 0;
+        tCIDLib::TCard4 c4Index = m_colClassesById.c4ElemCount();
+        while (c4Index > c4SharedCnt)
         {
-            // And we are doing them all so just whack the by id list, too
-            m_colClassesById.RemoveAll();
+            c4Index--;
+            TMEngClassInfo* pmeciKill = m_colClassesById[c4Index];
+            m_colClassesById.RemoveAt(c4Index);
+            delete pmeciKill;
         }
-         else if (m_colClassesById.bIsEmpty())
+
+        if (bRemoveBuiltIns)
         {
-            // Built ins are already removed, make sure the by name list is clean
-            m_colClasses.RemoveAll();
+            // We are doing them all so drop the shared ones as well
+            m_colClassesById.RemoveAll();
+            m_cptrClassSet.DropRef();
         }
-         else
+         else if (m_cptrClassSet && !m_cptrClassSet->bIsBuiltIns())
         {
             //
-            //  The array id that we use as the last built in id has to be
-            //  beyond the last of the intrinsic ids. So sanity check that.
+            //  We are using a set shared from another engine, so drop back to
+            //  just the built in classes, which are always first.
             //
-            CIDAssert
-            (
-                m_c2ArrayId >= tCIDLib::TCard2(tCIDMacroEng::EIntrinsics::Count)
-                , L"Invalid array id in CML engine cleanup"
-            );
-
-            //
-            //  We have to leave the built ins. The most efficent way
-            //  to do this is to delete all of the ones from the by id
-            //  list that are past the last built in id. Then just go
-            //  back and add the remaining ones back to the by name
-            //  list again. Go backwards to avoid recompaction every time.
-            //
-            tCIDLib::TCard4 c4Index = m_colClassesById.c4ElemCount() - 1;
-            const tCIDLib::TCard4 c4Last = m_c2ArrayId;
-            while (c4Index > c4Last)
-                m_colClassesById.RemoveAt(c4Index--);
-
-            // Ok, now add the ones left back
-            for (c4Index = 0; c4Index <= c4Last; c4Index++)
-                m_colClasses.Add(m_colClassesById[c4Index]);
+            const TMEngClassSet::TPtr& cptrBuiltIns = *CIDMacroEng_Engine::pcptrBuiltIns;
+            const tCIDLib::TCard4 c4BuiltInCnt = cptrBuiltIns->c4Count();
+            while (c4Index > c4BuiltInCnt)
+                m_colClassesById.RemoveAt(--c4Index);
+            m_cptrClassSet = cptrBuiltIns;
         }
+
+        // Ok, now add the ones left back to the by name list
+        const tCIDLib::TCard4 c4Count = m_colClassesById.c4ElemCount();
+        for (c4Index = 0; c4Index < c4Count; c4Index++)
+            m_colClasses.Add(m_colClassesById[c4Index]);
     }
 
     catch(TError& errToCatch)
@@ -1772,7 +1840,10 @@ TCIDMacroEngine::i4Run(         TMEngClassVal&      mecvTarget
         //  call item and parms off when we get back. We can do monomorphic dispatch
         //  here since we know the target class has the method.
         //
-        meciTarget.Invoke(*this, mecvTarget, c2MethodId, tCIDMacroEng::EDispatch::Mono);
+        {
+            TMEngProfJanitor janProfile(pmeprfActive(), meciTarget.c2Id(), c2MethodId);
+            meciTarget.Invoke(*this, mecvTarget, c2MethodId, tCIDMacroEng::EDispatch::Mono);
+        }
         MultiPop(c4ParmCount + 1);
 
         #if CID_DEBUG_ON
@@ -2070,6 +2141,15 @@ TMEngClassVal& TCIDMacroEngine::mecvStackAtTop()
 }
 
 
+// Get access to the profiling data, faulting in the profiler if needed
+TMEngProfiler& TCIDMacroEngine::meprfData()
+{
+    if (!m_pmeprfData)
+        m_pmeprfData = new TMEngProfiler();
+    return *m_pmeprfData;
+}
+
+
 //
 //  Provide access to any user rights context that the user code may have set
 //  on us. We don't care what it is, it's purely a passthrough for user code.
@@ -2873,11 +2953,15 @@ tCIDLib::TVoid TCIDMacroEngine::Reset()
     m_c4CurLine = 0;
     m_c4CallStackTop = 0;
 
+    // The profiling data is by class id, so it's no good anymore
+    if (m_pmeprfData)
+        m_pmeprfData->Reset();
+
     //
     //  Set this to the next available one after the builtins, because we
     //  didn't remove those!!!
     //
-    m_c2NextClassId = m_c2ArrayId + 1;
+    m_c2NextClassId = tCIDLib::TCard2(m_colClassesById.c4ElemCount());
 }
 
 
@@ -3066,6 +3150,38 @@ tCIDLib::TVoid TCIDMacroEngine::UnknownException()
 }
 
 
+//
+//  Resets us and then loads up the classes of a set shared from another engine
+//  (see cptrShareClasses()), so that we are ready to run that macro. The ids
+//  are the same as in the engine that shared them, so the caller can look up
+//  the main class by path and go from there.
+//
+tCIDLib::TVoid
+TCIDMacroEngine::UseClassSet(const TMEngClassSet::TPtr& cptrToUse)
+{
+    if (m_c4CallStackTop)
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcEng_ClassSetBusy
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Busy
+        );
+    }
+
+    //
+    //  This gets us back to just the built ins, which every set is layered on.
+    //  Then load the rest of the set's classes, and remember we are using it.
+    //
+    Reset();
+    LoadClassSet(*const_cast<TMEngClassSet*>(cptrToUse.pobjData()));
+    m_cptrClassSet = cptrToUse;
+    m_c2NextClassId = tCIDLib::TCard2(m_colClassesById.c4ElemCount());
+}
+
+
 tCIDLib::TVoid
 TCIDMacroEngine::ValidateCallFrame( const   TMEngClassVal&  mecvInstance
                                     , const tCIDLib::TCard2 c2MethodId) const
@@ -3363,6 +3479,71 @@ tCIDLib::TVoid TCIDMacroEngine::InitTempPool()
 }
 
 
+//
+//  Called from the ctor to get the built in classes loaded. If the shared set
+//  of them has not been created yet, we register them ourself and then make
+//  them the shared set. If someone else beats us to it, we just drop ours and
+//  use theirs.
+//
+tCIDLib::TVoid TCIDMacroEngine::LoadBuiltInClasses()
+{
+    if (!CIDMacroEng_Engine::atomBuiltInsDone)
+    {
+        RegisterBuiltInClasses();
+
+        TBaseLock lockInit;
+        if (!CIDMacroEng_Engine::atomBuiltInsDone)
+        {
+            CIDMacroEng_Engine::pcptrBuiltIns = new TMEngClassSet::TPtr
+            (
+                new TMEngClassSet
+                (
+                    TMEngClassSet::TPtr(), m_colClassesById, m_c2ArrayId, m_c2VectorId
+                )
+            );
+            m_cptrClassSet = *CIDMacroEng_Engine::pcptrBuiltIns;
+            CIDMacroEng_Engine::atomBuiltInsDone.Set();
+            return;
+        }
+
+        // We lost, so delete ours
+        Cleanup(kCIDLib::True);
+    }
+
+    TMEngClassSet& mecsBuiltIns = *CIDMacroEng_Engine::pcptrBuiltIns->pobjData();
+    LoadClassSet(mecsBuiltIns);
+    m_cptrClassSet = *CIDMacroEng_Engine::pcptrBuiltIns;
+    m_c2ArrayId = mecsBuiltIns.c2ArrayId();
+    m_c2VectorId = mecsBuiltIns.c2VectorId();
+    m_c2NextClassId = tCIDLib::TCard2(m_colClassesById.c4ElemCount());
+}
+
+
+//
+//  Adds the classes of the passed set to our lists, after those of its parent
+//  sets. Any that we already have (the built ins always) are skipped. The
+//  classes are shared, so we don't own them, and they must not be modified.
+//  We only use them non-const because the runtime does.
+//
+tCIDLib::TVoid TCIDMacroEngine::LoadClassSet(TMEngClassSet& mecsSrc)
+{
+    if (mecsSrc.m_cptrParent)
+        LoadClassSet(*mecsSrc.m_cptrParent);
+
+    const tCIDLib::TCard4 c4Have = m_colClassesById.c4ElemCount();
+    const tCIDLib::TCard4 c4Count = mecsSrc.m_colClasses.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        if (mecsSrc.m_c4FirstId + c4Index < c4Have)
+            continue;
+
+        TMEngClassInfo* pmeciCur = mecsSrc.m_colClasses[c4Index];
+        m_colClassesById.Add(pmeciCur);
+        m_colClasses.Add(pmeciCur);
+    }
+}
+
+
 //
 //  These two methods provide a temp pool that is used by the methods above
 //  that allow the caller to push temps onto the stack. The first one takes
@@ -3603,10 +3784,8 @@ tCIDLib::TVoid TCIDMacroEngine::RegisterBuiltInClasses()
 
 
     //
-    //  !!!! Make sure this one is last. The Cleanup() method uses this
-    //  one's id to know where the built in classes end, so that it can
-    //  remove all per-invocation classes but leave the built in ones
-    //  alone.
+    //  !!!! Make sure this one is last. Its id marks the end of the built
+    //  in classes, which are shared by all engines.
     //
     pmeciCol = new TMEngArrayInfo
     (
@@ -179,6 +179,16 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
             , const tCIDLib::TBoolean       bCheckType = kCIDLib::False
         )   const;
 
+        tCIDLib::TBoolean bProfiling() const
+        {
+            return m_bProfiling;
+        }
+
+        tCIDLib::TBoolean bProfiling
+        (
+            const   tCIDLib::TBoolean       bToSet
+        );
+
         tCIDLib::TBoolean bValidation() const
         {
             return m_bValidation;
@@ -290,6 +300,8 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
             , const tCIDLib::TBoolean       bCheckType = kCIDLib::False
         )   const;
 
+        TMEngClassSet::TPtr cptrShareClasses();
+
         const TCIDUserCtx& cuctxRights() const;
 
         tCIDLib::TVoid CheckIDEReq();
@@ -502,6 +514,8 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
 
         TMEngClassVal& mecvStackAtTop();
 
+        TMEngProfiler& meprfData();
+
         template <typename T> const T& mecvStackAtTopAs() const
         {
             return static_cast<const T&>(mecvStackAtTop());
@@ -560,6 +574,11 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
             return m_pmedbgToUse;
         }
 
+        TMEngProfiler* pmeprfActive() const
+        {
+            return m_bProfiling ? m_pmeprfData : nullptr;
+        }
+
         TMEngCallStackItem* pmecsiMostRecentCall
         (
                     tCIDLib::TCard4&        c4ToFill
@@ -794,6 +813,11 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
 
         tCIDLib::TVoid UnknownException();
 
+        tCIDLib::TVoid UseClassSet
+        (
+            const   TMEngClassSet::TPtr&    cptrToUse
+        );
+
         tCIDLib::TVoid ValidateCallFrame
         (
             const   TMEngClassVal&          mecvInstance
@@ -881,6 +905,13 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
 
         tCIDLib::TVoid InitTempPool();
 
+        tCIDLib::TVoid LoadBuiltInClasses();
+
+        tCIDLib::TVoid LoadClassSet
+        (
+                    TMEngClassSet&          mecsSrc
+        );
+
         TMEngClassVal* pmecvGet
         (
             const   tCIDLib::TCard2         c2ClassId
@@ -922,26 +953,27 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
         //      The IDE will set this flag, which lets us do some things differently
         //      than we would when running normally.
         //
+        //  m_bProfiling
+        //  m_pmeprfData
+        //      When profiling is on, the method impls report calls and opcodes
+        //      to the profiler object. It's faulted in when profiling is first
+        //      enabled, and the data is kept when it's disabled again, so that
+        //      it can be looked at. It's cleared when we are reset.
+        //
         //  m_bValidation
         //      This can be set to make the engine do stack checks. Normally they
         //      aren't done because of the overhead.
         //
         //  m_c2NextClassId
         //      This is used to stamp classes that are added to this instance of the
-        //      engine. Initially it's set to zero. As long as we keep the built in
-        //      classes around for subsequent invocations, the Reset() method will set
-        //      it to the next available id after the built in ones, so per-invocation
-        //      ids start from there.
+        //      engine. The Reset() method sets it to the next available id after the
+        //      shared built in ones, so per-invocation ids start from there.
         //
         //  m_c2ArrayId
         //  m_c2VectorId
-        //      For later checks, we store the class ids of the collection classes
-        //      when we register them. Note that the array id is the last of the pre-
-        //      setup classes that are always there. Any others only get loaded if the
-        //      parsed CML uses them. So, the Cleanup() method, if told not to remove
-        //      intrinsics, will remove any classes with a class id higher tahn the
-        //      array class id. That will leave all of the fundamental classes in place
-        //      so that we don't have to constantly reload them.
+        //      For later checks, we store the class ids of the collection classes.
+        //      They are part of the built in class set. Note that the array id is
+        //      the last of the pre-setup classes that are always there.
         //
         //  m_c4CallStackTop
         //      This is the top of stack index for the call stack. The vector
@@ -972,16 +1004,21 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
         //      This is a collection of classes which have been registered with this
         //      engine instance. It will always include the built in classes, and will
         //      have at least one main class that implements the user's macro code, and
-        //      that class will typically import other classes. This one is non-adopting,
-        //      and the by=id one below actually owns them.
+        //      that class will typically import other classes. This one is non-adopting.
         //
         //  m_colClassesById
         //      We have to have fast lookup by name for name resolution during the
         //      parse, but we need fast lookup by id during runtime, since the resolved
         //      ids are used. So, we have a separate vector for that. Since we assign
         //      ids as ascending indices, by just putting them on the vector as they
-        //      arrive, we create a by id lookup. This one owns the objects, not the by
-        //      name one, for performance reasons, see the Cleanup method.
+        //      arrive, we create a by id lookup. This one is non-adopting as well. The
+        //      ones up to the count of m_cptrClassSet are shared, and we own the ones
+        //      after that, see the Cleanup method.
+        //
+        //  m_cptrClassSet
+        //      The shared, immutable classes that we are using. This is always at least
+        //      the process wide set of built in classes, but can be a set shared from
+        //      another engine, see UseClassSet().
         //
         //  m_colCallStack
         //      This is the call stack. Return value storage, parameters, and
@@ -1032,6 +1069,7 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
         // -------------------------------------------------------------------
         tCIDLib::TBoolean           m_bInIDE;
         tCIDLib::TBoolean           m_bDebugMode;
+        tCIDLib::TBoolean           m_bProfiling;
         tCIDLib::TBoolean           m_bValidation;
         tCIDLib::TCard2             m_c2ArrayId;
         tCIDLib::TCard2             m_c2NextClassId;
@@ -1042,12 +1080,14 @@ class CIDMACROENGEXP TCIDMacroEngine : public TObject
         TCallStack                  m_colCallStack;
         TClassList                  m_colClasses;
         TClassIdList                m_colClassesById;
+        TMEngClassSet::TPtr         m_cptrClassSet;
         TTempPool                   m_colTempPool;
         tCIDMacroEng::EExceptReps   m_eExceptReport;
         const TCIDUserCtx*          m_pcuctxRights;
         MMEngDebugIntf*             m_pmedbgToUse;
         MMEngErrHandler*            m_pmeehToUse;
         MMEngFileResolver*          m_pmefrToUse;
+        TMEngProfiler*              m_pmeprfData;
         TMEngExceptVal*             m_pmecvThrown;
         TTextOutStream*             m_pstrmConsole;
         TString                     m_strSpecialDynRef;
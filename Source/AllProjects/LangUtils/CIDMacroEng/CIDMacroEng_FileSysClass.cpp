@@ -260,6 +260,13 @@ TMEngDirIterInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
     TDirIter& diterThis = mecvActual.diterValue();
     TFindBuf& fndbTmp = mecvActual.fndbTmp();
 
+    //
+    //  Class info is shared by engines that share classes, so our scratch
+    //  paths have to be locals.
+    //
+    TPathStr pathExpand1;
+    TPathStr pathExpand2;
+
     if (methiTarget.c2Id() == m_c2MethId_DefCtor)
     {
         // Just reset the object
@@ -271,7 +278,7 @@ TMEngDirIterInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         try
         {
             // Expand out the CML level path to a real path
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
 
             // Set up the search flags
             const tCIDLib::TBoolean bFilesOnly = meOwner.bStackValAt(c4FirstInd + 2);
@@ -293,16 +300,16 @@ TMEngDirIterInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
             }
 
             const TString& strWC = meOwner.strStackValAt(c4FirstInd + 1);
-            if (diterThis.bFindFirst(m_pathExpand1, strWC, fndbTmp, eFlags))
+            if (diterThis.bFindFirst(pathExpand1, strWC, fndbTmp, eFlags))
             {
-                meOwner.ContractFilePath(fndbTmp.pathFileName(), m_pathExpand2);
+                meOwner.ContractFilePath(fndbTmp.pathFileName(), pathExpand2);
 
                 // Return the info
                 TMEngStringVal& mecvPath = meOwner.mecvStackAtAs<TMEngStringVal>(c4FirstInd + 4);
                 TMEngCard8Val& mecvSize = meOwner.mecvStackAtAs<TMEngCard8Val>(c4FirstInd + 5);
                 TMEngBooleanVal& mecvIsFile = meOwner.mecvStackAtAs<TMEngBooleanVal>(c4FirstInd + 6);
 
-                mecvPath.strValue(m_pathExpand2);
+                mecvPath.strValue(pathExpand2);
                 mecvSize.c8Value(fndbTmp.c8Size());
                 mecvIsFile.bValue(fndbTmp.bIsFile());
 
@@ -326,14 +333,14 @@ TMEngDirIterInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         {
             if (diterThis.bFindNext(fndbTmp))
             {
-                meOwner.ContractFilePath(fndbTmp.pathFileName(), m_pathExpand1);
+                meOwner.ContractFilePath(fndbTmp.pathFileName(), pathExpand1);
 
                 // Return the info
                 TMEngStringVal& mecvPath = meOwner.mecvStackAtAs<TMEngStringVal>(c4FirstInd);
                 TMEngCard8Val& mecvSize = meOwner.mecvStackAtAs<TMEngCard8Val>(c4FirstInd + 1);
                 TMEngBooleanVal& mecvIsFile = meOwner.mecvStackAtAs<TMEngBooleanVal>(c4FirstInd + 2);
 
-                mecvPath.strValue(m_pathExpand1);
+                mecvPath.strValue(pathExpand1);
                 mecvSize.c8Value(fndbTmp.c8Size());
                 mecvIsFile.bValue(fndbTmp.bIsFile());
 
@@ -729,13 +736,20 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
 {
     const tCIDLib::TCard4 c4FirstInd = meOwner.c4FirstParmInd(methiTarget);
 
+    //
+    //  Class info is shared by engines that share classes, so our scratch
+    //  paths have to be locals.
+    //
+    TPathStr pathExpand1;
+    TPathStr pathExpand2;
+
     if (methiTarget.c2Id() == m_c2MethId_CopyFile)
     {
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd + 1), m_pathExpand2);
-            TFileSys::CopyFile(m_pathExpand1, m_pathExpand2);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd + 1), pathExpand2);
+            TFileSys::CopyFile(pathExpand1, pathExpand2);
         }
 
         catch(TError& errToCatch)
@@ -751,8 +765,8 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
     {
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
-            TFileSys::DeleteFile(m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
+            TFileSys::DeleteFile(pathExpand1);
         }
 
         catch(TError& errToCatch)
@@ -765,12 +779,12 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         TMEngBooleanVal& mecvRet = meOwner.mecvStackAtAs<TMEngBooleanVal>(c4FirstInd - 1);
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
             mecvRet.bValue
             (
                 TFileSys::bExists
                 (
-                    m_pathExpand1
+                    pathExpand1
                     , meOwner.bStackValAt(c4FirstInd + 1) ? tCIDLib::EDirSearchFlags::NormalDirs
                                                           : tCIDLib::EDirSearchFlags::AllDirs
                 )
@@ -787,12 +801,12 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         TMEngBooleanVal& mecvRet = meOwner.mecvStackAtAs<TMEngBooleanVal>(c4FirstInd - 1);
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
             mecvRet.bValue
             (
                 TFileSys::bExists
                 (
-                    m_pathExpand1
+                    pathExpand1
                     , meOwner.bStackValAt(c4FirstInd + 1) ? tCIDLib::EDirSearchFlags::NormalFiles
                                                           : tCIDLib::EDirSearchFlags::AllFiles
                 )
@@ -812,7 +826,7 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         tCIDLib::TBoolean bGotSome = kCIDLib::False;
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
 
             //
             //  The collection we get holds CML level objects, so we can't just
@@ -839,21 +853,21 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
             TDirIter diterFind;
             TFindBuf fndbToFill;
             const TString& strWC = meOwner.strStackValAt(c4FirstInd + 1);
-            if (diterFind.bFindFirst(m_pathExpand1, strWC, fndbToFill, eFlags))
+            if (diterFind.bFindFirst(pathExpand1, strWC, fndbToFill, eFlags))
             {
                 bGotSome = kCIDLib::True;
 
                 do
                 {
                     // Get the CML level path out
-                    meOwner.ContractFilePath(fndbToFill.pathFileName(), m_pathExpand2);
+                    meOwner.ContractFilePath(fndbToFill.pathFileName(), pathExpand2);
                     mecvToFill.AddObject
                     (
                         new TMEngStringVal
                         (
                             TString::strEmpty()
                             , tCIDMacroEng::EConstTypes::NonConst
-                            , m_pathExpand2
+                            , pathExpand2
                         )
                     );
                 }   while (diterFind.bFindNext(fndbToFill));
@@ -884,8 +898,8 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
     {
         try
         {
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
-            TFileSys::MakePath(m_pathExpand1);
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
+            TFileSys::MakePath(pathExpand1);
         }
 
         catch(TError& errToCatch)
@@ -898,8 +912,8 @@ TMEngFileSysInfo::bInvokeMethod(        TCIDMacroEngine&    meOwner
         try
         {
             // Expand the root path part
-            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), m_pathExpand1);
-            TFileSys::MakeSubDirectory(m_pathExpand1, meOwner.strStackValAt(c4FirstInd + 1));
+            meOwner.ExpandFilePath(meOwner.strStackValAt(c4FirstInd), pathExpand1);
+            TFileSys::MakeSubDirectory(pathExpand1, meOwner.strStackValAt(c4FirstInd + 1));
         }
 
         catch(TError& errToCatch)
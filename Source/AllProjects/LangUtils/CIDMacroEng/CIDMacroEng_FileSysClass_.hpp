@@ -216,14 +216,6 @@ class TMEngDirIterInfo : public TMEngClassInfo
         //
         //  m_pmeciErrors
         //      A pointer the error enum we create for our errors.
-        //
-        //  m_pathExpand
-        //      A temp path that we use for massaging between the internal
-        //      and external view of the paths.
-        //
-        //  m_pathOrgPath
-        //      The original macro level path, so that we can use it in any
-        //      error messages and such.
         // -------------------------------------------------------------------
         tCIDLib::TCard2     m_c2EnumId_Errors;
         tCIDLib::TCard2     m_c2MethId_DefCtor;
@@ -231,9 +223,6 @@ class TMEngDirIterInfo : public TMEngClassInfo
         tCIDLib::TCard2     m_c2MethId_FindNext;
         tCIDLib::TCard4     m_c4ErrFindFailed;
         TMEngEnumInfo*      m_pmeciErrors;
-        TPathStr            m_pathExpand1;
-        TPathStr            m_pathExpand2;
-        TPathStr            m_pathOrgPath;
 
 
         // -------------------------------------------------------------------
@@ -419,12 +408,6 @@ class TMEngFileSysInfo : public TMEngClassInfo
         //  m_pmeciXXX
         //      We lookup some enums that we use in params, so that we can
         //      quickly get access to their values.
-        //
-        //  m_pathExpand1
-        //  m_pathExpand2
-        //      All the paths are macro language based paths, which have to
-        //      be expanded to local file system paths internally. We keep
-        //      these around for doing that.
         // -------------------------------------------------------------------
         tCIDLib::TCard2     m_c2EnumId_Errors;
         tCIDLib::TCard2     m_c2MethId_CopyFile;
@@ -447,8 +430,6 @@ class TMEngFileSysInfo : public TMEngClassInfo
         tCIDLib::TCard4     m_c4ErrPathNotFQ;
         tCIDLib::TCard4     m_c4ErrSearchFailed;
         TMEngEnumInfo*      m_pmeciErrors;
-        TPathStr            m_pathExpand1;
-        TPathStr            m_pathExpand2;
 
 
         // -------------------------------------------------------------------
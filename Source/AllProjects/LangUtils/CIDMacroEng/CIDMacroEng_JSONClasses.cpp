@@ -32,6 +32,9 @@
 // ---------------------------------------------------------------------------
 #include    "CIDMacroEng_.hpp"
 
+// These are only available where the facilities they wrap are
+#if defined(CIDMACROENG_NETDBCLASSES)
+
 
 // ---------------------------------------------------------------------------
 //  Magic RTTI macros
@@ -2157,4 +2160,4 @@ TMEngJSONParserInfo::ThrowAnErr(        TCIDMacroEngine&    meOwner
     throw TExceptException();
 }
 
-
+#endif
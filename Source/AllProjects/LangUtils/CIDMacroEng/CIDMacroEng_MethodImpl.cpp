@@ -208,6 +208,25 @@ TMEngJumpTableItem::eComp(  const   TMEngClassVal&      mecvToCheck
 }
 
 
+tCIDLib::TCard4 TMEngJumpTableItem::c4IP() const
+{
+    return m_c4IP;
+}
+
+tCIDLib::TCard4 TMEngJumpTableItem::c4IP(const tCIDLib::TCard4 c4ToSet)
+{
+    m_c4IP = c4ToSet;
+    return m_c4IP;
+}
+
+
+const TMEngClassVal& TMEngJumpTableItem::mecvCase() const
+{
+    return *m_pmecvCase;
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TMEngJumpTable
 // PREFIX: jtbl
@@ -266,11 +285,43 @@ tCIDLib::TBoolean TMEngJumpTable::bHasRequiredItems() const
 }
 
 
+tCIDLib::TCard4 TMEngJumpTable::c4CaseCount() const
+{
+    return m_colCases.c4ElemCount();
+}
+
+
 tCIDLib::TCard4 TMEngJumpTable::c4DefCaseIP() const
 {
     return m_c4DefIP;
 }
 
+tCIDLib::TCard4 TMEngJumpTable::c4DefCaseIP(const tCIDLib::TCard4 c4ToSet)
+{
+    m_c4DefIP = c4ToSet;
+    return m_c4DefIP;
+}
+
+
+const TMEngJumpTableItem&
+TMEngJumpTable::jtbliAt(const tCIDLib::TCard4 c4At) const
+{
+    #if CID_DEBUG_ON
+    if (c4At >= m_colCases.c4ElemCount())
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcDbg_BadJmpTableIndex
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Index
+            , TCardinal(c4At)
+        );
+    }
+    #endif
+    return *m_colCases[c4At];
+}
 
 TMEngJumpTableItem& TMEngJumpTable::jtbliAt(const tCIDLib::TCard4 c4At)
 {
@@ -585,17 +636,22 @@ TMEngOpMethodImpl::TMEngOpMethodImpl(const  TString&        strName
                                     , const tCIDLib::TCard2 c2MethodId) :
 
     TMEngMethodImpl(strName, c2MethodId)
+    , m_c4DirectCnt(0)
     , m_colOpCodes(128)
+    , m_pdcallTargets(nullptr)
     , m_pjtblSwitches(nullptr)
+    , m_pfcolLineMap(nullptr)
 {
 }
 
 TMEngOpMethodImpl::~TMEngOpMethodImpl()
 {
-    // Delete the jump table list if we have one
+    // Delete the jump table list and optimization info if we have them
     try
     {
         delete m_pjtblSwitches;
+        delete [] m_pdcallTargets;
+        delete m_pfcolLineMap;
     }
 
     catch(TError& errToCatch)
@@ -682,6 +738,13 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
     //
     MMEngDebugIntf* pmedbgToCall = meOwner.pmedbgToUse();
 
+    //
+    //  Likewise for the profiler, which is null unless profiling is enabled.
+    //  If it's enabled while we are running, we'll start seeing it in the
+    //  next method invoked.
+    //
+    TMEngProfiler* pmeprfToCall = meOwner.pmeprfActive();
+
     #if CID_DEBUG_ON
     tCIDLib::TBoolean bDoDump = kCIDLib::False;
     if (bDoDump)
@@ -704,6 +767,13 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
             pmedbgToCall->LocalsChange(kCIDLib::True);
     }
 
+    //
+    //  We need an index, which is our 'instruction pointer'. It's outside
+    //  of the try so that, if the line opcodes were stripped, the handlers
+    //  below can still get the line of the opcode that failed.
+    //
+    tCIDLib::TCard4 c4IP = 0;
+
     //
     //  And now let's enter the opcode processing loop. We process opcodes
     //  in the order found, except when we hit jump opcodes. If we hit the
@@ -711,9 +781,6 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
     //
     try
     {
-        // We need an index, which is our 'instruction pointer'
-        tCIDLib::TCard4 c4IP = 0;
-
         //
         //  Remember the opcode count. If we get to this, then we are at
         //  the end of the method.
@@ -727,6 +794,19 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
             // Get the current opcode
             const TMEngOpCode& meopCur = m_colOpCodes[c4IP];
 
+            // If profiling, count it against the line it's on
+            if (pmeprfToCall)
+            {
+                tCIDLib::TCard4 c4Line;
+                if (m_pfcolLineMap)
+                    c4Line = (*m_pfcolLineMap)[c4IP];
+                else if (meopCur.eOpCode() == tCIDMacroEng::EOpCodes::CurLine)
+                    c4Line = meopCur.c4Immediate();
+                else
+                    c4Line = meOwner.c4CurLine();
+                pmeprfToCall->OpHit(meciTarget.c2Id(), c4Line);
+            }
+
             switch(meopCur.eOpCode())
             {
                 case tCIDMacroEng::EOpCodes::CallExcept :
@@ -737,6 +817,10 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                 case tCIDMacroEng::EOpCodes::CallStack :
                 case tCIDMacroEng::EOpCodes::CallThis :
                 {
+                    // If the line opcodes were stripped, keep the line up to date
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     TMEngClassVal*  pmecvTarget = nullptr;
                     const TMEngClassInfo* pmeciTarget = nullptr;
                     tCIDLib::TCard2 c2MethId = kCIDMacroEng::c2BadId;
@@ -848,6 +932,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                         if (pmedbgToCall)
                             pmedbgToCall->CallStackChange();
 
+                        // If profiling, this times the call till we get out of here
+                        TMEngProfJanitor janProfile(pmeprfToCall, pmeciTarget->c2Id(), c2MethId);
+
                         //
                         //  Looks ok, so call the class with the instance and
                         //  method info. It will pass it on to the appropriate
@@ -857,11 +944,42 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                         //  dispatch, else do polymorphic to go to the most
                         //  derived.
                         //
-                        tCIDMacroEng::EDispatch eDispatch = tCIDMacroEng::EDispatch::Poly;
-                        if (meopCur.eOpCode() == tCIDMacroEng::EOpCodes::CallParent)
-                            eDispatch = tCIDMacroEng::EDispatch::Mono;
+                        //  If the optimizer resolved the target up front, and
+                        //  the target object is of the expected class, we can
+                        //  just invoke the implementation directly.
+                        //
+                        const TDirectCall* pdcallTarget = nullptr;
+                        if (meopCur[3])
+                        {
+                            pdcallTarget = &m_pdcallTargets[meopCur[3] - 1];
+                            if ((pdcallTarget->c2GuardId != kCIDMacroEng::c2BadId)
+                            &&  (pdcallTarget->c2GuardId != pmecvTarget->c2ClassId()))
+                            {
+                                pdcallTarget = nullptr;
+                            }
+                        }
 
-                        pmeciTarget->Invoke(meOwner, *pmecvTarget, c2MethId, eDispatch);
+                        if (pdcallTarget)
+                        {
+                            if (meOwner.bValidation())
+                                meOwner.ValidateCallFrame(*pmecvTarget, c2MethId);
+
+                            pdcallTarget->pmethImpl->Invoke
+                            (
+                                *pmecvTarget
+                                , *pdcallTarget->pmeciImpl
+                                , *pdcallTarget->pmethiTarget
+                                , meOwner
+                            );
+                        }
+                         else
+                        {
+                            tCIDMacroEng::EDispatch eDispatch = tCIDMacroEng::EDispatch::Poly;
+                            if (meopCur.eOpCode() == tCIDMacroEng::EOpCodes::CallParent)
+                                eDispatch = tCIDMacroEng::EDispatch::Mono;
+
+                            pmeciTarget->Invoke(meOwner, *pmecvTarget, c2MethId, eDispatch);
+                        }
 
                         //
                         //  We clean off the call item, since we pushed it,
@@ -870,6 +988,10 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                         meOwner.PopTop();
                         if (pmedbgToCall)
                             pmedbgToCall->CallStackChange();
+
+                        // And any following pops the optimizer folded into the call
+                        if (meopCur[2])
+                            meOwner.MultiPop(meopCur[2]);
                     }
 
                     catch(TError& errToCatch)
@@ -981,6 +1103,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::ColIndex :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     //
                     //  The top of stack is an index value, and the one before
                     //  that is a collection object.
@@ -1051,6 +1176,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::Copy :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     const tCIDLib::TCard4 c4Top = meOwner.c4StackTop();
                     TMEngClassVal& mecvSrc = meOwner.mecvStackAt(c4Top - 1);
                     TMEngClassVal& mecvTar = meOwner.mecvStackAt(c4Top - 2);
@@ -1183,6 +1311,32 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                     break;
                 }
 
+                case tCIDMacroEng::EOpCodes::CondJumpPop :
+                case tCIDMacroEng::EOpCodes::NotCondJumpPop :
+                {
+                    //
+                    //  These are generated by the optimizer. They work like
+                    //  the regular ones, but pop some extra items under the
+                    //  boolean as well. The target IP only uses the first
+                    //  two indices so the third one holds the extra count.
+                    //
+                    tCIDLib::TBoolean bJump = meOwner.bStackValAt
+                    (
+                        meOwner.c4StackTop() - 1
+                    );
+                    meOwner.MultiPop(tCIDLib::TCard4(meopCur[2]) + 1);
+
+                    if (meopCur.eOpCode() == tCIDMacroEng::EOpCodes::NotCondJumpPop)
+                        bJump = !bJump;
+
+                    if (bJump)
+                    {
+                        c4IP = meopCur.c4Immediate();
+                        bNoIncIP = kCIDLib::True;
+                    }
+                    break;
+                }
+
                 case tCIDMacroEng::EOpCodes::CurLine :
                 {
                     // Just store the line number stored
@@ -1400,6 +1554,14 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
                     break;
                 }
 
+                case tCIDMacroEng::EOpCodes::PopUnder :
+                {
+                    // Generated by the optimizer for a flip and pop
+                    meOwner.FlipStackTop();
+                    meOwner.PopTop();
+                    break;
+                }
+
                 case tCIDMacroEng::EOpCodes::PopToReturn :
                 {
                     //
@@ -1419,6 +1581,8 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::PushCurLine :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
                     meOwner.PushCard4(meOwner.c4CurLine(), tCIDMacroEng::EConstTypes::Const);
                     break;
                 }
@@ -1644,6 +1808,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::Throw :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     //
                     //  This can be either a throw, or a rethrow, according
                     //  to the immediate boolean value. If a throw, then
@@ -1702,6 +1869,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::ThrowFmt :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     //
                     //  This is a special form of throw that is used to
                     //  pass in values to be used to replace tokens in the
@@ -1784,6 +1954,9 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
                 case tCIDMacroEng::EOpCodes::TypeCast :
                 {
+                    if (m_pfcolLineMap)
+                        meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
                     //
                     //  The first index is the type to cast to. The value to
                     //  cast is on the top of stack, and must be a numeric or
@@ -1897,6 +2070,10 @@ TMEngOpMethodImpl::Invoke(          TMEngClassVal&      mecvInstance
 
         if (!bThrowReported)
         {
+            // If the line opcodes were stripped, get the line of the failure
+            if (m_pfcolLineMap && (c4IP < m_pfcolLineMap->c4ElemCount()))
+                meOwner.c4CurLine((*m_pfcolLineMap)[c4IP]);
+
             facCIDMacroEng().LogMsg
             (
                 CID_FILE
@@ -2064,8 +2241,20 @@ tCIDLib::TCard4 TMEngOpMethodImpl::c4CurOffset() const
 }
 
 
+tCIDLib::TCard4 TMEngOpMethodImpl::c4JumpTableCount() const
+{
+    if (!m_pjtblSwitches)
+        return 0;
+    return m_pjtblSwitches->c4ElemCount();
+}
+
+
 tCIDLib::TCard4 TMEngOpMethodImpl::c4FirstLineNum() const
 {
+    // If the line opcodes were stripped, use the line map
+    if (m_pfcolLineMap && !m_pfcolLineMap->bIsEmpty())
+        return (*m_pfcolLineMap)[0];
+
     const tCIDLib::TCard4 c4Count = m_colOpCodes.c4ElemCount();
     for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
     {
@@ -2097,6 +2286,26 @@ TMEngOpMethodImpl::DumpOpCodes(         TTextOutStream&     strmTarget
 }
 
 
+const TMEngJumpTable&
+TMEngOpMethodImpl::jtblById(const tCIDLib::TCard2 c2Id) const
+{
+    // Make sure this index is valid
+    if (!m_pjtblSwitches || (c2Id >= m_pjtblSwitches->c4ElemCount()))
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcMeth_BadJumpTableId
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Index
+            , TCardinal(c2Id)
+            , strName()
+        );
+    }
+    return *m_pjtblSwitches->pobjAt(c2Id);
+}
+
 TMEngJumpTable& TMEngOpMethodImpl::jtblById(const tCIDLib::TCard2 c2Id)
 {
     // Make sure this index is valid
@@ -2195,6 +2404,39 @@ TMEngOpCode& TMEngOpMethodImpl::meopLast()
 }
 
 
+const TMEngOpMethodImpl::TLineMap* TMEngOpMethodImpl::pfcolLineMap() const
+{
+    return m_pfcolLineMap;
+}
+
+
+//
+//  This is used when a method whose line opcodes were stripped is loaded from
+//  the compiled class cache. There must be a line for each opcode.
+//
+tCIDLib::TVoid TMEngOpMethodImpl::SetLineMap(const TLineMap& fcolToSet)
+{
+    if (fcolToSet.c4ElemCount() != m_colOpCodes.c4ElemCount())
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcMeth_BadIP
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Index
+            , strName()
+            , TCardinal(fcolToSet.c4ElemCount())
+        );
+    }
+
+    if (m_pfcolLineMap)
+        *m_pfcolLineMap = fcolToSet;
+    else
+        m_pfcolLineMap = new TLineMap(fcolToSet);
+}
+
+
 // ---------------------------------------------------------------------------
 //  TMEngOpMethodImpl: Private, non-virtual methods
 // ---------------------------------------------------------------------------
@@ -101,6 +101,15 @@ class CIDMACROENGEXP TMEngJumpTableItem
             ,       tCIDLib::TCard4&        c4IP
         )   const;
 
+        tCIDLib::TCard4 c4IP() const;
+
+        tCIDLib::TCard4 c4IP
+        (
+            const   tCIDLib::TCard4         c4ToSet
+        );
+
+        const TMEngClassVal& mecvCase() const;
+
 
     private :
         // -------------------------------------------------------------------
@@ -160,8 +169,20 @@ class CIDMACROENGEXP TMEngJumpTable
 
         tCIDLib::TBoolean bHasRequiredItems() const;
 
+        tCIDLib::TCard4 c4CaseCount() const;
+
         tCIDLib::TCard4 c4DefCaseIP() const;
 
+        tCIDLib::TCard4 c4DefCaseIP
+        (
+            const   tCIDLib::TCard4         c4ToSet
+        );
+
+        const TMEngJumpTableItem& jtbliAt
+        (
+            const   tCIDLib::TCard4         c4At
+        )   const;
+
         TMEngJumpTableItem& jtbliAt
         (
             const   tCIDLib::TCard4         c4At
@@ -348,6 +369,12 @@ class CIDMACROENGEXP TMEngMethodImpl : public TMEngNamedItem
 class CIDMACROENGEXP TMEngOpMethodImpl : public TMEngMethodImpl
 {
     public  :
+        // -------------------------------------------------------------------
+        //  Class types
+        // -------------------------------------------------------------------
+        using TLineMap = TFundVector<tCIDLib::TCard4>;
+
+
         // -------------------------------------------------------------------
         //  Constructors and Destructor
         // -------------------------------------------------------------------
@@ -417,12 +444,24 @@ class CIDMACROENGEXP TMEngOpMethodImpl : public TMEngMethodImpl
 
         tCIDLib::TCard4 c4CurOffset() const;
 
+        tCIDLib::TCard4 c4JumpTableCount() const;
+
+        tCIDLib::TCard4 c4Optimize
+        (
+            const   tCIDLib::TBoolean       bStripLines
+        );
+
         tCIDLib::TVoid DumpOpCodes
         (
                     TTextOutStream&         strmTarget
             , const TCIDMacroEngine&        meOwner
         )   const;
 
+        const TMEngJumpTable& jtblById
+        (
+            const   tCIDLib::TCard2         c2Id
+        )   const;
+
         TMEngJumpTable& jtblById
         (
             const   tCIDLib::TCard2         c2Id
@@ -442,17 +481,49 @@ class CIDMACROENGEXP TMEngOpMethodImpl : public TMEngMethodImpl
 
         TMEngOpCode& meopLast();
 
+        const TLineMap* pfcolLineMap() const;
+
+        tCIDLib::TVoid ResolveCalls
+        (
+                    TCIDMacroEngine&        meOwner
+            , const TMEngClassInfo&         meciOwner
+        );
+
+        tCIDLib::TVoid SetLineMap
+        (
+            const   TLineMap&               fcolToSet
+        );
+
 
     private :
         // -------------------------------------------------------------------
         //  Private class types
+        //
+        //  TDirectCall
+        //      A call target resolved at load time, so that monomorphic calls
+        //      don't have to search the class hierarchy for the implementation
+        //      on every call. If the guard id isn't c2BadId, then the target
+        //      object must be of that class for the resolved target to be used.
         // -------------------------------------------------------------------
         using TMEngJumpTableTable = TRefVector<TMEngJumpTable>;
 
+        struct TDirectCall
+        {
+            tCIDLib::TCard2         c2GuardId;
+            const TMEngClassInfo*   pmeciImpl;
+            const TMEngMethodInfo*  pmethiTarget;
+            TMEngMethodImpl*        pmethImpl;
+        };
+
 
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bPeepholePass
+        (
+            const   tCIDLib::TBoolean       bStripLines
+        );
+
         tCIDLib::TVoid FormatErrTokens
         (
                     TCIDMacroEngine&        meOwner
@@ -464,6 +535,12 @@ class CIDMACROENGEXP TMEngOpMethodImpl : public TMEngMethodImpl
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_c4DirectCnt
+        //  m_pdcallTargets
+        //      The call targets that ResolveCalls() could resolve up front.
+        //      Call opcodes that have one hold its index plus one in their
+        //      fourth index. We only allocate this if needed.
+        //
         //  m_colOpCodes
         //      This is the list of opcodes that makes up the body of this
         //      method.
@@ -473,9 +550,18 @@ class CIDMACROENGEXP TMEngOpMethodImpl : public TMEngMethodImpl
         //      tables for them. So each switch statement gets a table added
         //      here and the table jump opcode holds the index of it's table.
         //      We only allocate this if needed.
+        //
+        //  m_pfcolLineMap
+        //      If the optimizer stripped out the current line opcodes, this
+        //      holds the line number for each opcode, so that we can still
+        //      keep the engine's current line updated for error reporting.
+        //      It's null if the lines weren't stripped.
         // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4DirectCnt;
         TVector<TMEngOpCode>    m_colOpCodes;
+        TDirectCall*            m_pdcallTargets;
         TMEngJumpTableTable*    m_pjtblSwitches;
+        TLineMap*               m_pfcolLineMap;
 
 
         // -------------------------------------------------------------------
@@ -0,0 +1,562 @@
+//
+// FILE NAME: CIDMacroEng_MethodOpt.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the post-parse optimization parts of the opcode
+//  based method implementation class. They are split out here since they
+//  have nothing to do with running the opcodes and the main file is big
+//  enough already.
+//
+//  c4Optimize() does a peephole pass over the opcodes, folding constant
+//  pushes, fusing common opcode pairs into the 'superinstructions' that
+//  only the optimizer generates, threading jumps, and optionally removing
+//  the current line opcodes (in which case a line map is kept so that
+//  errors still report the right line.) It's run until nothing else changes.
+//
+//  ResolveCalls() looks at the call opcodes and, where the target method
+//  implementation can be known up front, stores it so that Invoke() can
+//  call it directly instead of searching the class hierarchy each time.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Nothing that is the target of a jump can be merged into the opcode
+//      before it, since something else can get to it without going through
+//      that previous opcode. Anything else is fair game as long as the net
+//      stack effect is the same.
+//
+//  2)  The final opcode is never removed, since the engine's debugger and
+//      the parser's end of method check depend on it being there.
+//
+//  3)  Call resolution has to be done after all of the classes involved are
+//      loaded, since it has to look up the classes of locals and members.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDMacroEng_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDMacroEng_MethodOpt
+    {
+        //
+        //  The maximum number of peephole passes we'll do. Each one can only
+        //  expose new pairs where something was removed, so it settles down
+        //  quickly. This is just a safety net.
+        //
+        constexpr tCIDLib::TCard4   c4MaxPasses = 8;
+
+
+        //
+        //  Some helpers to classify opcodes, to keep the pass itself more
+        //  readable.
+        //
+        tCIDLib::TBoolean bIsCall(const tCIDMacroEng::EOpCodes eOp)
+        {
+            return (eOp >= tCIDMacroEng::EOpCodes::FirstCall)
+                    && (eOp <= tCIDMacroEng::EOpCodes::LastCall);
+        }
+
+        //
+        //  These have no side effects other than pushing something, so if the
+        //  value is immediately popped again, both can be dropped.
+        //
+        tCIDLib::TBoolean bIsPurePush(const tCIDMacroEng::EOpCodes eOp)
+        {
+            switch(eOp)
+            {
+                case tCIDMacroEng::EOpCodes::PushEnum :
+                case tCIDMacroEng::EOpCodes::PushImBoolean :
+                case tCIDMacroEng::EOpCodes::PushImCard1 :
+                case tCIDMacroEng::EOpCodes::PushImCard2 :
+                case tCIDMacroEng::EOpCodes::PushImCard4 :
+                case tCIDMacroEng::EOpCodes::PushImCard8 :
+                case tCIDMacroEng::EOpCodes::PushImChar :
+                case tCIDMacroEng::EOpCodes::PushImFloat4 :
+                case tCIDMacroEng::EOpCodes::PushImFloat8 :
+                case tCIDMacroEng::EOpCodes::PushImInt1 :
+                case tCIDMacroEng::EOpCodes::PushImInt2 :
+                case tCIDMacroEng::EOpCodes::PushImInt4 :
+                case tCIDMacroEng::EOpCodes::PushLocal :
+                case tCIDMacroEng::EOpCodes::PushMember :
+                case tCIDMacroEng::EOpCodes::PushParm :
+                case tCIDMacroEng::EOpCodes::PushStrPoolItem :
+                case tCIDMacroEng::EOpCodes::PushThis :
+                    return kCIDLib::True;
+
+                default :
+                    break;
+            };
+            return kCIDLib::False;
+        }
+
+        // Opcodes that hold a target IP in their c4Immediate field
+        tCIDLib::TBoolean bHasTargetIP(const tCIDMacroEng::EOpCodes eOp)
+        {
+            switch(eOp)
+            {
+                case tCIDMacroEng::EOpCodes::CondJump :
+                case tCIDMacroEng::EOpCodes::CondJumpNP :
+                case tCIDMacroEng::EOpCodes::CondJumpPop :
+                case tCIDMacroEng::EOpCodes::Jump :
+                case tCIDMacroEng::EOpCodes::NotCondJump :
+                case tCIDMacroEng::EOpCodes::NotCondJumpNP :
+                case tCIDMacroEng::EOpCodes::NotCondJumpPop :
+                case tCIDMacroEng::EOpCodes::Try :
+                    return kCIDLib::True;
+
+                default :
+                    break;
+            };
+            return kCIDLib::False;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMEngOpMethodImpl: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Runs peephole passes until nothing more changes, and returns how many
+//  opcodes were removed. If asked to strip the current line opcodes, we
+//  build the line map first, while we still have them to get the lines from.
+//
+tCIDLib::TCard4 TMEngOpMethodImpl::c4Optimize(const tCIDLib::TBoolean bStripLines)
+{
+    const tCIDLib::TCard4 c4OrgCount = m_colOpCodes.c4ElemCount();
+    if (c4OrgCount < 2)
+        return 0;
+
+    if (bStripLines && !m_pfcolLineMap)
+    {
+        // Anything before the first line opcode gets the first line
+        tCIDLib::TCard4 c4Line = c4FirstLineNum();
+
+        m_pfcolLineMap = new TLineMap(c4OrgCount);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OrgCount; c4Index++)
+        {
+            const TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+            if (meopCur.eOpCode() == tCIDMacroEng::EOpCodes::CurLine)
+                c4Line = meopCur.c4Immediate();
+            m_pfcolLineMap->c4AddElement(c4Line);
+        }
+    }
+
+    tCIDLib::TCard4 c4Passes = 0;
+    while (c4Passes < CIDMacroEng_MethodOpt::c4MaxPasses)
+    {
+        c4Passes++;
+        if (!bPeepholePass(bStripLines))
+            break;
+    }
+    return c4OrgCount - m_colOpCodes.c4ElemCount();
+}
+
+
+//
+//  For each call opcode where we can know the target implementation up front,
+//  store a direct call target and put its index (plus one) into the opcode.
+//  Locals and members are by value, so their class is known, but we keep the
+//  class as a guard anyway and Invoke() falls back to the normal lookup if
+//  it doesn't match. For CallThis we can only do it if the class or method
+//  is final, else a derived class could override it.
+//
+//  We stop at any class that isn't a standard (CML) class, since those can
+//  dispatch their methods however they want.
+//
+tCIDLib::TVoid
+TMEngOpMethodImpl::ResolveCalls(        TCIDMacroEngine&    meOwner
+                                , const TMEngClassInfo&     meciOwner)
+{
+    // Toss any previous results and clear out the old slots
+    delete [] m_pdcallTargets;
+    m_pdcallTargets = nullptr;
+    m_c4DirectCnt = 0;
+
+    const tCIDLib::TCard4 c4Count = m_colOpCodes.c4ElemCount();
+    tCIDLib::TCard4 c4Calls = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+        if (CIDMacroEng_MethodOpt::bIsCall(meopCur.eOpCode()))
+        {
+            meopCur.SetIndex(3, 0);
+            c4Calls++;
+        }
+    }
+
+    // The slot index has to fit in an opcode index
+    if (!c4Calls)
+        return;
+    if (c4Calls >= kCIDLib::c2MaxCard)
+        c4Calls = kCIDLib::c2MaxCard - 1;
+
+    m_pdcallTargets = new TDirectCall[c4Calls];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        if (m_c4DirectCnt == c4Calls)
+            break;
+
+        TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+
+        tCIDLib::TCard2 c2GuardId = kCIDMacroEng::c2BadId;
+        tCIDLib::TCard2 c2MethId = kCIDMacroEng::c2BadId;
+        tCIDLib::TCard2 c2StartId = kCIDMacroEng::c2BadId;
+        switch(meopCur.eOpCode())
+        {
+            case tCIDMacroEng::EOpCodes::CallLocal :
+                c2StartId = meliFind(meopCur[0]).c2ClassId();
+                c2GuardId = c2StartId;
+                c2MethId = meopCur[1];
+                break;
+
+            case tCIDMacroEng::EOpCodes::CallMember :
+                c2StartId = meciOwner.memiFind(meopCur[0]).c2ClassId();
+                c2GuardId = c2StartId;
+                c2MethId = meopCur[1];
+                break;
+
+            case tCIDMacroEng::EOpCodes::CallParent :
+                c2StartId = meciOwner.c2ParentClassId();
+                c2MethId = meopCur[0];
+                break;
+
+            case tCIDMacroEng::EOpCodes::CallThis :
+                c2MethId = meopCur[0];
+                if ((meciOwner.eExtend() == tCIDMacroEng::EClassExt::Final)
+                ||  (meciOwner.methiFind(c2MethId).eExtend() == tCIDMacroEng::EMethExt::Final))
+                {
+                    c2StartId = meciOwner.c2Id();
+                }
+                break;
+
+            default :
+                // Not a call, or one whose target is only known at runtime
+                break;
+        };
+
+        if (c2StartId == kCIDMacroEng::c2BadId)
+            continue;
+
+        //
+        //  Work up the hierarchy till we find an implementation, same as the
+        //  standard class' bInvokeMethod() would do at runtime.
+        //
+        tCIDLib::TCard2 c2CurId = c2StartId;
+        while (c2CurId != kCIDMacroEng::c2BadId)
+        {
+            TMEngClassInfo& meciCur = meOwner.meciFind(c2CurId);
+            if ((meciCur.clsIsA() != TMEngStdClassInfo::clsThis())
+            ||  (c2MethId >= meciCur.c4MethodCount()))
+            {
+                break;
+            }
+
+            TMEngMethodImpl* pmethFound = meciCur.pmethFind(c2MethId);
+            if (pmethFound)
+            {
+                TDirectCall& dcallNew = m_pdcallTargets[m_c4DirectCnt++];
+                dcallNew.c2GuardId = c2GuardId;
+                dcallNew.pmeciImpl = &meciCur;
+                dcallNew.pmethiTarget = &meciCur.methiFind(c2MethId);
+                dcallNew.pmethImpl = pmethFound;
+                meopCur.SetIndex(3, tCIDLib::TCard2(m_c4DirectCnt));
+                break;
+            }
+            c2CurId = meciCur.c2ParentClassId();
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMEngOpMethodImpl: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Does one peephole pass. We mark the ops to remove and rewrite others in
+//  place, then compact the list at the end and fix up all of the IPs. We
+//  return true if anything was changed.
+//
+tCIDLib::TBoolean TMEngOpMethodImpl::bPeepholePass(const tCIDLib::TBoolean bStripLines)
+{
+    const tCIDLib::TCard4 c4Count = m_colOpCodes.c4ElemCount();
+    const tCIDLib::TCard4 c4LastIP = c4Count - 1;
+
+    // Mark everything that something can jump to
+    TFundArray<tCIDLib::TBoolean> fcolTargets(c4Count, kCIDLib::False);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+        if (CIDMacroEng_MethodOpt::bHasTargetIP(meopCur.eOpCode()))
+        {
+            const tCIDLib::TCard4 c4Target = meopCur.c4Immediate();
+            if (c4Target < c4Count)
+                fcolTargets[c4Target] = kCIDLib::True;
+        }
+    }
+
+    const tCIDLib::TCard4 c4TblCount = m_pjtblSwitches ? m_pjtblSwitches->c4ElemCount() : 0;
+    for (tCIDLib::TCard4 c4TblInd = 0; c4TblInd < c4TblCount; c4TblInd++)
+    {
+        const TMEngJumpTable& jtblCur = *m_pjtblSwitches->pobjAt(c4TblInd);
+        if (jtblCur.c4DefCaseIP() < c4Count)
+            fcolTargets[jtblCur.c4DefCaseIP()] = kCIDLib::True;
+
+        const tCIDLib::TCard4 c4CaseCnt = jtblCur.c4CaseCount();
+        for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < c4CaseCnt; c4CaseInd++)
+        {
+            const tCIDLib::TCard4 c4IP = jtblCur.jtbliAt(c4CaseInd).c4IP();
+            if (c4IP < c4Count)
+                fcolTargets[c4IP] = kCIDLib::True;
+        }
+    }
+
+    TFundArray<tCIDLib::TBoolean> fcolRemove(c4Count, kCIDLib::False);
+    tCIDLib::TBoolean bChanges = kCIDLib::False;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LastIP; c4Index++)
+    {
+        if (fcolRemove[c4Index])
+            continue;
+
+        TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+        const tCIDMacroEng::EOpCodes eCur = meopCur.eOpCode();
+
+        //
+        //  Single opcode rules first. These just get rid of the opcode, or
+        //  point jumps at their final destination.
+        //
+        if (((eCur == tCIDMacroEng::EOpCodes::CurLine) && bStripLines)
+        ||  (eCur == tCIDMacroEng::EOpCodes::NoOp)
+        ||  ((eCur == tCIDMacroEng::EOpCodes::MultiPop) && !meopCur.c4Immediate())
+        ||  ((eCur == tCIDMacroEng::EOpCodes::Jump) && (meopCur.c4Immediate() == c4Index + 1)))
+        {
+            fcolRemove[c4Index] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+            continue;
+        }
+
+        if (CIDMacroEng_MethodOpt::bHasTargetIP(eCur)
+        &&  (eCur != tCIDMacroEng::EOpCodes::Try))
+        {
+            //
+            //  If it's going to a jump, go straight to where that one goes.
+            //  This only updates the target, so the extra pop count in the
+            //  fused ones is kept.
+            //
+            const tCIDLib::TCard4 c4Target = meopCur.c4Immediate();
+            if ((c4Target < c4Count)
+            &&  (m_colOpCodes[c4Target].eOpCode() == tCIDMacroEng::EOpCodes::Jump)
+            &&  (m_colOpCodes[c4Target].c4Immediate() != c4Target))
+            {
+                meopCur.c4Immediate(m_colOpCodes[c4Target].c4Immediate());
+                bChanges = kCIDLib::True;
+            }
+        }
+
+        //
+        //  Now the pair rules. The next one can't be something that's jumped
+        //  to, and we never touch the last opcode.
+        //
+        const tCIDLib::TCard4 c4Next = c4Index + 1;
+        if (fcolTargets[c4Next] || (c4Next == c4LastIP))
+            continue;
+
+        TMEngOpCode& meopNext = m_colOpCodes[c4Next];
+        const tCIDMacroEng::EOpCodes eNext = meopNext.eOpCode();
+
+        // Get the number of items the next one pops, if it's just a pop
+        tCIDLib::TCard4 c4NextPops = 0;
+        if (eNext == tCIDMacroEng::EOpCodes::PopTop)
+            c4NextPops = 1;
+        else if (eNext == tCIDMacroEng::EOpCodes::MultiPop)
+            c4NextPops = meopNext.c4Immediate();
+
+        if (c4NextPops
+        &&  ((eCur == tCIDMacroEng::EOpCodes::PopTop)
+        ||   (eCur == tCIDMacroEng::EOpCodes::MultiPop)))
+        {
+            // Merge pop runs into a single multi-pop
+            const tCIDLib::TCard4 c4CurPops
+            (
+                (eCur == tCIDMacroEng::EOpCodes::PopTop) ? 1 : meopCur.c4Immediate()
+            );
+            meopCur.SetImmediate(tCIDMacroEng::EOpCodes::MultiPop, c4CurPops + c4NextPops);
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+         else if (c4NextPops && CIDMacroEng_MethodOpt::bIsCall(eCur))
+        {
+            // Fold the post-call pops into the call
+            const tCIDLib::TCard4 c4NewPops = meopCur[2] + c4NextPops;
+            if (c4NewPops < kCIDLib::c2MaxCard)
+            {
+                meopCur.SetIndex(2, tCIDLib::TCard2(c4NewPops));
+                fcolRemove[c4Next] = kCIDLib::True;
+                bChanges = kCIDLib::True;
+            }
+        }
+         else if (c4NextPops && CIDMacroEng_MethodOpt::bIsPurePush(eCur))
+        {
+            // Pushed just to be popped, so get rid of the push and one pop
+            fcolRemove[c4Index] = kCIDLib::True;
+            if (c4NextPops == 1)
+                fcolRemove[c4Next] = kCIDLib::True;
+            else
+                meopNext.SetImmediate(tCIDMacroEng::EOpCodes::MultiPop, c4NextPops - 1);
+            bChanges = kCIDLib::True;
+        }
+         else if ((eCur == tCIDMacroEng::EOpCodes::FlipTop)
+              &&  (eNext == tCIDMacroEng::EOpCodes::PopTop))
+        {
+            meopCur.SetOpCode(tCIDMacroEng::EOpCodes::PopUnder);
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+         else if ((eCur == tCIDMacroEng::EOpCodes::PopUnder)
+              &&  ((eNext == tCIDMacroEng::EOpCodes::CondJump)
+              ||   (eNext == tCIDMacroEng::EOpCodes::NotCondJump)))
+        {
+            //
+            //  This is the standard result of a comparison followed by a
+            //  conditional jump. Set the target first, since setting the
+            //  opcode clears the indices, then the pop count.
+            //
+            meopCur.SetImmediate
+            (
+                (eNext == tCIDMacroEng::EOpCodes::CondJump)
+                    ? tCIDMacroEng::EOpCodes::CondJumpPop
+                    : tCIDMacroEng::EOpCodes::NotCondJumpPop
+                , meopNext.c4Immediate()
+            );
+            meopCur.SetIndex(2, 1);
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+         else if ((eCur == tCIDMacroEng::EOpCodes::Negate)
+              &&  ((eNext == tCIDMacroEng::EOpCodes::CondJump)
+              ||   (eNext == tCIDMacroEng::EOpCodes::NotCondJump)))
+        {
+            // Just flip the sense of the jump
+            meopCur.SetImmediate
+            (
+                (eNext == tCIDMacroEng::EOpCodes::CondJump)
+                    ? tCIDMacroEng::EOpCodes::NotCondJump
+                    : tCIDMacroEng::EOpCodes::CondJump
+                , meopNext.c4Immediate()
+            );
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+         else if ((eCur == tCIDMacroEng::EOpCodes::PushImBoolean)
+              &&  (eNext == tCIDMacroEng::EOpCodes::Negate))
+        {
+            meopCur.SetImmediate(tCIDMacroEng::EOpCodes::PushImBoolean, !meopCur.bImmediate());
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+         else if ((eCur == tCIDMacroEng::EOpCodes::PushImBoolean)
+              &&  ((eNext == tCIDMacroEng::EOpCodes::CondJump)
+              ||   (eNext == tCIDMacroEng::EOpCodes::NotCondJump)))
+        {
+            //
+            //  A constant condition, i.e. a while(True) or if(False). Either
+            //  it always jumps, or we can just drop both.
+            //
+            const tCIDLib::TBoolean bJumps
+            (
+                meopCur.bImmediate() == (eNext == tCIDMacroEng::EOpCodes::CondJump)
+            );
+            if (bJumps)
+                meopCur.SetImmediate(tCIDMacroEng::EOpCodes::Jump, meopNext.c4Immediate());
+            else
+                fcolRemove[c4Index] = kCIDLib::True;
+            fcolRemove[c4Next] = kCIDLib::True;
+            bChanges = kCIDLib::True;
+        }
+    }
+
+    if (!bChanges)
+        return kCIDLib::False;
+
+    //
+    //  Build a map from old to new IPs. Each one maps to the count of kept
+    //  opcodes before it, which also makes a removed opcode map to the next
+    //  kept one, which is what we want for jumps to removed opcodes. The
+    //  last one is never removed, so there always is a next one.
+    //
+    TFundArray<tCIDLib::TCard4> fcolNewIPs(c4Count);
+    TVector<TMEngOpCode> colNew(c4Count);
+    tCIDLib::TCard4 c4NewCount = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        fcolNewIPs[c4Index] = c4NewCount;
+        if (!fcolRemove[c4Index])
+        {
+            colNew.objAdd(m_colOpCodes[c4Index]);
+            if (m_pfcolLineMap)
+                (*m_pfcolLineMap)[c4NewCount] = (*m_pfcolLineMap)[c4Index];
+            c4NewCount++;
+        }
+    }
+    m_colOpCodes = tCIDLib::ForceMove(colNew);
+
+    if (m_pfcolLineMap && (c4NewCount < c4Count))
+        m_pfcolLineMap->Delete(c4NewCount, c4Count - 1);
+
+    // And update all of the jump targets
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4NewCount; c4Index++)
+    {
+        TMEngOpCode& meopCur = m_colOpCodes[c4Index];
+        if (!CIDMacroEng_MethodOpt::bHasTargetIP(meopCur.eOpCode()))
+            continue;
+
+        const tCIDLib::TCard4 c4Old = meopCur.c4Immediate();
+        if (c4Old < c4Count)
+            meopCur.c4Immediate(fcolNewIPs[c4Old]);
+    }
+
+    for (tCIDLib::TCard4 c4TblInd = 0; c4TblInd < c4TblCount; c4TblInd++)
+    {
+        TMEngJumpTable& jtblCur = *m_pjtblSwitches->pobjAt(c4TblInd);
+        if (jtblCur.c4DefCaseIP() < c4Count)
+            jtblCur.c4DefCaseIP(fcolNewIPs[jtblCur.c4DefCaseIP()]);
+
+        const tCIDLib::TCard4 c4CaseCnt = jtblCur.c4CaseCount();
+        for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < c4CaseCnt; c4CaseInd++)
+        {
+            TMEngJumpTableItem& jtbliCur = jtblCur.jtbliAt(c4CaseInd);
+            if (jtbliCur.c4IP() < c4Count)
+                jtbliCur.c4IP(fcolNewIPs[jtbliCur.c4IP()]);
+        }
+    }
+    return kCIDLib::True;
+}
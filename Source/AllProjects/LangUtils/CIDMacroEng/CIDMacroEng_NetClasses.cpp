@@ -37,8 +37,10 @@
 // ---------------------------------------------------------------------------
 RTTIDecls(TMEngDataSrcVal,TMEngClassVal)
 RTTIDecls(TMEngDataSrcInfo,TMEngClassInfo)
+#if defined(CIDMACROENG_NETDBCLASSES)
 RTTIDecls(TMEngHTTPClientVal,TMEngClassVal)
 RTTIDecls(TMEngHTTPClientInfo,TMEngClassInfo)
+#endif
 RTTIDecls(TMEngURLVal,TMEngClassVal)
 RTTIDecls(TMEngURLInfo,TMEngClassInfo)
 
@@ -235,6 +237,7 @@ TMEngDataSrcVal::SetSockTCP(const TIPEndPoint& ipepTar, const tCIDLib::TBoolean
         // Create ourselves a new source
         if (bSecure)
         {
+            #if defined(CIDMACROENG_NETDBCLASSES)
             //
             //  Create the socket in this case and directly and pass it to the
             //  secure channel data source, who will adopt it.
@@ -250,6 +253,17 @@ TMEngDataSrcVal::SetSockTCP(const TIPEndPoint& ipepTar, const tCIDLib::TBoolean
                 , tCIDSChan::EConnOpts::None
                 , ipepTar.strHostName()
             );
+            #else
+            // The secure channel support comes in via CIDNet, which we don't have here
+            facCIDMacroEng().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kMEngErrs::errcRT_NoSecureSock
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::NotSupported
+            );
+            #endif
         }
          else
         {
@@ -717,6 +731,8 @@ TMEngDataSrcInfo::ThrowAnErr(TCIDMacroEngine& meOwner, const tCIDLib::TCard4 c4T
 
 
 
+#if defined(CIDMACROENG_NETDBCLASSES)
+
 // ---------------------------------------------------------------------------
 //  CLASS: TMEngHTTPClientVal
 // PREFIX: mecv
@@ -2894,6 +2910,9 @@ TMEngHTTPClientInfo::ThrowAnErr(        TCIDMacroEngine&    meOwner
 
 
 
+#endif
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TMEngURLVal
 // PREFIX: mecv
@@ -258,6 +258,7 @@ class TMEngDataSrcInfo : public TMEngClassInfo
 
 
 
+#if defined(CIDMACROENG_NETDBCLASSES)
 // ---------------------------------------------------------------------------
 //  CLASS: TMEngHTTPClientVal
 // PREFIX: mecv
@@ -471,6 +472,7 @@ class TMEngHTTPClientInfo : public TMEngClassInfo
         // -------------------------------------------------------------------
         RTTIDefs(TMEngHTTPClientInfo,TMEngClassInfo)
 };
+#endif
 
 
 
@@ -522,6 +522,19 @@ TMEngOpCode::Format(TTextOutStream& strmTarget, const TCIDMacroEngine& meOwner)
             strmTarget  << sfmtData
                         << m_uStorage.ac2Indices[0]
                         << m_uStorage.ac2Indices[1];
+
+            // If the optimizer folded in any pops, show those
+            if (m_uStorage.ac2Indices[2])
+                strmTarget << sfmtData << m_uStorage.ac2Indices[2];
+            break;
+        }
+
+        case tCIDMacroEng::EOpCodes::CondJumpPop :
+        case tCIDMacroEng::EOpCodes::NotCondJumpPop :
+        {
+            strmTarget  << sfmtData
+                        << m_uStorage.c4Immediate
+                        << m_uStorage.ac2Indices[2];
             break;
         }
 
@@ -583,6 +596,11 @@ TMEngOpCode::Format(TTextOutStream& strmTarget, const TCIDMacroEngine& meOwner)
         case tCIDMacroEng::EOpCodes::CallExcept :
         case tCIDMacroEng::EOpCodes::CallParent :
         case tCIDMacroEng::EOpCodes::CallThis :
+            strmTarget << sfmtData << m_uStorage.ac2Indices[0];
+            if (m_uStorage.ac2Indices[2])
+                strmTarget << sfmtData << m_uStorage.ac2Indices[2];
+            break;
+
         case tCIDMacroEng::EOpCodes::PushLocal :
         case tCIDMacroEng::EOpCodes::PushMember :
         case tCIDMacroEng::EOpCodes::PushParm :
@@ -606,6 +624,7 @@ TMEngOpCode::Format(TTextOutStream& strmTarget, const TCIDMacroEngine& meOwner)
         case tCIDMacroEng::EOpCodes::NoOp :
         case tCIDMacroEng::EOpCodes::PopTop :
         case tCIDMacroEng::EOpCodes::PopToReturn :
+        case tCIDMacroEng::EOpCodes::PopUnder :
         case tCIDMacroEng::EOpCodes::PushCurLine :
         case tCIDMacroEng::EOpCodes::PushException :
         case tCIDMacroEng::EOpCodes::PushThis :
@@ -629,6 +648,20 @@ TMEngOpCode::SetOpCode(const tCIDMacroEng::EOpCodes eOpCode)
 }
 
 
+//
+//  Used by the optimizer to update a single index without disturbing the
+//  others, since it folds extra info into the unused ones of some opcodes.
+//
+tCIDLib::TVoid
+TMEngOpCode::SetIndex(  const   tCIDLib::TCard4 c4Index
+                        , const tCIDLib::TCard2 c2ToSet)
+{
+    if (c4Index >= kCIDMacroEng::c4OpIndices)
+        BadIndex(c4Index);
+    m_uStorage.ac2Indices[c4Index] = c2ToSet;
+}
+
+
 tCIDLib::TVoid
 TMEngOpCode::SetSingleIndex(const   tCIDMacroEng::EOpCodes eOpCode
                                 , const tCIDLib::TCard2     c2Index)
@@ -771,3 +804,47 @@ tCIDLib::TVoid TMEngOpCode::BadIndex(const tCIDLib::TCard4 c4Index) const
 }
 
 
+
+
+
+// ---------------------------------------------------------------------------
+//  Global operators
+// ---------------------------------------------------------------------------
+
+//
+//  These are used by the compiled class cache. We just write out the opcode
+//  and the storage as its raw indices, since that covers the whole union and
+//  we don't have to care which member is active. The cache is only ever read
+//  back on the same machine that wrote it.
+//
+TBinOutStream&
+operator<<(TBinOutStream& strmTarget, const TMEngOpCode& meopToWrite)
+{
+    strmTarget.WriteEnum(tCIDLib::c4EnumOrd(meopToWrite.m_eOpCode));
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < kCIDMacroEng::c4OpIndices; c4Index++)
+        strmTarget << meopToWrite.m_uStorage.ac2Indices[c4Index];
+    return strmTarget;
+}
+
+TBinInStream&
+operator>>(TBinInStream& strmSrc, TMEngOpCode& meopToFill)
+{
+    const tCIDMacroEng::EOpCodes eOpCode = tCIDMacroEng::EOpCodes(strmSrc.c4ReadEnum());
+    if (!tCIDMacroEng::bIsValidEnum(eOpCode))
+    {
+        facCIDMacroEng().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMEngErrs::errcCache_BadFormat
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+            , TString(L"opcode")
+        );
+    }
+
+    meopToFill.m_eOpCode = eOpCode;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < kCIDMacroEng::c4OpIndices; c4Index++)
+        strmSrc >> meopToFill.m_uStorage.ac2Indices[c4Index];
+    return strmSrc;
+}
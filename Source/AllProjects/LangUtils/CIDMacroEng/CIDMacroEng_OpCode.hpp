@@ -180,6 +180,12 @@ class CIDMACROENGEXP TMEngOpCode
             const   tCIDMacroEng::EOpCodes  eOpCode
         );
 
+        tCIDLib::TVoid SetIndex
+        (
+            const   tCIDLib::TCard4         c4Index
+            , const tCIDLib::TCard2         c2ToSet
+        );
+
         tCIDLib::TVoid SetSingleIndex
         (
             const   tCIDMacroEng::EOpCodes  eOpCode
@@ -270,6 +276,18 @@ class CIDMACROENGEXP TMEngOpCode
             , const TMEngOpCode&            meopToFormat
         );
 
+        friend TBinOutStream& operator<<
+        (
+                    TBinOutStream&          strmToWriteTo
+            , const TMEngOpCode&            meopToWrite
+        );
+
+        friend TBinInStream& operator>>
+        (
+                    TBinInStream&           strmToReadFrom
+            ,       TMEngOpCode&            meopToFill
+        );
+
 
     private :
         // -------------------------------------------------------------------
@@ -326,3 +344,9 @@ class CIDMACROENGEXP TMEngOpCode
 TTextOutStream&
 operator<<(TTextOutStream& strmTarget, const TMEngOpCode& meopToFormat);
 
+TBinOutStream&
+operator<<(TBinOutStream& strmTarget, const TMEngOpCode& meopToWrite);
+
+TBinInStream&
+operator>>(TBinInStream& strmSrc, TMEngOpCode& meopToFill);
+
@@ -415,6 +415,8 @@ TMacroEngParser::TMacroEngParser(const tCIDMacroEng::EOptLevels eOpt) :
     , m_colFlowStack()
     , m_colMatches(tCIDLib::EAdoptOpts::NoAdopt, 8)
     , m_eOptLevel(eOpt)
+    , m_fcolCompCounts(32)
+    , m_fcolCompIds(32)
     , m_pitResData()
     , m_pmecmToUse(nullptr)
     , m_pmeehToUse(nullptr)
@@ -446,6 +448,13 @@ TMacroEngParser::bParse(const   TString&                    strClassPath
     m_pmeehToUse = pmeehToUse;
     m_pmeTarget  = pmeTarget;
 
+    //
+    //  See if we can just reload the compiled results from a previous parse.
+    //  If this fails, it will have left the engine reset.
+    //
+    if (bLoadCompiled(strClassPath, pmeciMainClass))
+        return kCIDLib::True;
+
     // Try to load the initial class
     TParserSrc psrcMain
     (
@@ -457,6 +466,8 @@ TMacroEngParser::bParse(const   TString&                    strClassPath
     // Reset the engine and any of our data members that need it
     m_pmeTarget->Reset();
     m_colFlowStack.RemoveAll();
+    m_fcolCompCounts.RemoveAll();
+    m_fcolCompIds.RemoveAll();
 
     // Clear the error count before we start the parse
     m_c4ErrCount = 0;
@@ -466,8 +477,13 @@ TMacroEngParser::bParse(const   TString&                    strClassPath
     //  class, and all of the classes that it imports. When it get's back, it
     //  returns us the top level class, if no errors occur.
     //
+    const tCIDLib::TCard4 c4FirstClassId = m_pmeTarget->c4ClassCount();
     pmeciMainClass = pmeciParseClass(psrcMain);
 
+    // If it worked, store the compiled results for next time
+    if (pmeciMainClass && !m_c4ErrCount)
+        StoreCompiled(strClassPath, *pmeciMainClass, c4FirstClassId);
+
     // Indicate whether errors occured or not
     return (m_c4ErrCount == 0);
 }
@@ -543,6 +559,19 @@ TMacroEngParser::bParse(const   TString&                    strClassPath
 // ---------------------------------------------------------------------------
 //  TMacroEngParser: Private, non-virtual methods
 // ---------------------------------------------------------------------------
+
+//
+//  At the maximum optimization level, if there's no debugger that needs to
+//  see them, we let the optimizer strip out the current line opcodes.
+//
+tCIDLib::TBoolean TMacroEngParser::bStripLines() const
+{
+    return (m_eOptLevel == tCIDMacroEng::EOptLevels::Maximum)
+           && !m_pmeTarget->pmedbgToUse()
+           && !m_pmeTarget->bInIDE();
+}
+
+
 TMEngClassInfo&
 TMacroEngParser::meciResolvePath(const TParserSrc& psrcClass, const TString& strPath)
 {
@@ -595,6 +624,35 @@ TMacroEngParser::meciResolvePath(const TParserSrc& psrcClass, const TString& str
 }
 
 
+//
+//  Once a class is complete, this is called to optimize the opcodes of its
+//  methods and resolve the call targets that can be known up front. If the
+//  class came from the compiled class cache, the opcodes were already done
+//  so we just have to resolve the calls again, since those are pointers.
+//
+tCIDLib::TVoid
+TMacroEngParser::OptimizeClass(         TMEngClassInfo&     meciTarget
+                                , const tCIDLib::TBoolean   bCached)
+{
+    if (m_eOptLevel < tCIDMacroEng::EOptLevels::Medium)
+        return;
+
+    const tCIDLib::TBoolean bStrip = bStripLines();
+    const tCIDLib::TCard4 c4Count = meciTarget.m_colMethodImpls.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TMEngMethodImpl* pmethCur = meciTarget.m_colMethodImpls[c4Index];
+        if (pmethCur->clsIsA() != TMEngOpMethodImpl::clsThis())
+            continue;
+
+        TMEngOpMethodImpl* pmethOp = static_cast<TMEngOpMethodImpl*>(pmethCur);
+        if (!bCached)
+            pmethOp->c4Optimize(bStrip);
+        pmethOp->ResolveCalls(*m_pmeTarget, meciTarget);
+    }
+}
+
+
 TMEngClassInfo*
 TMacroEngParser::pmeciCheckClassLoad(const  TParserSrc& psrcClass
                                     , const TString&    strClassPath)
@@ -879,6 +937,17 @@ TMEngClassInfo* TMacroEngParser::pmeciParseClass(TParserSrc& psrcClass)
 
         // Do some standard validation
         ValidateClass(psrcClass, *pmeciRet);
+
+        // If there were no errors, optimize it if asked to
+        if (!m_c4ErrCount)
+            OptimizeClass(*pmeciRet, kCIDLib::False);
+
+        //
+        //  Remember where this one completed, relative to the classes that
+        //  have been registered, for the compiled class cache.
+        //
+        m_fcolCompIds.c4AddElement(pmeciRet->c2Id());
+        m_fcolCompCounts.c4AddElement(m_pmeTarget->c4ClassCount());
     }
 
     catch(TError& errToCatch)
@@ -40,6 +40,12 @@
 //  the higher level parsing helper classes that use a passed parser source
 //  object to do their work.
 //
+//  If the class manager supports it, the compiled results of a parse (the
+//  main class and everything it imported) are stored, and the next parse of
+//  that class will just reload them if none of the source has changed and the
+//  engine and parse options are the same. That's handled in the ParserCache
+//  file.
+//
 //  We also use a string pool for temp strings, in order to maintain sanity
 //  in this recursive environment. Like the parser source we forward ref it
 //  and keep it's impl internal.
@@ -129,6 +135,8 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
         using TMatchList    = TRefVector<TMEngClassInfo>;
         using TFlowStack    = TStack<TMEngFlowCtrlItem>;
         using TClassStack   = TStack<TString>;
+        using TCountList    = TFundVector<tCIDLib::TCard4>;
+        using TIdList       = TFundVector<tCIDLib::TCard2>;
 
 
         // -------------------------------------------------------------------
@@ -265,6 +273,12 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
                     TMEngFlowCtrlItem*&     pmefciToFill
         );
 
+        tCIDLib::TBoolean bLoadCompiled
+        (
+            const   TString&                strClassPath
+            ,       TMEngClassInfo*&        pmeciMainClass
+        );
+
         tCIDLib::TBoolean bPushNumericLiteral
         (
                     TParserSrc&             psrcClass
@@ -273,6 +287,8 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
             ,       tCIDLib::TCard2&        c2ClassId
         );
 
+        tCIDLib::TBoolean bStripLines() const;
+
         tCIDLib::TCard2 c2FindCorrectCtor
         (
                     TParserSrc&             psrcClass
@@ -408,12 +424,24 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
             const   TParserSrc&             psrcClass
         );
 
+        tCIDLib::TVoid LoadCompiledClass
+        (
+                    TBinInStream&           strmSrc
+            ,       TMEngClassInfo&         meciToFill
+        );
+
         TMEngClassInfo& meciResolvePath
         (
             const   TParserSrc&             psrcClass
             , const TString&                strPath
         );
 
+        tCIDLib::TVoid OptimizeClass
+        (
+                    TMEngClassInfo&         meciTarget
+            , const tCIDLib::TBoolean       bCached
+        );
+
         TMEngClassInfo* pmeciCheckClassLoad
         (
             const   TParserSrc&             psrcClass
@@ -535,6 +563,19 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
             ,       TMEngClassInfo&         meciTarget
         );
 
+        tCIDLib::TVoid StoreCompiled
+        (
+            const   TString&                strClassPath
+            , const TMEngClassInfo&         meciMainClass
+            , const tCIDLib::TCard4         c4FirstClassId
+        );
+
+        tCIDLib::TVoid StoreCompiledClass
+        (
+                    TBinOutStream&          strmTar
+            , const TMEngClassInfo&         meciSrc
+        );
+
         tCIDLib::TVoid ThrowUnrecoverable();
 
         tCIDLib::TVoid ValidateClass
@@ -579,6 +620,13 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
         //      fly, we use this temp one. Parsing is single threaded per
         //      parser instance, so this is fine.
         //
+        //  m_fcolCompCounts
+        //  m_fcolCompIds
+        //      As each parsed class is completed, we store its id and the number
+        //      of classes registered at that point. The compiled class cache uses
+        //      this to play back the class setup in the same order that the parse
+        //      did it, so that all of the class ids come out the same.
+        //
         //  m_meopToUse
         //      A temp opcode object to use for all opcode generation. We
         //      never need more than one at a time, so it's better to use
@@ -613,6 +661,8 @@ class CIDMACROENGEXP TMacroEngParser : public TObject
         TFlowStack                  m_colFlowStack;
         TMatchList                  m_colMatches;
         tCIDMacroEng::EOptLevels    m_eOptLevel;
+        TCountList                  m_fcolCompCounts;
+        TIdList                     m_fcolCompIds;
         TMEngOpCode                 m_meopToUse;
         tCIDMacroEng::TParmIdTable  m_pitResData;
         MMEngClassMgr*              m_pmecmToUse;
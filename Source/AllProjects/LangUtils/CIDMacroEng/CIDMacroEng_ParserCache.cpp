@@ -0,0 +1,1102 @@
+//
+// FILE NAME: CIDMacroEng_ParserCache.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file handles the compiled class cache part of the parser. After a
+//  successful parse we stream out everything the parse created, i.e. the
+//  classes it registered and the contents of the ones it compiled. On a later
+//  parse of the same class, if the class manager gives us back that data, and
+//  the source of all of the compiled classes hashes the same, and the engine
+//  and parser options are the same, we just play it back instead of parsing.
+//
+//  We don't write out the class objects directly. We write out an ordered
+//  list of events, class registrations and class completions, in the same
+//  order that the parse did them. So each class gets the same id that it did
+//  during the parse, and all of the class ids in the opcodes are still good.
+//  We verify that as we go.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Any warnings issued during the original parse are not issued again
+//      when loading from the cache. Errors are not a concern since we never
+//      store the results of a parse that had errors.
+//
+//  2)  The opcodes are written in their raw form, so if the opcode set changes
+//      the format version must be bumped.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDMacroEng_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDMacroEng_ParserCache
+    {
+        //
+        //  The events we store. A class is registered when it gets its id and
+        //  completed when the parse of its contents is done.
+        //
+        enum class EEvents : tCIDLib::TCard1
+        {
+            Register    = 1
+            , Complete  = 2
+        };
+
+        //
+        //  The types of classes we can register. External classes are just
+        //  loaded again by path. Std classes are the ones we compiled, and the
+        //  others are nested types of those.
+        //
+        enum class EClassTypes : tCIDLib::TCard1
+        {
+            External    = 1
+            , Std       = 2
+            , Enum      = 3
+            , Vector    = 4
+            , Array     = 5
+        };
+
+
+        tCIDLib::TVoid ThrowBadFmt(const tCIDLib::TCh* const pszWhat)
+        {
+            facCIDMacroEng().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kMEngErrs::errcCache_BadFormat
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+                , TString(pszWhat)
+            );
+        }
+
+        tCIDLib::TVoid ThrowNotCacheable(const TString& strClassPath)
+        {
+            facCIDMacroEng().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kMEngErrs::errcCache_NotCacheable
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::NotSupported
+                , strClassPath
+            );
+        }
+
+
+        //
+        //  Make sure that the class registered at the indicated id is the one
+        //  we expected.
+        //
+        tCIDLib::TVoid CheckClassId(        TCIDMacroEngine&    meTarget
+                                    , const tCIDLib::TCard2     c2Id
+                                    , const TString&            strClassPath)
+        {
+            if ((meTarget.c4ClassCount() <= c2Id)
+            ||  (meTarget.meciFind(c2Id).strClassPath() != strClassPath))
+            {
+                facCIDMacroEng().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kMEngErrs::errcCache_IdMismatch
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::Format
+                    , strClassPath
+                    , TCardinal(meTarget.c2FindClassId(strClassPath, kCIDLib::False))
+                    , TCardinal(c2Id)
+                );
+            }
+        }
+
+
+        //
+        //  Hash the source of a class, as the class manager gives it to us. We
+        //  go by lines so that line ending differences don't matter.
+        //
+        tCIDLib::TBoolean bHashSource(          MMEngClassMgr&  mecmSrc
+                                        , const TString&        strClassPath
+                                        ,       TSHA1Hash&      mhashToFill)
+        {
+            TTextInStream* pstrmSrc = mecmSrc.pstrmLoadClass
+            (
+                strClassPath, tCIDMacroEng::EResModes::ReadOnly
+            );
+            if (!pstrmSrc)
+                return kCIDLib::False;
+            TJanitor<TTextInStream> janSrc(pstrmSrc);
+
+            TSHA1Hasher mdigSrc;
+            mdigSrc.StartNew();
+
+            TString strLine;
+            while (!pstrmSrc->bEndOfStream())
+            {
+                pstrmSrc->c4GetLine(strLine);
+                mdigSrc.DigestStr(strLine);
+                mdigSrc.DigestText(L"\n", 1);
+            }
+            mdigSrc.Complete(mhashToFill);
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Values only show up as literals and switch case values, so they are
+        //  always one of the literal intrinsic types or an enum value.
+        //
+        tCIDLib::TVoid StoreValue(          TBinOutStream&  strmTar
+                                    , const TMEngClassVal&  mecvSrc
+                                    , const TString&        strClassPath)
+        {
+            strmTar << mecvSrc.strName() << mecvSrc.c2ClassId();
+
+            if (mecvSrc.bIsDescendantOf(TMEngEnumVal::clsThis()))
+            {
+                const TMEngEnumVal& mecvEnum = static_cast<const TMEngEnumVal&>(mecvSrc);
+                strmTar << kCIDLib::True
+                        << mecvEnum.c4MaxOrdinal()
+                        << mecvEnum.c4Ordinal();
+                return;
+            }
+            strmTar << kCIDLib::False;
+
+            switch(tCIDMacroEng::EIntrinsics(mecvSrc.c2ClassId()))
+            {
+                case tCIDMacroEng::EIntrinsics::Boolean :
+                    strmTar << static_cast<const TMEngBooleanVal&>(mecvSrc).bValue();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Char :
+                    strmTar << static_cast<const TMEngCharVal&>(mecvSrc).chValue();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::String :
+                    strmTar << static_cast<const TMEngStringVal&>(mecvSrc).strValue();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Card1 :
+                    strmTar << static_cast<const TMEngCard1Val&>(mecvSrc).c1Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Card2 :
+                    strmTar << static_cast<const TMEngCard2Val&>(mecvSrc).c2Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Card4 :
+                    strmTar << static_cast<const TMEngCard4Val&>(mecvSrc).c4Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Card8 :
+                    strmTar << static_cast<const TMEngCard8Val&>(mecvSrc).c8Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Float4 :
+                    strmTar << static_cast<const TMEngFloat4Val&>(mecvSrc).f4Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Float8 :
+                    strmTar << static_cast<const TMEngFloat8Val&>(mecvSrc).f8Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Int1 :
+                    strmTar << static_cast<const TMEngInt1Val&>(mecvSrc).i1Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Int2 :
+                    strmTar << static_cast<const TMEngInt2Val&>(mecvSrc).i2Value();
+                    break;
+
+                case tCIDMacroEng::EIntrinsics::Int4 :
+                    strmTar << static_cast<const TMEngInt4Val&>(mecvSrc).i4Value();
+                    break;
+
+                default :
+                    ThrowNotCacheable(strClassPath);
+                    break;
+            };
+        }
+
+        [[nodiscard]] TMEngClassVal* pmecvLoadValue(TBinInStream& strmSrc)
+        {
+            const tCIDMacroEng::EConstTypes eConst = tCIDMacroEng::EConstTypes::Const;
+
+            TString             strName;
+            tCIDLib::TCard2     c2ClassId;
+            tCIDLib::TBoolean   bEnum;
+            strmSrc >> strName >> c2ClassId >> bEnum;
+
+            if (bEnum)
+            {
+                tCIDLib::TCard4 c4MaxOrdinal;
+                tCIDLib::TCard4 c4Ordinal;
+                strmSrc >> c4MaxOrdinal >> c4Ordinal;
+                if (c4Ordinal > c4MaxOrdinal)
+                    ThrowBadFmt(L"enum value");
+
+                return new TMEngEnumVal(strName, c2ClassId, eConst, c4MaxOrdinal, c4Ordinal);
+            }
+
+            TMEngClassVal* pmecvRet = nullptr;
+            switch(tCIDMacroEng::EIntrinsics(c2ClassId))
+            {
+                case tCIDMacroEng::EIntrinsics::Boolean :
+                {
+                    tCIDLib::TBoolean bVal;
+                    strmSrc >> bVal;
+                    pmecvRet = new TMEngBooleanVal(strName, eConst, bVal);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Char :
+                {
+                    tCIDLib::TCh chVal;
+                    strmSrc >> chVal;
+                    pmecvRet = new TMEngCharVal(strName, eConst, chVal);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::String :
+                {
+                    TString strVal;
+                    strmSrc >> strVal;
+                    pmecvRet = new TMEngStringVal(strName, eConst, strVal);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Card1 :
+                {
+                    tCIDLib::TCard1 c1Val;
+                    strmSrc >> c1Val;
+                    pmecvRet = new TMEngCard1Val(strName, eConst, c1Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Card2 :
+                {
+                    tCIDLib::TCard2 c2Val;
+                    strmSrc >> c2Val;
+                    pmecvRet = new TMEngCard2Val(strName, eConst, c2Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Card4 :
+                {
+                    tCIDLib::TCard4 c4Val;
+                    strmSrc >> c4Val;
+                    pmecvRet = new TMEngCard4Val(strName, eConst, c4Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Card8 :
+                {
+                    tCIDLib::TCard8 c8Val;
+                    strmSrc >> c8Val;
+                    pmecvRet = new TMEngCard8Val(strName, eConst, c8Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Float4 :
+                {
+                    tCIDLib::TFloat4 f4Val;
+                    strmSrc >> f4Val;
+                    pmecvRet = new TMEngFloat4Val(strName, eConst, f4Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Float8 :
+                {
+                    tCIDLib::TFloat8 f8Val;
+                    strmSrc >> f8Val;
+                    pmecvRet = new TMEngFloat8Val(strName, eConst, f8Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Int1 :
+                {
+                    tCIDLib::TInt1 i1Val;
+                    strmSrc >> i1Val;
+                    pmecvRet = new TMEngInt1Val(strName, eConst, i1Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Int2 :
+                {
+                    tCIDLib::TInt2 i2Val;
+                    strmSrc >> i2Val;
+                    pmecvRet = new TMEngInt2Val(strName, eConst, i2Val);
+                    break;
+                }
+
+                case tCIDMacroEng::EIntrinsics::Int4 :
+                {
+                    tCIDLib::TInt4 i4Val;
+                    strmSrc >> i4Val;
+                    pmecvRet = new TMEngInt4Val(strName, eConst, i4Val);
+                    break;
+                }
+
+                default :
+                    ThrowBadFmt(L"value type");
+                    break;
+            };
+            return pmecvRet;
+        }
+
+
+        //
+        //  Write out the info required to register a class again. We figure
+        //  out what type it is. If it's not one we compiled, or a nested type
+        //  of one we compiled, then it's external.
+        //
+        tCIDLib::TVoid StoreRegister(       TBinOutStream&      strmTar
+                                    ,       TCIDMacroEngine&    meSrc
+                                    , const TMEngClassInfo&     meciSrc
+                                    , const tCIDLib::TCard4     c4FirstClassId)
+        {
+            EClassTypes eType = EClassTypes::External;
+            if (meciSrc.clsIsA() == TMEngStdClassInfo::clsThis())
+            {
+                eType = EClassTypes::Std;
+            }
+             else
+            {
+                const TMEngClassInfo* pmeciBase = meSrc.pmeciFind(meciSrc.strBasePath());
+                if (pmeciBase
+                &&  (pmeciBase->c2Id() >= c4FirstClassId)
+                &&  (pmeciBase->clsIsA() == TMEngStdClassInfo::clsThis()))
+                {
+                    if (meciSrc.clsIsA() == TMEngEnumInfo::clsThis())
+                        eType = EClassTypes::Enum;
+                    else if (meciSrc.clsIsA() == TMEngVectorInfo::clsThis())
+                        eType = EClassTypes::Vector;
+                    else if (meciSrc.clsIsA() == TMEngArrayInfo::clsThis())
+                        eType = EClassTypes::Array;
+                    else
+                        ThrowNotCacheable(meciSrc.strClassPath());
+                }
+            }
+
+            strmTar << tCIDLib::TCard1(eType) << meciSrc.strClassPath();
+            if (eType == EClassTypes::External)
+                return;
+
+            strmTar << meciSrc.strName()
+                    << meciSrc.strBasePath()
+                    << meciSrc.strParentClassPath();
+
+            if (eType == EClassTypes::Enum)
+            {
+                const TMEngEnumInfo& meciEnum = static_cast<const TMEngEnumInfo&>(meciSrc);
+                const tCIDLib::TCard4 c4Count = meciEnum.c4ValueCount();
+                strmTar << c4Count;
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+                {
+                    strmTar << meciEnum.strItemName(c4Index)
+                            << meciEnum.strTextValue(c4Index);
+                }
+            }
+             else if ((eType == EClassTypes::Vector) || (eType == EClassTypes::Array))
+            {
+                strmTar << static_cast<const TMEngColBaseInfo&>(meciSrc).c2ElemId();
+            }
+        }
+
+
+        //
+        //  Play back a registration. External classes may already have been
+        //  loaded as a side effect of loading some other external class, so
+        //  we only load them if not.
+        //
+        tCIDLib::TVoid LoadRegister(        TBinInStream&       strmSrc
+                                    ,       TCIDMacroEngine&    meTarget
+                                    , const tCIDLib::TCard2     c2Id)
+        {
+            tCIDLib::TCard1 c1Type;
+            TString         strClassPath;
+            strmSrc >> c1Type >> strClassPath;
+
+            const EClassTypes eType = EClassTypes(c1Type);
+            if (eType == EClassTypes::External)
+            {
+                if (meTarget.c4ClassCount() <= c2Id)
+                {
+                    if (!meTarget.pmeciLoadExternalClass(strClassPath))
+                        ThrowBadFmt(L"external class");
+                }
+                CheckClassId(meTarget, c2Id, strClassPath);
+                return;
+            }
+
+            TString strName;
+            TString strBasePath;
+            TString strParentPath;
+            strmSrc >> strName >> strBasePath >> strParentPath;
+
+            if (eType == EClassTypes::Std)
+            {
+                TMEngStdClassInfo* pmeciNew = new TMEngStdClassInfo
+                (
+                    strName, strBasePath, meTarget, strParentPath
+                );
+                TJanitor<TMEngStdClassInfo> janNew(pmeciNew);
+                pmeciNew->BaseClassInit(meTarget);
+                meTarget.c2AddClass(janNew.pobjOrphan());
+            }
+             else if (eType == EClassTypes::Enum)
+            {
+                tCIDLib::TCard4 c4Count;
+                strmSrc >> c4Count;
+
+                TMEngEnumInfo* pmeciNew = new TMEngEnumInfo
+                (
+                    meTarget, strName, strBasePath, strParentPath, c4Count
+                );
+                TJanitor<TMEngEnumInfo> janNew(pmeciNew);
+
+                TString strItem;
+                TString strText;
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+                {
+                    strmSrc >> strItem >> strText;
+                    pmeciNew->c4AddEnumItem(strItem, strText);
+                }
+                pmeciNew->BaseClassInit(meTarget);
+                meTarget.c2AddClass(janNew.pobjOrphan());
+            }
+             else if ((eType == EClassTypes::Vector) || (eType == EClassTypes::Array))
+            {
+                tCIDLib::TCard2 c2ElemId;
+                strmSrc >> c2ElemId;
+                if (c2ElemId >= meTarget.c4ClassCount())
+                    ThrowBadFmt(L"element type");
+
+                TMEngColBaseInfo* pmeciNew = nullptr;
+                if (eType == EClassTypes::Vector)
+                {
+                    pmeciNew = new TMEngVectorInfo
+                    (
+                        meTarget, strName, strBasePath, strParentPath, c2ElemId
+                    );
+                }
+                 else
+                {
+                    pmeciNew = new TMEngArrayInfo
+                    (
+                        meTarget, strName, strBasePath, strParentPath, c2ElemId
+                    );
+                }
+                TJanitor<TMEngColBaseInfo> janNew(pmeciNew);
+                pmeciNew->BaseClassInit(meTarget);
+                meTarget.c2AddClass(janNew.pobjOrphan());
+            }
+             else
+            {
+                ThrowBadFmt(L"class type");
+            }
+            CheckClassId(meTarget, c2Id, strClassPath);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMacroEngParser: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Called at the start of a parse. If the class manager has compiled data for
+//  this class, and it's still valid, we load it up and return true. Else we
+//  return false and the caller does a regular parse. If we fail part way
+//  through, we reset the engine again so it's as though we never tried.
+//
+tCIDLib::TBoolean
+TMacroEngParser::bLoadCompiled( const   TString&            strClassPath
+                                ,       TMEngClassInfo*&    pmeciMainClass)
+{
+    THeapBuf mbufData(32 * 1024);
+    tCIDLib::TCard4 c4Bytes = 0;
+    if (!m_pmecmToUse->bLoadCompiled(strClassPath, mbufData, c4Bytes) || !c4Bytes)
+        return kCIDLib::False;
+
+    tCIDLib::TBoolean bReset = kCIDLib::False;
+    try
+    {
+        TBinMBufInStream strmSrc(&mbufData, c4Bytes);
+
+        //
+        //  Check the header info. If any of this is different, it's not an
+        //  error, the data is just out of date, so we just return false.
+        //
+        strmSrc.CheckForStartMarker(CID_FILE, CID_LINE);
+
+        tCIDLib::TCard1 c1FmtVersion;
+        strmSrc >> c1FmtVersion;
+        if (c1FmtVersion != kCIDMacroEng_::c1CacheFmtVersion)
+            return kCIDLib::False;
+
+        tCIDLib::TCard4 c4MajVer, c4MinVer, c4Revision;
+        strmSrc >> c4MajVer >> c4MinVer >> c4Revision;
+        if ((c4MajVer != kCIDLib::c4MajVersion)
+        ||  (c4MinVer != kCIDLib::c4MinVersion)
+        ||  (c4Revision != kCIDLib::c4Revision))
+        {
+            return kCIDLib::False;
+        }
+
+        const tCIDMacroEng::EOptLevels eOptLevel = tCIDMacroEng::EOptLevels(strmSrc.c4ReadEnum());
+        tCIDLib::TBoolean bDebugMode, bValidation;
+        TString strDynRef, strMainPath;
+        tCIDLib::TBoolean bStripped;
+        strmSrc >> bStripped >> bDebugMode >> bValidation >> strDynRef >> strMainPath;
+        if ((eOptLevel != m_eOptLevel)
+        ||  (bStripped != bStripLines())
+        ||  (bDebugMode != m_pmeTarget->bDebugMode())
+        ||  (bValidation != m_pmeTarget->bValidation())
+        ||  (strDynRef != m_pmeTarget->strSpecialDynRef())
+        ||  (strMainPath != strClassPath))
+        {
+            return kCIDLib::False;
+        }
+
+        tCIDLib::TCard4 c4FirstClassId, c4ClassCount;
+        strmSrc >> c4FirstClassId >> c4ClassCount;
+
+        // Check the source of all of the compiled classes against the hashes
+        tCIDLib::TCard4 c4SrcCount;
+        strmSrc >> c4SrcCount;
+
+        TString     strSrcPath;
+        TSHA1Hash   mhashStored;
+        TSHA1Hash   mhashCur;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SrcCount; c4Index++)
+        {
+            strmSrc >> strSrcPath >> mhashStored;
+            if (!CIDMacroEng_ParserCache::bHashSource(*m_pmecmToUse, strSrcPath, mhashCur)
+            ||  (mhashCur != mhashStored))
+            {
+                return kCIDLib::False;
+            }
+        }
+        strmSrc.CheckForFrameMarker(CID_FILE, CID_LINE);
+
+        //
+        //  It's good, so reset the engine and our own stuff, and make sure we
+        //  start at the same class id as the original parse did.
+        //
+        m_pmeTarget->Reset();
+        m_colFlowStack.RemoveAll();
+        m_c4ErrCount = 0;
+        bReset = kCIDLib::True;
+
+        if (m_pmeTarget->c4ClassCount() != c4FirstClassId)
+            CIDMacroEng_ParserCache::ThrowBadFmt(L"first class id");
+
+        // And play back the events
+        tCIDLib::TCard4 c4EvCount;
+        strmSrc >> c4EvCount;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4EvCount; c4Index++)
+        {
+            tCIDLib::TCard1 c1Event;
+            tCIDLib::TCard2 c2Id;
+            strmSrc >> c1Event >> c2Id;
+
+            const auto eEvent = CIDMacroEng_ParserCache::EEvents(c1Event);
+
+            if (eEvent == CIDMacroEng_ParserCache::EEvents::Register)
+            {
+                CIDMacroEng_ParserCache::LoadRegister(strmSrc, *m_pmeTarget, c2Id);
+            }
+             else if (eEvent == CIDMacroEng_ParserCache::EEvents::Complete)
+            {
+                TMEngClassInfo& meciTar = m_pmeTarget->meciFind(c2Id);
+                if (meciTar.clsIsA() != TMEngStdClassInfo::clsThis())
+                    CIDMacroEng_ParserCache::ThrowBadFmt(L"completed class");
+                LoadCompiledClass(strmSrc, meciTar);
+            }
+             else
+            {
+                CIDMacroEng_ParserCache::ThrowBadFmt(L"event");
+            }
+        }
+
+        if (m_pmeTarget->c4ClassCount() != c4ClassCount)
+            CIDMacroEng_ParserCache::ThrowBadFmt(L"class count");
+
+        tCIDLib::TCard2 c2MainId;
+        strmSrc >> c2MainId;
+        strmSrc.CheckForEndMarker(CID_FILE, CID_LINE);
+
+        pmeciMainClass = &m_pmeTarget->meciFind(c2MainId);
+        if (pmeciMainClass->strClassPath() != strClassPath)
+            CIDMacroEng_ParserCache::ThrowBadFmt(L"main class");
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (!errToCatch.bLogged() && facCIDMacroEng().bLogWarnings())
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+
+        pmeciMainClass = nullptr;
+        if (bReset)
+            m_pmeTarget->Reset();
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
+//
+//  Play back the contents of a compiled class. The class was already created
+//  and registered, so it has its inherited methods and members. We just add
+//  the stuff at this level.
+//
+tCIDLib::TVoid
+TMacroEngParser::LoadCompiledClass(TBinInStream& strmSrc, TMEngClassInfo& meciToFill)
+{
+    meciToFill.m_eExtend = tCIDMacroEng::EClassExt(strmSrc.c4ReadEnum());
+
+    tCIDLib::TCard4 c4Count;
+    TString         strName;
+    TString         strValue;
+    tCIDLib::TCard2 c2ClassId;
+
+    // Directives
+    strmSrc >> c4Count;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        strmSrc >> strName >> strValue;
+        meciToFill.AddDirective(strName, strValue);
+    }
+
+    // Imports, including nested types
+    strmSrc >> c4Count;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        tCIDLib::TBoolean bNested;
+        strmSrc >> strName >> bNested;
+        if (bNested)
+            meciToFill.bAddNestedType(strName);
+        else
+            meciToFill.bAddClassImport(strName);
+    }
+
+    // Literals
+    strmSrc >> c4Count;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        strmSrc >> strName >> c2ClassId;
+        meciToFill.AddLiteral
+        (
+            new TMEngLiteralVal
+            (
+                strName, c2ClassId, CIDMacroEng_ParserCache::pmecvLoadValue(strmSrc)
+            )
+        );
+    }
+
+    //
+    //  Method infos. The inherited ones we just update in place, since this
+    //  class may have overridden them. The rest we add and make sure they
+    //  get the same ids.
+    //
+    tCIDLib::TCard2 c2FirstId;
+    strmSrc >> c2FirstId >> c4Count;
+    if (c2FirstId != meciToFill.c2FirstMethodId())
+        CIDMacroEng_ParserCache::ThrowBadFmt(L"first method id");
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        tCIDLib::TBoolean   bCtor;
+        tCIDLib::TCard4     c4ParmCount;
+        strmSrc >> strName >> c2ClassId >> bCtor;
+
+        const tCIDMacroEng::EVisTypes eVis = tCIDMacroEng::EVisTypes(strmSrc.c4ReadEnum());
+        const tCIDMacroEng::EMethExt eExt = tCIDMacroEng::EMethExt(strmSrc.c4ReadEnum());
+        const tCIDMacroEng::EConstTypes eConst = tCIDMacroEng::EConstTypes(strmSrc.c4ReadEnum());
+
+        TMEngMethodInfo methiNew(strName, c2ClassId, eVis, eExt, eConst);
+        methiNew.bIsCtor(bCtor);
+
+        strmSrc >> c4ParmCount;
+        for (tCIDLib::TCard4 c4PInd = 0; c4PInd < c4ParmCount; c4PInd++)
+        {
+            strmSrc >> strValue >> c2ClassId;
+            const tCIDMacroEng::EParmDirs eDir = tCIDMacroEng::EParmDirs(strmSrc.c4ReadEnum());
+            methiNew.c2AddParm(TMEngParmInfo(strValue, c2ClassId, eDir));
+        }
+
+        const tCIDLib::TCard2 c2Id = tCIDLib::TCard2(c4Index);
+        if (c2Id < c2FirstId)
+        {
+            TMEngMethodInfo& methiTar = meciToFill.methiFind(c2Id);
+            if (methiTar.strName() != strName)
+                CIDMacroEng_ParserCache::ThrowBadFmt(L"inherited method");
+            methiTar = methiNew;
+            methiTar.c2Id(c2Id);
+        }
+         else if (meciToFill.c2AddMethodInfo(methiNew) != c2Id)
+        {
+            CIDMacroEng_ParserCache::ThrowBadFmt(L"method id");
+        }
+    }
+
+    // Members at this level
+    strmSrc >> c2FirstId >> c4Count;
+    if ((c2FirstId != meciToFill.c2FirstMemberId())
+    ||  (c4Count < c2FirstId))
+    {
+        CIDMacroEng_ParserCache::ThrowBadFmt(L"first member id");
+    }
+
+    for (tCIDLib::TCard4 c4Index = c2FirstId; c4Index < c4Count; c4Index++)
+    {
+        strmSrc >> strName >> c2ClassId;
+        const tCIDMacroEng::EConstTypes eConst = tCIDMacroEng::EConstTypes(strmSrc.c4ReadEnum());
+
+        const tCIDLib::TCard2 c2Id = meciToFill.c2AddMember
+        (
+            TMEngMemberInfo(strName, c2ClassId, eConst), m_pmeTarget->meciFind(c2ClassId)
+        );
+        if (c2Id != c4Index)
+            CIDMacroEng_ParserCache::ThrowBadFmt(L"member id");
+    }
+
+    // And the method implementations
+    strmSrc >> c4Count;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        tCIDLib::TCard2 c2MethodId;
+        strmSrc >> strName >> c2MethodId;
+
+        TMEngOpMethodImpl* pmethNew = new TMEngOpMethodImpl(strName, c2MethodId);
+        TJanitor<TMEngOpMethodImpl> janImpl(pmethNew);
+
+        tCIDLib::TCard4 c4SubCount;
+        strmSrc >> c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            strmSrc >> strValue >> c2ClassId;
+            const tCIDMacroEng::EConstTypes eConst = tCIDMacroEng::EConstTypes(strmSrc.c4ReadEnum());
+            pmethNew->c2AddLocal(TMEngLocalInfo(strValue, c2ClassId, eConst));
+        }
+
+        // Don't let it find dups, so that the ids come out the same
+        strmSrc >> c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            strmSrc >> strValue;
+            pmethNew->c2AddString(strValue, kCIDLib::False);
+        }
+
+        strmSrc >> c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            TMEngJumpTable& jtblNew = pmethNew->jtblById(pmethNew->c2AddJumpTable());
+
+            tCIDLib::TCard4 c4DefIP, c4CaseCount;
+            strmSrc >> c4DefIP >> c4CaseCount;
+            if (c4DefIP != kCIDLib::c4MaxCard)
+                jtblNew.AddDefaultItem(c4DefIP);
+
+            for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < c4CaseCount; c4CaseInd++)
+            {
+                tCIDLib::TCard4 c4IP;
+                strmSrc >> c4IP;
+                jtblNew.AddItem(c4IP, CIDMacroEng_ParserCache::pmecvLoadValue(strmSrc));
+            }
+        }
+
+        strmSrc >> c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            strmSrc >> m_meopToUse;
+            pmethNew->c4AddOpCode(m_meopToUse);
+        }
+
+        // If the line opcodes were stripped, we get the line map
+        tCIDLib::TBoolean bLineMap;
+        strmSrc >> bLineMap;
+        if (bLineMap)
+        {
+            strmSrc >> c4SubCount;
+            TMEngOpMethodImpl::TLineMap fcolLines(c4SubCount);
+            for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+            {
+                tCIDLib::TCard4 c4Line;
+                strmSrc >> c4Line;
+                fcolLines.c4AddElement(c4Line);
+            }
+            pmethNew->SetLineMap(fcolLines);
+        }
+        meciToFill.AddMethodImpl(janImpl.pobjOrphan());
+    }
+    strmSrc.CheckForFrameMarker(CID_FILE, CID_LINE);
+
+    // Now that all of the methods are there, resolve any direct calls
+    OptimizeClass(meciToFill, kCIDLib::True);
+}
+
+
+//
+//  Called after a successful parse to store the results. We never let this
+//  cause the parse to fail. At worst we log something and the next parse just
+//  does it the long way.
+//
+tCIDLib::TVoid
+TMacroEngParser::StoreCompiled( const   TString&            strClassPath
+                                , const TMEngClassInfo&     meciMainClass
+                                , const tCIDLib::TCard4     c4FirstClassId)
+{
+    try
+    {
+        const tCIDLib::TCard4 c4ClassCount = m_pmeTarget->c4ClassCount();
+        TBinMBufOutStream strmOut(32 * 1024);
+
+        strmOut << tCIDLib::EStreamMarkers::StartObject
+                << kCIDMacroEng_::c1CacheFmtVersion
+                << kCIDLib::c4MajVersion
+                << kCIDLib::c4MinVersion
+                << kCIDLib::c4Revision;
+        strmOut.WriteEnum(tCIDLib::c4EnumOrd(m_eOptLevel));
+        strmOut << bStripLines()
+                << m_pmeTarget->bDebugMode()
+                << m_pmeTarget->bValidation()
+                << m_pmeTarget->strSpecialDynRef()
+                << strClassPath
+                << c4FirstClassId
+                << c4ClassCount;
+
+        //
+        //  The source hashes of all of the classes we compiled. Do them first
+        //  into a temp list so that we know the count.
+        //
+        tCIDLib::TStrList colPaths;
+        TVector<TSHA1Hash> colHashes;
+        TSHA1Hash mhashCur;
+        for (tCIDLib::TCard4 c4Id = c4FirstClassId; c4Id < c4ClassCount; c4Id++)
+        {
+            const TMEngClassInfo& meciCur = m_pmeTarget->meciFind(tCIDLib::TCard2(c4Id));
+            if (meciCur.clsIsA() != TMEngStdClassInfo::clsThis())
+                continue;
+
+            if (!CIDMacroEng_ParserCache::bHashSource(*m_pmecmToUse, meciCur.strClassPath(), mhashCur))
+                CIDMacroEng_ParserCache::ThrowNotCacheable(meciCur.strClassPath());
+
+            colPaths.objAdd(meciCur.strClassPath());
+            colHashes.objAdd(mhashCur);
+        }
+
+        const tCIDLib::TCard4 c4SrcCount = colPaths.c4ElemCount();
+        strmOut << c4SrcCount;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SrcCount; c4Index++)
+            strmOut << colPaths[c4Index] << colHashes[c4Index];
+        strmOut << tCIDLib::EStreamMarkers::Frame;
+
+        //
+        //  Now the events. We merge the registrations (which are just the
+        //  class ids in order) with the completions, which we recorded along
+        //  with the class count at the time they were completed.
+        //
+        const tCIDLib::TCard4 c4CompCount = m_fcolCompIds.c4ElemCount();
+        strmOut << tCIDLib::TCard4((c4ClassCount - c4FirstClassId) + c4CompCount);
+
+        tCIDLib::TCard4 c4CompInd = 0;
+        for (tCIDLib::TCard4 c4Id = c4FirstClassId; c4Id <= c4ClassCount; c4Id++)
+        {
+            while ((c4CompInd < c4CompCount) && (m_fcolCompCounts[c4CompInd] <= c4Id))
+            {
+                const tCIDLib::TCard2 c2CompId = m_fcolCompIds[c4CompInd++];
+                strmOut << tCIDLib::TCard1(CIDMacroEng_ParserCache::EEvents::Complete)
+                        << c2CompId;
+                StoreCompiledClass(strmOut, m_pmeTarget->meciFind(c2CompId));
+            }
+
+            if (c4Id < c4ClassCount)
+            {
+                strmOut << tCIDLib::TCard1(CIDMacroEng_ParserCache::EEvents::Register)
+                        << tCIDLib::TCard2(c4Id);
+                CIDMacroEng_ParserCache::StoreRegister
+                (
+                    strmOut
+                    , *m_pmeTarget
+                    , m_pmeTarget->meciFind(tCIDLib::TCard2(c4Id))
+                    , c4FirstClassId
+                );
+            }
+        }
+
+        strmOut << meciMainClass.c2Id()
+                << tCIDLib::EStreamMarkers::EndObject;
+        strmOut.Flush();
+
+        m_pmecmToUse->StoreCompiled(strClassPath, strmOut.mbufData(), strmOut.c4CurSize());
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (!errToCatch.bLogged() && facCIDMacroEng().bLogWarnings())
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+    }
+}
+
+
+tCIDLib::TVoid
+TMacroEngParser::StoreCompiledClass(        TBinOutStream&  strmTar
+                                    , const TMEngClassInfo& meciSrc)
+{
+    strmTar.WriteEnum(tCIDLib::c4EnumOrd(meciSrc.m_eExtend));
+
+    strmTar << meciSrc.m_colDirectives.c4ElemCount();
+    {
+        TMEngClassInfo::TDirectiveList::TCursor cursDirs(&meciSrc.m_colDirectives);
+        for (; cursDirs; ++cursDirs)
+            strmTar << cursDirs->strKey() << cursDirs->strValue();
+    }
+
+    strmTar << meciSrc.m_colImports.c4ElemCount();
+    {
+        TMEngClassInfo::TImportList::TCursor cursImports(&meciSrc.m_colImports);
+        for (; cursImports; ++cursImports)
+            strmTar << cursImports->m_strImport << cursImports->m_bNested;
+    }
+
+    strmTar << meciSrc.m_colLiterals.c4ElemCount();
+    {
+        TMEngClassInfo::TLiteralList::TCursor cursLits(&meciSrc.m_colLiterals);
+        for (; cursLits; ++cursLits)
+        {
+            strmTar << cursLits->strName() << cursLits->c2ClassId();
+
+            TJanitor<TMEngClassVal> janVal(cursLits->pmecvMakeNew(cursLits->strName()));
+            CIDMacroEng_ParserCache::StoreValue(strmTar, *janVal.pobjThis(), meciSrc.strClassPath());
+        }
+    }
+
+    // All the method infos, since inherited ones can be overridden
+    const tCIDLib::TCard4 c4MethodCount = meciSrc.c4MethodCount();
+    strmTar << meciSrc.c2FirstMethodId() << c4MethodCount;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4MethodCount; c4Index++)
+    {
+        const TMEngMethodInfo& methiCur = meciSrc.methiFind(tCIDLib::TCard2(c4Index));
+        strmTar << methiCur.strName() << methiCur.c2RetClassId() << methiCur.bIsCtor();
+        strmTar.WriteEnum(tCIDLib::c4EnumOrd(methiCur.eVisibility()));
+        strmTar.WriteEnum(tCIDLib::c4EnumOrd(methiCur.eExtend()));
+        strmTar.WriteEnum(tCIDLib::c4EnumOrd(methiCur.eConst()));
+
+        const tCIDLib::TCard4 c4ParmCount = methiCur.c4ParmCount();
+        strmTar << c4ParmCount;
+        for (tCIDLib::TCard4 c4PInd = 0; c4PInd < c4ParmCount; c4PInd++)
+        {
+            const TMEngParmInfo& mepiCur = methiCur.mepiFind(tCIDLib::TCard2(c4PInd));
+            strmTar << mepiCur.strName() << mepiCur.c2ClassId();
+            strmTar.WriteEnum(tCIDLib::c4EnumOrd(mepiCur.eDir()));
+        }
+    }
+
+    // Just the members at this level, the others are inherited
+    const tCIDLib::TCard4 c4MemberCount = meciSrc.c4MemberCount();
+    strmTar << meciSrc.c2FirstMemberId() << c4MemberCount;
+    for (tCIDLib::TCard4 c4Index = meciSrc.c2FirstMemberId(); c4Index < c4MemberCount; c4Index++)
+    {
+        const TMEngMemberInfo& memiCur = meciSrc.memiFind(tCIDLib::TCard2(c4Index));
+        strmTar << memiCur.strName() << memiCur.c2ClassId();
+        strmTar.WriteEnum(tCIDLib::c4EnumOrd(memiCur.eConst()));
+    }
+
+    const tCIDLib::TCard4 c4ImplCount = meciSrc.m_colMethodImpls.c4ElemCount();
+    strmTar << c4ImplCount;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ImplCount; c4Index++)
+    {
+        const TMEngMethodImpl* pmethCur = meciSrc.m_colMethodImpls[c4Index];
+        if (pmethCur->clsIsA() != TMEngOpMethodImpl::clsThis())
+            CIDMacroEng_ParserCache::ThrowNotCacheable(meciSrc.strClassPath());
+
+        const TMEngOpMethodImpl& methCur = *static_cast<const TMEngOpMethodImpl*>(pmethCur);
+        strmTar << methCur.strName() << methCur.c2Id();
+
+        tCIDLib::TCard4 c4SubCount = methCur.c4LocalCount();
+        strmTar << c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            const TMEngLocalInfo& meliCur = methCur.meliFind(tCIDLib::TCard2(c4SubInd));
+            strmTar << meliCur.strName() << meliCur.c2ClassId();
+            strmTar.WriteEnum(tCIDLib::c4EnumOrd(meliCur.eConst()));
+        }
+
+        c4SubCount = methCur.c4StringCount();
+        strmTar << c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            strmTar << static_cast<const TMEngStringVal&>
+            (
+                methCur.mecvFindPoolItem(tCIDLib::TCard2(c4SubInd))
+            ).strValue();
+        }
+
+        c4SubCount = methCur.c4JumpTableCount();
+        strmTar << c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+        {
+            const TMEngJumpTable& jtblCur = methCur.jtblById(tCIDLib::TCard2(c4SubInd));
+            const tCIDLib::TCard4 c4CaseCount = jtblCur.c4CaseCount();
+            strmTar << jtblCur.c4DefCaseIP() << c4CaseCount;
+            for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < c4CaseCount; c4CaseInd++)
+            {
+                const TMEngJumpTableItem& jtbliCur = jtblCur.jtbliAt(c4CaseInd);
+                strmTar << jtbliCur.c4IP();
+                CIDMacroEng_ParserCache::StoreValue
+                (
+                    strmTar, jtbliCur.mecvCase(), meciSrc.strClassPath()
+                );
+            }
+        }
+
+        c4SubCount = methCur.c4CurOffset();
+        strmTar << c4SubCount;
+        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+            strmTar << methCur.meopAt(c4SubInd);
+
+        const TMEngOpMethodImpl::TLineMap* pfcolLines = methCur.pfcolLineMap();
+        strmTar << (pfcolLines != nullptr);
+        if (pfcolLines)
+        {
+            c4SubCount = pfcolLines->c4ElemCount();
+            strmTar << c4SubCount;
+            for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCount; c4SubInd++)
+                strmTar << (*pfcolLines)[c4SubInd];
+        }
+    }
+    strmTar << tCIDLib::EStreamMarkers::Frame;
+}
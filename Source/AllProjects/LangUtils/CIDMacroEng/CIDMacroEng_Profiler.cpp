@@ -0,0 +1,414 @@
+//
+// FILE NAME: CIDMacroEng_Profiler.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the TMEngProfiler class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDMacroEng_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic RTTI macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TMEngProfiler,TObject)
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TMEngProfiler
+// PREFIX: meprf
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TMEngProfiler: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TMEngProfiler::TMEngProfiler() :
+
+    m_c4Depth(0)
+    , m_colFrames(64)
+    , m_colLineHits(tCIDLib::EAdoptOpts::Adopt, 64)
+    , m_colNodes(256)
+    , m_colStatIndex(tCIDLib::EAdoptOpts::Adopt, 64)
+    , m_colStats(128)
+{
+    Reset();
+}
+
+TMEngProfiler::~TMEngProfiler()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMEngProfiler: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TMEngProfiler::bHasData() const
+{
+    return !m_colStats.bIsEmpty() || !m_colLineHits.bIsEmpty();
+}
+
+
+tCIDLib::TCard4
+TMEngProfiler::c4CallCount( const   tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard2 c2MethodId) const
+{
+    const tCIDLib::TCard4 c4StatInd = c4FindStats(c2ClassId, c2MethodId);
+    if (c4StatInd == kCIDLib::c4MaxCard)
+        return 0;
+    return m_colStats[c4StatInd].c4Calls;
+}
+
+
+//
+//  Called when a method call starts. We return a token which is the new depth,
+//  so that ExitMethod() can pop back to the right place.
+//
+tCIDLib::TCard4
+TMEngProfiler::c4EnterMethod(const  tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard2 c2MethodId)
+{
+    const tCIDLib::TCard4 c4StatInd = c4FindStats(c2ClassId, c2MethodId, kCIDLib::True);
+    TMethStats& mstatsCur = m_colStats[c4StatInd];
+    mstatsCur.c4Calls++;
+    mstatsCur.c4Active++;
+
+    //
+    //  Find the node for this call under the current one. If not found, add
+    //  it as the new first child.
+    //
+    const tCIDLib::TCard4 c4ParNode = m_c4Depth ? m_colFrames[m_c4Depth - 1].c4Node : 0;
+    tCIDLib::TCard4 c4Node = m_colNodes[c4ParNode].c4FirstChild;
+    while (c4Node)
+    {
+        if (m_colNodes[c4Node].c4StatInd == c4StatInd)
+            break;
+        c4Node = m_colNodes[c4Node].c4NextSib;
+    }
+
+    if (!c4Node)
+    {
+        TStackNode nodeNew;
+        nodeNew.c4Parent = c4ParNode;
+        nodeNew.c4FirstChild = 0;
+        nodeNew.c4NextSib = m_colNodes[c4ParNode].c4FirstChild;
+        nodeNew.c4StatInd = c4StatInd;
+        nodeNew.c8ExclUS = 0;
+
+        c4Node = m_colNodes.c4ElemCount();
+        m_colNodes.objAdd(nodeNew);
+        m_colNodes[c4ParNode].c4FirstChild = c4Node;
+    }
+
+    // Push a frame, reusing one if we have it
+    TFrame frameNew;
+    frameNew.c4Node = c4Node;
+    frameNew.c4StatInd = c4StatInd;
+    frameNew.c8ChildUS = 0;
+    frameNew.c8StartUS = TTime::c8HPTimerUS();
+    if (m_c4Depth < m_colFrames.c4ElemCount())
+        m_colFrames[m_c4Depth] = frameNew;
+    else
+        m_colFrames.objAdd(frameNew);
+
+    m_c4Depth++;
+    return m_c4Depth;
+}
+
+
+tCIDLib::TCard4
+TMEngProfiler::c4LineHits(  const   tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard4 c4Line) const
+{
+    if (c2ClassId >= m_colLineHits.c4ElemCount())
+        return 0;
+
+    const TIndexList& fcolLines = *m_colLineHits[c2ClassId];
+    if (c4Line >= fcolLines.c4ElemCount())
+        return 0;
+    return fcolLines[c4Line];
+}
+
+
+tCIDLib::TCard8
+TMEngProfiler::c8ExclusiveUS(const  tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard2 c2MethodId) const
+{
+    const tCIDLib::TCard4 c4StatInd = c4FindStats(c2ClassId, c2MethodId);
+    if (c4StatInd == kCIDLib::c4MaxCard)
+        return 0;
+    return m_colStats[c4StatInd].c8ExclUS;
+}
+
+
+tCIDLib::TCard8
+TMEngProfiler::c8InclusiveUS(const  tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard2 c2MethodId) const
+{
+    const tCIDLib::TCard4 c4StatInd = c4FindStats(c2ClassId, c2MethodId);
+    if (c4StatInd == kCIDLib::c4MaxCard)
+        return 0;
+    return m_colStats[c4StatInd].c8InclUS;
+}
+
+
+//
+//  Pop back to just below the passed token's frame. Normally that's just the
+//  top one, but if a callee's exit was missed (we were reset or enabled part
+//  way through), this gets us back in sync.
+//
+tCIDLib::TVoid TMEngProfiler::ExitMethod(const tCIDLib::TCard4 c4Token)
+{
+    if (!c4Token || (c4Token > m_c4Depth))
+        return;
+
+    const tCIDLib::TCard8 c8Now = TTime::c8HPTimerUS();
+    while (m_c4Depth >= c4Token)
+    {
+        m_c4Depth--;
+        const TFrame& frameCur = m_colFrames[m_c4Depth];
+
+        const tCIDLib::TCard8 c8Total = c8Now - frameCur.c8StartUS;
+        const tCIDLib::TCard8 c8Excl = (c8Total > frameCur.c8ChildUS)
+                                       ? c8Total - frameCur.c8ChildUS : 0;
+
+        m_colNodes[frameCur.c4Node].c8ExclUS += c8Excl;
+
+        TMethStats& mstatsCur = m_colStats[frameCur.c4StatInd];
+        mstatsCur.c8ExclUS += c8Excl;
+        if (mstatsCur.c4Active)
+            mstatsCur.c4Active--;
+
+        // Only the outermost call of a method counts towards inclusive
+        if (!mstatsCur.c4Active)
+            mstatsCur.c8InclUS += c8Total;
+
+        if (m_c4Depth)
+            m_colFrames[m_c4Depth - 1].c8ChildUS += c8Total;
+    }
+}
+
+
+//
+//  Write out the call tree in the folded stacks format. Each node that has
+//  any exclusive time gets a line with its full stack.
+//
+tCIDLib::TVoid
+TMEngProfiler::FormatFolded(        TTextOutStream&     strmTarget
+                            , const TCIDMacroEngine&    meOwner) const
+{
+    TFundVector<tCIDLib::TCard4> fcolPath(32);
+    const tCIDLib::TCard4 c4Count = m_colNodes.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 1; c4Index < c4Count; c4Index++)
+    {
+        const TStackNode& nodeCur = m_colNodes[c4Index];
+        if (!nodeCur.c8ExclUS)
+            continue;
+
+        // Get the path up to the root, which is in reverse order
+        fcolPath.RemoveAll();
+        tCIDLib::TCard4 c4Cur = c4Index;
+        while (c4Cur)
+        {
+            fcolPath.c4AddElement(c4Cur);
+            c4Cur = m_colNodes[c4Cur].c4Parent;
+        }
+
+        tCIDLib::TCard4 c4PathInd = fcolPath.c4ElemCount();
+        while (c4PathInd)
+        {
+            c4PathInd--;
+            const TMethStats& mstatsCur = m_colStats[m_colNodes[fcolPath[c4PathInd]].c4StatInd];
+            const TMEngClassInfo& meciCur = meOwner.meciFind(mstatsCur.c2ClassId);
+            strmTarget  << meciCur.strClassPath() << L"."
+                        << meciCur.methiFind(mstatsCur.c2MethodId).strName();
+            if (c4PathInd)
+                strmTarget << L";";
+        }
+        strmTarget << L" " << nodeCur.c8ExclUS << kCIDLib::NewLn;
+    }
+    strmTarget.Flush();
+}
+
+
+//
+//  Writes out a readable report, the methods sorted by exclusive time, and
+//  then the lines hit for each class.
+//
+tCIDLib::TVoid
+TMEngProfiler::FormatReport(        TTextOutStream&     strmTarget
+                            , const TCIDMacroEngine&    meOwner) const
+{
+    TStreamJanitor janStream(&strmTarget);
+
+    const tCIDLib::TCard4 c4StatCount = m_colStats.c4ElemCount();
+    TFundVector<tCIDLib::TCard4> fcolOrder(c4StatCount);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4StatCount; c4Index++)
+        fcolOrder.c4AddElement(c4Index);
+
+    fcolOrder.Sort
+    (
+        [this](const tCIDLib::TCard4 c4First, const tCIDLib::TCard4 c4Second)
+        {
+            return tCIDLib::eComp
+            (
+                m_colStats[c4Second].c8ExclUS, m_colStats[c4First].c8ExclUS
+            );
+        }
+    );
+
+    strmTarget  << L"Method                                   Calls     Incl(us)     Excl(us)\n"
+                << L"---------------------------------------------------------------------------\n";
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4StatCount; c4Index++)
+        FormatMethod(strmTarget, meOwner, m_colStats[fcolOrder[c4Index]]);
+
+    strmTarget << L"\nLine              Opcodes\n"
+               << L"---------------------------------------------------------------------------\n";
+    const tCIDLib::TCard4 c4ClassCount = m_colLineHits.c4ElemCount();
+    for (tCIDLib::TCard4 c4ClassId = 0; c4ClassId < c4ClassCount; c4ClassId++)
+    {
+        const TIndexList& fcolLines = *m_colLineHits[c4ClassId];
+        const tCIDLib::TCard4 c4LineCount = fcolLines.c4ElemCount();
+        for (tCIDLib::TCard4 c4Line = 0; c4Line < c4LineCount; c4Line++)
+        {
+            if (!fcolLines[c4Line])
+                continue;
+
+            strmTarget  << meOwner.meciFind(tCIDLib::TCard2(c4ClassId)).strClassPath()
+                        << L"(" << c4Line << L")  " << fcolLines[c4Line]
+                        << kCIDLib::NewLn;
+        }
+    }
+    strmTarget.Flush();
+}
+
+
+tCIDLib::TVoid
+TMEngProfiler::OpHit(const tCIDLib::TCard2 c2ClassId, const tCIDLib::TCard4 c4Line)
+{
+    while (m_colLineHits.c4ElemCount() <= c2ClassId)
+        m_colLineHits.Add(new TIndexList(64));
+
+    TIndexList& fcolLines = *m_colLineHits[c2ClassId];
+    while (fcolLines.c4ElemCount() <= c4Line)
+        fcolLines.c4AddElement(0);
+    fcolLines[c4Line]++;
+}
+
+
+//
+//  Toss all of the data. We get the root node back in, which just exists to
+//  be the parent of the top level calls.
+//
+tCIDLib::TVoid TMEngProfiler::Reset()
+{
+    m_c4Depth = 0;
+    m_colFrames.RemoveAll();
+    m_colLineHits.RemoveAll();
+    m_colNodes.RemoveAll();
+    m_colStatIndex.RemoveAll();
+    m_colStats.RemoveAll();
+
+    TStackNode nodeRoot;
+    nodeRoot.c4Parent = 0;
+    nodeRoot.c4FirstChild = 0;
+    nodeRoot.c4NextSib = 0;
+    nodeRoot.c4StatInd = kCIDLib::c4MaxCard;
+    nodeRoot.c8ExclUS = 0;
+    m_colNodes.objAdd(nodeRoot);
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMEngProfiler: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TCard4
+TMEngProfiler::c4FindStats( const   tCIDLib::TCard2 c2ClassId
+                            , const tCIDLib::TCard2 c2MethodId) const
+{
+    if (c2ClassId >= m_colStatIndex.c4ElemCount())
+        return kCIDLib::c4MaxCard;
+
+    const TIndexList& fcolMeths = *m_colStatIndex[c2ClassId];
+    if (c2MethodId >= fcolMeths.c4ElemCount())
+        return kCIDLib::c4MaxCard;
+    return fcolMeths[c2MethodId];
+}
+
+tCIDLib::TCard4
+TMEngProfiler::c4FindStats( const   tCIDLib::TCard2     c2ClassId
+                            , const tCIDLib::TCard2     c2MethodId
+                            , const tCIDLib::TBoolean   bAdd)
+{
+    tCIDLib::TCard4 c4Ret = c4FindStats(c2ClassId, c2MethodId);
+    if ((c4Ret != kCIDLib::c4MaxCard) || !bAdd)
+        return c4Ret;
+
+    while (m_colStatIndex.c4ElemCount() <= c2ClassId)
+        m_colStatIndex.Add(new TIndexList(16));
+
+    TIndexList& fcolMeths = *m_colStatIndex[c2ClassId];
+    while (fcolMeths.c4ElemCount() <= c2MethodId)
+        fcolMeths.c4AddElement(kCIDLib::c4MaxCard);
+
+    TMethStats mstatsNew;
+    mstatsNew.c2ClassId = c2ClassId;
+    mstatsNew.c2MethodId = c2MethodId;
+    mstatsNew.c4Active = 0;
+    mstatsNew.c4Calls = 0;
+    mstatsNew.c8ExclUS = 0;
+    mstatsNew.c8InclUS = 0;
+
+    c4Ret = m_colStats.c4ElemCount();
+    m_colStats.objAdd(mstatsNew);
+    fcolMeths[c2MethodId] = c4Ret;
+    return c4Ret;
+}
+
+
+tCIDLib::TVoid
+TMEngProfiler::FormatMethod(        TTextOutStream&     strmTarget
+                            , const TCIDMacroEngine&    meOwner
+                            , const TMethStats&         mstatsSrc) const
+{
+    const TTextOutStream::Width widName(40);
+    const TTextOutStream::Width widNum(12);
+    const TTextOutStream::Width widNone(0);
+    const TTextOutStream::Justify jusLeft(tCIDLib::EHJustify::Left);
+    const TTextOutStream::Justify jusRight(tCIDLib::EHJustify::Right);
+
+    const TMEngClassInfo& meciCur = meOwner.meciFind(mstatsSrc.c2ClassId);
+    TString strName(meciCur.strClassPath());
+    strName.Append(kCIDLib::chPeriod);
+    strName.Append(meciCur.methiFind(mstatsSrc.c2MethodId).strName());
+
+    strmTarget  << jusLeft << widName << strName << jusRight << widNone << L" "
+                << TTextOutStream::Width(7) << mstatsSrc.c4Calls
+                << widNone << L" " << widNum << mstatsSrc.c8InclUS
+                << widNone << L" " << widNum << mstatsSrc.c8ExclUS
+                << widNone << kCIDLib::NewLn;
+}
@@ -0,0 +1,313 @@
+//
+// FILE NAME: CIDMacroEng_Profiler.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the CIDMacroEng_Profiler.cpp file, which implements
+//  the TMEngProfiler class. The engine owns one of these and, when profiling
+//  is enabled, the opcode interpreter tells it about each method call and
+//  each opcode executed. It tracks:
+//
+//  1.  Per-method call counts and inclusive and exclusive time. Inclusive
+//      time is only counted for the outermost active call of a method, so
+//      that recursion doesn't count the same time more than once.
+//  2.  Per-line opcode hit counts, for each class.
+//  3.  Exclusive time per unique call stack, which can be written out in the
+//      'folded stacks' format that flame graph tools take, i.e. one line per
+//      stack, with the frames separated by semicolons and then a space and
+//      the count (microseconds in our case.)
+//
+//  We also provide a simple janitor, TMEngProfJanitor, that the interpreter
+//  uses around method calls so that the call is correctly ended no matter
+//  how we get out. If the profiler pointer is null, it does nothing, which
+//  is the case when profiling is not enabled.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Everything is by class and method id, so the data is only good for
+//      the engine's current set of classes. The engine resets us when it
+//      is reset.
+//
+//  2)  Profiling can be enabled or disabled while a macro is running. The
+//      token returned from c4EnterMethod() lets us correctly unwind any calls
+//      that started while enabled, and calls that started before we were
+//      enabled are just never seen.
+//
+//  3)  This is not thread safe, but neither is the engine, so the engine's
+//      thread is the only one that should be updating it.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+class TCIDMacroEngine;
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//  CLASS: TMEngProfiler
+// PREFIX: meprf
+// ---------------------------------------------------------------------------
+class CIDMACROENGEXP TMEngProfiler : public TObject
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMEngProfiler();
+
+        TMEngProfiler(const TMEngProfiler&) = delete;
+
+        ~TMEngProfiler();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMEngProfiler& operator=(const TMEngProfiler&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bHasData() const;
+
+        tCIDLib::TCard4 c4CallCount
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+        )   const;
+
+        tCIDLib::TCard4 c4EnterMethod
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+        );
+
+        tCIDLib::TCard4 c4LineHits
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard4         c4Line
+        )   const;
+
+        tCIDLib::TCard8 c8ExclusiveUS
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+        )   const;
+
+        tCIDLib::TCard8 c8InclusiveUS
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+        )   const;
+
+        tCIDLib::TVoid ExitMethod
+        (
+            const   tCIDLib::TCard4         c4Token
+        );
+
+        tCIDLib::TVoid FormatFolded
+        (
+                    TTextOutStream&         strmTarget
+            , const TCIDMacroEngine&        meOwner
+        )   const;
+
+        tCIDLib::TVoid FormatReport
+        (
+                    TTextOutStream&         strmTarget
+            , const TCIDMacroEngine&        meOwner
+        )   const;
+
+        tCIDLib::TVoid OpHit
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard4         c4Line
+        );
+
+        tCIDLib::TVoid Reset();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private class types
+        //
+        //  TFrame
+        //      An active call. We remember when it started and how much of
+        //      its time was spent in calls it made, so that we can get the
+        //      exclusive time when it ends.
+        //
+        //  TMethStats
+        //      The per-method info. c4Active is how many calls of it are
+        //      currently active, to deal with recursion.
+        //
+        //  TStackNode
+        //      A node in the call tree, one per unique call stack. Each one
+        //      points to its parent and its first child, and the children of a
+        //      node are linked via their next sibling index. Node 0 is a root
+        //      that represents the entry point.
+        // -------------------------------------------------------------------
+        struct TFrame
+        {
+            tCIDLib::TCard4     c4Node;
+            tCIDLib::TCard4     c4StatInd;
+            tCIDLib::TCard8     c8StartUS;
+            tCIDLib::TCard8     c8ChildUS;
+        };
+
+        struct TMethStats
+        {
+            tCIDLib::TCard2     c2ClassId;
+            tCIDLib::TCard2     c2MethodId;
+            tCIDLib::TCard4     c4Active;
+            tCIDLib::TCard4     c4Calls;
+            tCIDLib::TCard8     c8ExclUS;
+            tCIDLib::TCard8     c8InclUS;
+        };
+
+        struct TStackNode
+        {
+            tCIDLib::TCard4     c4Parent;
+            tCIDLib::TCard4     c4FirstChild;
+            tCIDLib::TCard4     c4NextSib;
+            tCIDLib::TCard4     c4StatInd;
+            tCIDLib::TCard8     c8ExclUS;
+        };
+
+        using TIndexList = TFundVector<tCIDLib::TCard4>;
+        using TClassIndex = TRefVector<TIndexList>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4FindStats
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+        )   const;
+
+        tCIDLib::TCard4 c4FindStats
+        (
+            const   tCIDLib::TCard2         c2ClassId
+            , const tCIDLib::TCard2         c2MethodId
+            , const tCIDLib::TBoolean       bAdd
+        );
+
+        tCIDLib::TVoid FormatMethod
+        (
+                    TTextOutStream&         strmTarget
+            , const TCIDMacroEngine&        meOwner
+            , const TMethStats&             mstatsSrc
+        )   const;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Depth
+        //      The number of active frames in m_colFrames. We don't remove
+        //      them when popped, we just reuse them.
+        //
+        //  m_colFrames
+        //      The active calls, the top being at m_c4Depth - 1.
+        //
+        //  m_colLineHits
+        //      Opcode hit counts per line, indexed by class id and then by
+        //      line number.
+        //
+        //  m_colNodes
+        //      The call tree nodes. The first one is the root.
+        //
+        //  m_colStatIndex
+        //      Indexed by class id and then by method id, to get to the index
+        //      of a method's stats in m_colStats. c4MaxCard if not seen yet.
+        //
+        //  m_colStats
+        //      The per-method stats, in the order first called.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4Depth;
+        TVector<TFrame>         m_colFrames;
+        TClassIndex             m_colLineHits;
+        TVector<TStackNode>     m_colNodes;
+        TClassIndex             m_colStatIndex;
+        TVector<TMethStats>     m_colStats;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TMEngProfiler,TObject)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TMEngProfJanitor
+// PREFIX: jan
+// ---------------------------------------------------------------------------
+class CIDMACROENGEXP TMEngProfJanitor
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMEngProfJanitor() = delete;
+
+        TMEngProfJanitor(       TMEngProfiler* const    pmeprfToUse
+                        , const tCIDLib::TCard2         c2ClassId
+                        , const tCIDLib::TCard2         c2MethodId) :
+
+            m_c4Token(0)
+            , m_pmeprfToUse(pmeprfToUse)
+        {
+            if (m_pmeprfToUse)
+                m_c4Token = m_pmeprfToUse->c4EnterMethod(c2ClassId, c2MethodId);
+        }
+
+        TMEngProfJanitor(const TMEngProfJanitor&) = delete;
+
+        ~TMEngProfJanitor()
+        {
+            if (m_pmeprfToUse)
+                m_pmeprfToUse->ExitMethod(m_c4Token);
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMEngProfJanitor& operator=(const TMEngProfJanitor&) = delete;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Token
+        //      The token we got when we started the call, which we pass back
+        //      when it ends.
+        //
+        //  m_pmeprfToUse
+        //      The profiler, or null if not profiling.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4     m_c4Token;
+        TMEngProfiler*      m_pmeprfToUse;
+};
+
+#pragma CIDLIB_POPPACK
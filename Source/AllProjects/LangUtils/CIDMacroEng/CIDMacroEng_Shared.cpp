@@ -63,7 +63,7 @@ tCIDLib::TBoolean tCIDMacroEng::bIsValidEnum(const tCIDMacroEng::EFlowTypes eVal
 
 
 
-static TEnumMap::TEnumValItem aeitemValues_EOpCodes[56] = 
+static TEnumMap::TEnumValItem aeitemValues_EOpCodes[59] = 
 {
     {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::None), 0, 0,  { L"", L"", L"", L"None", L"EOpCodes::None", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CallExcept), 0, 0,  { L"", L"", L"", L"CallExcept", L"EOpCodes::CallExcept", L"" } }
@@ -78,6 +78,7 @@ static TEnumMap::TEnumValItem aeitemValues_EOpCodes[56] =
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CondEnumInc), 0, 0,  { L"", L"", L"", L"CondEnumInc", L"EOpCodes::CondEnumInc", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CondJump), 0, 0,  { L"", L"", L"", L"CondJump", L"EOpCodes::CondJump", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CondJumpNP), 0, 0,  { L"", L"", L"", L"CondJumpNP", L"EOpCodes::CondJumpNP", L"" } }
+  , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CondJumpPop), 0, 0,  { L"", L"", L"", L"CondJumpPop", L"EOpCodes::CondJumpPop", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::CurLine), 0, 0,  { L"", L"", L"", L"CurLine", L"EOpCodes::CurLine", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::EndTry), 0, 0,  { L"", L"", L"", L"EndTry", L"EOpCodes::EndTry", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::FlipTop), 0, 0,  { L"", L"", L"", L"FlipTop", L"EOpCodes::FlipTop", L"" } }
@@ -90,8 +91,10 @@ static TEnumMap::TEnumValItem aeitemValues_EOpCodes[56] =
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::NoOp), 0, 0,  { L"", L"", L"", L"NoOp", L"EOpCodes::NoOp", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::NotCondJumpNP), 0, 0,  { L"", L"", L"", L"NotCondJumpNP", L"EOpCodes::NotCondJumpNP", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::NotCondJump), 0, 0,  { L"", L"", L"", L"NotCondJump", L"EOpCodes::NotCondJump", L"" } }
+  , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::NotCondJumpPop), 0, 0,  { L"", L"", L"", L"NotCondJumpPop", L"EOpCodes::NotCondJumpPop", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PopTop), 0, 0,  { L"", L"", L"", L"PopTop", L"EOpCodes::PopTop", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PopToReturn), 0, 0,  { L"", L"", L"", L"PopToReturn", L"EOpCodes::PopToReturn", L"" } }
+  , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PopUnder), 0, 0,  { L"", L"", L"", L"PopUnder", L"EOpCodes::PopUnder", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PushCurLine), 0, 0,  { L"", L"", L"", L"PushCurLine", L"EOpCodes::PushCurLine", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PushEnum), 0, 0,  { L"", L"", L"", L"PushEnum", L"EOpCodes::PushEnum", L"" } }
   , {  tCIDLib::TInt4(tCIDMacroEng::EOpCodes::PushException), 0, 0,  { L"", L"", L"", L"PushException", L"EOpCodes::PushException", L"" } }
@@ -127,7 +130,7 @@ static TEnumMap::TEnumValItem aeitemValues_EOpCodes[56] =
 static TEnumMap emapEOpCodes
 (
      L"EOpCodes"
-     , 56
+     , 59
      , kCIDLib::False
      , aeitemValues_EOpCodes
      , nullptr
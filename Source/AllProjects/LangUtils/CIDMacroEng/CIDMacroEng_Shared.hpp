@@ -93,6 +93,12 @@ namespace tCIDMacroEng
     //                    this class or it's parent class, according to
     //                    the opcode. _CallParent let's us support calls
     //                    down the sequence of overridden methods.
+    //                    For all of the call opcodes, the optimizer
+    //                    can fold following pops into the third index,
+    //                    which is the number of items to pop after the
+    //                    call returns. The fourth index, if non-zero,
+    //                    is one more than the index of a pre-resolved
+    //                    call target in the method's direct call list.
     //  ColIndex        - Indexes a collection class. Expects the stack
     //                    top to hold the index in a Card4 value, and the
     //                    item under it to be the collection object. It
@@ -111,6 +117,10 @@ namespace tCIDMacroEng
     //                    If that is true, it jumps by the offset given in
     //                    c4Immediate, else it doesn't. The NP doesn't pop
     //                    the stack after checking the top, the other does.
+    //  CondJumpPop     - Only generated by the optimizer. Like CondJump,
+    //                    but the c4Immediate target IP only uses the first
+    //                    two indices. The third index is how many more
+    //                    items under the boolean to pop after checking it.
     //  CurLine         - c4Immediate holds the line number
     //  EndTry          - Expects a try stack item on the top of the stack
     //                    which it removes. It will be followed by an
@@ -128,7 +138,8 @@ namespace tCIDMacroEng
     //                    stack top.
     //  NoOp            - No parms, has no effect
     //  NotCondJump
-    //  NotCondJumpNP   - Like CondJump, but with reverse boolean logic.
+    //  NotCondJumpNP
+    //  NotCondJumpPop  - Like CondJump, but with reverse boolean logic.
     //  PushCurLine     - No parms. Pushes the Card4 current line value
     //  PushEnum        - Two indices. The first is the enumerated type,
     //                    and the second is the ordinal value to push.
@@ -143,6 +154,9 @@ namespace tCIDMacroEng
     //  PopToReturn     - Copies the value on the top of stack to the return
     //                    object on the stack, then pops the stack. Doesn't
     //                    require any parms.
+    //  PopUnder        - No parms. Only generated by the optimizer. Pops
+    //                    the item under the top of stack, leaving the top
+    //                    item in place. Same as a FlipTop and PopTop.
     //  PushImXX        - The xxImmediate field holds the value pushed
     //  PushLocal       - One index, the index of the local
     //  PushMember      - One index, the index of the member
@@ -202,6 +216,7 @@ namespace tCIDMacroEng
         , CondEnumInc
         , CondJump
         , CondJumpNP
+        , CondJumpPop
         , CurLine
         , EndTry
         , FlipTop
@@ -214,8 +229,10 @@ namespace tCIDMacroEng
         , NoOp
         , NotCondJumpNP
         , NotCondJump
+        , NotCondJumpPop
         , PopTop
         , PopToReturn
+        , PopUnder
         , PushCurLine
         , PushEnum
         , PushException
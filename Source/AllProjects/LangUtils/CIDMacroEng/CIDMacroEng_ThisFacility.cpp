@@ -136,9 +136,30 @@ TMEngRTClassLoader::pmeciLoadClass(         TCIDMacroEngine&    meTarget
     //          are the tricky ones that have special needs.
     //
     TMEngClassInfo* pmeciRet = nullptr;
+
+    //
+    //  These are only available on platforms where the facilities they wrap
+    //  are available.
+    //
+    #if defined(CIDMACROENG_NETDBCLASSES)
     if (strClassPath == TMEngAsyncHTTPClInfo::strPath())
         pmeciRet = new TMEngAsyncHTTPClInfo(meTarget);
-    else if (strClassPath == TMEngAudioInfo::strPath())
+    else if (strClassPath == L"MEng.System.Runtime.DBConnect")
+        pmeciRet = new TMEngDBConnInfo(meTarget);
+    else if (strClassPath == L"MEng.System.Runtime.DBStatement")
+        pmeciRet = new TMEngDBStmtInfo(meTarget);
+    else if (strClassPath == TMEngHTTPClientInfo::strPath())
+        pmeciRet = new TMEngHTTPClientInfo(meTarget);
+    else if (strClassPath == TMEngJSONAnchorInfo::strPath())
+        pmeciRet = new TMEngJSONAnchorInfo(meTarget);
+    else if (strClassPath == TMEngJSONParserInfo::strPath())
+        pmeciRet = new TMEngJSONParserInfo(meTarget);
+
+    if (pmeciRet)
+        return pmeciRet;
+    #endif
+
+    if (strClassPath == TMEngAudioInfo::strPath())
         pmeciRet = new TMEngAudioInfo(meTarget);
     else if (strClassPath == TMEngASCIIInfo::strPath())
         pmeciRet = new TMEngASCIIInfo(meTarget);
@@ -160,10 +181,6 @@ TMEngRTClassLoader::pmeciLoadClass(         TCIDMacroEngine&    meTarget
         pmeciRet = new TMEngDirIterInfo(meTarget);
     else if (strClassPath == TMEngDGramSocketInfo::strPath())
         pmeciRet = new TMEngDGramSocketInfo(meTarget);
-    else if (strClassPath == L"MEng.System.Runtime.DBConnect")
-        pmeciRet = new TMEngDBConnInfo(meTarget);
-    else if (strClassPath == L"MEng.System.Runtime.DBStatement")
-        pmeciRet = new TMEngDBStmtInfo(meTarget);
     else if (strClassPath == TMEngIPEPInfo::strPath())
         pmeciRet = new TMEngIPEPInfo(meTarget);
     else if (strClassPath == TMEngFileInStreamInfo::strPath())
@@ -172,12 +189,6 @@ TMEngRTClassLoader::pmeciLoadClass(         TCIDMacroEngine&    meTarget
         pmeciRet = new TMEngFileOutStreamInfo(meTarget);
     else if (strClassPath == L"MEng.System.Runtime.FileSystem")
         pmeciRet = new TMEngFileSysInfo(meTarget);
-    else if (strClassPath == TMEngHTTPClientInfo::strPath())
-        pmeciRet = new TMEngHTTPClientInfo(meTarget);
-    else if (strClassPath == TMEngJSONAnchorInfo::strPath())
-        pmeciRet = new TMEngJSONAnchorInfo(meTarget);
-    else if (strClassPath == TMEngJSONParserInfo::strPath())
-        pmeciRet = new TMEngJSONParserInfo(meTarget);
     else if (strClassPath == TMEngKVPairInfo::strPath())
         pmeciRet = new TMEngKVPairInfo(meTarget);
     else if (strClassPath == TMEngMD5Info::strPath())
@@ -194,11 +194,14 @@ TMEngXMLTreeParser::esrResolve( const   TString&                strPublicId
     //  a standard URL based one in that case.
     //
     TXMLEntitySrc* pxesRet = 0;
+    #if defined(CIDMACROENG_NETDBCLASSES)
     if (pathActual.bStartsWith(L"http:"))
     {
         pxesRet = new TURLEntitySrc(pathActual);
     }
-     else if (pathActual.bStartsWith(L"file:"))
+     else
+    #endif
+    if (pathActual.bStartsWith(L"file:"))
     {
         // Get the path part of the URL out
         TURL urlActual(pathActual, tCIDSock::EQualified::Full);
@@ -1488,11 +1491,14 @@ TMEngXMLTreeParserInfo::bInvokeMethod(          TCIDMacroEngine&    meOwner
                 const TString& strFile = meOwner.strStackValAt(c4FirstInd);
 
                 TXMLEntitySrc* pxesRoot = 0;
+                #if defined(CIDMACROENG_NETDBCLASSES)
                 if (strFile.bStartsWith(L"http:"))
                 {
                     pxesRoot = new TURLEntitySrc(strFile);
                 }
-                 else if (strFile.bStartsWith(L"file:"))
+                 else
+                #endif
+                if (strFile.bStartsWith(L"file:"))
                 {
                     // Get the path part of the URL out
                     TURL urlActual(strFile, tCIDSock::EQualified::Full);
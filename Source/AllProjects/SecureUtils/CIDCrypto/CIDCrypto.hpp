@@ -50,6 +50,15 @@
 #include    "CIDLib.hpp"
 
 
+// ---------------------------------------------------------------------------
+//  Export the facility object lazy evaluator function. We forward ref the
+//  facility class so that it's visible to templatized classes that must be
+//  defined before the actual facility class header.
+// ---------------------------------------------------------------------------
+class TFacCIDCrypto;
+extern CIDCRYPTEXP TFacCIDCrypto& facCIDCrypto();
+
+
 // ---------------------------------------------------------------------------
 //  Include our public headers
 // ---------------------------------------------------------------------------
@@ -70,11 +79,7 @@
 #include "CIDCrypto_SHA1.hpp"
 #include "CIDCrypto_SHA256Hash.hpp"
 #include "CIDCrypto_SHA256.hpp"
+#include "CIDCrypto_HMAC.hpp"
 #include "CIDCrypto_UniqueId.hpp"
 #include "CIDCrypto_ThisFacility.hpp"
 
-
-// ---------------------------------------------------------------------------
-//  Export the facility object lazy evaluator function
-// ---------------------------------------------------------------------------
-extern CIDCRYPTEXP TFacCIDCrypto& facCIDCrypto();
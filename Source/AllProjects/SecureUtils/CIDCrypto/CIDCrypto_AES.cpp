@@ -338,8 +338,11 @@ namespace
 TAESEncrypter::TAESEncrypter(const tCIDCrypto::EBlockModes eMode) :
 
     TBlockEncrypter(16, eMode)
+    , m_ac1HWDRK()
+    , m_ac1HWERK()
     , m_ac4DRK()
     , m_ac4ERK()
+    , m_bHWAccel(kCIDLib::False)
     , m_c4Rounds(0)
     , m_ckeyThis()
 {
@@ -351,6 +354,7 @@ TAESEncrypter::TAESEncrypter(const  TCryptoKey&             ckeyToUse
                             , const tCIDCrypto::EBlockModes eMode) :
 
     TBlockEncrypter(16, eMode)
+    , m_bHWAccel(kCIDLib::False)
     , m_c4Rounds(0)
     , m_ckeyThis(ckeyToUse)
 {
@@ -421,6 +425,20 @@ TAESEncrypter::SetNewKey(const  TCryptoKey&             ckeyNew
 // ---------------------------------------------------------------------------
 //  TAESEncrypter: Protected, inherited methods
 // ---------------------------------------------------------------------------
+
+// If we have AES-NI, use that, else let the base class do them one at a time
+tCIDLib::TVoid
+TAESEncrypter::DecryptBlocksImpl(const  tCIDLib::TCard1* const  pc1Cypher
+                                ,       tCIDLib::TCard1* const  pc1Plain
+                                , const tCIDLib::TCard4         c4Blocks)
+{
+    if (m_bHWAccel)
+        TCryptoHWAccel::AESDecryptBlocks(m_ac1HWDRK, m_c4Rounds, pc1Cypher, pc1Plain, c4Blocks);
+    else
+        TParent::DecryptBlocksImpl(pc1Cypher, pc1Plain, c4Blocks);
+}
+
+
 tCIDLib::TVoid
 TAESEncrypter::DecryptImpl( const   tCIDLib::TCard1* const  pc1Cypher
                             ,       tCIDLib::TCard1* const  pc1Plain)
@@ -533,6 +551,18 @@ TAESEncrypter::DecryptImpl( const   tCIDLib::TCard1* const  pc1Cypher
 }
 
 
+tCIDLib::TVoid
+TAESEncrypter::EncryptBlocksImpl(const  tCIDLib::TCard1* const  pc1Plain
+                                ,       tCIDLib::TCard1* const  pc1Cypher
+                                , const tCIDLib::TCard4         c4Blocks)
+{
+    if (m_bHWAccel)
+        TCryptoHWAccel::AESEncryptBlocks(m_ac1HWERK, m_c4Rounds, pc1Plain, pc1Cypher, c4Blocks);
+    else
+        TParent::EncryptBlocksImpl(pc1Plain, pc1Cypher, c4Blocks);
+}
+
+
 tCIDLib::TVoid
 TAESEncrypter::EncryptImpl( const   tCIDLib::TCard1* const  pc1Plain
                             ,       tCIDLib::TCard1* const  pc1Cypher)
@@ -824,6 +854,23 @@ tCIDLib::TVoid TAESEncrypter::ResetImpl()
     *pc4SK++ = *pc4RK++;
     *pc4SK++ = *pc4RK++;
     *pc4SK++ = *pc4RK++;
+
+    //
+    //  If the CPU has AES-NI, then set up the byte form of the round keys. The
+    //  instructions want each round key as the bytes of the big endian round key
+    //  words, and the decrypt ones are the same equivalent inverse cypher ones
+    //  we just set up above.
+    //
+    m_bHWAccel = TCryptoHWAccel::bAESAvail();
+    if (m_bHWAccel)
+    {
+        const tCIDLib::TCard4 c4Words = (m_c4Rounds + 1) * 4;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Words; c4Index++)
+        {
+            PUTCARD4(m_ac4ERK[c4Index], m_ac1HWERK, c4Index * 4);
+            PUTCARD4(m_ac4DRK[c4Index], m_ac1HWDRK, c4Index * 4);
+        }
+    }
 }
 
 
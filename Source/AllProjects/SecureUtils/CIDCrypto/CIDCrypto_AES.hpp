@@ -84,12 +84,26 @@ class CIDCRYPTEXP TAESEncrypter : public TBlockEncrypter
         // -------------------------------------------------------------------
         //  Protected, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid DecryptBlocksImpl
+        (
+            const   tCIDLib::TCard1* const  pc1Cypher
+            ,       tCIDLib::TCard1* const  pc1Plain
+            , const tCIDLib::TCard4         c4Blocks
+        )   override;
+
         tCIDLib::TVoid DecryptImpl
         (
             const   tCIDLib::TCard1* const  pc1Cypher
             ,       tCIDLib::TCard1* const  pc1Plain
         )   override;
 
+        tCIDLib::TVoid EncryptBlocksImpl
+        (
+            const   tCIDLib::TCard1* const  pc1Plain
+            ,       tCIDLib::TCard1* const  pc1CypherBuf
+            , const tCIDLib::TCard4         c4Blocks
+        )   override;
+
         tCIDLib::TVoid EncryptImpl
         (
             const   tCIDLib::TCard1* const  pc1Plain
@@ -103,6 +117,11 @@ class CIDCRYPTEXP TAESEncrypter : public TBlockEncrypter
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_ac1HWDRK
+        //  m_ac1HWERK
+        //      The round keys in byte form, for the AES-NI path. Only set up
+        //      if m_bHWAccel is set.
+        //
         //  m_ac4DRK
         //  m_ac4ERK
         //      The decryption and encryption round keys, respectively. These
@@ -110,6 +129,10 @@ class CIDCRYPTEXP TAESEncrypter : public TBlockEncrypter
         //      instance specific data. The other stuff is not instance
         //      specific and is all internal to the CPP file.
         //
+        //  m_bHWAccel
+        //      Set if the CPU supports AES-NI, in which case multi-block
+        //      operations are done with that instead of the tables.
+        //
         //  m_c4Rounds
         //      The number of rounds we are doing. The number of rounds is
         //      driven by the key length.
@@ -118,8 +141,11 @@ class CIDCRYPTEXP TAESEncrypter : public TBlockEncrypter
         //      This is the key being used for encryption/decryption in
         //      this object.
         // -------------------------------------------------------------------
+        tCIDLib::TCard1     m_ac1HWDRK[240];
+        tCIDLib::TCard1     m_ac1HWERK[240];
         tCIDLib::TCard4     m_ac4DRK[64];
         tCIDLib::TCard4     m_ac4ERK[64];
+        tCIDLib::TBoolean   m_bHWAccel;
         tCIDLib::TCard4     m_c4Rounds;
         TCryptoKey          m_ckeyThis;
 
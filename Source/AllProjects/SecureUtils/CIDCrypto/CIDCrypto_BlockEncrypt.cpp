@@ -46,11 +46,229 @@ namespace
     namespace CIDCrypto_BlockEncrypt
     {
         constexpr tCIDLib::TCard4   c4BufSz = 4096;
+
+        //
+        //  The max number of blocks we pass to the multi-block methods at
+        //  once, for those modes that can do blocks independently.
+        //
+        constexpr tCIDLib::TCard4   c4BatchBlocks = 64;
+
+        // GCM only works with 16 byte blocks, a 12 byte nonce, and 16 byte tags
+        constexpr tCIDLib::TCard4   c4GCMBlockSz = 16;
+        constexpr tCIDLib::TCard4   c4GCMNonceSz = 12;
+        constexpr tCIDLib::TCard4   c4GCMTagSz = 16;
+
+        //
+        //  The reduction values for the four bits shifted out on each step of
+        //  the software GHASH multiply.
+        //
+        constexpr tCIDLib::TCard2   ac2GHashLast4[16] =
+        {
+            0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0
+          , 0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+        };
+
+
+        //
+        //  Increment the trailing c4Bytes bytes of a counter block as a big
+        //  endian number. CTR mode does the whole block, GCM only the last 4
+        //  bytes.
+        //
+        tCIDLib::TVoid IncCounter(          tCIDLib::TCard1* const  pc1Block
+                                    , const tCIDLib::TCard4         c4BlockSz
+                                    , const tCIDLib::TCard4         c4Bytes)
+        {
+            const tCIDLib::TCard4 c4Stop = c4BlockSz - c4Bytes;
+            tCIDLib::TCard4 c4Index = c4BlockSz;
+            while (c4Index > c4Stop)
+            {
+                c4Index--;
+                pc1Block[c4Index]++;
+                if (pc1Block[c4Index])
+                    break;
+            }
+        }
     }
 }
 
 
 
+// ---------------------------------------------------------------------------
+//   CLASS: TGCMHash
+//  PREFIX: ghash
+//
+//  A simple internal helper that does the GHASH part of GCM. It uses the
+//  PCLMULQDQ instruction if available, else a 4 bit table based multiply.
+//  Data is fed in full blocks, except for the last chunk of the AAD and the
+//  last chunk of the cypher text, which are zero padded.
+// ---------------------------------------------------------------------------
+class TGCMHash
+{
+    public :
+        TGCMHash(const tCIDLib::TCard1* const pc1H) :
+
+            m_bHWAccel(TCryptoHWAccel::bGHashAvail())
+            , m_ac1Hash()
+        {
+            TRawMem::CopyMemBuf(m_ac1H, pc1H, CIDCrypto_BlockEncrypt::c4GCMBlockSz);
+            if (!m_bHWAccel)
+                BuildTables();
+        }
+
+        TGCMHash(const TGCMHash&) = delete;
+        TGCMHash& operator=(const TGCMHash&) = delete;
+
+        tCIDLib::TVoid Complete(const   tCIDLib::TCard4         c4AuthBytes
+                                , const tCIDLib::TCard4         c4TextBytes
+                                ,       tCIDLib::TCard1* const  pc1ToFill)
+        {
+            // Hash in the bit lengths of the two parts, as 64 bit big endian values
+            tCIDLib::TCard1 ac1Lens[CIDCrypto_BlockEncrypt::c4GCMBlockSz];
+            PutCard8(tCIDLib::TCard8(c4AuthBytes) * 8, ac1Lens);
+            PutCard8(tCIDLib::TCard8(c4TextBytes) * 8, &ac1Lens[8]);
+            Update(ac1Lens, CIDCrypto_BlockEncrypt::c4GCMBlockSz);
+
+            TRawMem::CopyMemBuf(pc1ToFill, m_ac1Hash, CIDCrypto_BlockEncrypt::c4GCMBlockSz);
+        }
+
+        tCIDLib::TVoid Update(const tCIDLib::TCard1* pc1Data, const tCIDLib::TCard4 c4Bytes)
+        {
+            constexpr tCIDLib::TCard4 c4BlockSz = CIDCrypto_BlockEncrypt::c4GCMBlockSz;
+            const tCIDLib::TCard4 c4Full = c4Bytes / c4BlockSz;
+            if (c4Full)
+            {
+                if (m_bHWAccel)
+                {
+                    TCryptoHWAccel::GHashBlocks(m_ac1H, m_ac1Hash, pc1Data, c4Full);
+                    pc1Data += c4Full * c4BlockSz;
+                }
+                 else
+                {
+                    for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Full; c4BInd++)
+                    {
+                        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlockSz; c4Index++)
+                            m_ac1Hash[c4Index] ^= pc1Data[c4Index];
+                        MulH();
+                        pc1Data += c4BlockSz;
+                    }
+                }
+            }
+
+            // If a trailing partial block, zero pad it
+            const tCIDLib::TCard4 c4Extra = c4Bytes - (c4Full * c4BlockSz);
+            if (c4Extra)
+            {
+                tCIDLib::TCard1 ac1Last[c4BlockSz] = {0};
+                TRawMem::CopyMemBuf(ac1Last, pc1Data, c4Extra);
+                if (m_bHWAccel)
+                {
+                    TCryptoHWAccel::GHashBlocks(m_ac1H, m_ac1Hash, ac1Last, 1);
+                }
+                 else
+                {
+                    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlockSz; c4Index++)
+                        m_ac1Hash[c4Index] ^= ac1Last[c4Index];
+                    MulH();
+                }
+            }
+        }
+
+    private :
+        static tCIDLib::TCard8 c8GetCard8(const tCIDLib::TCard1* const pc1Src)
+        {
+            tCIDLib::TCard8 c8Ret = 0;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+                c8Ret = (c8Ret << 8) | pc1Src[c4Index];
+            return c8Ret;
+        }
+
+        static tCIDLib::TVoid PutCard8(tCIDLib::TCard8 c8Val, tCIDLib::TCard1* const pc1Tar)
+        {
+            for (tCIDLib::TCard4 c4Index = 8; c4Index > 0; c4Index--)
+            {
+                pc1Tar[c4Index - 1] = tCIDLib::TCard1(c8Val);
+                c8Val >>= 8;
+            }
+        }
+
+        //
+        //  Build the tables of H times each 4 bit value. We get the power of
+        //  two multiples by shifting (which is multiplying by x in the GCM bit
+        //  order), and the rest by XORing those together.
+        //
+        tCIDLib::TVoid BuildTables()
+        {
+            tCIDLib::TCard8 c8High = c8GetCard8(m_ac1H);
+            tCIDLib::TCard8 c8Low = c8GetCard8(&m_ac1H[8]);
+
+            m_ac8HL[8] = c8Low;
+            m_ac8HH[8] = c8High;
+            m_ac8HH[0] = 0;
+            m_ac8HL[0] = 0;
+
+            for (tCIDLib::TCard4 c4Index = 4; c4Index > 0; c4Index >>= 1)
+            {
+                const tCIDLib::TCard4 c4Reduce = tCIDLib::TCard4(c8Low & 1) * 0xE1000000;
+                c8Low = (c8High << 63) | (c8Low >> 1);
+                c8High = (c8High >> 1) ^ (tCIDLib::TCard8(c4Reduce) << 32);
+                m_ac8HL[c4Index] = c8Low;
+                m_ac8HH[c4Index] = c8High;
+            }
+
+            for (tCIDLib::TCard4 c4Index = 2; c4Index <= 8; c4Index *= 2)
+            {
+                for (tCIDLib::TCard4 c4Sub = 1; c4Sub < c4Index; c4Sub++)
+                {
+                    m_ac8HH[c4Index + c4Sub] = m_ac8HH[c4Index] ^ m_ac8HH[c4Sub];
+                    m_ac8HL[c4Index + c4Sub] = m_ac8HL[c4Index] ^ m_ac8HL[c4Sub];
+                }
+            }
+        }
+
+        // Multiply the running hash by H, four bits at a time
+        tCIDLib::TVoid MulH()
+        {
+            tCIDLib::TCard1 c1Nib = m_ac1Hash[15] & 0xF;
+            tCIDLib::TCard8 c8High = m_ac8HH[c1Nib];
+            tCIDLib::TCard8 c8Low = m_ac8HL[c1Nib];
+
+            for (tCIDLib::TInt4 i4Index = 15; i4Index >= 0; i4Index--)
+            {
+                const tCIDLib::TCard1 c1Low = m_ac1Hash[i4Index] & 0xF;
+                const tCIDLib::TCard1 c1High = m_ac1Hash[i4Index] >> 4;
+                tCIDLib::TCard1 c1Rem;
+
+                if (i4Index != 15)
+                {
+                    c1Rem = tCIDLib::TCard1(c8Low & 0xF);
+                    c8Low = (c8High << 60) | (c8Low >> 4);
+                    c8High >>= 4;
+                    c8High ^= tCIDLib::TCard8(CIDCrypto_BlockEncrypt::ac2GHashLast4[c1Rem]) << 48;
+                    c8High ^= m_ac8HH[c1Low];
+                    c8Low ^= m_ac8HL[c1Low];
+                }
+
+                c1Rem = tCIDLib::TCard1(c8Low & 0xF);
+                c8Low = (c8High << 60) | (c8Low >> 4);
+                c8High >>= 4;
+                c8High ^= tCIDLib::TCard8(CIDCrypto_BlockEncrypt::ac2GHashLast4[c1Rem]) << 48;
+                c8High ^= m_ac8HH[c1High];
+                c8Low ^= m_ac8HL[c1High];
+            }
+
+            PutCard8(c8High, m_ac1Hash);
+            PutCard8(c8Low, &m_ac1Hash[8]);
+        }
+
+        tCIDLib::TBoolean   m_bHWAccel;
+        tCIDLib::TCard1     m_ac1H[CIDCrypto_BlockEncrypt::c4GCMBlockSz];
+        tCIDLib::TCard1     m_ac1Hash[CIDCrypto_BlockEncrypt::c4GCMBlockSz];
+        tCIDLib::TCard8     m_ac8HH[16];
+        tCIDLib::TCard8     m_ac8HL[16];
+};
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TBlockEncrypter
 //  PREFIX: cryp
@@ -62,13 +280,16 @@ namespace
 TBlockEncrypter::TBlockEncrypter(const  tCIDLib::TCard4         c4BlockSize
                                 , const tCIDCrypto::EBlockModes eMode) :
 
-    m_c4BlockSize(c4BlockSize)
+    m_c4AuthBytes(0)
+    , m_c4BlockSize(c4BlockSize)
     , m_eMode(eMode)
+    , m_pc1AuthData(nullptr)
 {
 }
 
 TBlockEncrypter::~TBlockEncrypter()
 {
+    delete [] m_pc1AuthData;
 }
 
 
@@ -86,9 +307,15 @@ TBlockEncrypter::c4Decrypt( const   TMemBuf&                mbufCypher
     //
     //  On decryption the source cypher bytes buffer must be an equal
     //  multiple of the block size, since the encryption should have forced
-    //  this to happen by padding any trailing partial block.
+    //  this to happen by padding any trailing partial block. The CTR and GCM
+    //  modes don't pad, so it can be any size for them.
     //
-    if (c4CypherBytes % m_c4BlockSize)
+    const tCIDLib::TBoolean bPadded
+    (
+        (m_eMode != tCIDCrypto::EBlockModes::CTR)
+        && (m_eMode != tCIDCrypto::EBlockModes::GCM)
+    );
+    if (bPadded && (c4CypherBytes % m_c4BlockSize))
     {
         facCIDCrypto().ThrowErr
         (
@@ -141,8 +368,13 @@ TBlockEncrypter::c4Decrypt( const   tCIDLib::TCard1* const  pc1Cypher
     //
     //  If an IV is required, and not provided, throw. In CBC mode without the random
     //  first block we have to have the original IV to get back the real first block.
+    //  The stream style modes always need the IV to recreate the key stream.
     //
-    if ((m_eMode == tCIDCrypto::EBlockModes::CBC) && !pc1IV)
+    if (((m_eMode == tCIDCrypto::EBlockModes::CBC)
+    ||   (m_eMode == tCIDCrypto::EBlockModes::OFB)
+    ||   (m_eMode == tCIDCrypto::EBlockModes::CTR)
+    ||   (m_eMode == tCIDCrypto::EBlockModes::GCM))
+    &&  !pc1IV)
     {
         facCIDCrypto().ThrowErr
         (
@@ -156,9 +388,10 @@ TBlockEncrypter::c4Decrypt( const   tCIDLib::TCard1* const  pc1Cypher
 
     //
     //  If zero cypher bytes, short circuit and just say zero output bytes. That's just
-    //  not a situation we care to support.
+    //  not a situation we care to support. For GCM there's always at least the tag,
+    //  so let it go through and complain.
     //
-    if (!c4CypherBytes)
+    if (!c4CypherBytes && (m_eMode != tCIDCrypto::EBlockModes::GCM))
         return 0;
 
     // Do the appropriate decrypt for our mode
@@ -178,6 +411,14 @@ TBlockEncrypter::c4Decrypt( const   tCIDLib::TCard1* const  pc1Cypher
             c4Ret = c4OFBProcess(pc1Cypher, c4CypherBytes, mbufPlain, pc1IV);
             break;
 
+        case tCIDCrypto::EBlockModes::CTR :
+            c4Ret = c4CTRProcess(pc1Cypher, c4CypherBytes, mbufPlain, pc1IV);
+            break;
+
+        case tCIDCrypto::EBlockModes::GCM :
+            c4Ret = c4GCMDecrypt(pc1Cypher, c4CypherBytes, mbufPlain, pc1IV);
+            break;
+
         default :
             CIDAssert2(L"Unknown block decryption mode");
             break;
@@ -293,7 +534,9 @@ TBlockEncrypter::c4Encrypt( const   tCIDLib::TCard1* const  pc1Plain
     // If an IV is required, and not provided, throw
     if (((m_eMode == tCIDCrypto::EBlockModes::CBC)
     ||   (m_eMode == tCIDCrypto::EBlockModes::CBC_IV)
-    ||   (m_eMode == tCIDCrypto::EBlockModes::OFB))
+    ||   (m_eMode == tCIDCrypto::EBlockModes::OFB)
+    ||   (m_eMode == tCIDCrypto::EBlockModes::CTR)
+    ||   (m_eMode == tCIDCrypto::EBlockModes::GCM))
     &&  !pac1IV)
     {
         facCIDCrypto().ThrowErr
@@ -306,6 +549,22 @@ TBlockEncrypter::c4Encrypt( const   tCIDLib::TCard1* const  pc1Plain
         );
     }
 
+    //
+    //  The stream style modes don't pad, so they get handled separately. GCM can
+    //  legally have no plain text, in which case the output is just the tag that
+    //  authenticates the additional data.
+    //
+    if (m_eMode == tCIDCrypto::EBlockModes::CTR)
+    {
+        if (!c4PlainBytes)
+            return 0;
+        return c4CTRProcess(pc1Plain, c4PlainBytes, mbufCypher, pac1IV);
+    }
+     else if (m_eMode == tCIDCrypto::EBlockModes::GCM)
+    {
+        return c4GCMEncrypt(pc1Plain, c4PlainBytes, mbufCypher, pac1IV);
+    }
+
     //
     //  If zero plain bytes, short circuit and just say zero output bytes. That's just
     //  not a situation we care to support.
@@ -463,12 +722,74 @@ TBlockEncrypter::eMode(const tCIDCrypto::EBlockModes eNewMode)
 }
 
 
+//
+//  Clear or set the additional authenticated data that GCM mode will hash in
+//  along with the cypher text. It's ignored in other modes.
+//
+tCIDLib::TVoid TBlockEncrypter::ClearAuthData()
+{
+    delete [] m_pc1AuthData;
+    m_pc1AuthData = nullptr;
+    m_c4AuthBytes = 0;
+}
+
+
 tCIDLib::TVoid TBlockEncrypter::Reset()
 {
     ResetImpl();
 }
 
 
+tCIDLib::TVoid
+TBlockEncrypter::SetAuthData(const  tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4Bytes)
+{
+    ClearAuthData();
+    if (c4Bytes)
+    {
+        m_pc1AuthData = new tCIDLib::TCard1[c4Bytes];
+        TRawMem::CopyMemBuf(m_pc1AuthData, pc1Data, c4Bytes);
+        m_c4AuthBytes = c4Bytes;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TBlockEncrypter: Protected, virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  By default we just do them one at a time. Derived classes can override
+//  these if they can do better.
+//
+tCIDLib::TVoid
+TBlockEncrypter::DecryptBlocksImpl( const   tCIDLib::TCard1* const  pc1Cypher
+                                    ,       tCIDLib::TCard1* const  pc1Plain
+                                    , const tCIDLib::TCard4         c4Blocks)
+{
+    tCIDLib::TCard4 c4Ofs = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Blocks; c4Index++)
+    {
+        DecryptImpl(pc1Cypher + c4Ofs, pc1Plain + c4Ofs);
+        c4Ofs += m_c4BlockSize;
+    }
+}
+
+tCIDLib::TVoid
+TBlockEncrypter::EncryptBlocksImpl( const   tCIDLib::TCard1* const  pc1Plain
+                                    ,       tCIDLib::TCard1* const  pc1Cypher
+                                    , const tCIDLib::TCard4         c4Blocks)
+{
+    tCIDLib::TCard4 c4Ofs = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Blocks; c4Index++)
+    {
+        EncryptImpl(pc1Plain + c4Ofs, pc1Cypher + c4Ofs);
+        c4Ofs += m_c4BlockSize;
+    }
+}
+
+
 
 // ---------------------------------------------------------------------------
 //  TBlockEncrypter: Protected, non-virtual methods
@@ -488,26 +809,33 @@ TBlockEncrypter::c4ECBDecrypt(  const   tCIDLib::TCard1* const  pc1Cypher
     const tCIDLib::TCard4 c4FullBlocks = c4CypherBytes / m_c4BlockSize;
 
     //
-    //  And here is a current block index we use to run through the
-    //  blocks and a pointer into each buffer that we bump up as we
-    //  go through the data.
+    //  The blocks are independent, so we do them in batches, which lets
+    //  the derived class pipeline them if it can.
     //
-    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[m_c4BlockSize];
+    const tCIDLib::TCard4 c4BatchBytes = CIDCrypto_BlockEncrypt::c4BatchBlocks * m_c4BlockSize;
+    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[c4BatchBytes];
     TArrayJanitor<tCIDLib::TCard1> janDest(pc1Dest);
 
     const tCIDLib::TCard1* pc1Src = pc1Cypher;
     tCIDLib::TCard4 c4TarInd = 0;
-    for (tCIDLib::TCard4 c4BlockInd = 0; c4BlockInd < c4FullBlocks; c4BlockInd++)
+    tCIDLib::TCard4 c4BlocksLeft = c4FullBlocks;
+    while (c4BlocksLeft)
     {
-        // Decrypt a block from the source to the destination
-        DecryptImpl(pc1Src, pc1Dest);
+        tCIDLib::TCard4 c4ThisTime = c4BlocksLeft;
+        if (c4ThisTime > CIDCrypto_BlockEncrypt::c4BatchBlocks)
+            c4ThisTime = CIDCrypto_BlockEncrypt::c4BatchBlocks;
+        const tCIDLib::TCard4 c4ThisBytes = c4ThisTime * m_c4BlockSize;
+
+        // Decrypt a batch from the source to the destination
+        DecryptBlocksImpl(pc1Src, pc1Dest, c4ThisTime);
 
         // And copy to our target buffer
-        mbufPlain.CopyIn(pc1Dest, m_c4BlockSize, c4TarInd);
+        mbufPlain.CopyIn(pc1Dest, c4ThisBytes, c4TarInd);
 
         // And move to the next round
-        pc1Src += m_c4BlockSize;
-        c4TarInd += m_c4BlockSize;
+        pc1Src += c4ThisBytes;
+        c4TarInd += c4ThisBytes;
+        c4BlocksLeft -= c4ThisTime;
     }
 
     // Return the actual bytes decrypted
@@ -555,8 +883,12 @@ TBlockEncrypter::c4CBCDecrypt(  const   tCIDLib::TCard1* const  pc1Cypher
     tCIDLib::TCard4 c4BlockInd = 0;
     const tCIDLib::TCard1* pc1Src = pc1Cypher;
 
-    // Allocate a block size output buffer to use for each round
-    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[m_c4BlockSize];
+    //
+    //  Allocate an output buffer to use for each round. Decryption can be done
+    //  in batches since each block only depends on the previous cypher text.
+    //
+    const tCIDLib::TCard4 c4BatchBytes = CIDCrypto_BlockEncrypt::c4BatchBlocks * m_c4BlockSize;
+    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[c4BatchBytes];
     TArrayJanitor<tCIDLib::TCard1> janDest(pc1Dest);
 
     //
@@ -591,23 +923,27 @@ TBlockEncrypter::c4CBCDecrypt(  const   tCIDLib::TCard1* const  pc1Cypher
     }
 
 
-    for (; c4BlockInd < c4FullBlocks; c4BlockInd++)
+    while (c4BlockInd < c4FullBlocks)
     {
-        // Decrypt a block from the source to the destination
-        DecryptImpl(pc1Src, pc1Dest);
+        tCIDLib::TCard4 c4ThisTime = c4FullBlocks - c4BlockInd;
+        if (c4ThisTime > CIDCrypto_BlockEncrypt::c4BatchBlocks)
+            c4ThisTime = CIDCrypto_BlockEncrypt::c4BatchBlocks;
+        const tCIDLib::TCard4 c4ThisBytes = c4ThisTime * m_c4BlockSize;
 
-        // Xor with the previous block
-        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < m_c4BlockSize; c4Ind++)
-        {
-            pc1Dest[c4Ind] ^= *pc1Prev;
-            pc1Prev++;
-        }
+        // Decrypt a batch of blocks from the source to the destination
+        DecryptBlocksImpl(pc1Src, pc1Dest, c4ThisTime);
 
-        mbufCypher.CopyIn(pc1Dest, m_c4BlockSize, c4TarInd);
+        // Xor each with the previous cypher block
+        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4ThisBytes; c4Ind++)
+            pc1Dest[c4Ind] ^= pc1Prev[c4Ind];
+        pc1Prev += c4ThisBytes;
 
-        // And adjust for the next block
-        pc1Src += m_c4BlockSize;
-        c4TarInd += m_c4BlockSize;
+        mbufCypher.CopyIn(pc1Dest, c4ThisBytes, c4TarInd);
+
+        // And adjust for the next batch
+        pc1Src += c4ThisBytes;
+        c4TarInd += c4ThisBytes;
+        c4BlockInd += c4ThisTime;
     }
 
     CIDAssert(c4TarInd == c4OutputBytes, L"CBC decrypt output size != expected");
@@ -659,30 +995,36 @@ TBlockEncrypter::c4ECBEncrypt(  const   tCIDLib::TCard1* const  pc1Plain
     if (mbufCypher.c4Size() < c4OutputBytes)
         mbufCypher.Reallocate(c4OutputBytes, kCIDLib::False);
 
-    // Allocate a block size output buffer to use for each round
-    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[m_c4BlockSize];
+    // Allocate an output buffer big enough for a batch of blocks
+    const tCIDLib::TCard4 c4BatchBytes = CIDCrypto_BlockEncrypt::c4BatchBlocks * m_c4BlockSize;
+    tCIDLib::TCard1* pc1Dest = new tCIDLib::TCard1[c4BatchBytes];
     TArrayJanitor<tCIDLib::TCard1> janDest(pc1Dest);
     const tCIDLib::TCard1* pc1Src = pc1Plain;
 
     //
     //  Ok, so now we can just run through the full blocks and encrypt
-    //  each one out to the plain text buffer. On each round we just pass
-    //  the derived class' basic block encrypt/decrypt method a raw pointer
-    //  into each buffer. We both agree on the block size so he knows how
-    //  many bytes to do and we know how many bytes to move forward each
-    //  time.
+    //  them out to the cypher text buffer. The blocks are independent, so
+    //  we pass the derived class' multi-block encrypt method a batch at a
+    //  time, which lets it pipeline them if it can.
     //
     tCIDLib::TCard4 c4TarInd = 0;
-    for (tCIDLib::TCard4 c4BlockInd = 0; c4BlockInd < c4FullBlocks; c4BlockInd++)
+    tCIDLib::TCard4 c4BlocksLeft = c4FullBlocks;
+    while (c4BlocksLeft)
     {
-        // Do another block
-        EncryptImpl(pc1Src, pc1Dest);
+        tCIDLib::TCard4 c4ThisTime = c4BlocksLeft;
+        if (c4ThisTime > CIDCrypto_BlockEncrypt::c4BatchBlocks)
+            c4ThisTime = CIDCrypto_BlockEncrypt::c4BatchBlocks;
+        const tCIDLib::TCard4 c4ThisBytes = c4ThisTime * m_c4BlockSize;
 
-        // Copy this block to the output buffer and adjust for the next round
-        mbufCypher.CopyIn(pc1Dest, m_c4BlockSize, c4TarInd);
+        // Do another batch
+        EncryptBlocksImpl(pc1Src, pc1Dest, c4ThisTime);
 
-        pc1Src += m_c4BlockSize;
-        c4TarInd += m_c4BlockSize;
+        // Copy them to the output buffer and adjust for the next round
+        mbufCypher.CopyIn(pc1Dest, c4ThisBytes, c4TarInd);
+
+        pc1Src += c4ThisBytes;
+        c4TarInd += c4ThisBytes;
+        c4BlocksLeft -= c4ThisTime;
     }
 
     if (c4ExtraBytes)
@@ -1017,3 +1359,281 @@ TBlockEncrypter::c4OFBProcess(  const   tCIDLib::TCard1* const  pc1Input
     // Return the actual bytes decrypted
     return c4OutputBytes;
 }
+
+
+//
+//  Does a CTR mode decrypt or encrypt. Like OFB it is symmetric, but the key
+//  stream is the encryption of a counter, so every block can be done at once.
+//  The IV is the initial counter block. There's no padding, so the output is
+//  the same size as the input.
+//
+tCIDLib::TCard4
+TBlockEncrypter::c4CTRProcess(  const   tCIDLib::TCard1* const  pc1Input
+                                , const tCIDLib::TCard4         c4InBytes
+                                ,       TMemBuf&                mbufOut
+                                , const tCIDLib::TCard1* const  pac1IV)
+{
+    // Make sure the output buffer can handle it
+    if (mbufOut.c4MaxSize() < c4InBytes)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcGen_TargetTooSmall
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::CantDo
+            , TCardinal(c4InBytes)
+            , TCardinal(mbufOut.c4MaxSize())
+        );
+    }
+
+    if (mbufOut.c4Size() < c4InBytes)
+        mbufOut.Reallocate(c4InBytes, kCIDLib::False);
+
+    // Copy the IV to a counter block that we can bump
+    tCIDLib::TCard1* pc1Counter = new tCIDLib::TCard1[m_c4BlockSize];
+    TArrayJanitor<tCIDLib::TCard1> janCounter(pc1Counter);
+    TRawMem::CopyMemBuf(pc1Counter, pac1IV, m_c4BlockSize);
+
+    CTRTransform(pc1Input, c4InBytes, mbufOut, pc1Counter, m_c4BlockSize, nullptr);
+    return c4InBytes;
+}
+
+
+//
+//  Does a GCM mode decrypt. We hash the cypher text and check the tag first,
+//  and only decrypt if it's good. That way we never return unauthenticated
+//  plain text to the caller, even partially.
+//
+tCIDLib::TCard4
+TBlockEncrypter::c4GCMDecrypt(  const   tCIDLib::TCard1* const  pc1Cypher
+                                , const tCIDLib::TCard4         c4CypherBytes
+                                ,       TMemBuf&                mbufPlain
+                                , const tCIDLib::TCard1* const  pac1IV)
+{
+    CheckGCMBlockSize();
+
+    if (c4CypherBytes < CIDCrypto_BlockEncrypt::c4GCMTagSz)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcBlock_NoAuthTag
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+        );
+    }
+    const tCIDLib::TCard4 c4TextBytes = c4CypherBytes - CIDCrypto_BlockEncrypt::c4GCMTagSz;
+
+    if (mbufPlain.c4MaxSize() < c4TextBytes)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcGen_TargetTooSmall
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::CantDo
+            , TCardinal(c4TextBytes)
+            , TCardinal(mbufPlain.c4MaxSize())
+        );
+    }
+
+    // The hash key is the encryption of a zero block
+    constexpr tCIDLib::TCard4 c4BlockSz = CIDCrypto_BlockEncrypt::c4GCMBlockSz;
+    tCIDLib::TCard1 ac1Zero[c4BlockSz] = {0};
+    tCIDLib::TCard1 ac1H[c4BlockSz];
+    EncryptImpl(ac1Zero, ac1H);
+
+    // Hash the additional data and cypher text and create the expected tag
+    TGCMHash ghashIn(ac1H);
+    ghashIn.Update(m_pc1AuthData, m_c4AuthBytes);
+    ghashIn.Update(pc1Cypher, c4TextBytes);
+
+    tCIDLib::TCard1 ac1Tag[c4BlockSz];
+    ghashIn.Complete(m_c4AuthBytes, c4TextBytes, ac1Tag);
+
+    // The initial counter block is the nonce and a 32 bit count of 1
+    tCIDLib::TCard1 ac1Counter[c4BlockSz] = {0};
+    TRawMem::CopyMemBuf(ac1Counter, pac1IV, CIDCrypto_BlockEncrypt::c4GCMNonceSz);
+    ac1Counter[c4BlockSz - 1] = 1;
+
+    tCIDLib::TCard1 ac1Mask[c4BlockSz];
+    EncryptImpl(ac1Counter, ac1Mask);
+
+    //
+    //  Compare the tags. Don't bail out on the first difference, so as not to
+    //  let the timing indicate how much of it was right.
+    //
+    const tCIDLib::TCard1* pc1InTag = pc1Cypher + c4TextBytes;
+    tCIDLib::TCard1 c1Diffs = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlockSz; c4Index++)
+        c1Diffs |= tCIDLib::TCard1(ac1Tag[c4Index] ^ ac1Mask[c4Index] ^ pc1InTag[c4Index]);
+
+    if (c1Diffs)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcBlock_AuthFailed
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Authority
+        );
+    }
+
+    // It's good, so decrypt, starting with the counter after the one for the tag
+    if (c4TextBytes)
+    {
+        if (mbufPlain.c4Size() < c4TextBytes)
+            mbufPlain.Reallocate(c4TextBytes, kCIDLib::False);
+
+        CIDCrypto_BlockEncrypt::IncCounter(ac1Counter, c4BlockSz, 4);
+        CTRTransform(pc1Cypher, c4TextBytes, mbufPlain, ac1Counter, 4, nullptr);
+    }
+    return c4TextBytes;
+}
+
+
+//
+//  Does a GCM mode encrypt. This is CTR mode with a 32 bit counter, and the
+//  cypher text is hashed as it's created. The tag is appended to the output.
+//
+tCIDLib::TCard4
+TBlockEncrypter::c4GCMEncrypt(  const   tCIDLib::TCard1* const  pc1Plain
+                                , const tCIDLib::TCard4         c4PlainBytes
+                                ,       TMemBuf&                mbufCypher
+                                , const tCIDLib::TCard1* const  pac1IV)
+{
+    CheckGCMBlockSize();
+
+    const tCIDLib::TCard4 c4OutputBytes = c4PlainBytes + CIDCrypto_BlockEncrypt::c4GCMTagSz;
+    if (mbufCypher.c4MaxSize() < c4OutputBytes)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcGen_TargetTooSmall
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::CantDo
+            , TCardinal(c4OutputBytes)
+            , TCardinal(mbufCypher.c4MaxSize())
+        );
+    }
+
+    if (mbufCypher.c4Size() < c4OutputBytes)
+        mbufCypher.Reallocate(c4OutputBytes, kCIDLib::False);
+
+    // The hash key is the encryption of a zero block
+    constexpr tCIDLib::TCard4 c4BlockSz = CIDCrypto_BlockEncrypt::c4GCMBlockSz;
+    tCIDLib::TCard1 ac1Zero[c4BlockSz] = {0};
+    tCIDLib::TCard1 ac1H[c4BlockSz];
+    EncryptImpl(ac1Zero, ac1H);
+
+    TGCMHash ghashOut(ac1H);
+    ghashOut.Update(m_pc1AuthData, m_c4AuthBytes);
+
+    // The initial counter block is the nonce and a 32 bit count of 1
+    tCIDLib::TCard1 ac1J0[c4BlockSz] = {0};
+    TRawMem::CopyMemBuf(ac1J0, pac1IV, CIDCrypto_BlockEncrypt::c4GCMNonceSz);
+    ac1J0[c4BlockSz - 1] = 1;
+
+    // The data starts with the next counter
+    tCIDLib::TCard1 ac1Counter[c4BlockSz];
+    TRawMem::CopyMemBuf(ac1Counter, ac1J0, c4BlockSz);
+    CIDCrypto_BlockEncrypt::IncCounter(ac1Counter, c4BlockSz, 4);
+    CTRTransform(pc1Plain, c4PlainBytes, mbufCypher, ac1Counter, 4, &ghashOut);
+
+    // And the tag is the hash XORed with the encrypted initial counter
+    tCIDLib::TCard1 ac1Tag[c4BlockSz];
+    ghashOut.Complete(m_c4AuthBytes, c4PlainBytes, ac1Tag);
+
+    tCIDLib::TCard1 ac1Mask[c4BlockSz];
+    EncryptImpl(ac1J0, ac1Mask);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlockSz; c4Index++)
+        ac1Tag[c4Index] ^= ac1Mask[c4Index];
+
+    mbufCypher.CopyIn(ac1Tag, c4BlockSz, c4PlainBytes);
+    return c4OutputBytes;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TBlockEncrypter: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// GCM is only defined for 128 bit block cyphers
+tCIDLib::TVoid TBlockEncrypter::CheckGCMBlockSize() const
+{
+    if (m_c4BlockSize != CIDCrypto_BlockEncrypt::c4GCMBlockSz)
+    {
+        facCIDCrypto().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCryptoErrs::errcBlock_ModeBlockSize
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::NotSupported
+            , TString(L"GCM")
+            , TCardinal(CIDCrypto_BlockEncrypt::c4GCMBlockSz)
+        );
+    }
+}
+
+
+//
+//  The counter mode grunt work for CTR and GCM. We create a batch of counter
+//  blocks, encrypt them all in one shot to get the key stream, and XOR that
+//  with the input. The trailing c4CountBytes bytes of the counter block are
+//  the counter, and it's left at the next counter to use.
+//
+//  If a GCM hash is passed, the output is hashed as we go. It's only used on
+//  encrypt, where the output is the cypher text.
+//
+tCIDLib::TVoid
+TBlockEncrypter::CTRTransform(  const   tCIDLib::TCard1*        pc1Input
+                                , const tCIDLib::TCard4         c4InBytes
+                                ,       TMemBuf&                mbufOut
+                                ,       tCIDLib::TCard1* const  pc1Counter
+                                , const tCIDLib::TCard4         c4CountBytes
+                                ,       TGCMHash* const         pghashOut)
+{
+    const tCIDLib::TCard4 c4BatchBytes = CIDCrypto_BlockEncrypt::c4BatchBlocks * m_c4BlockSize;
+    tCIDLib::TCard1* pc1Counters = new tCIDLib::TCard1[c4BatchBytes * 2];
+    TArrayJanitor<tCIDLib::TCard1> janCounters(pc1Counters);
+    tCIDLib::TCard1* const pc1KeyStream = pc1Counters + c4BatchBytes;
+
+    tCIDLib::TCard4 c4Done = 0;
+    while (c4Done < c4InBytes)
+    {
+        tCIDLib::TCard4 c4ThisBytes = c4InBytes - c4Done;
+        if (c4ThisBytes > c4BatchBytes)
+            c4ThisBytes = c4BatchBytes;
+        const tCIDLib::TCard4 c4ThisBlocks = (c4ThisBytes + m_c4BlockSize - 1) / m_c4BlockSize;
+
+        // Fill in the counter blocks for this batch
+        tCIDLib::TCard1* pc1Cur = pc1Counters;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThisBlocks; c4Index++)
+        {
+            TRawMem::CopyMemBuf(pc1Cur, pc1Counter, m_c4BlockSize);
+            CIDCrypto_BlockEncrypt::IncCounter(pc1Counter, m_c4BlockSize, c4CountBytes);
+            pc1Cur += m_c4BlockSize;
+        }
+
+        // Encrypt them to get the key stream, and XOR in the input
+        EncryptBlocksImpl(pc1Counters, pc1KeyStream, c4ThisBlocks);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThisBytes; c4Index++)
+            pc1KeyStream[c4Index] ^= pc1Input[c4Index];
+
+        mbufOut.CopyIn(pc1KeyStream, c4ThisBytes, c4Done);
+        if (pghashOut)
+            pghashOut->Update(pc1KeyStream, c4ThisBytes);
+
+        pc1Input += c4ThisBytes;
+        c4Done += c4ThisBytes;
+    }
+}
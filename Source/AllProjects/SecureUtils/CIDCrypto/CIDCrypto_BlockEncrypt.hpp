@@ -25,6 +25,19 @@
 //  request. We handle the various block encryption modes for them. This is
 //  slower, but drastically reduces the likelihood of error.
 //
+//  Derived classes can optionally override the multi-block methods, if they
+//  can do a run of blocks faster than one at a time (e.g. hardware support
+//  that can pipeline blocks.) We use those wherever the mode lets blocks be
+//  done independently, i.e. ECB, CBC decrypt, and the CTR and GCM modes.
+//
+//  For CTR, the IV is the initial counter block, which is incremented as a
+//  big endian number for each block. For GCM, the first 12 bytes of the IV
+//  are the nonce. In either case never use the same IV twice with the same
+//  key. GCM appends a 16 byte authentication tag to the cypher text, and the
+//  decrypt will throw if it doesn't match. Any additional data that should
+//  be authenticated but not encrypted can be set via SetAuthData(), and must
+//  be set the same on both sides.
+//
 //
 // CAVEATS/GOTCHAS:
 //
@@ -37,6 +50,8 @@
 
 #pragma CIDLIB_PACK(CIDLIBPACK)
 
+class TGCMHash;
+
 // ---------------------------------------------------------------------------
 //   CLASS: TBlockEncrypter
 //  PREFIX: cryp
@@ -140,8 +155,16 @@ class CIDCRYPTEXP TBlockEncrypter : public TObject
             const   tCIDCrypto::EBlockModes eNewMode
         );
 
+        tCIDLib::TVoid ClearAuthData();
+
         tCIDLib::TVoid Reset();
 
+        tCIDLib::TVoid SetAuthData
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4Bytes
+        );
+
 
     protected   :
         // -------------------------------------------------------------------
@@ -157,12 +180,26 @@ class CIDCRYPTEXP TBlockEncrypter : public TObject
         // -------------------------------------------------------------------
         //  Protected, virtual methods
         // -------------------------------------------------------------------
+        virtual tCIDLib::TVoid DecryptBlocksImpl
+        (
+            const   tCIDLib::TCard1* const  pc1Cypher
+            ,       tCIDLib::TCard1* const  pc1Plain
+            , const tCIDLib::TCard4         c4Blocks
+        );
+
         virtual tCIDLib::TVoid DecryptImpl
         (
             const   tCIDLib::TCard1* const  pc1Cypher
             ,       tCIDLib::TCard1* const  pc1Plain
         ) = 0;
 
+        virtual tCIDLib::TVoid EncryptBlocksImpl
+        (
+            const   tCIDLib::TCard1* const  pc1Plain
+            ,       tCIDLib::TCard1* const  pc1CypherBuf
+            , const tCIDLib::TCard4         c4Blocks
+        );
+
         virtual tCIDLib::TVoid EncryptImpl
         (
             const   tCIDLib::TCard1* const  pc1Plain
@@ -205,6 +242,30 @@ class CIDCRYPTEXP TBlockEncrypter : public TObject
             , const tCIDLib::TCard1* const  pc1IV
         );
 
+        tCIDLib::TCard4 c4CTRProcess
+        (
+            const   tCIDLib::TCard1* const  pc1Input
+            , const tCIDLib::TCard4         c4InputBytes
+            ,       TMemBuf&                mbufOut
+            , const tCIDLib::TCard1* const  pc1IV
+        );
+
+        tCIDLib::TCard4 c4GCMDecrypt
+        (
+            const   tCIDLib::TCard1* const  pc1Cypher
+            , const tCIDLib::TCard4         c4CypherBytes
+            ,       TMemBuf&                mbufPlain
+            , const tCIDLib::TCard1* const  pc1IV
+        );
+
+        tCIDLib::TCard4 c4GCMEncrypt
+        (
+            const   tCIDLib::TCard1* const  pc1Plain
+            , const tCIDLib::TCard4         c4PlainBytes
+            ,       TMemBuf&                mbufCypher
+            , const tCIDLib::TCard1* const  pc1IV
+        );
+
         tCIDLib::TCard4 c4OFBProcess
         (
             const   tCIDLib::TCard1* const  pc1Input
@@ -215,9 +276,30 @@ class CIDCRYPTEXP TBlockEncrypter : public TObject
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid CheckGCMBlockSize() const;
+
+        tCIDLib::TVoid CTRTransform
+        (
+            const   tCIDLib::TCard1*        pc1Input
+            , const tCIDLib::TCard4         c4InputBytes
+            ,       TMemBuf&                mbufOut
+            ,       tCIDLib::TCard1* const  pc1Counter
+            , const tCIDLib::TCard4         c4CountBytes
+            ,       TGCMHash* const         pghashOut
+        );
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_c4AuthBytes
+        //  m_pc1AuthData
+        //      The optional additional authenticated data for GCM mode. It
+        //      stays set until cleared or set to something else.
+        //
         //  m_c4BlockSize
         //      The block size used by the derived class. It is passed to the
         //      protected constructor by the derived class and we just store
@@ -226,8 +308,10 @@ class CIDCRYPTEXP TBlockEncrypter : public TObject
         //  m_eMode
         //      The block encryption mode to use.
         // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4AuthBytes;
         tCIDLib::TCard4         m_c4BlockSize;
         tCIDCrypto::EBlockModes m_eMode;
+        tCIDLib::TCard1*        m_pc1AuthData;
 
 
         // -------------------------------------------------------------------
@@ -57,6 +57,12 @@ namespace kCIDCrypto
     constexpr tCIDLib::TCard4   c4SHA256HashBytes   = 32;
     constexpr tCIDLib::TCard4   c4SHA256BlockSize   = 64;
 
+    //
+    //  The leaf size for the SHA-256 tree hash. This is part of the format,
+    //  so changing it changes the resulting hashes.
+    //
+    constexpr tCIDLib::TCard4   c4SHA256TreeLeafSz  = 0x10000;
+
 
     // -----------------------------------------------------------------------
     //  Constants for the machine id support.
@@ -0,0 +1,406 @@
+//
+// FILE NAME: CIDCrypto_HMAC.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the THMAC template class, which does HMAC (RFC 2104)
+//  message authentication codes over one of our hashers. It is templatized on
+//  the hasher class and its hash class, e.g. TSHA256Hasher and TSHA256Hash.
+//
+//  The facility class has a GenerateHMAC() method, but it has to redo the
+//  key setup (hashing the key padded with the ipad and opad values) for every
+//  message. This class does that once when the key is set, and keeps hashers
+//  that have already digested the ipad and opad blocks. For each message it
+//  just copies those states and goes from there. So, for small messages, it
+//  saves two of the four hash blocks per message. It doesn't allocate anything
+//  after construction, so it's fine to use per packet.
+//
+//  For streaming use, call StartNew(), then DigestRaw() or DigestBuf() as many
+//  times as needed, then Complete(). Complete() resets it for the next message
+//  on the same key. Or use GenerateMAC() to do a single buffer in one shot.
+//
+//  We also provide, as static methods, the HKDF (RFC 5869) and PBKDF2 (RFC 8018)
+//  key derivation functions, since they are just built on HMAC. PBKDF2 in
+//  particular benefits from the cached key state, since it does an HMAC per
+//  iteration with the same key.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The hasher's block size can be at most c4MaxBlockSz. That covers all of
+//      the hashers we have.
+//
+//  2)  This is not thread safe. If multiple threads need to generate MACs with
+//      the same key, they can each make a copy of a keyed object, which is cheap
+//      and doesn't redo the key setup.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: THMAC
+//  PREFIX: hmac
+// ---------------------------------------------------------------------------
+template <typename TDigest, typename THash> class THMAC
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Does the extract and expand steps in one shot. The salt can be empty
+        //  and the info can be empty.
+        //
+        static tCIDLib::TVoid HKDF( const   tCIDLib::TCard1* const  pc1Salt
+                                    , const tCIDLib::TCard4         c4SaltBytes
+                                    , const tCIDLib::TCard1* const  pc1IKM
+                                    , const tCIDLib::TCard4         c4IKMBytes
+                                    , const tCIDLib::TCard1* const  pc1Info
+                                    , const tCIDLib::TCard4         c4InfoBytes
+                                    ,       tCIDLib::TCard1* const  pc1Out
+                                    , const tCIDLib::TCard4         c4OutBytes)
+        {
+            THash mhashPRK;
+            HKDFExtract(pc1Salt, c4SaltBytes, pc1IKM, c4IKMBytes, mhashPRK);
+            HKDFExpand
+            (
+                mhashPRK.pc1Buffer()
+                , mhashPRK.c4Bytes()
+                , pc1Info
+                , c4InfoBytes
+                , pc1Out
+                , c4OutBytes
+            );
+        }
+
+        //
+        //  Expands the pseudo-random key into the requested number of output
+        //  bytes, which can be at most 255 times the hash size.
+        //
+        static tCIDLib::TVoid HKDFExpand(const  tCIDLib::TCard1* const  pc1PRK
+                                        , const tCIDLib::TCard4         c4PRKBytes
+                                        , const tCIDLib::TCard1* const  pc1Info
+                                        , const tCIDLib::TCard4         c4InfoBytes
+                                        ,       tCIDLib::TCard1* const  pc1Out
+                                        , const tCIDLib::TCard4         c4OutBytes)
+        {
+            THMAC hmacPRK(pc1PRK, c4PRKBytes);
+            THash mhashT;
+
+            const tCIDLib::TCard4 c4HashBytes = mhashT.c4Bytes();
+            if (c4OutBytes > c4HashBytes * 255)
+            {
+                facCIDCrypto().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kCryptoErrs::errcKDF_OutputTooLong
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::BadParms
+                    , TCardinal(c4HashBytes * 255)
+                    , TCardinal(c4OutBytes)
+                );
+            }
+
+            // T(n) = HMAC(PRK, T(n-1) | info | n), where T(0) is empty
+            tCIDLib::TCard4 c4Done = 0;
+            tCIDLib::TCard1 c1Counter = 1;
+            while (c4Done < c4OutBytes)
+            {
+                hmacPRK.StartNew();
+                if (c4Done)
+                    hmacPRK.DigestRaw(mhashT.pc1Buffer(), c4HashBytes);
+                hmacPRK.DigestRaw(pc1Info, c4InfoBytes);
+                hmacPRK.DigestRaw(&c1Counter, 1);
+                hmacPRK.Complete(mhashT);
+
+                const tCIDLib::TCard4 c4ThisTime = tCIDLib::MinVal
+                (
+                    c4HashBytes, c4OutBytes - c4Done
+                );
+                TRawMem::CopyMemBuf(pc1Out + c4Done, mhashT.pc1Buffer(), c4ThisTime);
+                c4Done += c4ThisTime;
+                c1Counter++;
+            }
+        }
+
+        // Extracts a pseudo-random key from the input keying material
+        static tCIDLib::TVoid HKDFExtract(  const   tCIDLib::TCard1* const  pc1Salt
+                                            , const tCIDLib::TCard4         c4SaltBytes
+                                            , const tCIDLib::TCard1* const  pc1IKM
+                                            , const tCIDLib::TCard4         c4IKMBytes
+                                            ,       THash&                  mhashPRK)
+        {
+            //
+            //  An empty salt is supposed to be a hash's worth of zeros, but the
+            //  HMAC key padding already does that, so we don't have to.
+            //
+            THMAC hmacSalt(pc1Salt, c4SaltBytes);
+            hmacSalt.GenerateMAC(pc1IKM, c4IKMBytes, mhashPRK);
+        }
+
+        //
+        //  Derives a key from a password and salt. Each hash's worth of output
+        //  is the XOR of c4Iterations chained HMACs.
+        //
+        static tCIDLib::TVoid PBKDF2(const  tCIDLib::TCard1* const  pc1Password
+                                    , const tCIDLib::TCard4         c4PasswordBytes
+                                    , const tCIDLib::TCard1* const  pc1Salt
+                                    , const tCIDLib::TCard4         c4SaltBytes
+                                    , const tCIDLib::TCard4         c4Iterations
+                                    ,       tCIDLib::TCard1* const  pc1Out
+                                    , const tCIDLib::TCard4         c4OutBytes)
+        {
+            if (!c4Iterations)
+            {
+                facCIDCrypto().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kCryptoErrs::errcKDF_NoIterations
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::BadParms
+                );
+            }
+
+            THMAC hmacPW(pc1Password, c4PasswordBytes);
+            THash mhashU;
+            const tCIDLib::TCard4 c4HashBytes = mhashU.c4Bytes();
+
+            CIDLib_Suppress(26494)
+            tCIDLib::TCard1 ac1Accum[c4MaxBlockSz];
+
+            tCIDLib::TCard4 c4Done = 0;
+            tCIDLib::TCard4 c4BlockNum = 1;
+            while (c4Done < c4OutBytes)
+            {
+                // U1 = HMAC(P, S | big endian block number)
+                const tCIDLib::TCard1 ac1Num[4] =
+                {
+                    tCIDLib::TCard1(c4BlockNum >> 24)
+                    , tCIDLib::TCard1(c4BlockNum >> 16)
+                    , tCIDLib::TCard1(c4BlockNum >> 8)
+                    , tCIDLib::TCard1(c4BlockNum)
+                };
+                hmacPW.StartNew();
+                hmacPW.DigestRaw(pc1Salt, c4SaltBytes);
+                hmacPW.DigestRaw(ac1Num, 4);
+                hmacPW.Complete(mhashU);
+                TRawMem::CopyMemBuf(ac1Accum, mhashU.pc1Buffer(), c4HashBytes);
+
+                // And Un = HMAC(P, Un-1), all XORed together
+                for (tCIDLib::TCard4 c4Iter = 1; c4Iter < c4Iterations; c4Iter++)
+                {
+                    hmacPW.StartNew();
+                    hmacPW.DigestRaw(mhashU.pc1Buffer(), c4HashBytes);
+                    hmacPW.Complete(mhashU);
+
+                    const tCIDLib::TCard1* pc1U = mhashU.pc1Buffer();
+                    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4HashBytes; c4Index++)
+                        ac1Accum[c4Index] ^= pc1U[c4Index];
+                }
+
+                const tCIDLib::TCard4 c4ThisTime = tCIDLib::MinVal
+                (
+                    c4HashBytes, c4OutBytes - c4Done
+                );
+                TRawMem::CopyMemBuf(pc1Out + c4Done, ac1Accum, c4ThisTime);
+                c4Done += c4ThisTime;
+                c4BlockNum++;
+            }
+            TRawMem::SetMemBuf(ac1Accum, tCIDLib::TCard1(0), c4MaxBlockSz);
+        }
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+
+        // Set up with an empty key, which is legal for HMAC
+        THMAC()
+        {
+            SetKey(nullptr, 0);
+        }
+
+        THMAC(  const   tCIDLib::TCard1* const  pc1Key
+                , const tCIDLib::TCard4         c4KeyBytes)
+        {
+            SetKey(pc1Key, c4KeyBytes);
+        }
+
+        THMAC(  const   TMemBuf&                mbufKey
+                , const tCIDLib::TCard4         c4KeyBytes)
+        {
+            SetKey(mbufKey, c4KeyBytes);
+        }
+
+        THMAC(const THMAC&) = default;
+
+        ~THMAC() = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        THMAC& operator=(const THMAC&) = default;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+
+        //
+        //  Finish off the inner hash, then run that through the outer hash to
+        //  get the final MAC. We use the caller's hash as the temp for the inner
+        //  hash. Then we get ready for another message.
+        //
+        tCIDLib::TVoid Complete(THash& mhashToFill)
+        {
+            m_mdigWork.Complete(mhashToFill);
+
+            m_mdigOuter2 = m_mdigOuter;
+            m_mdigOuter2.DigestRaw(mhashToFill.pc1Buffer(), mhashToFill.c4Bytes());
+            m_mdigOuter2.Complete(mhashToFill);
+
+            StartNew();
+        }
+
+        tCIDLib::TVoid DigestBuf(const  TMemBuf&                mbufToDigest
+                                , const tCIDLib::TCard4         c4Bytes)
+        {
+            m_mdigWork.DigestBuf(mbufToDigest, c4Bytes);
+        }
+
+        tCIDLib::TVoid DigestRaw(const  tCIDLib::TCard1* const  pc1ToDigest
+                                , const tCIDLib::TCard4         c4Bytes)
+        {
+            m_mdigWork.DigestRaw(pc1ToDigest, c4Bytes);
+        }
+
+        // A convenience to do a whole message in one shot
+        tCIDLib::TVoid GenerateMAC( const   tCIDLib::TCard1* const  pc1Msg
+                                    , const tCIDLib::TCard4         c4MsgBytes
+                                    ,       THash&                  mhashToFill)
+        {
+            StartNew();
+            m_mdigWork.DigestRaw(pc1Msg, c4MsgBytes);
+            Complete(mhashToFill);
+        }
+
+        tCIDLib::TVoid SetKey(  const   tCIDLib::TCard1* const  pc1Key
+                                , const tCIDLib::TCard4         c4KeyBytes)
+        {
+            const tCIDLib::TCard4 c4BlockSz = m_mdigInner.c4BlockSize();
+            CIDAssert(c4BlockSz <= c4MaxBlockSz, L"The hasher block size is too large for HMAC");
+
+            //
+            //  Get the key, zero padded to the block size. If it's longer than
+            //  the block size, we use the hash of it.
+            //
+            CIDLib_Suppress(26494)
+            tCIDLib::TCard1 ac1IPad[c4MaxBlockSz];
+            CIDLib_Suppress(26494)
+            tCIDLib::TCard1 ac1OPad[c4MaxBlockSz];
+            TRawMem::SetMemBuf(ac1IPad, tCIDLib::TCard1(0), c4BlockSz);
+            if (c4KeyBytes > c4BlockSz)
+            {
+                THash mhashKey;
+                m_mdigInner.StartNew();
+                m_mdigInner.DigestRaw(pc1Key, c4KeyBytes);
+                m_mdigInner.Complete(mhashKey);
+                TRawMem::CopyMemBuf(ac1IPad, mhashKey.pc1Buffer(), mhashKey.c4Bytes());
+            }
+             else if (c4KeyBytes)
+            {
+                TRawMem::CopyMemBuf(ac1IPad, pc1Key, c4KeyBytes);
+            }
+
+            // Create the two pads from the key
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BlockSz; c4Index++)
+            {
+                ac1OPad[c4Index] = ac1IPad[c4Index] ^ 0x5C;
+                ac1IPad[c4Index] ^= 0x36;
+            }
+
+            // And get the two hashers primed with them
+            m_mdigInner.StartNew();
+            m_mdigInner.DigestRaw(ac1IPad, c4BlockSz);
+            m_mdigOuter.StartNew();
+            m_mdigOuter.DigestRaw(ac1OPad, c4BlockSz);
+
+            // Don't leave key material lying around on the stack
+            TRawMem::SetMemBuf(ac1IPad, tCIDLib::TCard1(0), c4MaxBlockSz);
+            TRawMem::SetMemBuf(ac1OPad, tCIDLib::TCard1(0), c4MaxBlockSz);
+
+            StartNew();
+        }
+
+        tCIDLib::TVoid SetKey(  const   TMemBuf&                mbufKey
+                                , const tCIDLib::TCard4         c4KeyBytes)
+        {
+            SetKey(mbufKey.pc1Data(), c4KeyBytes);
+        }
+
+        // Start a new message on the current key
+        tCIDLib::TVoid StartNew()
+        {
+            m_mdigWork = m_mdigInner;
+        }
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private class constants
+        // -------------------------------------------------------------------
+        static constexpr tCIDLib::TCard4    c4MaxBlockSz = 128;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_mdigInner
+        //  m_mdigOuter
+        //      The hashers after the key XORed ipad and opad blocks have been
+        //      digested. These are set up when the key is set and are then just
+        //      copied for each message.
+        //
+        //  m_mdigOuter2
+        //      A copy of m_mdigOuter used to do the outer hash for a message, so
+        //      that we don't have to construct one for each message.
+        //
+        //  m_mdigWork
+        //      The inner hash of the current message. StartNew() copies the inner
+        //      state into it.
+        // -------------------------------------------------------------------
+        TDigest     m_mdigInner;
+        TDigest     m_mdigOuter;
+        TDigest     m_mdigOuter2;
+        TDigest     m_mdigWork;
+};
+
+#pragma CIDLIB_POPPACK
+
+
+namespace tCIDCrypto
+{
+    using THMACSHA1     = THMAC<TSHA1Hasher, TSHA1Hash>;
+    using THMACSHA256   = THMAC<TSHA256Hasher, TSHA256Hash>;
+}
@@ -0,0 +1,1032 @@
+//
+// FILE NAME: CIDCrypto_HWAccel.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the hardware accelerated AES, GHASH and SHA
+//  operations. See the header for details.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  Only the functions in here are built for the extra instruction sets,
+//      so nothing in here can be called unless the availability methods say
+//      they are available.
+//
+//  2)  The AES methods interleave up to 8 blocks at a time. The AES-NI round
+//      instructions have a latency of multiple cycles but can start a new one
+//      every cycle, so doing one block at a time would leave most of that on
+//      the table. The same for GHASH, which folds in four blocks per
+//      reduction.
+//
+//  3)  The SHA lanes methods are for hashing many independent messages. A
+//      single SHA stream can't be usefully vectorized, since each round
+//      depends on the previous one, but eight of them side by side can.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDCrypto_.hpp"
+
+#if defined(CIDLIB_CPU_X86) || defined(CIDLIB_CPU_X64)
+#define CIDCRYPTO_HWACCEL
+#include    <immintrin.h>
+#endif
+
+
+#if defined(CIDCRYPTO_HWACCEL)
+
+// ---------------------------------------------------------------------------
+//  Local helpers
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDCrypto_HWAccel
+    {
+        // The number of blocks we interleave in the AES methods
+        constexpr tCIDLib::TCard4   c4AESWidth = 8;
+
+
+        // Reverses the bytes of a block, to go to/from the GHASH bit order
+        CIDLIB_ISATARGET("pclmul,ssse3")
+        inline __m128i m128Swap(const __m128i m128Val)
+        {
+            const __m128i m128Mask = _mm_set_epi8
+            (
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+            );
+            return _mm_shuffle_epi8(m128Val, m128Mask);
+        }
+
+
+        //
+        //  Accumulate the unreduced carryless product of two byte swapped
+        //  blocks into the low, middle and high parts, so that a number of
+        //  them can be reduced at once.
+        //
+        CIDLIB_ISATARGET("pclmul,ssse3")
+        inline tCIDLib::TVoid ClMulAccum(const  __m128i     m128A
+                                        , const __m128i     m128B
+                                        ,       __m128i&    m128Lo
+                                        ,       __m128i&    m128Mid
+                                        ,       __m128i&    m128Hi)
+        {
+            m128Lo = _mm_xor_si128(m128Lo, _mm_clmulepi64_si128(m128A, m128B, 0x00));
+            m128Hi = _mm_xor_si128(m128Hi, _mm_clmulepi64_si128(m128A, m128B, 0x11));
+            m128Mid = _mm_xor_si128(m128Mid, _mm_clmulepi64_si128(m128A, m128B, 0x10));
+            m128Mid = _mm_xor_si128(m128Mid, _mm_clmulepi64_si128(m128A, m128B, 0x01));
+        }
+
+
+        //
+        //  Reduce an accumulated 256 bit product modulo the GCM polynomial. The
+        //  GCM bit order is reflected, so we have to shift the product left by
+        //  one first, and then do the reduction of the low half into the high.
+        //
+        CIDLIB_ISATARGET("pclmul,ssse3")
+        inline __m128i m128Reduce(  const   __m128i m128Lo
+                                    , const __m128i m128Mid
+                                    , const __m128i m128Hi)
+        {
+            __m128i m128L = _mm_xor_si128(m128Lo, _mm_slli_si128(m128Mid, 8));
+            __m128i m128H = _mm_xor_si128(m128Hi, _mm_srli_si128(m128Mid, 8));
+
+            // Shift the whole 256 bits left by one
+            __m128i m128Tmp1 = _mm_srli_epi32(m128L, 31);
+            __m128i m128Tmp2 = _mm_srli_epi32(m128H, 31);
+            m128L = _mm_slli_epi32(m128L, 1);
+            m128H = _mm_slli_epi32(m128H, 1);
+
+            const __m128i m128Carry = _mm_srli_si128(m128Tmp1, 12);
+            m128Tmp2 = _mm_slli_si128(m128Tmp2, 4);
+            m128Tmp1 = _mm_slli_si128(m128Tmp1, 4);
+            m128L = _mm_or_si128(m128L, m128Tmp1);
+            m128H = _mm_or_si128(m128H, m128Tmp2);
+            m128H = _mm_or_si128(m128H, m128Carry);
+
+            // First phase of the reduction
+            m128Tmp1 = _mm_xor_si128
+            (
+                _mm_xor_si128(_mm_slli_epi32(m128L, 31), _mm_slli_epi32(m128L, 30))
+                , _mm_slli_epi32(m128L, 25)
+            );
+            m128Tmp2 = _mm_srli_si128(m128Tmp1, 4);
+            m128Tmp1 = _mm_slli_si128(m128Tmp1, 12);
+            m128L = _mm_xor_si128(m128L, m128Tmp1);
+
+            // And the second
+            __m128i m128Tmp3 = _mm_xor_si128
+            (
+                _mm_xor_si128(_mm_srli_epi32(m128L, 1), _mm_srli_epi32(m128L, 2))
+                , _mm_srli_epi32(m128L, 7)
+            );
+            m128Tmp3 = _mm_xor_si128(m128Tmp3, m128Tmp2);
+            m128L = _mm_xor_si128(m128L, m128Tmp3);
+            return _mm_xor_si128(m128H, m128L);
+        }
+
+
+        CIDLIB_ISATARGET("pclmul,ssse3")
+        inline __m128i m128GFMul(const __m128i m128A, const __m128i m128B)
+        {
+            __m128i m128Lo = _mm_setzero_si128();
+            __m128i m128Mid = _mm_setzero_si128();
+            __m128i m128Hi = _mm_setzero_si128();
+            ClMulAccum(m128A, m128B, m128Lo, m128Mid, m128Hi);
+            return m128Reduce(m128Lo, m128Mid, m128Hi);
+        }
+
+
+        //
+        //  Helpers for the SHA extensions based SHA-1. One does four rounds
+        //  with the indicated round function, and the other calculates the
+        //  next four message words from the previous sixteen.
+        //
+        template <int iFunc> CIDLIB_ISATARGET("sha,sse4.1")
+        inline tCIDLib::TVoid SHA1Quad(         __m128i&    m128ABCD
+                                        ,       __m128i&    m128E
+                                        ,       __m128i&    m128NextE
+                                        , const __m128i     m128W)
+        {
+            m128E = _mm_sha1nexte_epu32(m128NextE, m128W);
+            m128NextE = m128ABCD;
+            m128ABCD = _mm_sha1rnds4_epu32(m128ABCD, m128E, iFunc);
+        }
+
+        CIDLIB_ISATARGET("sha,sse4.1")
+        inline __m128i m128SHA1Sched(const  __m128i m128W16
+                                    , const __m128i m128W12
+                                    , const __m128i m128W8
+                                    , const __m128i m128W4)
+        {
+            return _mm_sha1msg2_epu32
+            (
+                _mm_xor_si128(_mm_sha1msg1_epu32(m128W16, m128W12), m128W8), m128W4
+            );
+        }
+
+
+        //
+        //  And the same for SHA-256. The round instruction does two rounds, so
+        //  we do it twice, with the upper message words moved down.
+        //
+        CIDLIB_ISATARGET("sha,sse4.1")
+        inline tCIDLib::TVoid SHA256Quad(       __m128i&    m128State0
+                                        ,       __m128i&    m128State1
+                                        , const __m128i     m128W
+                                        , const __m128i     m128K)
+        {
+            __m128i m128Msg = _mm_add_epi32(m128W, m128K);
+            m128State1 = _mm_sha256rnds2_epu32(m128State1, m128State0, m128Msg);
+            m128Msg = _mm_shuffle_epi32(m128Msg, 0x0E);
+            m128State0 = _mm_sha256rnds2_epu32(m128State0, m128State1, m128Msg);
+        }
+
+        CIDLIB_ISATARGET("sha,sse4.1")
+        inline __m128i m128SHA256Sched( const   __m128i m128W16
+                                        , const __m128i m128W12
+                                        , const __m128i m128W8
+                                        , const __m128i m128W4)
+        {
+            const __m128i m128Tmp = _mm_add_epi32
+            (
+                _mm_sha256msg1_epu32(m128W16, m128W12), _mm_alignr_epi8(m128W4, m128W8, 4)
+            );
+            return _mm_sha256msg2_epu32(m128Tmp, m128W4);
+        }
+
+
+        //
+        //  Rotates for the SHA lanes methods. These are done on all eight 32
+        //  bit lanes at once.
+        //
+        CIDLIB_ISATARGET("avx2")
+        inline __m256i m256RotL(const __m256i m256Val, const int iBits)
+        {
+            return _mm256_or_si256
+            (
+                _mm256_slli_epi32(m256Val, iBits), _mm256_srli_epi32(m256Val, 32 - iBits)
+            );
+        }
+
+        CIDLIB_ISATARGET("avx2")
+        inline __m256i m256RotR(const __m256i m256Val, const int iBits)
+        {
+            return _mm256_or_si256
+            (
+                _mm256_srli_epi32(m256Val, iBits), _mm256_slli_epi32(m256Val, 32 - iBits)
+            );
+        }
+
+
+        //
+        //  Load 32 bytes from each of the eight lanes' data, at the indicated
+        //  offset, and transpose them so that we get eight registers, each of
+        //  which has the same message word for all of the lanes. They are byte
+        //  swapped to get the big endian words.
+        //
+        CIDLIB_ISATARGET("avx2")
+        inline tCIDLib::TVoid LoadLaneWords(const   tCIDLib::TCard1** const apc1Data
+                                            , const tCIDLib::TCard4         c4Ofs
+                                            ,       __m256i* const          pm256Out)
+        {
+            const __m256i m256Swap = _mm256_set_epi8
+            (
+                12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+                , 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+            );
+
+            __m256i am256Rows[kCIDCrypto_::c4SHALanes];
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < kCIDCrypto_::c4SHALanes; c4Index++)
+            {
+                am256Rows[c4Index] = _mm256_loadu_si256
+                (
+                    reinterpret_cast<const __m256i*>(apc1Data[c4Index] + c4Ofs)
+                );
+            }
+
+            // Interleave the 32 bit values, then the 64 bit values, then the halves
+            const __m256i m256T0 = _mm256_unpacklo_epi32(am256Rows[0], am256Rows[1]);
+            const __m256i m256T1 = _mm256_unpackhi_epi32(am256Rows[0], am256Rows[1]);
+            const __m256i m256T2 = _mm256_unpacklo_epi32(am256Rows[2], am256Rows[3]);
+            const __m256i m256T3 = _mm256_unpackhi_epi32(am256Rows[2], am256Rows[3]);
+            const __m256i m256T4 = _mm256_unpacklo_epi32(am256Rows[4], am256Rows[5]);
+            const __m256i m256T5 = _mm256_unpackhi_epi32(am256Rows[4], am256Rows[5]);
+            const __m256i m256T6 = _mm256_unpacklo_epi32(am256Rows[6], am256Rows[7]);
+            const __m256i m256T7 = _mm256_unpackhi_epi32(am256Rows[6], am256Rows[7]);
+
+            const __m256i m256U0 = _mm256_unpacklo_epi64(m256T0, m256T2);
+            const __m256i m256U1 = _mm256_unpackhi_epi64(m256T0, m256T2);
+            const __m256i m256U2 = _mm256_unpacklo_epi64(m256T1, m256T3);
+            const __m256i m256U3 = _mm256_unpackhi_epi64(m256T1, m256T3);
+            const __m256i m256U4 = _mm256_unpacklo_epi64(m256T4, m256T6);
+            const __m256i m256U5 = _mm256_unpackhi_epi64(m256T4, m256T6);
+            const __m256i m256U6 = _mm256_unpacklo_epi64(m256T5, m256T7);
+            const __m256i m256U7 = _mm256_unpackhi_epi64(m256T5, m256T7);
+
+            pm256Out[0] = _mm256_permute2x128_si256(m256U0, m256U4, 0x20);
+            pm256Out[1] = _mm256_permute2x128_si256(m256U1, m256U5, 0x20);
+            pm256Out[2] = _mm256_permute2x128_si256(m256U2, m256U6, 0x20);
+            pm256Out[3] = _mm256_permute2x128_si256(m256U3, m256U7, 0x20);
+            pm256Out[4] = _mm256_permute2x128_si256(m256U0, m256U4, 0x31);
+            pm256Out[5] = _mm256_permute2x128_si256(m256U1, m256U5, 0x31);
+            pm256Out[6] = _mm256_permute2x128_si256(m256U2, m256U6, 0x31);
+            pm256Out[7] = _mm256_permute2x128_si256(m256U3, m256U7, 0x31);
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+                pm256Out[c4Index] = _mm256_shuffle_epi8(pm256Out[c4Index], m256Swap);
+        }
+    }
+}
+
+#endif
+
+
+
+// ---------------------------------------------------------------------------
+//  TCryptoHWAccel functions
+// ---------------------------------------------------------------------------
+#if defined(CIDCRYPTO_HWACCEL)
+
+CIDLIB_ISATARGET("aes")
+tCIDLib::TVoid
+TCryptoHWAccel::AESDecryptBlocks(const  tCIDLib::TCard1* const  pc1Keys
+                                , const tCIDLib::TCard4         c4Rounds
+                                , const tCIDLib::TCard1*        pc1In
+                                ,       tCIDLib::TCard1*        pc1Out
+                                , const tCIDLib::TCard4         c4Blocks)
+{
+    constexpr tCIDLib::TCard4 c4Width = CIDCrypto_HWAccel::c4AESWidth;
+
+    __m128i am128Keys[15];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index <= c4Rounds; c4Index++)
+        am128Keys[c4Index] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1Keys) + c4Index);
+
+    tCIDLib::TCard4 c4Left = c4Blocks;
+    __m128i am128Blocks[c4Width];
+    while (c4Left >= c4Width)
+    {
+        for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+        {
+            am128Blocks[c4BInd] = _mm_xor_si128
+            (
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1In) + c4BInd)
+                , am128Keys[0]
+            );
+        }
+
+        for (tCIDLib::TCard4 c4RInd = 1; c4RInd < c4Rounds; c4RInd++)
+        {
+            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+                am128Blocks[c4BInd] = _mm_aesdec_si128(am128Blocks[c4BInd], am128Keys[c4RInd]);
+        }
+
+        for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+        {
+            _mm_storeu_si128
+            (
+                reinterpret_cast<__m128i*>(pc1Out) + c4BInd
+                , _mm_aesdeclast_si128(am128Blocks[c4BInd], am128Keys[c4Rounds])
+            );
+        }
+
+        pc1In += c4Width * 16;
+        pc1Out += c4Width * 16;
+        c4Left -= c4Width;
+    }
+
+    // Do any trailing blocks one at a time
+    while (c4Left)
+    {
+        __m128i m128Block = _mm_xor_si128
+        (
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1In)), am128Keys[0]
+        );
+        for (tCIDLib::TCard4 c4RInd = 1; c4RInd < c4Rounds; c4RInd++)
+            m128Block = _mm_aesdec_si128(m128Block, am128Keys[c4RInd]);
+        _mm_storeu_si128
+        (
+            reinterpret_cast<__m128i*>(pc1Out)
+            , _mm_aesdeclast_si128(m128Block, am128Keys[c4Rounds])
+        );
+
+        pc1In += 16;
+        pc1Out += 16;
+        c4Left--;
+    }
+}
+
+
+CIDLIB_ISATARGET("aes")
+tCIDLib::TVoid
+TCryptoHWAccel::AESEncryptBlocks(const  tCIDLib::TCard1* const  pc1Keys
+                                , const tCIDLib::TCard4         c4Rounds
+                                , const tCIDLib::TCard1*        pc1In
+                                ,       tCIDLib::TCard1*        pc1Out
+                                , const tCIDLib::TCard4         c4Blocks)
+{
+    constexpr tCIDLib::TCard4 c4Width = CIDCrypto_HWAccel::c4AESWidth;
+
+    __m128i am128Keys[15];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index <= c4Rounds; c4Index++)
+        am128Keys[c4Index] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1Keys) + c4Index);
+
+    tCIDLib::TCard4 c4Left = c4Blocks;
+    __m128i am128Blocks[c4Width];
+    while (c4Left >= c4Width)
+    {
+        for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+        {
+            am128Blocks[c4BInd] = _mm_xor_si128
+            (
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1In) + c4BInd)
+                , am128Keys[0]
+            );
+        }
+
+        for (tCIDLib::TCard4 c4RInd = 1; c4RInd < c4Rounds; c4RInd++)
+        {
+            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+                am128Blocks[c4BInd] = _mm_aesenc_si128(am128Blocks[c4BInd], am128Keys[c4RInd]);
+        }
+
+        for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Width; c4BInd++)
+        {
+            _mm_storeu_si128
+            (
+                reinterpret_cast<__m128i*>(pc1Out) + c4BInd
+                , _mm_aesenclast_si128(am128Blocks[c4BInd], am128Keys[c4Rounds])
+            );
+        }
+
+        pc1In += c4Width * 16;
+        pc1Out += c4Width * 16;
+        c4Left -= c4Width;
+    }
+
+    // Do any trailing blocks one at a time
+    while (c4Left)
+    {
+        __m128i m128Block = _mm_xor_si128
+        (
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1In)), am128Keys[0]
+        );
+        for (tCIDLib::TCard4 c4RInd = 1; c4RInd < c4Rounds; c4RInd++)
+            m128Block = _mm_aesenc_si128(m128Block, am128Keys[c4RInd]);
+        _mm_storeu_si128
+        (
+            reinterpret_cast<__m128i*>(pc1Out)
+            , _mm_aesenclast_si128(m128Block, am128Keys[c4Rounds])
+        );
+
+        pc1In += 16;
+        pc1Out += 16;
+        c4Left--;
+    }
+}
+
+
+tCIDLib::TBoolean TCryptoHWAccel::bAESAvail()
+{
+    if (!facCIDCrypto().bHWAccel())
+        return kCIDLib::False;
+    return TSysInfo::bCPUHasFeatures(tCIDLib::ECPUFeatures::AESNI);
+}
+
+
+tCIDLib::TBoolean TCryptoHWAccel::bGHashAvail()
+{
+    if (!facCIDCrypto().bHWAccel())
+        return kCIDLib::False;
+
+    // Anything with PCLMULQDQ has SSSE3, but we check SSE4.1 to be safe
+    return TSysInfo::bCPUHasFeatures
+    (
+        tCIDLib::ECPUFeatures::PCLMUL | tCIDLib::ECPUFeatures::SSE41
+    );
+}
+
+
+CIDLIB_ISATARGET("pclmul,ssse3")
+tCIDLib::TVoid
+TCryptoHWAccel::GHashBlocks(const   tCIDLib::TCard1* const  pc1H
+                            ,       tCIDLib::TCard1* const  pc1Hash
+                            , const tCIDLib::TCard1*        pc1Data
+                            , const tCIDLib::TCard4         c4Blocks)
+{
+    const __m128i m128H1 = CIDCrypto_HWAccel::m128Swap
+    (
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1H))
+    );
+    __m128i m128Hash = CIDCrypto_HWAccel::m128Swap
+    (
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1Hash))
+    );
+
+    tCIDLib::TCard4 c4Left = c4Blocks;
+    if (c4Left >= 4)
+    {
+        //
+        //  We need H to the 2nd, 3rd, and 4th powers. The first block of each
+        //  group of four gets multiplied by H^4, the next by H^3, and so on,
+        //  so that we can sum them all and do one reduction.
+        //
+        const __m128i m128H2 = CIDCrypto_HWAccel::m128GFMul(m128H1, m128H1);
+        const __m128i m128H3 = CIDCrypto_HWAccel::m128GFMul(m128H2, m128H1);
+        const __m128i m128H4 = CIDCrypto_HWAccel::m128GFMul(m128H3, m128H1);
+
+        const __m128i* pm128Src = reinterpret_cast<const __m128i*>(pc1Data);
+        while (c4Left >= 4)
+        {
+            const __m128i m128B0 = _mm_xor_si128
+            (
+                CIDCrypto_HWAccel::m128Swap(_mm_loadu_si128(pm128Src)), m128Hash
+            );
+            const __m128i m128B1 = CIDCrypto_HWAccel::m128Swap(_mm_loadu_si128(pm128Src + 1));
+            const __m128i m128B2 = CIDCrypto_HWAccel::m128Swap(_mm_loadu_si128(pm128Src + 2));
+            const __m128i m128B3 = CIDCrypto_HWAccel::m128Swap(_mm_loadu_si128(pm128Src + 3));
+
+            __m128i m128Lo = _mm_setzero_si128();
+            __m128i m128Mid = _mm_setzero_si128();
+            __m128i m128Hi = _mm_setzero_si128();
+            CIDCrypto_HWAccel::ClMulAccum(m128B0, m128H4, m128Lo, m128Mid, m128Hi);
+            CIDCrypto_HWAccel::ClMulAccum(m128B1, m128H3, m128Lo, m128Mid, m128Hi);
+            CIDCrypto_HWAccel::ClMulAccum(m128B2, m128H2, m128Lo, m128Mid, m128Hi);
+            CIDCrypto_HWAccel::ClMulAccum(m128B3, m128H1, m128Lo, m128Mid, m128Hi);
+            m128Hash = CIDCrypto_HWAccel::m128Reduce(m128Lo, m128Mid, m128Hi);
+
+            pm128Src += 4;
+            c4Left -= 4;
+        }
+        pc1Data = reinterpret_cast<const tCIDLib::TCard1*>(pm128Src);
+    }
+
+    // Do any trailing blocks one at a time
+    while (c4Left)
+    {
+        const __m128i m128Block = CIDCrypto_HWAccel::m128Swap
+        (
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc1Data))
+        );
+        m128Hash = CIDCrypto_HWAccel::m128GFMul(_mm_xor_si128(m128Hash, m128Block), m128H1);
+        pc1Data += 16;
+        c4Left--;
+    }
+
+    _mm_storeu_si128
+    (
+        reinterpret_cast<__m128i*>(pc1Hash), CIDCrypto_HWAccel::m128Swap(m128Hash)
+    );
+}
+
+
+tCIDLib::TBoolean TCryptoHWAccel::bSHAAvail()
+{
+    if (!facCIDCrypto().bHWAccel())
+        return kCIDLib::False;
+
+    return TSysInfo::bCPUHasFeatures
+    (
+        tCIDLib::ECPUFeatures::SHA | tCIDLib::ECPUFeatures::SSE41
+    );
+}
+
+
+tCIDLib::TBoolean TCryptoHWAccel::bSHALanesAvail()
+{
+    if (!facCIDCrypto().bHWAccel())
+        return kCIDLib::False;
+    return TSysInfo::bCPUHasFeatures(tCIDLib::ECPUFeatures::AVX2);
+}
+
+
+//
+//  The SHA-1 rounds are done four at a time by the SHA1RNDS4 instruction,
+//  which also wants the next E value added to the message words, which is
+//  what SHA1NEXTE does. The message schedule is done with the MSG1/MSG2
+//  instructions, four words at a time.
+//
+CIDLIB_ISATARGET("sha,sse4.1")
+tCIDLib::TVoid
+TCryptoHWAccel::SHA1Blocks(         tCIDLib::TCard4* const  pc4State
+                            , const tCIDLib::TCard1*        pc1Data
+                            , const tCIDLib::TCard4         c4Blocks)
+{
+    const __m128i m128Mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+    // The instructions want the state words in reverse order, A at the top
+    __m128i m128ABCD = _mm_shuffle_epi32
+    (
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc4State)), 0x1B
+    );
+    __m128i m128E = _mm_set_epi32(int(pc4State[4]), 0, 0, 0);
+
+    const __m128i* pm128Src = reinterpret_cast<const __m128i*>(pc1Data);
+    for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Blocks; c4BInd++)
+    {
+        const __m128i m128SaveABCD = m128ABCD;
+        const __m128i m128SaveE = m128E;
+
+        __m128i m128W0 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src), m128Mask);
+        __m128i m128W1 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 1), m128Mask);
+        __m128i m128W2 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 2), m128Mask);
+        __m128i m128W3 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 3), m128Mask);
+
+        // The first four rounds get E added directly
+        __m128i m128NextE = m128ABCD;
+        m128ABCD = _mm_sha1rnds4_epu32(m128ABCD, _mm_add_epi32(m128E, m128W0), 0);
+
+        //
+        //  And the rest of them, in groups of four, calculating the message
+        //  words as we go once we are past the first 16.
+        //
+        CIDCrypto_HWAccel::SHA1Quad<0>(m128ABCD, m128E, m128NextE, m128W1);
+        CIDCrypto_HWAccel::SHA1Quad<0>(m128ABCD, m128E, m128NextE, m128W2);
+        CIDCrypto_HWAccel::SHA1Quad<0>(m128ABCD, m128E, m128NextE, m128W3);
+
+        m128W0 = CIDCrypto_HWAccel::m128SHA1Sched(m128W0, m128W1, m128W2, m128W3);
+        CIDCrypto_HWAccel::SHA1Quad<0>(m128ABCD, m128E, m128NextE, m128W0);
+        m128W1 = CIDCrypto_HWAccel::m128SHA1Sched(m128W1, m128W2, m128W3, m128W0);
+        CIDCrypto_HWAccel::SHA1Quad<1>(m128ABCD, m128E, m128NextE, m128W1);
+        m128W2 = CIDCrypto_HWAccel::m128SHA1Sched(m128W2, m128W3, m128W0, m128W1);
+        CIDCrypto_HWAccel::SHA1Quad<1>(m128ABCD, m128E, m128NextE, m128W2);
+        m128W3 = CIDCrypto_HWAccel::m128SHA1Sched(m128W3, m128W0, m128W1, m128W2);
+        CIDCrypto_HWAccel::SHA1Quad<1>(m128ABCD, m128E, m128NextE, m128W3);
+
+        m128W0 = CIDCrypto_HWAccel::m128SHA1Sched(m128W0, m128W1, m128W2, m128W3);
+        CIDCrypto_HWAccel::SHA1Quad<1>(m128ABCD, m128E, m128NextE, m128W0);
+        m128W1 = CIDCrypto_HWAccel::m128SHA1Sched(m128W1, m128W2, m128W3, m128W0);
+        CIDCrypto_HWAccel::SHA1Quad<1>(m128ABCD, m128E, m128NextE, m128W1);
+        m128W2 = CIDCrypto_HWAccel::m128SHA1Sched(m128W2, m128W3, m128W0, m128W1);
+        CIDCrypto_HWAccel::SHA1Quad<2>(m128ABCD, m128E, m128NextE, m128W2);
+        m128W3 = CIDCrypto_HWAccel::m128SHA1Sched(m128W3, m128W0, m128W1, m128W2);
+        CIDCrypto_HWAccel::SHA1Quad<2>(m128ABCD, m128E, m128NextE, m128W3);
+
+        m128W0 = CIDCrypto_HWAccel::m128SHA1Sched(m128W0, m128W1, m128W2, m128W3);
+        CIDCrypto_HWAccel::SHA1Quad<2>(m128ABCD, m128E, m128NextE, m128W0);
+        m128W1 = CIDCrypto_HWAccel::m128SHA1Sched(m128W1, m128W2, m128W3, m128W0);
+        CIDCrypto_HWAccel::SHA1Quad<2>(m128ABCD, m128E, m128NextE, m128W1);
+        m128W2 = CIDCrypto_HWAccel::m128SHA1Sched(m128W2, m128W3, m128W0, m128W1);
+        CIDCrypto_HWAccel::SHA1Quad<2>(m128ABCD, m128E, m128NextE, m128W2);
+        m128W3 = CIDCrypto_HWAccel::m128SHA1Sched(m128W3, m128W0, m128W1, m128W2);
+        CIDCrypto_HWAccel::SHA1Quad<3>(m128ABCD, m128E, m128NextE, m128W3);
+
+        m128W0 = CIDCrypto_HWAccel::m128SHA1Sched(m128W0, m128W1, m128W2, m128W3);
+        CIDCrypto_HWAccel::SHA1Quad<3>(m128ABCD, m128E, m128NextE, m128W0);
+        m128W1 = CIDCrypto_HWAccel::m128SHA1Sched(m128W1, m128W2, m128W3, m128W0);
+        CIDCrypto_HWAccel::SHA1Quad<3>(m128ABCD, m128E, m128NextE, m128W1);
+        m128W2 = CIDCrypto_HWAccel::m128SHA1Sched(m128W2, m128W3, m128W0, m128W1);
+        CIDCrypto_HWAccel::SHA1Quad<3>(m128ABCD, m128E, m128NextE, m128W2);
+        m128W3 = CIDCrypto_HWAccel::m128SHA1Sched(m128W3, m128W0, m128W1, m128W2);
+        CIDCrypto_HWAccel::SHA1Quad<3>(m128ABCD, m128E, m128NextE, m128W3);
+
+        // Add the saved state back in
+        m128E = _mm_sha1nexte_epu32(m128NextE, m128SaveE);
+        m128ABCD = _mm_add_epi32(m128ABCD, m128SaveABCD);
+
+        pm128Src += 4;
+    }
+
+    _mm_storeu_si128
+    (
+        reinterpret_cast<__m128i*>(pc4State), _mm_shuffle_epi32(m128ABCD, 0x1B)
+    );
+    pc4State[4] = tCIDLib::TCard4(_mm_extract_epi32(m128E, 3));
+}
+
+
+CIDLIB_ISATARGET("avx2")
+tCIDLib::TVoid
+TCryptoHWAccel::SHA1Lanes(          tCIDLib::TCard4* const  pc4States
+                            , const tCIDLib::TCard1** const apc1Data
+                            , const tCIDLib::TCard4         c4Blocks)
+{
+    constexpr tCIDLib::TCard4 c4Lanes = kCIDCrypto_::c4SHALanes;
+    __m256i* const pm256State = reinterpret_cast<__m256i*>(pc4States);
+
+    __m256i m256A = _mm256_loadu_si256(pm256State);
+    __m256i m256B = _mm256_loadu_si256(pm256State + 1);
+    __m256i m256C = _mm256_loadu_si256(pm256State + 2);
+    __m256i m256D = _mm256_loadu_si256(pm256State + 3);
+    __m256i m256E = _mm256_loadu_si256(pm256State + 4);
+
+    const __m256i am256K[4] =
+    {
+        _mm256_set1_epi32(0x5A827999)
+        , _mm256_set1_epi32(0x6ED9EBA1)
+        , _mm256_set1_epi32(int(0x8F1BBCDC))
+        , _mm256_set1_epi32(int(0xCA62C1D6))
+    };
+
+    for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Blocks; c4BInd++)
+    {
+        __m256i am256W[16];
+        CIDCrypto_HWAccel::LoadLaneWords(apc1Data, 0, am256W);
+        CIDCrypto_HWAccel::LoadLaneWords(apc1Data, 32, am256W + 8);
+
+        const __m256i m256SaveA = m256A;
+        const __m256i m256SaveB = m256B;
+        const __m256i m256SaveC = m256C;
+        const __m256i m256SaveD = m256D;
+        const __m256i m256SaveE = m256E;
+
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < 80; c4Round++)
+        {
+            // Past the first 16 we calculate the words in place
+            __m256i& m256W = am256W[c4Round & 15];
+            if (c4Round >= 16)
+            {
+                m256W = CIDCrypto_HWAccel::m256RotL
+                (
+                    _mm256_xor_si256
+                    (
+                        _mm256_xor_si256(am256W[(c4Round - 3) & 15], am256W[(c4Round - 8) & 15])
+                        , _mm256_xor_si256(am256W[(c4Round - 14) & 15], m256W)
+                    )
+                    , 1
+                );
+            }
+
+            __m256i m256F;
+            if (c4Round < 20)
+            {
+                m256F = _mm256_xor_si256(m256D, _mm256_and_si256(m256B, _mm256_xor_si256(m256C, m256D)));
+            }
+             else if ((c4Round >= 40) && (c4Round < 60))
+            {
+                m256F = _mm256_or_si256
+                (
+                    _mm256_and_si256(m256B, m256C)
+                    , _mm256_and_si256(m256D, _mm256_or_si256(m256B, m256C))
+                );
+            }
+             else
+            {
+                m256F = _mm256_xor_si256(_mm256_xor_si256(m256B, m256C), m256D);
+            }
+
+            const __m256i m256Tmp = _mm256_add_epi32
+            (
+                _mm256_add_epi32(CIDCrypto_HWAccel::m256RotL(m256A, 5), m256F)
+                , _mm256_add_epi32
+                  (
+                    _mm256_add_epi32(m256E, m256W), am256K[c4Round / 20]
+                  )
+            );
+            m256E = m256D;
+            m256D = m256C;
+            m256C = CIDCrypto_HWAccel::m256RotL(m256B, 30);
+            m256B = m256A;
+            m256A = m256Tmp;
+        }
+
+        m256A = _mm256_add_epi32(m256A, m256SaveA);
+        m256B = _mm256_add_epi32(m256B, m256SaveB);
+        m256C = _mm256_add_epi32(m256C, m256SaveC);
+        m256D = _mm256_add_epi32(m256D, m256SaveD);
+        m256E = _mm256_add_epi32(m256E, m256SaveE);
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Lanes; c4Index++)
+            apc1Data[c4Index] += 64;
+    }
+
+    _mm256_storeu_si256(pm256State, m256A);
+    _mm256_storeu_si256(pm256State + 1, m256B);
+    _mm256_storeu_si256(pm256State + 2, m256C);
+    _mm256_storeu_si256(pm256State + 3, m256D);
+    _mm256_storeu_si256(pm256State + 4, m256E);
+}
+
+
+//
+//  The SHA256RNDS2 instruction does two rounds, and wants the state split into
+//  ABEF and CDGH halves, so we have to shuffle the state on the way in and out.
+//  The message schedule is done four words at a time with the MSG1/MSG2
+//  instructions.
+//
+CIDLIB_ISATARGET("sha,sse4.1")
+tCIDLib::TVoid
+TCryptoHWAccel::SHA256Blocks(       tCIDLib::TCard4* const  pc4State
+                            , const tCIDLib::TCard1*        pc1Data
+                            , const tCIDLib::TCard4         c4Blocks)
+{
+    const __m128i m128Mask = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL);
+    const __m128i* pm128K = reinterpret_cast<const __m128i*>(kCIDCrypto_::ac4SHA256K);
+
+    __m128i m128Tmp = _mm_shuffle_epi32
+    (
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc4State)), 0xB1
+    );
+    __m128i m128State1 = _mm_shuffle_epi32
+    (
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc4State + 4)), 0x1B
+    );
+    __m128i m128State0 = _mm_alignr_epi8(m128Tmp, m128State1, 8);
+    m128State1 = _mm_blend_epi16(m128State1, m128Tmp, 0xF0);
+
+    const __m128i* pm128Src = reinterpret_cast<const __m128i*>(pc1Data);
+    for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Blocks; c4BInd++)
+    {
+        const __m128i m128Save0 = m128State0;
+        const __m128i m128Save1 = m128State1;
+
+        __m128i m128W0 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src), m128Mask);
+        CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W0, pm128K[0]);
+        __m128i m128W1 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 1), m128Mask);
+        CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W1, pm128K[1]);
+        __m128i m128W2 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 2), m128Mask);
+        CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W2, pm128K[2]);
+        __m128i m128W3 = _mm_shuffle_epi8(_mm_loadu_si128(pm128Src + 3), m128Mask);
+        CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W3, pm128K[3]);
+
+        // The rest we calculate the message words for as we go
+        for (tCIDLib::TCard4 c4Group = 4; c4Group < 16; c4Group += 4)
+        {
+            m128W0 = CIDCrypto_HWAccel::m128SHA256Sched(m128W0, m128W1, m128W2, m128W3);
+            CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W0, pm128K[c4Group]);
+            m128W1 = CIDCrypto_HWAccel::m128SHA256Sched(m128W1, m128W2, m128W3, m128W0);
+            CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W1, pm128K[c4Group + 1]);
+            m128W2 = CIDCrypto_HWAccel::m128SHA256Sched(m128W2, m128W3, m128W0, m128W1);
+            CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W2, pm128K[c4Group + 2]);
+            m128W3 = CIDCrypto_HWAccel::m128SHA256Sched(m128W3, m128W0, m128W1, m128W2);
+            CIDCrypto_HWAccel::SHA256Quad(m128State0, m128State1, m128W3, pm128K[c4Group + 3]);
+        }
+
+        m128State0 = _mm_add_epi32(m128State0, m128Save0);
+        m128State1 = _mm_add_epi32(m128State1, m128Save1);
+        pm128Src += 4;
+    }
+
+    m128Tmp = _mm_shuffle_epi32(m128State0, 0x1B);
+    m128State1 = _mm_shuffle_epi32(m128State1, 0xB1);
+    _mm_storeu_si128
+    (
+        reinterpret_cast<__m128i*>(pc4State), _mm_blend_epi16(m128Tmp, m128State1, 0xF0)
+    );
+    _mm_storeu_si128
+    (
+        reinterpret_cast<__m128i*>(pc4State + 4), _mm_alignr_epi8(m128State1, m128Tmp, 8)
+    );
+}
+
+
+CIDLIB_ISATARGET("avx2")
+tCIDLib::TVoid
+TCryptoHWAccel::SHA256Lanes(        tCIDLib::TCard4* const  pc4States
+                            , const tCIDLib::TCard1** const apc1Data
+                            , const tCIDLib::TCard4         c4Blocks)
+{
+    constexpr tCIDLib::TCard4 c4Lanes = kCIDCrypto_::c4SHALanes;
+    __m256i* const pm256State = reinterpret_cast<__m256i*>(pc4States);
+
+    __m256i am256H[8];
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+        am256H[c4Index] = _mm256_loadu_si256(pm256State + c4Index);
+
+    for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Blocks; c4BInd++)
+    {
+        __m256i am256W[16];
+        CIDCrypto_HWAccel::LoadLaneWords(apc1Data, 0, am256W);
+        CIDCrypto_HWAccel::LoadLaneWords(apc1Data, 32, am256W + 8);
+
+        __m256i m256A = am256H[0];
+        __m256i m256B = am256H[1];
+        __m256i m256C = am256H[2];
+        __m256i m256D = am256H[3];
+        __m256i m256E = am256H[4];
+        __m256i m256F = am256H[5];
+        __m256i m256G = am256H[6];
+        __m256i m256H = am256H[7];
+
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < 64; c4Round++)
+        {
+            __m256i& m256W = am256W[c4Round & 15];
+            if (c4Round >= 16)
+            {
+                const __m256i m256W15 = am256W[(c4Round - 15) & 15];
+                const __m256i m256W2 = am256W[(c4Round - 2) & 15];
+                const __m256i m256S0 = _mm256_xor_si256
+                (
+                    _mm256_xor_si256
+                    (
+                        CIDCrypto_HWAccel::m256RotR(m256W15, 7)
+                        , CIDCrypto_HWAccel::m256RotR(m256W15, 18)
+                    )
+                    , _mm256_srli_epi32(m256W15, 3)
+                );
+                const __m256i m256S1 = _mm256_xor_si256
+                (
+                    _mm256_xor_si256
+                    (
+                        CIDCrypto_HWAccel::m256RotR(m256W2, 17)
+                        , CIDCrypto_HWAccel::m256RotR(m256W2, 19)
+                    )
+                    , _mm256_srli_epi32(m256W2, 10)
+                );
+                m256W = _mm256_add_epi32
+                (
+                    _mm256_add_epi32(m256W, m256S0)
+                    , _mm256_add_epi32(am256W[(c4Round - 7) & 15], m256S1)
+                );
+            }
+
+            const __m256i m256Sum1 = _mm256_xor_si256
+            (
+                _mm256_xor_si256
+                (
+                    CIDCrypto_HWAccel::m256RotR(m256E, 6), CIDCrypto_HWAccel::m256RotR(m256E, 11)
+                )
+                , CIDCrypto_HWAccel::m256RotR(m256E, 25)
+            );
+            const __m256i m256Ch = _mm256_xor_si256
+            (
+                m256G, _mm256_and_si256(m256E, _mm256_xor_si256(m256F, m256G))
+            );
+            const __m256i m256T1 = _mm256_add_epi32
+            (
+                _mm256_add_epi32(_mm256_add_epi32(m256H, m256Sum1), m256Ch)
+                , _mm256_add_epi32
+                  (
+                    _mm256_set1_epi32(int(kCIDCrypto_::ac4SHA256K[c4Round])), m256W
+                  )
+            );
+
+            const __m256i m256Sum0 = _mm256_xor_si256
+            (
+                _mm256_xor_si256
+                (
+                    CIDCrypto_HWAccel::m256RotR(m256A, 2), CIDCrypto_HWAccel::m256RotR(m256A, 13)
+                )
+                , CIDCrypto_HWAccel::m256RotR(m256A, 22)
+            );
+            const __m256i m256Maj = _mm256_or_si256
+            (
+                _mm256_and_si256(m256A, m256B)
+                , _mm256_and_si256(m256C, _mm256_or_si256(m256A, m256B))
+            );
+
+            m256H = m256G;
+            m256G = m256F;
+            m256F = m256E;
+            m256E = _mm256_add_epi32(m256D, m256T1);
+            m256D = m256C;
+            m256C = m256B;
+            m256B = m256A;
+            m256A = _mm256_add_epi32(m256T1, _mm256_add_epi32(m256Sum0, m256Maj));
+        }
+
+        am256H[0] = _mm256_add_epi32(am256H[0], m256A);
+        am256H[1] = _mm256_add_epi32(am256H[1], m256B);
+        am256H[2] = _mm256_add_epi32(am256H[2], m256C);
+        am256H[3] = _mm256_add_epi32(am256H[3], m256D);
+        am256H[4] = _mm256_add_epi32(am256H[4], m256E);
+        am256H[5] = _mm256_add_epi32(am256H[5], m256F);
+        am256H[6] = _mm256_add_epi32(am256H[6], m256G);
+        am256H[7] = _mm256_add_epi32(am256H[7], m256H);
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Lanes; c4Index++)
+            apc1Data[c4Index] += 64;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+        _mm256_storeu_si256(pm256State + c4Index, am256H[c4Index]);
+}
+
+#else
+
+//
+//  On other CPUs we just say none of it is available, and these will never
+//  get called.
+//
+tCIDLib::TVoid
+TCryptoHWAccel::AESDecryptBlocks(const  tCIDLib::TCard1* const
+                                , const tCIDLib::TCard4
+                                , const tCIDLib::TCard1*
+                                ,       tCIDLib::TCard1*
+                                , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::AESEncryptBlocks(const  tCIDLib::TCard1* const
+                                , const tCIDLib::TCard4
+                                , const tCIDLib::TCard1*
+                                ,       tCIDLib::TCard1*
+                                , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TBoolean TCryptoHWAccel::bAESAvail()
+{
+    return kCIDLib::False;
+}
+
+tCIDLib::TBoolean TCryptoHWAccel::bGHashAvail()
+{
+    return kCIDLib::False;
+}
+
+tCIDLib::TBoolean TCryptoHWAccel::bSHAAvail()
+{
+    return kCIDLib::False;
+}
+
+tCIDLib::TBoolean TCryptoHWAccel::bSHALanesAvail()
+{
+    return kCIDLib::False;
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::GHashBlocks(const   tCIDLib::TCard1* const
+                            ,       tCIDLib::TCard1* const
+                            , const tCIDLib::TCard1*
+                            , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::SHA1Blocks(         tCIDLib::TCard4* const
+                            , const tCIDLib::TCard1*
+                            , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::SHA1Lanes(          tCIDLib::TCard4* const
+                            , const tCIDLib::TCard1** const
+                            , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::SHA256Blocks(       tCIDLib::TCard4* const
+                            , const tCIDLib::TCard1*
+                            , const tCIDLib::TCard4)
+{
+}
+
+tCIDLib::TVoid
+TCryptoHWAccel::SHA256Lanes(        tCIDLib::TCard4* const
+                            , const tCIDLib::TCard1** const
+                            , const tCIDLib::TCard4)
+{
+}
+
+#endif
@@ -0,0 +1,113 @@
+//
+// FILE NAME: CIDCrypto_HWAccel_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the internal header for the CIDCrypto_HWAccel.cpp file. This file
+//  provides the hardware accelerated (AES-NI and PCLMULQDQ) versions of the
+//  AES block operations and the GCM GHASH function, and SHA extensions and
+//  AVX2 versions of the SHA-1 and SHA-256 compression functions. These are
+//  only called if the availability methods say they are available, else the
+//  callers use the portable versions.
+//
+//  The AES methods take the round keys in byte form, i.e. each round key is
+//  the big endian round key words from the standard key schedule, stored as
+//  bytes. The decrypt keys are the 'equivalent inverse cypher' keys, which
+//  is what the table driven AES implementation already creates.
+//
+//  The GHASH method takes the hash key H (the encryption of an all zeros
+//  block) and the running hash value, both as standard GCM byte order blocks,
+//  and updates the hash with the passed full blocks.
+//
+//  The SHA block methods take the hasher's state words (A, B, C, ... in that
+//  order) and run the passed number of full 64 byte blocks through them. The
+//  lanes versions hash kCIDCrypto_::c4SHALanes independent streams at once.
+//  The state words are interleaved, so word n of lane x is at index
+//  (n * c4SHALanes) + x. Each lane's data pointer is moved forward by the
+//  number of bytes processed.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+namespace TCryptoHWAccel
+{
+    tCIDLib::TVoid AESDecryptBlocks
+    (
+        const   tCIDLib::TCard1* const  pc1Keys
+        , const tCIDLib::TCard4         c4Rounds
+        , const tCIDLib::TCard1*        pc1In
+        ,       tCIDLib::TCard1*        pc1Out
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid AESEncryptBlocks
+    (
+        const   tCIDLib::TCard1* const  pc1Keys
+        , const tCIDLib::TCard4         c4Rounds
+        , const tCIDLib::TCard1*        pc1In
+        ,       tCIDLib::TCard1*        pc1Out
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TBoolean bAESAvail();
+
+    tCIDLib::TBoolean bGHashAvail();
+
+    tCIDLib::TBoolean bSHAAvail();
+
+    tCIDLib::TBoolean bSHALanesAvail();
+
+    tCIDLib::TVoid GHashBlocks
+    (
+        const   tCIDLib::TCard1* const  pc1H
+        ,       tCIDLib::TCard1* const  pc1Hash
+        , const tCIDLib::TCard1*        pc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid SHA1Blocks
+    (
+                tCIDLib::TCard4* const  pc4State
+        , const tCIDLib::TCard1*        pc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid SHA1Lanes
+    (
+                tCIDLib::TCard4* const  pc4States
+        , const tCIDLib::TCard1** const apc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid SHA256Blocks
+    (
+                tCIDLib::TCard4* const  pc4State
+        , const tCIDLib::TCard1*        pc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid SHA256Lanes
+    (
+                tCIDLib::TCard4* const  pc4States
+        , const tCIDLib::TCard1** const apc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+}
@@ -38,17 +38,9 @@ class CIDCRYPTEXP THashDigest : public TObject
         // -------------------------------------------------------------------
         //  Constructors and destructor
         // -------------------------------------------------------------------
-        THashDigest(const THashDigest&) = delete;
-
         ~THashDigest();
 
 
-        // -------------------------------------------------------------------
-        //  Public operators
-        // -------------------------------------------------------------------
-        THashDigest& operator=(const THashDigest&) = delete;
-
-
         // -------------------------------------------------------------------
         //  Public, virtual methods
         // -------------------------------------------------------------------
@@ -118,6 +110,19 @@ class CIDCRYPTEXP THashDigest : public TObject
             const   tCIDLib::TCard4         c4BlockSize
         );
 
+        //
+        //  Derived classes can be copied, so that a partially done hash can be
+        //  cloned, e.g. to reuse the keyed state in THMAC. But only as their
+        //  actual type, not via the base class.
+        //
+        THashDigest(const THashDigest&) = default;
+
+
+        // -------------------------------------------------------------------
+        //  Protected operators
+        // -------------------------------------------------------------------
+        THashDigest& operator=(const THashDigest&) = default;
+
 
     private :
         // -------------------------------------------------------------------
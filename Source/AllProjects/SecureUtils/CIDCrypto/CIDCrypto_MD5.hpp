@@ -46,7 +46,7 @@ class CIDCRYPTEXP TMessageDigest5 : public THashDigest
         // -------------------------------------------------------------------
         TMessageDigest5();
 
-        TMessageDigest5(const TMessageDigest5&) = delete;
+        TMessageDigest5(const TMessageDigest5&) = default;
 
         ~TMessageDigest5();
 
@@ -54,7 +54,7 @@ class CIDCRYPTEXP TMessageDigest5 : public THashDigest
         // -------------------------------------------------------------------
         //  Public operators
         // -------------------------------------------------------------------
-        TMessageDigest5& operator=(const TMessageDigest5&) = delete;
+        TMessageDigest5& operator=(const TMessageDigest5&) = default;
 
 
         // -------------------------------------------------------------------
@@ -45,6 +45,28 @@ c4CircularShift(const tCIDLib::TCard4 c4Bits, const tCIDLib::TCard4 c4Word)
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDCrypto_SHA1
+    {
+        // The initial hash state, used by us and by the multi-message scheme
+        constexpr tCIDLib::TCard4 ac4InitState[5] =
+        {
+            0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+        };
+
+        //
+        //  How many messages we pass to the lanes hasher at once, which sets the
+        //  size of the output buffer we need.
+        //
+        constexpr tCIDLib::TCard4   c4MultiBatch = 64;
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 //  Do our RTTI macros
 // ---------------------------------------------------------------------------
@@ -62,6 +84,7 @@ RTTIDecls(TSHA1Hasher,TObject)
 TSHA1Hasher::TSHA1Hasher() :
 
     THashDigest(c4BlockSz)
+    , m_bHWAccel(TCryptoHWAccel::bSHAAvail())
     , m_c4ByteCnt(0)
     , m_c4PartialCnt(0)
 {
@@ -77,6 +100,67 @@ TSHA1Hasher::~TSHA1Hasher()
 }
 
 
+// ---------------------------------------------------------------------------
+//  TSHA1Hasher: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Hashes a list of independent messages. If we have the SHA extensions, just
+//  doing them one at a time with those is fastest. Else, if we have AVX2, we
+//  can do a set of them in parallel with the lanes hasher. Else we just do them
+//  one at a time with the portable code.
+//
+tCIDLib::TVoid
+TSHA1Hasher::DigestMulti(const  tCIDLib::TCard1* const* const   apc1Msgs
+                        , const tCIDLib::TCard4* const          ac4Bytes
+                        ,       TSHA1Hash* const                amhashToFill
+                        , const tCIDLib::TCard4                 c4Count)
+{
+    if (!c4Count)
+        return;
+
+    if (!TCryptoHWAccel::bSHAAvail() && TCryptoHWAccel::bSHALanesAvail())
+    {
+        constexpr tCIDLib::TCard4 c4HashBytes = kCIDCrypto::c4SHA1HashBytes;
+        tCIDLib::TCard1 ac1Hashes[CIDCrypto_SHA1::c4MultiBatch * c4HashBytes];
+
+        tCIDLib::TCard4 c4Done = 0;
+        while (c4Done < c4Count)
+        {
+            const tCIDLib::TCard4 c4Batch = tCIDLib::MinVal
+            (
+                CIDCrypto_SHA1::c4MultiBatch, c4Count - c4Done
+            );
+
+            TCryptoSHALanes::HashMsgs
+            (
+                TCryptoHWAccel::SHA1Lanes
+                , CIDCrypto_SHA1::ac4InitState
+                , c4BufCnt
+                , &apc1Msgs[c4Done]
+                , &ac4Bytes[c4Done]
+                , c4Batch
+                , ac1Hashes
+            );
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Batch; c4Index++)
+                amhashToFill[c4Done + c4Index].Set(&ac1Hashes[c4Index * c4HashBytes], c4HashBytes);
+            c4Done += c4Batch;
+        }
+        return;
+    }
+
+    TSHA1Hasher mdigHash;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        mdigHash.StartNew();
+        mdigHash.DigestRaw(apc1Msgs[c4Index], ac4Bytes[c4Index]);
+        mdigHash.Complete(amhashToFill[c4Index]);
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  TSHA1Hasher: Public, non-virtual methods
 // ---------------------------------------------------------------------------
@@ -154,29 +238,24 @@ TSHA1Hasher::DigestRaw( const   tCIDLib::TCard1* const  pc1ToDigest
             return;
 
         // We got a full block so process and it and reset the partial count
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
         m_c4PartialCnt = 0;
     }
 
-    // And now process the remaining full blocks
-    while (c4Index < c4Bytes)
+    //
+    //  And now process the remaining full blocks. We do them all in one shot,
+    //  so that the accelerated version can keep the state in registers across
+    //  blocks.
+    //
+    const tCIDLib::TCard4 c4Full = (c4Bytes - c4Index) / c4BlockSz;
+    if (c4Full)
     {
-        //
-        //  We process blocksz bytes at a time, so see if we have that many left
-        //  If not, we have to pad a block at the end, so break out.
-        //
-        if (c4Index + c4BlockSz > c4Bytes)
-            break;
-
-        // We can do another whole block
-        ProcessMsgBlock(pc1Cur);
-
-        // Move forward now by a whole block
-        pc1Cur += c4BlockSz;
-        c4Index += c4BlockSz;
+        ProcessMsgBlocks(pc1Cur, c4Full);
 
-        // Bump the count of bytes we've processed so far
-        m_c4ByteCnt += c4BlockSz;
+        const tCIDLib::TCard4 c4FullBytes = c4Full * c4BlockSz;
+        pc1Cur += c4FullBytes;
+        c4Index += c4FullBytes;
+        m_c4ByteCnt += c4FullBytes;
     }
 
     //
@@ -219,7 +298,7 @@ TSHA1Hasher::DigestSrc(TBinInStream& strmSrc, const tCIDLib::TCard4 c4Bytes)
             return;
 
         // We got a full block so process and it and reset the partial count
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
         m_c4PartialCnt = 0;
     }
 
@@ -238,7 +317,7 @@ TSHA1Hasher::DigestSrc(TBinInStream& strmSrc, const tCIDLib::TCard4 c4Bytes)
         //  as a temp since we know we have flushed out any partial at this point.
         //
         strmSrc.c4ReadRawBuffer(m_ac1Partial, c4BlockSz);
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
 
         // Move forward now by a whole block
         c4Index += c4BlockSz;
@@ -273,11 +352,7 @@ tCIDLib::TVoid TSHA1Hasher::StartNew()
 
 tCIDLib::TVoid TSHA1Hasher::InitContext()
 {
-    m_ac4H[0] = 0x67452301;
-    m_ac4H[1] = 0xEFCDAB89;
-    m_ac4H[2] = 0x98BADCFE;
-    m_ac4H[3] = 0x10325476;
-    m_ac4H[4] = 0xC3D2E1F0;
+    TRawMem::CopyMemBuf(m_ac4H, CIDCrypto_SHA1::ac4InitState, sizeof(m_ac4H));
 
     // Reset counts
     m_c4ByteCnt = 0;
@@ -302,7 +377,7 @@ tCIDLib::TVoid TSHA1Hasher::PadMsg()
         m_ac1Partial[c4Index++] = 0x80;
         while(c4Index < c4BlockSz)
             m_ac1Partial[c4Index++] = 0;
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
 
         // Fill up another up to the point where we put in the length
         c4Index = 0;
@@ -333,7 +408,7 @@ tCIDLib::TVoid TSHA1Hasher::PadMsg()
     m_ac1Partial[63] = tCIDLib::TCard1((c4BitCnt ) & 0xFF);
 
     // And spit out this last one
-    ProcessMsgBlock(m_ac1Partial);
+    ProcessMsgBlocks(m_ac1Partial, 1);
     m_c4PartialCnt = 0;
 }
 
@@ -433,6 +508,29 @@ TSHA1Hasher::ProcessMsgBlock(const tCIDLib::TCard1* const pc1Block)
 }
 
 
+//
+//  Handles a run of full blocks. If we have the SHA extensions we pass them all
+//  to the accelerated version, else we just do them one at a time.
+//
+tCIDLib::TVoid
+TSHA1Hasher::ProcessMsgBlocks(  const   tCIDLib::TCard1* const  pc1Blocks
+                                , const tCIDLib::TCard4         c4Count)
+{
+    if (m_bHWAccel)
+    {
+        TCryptoHWAccel::SHA1Blocks(m_ac4H, pc1Blocks, c4Count);
+        return;
+    }
+
+    const tCIDLib::TCard1* pc1Cur = pc1Blocks;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        ProcessMsgBlock(pc1Cur);
+        pc1Cur += c4BlockSz;
+    }
+}
+
+
 // Clean ou the context info for discretion
 tCIDLib::TVoid TSHA1Hasher::ScrubContext()
 {
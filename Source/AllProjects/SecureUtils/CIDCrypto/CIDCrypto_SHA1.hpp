@@ -40,11 +40,29 @@ class CIDCRYPTEXP TSHA1Hasher : public THashDigest
         // -------------------------------------------------------------------
         TSHA1Hasher();
 
-        TSHA1Hasher(const TSHA1Hasher&) = delete;
+        TSHA1Hasher(const TSHA1Hasher&) = default;
 
         ~TSHA1Hasher();
 
 
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TVoid DigestMulti
+        (
+            const   tCIDLib::TCard1* const* const   apc1Msgs
+            , const tCIDLib::TCard4* const          ac4Bytes
+            ,       TSHA1Hash* const                amhashToFill
+            , const tCIDLib::TCard4                 c4Count
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TSHA1Hasher& operator=(const TSHA1Hasher&) = default;
+
+
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
@@ -76,13 +94,6 @@ class CIDCRYPTEXP TSHA1Hasher : public THashDigest
         static constexpr tCIDLib::TCard4    c4BufCnt  = 5;
 
 
-        // -------------------------------------------------------------------
-        //  Unimplemented constructors and operators
-        // -------------------------------------------------------------------
-
-        tCIDLib::TVoid operator=(const TSHA1Hasher&);
-
-
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
@@ -95,6 +106,12 @@ class CIDCRYPTEXP TSHA1Hasher : public THashDigest
             const   tCIDLib::TCard1* const  pc1Block
         );
 
+        tCIDLib::TVoid ProcessMsgBlocks
+        (
+            const   tCIDLib::TCard1* const  pc1Blocks
+            , const tCIDLib::TCard4         c4Count
+        );
+
         tCIDLib::TVoid ScrubContext();
 
 
@@ -110,6 +127,10 @@ class CIDCRYPTEXP TSHA1Hasher : public THashDigest
         //  m_ac4H
         //      Message digest buffers
         //
+        //  m_bHWAccel
+        //      Set if the CPU has the SHA extensions, in which case we use them
+        //      for the compression function instead of the portable code.
+        //
         //  m_c4ByteCnt
         //      We have to remember the full count of bytes we have hashed,
         //      because it's used at the end.
@@ -117,10 +138,11 @@ class CIDCRYPTEXP TSHA1Hasher : public THashDigest
         //  m_c4PartialCnt
         //      The number of bytes in the m_ac1Partial buffer.
         // -------------------------------------------------------------------
-        tCIDLib::TCard1 m_ac1Partial[c4BlockSz];
-        tCIDLib::TCard4 m_ac4H[c4BufCnt];
-        tCIDLib::TCard4 m_c4ByteCnt;
-        tCIDLib::TCard4 m_c4PartialCnt;
+        tCIDLib::TCard1   m_ac1Partial[c4BlockSz];
+        tCIDLib::TCard4   m_ac4H[c4BufCnt];
+        tCIDLib::TBoolean m_bHWAccel;
+        tCIDLib::TCard4   m_c4ByteCnt;
+        tCIDLib::TCard4   m_c4PartialCnt;
 
 
         // -------------------------------------------------------------------
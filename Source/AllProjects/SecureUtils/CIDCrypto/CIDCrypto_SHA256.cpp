@@ -59,26 +59,187 @@
            | ((tCIDLib::TCard4) *((str) + 0) << 24);   \
 }
 
-static constexpr tCIDLib::TCard4 ac4K[kCIDCrypto::c4SHA256BlockSize] =
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
 {
-      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5
-    , 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5
-    , 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3
-    , 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174
-    , 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc
-    , 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da
-    , 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7
-    , 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967
-    , 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13
-    , 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85
-    , 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3
-    , 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070
-    , 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5
-    , 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3
-    , 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208
-    , 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-};
+    namespace CIDCrypto_SHA256
+    {
+        // The initial hash state, used by us and by the multi-message scheme
+        constexpr tCIDLib::TCard4 ac4InitState[8] =
+        {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a
+            , 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+
+        //
+        //  How many messages we pass to the lanes hasher at once, which sets the
+        //  size of the output buffer we need. And the number of tree hash leaves
+        //  a thread has to get before it's worth using another thread.
+        //
+        constexpr tCIDLib::TCard4   c4MultiBatch = 64;
+        constexpr tCIDLib::TCard4   c4MinThreadLeaves = 4;
+
+        // The prefix bytes for tree leaves, nodes, and the final hash
+        constexpr tCIDLib::TCard1   c1LeafPref = 0x00;
+        constexpr tCIDLib::TCard1   c1NodePref = 0x01;
+        constexpr tCIDLib::TCard1   c1RootPref = 0x02;
+
+
+        // -----------------------------------------------------------------------
+        //  For the parallel tree hash, each worker thread gets one of these. It
+        //  does a contiguous range of leaves. If it fails, it stores the error
+        //  for the calling thread to throw.
+        // -----------------------------------------------------------------------
+        struct TTreeSeg
+        {
+            const tCIDLib::TCard1*  pc1Data = nullptr;
+            tCIDLib::TCard4         c4DataSz = 0;
+            tCIDLib::TCard4         c4FirstLeaf = 0;
+            tCIDLib::TCard4         c4LeafCnt = 0;
+            TSHA256Hash*            pmhashLeaves = nullptr;
+            tCIDLib::TBoolean       bFailed = kCIDLib::False;
+            TError                  errFailure;
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  Hashes a list of independent messages, optionally with a prefix byte
+        //  in front of each one. If we have the SHA extensions, just doing them
+        //  one at a time with those is fastest. Else, if we have AVX2, we can do
+        //  a set of them in parallel with the lanes hasher. Else we just do them
+        //  one at a time with the portable code.
+        // -----------------------------------------------------------------------
+        tCIDLib::TVoid DigestMsgs(  const   tCIDLib::TCard1* const* const   apc1Msgs
+                                    , const tCIDLib::TCard4* const          ac4Bytes
+                                    ,       TSHA256Hash* const              amhashToFill
+                                    , const tCIDLib::TCard4                 c4Count
+                                    , const tCIDLib::TCard1* const          pc1Prefix)
+        {
+            if (!c4Count)
+                return;
+
+            if (!TCryptoHWAccel::bSHAAvail() && TCryptoHWAccel::bSHALanesAvail())
+            {
+                constexpr tCIDLib::TCard4 c4HashBytes = kCIDCrypto::c4SHA256HashBytes;
+                tCIDLib::TCard1 ac1Hashes[c4MultiBatch * c4HashBytes];
+
+                tCIDLib::TCard4 c4Done = 0;
+                while (c4Done < c4Count)
+                {
+                    const tCIDLib::TCard4 c4Batch = tCIDLib::MinVal(c4MultiBatch, c4Count - c4Done);
+
+                    TCryptoSHALanes::HashMsgs
+                    (
+                        TCryptoHWAccel::SHA256Lanes
+                        , ac4InitState
+                        , tCIDLib::c4ArrayElems(ac4InitState)
+                        , &apc1Msgs[c4Done]
+                        , &ac4Bytes[c4Done]
+                        , c4Batch
+                        , ac1Hashes
+                        , pc1Prefix
+                    );
+
+                    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Batch; c4Index++)
+                        amhashToFill[c4Done + c4Index].Set(&ac1Hashes[c4Index * c4HashBytes], c4HashBytes);
+                    c4Done += c4Batch;
+                }
+                return;
+            }
+
+            TSHA256Hasher mdigHash;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                mdigHash.StartNew();
+                if (pc1Prefix)
+                    mdigHash.DigestRaw(pc1Prefix, 1);
+                mdigHash.DigestRaw(apc1Msgs[c4Index], ac4Bytes[c4Index]);
+                mdigHash.Complete(amhashToFill[c4Index]);
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Hash a range of tree leaves. We do them in batches via the multi-
+        //  message hasher, which will use the lanes hasher if it's the best
+        //  available option. Each leaf gets the leaf prefix byte.
+        // -----------------------------------------------------------------------
+        tCIDLib::TVoid HashLeaves(  const   tCIDLib::TCard1* const  pc1Data
+                                    , const tCIDLib::TCard4         c4DataSz
+                                    , const tCIDLib::TCard4         c4FirstLeaf
+                                    , const tCIDLib::TCard4         c4LeafCnt
+                                    ,       TSHA256Hash* const      pmhashLeaves)
+        {
+            constexpr tCIDLib::TCard4 c4LeafSz = kCIDCrypto::c4SHA256TreeLeafSz;
+
+            const tCIDLib::TCard1* apc1Msgs[c4MultiBatch];
+            tCIDLib::TCard4 ac4Bytes[c4MultiBatch];
+
+            tCIDLib::TCard4 c4Done = 0;
+            while (c4Done < c4LeafCnt)
+            {
+                const tCIDLib::TCard4 c4Batch = tCIDLib::MinVal(c4MultiBatch, c4LeafCnt - c4Done);
+                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Batch; c4Index++)
+                {
+                    const tCIDLib::TCard4 c4Ofs = (c4FirstLeaf + c4Done + c4Index) * c4LeafSz;
+                    apc1Msgs[c4Index] = pc1Data + c4Ofs;
+                    ac4Bytes[c4Index] = tCIDLib::MinVal(c4LeafSz, c4DataSz - c4Ofs);
+                }
+
+                DigestMsgs
+                (
+                    apc1Msgs
+                    , ac4Bytes
+                    , &pmhashLeaves[c4FirstLeaf + c4Done]
+                    , c4Batch
+                    , &c1LeafPref
+                );
+                c4Done += c4Batch;
+            }
+        }
+
 
+        // -----------------------------------------------------------------------
+        //  The tree hash worker thread entry point.
+        // -----------------------------------------------------------------------
+        tCIDLib::EExitCodes eTreeSegThread(TThread& thrThis, tCIDLib::TVoid* pData)
+        {
+            TTreeSeg* pSeg = static_cast<TTreeSeg*>(pData);
+
+            // Let the calling thread go
+            thrThis.Sync();
+
+            try
+            {
+                HashLeaves
+                (
+                    pSeg->pc1Data
+                    , pSeg->c4DataSz
+                    , pSeg->c4FirstLeaf
+                    , pSeg->c4LeafCnt
+                    , pSeg->pmhashLeaves
+                );
+            }
+
+            catch(TError& errToCatch)
+            {
+                pSeg->errFailure = errToCatch;
+                pSeg->bFailed = kCIDLib::True;
+            }
+
+            catch(...)
+            {
+                pSeg->bFailed = kCIDLib::True;
+            }
+            return tCIDLib::EExitCodes::Normal;
+        }
+    }
+}
 
 
 // ---------------------------------------------------------------------------
@@ -98,6 +259,7 @@ RTTIDecls(TSHA256Hasher,TObject)
 TSHA256Hasher::TSHA256Hasher() :
 
     THashDigest(kCIDCrypto::c4SHA256BlockSize)
+    , m_bHWAccel(TCryptoHWAccel::bSHAAvail())
     , m_c4ByteCnt(0)
     , m_c4PartialCnt(0)
 {
@@ -113,6 +275,162 @@ TSHA256Hasher::~TSHA256Hasher()
 }
 
 
+// ---------------------------------------------------------------------------
+//  TSHA256Hasher: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Hashes a list of independent messages. The local helper does the work, since
+//  the tree hash also needs it, with the leaf prefix byte.
+//
+tCIDLib::TVoid
+TSHA256Hasher::DigestMulti( const   tCIDLib::TCard1* const* const   apc1Msgs
+                            , const tCIDLib::TCard4* const          ac4Bytes
+                            ,       TSHA256Hash* const              amhashToFill
+                            , const tCIDLib::TCard4                 c4Count)
+{
+    CIDCrypto_SHA256::DigestMsgs(apc1Msgs, ac4Bytes, amhashToFill, c4Count, nullptr);
+}
+
+
+//
+//  Does a tree hash of the passed buffer, so that the leaves can be done in
+//  parallel. The buffer is broken into kCIDCrypto::c4SHA256TreeLeafSz sized
+//  leaves (the last one can be short, and an empty buffer is one empty leaf),
+//  and each one is hashed as:
+//
+//      SHA256(0x00 | leaf)
+//
+//  Then pairs of hashes are combined as:
+//
+//      SHA256(0x01 | left | right)
+//
+//  until we get to one. An odd one out at any level just moves up as is. The
+//  final hash is then:
+//
+//      SHA256(0x02 | root | 64 bit big endian byte count)
+//
+//  The prefixes keep leaves, nodes and the final hash from ever being confused
+//  with each other, so a 65 byte leaf can't pass for a node, and the length
+//  binds the shape of the tree. This is not the same as a regular SHA-256 hash
+//  of the data, so both sides have to use this method.
+//
+//  If they pass zero for max threads, we use one per CPU. We only use as many
+//  threads as will have a reasonable number of leaves each, and if that ends
+//  up being one we just do it on the calling thread.
+//
+tCIDLib::TVoid
+TSHA256Hasher::TreeHash(const   tCIDLib::TCard1* const  pc1ToDigest
+                        , const tCIDLib::TCard4         c4Bytes
+                        ,       TSHA256Hash&            mhashToFill
+                        , const tCIDLib::TCard4         c4MaxThreads)
+{
+    constexpr tCIDLib::TCard4 c4LeafSz = kCIDCrypto::c4SHA256TreeLeafSz;
+    constexpr tCIDLib::TCard4 c4HashBytes = kCIDCrypto::c4SHA256HashBytes;
+
+    const tCIDLib::TCard4 c4LeafCnt = c4Bytes ? ((c4Bytes - 1) / c4LeafSz) + 1 : 1;
+    TArrayJanitor<TSHA256Hash> janLeaves(c4LeafCnt);
+    TSHA256Hash* const pmhashLeaves = janLeaves.paThis();
+
+    tCIDLib::TCard4 c4ThreadCnt = c4MaxThreads ? c4MaxThreads : TSysInfo::c4CPUCount();
+    if (c4ThreadCnt > c4LeafCnt / CIDCrypto_SHA256::c4MinThreadLeaves)
+        c4ThreadCnt = c4LeafCnt / CIDCrypto_SHA256::c4MinThreadLeaves;
+
+    if (c4ThreadCnt < 2)
+    {
+        CIDCrypto_SHA256::HashLeaves(pc1ToDigest, c4Bytes, 0, c4LeafCnt, pmhashLeaves);
+    }
+     else
+    {
+        TRefVector<TThread> colThreads(tCIDLib::EAdoptOpts::Adopt, c4ThreadCnt);
+        TObjArray<CIDCrypto_SHA256::TTreeSeg> objaSegs(c4ThreadCnt);
+
+        // Spread the leaves out, with any extras going one each to the first ones
+        const tCIDLib::TCard4 c4PerThread = c4LeafCnt / c4ThreadCnt;
+        const tCIDLib::TCard4 c4Extras = c4LeafCnt % c4ThreadCnt;
+        tCIDLib::TCard4 c4NextLeaf = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThreadCnt; c4Index++)
+        {
+            CIDCrypto_SHA256::TTreeSeg& segCur = objaSegs[c4Index];
+            segCur.pc1Data = pc1ToDigest;
+            segCur.c4DataSz = c4Bytes;
+            segCur.c4FirstLeaf = c4NextLeaf;
+            segCur.c4LeafCnt = c4PerThread + ((c4Index < c4Extras) ? 1 : 0);
+            segCur.pmhashLeaves = pmhashLeaves;
+            c4NextLeaf += segCur.c4LeafCnt;
+
+            colThreads.Add
+            (
+                new TThread
+                (
+                    facCIDLib().strNextThreadName(TString(L"SHA256Tree"))
+                    , CIDCrypto_SHA256::eTreeSegThread
+                )
+            );
+            colThreads[c4Index]->Start(&segCur);
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThreadCnt; c4Index++)
+            colThreads[c4Index]->eWaitForDeath();
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ThreadCnt; c4Index++)
+        {
+            CIDCrypto_SHA256::TTreeSeg& segCur = objaSegs[c4Index];
+            if (segCur.bFailed)
+            {
+                segCur.errFailure.AddStackLevel(CID_FILE, CID_LINE);
+                throw segCur.errFailure;
+            }
+        }
+    }
+
+    //
+    //  Now combine them in place, level by level. Each level's hashes go into
+    //  the front of the list.
+    //
+    TSHA256Hasher mdigHash;
+    tCIDLib::TCard4 c4LevelCnt = c4LeafCnt;
+    while (c4LevelCnt > 1)
+    {
+        const tCIDLib::TCard4 c4Pairs = c4LevelCnt / 2;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Pairs; c4Index++)
+        {
+            mdigHash.StartNew();
+            mdigHash.DigestRaw(&CIDCrypto_SHA256::c1NodePref, 1);
+            mdigHash.DigestRaw(pmhashLeaves[c4Index * 2].pc1Buffer(), c4HashBytes);
+            mdigHash.DigestRaw(pmhashLeaves[(c4Index * 2) + 1].pc1Buffer(), c4HashBytes);
+            mdigHash.Complete(pmhashLeaves[c4Index]);
+        }
+
+        if (c4LevelCnt & 1)
+        {
+            pmhashLeaves[c4Pairs] = pmhashLeaves[c4LevelCnt - 1];
+            c4LevelCnt = c4Pairs + 1;
+        }
+         else
+        {
+            c4LevelCnt = c4Pairs;
+        }
+    }
+
+    // And do the final hash, with the root and the length
+    tCIDLib::TCard1 ac1Len[8];
+    tCIDLib::TCard8 c8Len = c4Bytes;
+    for (tCIDLib::TCard4 c4Index = 8; c4Index > 0; c4Index--)
+    {
+        ac1Len[c4Index - 1] = tCIDLib::TCard1(c8Len & 0xFF);
+        c8Len >>= 8;
+    }
+
+    mdigHash.StartNew();
+    mdigHash.DigestRaw(&CIDCrypto_SHA256::c1RootPref, 1);
+    mdigHash.DigestRaw(pmhashLeaves[0].pc1Buffer(), c4HashBytes);
+    mdigHash.DigestRaw(ac1Len, 8);
+    mdigHash.Complete(mhashToFill);
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  TSHA256Hasher: Public, non-virtual methods
 // ---------------------------------------------------------------------------
@@ -181,29 +499,24 @@ TSHA256Hasher::DigestRaw( const   tCIDLib::TCard1* const  pc1ToDigest
             return;
 
         // We got a full block so process and it and reset the partial count
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
         m_c4PartialCnt = 0;
     }
 
-    // And now process the remaining full blocks
-    while (c4Index < c4Bytes)
+    //
+    //  And now process the remaining full blocks. We do them all in one shot,
+    //  so that the accelerated version can keep the state in registers across
+    //  blocks.
+    //
+    const tCIDLib::TCard4 c4Full = (c4Bytes - c4Index) / kCIDCrypto::c4SHA256BlockSize;
+    if (c4Full)
     {
-        //
-        //  We process a block of bytes at a time, so see if we have that many left
-        //  If not, we have to pad a block at the end, so break out.
-        //
-        if (c4Index + kCIDCrypto::c4SHA256BlockSize > c4Bytes)
-            break;
-
-        // We can do another whole block
-        ProcessMsgBlock(pc1Cur);
-
-        // Move forward now by a whole block
-        pc1Cur += kCIDCrypto::c4SHA256BlockSize;
-        c4Index += kCIDCrypto::c4SHA256BlockSize;
+        ProcessMsgBlocks(pc1Cur, c4Full);
 
-        // Bump the count of bytes we've processed so far
-        m_c4ByteCnt += kCIDCrypto::c4SHA256BlockSize;
+        const tCIDLib::TCard4 c4FullBytes = c4Full * kCIDCrypto::c4SHA256BlockSize;
+        pc1Cur += c4FullBytes;
+        c4Index += c4FullBytes;
+        m_c4ByteCnt += c4FullBytes;
     }
 
     //
@@ -246,7 +559,7 @@ TSHA256Hasher::DigestSrc(TBinInStream& strmSrc, const tCIDLib::TCard4 c4Bytes)
             return;
 
         // We got a full block so process and it and reset the partial count
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
         m_c4PartialCnt = 0;
     }
 
@@ -265,7 +578,7 @@ TSHA256Hasher::DigestSrc(TBinInStream& strmSrc, const tCIDLib::TCard4 c4Bytes)
         //  as a temp since we know we have flushed out any partial at this point.
         //
         strmSrc.c4ReadRawBuffer(m_ac1Partial, kCIDCrypto::c4SHA256BlockSize);
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
 
         // Move forward now by a whole block
         c4Index += 64;
@@ -301,14 +614,7 @@ tCIDLib::TVoid TSHA256Hasher::StartNew()
 // Preps us for another round of hashing
 tCIDLib::TVoid TSHA256Hasher::InitContext()
 {
-    m_ac4H[0] = 0x6a09e667;
-    m_ac4H[1] = 0xbb67ae85;
-    m_ac4H[2] = 0x3c6ef372;
-    m_ac4H[3] = 0xa54ff53a;
-    m_ac4H[4] = 0x510e527f;
-    m_ac4H[5] = 0x9b05688c;
-    m_ac4H[6] = 0x1f83d9ab;
-    m_ac4H[7] = 0x5be0cd19;
+    TRawMem::CopyMemBuf(m_ac4H, CIDCrypto_SHA256::ac4InitState, sizeof(m_ac4H));
 
     m_c4PartialCnt = 0;
     m_c4ByteCnt = 0;
@@ -332,7 +638,7 @@ tCIDLib::TVoid TSHA256Hasher::PadMsg()
         m_ac1Partial[c4Index++] = 0x80;
         while(c4Index < kCIDCrypto::c4SHA256BlockSize)
             m_ac1Partial[c4Index++] = 0;
-        ProcessMsgBlock(m_ac1Partial);
+        ProcessMsgBlocks(m_ac1Partial, 1);
 
         // Fill up another up to the point where we put in the length
         c4Index = 0;
@@ -363,7 +669,7 @@ tCIDLib::TVoid TSHA256Hasher::PadMsg()
     m_ac1Partial[63] = tCIDLib::TCard1((c4BitCnt ) & 0xFF);
 
     // And spit out this last one
-    ProcessMsgBlock(m_ac1Partial);
+    ProcessMsgBlocks(m_ac1Partial, 1);
     m_c4PartialCnt = 0;
 }
 
@@ -397,7 +703,7 @@ tCIDLib::TVoid TSHA256Hasher::ProcessMsgBlock(const tCIDLib::TCard1* const pc1Bl
     for (tCIDLib::TCard4 c4Ind = 0; c4Ind < kCIDCrypto::c4SHA256BlockSize; c4Ind++)
     {
         const tCIDLib::TCard4 c4T1 = ac4WV[7] + SHA256_F2(ac4WV[4]) + SHA2_CH(ac4WV[4], ac4WV[5], ac4WV[6])
-                               + ac4K[c4Ind] + ac4W[c4Ind];
+                               + kCIDCrypto_::ac4SHA256K[c4Ind] + ac4W[c4Ind];
         const tCIDLib::TCard4 c4T2 = SHA256_F1(ac4WV[0]) + SHA2_MAJ(ac4WV[0], ac4WV[1], ac4WV[2]);
         ac4WV[7] = ac4WV[6];
         ac4WV[6] = ac4WV[5];
@@ -414,6 +720,29 @@ tCIDLib::TVoid TSHA256Hasher::ProcessMsgBlock(const tCIDLib::TCard1* const pc1Bl
 }
 
 
+//
+//  Handles a run of full blocks. If we have the SHA extensions we pass them all
+//  to the accelerated version, else we just do them one at a time.
+//
+tCIDLib::TVoid
+TSHA256Hasher::ProcessMsgBlocks(const   tCIDLib::TCard1* const  pc1Blocks
+                                , const tCIDLib::TCard4         c4Count)
+{
+    if (m_bHWAccel)
+    {
+        TCryptoHWAccel::SHA256Blocks(m_ac4H, pc1Blocks, c4Count);
+        return;
+    }
+
+    const tCIDLib::TCard1* pc1Cur = pc1Blocks;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        ProcessMsgBlock(pc1Cur);
+        pc1Cur += kCIDCrypto::c4SHA256BlockSize;
+    }
+}
+
+
 // Clean ou the context info for discretion
 tCIDLib::TVoid TSHA256Hasher::ScrubContext()
 {
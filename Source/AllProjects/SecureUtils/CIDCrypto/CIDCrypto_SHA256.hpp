@@ -40,15 +40,35 @@ class CIDCRYPTEXP TSHA256Hasher : public THashDigest
         // -------------------------------------------------------------------
         TSHA256Hasher();
 
-        TSHA256Hasher(const TSHA256Hasher&) = delete;
+        TSHA256Hasher(const TSHA256Hasher&) = default;
 
         ~TSHA256Hasher();
 
 
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TVoid DigestMulti
+        (
+            const   tCIDLib::TCard1* const* const   apc1Msgs
+            , const tCIDLib::TCard4* const          ac4Bytes
+            ,       TSHA256Hash* const              amhashToFill
+            , const tCIDLib::TCard4                 c4Count
+        );
+
+        static tCIDLib::TVoid TreeHash
+        (
+            const   tCIDLib::TCard1* const  pc1ToDigest
+            , const tCIDLib::TCard4         c4Bytes
+            ,       TSHA256Hash&            mhashToFill
+            , const tCIDLib::TCard4         c4MaxThreads = 0
+        );
+
+
         // -------------------------------------------------------------------
         //  Public operators
         // -------------------------------------------------------------------
-        TSHA256Hasher& operator=(const TSHA256Hasher&) = delete;
+        TSHA256Hasher& operator=(const TSHA256Hasher&) = default;
 
 
         // -------------------------------------------------------------------
@@ -93,6 +113,12 @@ class CIDCRYPTEXP TSHA256Hasher : public THashDigest
             const   tCIDLib::TCard1* const  pc1Block
         );
 
+        tCIDLib::TVoid ProcessMsgBlocks
+        (
+            const   tCIDLib::TCard1* const  pc1Blocks
+            , const tCIDLib::TCard4         c4Count
+        );
+
         tCIDLib::TVoid ScrubContext();
 
 
@@ -108,6 +134,10 @@ class CIDCRYPTEXP TSHA256Hasher : public THashDigest
         //  m_ac4H
         //      Storage for our digest buffers
         //
+        //  m_bHWAccel
+        //      Set if the CPU has the SHA extensions, in which case we use them
+        //      for the compression function instead of the portable code.
+        //
         //  m_c4ByteCnt
         //      The total count of input bytes so far added to the actual hash. Doesn't
         //      include any partial block not yet added.
@@ -116,10 +146,11 @@ class CIDCRYPTEXP TSHA256Hasher : public THashDigest
         //      Used to track partial buffers so that we can pick up where we left
         //      off next time, and to pad the final block if it is not complete.
         // -------------------------------------------------------------------
-        tCIDLib::TCard1 m_ac1Partial[kCIDCrypto::c4SHA256HashBytes * 2];
-        tCIDLib::TCard4 m_ac4H[c4BufCnt];
-        tCIDLib::TCard4 m_c4ByteCnt;
-        tCIDLib::TCard4 m_c4PartialCnt;
+        tCIDLib::TCard1   m_ac1Partial[kCIDCrypto::c4SHA256HashBytes * 2];
+        tCIDLib::TCard4   m_ac4H[c4BufCnt];
+        tCIDLib::TBoolean m_bHWAccel;
+        tCIDLib::TCard4   m_c4ByteCnt;
+        tCIDLib::TCard4   m_c4PartialCnt;
 
 
         // -------------------------------------------------------------------
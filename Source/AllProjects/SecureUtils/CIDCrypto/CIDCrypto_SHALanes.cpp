@@ -0,0 +1,296 @@
+//
+// FILE NAME: CIDCrypto_SHALanes.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the multi-message SHA hashing helper. See the header
+//  for details.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The lanes function always does all of the lanes. If we run out of
+//      messages, the idle lanes just follow along on an active lane's data
+//      and their results are thrown away.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Facility specific includes
+// ---------------------------------------------------------------------------
+#include    "CIDCrypto_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CIDCrypto_SHALanes
+    {
+        constexpr tCIDLib::TCard4   c4BlockSz = 64;
+        constexpr tCIDLib::TCard4   c4MaxWords = 8;
+
+        // The most sections a message can have, head, full blocks, and tail
+        constexpr tCIDLib::TCard4   c4MaxSects = 3;
+
+
+        //
+        //  The per-lane info. Each message is done as a list of sections. If
+        //  there is a prefix byte, the first block has to be built here, since
+        //  it's the prefix plus the start of the message. Then come the full
+        //  blocks, taken directly from the caller's buffer, then one or two
+        //  padded tail blocks that we build here.
+        //
+        struct TLane
+        {
+            tCIDLib::TBoolean       bActive = kCIDLib::False;
+            tCIDLib::TCard4         c4MsgIndex = 0;
+            tCIDLib::TCard4         c4BlocksLeft = 0;
+            tCIDLib::TCard4         c4SectInd = 0;
+            tCIDLib::TCard4         c4SectCnt = 0;
+            const tCIDLib::TCard1*  pc1Cur = nullptr;
+            const tCIDLib::TCard1*  apc1Sects[c4MaxSects];
+            tCIDLib::TCard4         ac4SectBlocks[c4MaxSects];
+            tCIDLib::TCard1         ac1Head[c4BlockSz];
+            tCIDLib::TCard1         ac1Tail[c4BlockSz * 2];
+        };
+
+
+        //
+        //  Set up a lane for a new message. We build the head and tail blocks
+        //  now, so that they are ready to go when the lane gets to them.
+        //
+        tCIDLib::TVoid LoadLane(        TLane&                  laneTar
+                                , const tCIDLib::TCard4         c4LaneInd
+                                , const tCIDLib::TCard4         c4MsgIndex
+                                , const tCIDLib::TCard1* const  pc1Msg
+                                , const tCIDLib::TCard4         c4Bytes
+                                , const tCIDLib::TCard1* const  pc1Prefix
+                                , const tCIDLib::TCard4* const  pc4InitState
+                                , const tCIDLib::TCard4         c4StateWords
+                                ,       tCIDLib::TCard4* const  pc4States)
+        {
+            // Everything is in terms of the prefix plus the message
+            const tCIDLib::TCard4 c4PrefLen = pc1Prefix ? 1 : 0;
+            const tCIDLib::TCard4 c4Total = c4Bytes + c4PrefLen;
+            const tCIDLib::TCard4 c4Full = c4Total / c4BlockSz;
+            const tCIDLib::TCard4 c4Extra = c4Total - (c4Full * c4BlockSz);
+
+            laneTar.bActive = kCIDLib::True;
+            laneTar.c4MsgIndex = c4MsgIndex;
+            laneTar.c4SectCnt = 0;
+
+            // If there are any full blocks, set them up, building the head if needed
+            if (c4Full)
+            {
+                if (c4PrefLen)
+                {
+                    laneTar.ac1Head[0] = *pc1Prefix;
+                    TRawMem::CopyMemBuf(laneTar.ac1Head + 1, pc1Msg, c4BlockSz - 1);
+                    laneTar.apc1Sects[laneTar.c4SectCnt] = laneTar.ac1Head;
+                    laneTar.ac4SectBlocks[laneTar.c4SectCnt++] = 1;
+
+                    if (c4Full > 1)
+                    {
+                        laneTar.apc1Sects[laneTar.c4SectCnt] = pc1Msg + (c4BlockSz - 1);
+                        laneTar.ac4SectBlocks[laneTar.c4SectCnt++] = c4Full - 1;
+                    }
+                }
+                 else
+                {
+                    laneTar.apc1Sects[laneTar.c4SectCnt] = pc1Msg;
+                    laneTar.ac4SectBlocks[laneTar.c4SectCnt++] = c4Full;
+                }
+            }
+
+            //
+            //  And the tail. If there are no full blocks, the prefix has to go
+            //  into the tail.
+            //
+            const tCIDLib::TCard4 c4TailBlocks = (c4Extra + 9 > c4BlockSz) ? 2 : 1;
+            TRawMem::SetMemBuf(laneTar.ac1Tail, tCIDLib::TCard1(0), c4BlockSz * 2);
+            if (!c4Full && c4PrefLen)
+            {
+                laneTar.ac1Tail[0] = *pc1Prefix;
+                if (c4Bytes)
+                    TRawMem::CopyMemBuf(laneTar.ac1Tail + 1, pc1Msg, c4Bytes);
+            }
+             else if (c4Extra)
+            {
+                TRawMem::CopyMemBuf
+                (
+                    laneTar.ac1Tail, pc1Msg + ((c4Full * c4BlockSz) - c4PrefLen), c4Extra
+                );
+            }
+            laneTar.ac1Tail[c4Extra] = 0x80;
+
+            // The bit length goes in the last 8 bytes, big endian
+            tCIDLib::TCard8 c8Bits = tCIDLib::TCard8(c4Total) * 8;
+            tCIDLib::TCard4 c4LenOfs = (c4TailBlocks * c4BlockSz);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+            {
+                laneTar.ac1Tail[--c4LenOfs] = tCIDLib::TCard1(c8Bits);
+                c8Bits >>= 8;
+            }
+            laneTar.apc1Sects[laneTar.c4SectCnt] = laneTar.ac1Tail;
+            laneTar.ac4SectBlocks[laneTar.c4SectCnt++] = c4TailBlocks;
+
+            // And start on the first section
+            laneTar.c4SectInd = 0;
+            laneTar.pc1Cur = laneTar.apc1Sects[0];
+            laneTar.c4BlocksLeft = laneTar.ac4SectBlocks[0];
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4StateWords; c4Index++)
+                pc4States[(c4Index * kCIDCrypto_::c4SHALanes) + c4LaneInd] = pc4InitState[c4Index];
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TCryptoSHALanes: Public functions
+// ---------------------------------------------------------------------------
+tCIDLib::TVoid
+TCryptoSHALanes::HashMsgs(  const   TLanesFunc                      pfnLanes
+                            , const tCIDLib::TCard4* const          pc4InitState
+                            , const tCIDLib::TCard4                 c4StateWords
+                            , const tCIDLib::TCard1* const* const   apc1Msgs
+                            , const tCIDLib::TCard4* const          ac4Bytes
+                            , const tCIDLib::TCard4                 c4Count
+                            ,       tCIDLib::TCard1* const          pc1Hashes
+                            , const tCIDLib::TCard1* const          pc1Prefix)
+{
+    constexpr tCIDLib::TCard4 c4Lanes = kCIDCrypto_::c4SHALanes;
+    CIDAssert(c4StateWords <= CIDCrypto_SHALanes::c4MaxWords, L"Too many SHA state words");
+
+    CIDCrypto_SHALanes::TLane aLanes[c4Lanes];
+    tCIDLib::TCard4 ac4States[CIDCrypto_SHALanes::c4MaxWords * c4Lanes] = {0};
+    const tCIDLib::TCard1* apc1Data[c4Lanes];
+
+    // Load up as many lanes as we can
+    tCIDLib::TCard4 c4NextMsg = 0;
+    tCIDLib::TCard4 c4ActiveCnt = 0;
+    for (tCIDLib::TCard4 c4LaneInd = 0; c4LaneInd < c4Lanes; c4LaneInd++)
+    {
+        if (c4NextMsg == c4Count)
+            break;
+
+        CIDCrypto_SHALanes::LoadLane
+        (
+            aLanes[c4LaneInd]
+            , c4LaneInd
+            , c4NextMsg
+            , apc1Msgs[c4NextMsg]
+            , ac4Bytes[c4NextMsg]
+            , pc1Prefix
+            , pc4InitState
+            , c4StateWords
+            , ac4States
+        );
+        c4NextMsg++;
+        c4ActiveCnt++;
+    }
+
+    while (c4ActiveCnt)
+    {
+        //
+        //  Find the number of blocks we can do before some lane has to switch
+        //  to its tail or finish. And find an active lane for any idle ones to
+        //  follow along on.
+        //
+        tCIDLib::TCard4 c4Run = kCIDLib::c4MaxCard;
+        const tCIDLib::TCard1* pc1Follow = nullptr;
+        for (tCIDLib::TCard4 c4LaneInd = 0; c4LaneInd < c4Lanes; c4LaneInd++)
+        {
+            const CIDCrypto_SHALanes::TLane& laneCur = aLanes[c4LaneInd];
+            if (laneCur.bActive)
+            {
+                if (laneCur.c4BlocksLeft < c4Run)
+                {
+                    c4Run = laneCur.c4BlocksLeft;
+                    pc1Follow = laneCur.pc1Cur;
+                }
+            }
+        }
+
+        for (tCIDLib::TCard4 c4LaneInd = 0; c4LaneInd < c4Lanes; c4LaneInd++)
+        {
+            const CIDCrypto_SHALanes::TLane& laneCur = aLanes[c4LaneInd];
+            apc1Data[c4LaneInd] = laneCur.bActive ? laneCur.pc1Cur : pc1Follow;
+        }
+
+        pfnLanes(ac4States, apc1Data, c4Run);
+
+        // Move the lanes forward and handle any that hit the end of a section
+        for (tCIDLib::TCard4 c4LaneInd = 0; c4LaneInd < c4Lanes; c4LaneInd++)
+        {
+            CIDCrypto_SHALanes::TLane& laneCur = aLanes[c4LaneInd];
+            if (!laneCur.bActive)
+                continue;
+
+            laneCur.pc1Cur = apc1Data[c4LaneInd];
+            laneCur.c4BlocksLeft -= c4Run;
+            if (laneCur.c4BlocksLeft)
+                continue;
+
+            // If there's another section, move up to it
+            if (++laneCur.c4SectInd < laneCur.c4SectCnt)
+            {
+                laneCur.pc1Cur = laneCur.apc1Sects[laneCur.c4SectInd];
+                laneCur.c4BlocksLeft = laneCur.ac4SectBlocks[laneCur.c4SectInd];
+                continue;
+            }
+
+            // This one is done, so store the hash bytes
+            tCIDLib::TCard1* pc1Out = pc1Hashes + (laneCur.c4MsgIndex * c4StateWords * 4);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4StateWords; c4Index++)
+            {
+                const tCIDLib::TCard4 c4Val = ac4States[(c4Index * c4Lanes) + c4LaneInd];
+                *pc1Out++ = tCIDLib::TCard1(c4Val >> 24);
+                *pc1Out++ = tCIDLib::TCard1(c4Val >> 16);
+                *pc1Out++ = tCIDLib::TCard1(c4Val >> 8);
+                *pc1Out++ = tCIDLib::TCard1(c4Val);
+            }
+
+            // And load the next message, or go idle if no more
+            if (c4NextMsg < c4Count)
+            {
+                CIDCrypto_SHALanes::LoadLane
+                (
+                    laneCur
+                    , c4LaneInd
+                    , c4NextMsg
+                    , apc1Msgs[c4NextMsg]
+                    , ac4Bytes[c4NextMsg]
+                    , pc1Prefix
+                    , pc4InitState
+                    , c4StateWords
+                    , ac4States
+                );
+                c4NextMsg++;
+            }
+             else
+            {
+                laneCur.bActive = kCIDLib::False;
+                c4ActiveCnt--;
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+//
+// FILE NAME: CIDCrypto_SHALanes_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the internal header for the CIDCrypto_SHALanes.cpp file. This file
+//  handles hashing a list of independent messages using the multi-lane SHA
+//  compression functions. It keeps all of the lanes busy, padding out each
+//  message as it gets to the end, and loading up the next waiting message
+//  into that lane.
+//
+//  SHA-1 and SHA-256 use the same block size and padding, so the caller just
+//  passes the lanes function, the initial state, and the number of state
+//  words. The results are the final state words for each message, stored as
+//  big endian bytes, i.e. the actual hash bytes.
+//
+//  The caller can optionally pass a prefix byte that is hashed in front of
+//  every message, as the SHA-256 tree hash does for its leaves. That lets us
+//  still take the message bytes directly from the caller's buffers.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+namespace TCryptoSHALanes
+{
+    using TLanesFunc = tCIDLib::TVoid (*)
+    (
+                tCIDLib::TCard4* const  pc4States
+        , const tCIDLib::TCard1** const apc1Data
+        , const tCIDLib::TCard4         c4Blocks
+    );
+
+    tCIDLib::TVoid HashMsgs
+    (
+        const   TLanesFunc                      pfnLanes
+        , const tCIDLib::TCard4* const          pc4InitState
+        , const tCIDLib::TCard4                 c4StateWords
+        , const tCIDLib::TCard1* const* const   apc1Msgs
+        , const tCIDLib::TCard4* const          ac4Bytes
+        , const tCIDLib::TCard4                 c4Count
+        ,       tCIDLib::TCard1* const          pc1Hashes
+        , const tCIDLib::TCard1* const          pc1Prefix = nullptr
+    );
+}
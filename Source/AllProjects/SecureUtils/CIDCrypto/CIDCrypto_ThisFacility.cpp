@@ -59,6 +59,7 @@ TFacCIDCrypto::TFacCIDCrypto() :
         , kCIDLib::c4Revision
         , tCIDLib::EModFlags::HasMsgFile
     )
+    , m_bHWAccel(kCIDLib::True)
     , m_prandGen(new TRandomNum)
 {
     // Seed our random number generator
@@ -82,6 +83,22 @@ TFacCIDCrypto::~TFacCIDCrypto()
 //  TFacCIDCrypto: Public, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  Get or set whether the hardware accelerated paths can be used. The CPU has to
+//  support them as well, this just lets them be turned off.
+//
+tCIDLib::TBoolean TFacCIDCrypto::bHWAccel() const
+{
+    return m_bHWAccel;
+}
+
+tCIDLib::TBoolean TFacCIDCrypto::bHWAccel(const tCIDLib::TBoolean bToSet)
+{
+    m_bHWAccel = bToSet;
+    return m_bHWAccel;
+}
+
+
 //
 //  Get a random number, optionally requiring it to be non-zero. We have one for 32
 //  and one for 64 bit values. The latter we have to build up from two 32s.
@@ -63,6 +63,13 @@ class CIDCRYPTEXP TFacCIDCrypto : public TFacility
         // -------------------------------------------------------------------
         //  Public, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bHWAccel() const;
+
+        tCIDLib::TBoolean bHWAccel
+        (
+            const   tCIDLib::TBoolean       bToSet
+        );
+
         tCIDLib::TCard4 c4GetRandom
         (
             const   tCIDLib::TBoolean       bNonZero = kCIDLib::True
@@ -110,6 +117,13 @@ class CIDCRYPTEXP TFacCIDCrypto : public TFacility
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_bHWAccel
+        //      Defaults to true, which lets the algorithms use the CPU's crypto
+        //      instructions when it has them. If cleared, they use the software
+        //      versions. It's checked when hashers are created and when block
+        //      encrypters are keyed, so it doesn't affect existing ones. This is
+        //      mostly so that tests can check and time both paths.
+        //
         //  m_mtxSync
         //      We have to protect the random number generator against multiple thread
         //      usage which may well happen.
@@ -119,8 +133,9 @@ class CIDCRYPTEXP TFacCIDCrypto : public TFacility
         //      methods to generate them. Make it a pointer since we can then avoid
         //      pushing CIDMath on anyone who uses this facility.
         // -------------------------------------------------------------------
-        TMutex      m_mtxSync;
-        TRandomNum* m_prandGen;
+        tCIDLib::TBoolean   m_bHWAccel;
+        TMutex              m_mtxSync;
+        TRandomNum*         m_prandGen;
 
 
         // -------------------------------------------------------------------
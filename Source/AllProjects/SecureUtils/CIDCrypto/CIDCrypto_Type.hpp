@@ -30,7 +30,13 @@
 namespace tCIDCrypto
 {
     // -----------------------------------------------------------------------
-    //  The standard block cypher modes
+    //  The standard block cypher modes.
+    //
+    //  CTR and GCM are stream style modes (the output is the same size as the
+    //  input, no padding), and every block can be done independently, so they
+    //  are the ones to use for bulk data. GCM also authenticates the data, by
+    //  appending a tag to the cypher text, so it's the only one that can tell
+    //  you if the data was modified. Both only support 16 byte block cyphers.
     // -----------------------------------------------------------------------
     enum class EBlockModes
     {
@@ -38,9 +44,11 @@ namespace tCIDCrypto
         , CBC
         , CBC_IV
         , OFB
+        , CTR
+        , GCM
 
         , Count
         , Min           = ECB
-        , Max           = OFB
+        , Max           = GCM
     };
 }
@@ -0,0 +1,111 @@
+//
+// FILE NAME: TestCIDImage.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main implementation file of the test program.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "TestCIDImage.hpp"
+
+
+// ----------------------------------------------------------------------------
+//  Magic macros
+// ----------------------------------------------------------------------------
+RTTIDecls(TImageTestApp,TTestFWApp)
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TImageTestApp
+// PREFIX: tfwapp
+// ---------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TImageTestApp: Constructor and Destructor
+// ----------------------------------------------------------------------------
+TImageTestApp::TImageTestApp()
+{
+}
+
+TImageTestApp::~TImageTestApp()
+{
+}
+
+
+// ----------------------------------------------------------------------------
+//  TImageTestApp: Public, inherited methods
+// ----------------------------------------------------------------------------
+tCIDLib::TBoolean TImageTestApp::bInitialize(TString&)
+{
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TImageTestApp::LoadTests()
+{
+    // Load up our tests on our parent class
+    AddTest(new TTest_Blur);
+    AddTest(new TTest_JPEGScale);
+    AddTest(new TTest_PNGFilters);
+    AddTest(new TTest_PNGRoundTrip);
+    AddTest(new TTest_ScaleAlpha);
+}
+
+tCIDLib::TVoid TImageTestApp::PostTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TImageTestApp::PreTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TImageTestApp::Terminate()
+{
+    // Nothing to do
+}
+
+
+
+// ----------------------------------------------------------------------------
+//  Declare the test app object
+// ----------------------------------------------------------------------------
+TImageTestApp   tfwappImage;
+
+
+
+// ----------------------------------------------------------------------------
+//  Include magic main module code. We just point it at the test thread
+//  entry point of the test framework app class.
+// ----------------------------------------------------------------------------
+CIDLib_MainModule
+(
+    TThread
+    (
+        L"TestThread"
+        , TMemberFunc<TImageTestApp>(&tfwappImage, &TImageTestApp::eTestThread)
+    )
+)
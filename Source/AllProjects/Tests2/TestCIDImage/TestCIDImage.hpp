@@ -0,0 +1,321 @@
+//
+// FILE NAME: TestCIDImage.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main header file of the CIDImage tests. We just declare all of
+//  the tests here.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "CIDImage.hpp"
+#include    "CIDJPEG.hpp"
+#include    "CIDPNG.hpp"
+#include    "CIDZLib.hpp"
+#include    "TestFWLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Blur
+// PREFIX: tfwt
+//
+//  Tests the gaussian blur against a simple per-pixel version, for each
+//  format it supports and each order.
+// ---------------------------------------------------------------------------
+class TTest_Blur : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Blur();
+
+        TTest_Blur(const TTest_Blur&) = delete;
+        TTest_Blur(TTest_Blur&&) = delete;
+
+        ~TTest_Blur();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTestBlur
+        (
+                    TTextOutStream&         strmOut
+            , const tCIDImage::EPixFmts     eFmt
+            , const tCIDImage::EBitDepths   eDepth
+            , const tCIDLib::TCard4         c4CCnt
+            , const TSize&                  szImage
+            , const tCIDLib::TCard4         c4Order
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Blur,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_JPEGScale
+// PREFIX: tfwt
+//
+//  Decodes a known JPEG at each scale, into the image and to a row sink, and
+//  checks the sizes, that the two agree, and that an early stop is safe.
+// ---------------------------------------------------------------------------
+class TTest_JPEGScale : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_JPEGScale();
+
+        TTest_JPEGScale(const TTest_JPEGScale&) = delete;
+        TTest_JPEGScale(TTest_JPEGScale&&) = delete;
+
+        ~TTest_JPEGScale();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_JPEGScale,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PNGFilters
+// PREFIX: tfwt
+//
+//  Reads hand built PNG files that use every filter type, for each of the
+//  bytes per pixel sizes, and checks them against unfiltered versions.
+// ---------------------------------------------------------------------------
+class TTest_PNGFilters : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PNGFilters();
+
+        TTest_PNGFilters(const TTest_PNGFilters&) = delete;
+        TTest_PNGFilters(TTest_PNGFilters&&) = delete;
+
+        ~TTest_PNGFilters();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PNGFilters,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PNGRoundTrip
+// PREFIX: tfwt
+//
+//  Writes out and reads back PNGs of each format we can write, and checks the
+//  filters that were picked for each line.
+// ---------------------------------------------------------------------------
+class TTest_PNGRoundTrip : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PNGRoundTrip();
+
+        TTest_PNGRoundTrip(const TTest_PNGRoundTrip&) = delete;
+        TTest_PNGRoundTrip(TTest_PNGRoundTrip&&) = delete;
+
+        ~TTest_PNGRoundTrip();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PNGRoundTrip,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ScaleAlpha
+// PREFIX: tfwt
+//
+//  Tests the alpha ramp in each direction, for each format with alpha, with
+//  and without pre-multiply.
+// ---------------------------------------------------------------------------
+class TTest_ScaleAlpha : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_ScaleAlpha();
+
+        TTest_ScaleAlpha(const TTest_ScaleAlpha&) = delete;
+        TTest_ScaleAlpha(TTest_ScaleAlpha&&) = delete;
+
+        ~TTest_ScaleAlpha();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTestRamp
+        (
+                    TTextOutStream&         strmOut
+            , const tCIDImage::EPixFmts     eFmt
+            , const tCIDImage::EBitDepths   eDepth
+            , const tCIDLib::TCard4         c4CCnt
+            , const TSize&                  szImage
+            , const tCIDLib::EDirs          eDir
+            , const tCIDLib::TCard4         c4StartInd
+            , const tCIDLib::TCard4         c4EndInd
+            , const tCIDLib::TBoolean       bPremul
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_ScaleAlpha,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TImageTestApp
+// PREFIX: tfwapp
+//
+//  This is our implementation of the test framework's test program framework.
+//  We just create a derivative and override some methods.
+// ---------------------------------------------------------------------------
+class TImageTestApp : public TTestFWApp
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TImageTestApp();
+
+        TImageTestApp(const TImageTestApp&) = delete;
+        TImageTestApp(TImageTestApp&&) = delete;
+
+        ~TImageTestApp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bInitialize
+        (
+                    TString&                strErr
+        )   override;
+
+        tCIDLib::TVoid LoadTests() override;
+
+        tCIDLib::TVoid PostTest
+        (
+            const   TTestFWTest&            tfwtFinished
+        )   override;
+
+        tCIDLib::TVoid PreTest
+        (
+            const   TTestFWTest&            tfwtStarting
+        )   override;
+
+        tCIDLib::TVoid Terminate() override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TImageTestApp,TTestFWApp)
+};
+
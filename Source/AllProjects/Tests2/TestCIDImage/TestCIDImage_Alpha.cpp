@@ -0,0 +1,407 @@
+//
+// FILE NAME: TestCIDImage_Alpha.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the pixel array's alpha ramp (ScaleAlpha), in all four
+//  directions, for each format that has alpha, with and without pre-multiply.
+//  We check the shape of the ramp directly, and check the whole image against a
+//  simple per-pixel version.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDImage.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_ScaleAlpha,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDImage_Alpha
+    {
+        // -----------------------------------------------------------------------
+        //  The formats that have alpha, and the components per pixel of each.
+        //  The alpha is always the last one.
+        // -----------------------------------------------------------------------
+        struct TAlphaFmt
+        {
+            tCIDImage::EPixFmts     eFmt;
+            tCIDImage::EBitDepths   eDepth;
+            tCIDLib::TCard4         c4CCnt;
+        };
+        const TAlphaFmt afmtList[] =
+        {
+            { tCIDImage::EPixFmts::TrueAlpha, tCIDImage::EBitDepths::Eight, 4 }
+          , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Eight, 2 }
+          , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Sixteen, 2 }
+        };
+
+        const tCIDLib::EDirs aeDirs[] =
+        {
+            tCIDLib::EDirs::Left
+            , tCIDLib::EDirs::Right
+            , tCIDLib::EDirs::Down
+            , tCIDLib::EDirs::Up
+        };
+
+
+        // Get or set a component of a pixel array, 8 or 16 bit
+        tCIDLib::TCard4 c4CompAt(const  TPixelArray&        pixaSrc
+                                , const tCIDLib::TBoolean   b16
+                                , const tCIDLib::TCard4     c4Row
+                                , const tCIDLib::TCard4     c4Ind)
+        {
+            const tCIDLib::TCard1* pc1Row = pixaSrc.pc1RowPtr(c4Row);
+            if (b16)
+                return reinterpret_cast<const tCIDLib::TCard2*>(pc1Row)[c4Ind];
+            return pc1Row[c4Ind];
+        }
+
+        tCIDLib::TVoid PutComp(         TPixelArray&        pixaTar
+                                , const tCIDLib::TBoolean   b16
+                                , const tCIDLib::TCard4     c4Row
+                                , const tCIDLib::TCard4     c4Ind
+                                , const tCIDLib::TCard4     c4Val)
+        {
+            tCIDLib::TCard1* pc1Row = pixaTar.pc1RowPtr(c4Row);
+            if (b16)
+                reinterpret_cast<tCIDLib::TCard2*>(pc1Row)[c4Ind] = tCIDLib::TCard2(c4Val);
+            else
+                pc1Row[c4Ind] = tCIDLib::TCard1(c4Val);
+        }
+
+
+        //
+        //  Fill an image with pseudo-random component values, always the same
+        //  for a given image.
+        //
+        tCIDLib::TVoid FillImage(TPixelArray& pixaTar, const TAlphaFmt& fmtCur)
+        {
+            const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+            const tCIDLib::TCard4 c4RowComps = pixaTar.c4Width() * fmtCur.c4CCnt;
+            tCIDLib::TCard4 c4Seed = 0x13579BDF;
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaTar.c4Height(); c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowComps; c4Ind++)
+                {
+                    c4Seed = (c4Seed * 1103515245) + 12345;
+                    PutComp(pixaTar, b16, c4Row, c4Ind, c4Seed >> (b16 ? 16 : 24));
+                }
+            }
+        }
+
+
+        //
+        //  A simple per-pixel version of the ramp, to check the real one against.
+        //  We put the expected components into the passed buffer, a row after
+        //  another. The levels are calculated exactly as the pixel array does,
+        //  since a float difference could move a value by one.
+        //
+        tCIDLib::TVoid RefRamp( const   TPixelArray&            pixaSrc
+                                , const TAlphaFmt&              fmtCur
+                                , const tCIDLib::EDirs          eDir
+                                , const tCIDLib::TCard4         c4StartInd
+                                , const tCIDLib::TCard4         c4EndInd
+                                , const tCIDLib::TBoolean       bPremul
+                                ,       tCIDLib::TCard4* const  pc4Out)
+        {
+            const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+            const tCIDLib::TCard4 c4MaxAlpha = b16 ? 0xFFFF : 0xFF;
+            const tCIDLib::TCard4 c4CCnt = fmtCur.c4CCnt;
+            const tCIDLib::TCard4 c4Width = pixaSrc.c4Width();
+            const tCIDLib::TCard4 c4Height = pixaSrc.c4Height();
+            const tCIDLib::TCard4 c4RowComps = c4Width * c4CCnt;
+
+            const tCIDLib::TBoolean bHorz
+            (
+                (eDir == tCIDLib::EDirs::Left) || (eDir == tCIDLib::EDirs::Right)
+            );
+            const tCIDLib::TBoolean bReverse
+            (
+                (eDir == tCIDLib::EDirs::Left) || (eDir == tCIDLib::EDirs::Up)
+            );
+
+            const tCIDLib::TCard4 c4Count = c4EndInd - c4StartInd;
+            const tCIDLib::TCard4 c4First = bReverse ? c4StartInd + 1 : c4StartInd;
+
+            //
+            //  Get the alpha for each step along the ramp. The level goes up by
+            //  a fixed step, so do the same adds to get the same float value.
+            //
+            tCIDLib::TCard4* pc4Alphas = new tCIDLib::TCard4[c4Count];
+            TArrayJanitor<tCIDLib::TCard4> janAlphas(pc4Alphas);
+            {
+                const tCIDLib::TFloat4 f4IncPer = 1.57F / c4Count;
+                tCIDLib::TFloat4 f4CurRad = 0;
+                for (tCIDLib::TCard4 c4Step = 0; c4Step < c4Count; c4Step++)
+                {
+                    const tCIDLib::TFloat8 f8Level = 1.0 - TMathLib::f4Sine(f4CurRad);
+                    if (b16)
+                        pc4Alphas[c4Step] = tCIDLib::TCard2(f8Level * c4MaxAlpha);
+                    else
+                        pc4Alphas[c4Step] = tCIDLib::TCard1(f8Level * c4MaxAlpha);
+                    f4CurRad += f4IncPer;
+                }
+            }
+
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < c4Height; c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Col = 0; c4Col < c4Width; c4Col++)
+                {
+                    const tCIDLib::TCard4 c4Base = (c4Row * c4RowComps) + (c4Col * c4CCnt);
+                    for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
+                    {
+                        pc4Out[c4Base + c4CInd] = c4CompAt
+                        (
+                            pixaSrc, b16, c4Row, (c4Col * c4CCnt) + c4CInd
+                        );
+                    }
+
+                    // If not in the ramp, leave it alone
+                    const tCIDLib::TCard4 c4At = bHorz ? c4Col : c4Row;
+                    if ((c4At < c4First) || (c4At >= c4First + c4Count))
+                        continue;
+
+                    // For up and left, the first step is at the end
+                    tCIDLib::TCard4 c4Step = c4At - c4First;
+                    if (bReverse)
+                        c4Step = (c4Count - 1) - c4Step;
+                    const tCIDLib::TCard4 c4Alpha = pc4Alphas[c4Step];
+
+                    if (bPremul)
+                    {
+                        for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt - 1; c4CInd++)
+                            pc4Out[c4Base + c4CInd] = (pc4Out[c4Base + c4CInd] * c4Alpha) / c4MaxAlpha;
+                    }
+                    pc4Out[c4Base + c4CCnt - 1] = c4Alpha;
+                }
+            }
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ScaleAlpha
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_ScaleAlpha: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_ScaleAlpha::TTest_ScaleAlpha() :
+
+    TTestFWTest
+    (
+        L"Scale Alpha", L"Tests the alpha ramp in each direction and format", 3
+    )
+{
+}
+
+TTest_ScaleAlpha::~TTest_ScaleAlpha()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ScaleAlpha: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_ScaleAlpha::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  Check the shape of the ramp. Starting with full alpha, the line/col where
+    //  the ramp starts has to stay fully opaque, it has to drop off steadily
+    //  from there to nearly transparent, and nothing outside of it can change.
+    //  For up and left, it starts at the end index and goes back to just after
+    //  the start index.
+    //
+    for (const TestCIDImage_Alpha::TAlphaFmt& fmtCur : TestCIDImage_Alpha::afmtList)
+    {
+        const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+        const tCIDLib::TCard4 c4MaxAlpha = b16 ? 0xFFFF : 0xFF;
+        const tCIDLib::TCard4 c4AlphaInd = fmtCur.c4CCnt - 1;
+
+        for (const tCIDLib::EDirs eDir : TestCIDImage_Alpha::aeDirs)
+        {
+            const tCIDLib::TBoolean bHorz
+            (
+                (eDir == tCIDLib::EDirs::Left) || (eDir == tCIDLib::EDirs::Right)
+            );
+            const tCIDLib::TBoolean bReverse
+            (
+                (eDir == tCIDLib::EDirs::Left) || (eDir == tCIDLib::EDirs::Up)
+            );
+
+            TPixelArray pixaTest
+            (
+                fmtCur.eFmt, fmtCur.eDepth, tCIDImage::ERowOrders::TopDown, TSize(32, 32)
+            );
+            pixaTest.SetAll(0);
+            pixaTest.SetAllAlpha(c4MaxAlpha);
+            pixaTest.ScaleAlpha(eDir, 8, 24, kCIDLib::False);
+
+            // Get the alpha along the ramp direction, in the order it ramps
+            tCIDLib::TCard4 ac4Alphas[32];
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 32; c4Index++)
+            {
+                const tCIDLib::TCard4 c4At = bReverse ? 31 - c4Index : c4Index;
+                ac4Alphas[c4Index] = bHorz
+                    ? TestCIDImage_Alpha::c4CompAt(pixaTest, b16, 5, (c4At * fmtCur.c4CCnt) + c4AlphaInd)
+                    : TestCIDImage_Alpha::c4CompAt(pixaTest, b16, c4At, c4AlphaInd);
+            }
+
+            //
+            //  In ramp order, the ramp starts at 8 for down/right, and at 24 for
+            //  up/left, which is index 7 in the reversed list. Either way it's 16
+            //  lines/cols long.
+            //
+            const tCIDLib::TCard4 c4RampStart = bReverse ? 7 : 8;
+            const tCIDLib::TCard4 c4RampEnd = c4RampStart + 16;
+
+            tCIDLib::TBoolean bBadShape = kCIDLib::False;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 32; c4Index++)
+            {
+                if ((c4Index < c4RampStart) || (c4Index >= c4RampEnd))
+                {
+                    if (ac4Alphas[c4Index] != c4MaxAlpha)
+                        bBadShape = kCIDLib::True;
+                }
+                 else if (c4Index == c4RampStart)
+                {
+                    if (ac4Alphas[c4Index] != c4MaxAlpha)
+                        bBadShape = kCIDLib::True;
+                }
+                 else if (ac4Alphas[c4Index] >= ac4Alphas[c4Index - 1])
+                {
+                    bBadShape = kCIDLib::True;
+                }
+            }
+
+            if (ac4Alphas[c4RampEnd - 1] > c4MaxAlpha / 16)
+                bBadShape = kCIDLib::True;
+
+            if (bBadShape)
+            {
+                strmOut << TFWCurLn << L"Alpha ramp had the wrong shape. Fmt="
+                        << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                        << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L", Dir="
+                        << tCIDLib::c4EnumOrd(eDir) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    //
+    //  And against the per-pixel version, with and without pre-multiply. Do a
+    //  range inside the image, one that runs off the end, and one on an image
+    //  large enough to be split into bands.
+    //
+    for (const TestCIDImage_Alpha::TAlphaFmt& fmtCur : TestCIDImage_Alpha::afmtList)
+    {
+        for (const tCIDLib::EDirs eDir : TestCIDImage_Alpha::aeDirs)
+        {
+            for (tCIDLib::TCard4 c4Premul = 0; c4Premul < 2; c4Premul++)
+            {
+                const tCIDLib::TBoolean bPremul = c4Premul != 0;
+                if (!bTestRamp(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, TSize(41, 29), eDir, 3, 20, bPremul)
+                ||  !bTestRamp(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, TSize(41, 29), eDir, 10, 60, bPremul)
+                ||  !bTestRamp(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, TSize(640, 480), eDir, 0, 460, bPremul))
+                {
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+        }
+    }
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ScaleAlpha: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Ramps the alpha of a pseudo-random image of the indicated format and size, and
+//  checks it against the per-pixel version.
+//
+tCIDLib::TBoolean
+TTest_ScaleAlpha::bTestRamp(        TTextOutStream&         strmOut
+                            , const tCIDImage::EPixFmts     eFmt
+                            , const tCIDImage::EBitDepths   eDepth
+                            , const tCIDLib::TCard4         c4CCnt
+                            , const TSize&                  szImage
+                            , const tCIDLib::EDirs          eDir
+                            , const tCIDLib::TCard4         c4StartInd
+                            , const tCIDLib::TCard4         c4EndInd
+                            , const tCIDLib::TBoolean       bPremul)
+{
+    const TestCIDImage_Alpha::TAlphaFmt fmtCur = { eFmt, eDepth, c4CCnt };
+    const tCIDLib::TBoolean b16 = eDepth == tCIDImage::EBitDepths::Sixteen;
+
+    TPixelArray pixaTest(eFmt, eDepth, tCIDImage::ERowOrders::TopDown, szImage);
+    TestCIDImage_Alpha::FillImage(pixaTest, fmtCur);
+
+    const tCIDLib::TCard4 c4RowComps = szImage.c4Width() * c4CCnt;
+    tCIDLib::TCard4* pc4Exp = new tCIDLib::TCard4[c4RowComps * szImage.c4Height()];
+    TArrayJanitor<tCIDLib::TCard4> janExp(pc4Exp);
+    TestCIDImage_Alpha::RefRamp(pixaTest, fmtCur, eDir, c4StartInd, c4EndInd, bPremul, pc4Exp);
+
+    pixaTest.ScaleAlpha(eDir, c4StartInd, c4EndInd, bPremul);
+
+    tCIDLib::TCard4 c4Bad = 0;
+    for (tCIDLib::TCard4 c4Row = 0; c4Row < szImage.c4Height(); c4Row++)
+    {
+        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowComps; c4Ind++)
+        {
+            if (TestCIDImage_Alpha::c4CompAt(pixaTest, b16, c4Row, c4Ind)
+                                        != pc4Exp[(c4Row * c4RowComps) + c4Ind])
+            {
+                c4Bad++;
+            }
+        }
+    }
+
+    if (c4Bad)
+    {
+        strmOut << TFWCurLn << c4Bad << L" components were wrong. Fmt="
+                << tCIDLib::c4EnumOrd(eFmt) << L", Depth=" << tCIDLib::c4EnumOrd(eDepth)
+                << L", Size=" << szImage << L", Dir=" << tCIDLib::c4EnumOrd(eDir)
+                << L", Range=" << c4StartInd << L"-" << c4EndInd
+                << L", Premul=" << (bPremul ? L"Yes" : L"No") << L"\n\n";
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
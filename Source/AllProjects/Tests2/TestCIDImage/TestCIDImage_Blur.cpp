@@ -0,0 +1,406 @@
+//
+// FILE NAME: TestCIDImage_Blur.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the pixel array's gaussian blur. The real one works on whole
+//  rows at a time, split into bands on large images. We check it against a
+//  simple per-pixel version, for every format it supports and every order, and
+//  against a small hand worked case.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The per-pixel version has to do what the original did, which is to leave
+//      the outer pixels alone, treat horizontal taps off the image as zero, and
+//      skip vertical taps off the image.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDImage.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_Blur,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDImage_Blur
+    {
+        // -----------------------------------------------------------------------
+        //  The factors for each order, and the number of them, which have to
+        //  match what the pixel array uses.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4 c4MaxOrder = 12;
+        const tCIDLib::TCard4 ac4Factors[c4MaxOrder + 1][c4MaxOrder + 1] =
+        {
+            {   2,   4,   5,   5,   2,   0,   0,   0,   0,   0,   0,   0 }
+          , {   2,   8,  20,  32,  32,  20,   8,   2,   0,   0,   0,   0 }
+          , {   3,  13,  24,  36,  42,  42,  36,  24,  13,   3,   0,   0 }
+          , {   1,   2,   1,   0,   0,   0,   0,   0,   0,   0,   0,   0 }
+          , {   1,   3,   3,   1,   0,   0,   0,   0,   0,   0,   0,   0 }
+          , {   1,   4,   6,   4,   1,   0,   0,   0,   0,   0,   0,   0 }
+          , {   1,   5,  10,  10,   5,   1,   0,   0,   0,   0,   0,   0 }
+          , {   1,   6,  15,  20,  15,   6,   1,   0,   0,   0,   0,   0 }
+          , {   1,   7,  21,  35,  35,  21,   7,   1,   0,   0,   0,   0 }
+          , {   1,   8,  28,  56,  70,  56,  28,   8,   1,   0,   0,   0 }
+          , {   1,   9,  36,  84, 126, 126,  84,  36,   9,   1,   0,   0 }
+          , {   1,  10,  45, 120, 210, 252, 210, 120,  45,  10,   1,   0 }
+          , {   1,  11,  55, 165, 330, 462, 462, 330, 165,  55,  11,   1 }
+        };
+        const tCIDLib::TCard4 ac4Taps[c4MaxOrder + 1] =
+        {
+            5, 8, 10, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The formats the blur supports, and the components per pixel of each
+        // -----------------------------------------------------------------------
+        struct TBlurFmt
+        {
+            tCIDImage::EPixFmts     eFmt;
+            tCIDImage::EBitDepths   eDepth;
+            tCIDLib::TCard4         c4CCnt;
+        };
+        const TBlurFmt afmtList[] =
+        {
+            { tCIDImage::EPixFmts::TrueClr, tCIDImage::EBitDepths::Eight, 3 }
+          , { tCIDImage::EPixFmts::TrueAlpha, tCIDImage::EBitDepths::Eight, 4 }
+          , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Eight, 1 }
+          , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Eight, 2 }
+          , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Sixteen, 1 }
+          , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Sixteen, 2 }
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  A single full on pixel in the middle of a 5x5 image, blurred with
+        //  order 3 (1, 2, 1), worked out by hand, for 8 and 16 bit components.
+        // -----------------------------------------------------------------------
+        const tCIDLib::TCard4 ac4Known8[5][5] =
+        {
+            {   0,   0,   0,   0,   0 }
+          , {   0,  15,  31,  15,   0 }
+          , {   0,  31,  63,  31,   0 }
+          , {   0,  15,  31,  15,   0 }
+          , {   0,   0,   0,   0,   0 }
+        };
+        const tCIDLib::TCard4 ac4Known16[5][5] =
+        {
+            {   0,     0,     0,     0,  0 }
+          , {   0,  4095,  8191,  4095,  0 }
+          , {   0,  8191, 16383,  8191,  0 }
+          , {   0,  4095,  8191,  4095,  0 }
+          , {   0,     0,     0,     0,  0 }
+        };
+
+
+        // Get or set a component of a pixel array, 8 or 16 bit
+        tCIDLib::TCard4 c4CompAt(const  TPixelArray&        pixaSrc
+                                , const tCIDLib::TBoolean   b16
+                                , const tCIDLib::TCard4     c4Row
+                                , const tCIDLib::TCard4     c4Ind)
+        {
+            const tCIDLib::TCard1* pc1Row = pixaSrc.pc1RowPtr(c4Row);
+            if (b16)
+                return reinterpret_cast<const tCIDLib::TCard2*>(pc1Row)[c4Ind];
+            return pc1Row[c4Ind];
+        }
+
+        tCIDLib::TVoid PutComp(         TPixelArray&        pixaTar
+                                , const tCIDLib::TBoolean   b16
+                                , const tCIDLib::TCard4     c4Row
+                                , const tCIDLib::TCard4     c4Ind
+                                , const tCIDLib::TCard4     c4Val)
+        {
+            tCIDLib::TCard1* pc1Row = pixaTar.pc1RowPtr(c4Row);
+            if (b16)
+                reinterpret_cast<tCIDLib::TCard2*>(pc1Row)[c4Ind] = tCIDLib::TCard2(c4Val);
+            else
+                pc1Row[c4Ind] = tCIDLib::TCard1(c4Val);
+        }
+
+
+        //
+        //  Fill an image with pseudo-random component values, always the same
+        //  for a given image.
+        //
+        tCIDLib::TVoid FillImage(TPixelArray& pixaTar, const TBlurFmt& fmtCur)
+        {
+            const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+            const tCIDLib::TCard4 c4RowComps = pixaTar.c4Width() * fmtCur.c4CCnt;
+            tCIDLib::TCard4 c4Seed = 0x2468ACE1;
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaTar.c4Height(); c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowComps; c4Ind++)
+                {
+                    c4Seed = (c4Seed * 1103515245) + 12345;
+                    PutComp(pixaTar, b16, c4Row, c4Ind, c4Seed >> (b16 ? 16 : 24));
+                }
+            }
+        }
+
+
+        //
+        //  A simple per-pixel blur, to check the real one against. We put the
+        //  expected components into the passed buffer, a row after another.
+        //
+        tCIDLib::TVoid RefBlur( const   TPixelArray&            pixaSrc
+                                , const TBlurFmt&               fmtCur
+                                , const tCIDLib::TCard4         c4Order
+                                ,       tCIDLib::TCard4* const  pc4Out)
+        {
+            const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+            const tCIDLib::TCard4 c4CCnt = fmtCur.c4CCnt;
+            const tCIDLib::TCard4 c4Width = pixaSrc.c4Width();
+            const tCIDLib::TCard4 c4Height = pixaSrc.c4Height();
+            const tCIDLib::TCard4 c4RowComps = c4Width * c4CCnt;
+            const tCIDLib::TCard4 c4Comps = c4RowComps * c4Height;
+
+            const tCIDLib::TCard4 c4OrderInd = tCIDLib::MinVal(c4Order, c4MaxOrder);
+            const tCIDLib::TCard4* pc4Factors = ac4Factors[c4OrderInd];
+            const tCIDLib::TInt4 i4Taps = tCIDLib::TInt4(ac4Taps[c4OrderInd]);
+            const tCIDLib::TInt4 i4Half = (i4Taps - 1) >> 1;
+            tCIDLib::TCard4 c4Divisor = 0;
+            for (tCIDLib::TInt4 i4TInd = 0; i4TInd < i4Taps; i4TInd++)
+                c4Divisor += pc4Factors[i4TInd];
+
+            // Start both the temp and output as copies of the source
+            tCIDLib::TCard4* pc4Tmp = new tCIDLib::TCard4[c4Comps];
+            TArrayJanitor<tCIDLib::TCard4> janTmp(pc4Tmp);
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < c4Height; c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowComps; c4Ind++)
+                {
+                    const tCIDLib::TCard4 c4Val = c4CompAt(pixaSrc, b16, c4Row, c4Ind);
+                    pc4Tmp[(c4Row * c4RowComps) + c4Ind] = c4Val;
+                    pc4Out[(c4Row * c4RowComps) + c4Ind] = c4Val;
+                }
+            }
+
+            if ((c4Width < 3) || (c4Height < 3))
+                return;
+
+            // Horizontal from the source into the temp
+            for (tCIDLib::TCard4 c4Row = 1; c4Row < c4Height - 1; c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Col = 1; c4Col < c4Width - 1; c4Col++)
+                {
+                    for (tCIDLib::TCard4 c4CInd = 0; c4CInd < c4CCnt; c4CInd++)
+                    {
+                        tCIDLib::TCard4 c4Sum = 0;
+                        for (tCIDLib::TInt4 i4TInd = 0; i4TInd < i4Taps; i4TInd++)
+                        {
+                            const tCIDLib::TInt4 i4Col = tCIDLib::TInt4(c4Col) - i4Half + i4TInd;
+                            if ((i4Col < 0) || (i4Col >= tCIDLib::TInt4(c4Width)))
+                                continue;
+
+                            c4Sum += pc4Factors[i4TInd] * c4CompAt
+                            (
+                                pixaSrc, b16, c4Row, (tCIDLib::TCard4(i4Col) * c4CCnt) + c4CInd
+                            );
+                        }
+                        pc4Tmp[(c4Row * c4RowComps) + (c4Col * c4CCnt) + c4CInd] = c4Sum / c4Divisor;
+                    }
+                }
+            }
+
+            // And vertical from the temp into the output
+            for (tCIDLib::TCard4 c4Row = 1; c4Row < c4Height - 1; c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Ind = c4CCnt; c4Ind < c4RowComps - c4CCnt; c4Ind++)
+                {
+                    tCIDLib::TCard4 c4Sum = 0;
+                    for (tCIDLib::TInt4 i4TInd = 0; i4TInd < i4Taps; i4TInd++)
+                    {
+                        const tCIDLib::TInt4 i4Row = tCIDLib::TInt4(c4Row) - i4Half + i4TInd;
+                        if ((i4Row < 0) || (i4Row >= tCIDLib::TInt4(c4Height)))
+                            continue;
+                        c4Sum += pc4Factors[i4TInd] * pc4Tmp[(tCIDLib::TCard4(i4Row) * c4RowComps) + c4Ind];
+                    }
+                    pc4Out[(c4Row * c4RowComps) + c4Ind] = c4Sum / c4Divisor;
+                }
+            }
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Blur
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Blur: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Blur::TTest_Blur() :
+
+    TTestFWTest
+    (
+        L"Gaussian Blur", L"Checks the blur against a per-pixel version", 3
+    )
+{
+}
+
+TTest_Blur::~TTest_Blur()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Blur: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Blur::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // The hand worked one, for each format
+    for (const TestCIDImage_Blur::TBlurFmt& fmtCur : TestCIDImage_Blur::afmtList)
+    {
+        const tCIDLib::TBoolean b16 = fmtCur.eDepth == tCIDImage::EBitDepths::Sixteen;
+        TPixelArray pixaTest
+        (
+            fmtCur.eFmt, fmtCur.eDepth, tCIDImage::ERowOrders::TopDown, TSize(5, 5)
+        );
+        pixaTest.SetAll(0);
+        for (tCIDLib::TCard4 c4CInd = 0; c4CInd < fmtCur.c4CCnt; c4CInd++)
+        {
+            TestCIDImage_Blur::PutComp
+            (
+                pixaTest, b16, 2, (2 * fmtCur.c4CCnt) + c4CInd, b16 ? 0xFFFF : 0xFF
+            );
+        }
+        pixaTest.GaussianBlur(3);
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Row = 0; c4Row < 5; c4Row++)
+        {
+            for (tCIDLib::TCard4 c4Ind = 0; c4Ind < 5 * fmtCur.c4CCnt; c4Ind++)
+            {
+                const tCIDLib::TCard4 c4Col = c4Ind / fmtCur.c4CCnt;
+                const tCIDLib::TCard4 c4Exp = b16 ? TestCIDImage_Blur::ac4Known16[c4Row][c4Col]
+                                                  : TestCIDImage_Blur::ac4Known8[c4Row][c4Col];
+                if (TestCIDImage_Blur::c4CompAt(pixaTest, b16, c4Row, c4Ind) != c4Exp)
+                    c4Bad++;
+            }
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" components of the known blur were wrong. Fmt="
+                    << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                    << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Now against the per-pixel version. Every order (and one past the max,
+    //  which gets clipped), at some odd and degenerate sizes. Then a couple of
+    //  orders on an image big enough to be split into bands.
+    //
+    const TSize aszSmall[] =
+    {
+        TSize(37, 23), TSize(3, 3), TSize(2, 9), TSize(16, 1)
+    };
+    for (const TestCIDImage_Blur::TBlurFmt& fmtCur : TestCIDImage_Blur::afmtList)
+    {
+        for (const TSize& szCur : aszSmall)
+        {
+            for (tCIDLib::TCard4 c4Order = 0; c4Order <= TestCIDImage_Blur::c4MaxOrder + 1; c4Order++)
+            {
+                if (!bTestBlur(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, szCur, c4Order))
+                    eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        if (!bTestBlur(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, TSize(640, 480), 3)
+        ||  !bTestBlur(strmOut, fmtCur.eFmt, fmtCur.eDepth, fmtCur.c4CCnt, TSize(640, 480), 12))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Blur: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Blurs a pseudo-random image of the indicated format and size, and checks it
+//  against the per-pixel version.
+//
+tCIDLib::TBoolean
+TTest_Blur::bTestBlur(          TTextOutStream&         strmOut
+                        , const tCIDImage::EPixFmts     eFmt
+                        , const tCIDImage::EBitDepths   eDepth
+                        , const tCIDLib::TCard4         c4CCnt
+                        , const TSize&                  szImage
+                        , const tCIDLib::TCard4         c4Order)
+{
+    const TestCIDImage_Blur::TBlurFmt fmtCur = { eFmt, eDepth, c4CCnt };
+    const tCIDLib::TBoolean b16 = eDepth == tCIDImage::EBitDepths::Sixteen;
+
+    TPixelArray pixaTest(eFmt, eDepth, tCIDImage::ERowOrders::TopDown, szImage);
+    TestCIDImage_Blur::FillImage(pixaTest, fmtCur);
+
+    const tCIDLib::TCard4 c4RowComps = szImage.c4Width() * c4CCnt;
+    tCIDLib::TCard4* pc4Exp = new tCIDLib::TCard4[c4RowComps * szImage.c4Height()];
+    TArrayJanitor<tCIDLib::TCard4> janExp(pc4Exp);
+    TestCIDImage_Blur::RefBlur(pixaTest, fmtCur, c4Order, pc4Exp);
+
+    pixaTest.GaussianBlur(c4Order);
+
+    tCIDLib::TCard4 c4Bad = 0;
+    for (tCIDLib::TCard4 c4Row = 0; c4Row < szImage.c4Height(); c4Row++)
+    {
+        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowComps; c4Ind++)
+        {
+            if (TestCIDImage_Blur::c4CompAt(pixaTest, b16, c4Row, c4Ind)
+                                        != pc4Exp[(c4Row * c4RowComps) + c4Ind])
+            {
+                c4Bad++;
+            }
+        }
+    }
+
+    if (c4Bad)
+    {
+        strmOut << TFWCurLn << c4Bad << L" components were wrong. Fmt="
+                << tCIDLib::c4EnumOrd(eFmt) << L", Depth=" << tCIDLib::c4EnumOrd(eDepth)
+                << L", Size=" << szImage << L", Order=" << c4Order << L"\n\n";
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
@@ -0,0 +1,392 @@
+//
+// FILE NAME: TestCIDImage_JPEG.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the JPEG decoder's scaled decoding and scan line sink output.
+//  We write out a known image, then decode it at each scale, both into the image
+//  and to a row sink, and make sure they agree. And we make sure that a decode
+//  that the sink stops early leaves the image object usable.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDImage.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_JPEGScale,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDImage_JPEG
+    {
+        // -----------------------------------------------------------------------
+        //  The size of our test image. It's not a multiple of 8 either way, so
+        //  that the scaled sizes have to round up.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Width = 123;
+        constexpr tCIDLib::TCard4   c4Height = 77;
+
+
+        // -----------------------------------------------------------------------
+        //  A row sink that just stores the rows it gets, so we can compare them
+        //  to the image. It can be told to stop after some number of rows.
+        // -----------------------------------------------------------------------
+        class TTestRowSink : public MJPEGRowSink
+        {
+            public :
+                TTestRowSink(const tCIDLib::TCard4 c4StopAfter = kCIDLib::c4MaxCard) :
+
+                    m_bOutOfOrder(kCIDLib::False)
+                    , m_c4RowBytes(0)
+                    , m_c4Rows(0)
+                    , m_c4StopAfter(c4StopAfter)
+                    , m_eFmt(tCIDImage::EPixFmts::GrayScale)
+                    , m_mbufRows(8)
+                {
+                }
+
+                TTestRowSink(const TTestRowSink&) = delete;
+                TTestRowSink(TTestRowSink&&) = delete;
+
+                ~TTestRowSink() = default;
+
+                tCIDLib::TBoolean bStoreRow(const   tCIDLib::TCard1* const  pc1Row
+                                            , const tCIDLib::TCard4         c4Row) final
+                {
+                    if (c4Row != m_c4Rows)
+                        m_bOutOfOrder = kCIDLib::True;
+
+                    m_mbufRows.CopyIn(pc1Row, m_c4RowBytes, c4Row * m_c4RowBytes);
+                    m_c4Rows++;
+                    return (m_c4Rows < m_c4StopAfter);
+                }
+
+                tCIDLib::TVoid StartImage(  const   TSize&                  szImage
+                                            , const tCIDImage::EPixFmts     eFmt
+                                            , const tCIDImage::EBitDepths) final
+                {
+                    m_eFmt = eFmt;
+                    m_szImage = szImage;
+                    m_c4RowBytes = szImage.c4Width()
+                                   * ((eFmt == tCIDImage::EPixFmts::GrayScale) ? 1 : 3);
+                    m_c4Rows = 0;
+                    m_bOutOfOrder = kCIDLib::False;
+
+                    const tCIDLib::TCard4 c4Size = tCIDLib::MaxVal
+                    (
+                        m_c4RowBytes * szImage.c4Height(), tCIDLib::TCard4(8)
+                    );
+                    m_mbufRows.Reset(c4Size, c4Size);
+                }
+
+                tCIDLib::TBoolean   m_bOutOfOrder;
+                tCIDLib::TCard4     m_c4RowBytes;
+                tCIDLib::TCard4     m_c4Rows;
+                tCIDLib::TCard4     m_c4StopAfter;
+                tCIDImage::EPixFmts m_eFmt;
+                THeapBuf            m_mbufRows;
+                TSize               m_szImage;
+        };
+
+
+        //
+        //  Make sure that the rows a sink got are the same as the pixel array
+        //  of an image decoded normally.
+        //
+        tCIDLib::TBoolean bSameRows(const TTestRowSink& mjrsSrc, const TCIDImage& imgSrc)
+        {
+            if ((mjrsSrc.m_szImage != imgSrc.szImage())
+            ||  (mjrsSrc.m_eFmt != imgSrc.ePixFmt())
+            ||  (mjrsSrc.m_c4Rows != imgSrc.c4Height())
+            ||  mjrsSrc.m_bOutOfOrder)
+            {
+                return kCIDLib::False;
+            }
+
+            const TPixelArray& pixaSrc = imgSrc.pixaBits();
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < mjrsSrc.m_c4Rows; c4Row++)
+            {
+                if (!TRawMem::bCompareMemBuf
+                (
+                    mjrsSrc.m_mbufRows.pc1DataAt(c4Row * mjrsSrc.m_c4RowBytes)
+                    , pixaSrc.pc1RowPtr(c4Row)
+                    , mjrsSrc.m_c4RowBytes))
+                {
+                    return kCIDLib::False;
+                }
+            }
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Make sure two images have the same format and pixels. The pixel array
+        //  lines may have padding, so we do it a row at a time.
+        //
+        tCIDLib::TBoolean bSameImage(const TCIDImage& imgOne, const TCIDImage& imgTwo)
+        {
+            if ((imgOne.szImage() != imgTwo.szImage())
+            ||  (imgOne.ePixFmt() != imgTwo.ePixFmt()))
+            {
+                return kCIDLib::False;
+            }
+
+            const TPixelArray& pixaOne = imgOne.pixaBits();
+            const TPixelArray& pixaTwo = imgTwo.pixaBits();
+            const tCIDLib::TCard4 c4RowBytes = (pixaOne.c4Width() * pixaOne.c4BitsPer()) / 8;
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaOne.c4Height(); c4Row++)
+            {
+                if (!TRawMem::bCompareMemBuf(pixaOne.pc1RowPtr(c4Row), pixaTwo.pc1RowPtr(c4Row), c4RowBytes))
+                    return kCIDLib::False;
+            }
+            return kCIDLib::True;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_JPEGScale
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_JPEGScale: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_JPEGScale::TTest_JPEGScale() :
+
+    TTestFWTest
+    (
+        L"JPEG Scaling", L"Tests scaled JPEG decoding and row sink output", 2
+    )
+{
+}
+
+TTest_JPEGScale::~TTest_JPEGScale()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_JPEGScale: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_JPEGScale::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // Do a color and a gray scale image
+    const tCIDImage::EPixFmts aeFmts[] =
+    {
+        tCIDImage::EPixFmts::TrueClr, tCIDImage::EPixFmts::GrayScale
+    };
+
+    for (const tCIDImage::EPixFmts eFmt : aeFmts)
+    {
+        //
+        //  Create our known image, a smooth gradient that JPEG handles well,
+        //  and write it out.
+        //
+        TPixelArray pixaSrc
+        (
+            eFmt
+            , tCIDImage::EBitDepths::Eight
+            , tCIDImage::ERowOrders::TopDown
+            , TSize(TestCIDImage_JPEG::c4Width, TestCIDImage_JPEG::c4Height)
+        );
+        const tCIDLib::TCard4 c4RowBytes = (pixaSrc.c4Width() * pixaSrc.c4BitsPer()) / 8;
+        for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaSrc.c4Height(); c4Row++)
+        {
+            tCIDLib::TCard1* pc1Row = pixaSrc.pc1RowPtr(c4Row);
+            for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowBytes; c4Ind++)
+                pc1Row[c4Ind] = tCIDLib::TCard1(c4Ind + (c4Row * 2));
+        }
+
+        TBinMBufOutStream strmJPEG(64 * 1024);
+        {
+            TJPEGImage imgSrc(pixaSrc);
+            imgSrc.c4CompQuality(95);
+            strmJPEG << imgSrc;
+            strmJPEG.Flush();
+        }
+
+        //
+        //  Decode it at each scale, into the image and to a sink, and check
+        //  the size, which should be rounded up.
+        //
+        const tCIDJPEG::EDecScales aeScales[] =
+        {
+            tCIDJPEG::EDecScales::Full
+            , tCIDJPEG::EDecScales::Half
+            , tCIDJPEG::EDecScales::Quarter
+            , tCIDJPEG::EDecScales::Eighth
+        };
+        const tCIDLib::TCard4 ac4Divs[] = { 1, 2, 4, 8 };
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < tCIDLib::c4ArrayElems(aeScales); c4Index++)
+        {
+            const tCIDLib::TCard4 c4Div = ac4Divs[c4Index];
+            const TSize szExp
+            (
+                (TestCIDImage_JPEG::c4Width + c4Div - 1) / c4Div
+                , (TestCIDImage_JPEG::c4Height + c4Div - 1) / c4Div
+            );
+
+            TJPEGImage imgDec;
+            imgDec.eDecScale(aeScales[c4Index]);
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                strmSrc >> imgDec;
+            }
+
+            if ((imgDec.szImage() != szExp) || (imgDec.ePixFmt() != eFmt))
+            {
+                strmOut << TFWCurLn << L"Scaled image was " << imgDec.szImage()
+                        << L" but should be " << szExp << L". Fmt="
+                        << tCIDLib::c4EnumOrd(eFmt) << L", Scale=1/" << c4Div << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+                continue;
+            }
+
+            // Decode it again, on the same object, to a sink
+            TestCIDImage_JPEG::TTestRowSink mjrsTest;
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                imgDec.DecodeTo(strmSrc, mjrsTest);
+            }
+
+            if (!TestCIDImage_JPEG::bSameRows(mjrsTest, imgDec))
+            {
+                strmOut << TFWCurLn << L"Sink rows didn't match the decoded image. Fmt="
+                        << tCIDLib::c4EnumOrd(eFmt) << L", Scale=1/" << c4Div << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        //
+        //  At full size, it should be close to the original. It's lossy, but
+        //  a smooth gradient at high quality should be within a few levels on
+        //  average.
+        //
+        {
+            TJPEGImage imgDec;
+            TBinMBufInStream strmSrc(strmJPEG);
+            strmSrc >> imgDec;
+
+            const TPixelArray& pixaDec = imgDec.pixaBits();
+            tCIDLib::TCard8 c8TotalDiff = 0;
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaSrc.c4Height(); c4Row++)
+            {
+                const tCIDLib::TCard1* pc1Src = pixaSrc.pc1RowPtr(c4Row);
+                const tCIDLib::TCard1* pc1Dec = pixaDec.pc1RowPtr(c4Row);
+                for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowBytes; c4Ind++)
+                {
+                    c8TotalDiff += (pc1Src[c4Ind] > pc1Dec[c4Ind])
+                                   ? pc1Src[c4Ind] - pc1Dec[c4Ind]
+                                   : pc1Dec[c4Ind] - pc1Src[c4Ind];
+                }
+            }
+
+            const tCIDLib::TCard8 c8AvgDiff = c8TotalDiff / (c4RowBytes * pixaSrc.c4Height());
+            if (c8AvgDiff > 4)
+            {
+                strmOut << TFWCurLn << L"Decoded image was too far from the original. AvgDiff="
+                        << c8AvgDiff << L", Fmt=" << tCIDLib::c4EnumOrd(eFmt) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        //
+        //  Stop a sink decode early, at a scale, then make sure the same object
+        //  can still do a full decode, and a full sink decode, and that both
+        //  match a decode by a fresh object.
+        //
+        {
+            TJPEGImage imgFresh;
+            imgFresh.eDecScale(tCIDJPEG::EDecScales::Half);
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                strmSrc >> imgFresh;
+            }
+
+            TJPEGImage imgReuse;
+            imgReuse.eDecScale(tCIDJPEG::EDecScales::Half);
+
+            TestCIDImage_JPEG::TTestRowSink mjrsStop(3);
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                imgReuse.DecodeTo(strmSrc, mjrsStop);
+            }
+
+            if (mjrsStop.m_c4Rows != 3)
+            {
+                strmOut << TFWCurLn << L"Sink got " << mjrsStop.m_c4Rows
+                        << L" rows after asking to stop at 3. Fmt="
+                        << tCIDLib::c4EnumOrd(eFmt) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                strmSrc >> imgReuse;
+            }
+
+            if (!TestCIDImage_JPEG::bSameImage(imgReuse, imgFresh))
+            {
+                strmOut << TFWCurLn << L"Decode after an early stop was wrong. Fmt="
+                        << tCIDLib::c4EnumOrd(eFmt) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+
+            // Stop it again, then do a full sink decode
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                imgReuse.DecodeTo(strmSrc, mjrsStop);
+            }
+
+            TestCIDImage_JPEG::TTestRowSink mjrsFull;
+            {
+                TBinMBufInStream strmSrc(strmJPEG);
+                imgReuse.DecodeTo(strmSrc, mjrsFull);
+            }
+
+            if (!TestCIDImage_JPEG::bSameRows(mjrsFull, imgFresh))
+            {
+                strmOut << TFWCurLn << L"Sink decode after an early stop was wrong. Fmt="
+                        << tCIDLib::c4EnumOrd(eFmt) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+    return eRes;
+}
@@ -0,0 +1,604 @@
+//
+// FILE NAME: TestCIDImage_PNG.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the PNG scan line filters. One test round trips images of
+//  each format we can write, and checks which filters the writer picked. The
+//  other builds PNG files by hand, using every filter type for each of the
+//  bytes per pixel sizes (1, 2, 3, 4, 6, and 8) that the reader has to deal
+//  with, and makes sure they read in the same as the unfiltered version.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  We can't write 16 bit color, since the pixel array can't hold it, so the
+//      6 and 8 bytes per pixel sizes are only covered by the hand built files.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDImage.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_PNGFilters,TTestFWTest)
+RTTIDecls(TTest_PNGRoundTrip,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDImage_PNG
+    {
+        // -----------------------------------------------------------------------
+        //  The chunk ids we need, and the file marker
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Chunk_Header  = 0x49484452;
+        constexpr tCIDLib::TCard4   c4Chunk_Data    = 0x49444154;
+        constexpr tCIDLib::TCard4   c4Chunk_End     = 0x49454E44;
+
+        const tCIDLib::TCard1 ac1Marker[8] =
+        {
+            0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The PNG formats we build by hand, one or more for each bytes per
+        //  pixel size, plus a sub-byte one. The color type is the PNG value.
+        // -----------------------------------------------------------------------
+        struct TPNGFmt
+        {
+            tCIDLib::TCard1     c1ClrType;
+            tCIDLib::TCard1     c1Depth;
+            tCIDLib::TCard4     c4Bpp;
+        };
+        const TPNGFmt afmtHand[] =
+        {
+            { 0,  4, 1 }
+          , { 0,  8, 1 }
+          , { 4,  8, 2 }
+          , { 0, 16, 2 }
+          , { 2,  8, 3 }
+          , { 6,  8, 4 }
+          , { 4, 16, 4 }
+          , { 2, 16, 6 }
+          , { 6, 16, 8 }
+        };
+
+
+        // The bytes in a scan line, not counting the filter byte
+        tCIDLib::TCard4 c4CalcLineBytes(const TPNGFmt& fmtSrc, const tCIDLib::TCard4 c4Width)
+        {
+            if (fmtSrc.c1Depth < 8)
+                return ((c4Width * fmtSrc.c1Depth) + 7) / 8;
+            return c4Width * fmtSrc.c4Bpp;
+        }
+
+
+        // Append a big endian Card4 to a buffer
+        tCIDLib::TVoid PutBE4(          TMemBuf&            mbufTar
+                                ,       tCIDLib::TCard4&    c4Ind
+                                , const tCIDLib::TCard4     c4ToPut)
+        {
+            mbufTar.PutCard1(tCIDLib::TCard1(c4ToPut >> 24), c4Ind++);
+            mbufTar.PutCard1(tCIDLib::TCard1(c4ToPut >> 16), c4Ind++);
+            mbufTar.PutCard1(tCIDLib::TCard1(c4ToPut >> 8), c4Ind++);
+            mbufTar.PutCard1(tCIDLib::TCard1(c4ToPut), c4Ind++);
+        }
+
+        tCIDLib::TCard4 c4GetBE4(const TMemBuf& mbufSrc, const tCIDLib::TCard4 c4Ind)
+        {
+            return (tCIDLib::TCard4(mbufSrc[c4Ind]) << 24)
+                   | (tCIDLib::TCard4(mbufSrc[c4Ind + 1]) << 16)
+                   | (tCIDLib::TCard4(mbufSrc[c4Ind + 2]) << 8)
+                   | tCIDLib::TCard4(mbufSrc[c4Ind + 3]);
+        }
+
+
+        // Append a chunk, with its length and CRC, to a buffer
+        tCIDLib::TVoid AddChunk(        TMemBuf&                mbufTar
+                                ,       tCIDLib::TCard4&        c4Ind
+                                , const tCIDLib::TCard4         c4Id
+                                , const tCIDLib::TCard1* const  pc1Data
+                                , const tCIDLib::TCard4         c4Len)
+        {
+            PutBE4(mbufTar, c4Ind, c4Len);
+            const tCIDLib::TCard4 c4CRCStart = c4Ind;
+            PutBE4(mbufTar, c4Ind, c4Id);
+            if (c4Len)
+            {
+                mbufTar.CopyIn(pc1Data, c4Len, c4Ind);
+                c4Ind += c4Len;
+            }
+            PutBE4
+            (
+                mbufTar
+                , c4Ind
+                , TRawMem::hshHashBuffer3309(mbufTar.pc1DataAt(c4CRCStart), c4Len + 4)
+            );
+        }
+
+
+        //
+        //  The Paeth predictor, done just as the PNG spec describes it, to check
+        //  the reader's version against.
+        //
+        tCIDLib::TCard4 c4Paeth(const   tCIDLib::TCard4 c4Left
+                                , const tCIDLib::TCard4 c4Above
+                                , const tCIDLib::TCard4 c4AboveLeft)
+        {
+            const tCIDLib::TInt4 i4Est = tCIDLib::TInt4(c4Left + c4Above) - tCIDLib::TInt4(c4AboveLeft);
+            tCIDLib::TInt4 i4PA = i4Est - tCIDLib::TInt4(c4Left);
+            tCIDLib::TInt4 i4PB = i4Est - tCIDLib::TInt4(c4Above);
+            tCIDLib::TInt4 i4PC = i4Est - tCIDLib::TInt4(c4AboveLeft);
+            if (i4PA < 0)
+                i4PA = -i4PA;
+            if (i4PB < 0)
+                i4PB = -i4PB;
+            if (i4PC < 0)
+                i4PC = -i4PC;
+
+            if ((i4PA <= i4PB) && (i4PA <= i4PC))
+                return c4Left;
+            if (i4PB <= i4PC)
+                return c4Above;
+            return c4AboveLeft;
+        }
+
+
+        //
+        //  Filter one raw scan line into the output, a byte at a time. The
+        //  previous line is null on the first line.
+        //
+        tCIDLib::TVoid FilterLine(  const   tCIDLib::TCard1         c1Filter
+                                    , const tCIDLib::TCard1* const  pc1Cur
+                                    , const tCIDLib::TCard1* const  pc1Prev
+                                    , const tCIDLib::TCard4         c4Bytes
+                                    , const tCIDLib::TCard4         c4Bpp
+                                    ,       tCIDLib::TCard1* const  pc1Out)
+        {
+            for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4Bytes; c4Ind++)
+            {
+                const tCIDLib::TCard4 c4Left = (c4Ind >= c4Bpp) ? pc1Cur[c4Ind - c4Bpp] : 0;
+                const tCIDLib::TCard4 c4Above = pc1Prev ? pc1Prev[c4Ind] : 0;
+                const tCIDLib::TCard4 c4AboveLeft
+                (
+                    (pc1Prev && (c4Ind >= c4Bpp)) ? pc1Prev[c4Ind - c4Bpp] : 0
+                );
+
+                tCIDLib::TCard4 c4Pred = 0;
+                if (c1Filter == 1)
+                    c4Pred = c4Left;
+                else if (c1Filter == 2)
+                    c4Pred = c4Above;
+                else if (c1Filter == 3)
+                    c4Pred = (c4Left + c4Above) / 2;
+                else if (c1Filter == 4)
+                    c4Pred = c4Paeth(c4Left, c4Above, c4AboveLeft);
+
+                pc1Out[c4Ind] = tCIDLib::TCard1(pc1Cur[c4Ind] - c4Pred);
+            }
+        }
+
+
+        //
+        //  Build a PNG file from raw scan lines. If c4FirstFilter is c4MaxCard,
+        //  every line is left unfiltered. Else the lines cycle through the five
+        //  filters, starting with that one.
+        //
+        tCIDLib::TCard4 c4BuildPNG( const   TPNGFmt&        fmtBuild
+                                    , const tCIDLib::TCard4 c4Width
+                                    , const tCIDLib::TCard4 c4Height
+                                    , const TMemBuf&        mbufRaw
+                                    , const tCIDLib::TCard4 c4FirstFilter
+                                    ,       TMemBuf&        mbufPNG)
+        {
+            const tCIDLib::TCard4 c4LineBytes = c4CalcLineBytes(fmtBuild, c4Width);
+
+            // Filter the lines, each with its leading filter type byte
+            THeapBuf mbufFiltered((c4LineBytes + 1) * c4Height);
+            for (tCIDLib::TCard4 c4Line = 0; c4Line < c4Height; c4Line++)
+            {
+                tCIDLib::TCard1 c1Filter = 0;
+                if (c4FirstFilter != kCIDLib::c4MaxCard)
+                    c1Filter = tCIDLib::TCard1((c4FirstFilter + c4Line) % 5);
+
+                tCIDLib::TCard1* pc1Out = mbufFiltered.pc1DataAt(c4Line * (c4LineBytes + 1));
+                *pc1Out++ = c1Filter;
+                FilterLine
+                (
+                    c1Filter
+                    , mbufRaw.pc1DataAt(c4Line * c4LineBytes)
+                    , c4Line ? mbufRaw.pc1DataAt((c4Line - 1) * c4LineBytes) : nullptr
+                    , c4LineBytes
+                    , fmtBuild.c4Bpp
+                    , pc1Out
+                );
+            }
+
+            TZLibCompressor zlibData;
+            TBinMBufInStream strmFiltered(&mbufFiltered, mbufFiltered.c4Size());
+            TBinMBufOutStream strmComp(mbufFiltered.c4Size() + 1024);
+            const tCIDLib::TCard4 c4CompSz = zlibData.c4Compress(strmFiltered, strmComp);
+            strmComp.Flush();
+
+            tCIDLib::TCard4 c4Ind = 0;
+            mbufPNG.CopyIn(ac1Marker, 8, 0);
+            c4Ind += 8;
+
+            tCIDLib::TCard1 ac1Hdr[13];
+            ac1Hdr[0] = tCIDLib::TCard1(c4Width >> 24);
+            ac1Hdr[1] = tCIDLib::TCard1(c4Width >> 16);
+            ac1Hdr[2] = tCIDLib::TCard1(c4Width >> 8);
+            ac1Hdr[3] = tCIDLib::TCard1(c4Width);
+            ac1Hdr[4] = tCIDLib::TCard1(c4Height >> 24);
+            ac1Hdr[5] = tCIDLib::TCard1(c4Height >> 16);
+            ac1Hdr[6] = tCIDLib::TCard1(c4Height >> 8);
+            ac1Hdr[7] = tCIDLib::TCard1(c4Height);
+            ac1Hdr[8] = fmtBuild.c1Depth;
+            ac1Hdr[9] = fmtBuild.c1ClrType;
+            ac1Hdr[10] = 0;
+            ac1Hdr[11] = 0;
+            ac1Hdr[12] = 0;
+            AddChunk(mbufPNG, c4Ind, c4Chunk_Header, ac1Hdr, 13);
+            AddChunk(mbufPNG, c4Ind, c4Chunk_Data, strmComp.mbufData().pc1Data(), c4CompSz);
+            AddChunk(mbufPNG, c4Ind, c4Chunk_End, nullptr, 0);
+            return c4Ind;
+        }
+
+
+        //
+        //  Find the data chunks in a PNG file, decompress them, and return the
+        //  filter type of each line. We assume one data chunk, which is all our
+        //  writer creates.
+        //
+        tCIDLib::TBoolean
+        bGetFilters(const   TMemBuf&                    mbufPNG
+                    , const tCIDLib::TCard4             c4PNGBytes
+                    , const tCIDLib::TCard4             c4LineBytes
+                    , const tCIDLib::TCard4             c4Lines
+                    ,       TFundVector<tCIDLib::TCard1>& fcolFilters)
+        {
+            fcolFilters.RemoveAll();
+
+            tCIDLib::TCard4 c4Ind = 8;
+            while (c4Ind + 12 <= c4PNGBytes)
+            {
+                const tCIDLib::TCard4 c4Len = c4GetBE4(mbufPNG, c4Ind);
+                const tCIDLib::TCard4 c4Id = c4GetBE4(mbufPNG, c4Ind + 4);
+                if (c4Id == c4Chunk_Data)
+                {
+                    TZLibCompressor zlibData;
+                    TBinMBufInStream strmComp(mbufPNG.pc1DataAt(c4Ind + 8), c4Len);
+                    TBinMBufOutStream strmDecomp((c4LineBytes + 1) * c4Lines + 16);
+                    const tCIDLib::TCard4 c4Bytes = zlibData.c4Decompress(strmComp, strmDecomp);
+                    strmDecomp.Flush();
+                    if (c4Bytes != (c4LineBytes + 1) * c4Lines)
+                        return kCIDLib::False;
+
+                    for (tCIDLib::TCard4 c4Line = 0; c4Line < c4Lines; c4Line++)
+                        fcolFilters.c4AddElement(strmDecomp.mbufData()[c4Line * (c4LineBytes + 1)]);
+                    return kCIDLib::True;
+                }
+                c4Ind += c4Len + 12;
+            }
+            return kCIDLib::False;
+        }
+
+
+        // Compare the pixels of two images, and their formats
+        tCIDLib::TBoolean bSameImage(const TCIDImage& imgOne, const TCIDImage& imgTwo)
+        {
+            if ((imgOne.ePixFmt() != imgTwo.ePixFmt())
+            ||  (imgOne.eBitDepth() != imgTwo.eBitDepth())
+            ||  (imgOne.szImage() != imgTwo.szImage()))
+            {
+                return kCIDLib::False;
+            }
+
+            const TPixelArray& pixaOne = imgOne.pixaBits();
+            const TPixelArray& pixaTwo = imgTwo.pixaBits();
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaOne.c4Height(); c4Row++)
+            {
+                for (tCIDLib::TCard4 c4Col = 0; c4Col < pixaOne.c4Width(); c4Col++)
+                {
+                    if (pixaOne.c4At(c4Col, c4Row) != pixaTwo.c4At(c4Col, c4Row))
+                        return kCIDLib::False;
+                }
+            }
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Fill the used bytes of each row of an image with a gradient plus a bit
+        //  of noise, which the smarter filters do well on. Any byte values are
+        //  legal for every format we use here.
+        //
+        tCIDLib::TVoid FillImage(TPixelArray& pixaTar)
+        {
+            const tCIDLib::TCard4 c4RowBytes = ((pixaTar.c4Width() * pixaTar.c4BitsPer()) + 7) / 8;
+            tCIDLib::TCard4 c4Seed = 0x55AA1234;
+            for (tCIDLib::TCard4 c4Row = 0; c4Row < pixaTar.c4Height(); c4Row++)
+            {
+                tCIDLib::TCard1* pc1Row = pixaTar.pc1RowPtr(c4Row);
+                for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4RowBytes; c4Ind++)
+                {
+                    c4Seed = (c4Seed * 1103515245) + 12345;
+                    pc1Row[c4Ind] = tCIDLib::TCard1((c4Ind * 3) + (c4Row * 5) + (c4Seed >> 29));
+                }
+            }
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PNGFilters
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PNGFilters: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PNGFilters::TTest_PNGFilters() :
+
+    TTestFWTest
+    (
+        L"PNG Filters", L"Reads PNG files using every filter for each pixel size", 2
+    )
+{
+}
+
+TTest_PNGFilters::~TTest_PNGFilters()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PNGFilters: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PNGFilters::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // An odd size, so that lines aren't a nice multiple of anything
+    const tCIDLib::TCard4 c4Width = 13;
+    const tCIDLib::TCard4 c4Height = 11;
+
+    THeapBuf mbufPNG(16 * 1024);
+    for (const TestCIDImage_PNG::TPNGFmt& fmtCur : TestCIDImage_PNG::afmtHand)
+    {
+        // Make up the raw lines, the same sort of gradient plus noise
+        const tCIDLib::TCard4 c4LineBytes = TestCIDImage_PNG::c4CalcLineBytes(fmtCur, c4Width);
+        THeapBuf mbufRaw(c4LineBytes * c4Height);
+        tCIDLib::TCard4 c4Seed = 0x7531ECA8;
+        for (tCIDLib::TCard4 c4Ind = 0; c4Ind < c4LineBytes * c4Height; c4Ind++)
+        {
+            c4Seed = (c4Seed * 1103515245) + 12345;
+            const tCIDLib::TCard4 c4Col = c4Ind % c4LineBytes;
+            const tCIDLib::TCard4 c4Row = c4Ind / c4LineBytes;
+            mbufRaw.PutCard1(tCIDLib::TCard1((c4Col * 7) + (c4Row * 3) + (c4Seed >> 28)), c4Ind);
+        }
+
+        // Read in the unfiltered version
+        TPNGImage imgPlain;
+        {
+            const tCIDLib::TCard4 c4Bytes = TestCIDImage_PNG::c4BuildPNG
+            (
+                fmtCur, c4Width, c4Height, mbufRaw, kCIDLib::c4MaxCard, mbufPNG
+            );
+            TBinMBufInStream strmSrc(&mbufPNG, c4Bytes);
+            strmSrc >> imgPlain;
+        }
+
+        //
+        //  And do one with the filters cycling through each type, starting
+        //  with each, so that each one gets used on the first line, which has
+        //  no line above.
+        //
+        for (tCIDLib::TCard4 c4First = 0; c4First < 5; c4First++)
+        {
+            const tCIDLib::TCard4 c4Bytes = TestCIDImage_PNG::c4BuildPNG
+            (
+                fmtCur, c4Width, c4Height, mbufRaw, c4First, mbufPNG
+            );
+
+            TPNGImage imgFiltered;
+            TBinMBufInStream strmSrc(&mbufPNG, c4Bytes);
+            strmSrc >> imgFiltered;
+
+            if (!TestCIDImage_PNG::bSameImage(imgPlain, imgFiltered))
+            {
+                strmOut << TFWCurLn << L"Filtered PNG read in differently. ClrType="
+                        << fmtCur.c1ClrType << L", Depth=" << fmtCur.c1Depth
+                        << L", Bpp=" << fmtCur.c4Bpp << L", First=" << c4First
+                        << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+    return eRes;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PNGRoundTrip
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PNGRoundTrip: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PNGRoundTrip::TTest_PNGRoundTrip() :
+
+    TTestFWTest
+    (
+        L"PNG Round Trip", L"Writes and reads back PNGs of each format", 2
+    )
+{
+}
+
+TTest_PNGRoundTrip::~TTest_PNGRoundTrip()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PNGRoundTrip: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PNGRoundTrip::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  Each format we can write, which covers 1 to 4 bytes per pixel, and the
+    //  sub-byte and palette formats, which must not be filtered.
+    //
+    struct TRTFmt
+    {
+        tCIDImage::EPixFmts     eFmt;
+        tCIDImage::EBitDepths   eDepth;
+    };
+    const TRTFmt afmtList[] =
+    {
+        { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::One }
+      , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Two }
+      , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Four }
+      , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Eight }
+      , { tCIDImage::EPixFmts::ClrPal, tCIDImage::EBitDepths::Four }
+      , { tCIDImage::EPixFmts::ClrPal, tCIDImage::EBitDepths::Eight }
+      , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Eight }
+      , { tCIDImage::EPixFmts::GrayScale, tCIDImage::EBitDepths::Sixteen }
+      , { tCIDImage::EPixFmts::TrueClr, tCIDImage::EBitDepths::Eight }
+      , { tCIDImage::EPixFmts::TrueAlpha, tCIDImage::EBitDepths::Eight }
+      , { tCIDImage::EPixFmts::GrayAlpha, tCIDImage::EBitDepths::Sixteen }
+    };
+
+    const TSize szTest(37, 19);
+    TFundVector<tCIDLib::TCard1> fcolFilters(szTest.c4Height());
+    for (const TRTFmt& fmtCur : afmtList)
+    {
+        TPixelArray pixaSrc(fmtCur.eFmt, fmtCur.eDepth, tCIDImage::ERowOrders::TopDown, szTest);
+        TestCIDImage_PNG::FillImage(pixaSrc);
+
+        const tCIDLib::TBoolean bPalette = tCIDLib::bAllBitsOn
+        (
+            fmtCur.eFmt, tCIDImage::EPixFmts::Palette
+        );
+        TPNGImage imgOut;
+        if (bPalette)
+        {
+            imgOut = TPNGImage
+            (
+                pixaSrc
+                , TClrPalette
+                  (
+                    (fmtCur.eDepth == tCIDImage::EBitDepths::Four)
+                    ? tCIDImage::EDefPalettes::Default16
+                    : tCIDImage::EDefPalettes::Default256
+                  )
+            );
+        }
+         else
+        {
+            imgOut = TPNGImage(pixaSrc);
+        }
+
+        TBinMBufOutStream strmPNG(64 * 1024);
+        strmPNG << imgOut;
+        strmPNG.Flush();
+
+        TPNGImage imgIn;
+        {
+            TBinMBufInStream strmSrc(strmPNG);
+            strmSrc >> imgIn;
+        }
+
+        if (!TestCIDImage_PNG::bSameImage(imgOut, imgIn))
+        {
+            strmOut << TFWCurLn << L"PNG did not round trip. Fmt="
+                    << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                    << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        //
+        //  Check the filters the writer picked. Palette and sub-byte images
+        //  must all be None. The others should have used a real filter on at
+        //  least some lines of our gradient data.
+        //
+        const tCIDLib::TCard4 c4LineBytes
+        (
+            ((szTest.c4Width() * pixaSrc.c4BitsPer()) + 7) / 8
+        );
+        if (!TestCIDImage_PNG::bGetFilters(strmPNG.mbufData()
+                                            , strmPNG.c4CurSize()
+                                            , c4LineBytes
+                                            , szTest.c4Height()
+                                            , fcolFilters))
+        {
+            strmOut << TFWCurLn << L"Could not get the PNG line filters. Fmt="
+                    << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                    << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        tCIDLib::TCard4 c4Filtered = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < fcolFilters.c4ElemCount(); c4Index++)
+        {
+            if (fcolFilters[c4Index])
+                c4Filtered++;
+        }
+
+        const tCIDLib::TBoolean bNoFilter
+        (
+            bPalette || (fmtCur.eDepth < tCIDImage::EBitDepths::Eight)
+        );
+        if (bNoFilter && c4Filtered)
+        {
+            strmOut << TFWCurLn << c4Filtered << L" lines were filtered, but should not be. Fmt="
+                    << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                    << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+         else if (!bNoFilter && !c4Filtered)
+        {
+            strmOut << TFWCurLn << L"No lines were filtered. Fmt="
+                    << tCIDLib::c4EnumOrd(fmtCur.eFmt) << L", Depth="
+                    << tCIDLib::c4EnumOrd(fmtCur.eDepth) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
@@ -96,6 +96,7 @@ tCIDLib::TVoid TCIDLibTestApp::LoadTests()
     AddTest(new TTest_StringTokenRep);
     AddTest(new TTest_StringMove);
     AddTest(new TTest_StringCopyCat);
+    AddTest(new TTest_StringHash);
 
     // General tests of basic classes, non all that inter-related
     AddTest(new TTest_CoordCtor);
@@ -144,6 +145,7 @@ tCIDLib::TVoid TCIDLibTestApp::LoadTests()
     AddTest(new TTest_BagMove);
     AddTest(new TTest_BagPlace);
     AddTest(new TTest_ColAlgo1);
+    AddTest(new TTest_ColAlgo2);
 
     AddTest(new TTest_ColCursors);
 
@@ -181,6 +183,30 @@ tCIDLib::TVoid TCIDLibTestApp::LoadTests()
     AddTest(new TTest_WeakPtr3);
     AddTest(new TTest_SafeCnt2);
 
+    // The thread pool
+    AddTest(new TTest_ThreadPool);
+
+    // The lock free ring queues
+    AddTest(new TTest_RingQueue);
+
+    // Reader/writer and sequence locks
+    AddTest(new TTest_RWLock);
+
+    // Stress and timing of the basic sync primitives
+    AddTest(new TTest_SyncPerf);
+
+    // The small object slab allocator
+    AddTest(new TTest_SlabAlloc);
+
+    // The arena allocator and arena aware collections
+    AddTest(new TTest_Arena);
+
+    // The fast 64 bit hash
+    AddTest(new TTest_Hash64);
+
+    // Interned strings
+    AddTest(new TTest_Atom);
+
     // Publish/subscribe
     AddTest(new TTest_PubSub1);
     AddTest(new TTest_PubSubVector);
@@ -643,6 +643,50 @@ class TTest_ColAlgo1 : public TTestFWTest
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ColAlgo2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_ColAlgo2 : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_ColAlgo2();
+
+        TTest_ColAlgo2(const TTest_ColAlgo2&) = delete;
+        TTest_ColAlgo2(TTest_ColAlgo2&&) = delete;
+
+        ~TTest_ColAlgo2();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TTest_ColAlgo2& operator=(const TTest_ColAlgo2&) = delete;
+        TTest_ColAlgo2& operator=(TTest_ColAlgo2&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_ColAlgo2,TTestFWTest)
+};
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_ColCursors
 // PREFIX: tfwt
@@ -2064,6 +2108,260 @@ class TTest_RefVectorMoveItem : public TTestFWTest
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RingQueue
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_RingQueue : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_RingQueue();
+
+        ~TTest_RingQueue();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        template <typename TQType> tCIDLib::TBoolean bBasicTests
+        (
+                    TQType&&                colTest
+            , const tCIDLib::TCh* const     pszType
+            ,       TTextStringOutStream&   strmOutput
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_RingQueue,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RWLock
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_RWLock : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_RWLock();
+
+        ~TTest_RWLock();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bSingleThreadTests
+        (
+                    TTextStringOutStream&   strmOutput
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_RWLock,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SyncPerf
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_SyncPerf : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_SyncPerf();
+
+        ~TTest_SyncPerf();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_SyncPerf,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SlabAlloc
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_SlabAlloc : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_SlabAlloc();
+
+        ~TTest_SlabAlloc();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_SlabAlloc,TTestFWTest)
+};
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Arena
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_Arena : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Arena();
+
+        ~TTest_Arena();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Arena,TTestFWTest)
+};
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Hash64
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_Hash64 : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Hash64();
+
+        ~TTest_Hash64();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Hash64,TTestFWTest)
+};
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Atom
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_Atom : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Atom();
+
+        ~TTest_Atom();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Atom,TTestFWTest)
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_SafeCnt1
 // PREFIX: tfwt
@@ -2440,6 +2738,39 @@ class TTest_StringMove : public TTestFWTest
 };
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_StringHash
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_StringHash : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_StringHash();
+
+        ~TTest_StringHash();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_StringHash,TTestFWTest)
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_StringTokens
 // PREFIX: tfwt
@@ -2554,6 +2885,39 @@ class TTest_StringTokenRep : public TTestFWTest
 };
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ThreadPool
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_ThreadPool : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_ThreadPool();
+
+        ~TTest_ThreadPool();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_ThreadPool,TTestFWTest)
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_Time1
 // PREFIX: tfwt
@@ -0,0 +1,375 @@
+//
+// FILE NAME: TestCIDLib2_Arena.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests of the arena allocator, its janitor, and of the
+//  collections and text stream that can allocate from an arena. It also times
+//  some request style work (build up a map and vector, format a reply, then
+//  toss them) with and without an arena.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The times are only reported, they are not checked.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_Arena,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_Arena
+    {
+        // -----------------------------------------------------------------------
+        //  c4BlockCnt
+        //      The number of blocks we allocate in the overlap test.
+        //
+        //  c4Requests
+        //  c4ReqCount
+        //      The number of simulated requests we time, and how many map and
+        //      vector elements each one adds.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4BlockCnt  = 2000;
+        constexpr tCIDLib::TCard4   c4Requests  = 200;
+        constexpr tCIDLib::TCard4   c4ReqCount  = 1000;
+
+
+        using TTestMap = THashMap<TString, TString, TStringKeyOps>;
+
+
+        //
+        //  Format some reply text to the passed stream. It's used to test the
+        //  arena text stream against a string stream, and for the timing.
+        //
+        tCIDLib::TVoid FormatReply(         TTextOutStream&     strmTar
+                                    , const tCIDLib::TCard4     c4Lines)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Lines; c4Index++)
+            {
+                strmTar << L"Item " << c4Index << L" = "
+                        << TFloat(c4Index / 3.0, 2) << kCIDLib::NewLn;
+            }
+            strmTar.Flush();
+        }
+
+
+        //
+        //  Do one simulated request. If an arena is passed, the map and vector
+        //  allocate from it, and the reply is formatted into it. Returns the
+        //  number of things it found, which the caller can check.
+        //
+        tCIDLib::TCard4 c4DoRequest(TArena* const parenaToUse)
+        {
+            TTestMap colMap
+            (
+                109
+                , TStringKeyOps(kCIDLib::False)
+                , parenaToUse
+            );
+            TFundVector<tCIDLib::TCard4> fcolVals(16, parenaToUse);
+
+            TString strKey;
+            TString strVal;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ReqCount; c4Index++)
+            {
+                strKey.SetFormatted(c4Index);
+                strVal = strKey;
+                strVal.Append(L"-Val");
+                colMap.kobjAdd(strKey, strVal);
+                fcolVals.c4AddElement(c4Index);
+            }
+
+            tCIDLib::TCard4 c4Found = 0;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ReqCount; c4Index++)
+            {
+                strKey.SetFormatted(fcolVals[c4Index]);
+                if (colMap.bKeyExists(strKey))
+                    c4Found++;
+            }
+
+            if (parenaToUse)
+            {
+                TTextArenaOutStream strmReply(parenaToUse);
+                FormatReply(strmReply, c4ReqCount / 10);
+            }
+             else
+            {
+                TTextStringOutStream strmReply(64UL);
+                FormatReply(strmReply, c4ReqCount / 10);
+            }
+            return c4Found;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Arena
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Arena: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Arena::TTest_Arena() :
+
+    TTestFWTest
+    (
+        L"Arena", L"Tests and timing of the arena allocator", 3
+    )
+{
+}
+
+TTest_Arena::~TTest_Arena()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Arena: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Arena::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  Use a small chunk size so that we cross lots of chunks. Allocate blocks
+    //  of varying sizes and alignments and fill each with its own pattern. If
+    //  any of them overlap, the patterns will get stepped on.
+    //
+    TArena arenaTest(4096);
+    {
+        tCIDLib::TCard1* apc1Blocks[TestCIDLib2_Arena::c4BlockCnt];
+        tCIDLib::TCard4 ac4Sizes[TestCIDLib2_Arena::c4BlockCnt];
+
+        tCIDLib::TCard4 c4BadAlign = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Arena::c4BlockCnt; c4Index++)
+        {
+            const tCIDLib::TCard4 c4Align = tCIDLib::TCard4(1) << (c4Index % 7);
+            ac4Sizes[c4Index] = 1 + ((c4Index * 37) % 300);
+            apc1Blocks[c4Index] = static_cast<tCIDLib::TCard1*>
+            (
+                arenaTest.pAlloc(ac4Sizes[c4Index], c4Align)
+            );
+            if (reinterpret_cast<size_t>(apc1Blocks[c4Index]) & (c4Align - 1))
+                c4BadAlign++;
+            TRawMem::SetMemBuf(apc1Blocks[c4Index], tCIDLib::TCard1(c4Index & 0xFF), ac4Sizes[c4Index]);
+        }
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Arena::c4BlockCnt; c4Index++)
+        {
+            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < ac4Sizes[c4Index]; c4BInd++)
+            {
+                if (apc1Blocks[c4Index][c4BInd] != tCIDLib::TCard1(c4Index & 0xFF))
+                {
+                    c4Bad++;
+                    break;
+                }
+            }
+        }
+
+        if (c4BadAlign)
+        {
+            strmOut << TFWCurLn << c4BadAlign << L" arena blocks were not aligned\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" arena blocks were overwritten\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // A block bigger than the chunk size should get a chunk of its own
+    {
+        tCIDLib::TCard1* pc1Big = static_cast<tCIDLib::TCard1*>(arenaTest.pAlloc(20000));
+        TRawMem::SetMemBuf(pc1Big, tCIDLib::TCard1(0xAC), 20000);
+        if ((pc1Big[0] != 0xAC) || (pc1Big[19999] != 0xAC))
+        {
+            strmOut << TFWCurLn << L"Oversized arena block was not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Resetting should keep the chunks and then reuse them
+    {
+        const tCIDLib::TCard4 c4Chunks = arenaTest.c4ChunkCount();
+        arenaTest.Reset();
+        if (arenaTest.c4BytesUsed() || (arenaTest.c4ChunkCount() != c4Chunks))
+        {
+            strmOut << TFWCurLn << L"Arena reset did not leave the expected state\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 1000; c4Index++)
+            arenaTest.pAlloc(64);
+
+        if (arenaTest.c4ChunkCount() != c4Chunks)
+        {
+            strmOut << TFWCurLn << L"Arena allocated new chunks instead of reusing them\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // A janitor should roll back what's allocated in its scope, and only that
+    {
+        const tCIDLib::TCard4 c4Used = arenaTest.c4BytesUsed();
+        const tCIDLib::TCh* pszKeep = arenaTest.pszReplicate(L"Keep this text");
+        const tCIDLib::TCard4 c4Kept = arenaTest.c4BytesUsed();
+        {
+            TArenaJanitor janArena(&arenaTest);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 500; c4Index++)
+                arenaTest.pszReplicate(TString(L"Some scoped text to throw away"));
+        }
+
+        if (arenaTest.c4BytesUsed() != c4Kept)
+        {
+            strmOut << TFWCurLn << L"Arena janitor did not roll back to its mark\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (!TRawStr::bCompareStr(pszKeep, L"Keep this text"))
+        {
+            strmOut << TFWCurLn << L"Arena text outside the janitor was lost\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (c4Kept <= c4Used)
+        {
+            strmOut << TFWCurLn << L"Replicated text did not use any arena space\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Make sure the arena aware collections work and give back correct results
+    {
+        TArenaJanitor janArena(&arenaTest);
+        const tCIDLib::TCard4 c4Found = TestCIDLib2_Arena::c4DoRequest(&arenaTest);
+        if (c4Found != TestCIDLib2_Arena::c4ReqCount)
+        {
+            strmOut << TFWCurLn << L"Expected " << TestCIDLib2_Arena::c4ReqCount
+                    << L" arena map elements but found " << c4Found << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Text formatted into an arena stream has to match the same text done
+    //  into a string stream. Start small so it has to grow a number of times.
+    //  Resetting the stream should empty it.
+    //
+    {
+        TArenaJanitor janArena(&arenaTest);
+        TTextArenaOutStream strmArena(&arenaTest, 8);
+        TTextStringOutStream strmString(8UL);
+        TestCIDLib2_Arena::FormatReply(strmArena, 200);
+        TestCIDLib2_Arena::FormatReply(strmString, 200);
+
+        if ((strmArena.c4Length() != strmString.strData().c4Length())
+        ||  !strmString.strData().bCompare(strmArena.pszText()))
+        {
+            strmOut << TFWCurLn << L"Arena stream text did not match string stream\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        strmArena.Reset();
+        if (strmArena.c4Length() || (*strmArena.pszText() != kCIDLib::chNull))
+        {
+            strmOut << TFWCurLn << L"Arena stream was not empty after reset\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Removing from an arena based map should work, and a copy of it, which is
+    //  on the heap, should survive the arena being reset.
+    //
+    {
+        TArena arenaMap;
+        TestCIDLib2_Arena::TTestMap colMap(23, TStringKeyOps(kCIDLib::False), &arenaMap);
+        colMap.kobjAdd(L"Key1", L"Value1");
+        colMap.kobjAdd(L"Key2", L"Value2");
+        colMap.kobjAdd(L"Key3", L"Value3");
+        colMap.RemoveKey(L"Key2");
+
+        TestCIDLib2_Arena::TTestMap colCopy(colMap);
+        colMap.RemoveAll();
+        arenaMap.Reset();
+
+        if ((colCopy.c4ElemCount() != 2)
+        ||  !colCopy.bKeyExists(L"Key1")
+        ||  colCopy.bKeyExists(L"Key2")
+        ||  (colCopy.kobjFindByKey(L"Key3").objValue() != L"Value3"))
+        {
+            strmOut << TFWCurLn << L"Copy of arena based map was not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // And time some request style work with and without an arena
+    {
+        tCIDLib::TCard4 c4Found = 0;
+        tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Arena::c4Requests; c4Index++)
+            c4Found += TestCIDLib2_Arena::c4DoRequest(nullptr);
+        strmOut << L"Requests on the heap: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        TArena arenaReq;
+        c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Arena::c4Requests; c4Index++)
+        {
+            c4Found += TestCIDLib2_Arena::c4DoRequest(&arenaReq);
+            arenaReq.Reset();
+        }
+        strmOut << L"Requests in an arena: " << (TTime::c8Millis() - c8Start) << L"ms, "
+                << arenaReq.c4ChunkCount() << L" chunks\n";
+
+        const tCIDLib::TCard4 c4Expected
+        (
+            TestCIDLib2_Arena::c4Requests * TestCIDLib2_Arena::c4ReqCount * 2
+        );
+        if (c4Found != c4Expected)
+        {
+            strmOut << TFWCurLn << L"Expected " << c4Expected << L" found elements but got "
+                    << c4Found << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    strmOut << L"\n";
+    return eRes;
+}
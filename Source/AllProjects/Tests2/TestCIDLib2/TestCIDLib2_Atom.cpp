@@ -0,0 +1,431 @@
+//
+// FILE NAME: TestCIDLib2_Atom.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests of the atom (interned string) class, and of the
+//  log event and stats cache code that use it. It also times copying and
+//  comparing atoms against doing the same with strings.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The atom table is process wide and never shrinks, so we use text that is
+//      unique to this test, and only check counts relative to what was there
+//      when we started.
+//
+//  2)  The times are only reported, they are not checked.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_Atom,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_Atom
+    {
+        // -----------------------------------------------------------------------
+        //  c4GrowCount
+        //      The number of unique atoms we add, which is enough to make the
+        //      table grow a few times.
+        //
+        //  c4Tasks
+        //  c4TaskNames
+        //      The number of threads we have interning the same names at once,
+        //      and how many names each one does.
+        //
+        //  c4TimeRounds
+        //      The number of copy and compare rounds we time.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4GrowCount     = 5000;
+        constexpr tCIDLib::TCard4   c4Tasks         = 8;
+        constexpr tCIDLib::TCard4   c4TaskNames     = 500;
+        constexpr tCIDLib::TCard4   c4TimeRounds    = 200000;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Atom
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Atom: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Atom::TTest_Atom() :
+
+    TTestFWTest
+    (
+        L"Atom", L"Tests and timing of interned strings", 3
+    )
+{
+}
+
+TTest_Atom::~TTest_Atom()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Atom: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Atom::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // The same text should give back the same entry, and different text not
+    {
+        const tCIDLib::TCard4 c4Start = TAtom::c4AtomCount();
+
+        TString strText(L"AtomTest/Basic/First");
+        TAtom atmFirst(strText);
+        TAtom atmSecond(L"AtomTest/Basic/First");
+        TAtom atmOther(L"AtomTest/Basic/Other");
+        TAtom atmCopy(atmFirst);
+
+        if ((atmFirst != atmSecond)
+        ||  (atmFirst != atmCopy)
+        ||  (atmFirst == atmOther)
+        ||  (atmFirst.pszText() != atmSecond.pszText()))
+        {
+            strmOut << TFWCurLn << L"Atoms for the same text were not the same\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if ((atmFirst.strText() != strText)
+        ||  (atmFirst.c4Length() != strText.c4Length())
+        ||  (atmFirst.c8Hash() != TRawStr::c8HashStr64(strText.pszBuffer())))
+        {
+            strmOut << TFWCurLn << L"Atom text or hash was not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (TAtom::c4AtomCount() != c4Start + 2)
+        {
+            strmOut << TFWCurLn << L"Expected 2 new atoms but got "
+                    << (TAtom::c4AtomCount() - c4Start) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        // Case matters
+        if (TAtom(L"ATOMTEST/BASIC/FIRST") == atmFirst)
+        {
+            strmOut << TFWCurLn << L"Atoms should be case sensitive\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Empty text should be the empty atom, and not go into the table
+    {
+        const tCIDLib::TCard4 c4Start = TAtom::c4AtomCount();
+        TAtom atmEmpty;
+        TAtom atmFromEmpty(TString::strEmpty());
+        if (!atmEmpty.bIsEmpty()
+        ||  (atmEmpty != atmFromEmpty)
+        ||  !atmEmpty.strText().bIsEmpty()
+        ||  atmEmpty.c4Length()
+        ||  (atmEmpty.c8Hash() != TRawStr::c8HashStr64(kCIDLib::pszEmptyZStr))
+        ||  (TAtom::c4AtomCount() != c4Start))
+        {
+            strmOut << TFWCurLn << L"The empty atom was not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Finding shouldn't add, and should find it once it's been added
+    {
+        TAtom atmFound(L"Something");
+        if (TAtom::bFind(L"AtomTest/Find/NotYet", atmFound) || !atmFound.bIsEmpty())
+        {
+            strmOut << TFWCurLn << L"Found an atom that has not been added\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        TAtom atmAdded(L"AtomTest/Find/NotYet");
+        if (!TAtom::bFind(L"AtomTest/Find/NotYet", atmFound) || (atmFound != atmAdded))
+        {
+            strmOut << TFWCurLn << L"Did not find an atom that was added\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Add enough to make the table grow a number of times, then make sure that
+    //  they all still look up to the same atoms. And put them into a hash set to
+    //  check the key ops.
+    //
+    {
+        const tCIDLib::TCard4 c4Start = TAtom::c4AtomCount();
+        TVector<TAtom> colAtoms(TestCIDLib2_Atom::c4GrowCount);
+        THashSet<TAtom, TAtomKeyOps> colSet(109, TAtomKeyOps());
+        TString strName;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Atom::c4GrowCount; c4Index++)
+        {
+            strName = L"AtomTest/Grow/";
+            strName.AppendFormatted(c4Index);
+            TAtom atmNew(strName);
+            colAtoms.objAdd(atmNew);
+            colSet.objAdd(atmNew);
+        }
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Atom::c4GrowCount; c4Index++)
+        {
+            strName = L"AtomTest/Grow/";
+            strName.AppendFormatted(c4Index);
+            TAtom atmFound;
+            if (!TAtom::bFind(strName, atmFound)
+            ||  (atmFound != colAtoms[c4Index])
+            ||  (colAtoms[c4Index].strText() != strName)
+            ||  !colSet.bHasElement(TAtom(strName)))
+            {
+                c4Bad++;
+            }
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" atoms were wrong after the table grew\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if ((TAtom::c4AtomCount() != c4Start + TestCIDLib2_Atom::c4GrowCount)
+        ||  (colSet.c4ElemCount() != TestCIDLib2_Atom::c4GrowCount))
+        {
+            strmOut << TFWCurLn << L"Atom counts were wrong after the table grew\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Have a bunch of threads intern the same names at the same time. They
+    //  should all get the same atoms, and each name should only be added once.
+    //
+    {
+        const tCIDLib::TCard4 c4Start = TAtom::c4AtomCount();
+        TThreadPool tpoolTest(L"AtomTest", TestCIDLib2_Atom::c4Tasks);
+
+        TAtom aatmFound[TestCIDLib2_Atom::c4Tasks][TestCIDLib2_Atom::c4TaskNames];
+        TVector<TThreadPool::TTaskPtr> colTasks(TestCIDLib2_Atom::c4Tasks);
+        for (tCIDLib::TCard4 c4TaskInd = 0; c4TaskInd < TestCIDLib2_Atom::c4Tasks; c4TaskInd++)
+        {
+            TAtom* patmTar = aatmFound[c4TaskInd];
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [patmTar](TThreadPoolTask&)
+                    {
+                        TString strName;
+                        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Atom::c4TaskNames; c4Index++)
+                        {
+                            strName = L"AtomTest/Shared/";
+                            strName.AppendFormatted(c4Index);
+                            patmTar[c4Index] = TAtom(strName);
+                        }
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4TaskInd = 0; c4TaskInd < TestCIDLib2_Atom::c4Tasks; c4TaskInd++)
+            colTasks[c4TaskInd]->bWaitDone();
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4TaskInd = 1; c4TaskInd < TestCIDLib2_Atom::c4Tasks; c4TaskInd++)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_Atom::c4TaskNames; c4Index++)
+            {
+                if (aatmFound[c4TaskInd][c4Index] != aatmFound[0][c4Index])
+                    c4Bad++;
+            }
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" atoms interned on other threads were different\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (TAtom::c4AtomCount() != c4Start + TestCIDLib2_Atom::c4TaskNames)
+        {
+            strmOut << TFWCurLn << L"Expected " << TestCIDLib2_Atom::c4TaskNames
+                    << L" new atoms from the threads but got "
+                    << (TAtom::c4AtomCount() - c4Start) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Log events keep their facility and file names as atoms. Make sure they
+    //  still give back the right text, survive a copy and streaming, and that the
+    //  same event check still works. The host, process and thread names must not
+    //  be interned, even when streamed in, since the table is never freed.
+    //
+    {
+        TLogEvent logevOne
+        (
+            L"AtomTestFac", L"SomePath/AtomTest.cpp", 10, L"Error one"
+        );
+        TLogEvent logevTwo
+        (
+            L"AtomTestFac", L"AtomTest.cpp", 20, L"Error two"
+        );
+        TLogEvent logevOther
+        (
+            L"AtomTestOther", L"AtomTest.cpp", 30, L"Error three"
+        );
+
+        if ((logevOne.strFacName() != L"AtomTestFac")
+        ||  (logevOne.strFileName() != L"AtomTest.cpp")
+        ||  (logevOne.strHostName() != TSysInfo::strIPHostName())
+        ||  (logevOne.strProcess() != TProcess::strProcessName()))
+        {
+            strmOut << TFWCurLn << L"Log event names were not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (!logevOne.bSameEvent(logevTwo)
+        ||  logevOne.bSameEvent(logevOther)
+        ||  !logevOne.bCheckEvent(L"AtomTestFac", 0))
+        {
+            strmOut << TFWCurLn << L"Log event same event checks failed\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        TLogEvent logevNames(logevTwo);
+        logevNames.strHostName(L"AtomTestHost_NotInterned");
+        logevNames.strThread(L"AtomTestThread_NotInterned");
+
+        TBinMBufOutStream strmTar(1024UL);
+        strmTar << logevOne << logevNames << kCIDLib::FlushIt;
+        TBinMBufInStream strmSrc(strmTar);
+        TLogEvent logevRead;
+        TLogEvent logevNamesRead;
+        strmSrc >> logevRead >> logevNamesRead;
+
+        TAtom atmFind;
+        if ((logevNamesRead.strHostName() != L"AtomTestHost_NotInterned")
+        ||  (logevNamesRead.strThread() != L"AtomTestThread_NotInterned")
+        ||  TAtom::bFind(L"AtomTestHost_NotInterned", atmFind)
+        ||  TAtom::bFind(L"AtomTestThread_NotInterned", atmFind))
+        {
+            strmOut << TFWCurLn << L"Log event host or thread names were interned\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        TLogEvent logevCopy(logevOne);
+        logevOne.Reset();
+
+        if ((logevRead.strFacName() != L"AtomTestFac")
+        ||  (logevRead.strThread() != logevCopy.strThread())
+        ||  (logevCopy.strFacName() != L"AtomTestFac")
+        ||  !logevRead.bSameEvent(logevCopy)
+        ||  !logevOne.strFacName().bIsEmpty())
+        {
+            strmOut << TFWCurLn << L"Log event copy or streaming lost the names\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // The stats cache keys are atoms now, so make sure key lookups still work
+    {
+        TStatsCacheItem sciTest;
+        TStatsCache::RegisterItem
+        (
+            L"/Stats/Test/Atom/Value", tCIDLib::EStatItemTypes::Value, sciTest
+        );
+        TStatsCache::SetValue(sciTest, 42);
+
+        TAtom atmKey;
+        if ((TStatsCache::c8CheckValue(L"/Stats/Test/Atom/Value") != 42)
+        ||  (TStatsCache::c8CheckValue(L"/Stats/Test/Atom/Missing") != 0)
+        ||  !TAtom::bFind(L"/Stats/Test/Atom/Value", atmKey))
+        {
+            strmOut << TFWCurLn << L"Stats cache lookup by key failed\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And time copying and comparing atoms against strings, for a typical
+    //  sort of name that's too long for the string's small buffer.
+    //
+    {
+        const TString strName(L"/Stats/Core/ThreadPool/AvgLatencyUS");
+        const TAtom atmName(strName);
+
+        tCIDLib::TCard4 c4Same = 0;
+        tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_Atom::c4TimeRounds; c4Round++)
+        {
+            TString strCopy(strName);
+            if (strCopy == strName)
+                c4Same++;
+        }
+        const tCIDLib::TCard8 c8StrMs = TTime::c8Millis() - c8Start;
+
+        c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_Atom::c4TimeRounds; c4Round++)
+        {
+            TAtom atmCopy(atmName);
+            if (atmCopy == atmName)
+                c4Same++;
+        }
+        const tCIDLib::TCard8 c8AtomMs = TTime::c8Millis() - c8Start;
+
+        c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_Atom::c4TimeRounds; c4Round++)
+        {
+            TAtom atmLookup(strName);
+            if (atmLookup == atmName)
+                c4Same++;
+        }
+        const tCIDLib::TCard8 c8InternMs = TTime::c8Millis() - c8Start;
+
+        strmOut << L"Copy/compare " << TestCIDLib2_Atom::c4TimeRounds << L" times. String: "
+                << c8StrMs << L"ms, atom: " << c8AtomMs << L"ms, intern existing: "
+                << c8InternMs << L"ms\n";
+
+        if (c4Same != TestCIDLib2_Atom::c4TimeRounds * 3)
+        {
+            strmOut << TFWCurLn << L"Timing copies did not compare equal\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    strmOut << L"\n";
+    return eRes;
+}
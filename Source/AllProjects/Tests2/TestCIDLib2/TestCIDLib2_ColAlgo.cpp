@@ -20,6 +20,9 @@
 //  we do have some simple ones for very common scenarios where performance is
 //  not an issue.
 //
+//  We also test the parallel versions here, comparing them against the
+//  serial results.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -38,6 +41,7 @@
 //  Magic macros
 // ---------------------------------------------------------------------------
 RTTIDecls(TTest_ColAlgo1, TTestFWTest)
+RTTIDecls(TTest_ColAlgo2, TTestFWTest)
 
 
 
@@ -576,3 +580,273 @@ tCIDLib::TBoolean TTest_ColAlgo1::bTestConstMap(const TVector<TCardinal>& colSrc
     }
     return kCIDLib::True;
 }
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ColAlgo2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_ColAlgo2: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_ColAlgo2::TTest_ColAlgo2() :
+
+    TTestFWTest
+    (
+        L"Collection Algorithms 2", L"Parallel collection algorithm tests", 4
+    )
+{
+}
+
+TTest_ColAlgo2::~TTest_ColAlgo2()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ColAlgo2: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_ColAlgo2::eRunTest(TTextStringOutStream&  strmOut
+                        , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  We use a small grain size so that we really get broken up into a lot of
+    //  chunks, and a count that isn't a nice multiple of anything.
+    //
+    const tCIDLib::TCard4 c4Grain = 256;
+    const tCIDLib::TCard4 c4Count = 50021;
+
+    //
+    //  Load up a list with pseudo-random values. The high 16 bits are the sort
+    //  key, and there are lots of dups. The low 16 bits hold the original order
+    //  so we can check that the sort is stable.
+    //
+    tCIDLib::TCardList fcolVals(c4Count);
+    tCIDLib::TCard4 c4Seed = 0x1234567;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        c4Seed = (c4Seed * 1103515245) + 12345;
+        fcolVals.c4AddElement(((c4Seed >> 8) & 0x3FF0000) | (c4Index & 0xFFFF));
+    }
+
+    auto KeyComp = [](const tCIDLib::TCard4 c41, const tCIDLib::TCard4 c42)
+    {
+        return tCIDLib::eComp(c41 >> 16, c42 >> 16);
+    };
+
+    // Sort it serially and in parallel and compare
+    {
+        tCIDLib::TCardList fcolSerial(fcolVals);
+        tCIDLib::TCardList fcolPar(fcolVals);
+        fcolSerial.Sort(KeyComp);
+        fcolPar.ParSort(KeyComp, c4Grain);
+
+        tCIDLib::TBoolean bMatched = kCIDLib::True;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            if (fcolSerial[c4Index] != fcolPar[c4Index])
+            {
+                bMatched = kCIDLib::False;
+                break;
+            }
+        }
+
+        if (!bMatched)
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            strmOut << TFWCurLn << L"Parallel sort did not match serial sort\n\n";
+        }
+
+        // And a small one that should stay serial
+        tCIDLib::TCardList fcolSmall(8);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+            fcolSmall.c4AddElement(8 - c4Index);
+        fcolSmall.ParSort(tCIDLib::TDefMagComp<tCIDLib::TCard4>());
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 8; c4Index++)
+        {
+            if (fcolSmall[c4Index] != c4Index + 1)
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+                strmOut << TFWCurLn << L"Parallel sort of small list failed\n\n";
+                break;
+            }
+        }
+    }
+
+    // Do a by reference one as well
+    {
+        TVector<TCardinal> colSerial(c4Count);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colSerial.objPlace(fcolVals[c4Index]);
+        TVector<TCardinal> colPar(colSerial);
+
+        auto ObjComp = [](const TCardinal& c1, const TCardinal& c2)
+        {
+            return tCIDLib::eComp(c1.c4Val() >> 16, c2.c4Val() >> 16);
+        };
+        colSerial.Sort(ObjComp);
+        colPar.ParSort(ObjComp, c4Grain);
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            if (colSerial[c4Index] != colPar[c4Index])
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+                strmOut << TFWCurLn << L"Parallel vector sort did not match serial sort\n\n";
+                break;
+            }
+        }
+    }
+
+    // Test the for each, and make sure every element gets hit exactly once
+    {
+        tCIDLib::TCardList fcolTest(fcolVals);
+        tCIDColAlgo::ParForEach
+        (
+            fcolTest
+            , [](tCIDLib::TCard4& c4Cur, const tCIDLib::TCard4 c4Index)
+              {
+                c4Cur = (c4Cur & 0xFFFF) + c4Index + 1;
+              }
+            , c4Grain
+        );
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            if (fcolTest[c4Index] != (fcolVals[c4Index] & 0xFFFF) + c4Index + 1)
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+                strmOut << TFWCurLn << L"Parallel for each failed at index "
+                        << c4Index << L"\n\n";
+                break;
+            }
+        }
+    }
+
+    // Compare map/reduce to the serial version
+    {
+        TVector<TCardinal> colSrcVals(c4Count);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colSrcVals.objPlace(c4Index & 0xFFF);
+
+        auto IsOdd = [](const TCardinal& cVal) -> tCIDLib::TBoolean { return (cVal.c4Val() & 0x1U) != 0; };
+        auto Sum = [](TCardinal& cAccum, const TCardinal& cVal) -> tCIDLib::TVoid { cAccum += cVal; };
+
+        const TCardinal cSerial = tCIDColAlgo::tMapReduce(colSrcVals, IsOdd, Sum, TCardinal(7UL));
+        const TCardinal cPar = tCIDColAlgo::tParMapReduce
+        (
+            colSrcVals, IsOdd, Sum, TCardinal(7UL), c4Grain
+        );
+
+        if (cSerial != cPar)
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            strmOut << TFWCurLn << L"Parallel map/reduce got " << cPar
+                    << L" but expected " << cSerial << L"\n\n";
+        }
+    }
+
+    //
+    //  Do a prefix scan. We use a non-commutative operation, keeping the last
+    //  non-zero value seen, to make sure the chunks get combined in order.
+    //
+    {
+        tCIDLib::TCardList fcolOnes(c4Count);
+        tCIDLib::TCardList fcolLast(c4Count);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            fcolOnes.c4AddElement(1);
+            fcolLast.c4AddElement(((c4Index % 1000) == 0) ? c4Index + 1 : 0);
+        }
+
+        tCIDColAlgo::ParPrefixScan
+        (
+            fcolOnes
+            , [](tCIDLib::TCard4& c4Accum, const tCIDLib::TCard4 c4Val) { c4Accum += c4Val; }
+            , c4Grain
+        );
+
+        tCIDColAlgo::ParPrefixScan
+        (
+            fcolLast
+            , [](tCIDLib::TCard4& c4Accum, const tCIDLib::TCard4 c4Val)
+              {
+                if (c4Val)
+                    c4Accum = c4Val;
+              }
+            , c4Grain
+        );
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            if (fcolOnes[c4Index] != c4Index + 1)
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+                strmOut << TFWCurLn << L"Parallel sum scan failed at index "
+                        << c4Index << L"\n\n";
+                break;
+            }
+
+            if (fcolLast[c4Index] != ((c4Index / 1000) * 1000) + 1)
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+                strmOut << TFWCurLn << L"Parallel ordered scan failed at index "
+                        << c4Index << L"\n\n";
+                break;
+            }
+        }
+    }
+
+    // Make sure an exception in a chunk gets back to us
+    {
+        tCIDLib::TCardList fcolTest(fcolVals);
+        tCIDLib::TBoolean bCaught = kCIDLib::False;
+        try
+        {
+            tCIDColAlgo::ParForEach
+            (
+                fcolTest
+                , [c4Count](tCIDLib::TCard4&, const tCIDLib::TCard4 c4Index)
+                  {
+                    if (c4Index == c4Count - 1)
+                    {
+                        facCIDLib().ThrowErr
+                        (
+                            CID_FILE
+                            , CID_LINE
+                            , kCIDErrs::errcGen_IndexError
+                            , tCIDLib::ESeverities::Failed
+                            , tCIDLib::EErrClasses::Index
+                            , TCardinal(c4Index)
+                            , TString(L"ParForEach")
+                            , TCardinal(c4Count)
+                        );
+                    }
+                  }
+                , c4Grain
+            );
+        }
+
+        catch(TError& errToCatch)
+        {
+            bCaught = errToCatch.bCheckEvent
+            (
+                facCIDLib().strName(), kCIDErrs::errcGen_IndexError
+            );
+        }
+
+        if (!bCaught)
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            strmOut << TFWCurLn << L"Parallel chunk error was not propogated\n\n";
+        }
+    }
+
+    return eRes;
+}
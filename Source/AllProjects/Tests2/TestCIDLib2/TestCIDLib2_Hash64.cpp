@@ -0,0 +1,299 @@
+//
+// FILE NAME: TestCIDLib2_Hash64.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests of the fast 64 bit hash, for buffers and strings,
+//  and the key ops that use it. It also times it against the standard string
+//  hash.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The known answers must be the same on all platforms, so if they fail on
+//      one only, that's a real problem, not a test issue.
+//
+//  2)  The times are only reported, they are not checked.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_Hash64,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_Hash64
+    {
+        // -----------------------------------------------------------------------
+        //  A known answer test, which we check with a zero seed and a seed of
+        //  1234.
+        // -----------------------------------------------------------------------
+        struct TKnownAnswer
+        {
+            const tCIDLib::TCh* pszText;
+            tCIDLib::TCard8     c8Hash;
+            tCIDLib::TCard8     c8Seeded;
+        };
+
+        const TKnownAnswer aKnownAnswers[] =
+        {
+            { L"", 0x4BC84D4BE8D47094, 0x77991F6BF2045923 }
+          , { L"a", 0x6A3BE2359797F13B, 0x84413742A1C7AA34 }
+          , { L"Hello", 0xA5CA389A033063ED, 0xFB86BDF9906DC520 }
+          , { L"CIDLib string hash", 0xCB032C9F44DBE220, 0x9460A1AC335C1C3B }
+          , { L"The quick brown fox jumps over the lazy dog", 0xD732D750CBA35E8E, 0xB2A2BA6BCBD87283 }
+          , { L"Sm\x00F6rg\x00E5sbord \x4E2D\x6587 \U0001F600", 0xE78C655292E44D39, 0xC9E064CFE376BF66 }
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  c4TimeRounds
+        //      The number of times we hash the list of strings when timing.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4TimeRounds = 2000;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Hash64
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Hash64: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Hash64::TTest_Hash64() :
+
+    TTestFWTest
+    (
+        L"Hash64", L"Tests and timing of the fast 64 bit hash", 3
+    )
+{
+}
+
+TTest_Hash64::~TTest_Hash64()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Hash64: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Hash64::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // Check the known answers
+    for (const TestCIDLib2_Hash64::TKnownAnswer& kaCur : TestCIDLib2_Hash64::aKnownAnswers)
+    {
+        if ((TRawStr::c8HashStr64(kaCur.pszText) != kaCur.c8Hash)
+        ||  (TRawStr::c8HashStr64(kaCur.pszText, kCIDLib::c4MaxCard, kCIDLib::True, 1234) != kaCur.c8Seeded)
+        ||  (TString(kaCur.pszText).c8CalcHash64() != kaCur.c8Hash))
+        {
+            strmOut << TFWCurLn << L"Known answer failed for: " << kaCur.pszText << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  A buffer's hash should be the same whether it's done all at once or via a
+    //  memory buffer. Do every length up to a few stripes, to cover the tail
+    //  handling, and make sure that each length is different from the previous.
+    //
+    {
+        tCIDLib::TCard1 ac1Data[100];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 100; c4Index++)
+            ac1Data[c4Index] = tCIDLib::TCard1(c4Index);
+
+        if (TRawMem::c8HashBuffer64(ac1Data, 100) != 0x0387B04B0D8F23D1)
+        {
+            strmOut << TFWCurLn << L"Known answer failed for the buffer hash\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        THeapBuf mbufData(ac1Data, 100);
+        tCIDLib::TCard4 c4Bad = 0;
+        tCIDLib::TCard8 c8Prev = 0;
+        for (tCIDLib::TCard4 c4Len = 0; c4Len <= 100; c4Len++)
+        {
+            const tCIDLib::TCard8 c8Hash = TRawMem::c8HashBuffer64(ac1Data, c4Len);
+            if ((c8Hash == c8Prev) || (mbufData.c8CalcHash64(0, c4Len) != c8Hash))
+                c4Bad++;
+            c8Prev = c8Hash;
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" buffer hash lengths were wrong\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  A string's hash is defined as the hash of its UTF-16 form. So build that
+    //  up by hand for some strings of various lengths, and compare them. Every
+    //  fifth char is Greek, so that high bytes get exercised.
+    //
+    {
+        tCIDLib::TCard4 c4Bad = 0;
+        tCIDLib::TCard1 ac1Utf16[256];
+        TString strTest;
+        for (tCIDLib::TCard4 c4Len = 0; c4Len < 100; c4Len++)
+        {
+            strTest.Clear();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Len; c4Index++)
+            {
+                const tCIDLib::TCh chCur = tCIDLib::TCh
+                (
+                    ((c4Index % 5) ? L'A' : 0x391) + ((c4Index * 7) % 17)
+                );
+                strTest.Append(chCur);
+                ac1Utf16[c4Index * 2] = tCIDLib::TCard1(chCur & 0xFF);
+                ac1Utf16[(c4Index * 2) + 1] = tCIDLib::TCard1((chCur >> 8) & 0xFF);
+            }
+
+            if (strTest.c8CalcHash64() != TRawMem::c8HashBuffer64(ac1Utf16, c4Len * 2))
+                c4Bad++;
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" string hashes didn't match their UTF-16 form\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Case insensitive should be the same as hashing a lower cased copy
+    {
+        TString strMixed(L"This Is Some MIXED case TEXT, Long Enough For A Stripe Or Two");
+        TString strLower(strMixed);
+        strLower.ToLower();
+        if ((strMixed.c8CalcHash64(kCIDLib::False) != strLower.c8CalcHash64())
+        ||  (strMixed.c8CalcHash64() == strLower.c8CalcHash64()))
+        {
+            strmOut << TFWCurLn << L"Case insensitive hash was not correct\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Make sure the key ops work in a hash set, case sensitive and not
+    {
+        tCIDLib::TBoolean bOk = kCIDLib::True;
+        THashSet<TString, TFastStringKeyOps> colSens(29, TFastStringKeyOps(kCIDLib::True));
+        THashSet<TString, TFastStringKeyOps> colInsens(29, TFastStringKeyOps(kCIDLib::False));
+        TString strVal;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 500; c4Index++)
+        {
+            strVal = L"Key_";
+            strVal.AppendFormatted(c4Index);
+            colSens.objAdd(strVal);
+            colInsens.objAdd(strVal);
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 500; c4Index++)
+        {
+            strVal = L"KEY_";
+            strVal.AppendFormatted(c4Index);
+            if (colSens.bHasElement(strVal) || !colInsens.bHasElement(strVal))
+                bOk = kCIDLib::False;
+
+            strVal = L"Key_";
+            strVal.AppendFormatted(c4Index);
+            if (!colSens.bHasElement(strVal))
+                bOk = kCIDLib::False;
+        }
+
+        if (!bOk)
+        {
+            strmOut << TFWCurLn << L"Fast key ops hash set lookups failed\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And time it against the standard string hash, on some typical key sized
+    //  strings and some longer ones. We call the raw hashes, since the string
+    //  class caches the standard one.
+    //
+    {
+        TVector<TString> colStrs;
+        tCIDLib::TCard4 c4Chars = 0;
+        TString strVal;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 200; c4Index++)
+        {
+            strVal = L"/Some/Path/To/";
+            strVal.AppendFormatted(c4Index);
+            for (tCIDLib::TCard4 c4Rep = 0; c4Rep < (c4Index % 8); c4Rep++)
+                strVal.Append(L"/AndSomeMoreText");
+            c4Chars += strVal.c4Length();
+            colStrs.objAdd(strVal);
+        }
+
+        const tCIDLib::TCard4 c4Count = colStrs.c4ElemCount();
+        tCIDLib::TCard4 c4Sum = 0;
+        tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_Hash64::c4TimeRounds; c4Round++)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+                c4Sum += TRawStr::hshHashStr(colStrs[c4Index].pszBuffer(), 109);
+        }
+        const tCIDLib::TCard8 c8OldMs = TTime::c8Millis() - c8Start;
+
+        tCIDLib::TCard8 c8Sum = 0;
+        c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_Hash64::c4TimeRounds; c4Round++)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                const TString& strCur = colStrs[c4Index];
+                c8Sum += TRawStr::c8HashStr64(strCur.pszBuffer(), strCur.c4Length());
+            }
+        }
+        const tCIDLib::TCard8 c8NewMs = TTime::c8Millis() - c8Start;
+
+        const tCIDLib::TFloat8 f8MB
+        (
+            (tCIDLib::TFloat8(c4Chars) * TestCIDLib2_Hash64::c4TimeRounds) / (1024.0 * 1024.0)
+        );
+        strmOut << L"Hashed " << f8MB << L"M chars. Standard hash: " << c8OldMs
+                << L"ms, 64 bit hash: " << c8NewMs << L"ms\n";
+
+        // Just to use the sums, so they can't be optimized away
+        if (!c4Sum || !c8Sum)
+            strmOut << L"Unexpected zero hash sum\n";
+    }
+
+    strmOut << L"\n";
+    return eRes;
+}
@@ -0,0 +1,526 @@
+//
+// FILE NAME: TestCIDLib2_RWLock.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests related to the reader/writer lock, the sequence lock,
+//  and collections that use shared locking.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_RWLock,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_RWLock
+    {
+        // -----------------------------------------------------------------------
+        //  c4Readers
+        //  c4Writers
+        //      The number of reader and writer threads we use in the threaded
+        //      tests.
+        //
+        //  c4Rounds
+        //      The number of times each writer updates the protected data.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Readers   = 4;
+        constexpr tCIDLib::TCard4   c4Writers   = 2;
+        constexpr tCIDLib::TCard4   c4Rounds    = 20000;
+
+
+        // -----------------------------------------------------------------------
+        //  A simple pair of values that are always written to be the same, so
+        //  readers can see if they ever get a torn read.
+        // -----------------------------------------------------------------------
+        struct TValPair
+        {
+            tCIDLib::TCard4 c4Val1;
+            tCIDLib::TCard4 c4Val2;
+        };
+
+
+        // Return true if the error is the indicated CIDLib error
+        tCIDLib::TBoolean bCheckErr(const TError& errToCheck, const tCIDLib::TErrCode errcToCheck)
+        {
+            return errToCheck.bCheckEvent(facCIDLib().strName(), errcToCheck);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RWLock
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_RWLock: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_RWLock::TTest_RWLock() :
+
+    TTestFWTest
+    (
+        L"RW Locks", L"Tests of the reader/writer and sequence locks", 4
+    )
+{
+}
+
+TTest_RWLock::~TTest_RWLock()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RWLock: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_RWLock::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    if (!bSingleThreadTests(strmOut))
+        eRes = tTestFWLib::ETestRes::Failed;
+
+    TThreadPool tpoolTest
+    (
+        L"RWLockTest", TestCIDLib2_RWLock::c4Readers + TestCIDLib2_RWLock::c4Writers
+    );
+
+    //
+    //  While we hold it shared, another thread should be able to get it shared,
+    //  but not exclusive. Once we let it go, it should be able to get it exclusive.
+    //
+    {
+        TRWLock rwlTest;
+        rwlTest.LockShared();
+
+        tCIDLib::TBoolean bGotShared = kCIDLib::False;
+        tCIDLib::TBoolean bGotExcl = kCIDLib::True;
+        TThreadPool::TTaskPtr cptrTest = tpoolTest.cptrRun
+        (
+            [&rwlTest, &bGotShared, &bGotExcl](TThreadPoolTask&)
+            {
+                bGotShared = rwlTest.bTryLockShared(0);
+                if (bGotShared)
+                    rwlTest.UnlockShared();
+
+                bGotExcl = rwlTest.bTryLock(50);
+                if (bGotExcl)
+                    rwlTest.Unlock();
+            }
+        );
+        cptrTest->bWaitDone(10000);
+
+        if (!bGotShared)
+        {
+            strmOut << TFWCurLn << L"Second reader could not get a shared lock\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (bGotExcl)
+        {
+            strmOut << TFWCurLn << L"Writer got the lock while a reader had it\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        rwlTest.UnlockShared();
+        cptrTest = tpoolTest.cptrRun
+        (
+            [&rwlTest, &bGotExcl](TThreadPoolTask&)
+            {
+                bGotExcl = rwlTest.bTryLock(5000);
+                if (bGotExcl)
+                    rwlTest.Unlock();
+            }
+        );
+        cptrTest->bWaitDone(10000);
+
+        if (!bGotExcl)
+        {
+            strmOut << TFWCurLn << L"Writer could not get the lock once it was free\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Have some writers update a pair of values under an exclusive lock, and some
+    //  readers check them under a shared lock. The readers should never see them
+    //  differ, and at the end the writers' updates should all be there.
+    //
+    {
+        TRWLock rwlTest;
+        TestCIDLib2_RWLock::TValPair Vals{ 0, 0 };
+        TSafeCard4Counter scntBad;
+        TSafeCard4Counter scntWritersDone;
+
+        TVector<TThreadPool::TTaskPtr> colTasks
+        (
+            TestCIDLib2_RWLock::c4Readers + TestCIDLib2_RWLock::c4Writers
+        );
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_RWLock::c4Writers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&rwlTest, &Vals, &scntWritersDone](TThreadPoolTask&)
+                    {
+                        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_RWLock::c4Rounds; c4Round++)
+                        {
+                            TLocker lockrWrite(&rwlTest);
+                            Vals.c4Val1++;
+                            Vals.c4Val2++;
+                        }
+                        scntWritersDone++;
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_RWLock::c4Readers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&rwlTest, &Vals, &scntBad, &scntWritersDone](TThreadPoolTask&)
+                    {
+                        while (scntWritersDone.c4Value() < TestCIDLib2_RWLock::c4Writers)
+                        {
+                            TSharedLocker lockrRead(&rwlTest);
+                            if (Vals.c4Val1 != Vals.c4Val2)
+                                scntBad++;
+                        }
+                    }
+                )
+            );
+        }
+
+        const tCIDLib::TCard4 c4Count = colTasks.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colTasks[c4Index]->bWaitDone();
+
+        const tCIDLib::TCard4 c4Expected
+        (
+            TestCIDLib2_RWLock::c4Writers * TestCIDLib2_RWLock::c4Rounds
+        );
+        if ((Vals.c4Val1 != c4Expected) || (Vals.c4Val2 != c4Expected))
+        {
+            strmOut << TFWCurLn << L"Expected RW lock values of " << c4Expected
+                    << L" but got " << Vals.c4Val1 << L"/" << Vals.c4Val2 << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (scntBad.c4Value())
+        {
+            strmOut << TFWCurLn << L"Readers saw " << scntBad.c4Value()
+                    << L" inconsistent RW lock values\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Do the same sort of thing for the sequence lock
+    {
+        TSeqLockedVal<TestCIDLib2_RWLock::TValPair> sqlvTest(TestCIDLib2_RWLock::TValPair{ 0, 0 });
+        TSafeCard4Counter scntBad;
+        TSafeCard4Counter scntWritersDone;
+
+        TVector<TThreadPool::TTaskPtr> colTasks
+        (
+            TestCIDLib2_RWLock::c4Readers + TestCIDLib2_RWLock::c4Writers
+        );
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_RWLock::c4Writers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&sqlvTest, &scntWritersDone](TThreadPoolTask&)
+                    {
+                        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_RWLock::c4Rounds; c4Round++)
+                        {
+                            sqlvTest.Update
+                            (
+                                [](TestCIDLib2_RWLock::TValPair& Upd)
+                                {
+                                    Upd.c4Val1++;
+                                    Upd.c4Val2++;
+                                }
+                            );
+                        }
+                        scntWritersDone++;
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_RWLock::c4Readers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&sqlvTest, &scntBad, &scntWritersDone](TThreadPoolTask&)
+                    {
+                        while (scntWritersDone.c4Value() < TestCIDLib2_RWLock::c4Writers)
+                        {
+                            const TestCIDLib2_RWLock::TValPair Cur = sqlvTest.tValue();
+                            if (Cur.c4Val1 != Cur.c4Val2)
+                                scntBad++;
+                        }
+                    }
+                )
+            );
+        }
+
+        const tCIDLib::TCard4 c4Count = colTasks.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colTasks[c4Index]->bWaitDone();
+
+        const tCIDLib::TCard4 c4Expected
+        (
+            TestCIDLib2_RWLock::c4Writers * TestCIDLib2_RWLock::c4Rounds
+        );
+        const TestCIDLib2_RWLock::TValPair Final = sqlvTest.tValue();
+        if ((Final.c4Val1 != c4Expected) || (Final.c4Val2 != c4Expected))
+        {
+            strmOut << TFWCurLn << L"Expected seq lock values of " << c4Expected
+                    << L" but got " << Final.c4Val1 << L"/" << Final.c4Val2 << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (scntBad.c4Value())
+        {
+            strmOut << TFWCurLn << L"Readers saw " << scntBad.c4Value()
+                    << L" inconsistent seq lock values\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RWLock: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Checks the nesting rules and the errors for misuse, and a shared safe collection,
+//  all of which we can do from a single thread.
+//
+tCIDLib::TBoolean TTest_RWLock::bSingleThreadTests(TTextStringOutStream& strmOut)
+{
+    tCIDLib::TBoolean bRes = kCIDLib::True;
+
+    TRWLock rwlTest;
+
+    // The exclusive owner can nest in either mode
+    rwlTest.Lock();
+    rwlTest.Lock();
+    rwlTest.LockShared();
+    rwlTest.UnlockShared();
+    rwlTest.Unlock();
+    rwlTest.Unlock();
+
+    // Unlocking it again now should be caught, since we don't own it
+    try
+    {
+        rwlTest.Unlock();
+        strmOut << TFWCurLn << L"Unlock of an unowned RW lock was not caught\n\n";
+        bRes = kCIDLib::False;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!TestCIDLib2_RWLock::bCheckErr(errToCatch, kCIDErrs::errcRWL_NotOwner))
+        {
+            strmOut << TFWCurLn << L"Got the wrong error for an unowned unlock\n\n";
+            bRes = kCIDLib::False;
+        }
+    }
+
+    //
+    //  A shared owner can nest shared locks, but cannot take it exclusive. That
+    //  would deadlock, so it has to be caught.
+    //
+    rwlTest.LockShared();
+    rwlTest.LockShared();
+    try
+    {
+        rwlTest.Lock(0);
+        rwlTest.Unlock();
+        strmOut << TFWCurLn << L"Upgrade of a shared RW lock was not caught\n\n";
+        bRes = kCIDLib::False;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!TestCIDLib2_RWLock::bCheckErr(errToCatch, kCIDErrs::errcRWL_CantUpgrade))
+        {
+            strmOut << TFWCurLn << L"Got the wrong error for a lock upgrade\n\n";
+            bRes = kCIDLib::False;
+        }
+    }
+    rwlTest.UnlockShared();
+    rwlTest.UnlockShared();
+
+    // And now it should be completely free again
+    if (!rwlTest.bTryLock(0))
+    {
+        strmOut << TFWCurLn << L"RW lock was not free after shared unlocks\n\n";
+        bRes = kCIDLib::False;
+    }
+     else
+    {
+        rwlTest.Unlock();
+    }
+
+    // Unlocking a shared lock we don't hold should be caught as well
+    try
+    {
+        rwlTest.UnlockShared();
+        strmOut << TFWCurLn << L"Shared unlock of an unowned RW lock was not caught\n\n";
+        bRes = kCIDLib::False;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!TestCIDLib2_RWLock::bCheckErr(errToCatch, kCIDErrs::errcRWL_NotShared))
+        {
+            strmOut << TFWCurLn << L"Got the wrong error for an unowned shared unlock\n\n";
+            bRes = kCIDLib::False;
+        }
+    }
+
+    //
+    //  We can hold up to the max number of shared locks at once. One more has to
+    //  be rejected, and not left locked.
+    //
+    {
+        TRWLock arwlMany[TRWLock::c4MaxShared + 1];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TRWLock::c4MaxShared; c4Index++)
+            arwlMany[c4Index].LockShared();
+
+        TRWLock& rwlExtra = arwlMany[TRWLock::c4MaxShared];
+        try
+        {
+            rwlExtra.LockShared();
+            rwlExtra.UnlockShared();
+            strmOut << TFWCurLn << L"Too many shared locks was not caught\n\n";
+            bRes = kCIDLib::False;
+        }
+
+        catch(const TError& errToCatch)
+        {
+            if (!TestCIDLib2_RWLock::bCheckErr(errToCatch, kCIDErrs::errcRWL_TooManyShared))
+            {
+                strmOut << TFWCurLn << L"Got the wrong error for too many shared locks\n\n";
+                bRes = kCIDLib::False;
+            }
+        }
+
+        if (!rwlExtra.bTryLock(0))
+        {
+            strmOut << TFWCurLn << L"Rejected shared lock was left locked\n\n";
+            bRes = kCIDLib::False;
+        }
+         else
+        {
+            rwlExtra.Unlock();
+        }
+
+        // Nesting still works on the ones we hold
+        arwlMany[0].LockShared();
+        arwlMany[0].UnlockShared();
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TRWLock::c4MaxShared; c4Index++)
+            arwlMany[c4Index].UnlockShared();
+
+        // And now there's room again
+        rwlExtra.LockShared();
+        rwlExtra.UnlockShared();
+    }
+
+    //
+    //  Create a shared safe collection. Read only methods take a shared lock, which
+    //  has to nest inside an explicit lock of the collection in either mode.
+    //
+    TVector<TString> colShared(8, tCIDLib::EMTStates::SharedSafe);
+    if (colShared.eMTSafe() != tCIDLib::EMTStates::SharedSafe)
+    {
+        strmOut << TFWCurLn << L"Collection did not report the shared safe state\n\n";
+        bRes = kCIDLib::False;
+    }
+
+    colShared.objAdd(TString(L"Value 1"));
+    colShared.objAdd(TString(L"Value 2"));
+    {
+        TLocker lockrCol(&colShared);
+        colShared.objAdd(TString(L"Value 3"));
+        if (colShared[2] != L"Value 3")
+        {
+            strmOut << TFWCurLn << L"Got wrong value from shared safe collection\n\n";
+            bRes = kCIDLib::False;
+        }
+    }
+
+    {
+        TSharedLocker lockrCol(&colShared);
+        if (colShared.c4ElemCount() != 3)
+        {
+            strmOut << TFWCurLn << L"Expected 3 elements in shared safe collection\n\n";
+            bRes = kCIDLib::False;
+        }
+    }
+
+    // A copy should get the same thread safety state
+    TVector<TString> colCopy(colShared);
+    if (colCopy.eMTSafe() != tCIDLib::EMTStates::SharedSafe)
+    {
+        strmOut << TFWCurLn << L"Collection copy did not get the shared safe state\n\n";
+        bRes = kCIDLib::False;
+    }
+
+    // And we should be able to change it back to a regular safe one
+    colCopy.Reset(tCIDLib::EMTStates::Safe, 8);
+    if (colCopy.eMTSafe() != tCIDLib::EMTStates::Safe)
+    {
+        strmOut << TFWCurLn << L"Collection did not go back to regular safe state\n\n";
+        bRes = kCIDLib::False;
+    }
+    return bRes;
+}
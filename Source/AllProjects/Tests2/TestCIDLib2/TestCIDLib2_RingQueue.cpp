@@ -0,0 +1,512 @@
+//
+// FILE NAME: TestCIDLib2_RingQueue.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests related to the lock free ring queues. Along with the
+//  correctness tests, it reports the time to move a fixed number of elements
+//  through a ring queue and through a TQueue, for various producer counts.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_RingQueue,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_RingQueue
+    {
+        // -----------------------------------------------------------------------
+        //  c4MaxProducers
+        //      The most producers we test with, which sets the size of our pool.
+        //
+        //  c4TimingCnt
+        //      The number of elements pushed through the queues for the timing
+        //      comparisons, split across the producers.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxProducers  = 16;
+        constexpr tCIDLib::TCard4   c4TimingCnt     = 0x40000;
+
+
+        // -----------------------------------------------------------------------
+        //  Run the passed number of producers, each of which calls fnPut for
+        //  c4PerProd values, and one consumer which calls fnGet until it has gotten
+        //  them all. The consumer sums up what it gets, and we return the time it
+        //  took, or zero if the sum was wrong.
+        // -----------------------------------------------------------------------
+        template <typename TPutFunc, typename TGetFunc>
+        tCIDLib::TCard8 c8RunProducers(         TThreadPool&        tpoolTest
+                                        , const tCIDLib::TCard4     c4Producers
+                                        , const tCIDLib::TCard4     c4PerProd
+                                        ,       TPutFunc            fnPut
+                                        ,       TGetFunc            fnGet)
+        {
+            const tCIDLib::TCard4 c4Total = c4Producers * c4PerProd;
+            tCIDLib::TCard8 c8Sum = 0;
+
+            const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+            TThreadPool::TTaskPtr cptrCons = tpoolTest.cptrRun
+            (
+                [&c8Sum, c4Total, &fnGet](TThreadPoolTask&)
+                {
+                    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Total; c4Index++)
+                        c8Sum += fnGet();
+                }
+            );
+
+            TVector<TThreadPool::TTaskPtr> colProds(c4Producers);
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Producers; c4Index++)
+            {
+                colProds.objAdd
+                (
+                    tpoolTest.cptrRun
+                    (
+                        [c4PerProd, &fnPut](TThreadPoolTask&)
+                        {
+                            for (tCIDLib::TCard4 c4Val = 1; c4Val <= c4PerProd; c4Val++)
+                                fnPut(c4Val);
+                        }
+                    )
+                );
+            }
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Producers; c4Index++)
+                colProds[c4Index]->bWaitDone();
+            cptrCons->bWaitDone();
+            const tCIDLib::TCard8 c8End = TTime::c8Millis();
+
+            const tCIDLib::TCard8 c8Expected
+            (
+                tCIDLib::TCard8(c4Producers) * ((tCIDLib::TCard8(c4PerProd) * (c4PerProd + 1)) / 2)
+            );
+            if (c8Sum != c8Expected)
+                return 0;
+
+            // Don't return zero for a really fast run
+            return tCIDLib::MaxVal(c8End - c8Start, tCIDLib::TCard8(1));
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RingQueue
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_RingQueue: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_RingQueue::TTest_RingQueue() :
+
+    TTestFWTest
+    (
+        L"Ring Queues", L"Tests of the lock free SPSC and MPMC ring queues", 4
+    )
+{
+}
+
+TTest_RingQueue::~TTest_RingQueue()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RingQueue: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_RingQueue::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // The size should be rounded up to a power of two, and zero is not allowed
+    {
+        TSPSCRingQ<tCIDLib::TCard4> colTest(5);
+        if (colTest.c4MaxElems() != 8)
+        {
+            strmOut << TFWCurLn << L"Expected max elems of 8 but got "
+                    << colTest.c4MaxElems() << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        try
+        {
+            TMPMCRingQ<tCIDLib::TCard4> colBad(0);
+            strmOut << TFWCurLn << L"A zero sized ring queue was not caught\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        catch(const TError& errToCatch)
+        {
+            if (!errToCatch.bCheckEvent(facCIDLib().strName(), kCIDErrs::errcCol_ZeroSize))
+            {
+                strmOut << TFWCurLn << L"Got the wrong error for a zero sized queue\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    // Do the single threaded checks on both of them
+    if (!bBasicTests(TSPSCRingQ<TString>(16), L"SPSC", strmOut))
+        eRes = tTestFWLib::ETestRes::Failed;
+    if (!bBasicTests(TMPMCRingQ<TString>(16), L"MPMC", strmOut))
+        eRes = tTestFWLib::ETestRes::Failed;
+
+    //
+    //  Push a bunch of values through a small SPSC queue from another thread. They
+    //  have to come out in order. The producer does batches of varying sizes to
+    //  exercise the wrap around.
+    //
+    TThreadPool tpoolTest(L"RingQTest", TestCIDLib2_RingQueue::c4MaxProducers + 2);
+    {
+        const tCIDLib::TCard4 c4Count = 100000;
+        TSPSCRingQ<tCIDLib::TCard4> colSPSC(64);
+
+        TThreadPool::TTaskPtr cptrProd = tpoolTest.cptrRun
+        (
+            [&colSPSC](TThreadPoolTask&)
+            {
+                tCIDLib::TCard4 ac4Batch[7];
+                tCIDLib::TCard4 c4Next = 0;
+                while (c4Next < c4Count)
+                {
+                    const tCIDLib::TCard4 c4BatchSz = tCIDLib::MinVal
+                    (
+                        (c4Next % 7) + 1, c4Count - c4Next
+                    );
+                    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BatchSz; c4Index++)
+                        ac4Batch[c4Index] = c4Next + c4Index;
+                    c4Next += colSPSC.c4PutBatch(ac4Batch, c4BatchSz, 5000);
+                }
+            }
+        );
+
+        tCIDLib::TCard4 c4Expected = 0;
+        tCIDLib::TCard4 c4Val;
+        while (c4Expected < c4Count)
+        {
+            if (!colSPSC.bGetNext(c4Val, 5000))
+            {
+                strmOut << TFWCurLn << L"Timed out on SPSC get\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+                break;
+            }
+
+            if (c4Val != c4Expected)
+            {
+                strmOut << TFWCurLn << L"Expected SPSC value " << c4Expected
+                        << L" but got " << c4Val << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+                break;
+            }
+            c4Expected++;
+        }
+        cptrProd->bWaitDone(10000);
+    }
+
+    //
+    //  Do multiple producers and consumers through a small MPMC queue. Each value
+    //  should come out exactly once. Each producer puts a distinct range of values
+    //  and we mark them off as they are seen.
+    //
+    {
+        const tCIDLib::TCard4 c4Producers = 4;
+        const tCIDLib::TCard4 c4Consumers = 4;
+        const tCIDLib::TCard4 c4PerProd = 20000;
+        const tCIDLib::TCard4 c4Total = c4Producers * c4PerProd;
+
+        TMPMCRingQ<tCIDLib::TCard4> colMPMC(32);
+        TFundArray<tCIDLib::TCard4> fcolSeen(c4Total);
+        fcolSeen.SetAll(0);
+        TSafeCard4Counter scntGot;
+
+        TVector<TThreadPool::TTaskPtr> colTasks(c4Producers + c4Consumers);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Consumers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&colMPMC, &fcolSeen, &scntGot](TThreadPoolTask&)
+                    {
+                        tCIDLib::TCard4 ac4Batch[4];
+                        while (scntGot.c4Value() < c4Total)
+                        {
+                            const tCIDLib::TCard4 c4Got = colMPMC.c4GetBatch(ac4Batch, 4, 20);
+                            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Got; c4BInd++)
+                                TAtomic::c4SafeAcquire(fcolSeen[ac4Batch[c4BInd]]);
+                            scntGot.c4AddTo(c4Got);
+                        }
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Producers; c4Index++)
+        {
+            const tCIDLib::TCard4 c4Base = c4Index * c4PerProd;
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&colMPMC, c4Base](TThreadPoolTask&)
+                    {
+                        for (tCIDLib::TCard4 c4Val = 0; c4Val < c4PerProd; c4Val++)
+                            colMPMC.bPut(c4Base + c4Val);
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < colTasks.c4ElemCount(); c4Index++)
+        {
+            if (!colTasks[c4Index]->bWaitDone(20000))
+            {
+                strmOut << TFWCurLn << L"Timed out waiting for MPMC tasks\n\n";
+                return tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Total; c4Index++)
+        {
+            if (fcolSeen[c4Index] != 1)
+                c4Bad++;
+        }
+
+        if (c4Bad || !colMPMC.bIsEmpty())
+        {
+            strmOut << TFWCurLn << c4Bad << L" MPMC values were not seen exactly once\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And report the relative times of the ring queue and TQueue, for various
+    //  producer counts, with a single consumer. This is informational only.
+    //
+    strmOut << L"Producers   MPMC(ms)   TQueue(ms)\n";
+    for (tCIDLib::TCard4 c4Producers = 1;
+                c4Producers <= TestCIDLib2_RingQueue::c4MaxProducers; c4Producers <<= 1)
+    {
+        const tCIDLib::TCard4 c4PerProd = TestCIDLib2_RingQueue::c4TimingCnt / c4Producers;
+
+        TMPMCRingQ<TCardinal> colRing(1024);
+        const tCIDLib::TCard8 c8RingMS = TestCIDLib2_RingQueue::c8RunProducers
+        (
+            tpoolTest
+            , c4Producers
+            , c4PerProd
+            , [&colRing](const tCIDLib::TCard4 c4Val) { colRing.bPut(TCardinal(c4Val)); }
+            , [&colRing]()
+              {
+                TCardinal cVal;
+                colRing.bGetNext(cVal);
+                return cVal.c4Val();
+              }
+        );
+
+        TQueue<TCardinal> colQ(tCIDLib::EMTStates::Safe);
+        const tCIDLib::TCard8 c8QueueMS = TestCIDLib2_RingQueue::c8RunProducers
+        (
+            tpoolTest
+            , c4Producers
+            , c4PerProd
+            , [&colQ](const tCIDLib::TCard4 c4Val) { colQ.objPut(TCardinal(c4Val)); }
+            , [&colQ]()
+              {
+                TCardinal cVal;
+                colQ.bGetNext(cVal, kCIDLib::c4MaxWait);
+                return cVal.c4Val();
+              }
+        );
+
+        if (!c8RingMS || !c8QueueMS)
+        {
+            strmOut << TFWCurLn << L"Got the wrong sum with " << c4Producers
+                    << L" producers\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+            break;
+        }
+
+        strmOut << TTextOutStream::Spaces(4) << c4Producers
+                << TTextOutStream::Spaces(10) << c8RingMS
+                << TTextOutStream::Spaces(10) << c8QueueMS << kCIDLib::NewLn;
+    }
+    strmOut << kCIDLib::NewLn;
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RingQueue: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Does the single threaded tests, which are the same for both types, so we
+//  use a template.
+//
+template <typename TQType> tCIDLib::TBoolean
+TTest_RingQueue::bBasicTests(       TQType&&                colTest
+                            , const tCIDLib::TCh* const     pszType
+                            ,       TTextStringOutStream&   strmOut)
+{
+    tCIDLib::TBoolean bRet = kCIDLib::True;
+    const tCIDLib::TCard4 c4Max = colTest.c4MaxElems();
+
+    TString strVal;
+    if (!colTest.bIsEmpty() || colTest.bGetNext(strVal, 0))
+    {
+        strmOut << TFWCurLn << pszType << L" queue is not initially empty\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    // Fill it up, alternating copies and moves
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Max; c4Index++)
+    {
+        strVal.SetFormatted(c4Index);
+        tCIDLib::TBoolean bOK;
+        if (c4Index & 1)
+            bOK = colTest.bPut(strVal, 0);
+        else
+            bOK = colTest.bPut(TString(strVal), 0);
+
+        if (!bOK)
+        {
+            strmOut << TFWCurLn << pszType << L" put failed on non-full queue\n\n";
+            return kCIDLib::False;
+        }
+    }
+
+    if (!colTest.bIsFull() || (colTest.c4ElemCount() != c4Max))
+    {
+        strmOut << TFWCurLn << pszType << L" queue is not full\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    // A put should fail now, and throw if asked to
+    if (colTest.bPut(strVal, 0))
+    {
+        strmOut << TFWCurLn << pszType << L" put worked on a full queue\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    try
+    {
+        colTest.bPut(strVal, 10, kCIDLib::True);
+        strmOut << TFWCurLn << pszType << L" put timeout did not throw\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!errToCatch.bCheckEvent(facCIDLib().strName(), kCIDErrs::errcCol_Full))
+        {
+            strmOut << TFWCurLn << pszType << L" got the wrong put timeout error\n\n";
+            bRet = kCIDLib::False;
+        }
+    }
+
+    // Get half of them out in a batch and check them
+    TArrayJanitor<TString> janBatch(c4Max);
+    TString* const pstrBatch = janBatch.paThis();
+    const tCIDLib::TCard4 c4Half = c4Max / 2;
+    if (colTest.c4GetBatch(pstrBatch, c4Half) != c4Half)
+    {
+        strmOut << TFWCurLn << pszType << L" batch get returned the wrong count\n\n";
+        return kCIDLib::False;
+    }
+
+    TString strExp;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Half; c4Index++)
+    {
+        strExp.SetFormatted(c4Index);
+        if (pstrBatch[c4Index] != strExp)
+        {
+            strmOut << TFWCurLn << pszType << L" batch get value " << c4Index
+                    << L" was wrong\n\n";
+            bRet = kCIDLib::False;
+        }
+    }
+
+    //
+    //  Put a batch bigger than the space. We should only get half of it in, and
+    //  that should wrap around.
+    //
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Max; c4Index++)
+        pstrBatch[c4Index].SetFormatted(c4Max + c4Index);
+    if (colTest.c4PutBatch(pstrBatch, c4Max) != c4Half)
+    {
+        strmOut << TFWCurLn << pszType << L" batch put returned the wrong count\n\n";
+        return kCIDLib::False;
+    }
+
+    // Now everything should come out in order
+    for (tCIDLib::TCard4 c4Index = c4Half; c4Index < c4Max + c4Half; c4Index++)
+    {
+        strExp.SetFormatted(c4Index);
+        if (!colTest.bGetNext(strVal, 0) || (strVal != strExp))
+        {
+            strmOut << TFWCurLn << pszType << L" got the wrong value at " << c4Index
+                    << L"\n\n";
+            return kCIDLib::False;
+        }
+    }
+
+    // And we should be empty again and a get should time out
+    if (!colTest.bIsEmpty() || colTest.c4GetBatch(pstrBatch, c4Max, 10))
+    {
+        strmOut << TFWCurLn << pszType << L" queue is not empty after gets\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    try
+    {
+        colTest.bGetNext(strVal, 10, kCIDLib::True);
+        strmOut << TFWCurLn << pszType << L" get timeout did not throw\n\n";
+        bRet = kCIDLib::False;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!errToCatch.bCheckEvent(facCIDLib().strName(), kCIDErrs::errcCol_IsEmpty))
+        {
+            strmOut << TFWCurLn << pszType << L" got the wrong get timeout error\n\n";
+            bRet = kCIDLib::False;
+        }
+    }
+    return bRet;
+}
@@ -0,0 +1,260 @@
+//
+// FILE NAME: TestCIDLib2_SlabAlloc.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests of the slab allocator. It also times some node heavy
+//  collection work. Since the allocator is latched on or off for the life of
+//  the process, run this once with CID_SLABALLOC=1 and once without, to compare.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_SlabAlloc,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_SlabAlloc
+    {
+        // -----------------------------------------------------------------------
+        //  ac4Sizes
+        //      The sizes we test, which cover each size class and its edges, and
+        //      some that are too big and go to the heap.
+        //
+        //  c4BlockCnt
+        //      The number of blocks of each size we allocate at once.
+        //
+        //  c4Threads
+        //      The number of threads in the cross thread test.
+        //
+        //  c4ColRounds
+        //  c4ColCount
+        //      The number of rounds of collection work we time, and how many
+        //      elements get added and removed in each round.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4 ac4Sizes[] =
+        {
+            1, 16, 17, 40, 48, 64, 65, 100, 200, 256, 300, 512, 513, 1000
+        };
+        constexpr tCIDLib::TCard4   c4BlockCnt  = 500;
+        constexpr tCIDLib::TCard4   c4Threads   = 4;
+        constexpr tCIDLib::TCard4   c4ColRounds = 10;
+        constexpr tCIDLib::TCard4   c4ColCount  = 10000;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SlabAlloc
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_SlabAlloc: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_SlabAlloc::TTest_SlabAlloc() :
+
+    TTestFWTest
+    (
+        L"Slab Allocator", L"Tests and timing of the slab allocator", 4
+    )
+{
+}
+
+TTest_SlabAlloc::~TTest_SlabAlloc()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SlabAlloc: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_SlabAlloc::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    strmOut << L"Slab allocator is "
+            << (TSlabAlloc::bEnabled() ? L"enabled\n" : L"disabled\n");
+
+    //
+    //  For each size, allocate a bunch of blocks and fill each with its own
+    //  pattern. If any of them overlap, the patterns will get stepped on.
+    //
+    tCIDLib::TCard1* apc1Blocks[TestCIDLib2_SlabAlloc::c4BlockCnt];
+    for (const tCIDLib::TCard4 c4Size : TestCIDLib2_SlabAlloc::ac4Sizes)
+    {
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SlabAlloc::c4BlockCnt; c4Index++)
+        {
+            apc1Blocks[c4Index] = static_cast<tCIDLib::TCard1*>(TSlabAlloc::pAlloc(c4Size));
+            TRawMem::SetMemBuf(apc1Blocks[c4Index], tCIDLib::TCard1(c4Index & 0xFF), c4Size);
+        }
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SlabAlloc::c4BlockCnt; c4Index++)
+        {
+            const tCIDLib::TCard1* pc1Cur = apc1Blocks[c4Index];
+            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < c4Size; c4BInd++)
+            {
+                if (pc1Cur[c4BInd] != tCIDLib::TCard1(c4Index & 0xFF))
+                {
+                    c4Bad++;
+                    break;
+                }
+            }
+            TSlabAlloc::Free(apc1Blocks[c4Index], c4Size);
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" blocks of size " << c4Size
+                    << L" were overwritten\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Allocate blocks on other threads and free them on this one, which moves
+    //  them into our magazine and then back to the depot.
+    //
+    {
+        TThreadPool tpoolTest(L"SlabAllocTest", TestCIDLib2_SlabAlloc::c4Threads);
+
+        constexpr tCIDLib::TCard4 c4PerThread = TestCIDLib2_SlabAlloc::c4BlockCnt / TestCIDLib2_SlabAlloc::c4Threads;
+        TVector<TThreadPool::TTaskPtr> colTasks(TestCIDLib2_SlabAlloc::c4Threads);
+        for (tCIDLib::TCard4 c4TInd = 0; c4TInd < TestCIDLib2_SlabAlloc::c4Threads; c4TInd++)
+        {
+            tCIDLib::TCard1** ppc1Mine = &apc1Blocks[c4TInd * c4PerThread];
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [ppc1Mine, c4TInd](TThreadPoolTask&)
+                    {
+                        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PerThread; c4Index++)
+                        {
+                            ppc1Mine[c4Index] = static_cast<tCIDLib::TCard1*>(TSlabAlloc::pAlloc(48));
+                            TRawMem::SetMemBuf(ppc1Mine[c4Index], tCIDLib::TCard1(c4TInd), 48);
+                        }
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4TInd = 0; c4TInd < TestCIDLib2_SlabAlloc::c4Threads; c4TInd++)
+            colTasks[c4TInd]->bWaitDone();
+
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PerThread * TestCIDLib2_SlabAlloc::c4Threads; c4Index++)
+        {
+            const tCIDLib::TCard1 c1Exp = tCIDLib::TCard1(c4Index / c4PerThread);
+            for (tCIDLib::TCard4 c4BInd = 0; c4BInd < 48; c4BInd++)
+            {
+                if (apc1Blocks[c4Index][c4BInd] != c1Exp)
+                {
+                    c4Bad++;
+                    break;
+                }
+            }
+            TSlabAlloc::Free(apc1Blocks[c4Index], 48);
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" blocks allocated on other threads were "
+                       L"overwritten\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Time some node heavy collection work
+    {
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        tCIDLib::TStrHashSet colTest(109, TStringKeyOps(kCIDLib::False));
+        TString strVal;
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_SlabAlloc::c4ColRounds; c4Round++)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SlabAlloc::c4ColCount; c4Index++)
+            {
+                strVal.SetFormatted(c4Index);
+                colTest.objAdd(strVal);
+            }
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SlabAlloc::c4ColCount; c4Index++)
+            {
+                strVal.SetFormatted(c4Index);
+                colTest.bRemove(strVal);
+            }
+        }
+        strmOut << L"Hash set add/remove: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        if (!colTest.bIsEmpty())
+        {
+            strmOut << TFWCurLn << L"Hash set should have been empty\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    {
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        TQueue<TCardinal> colTest;
+        TCardinal cVal;
+        tCIDLib::TCard4 c4Sum = 0;
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_SlabAlloc::c4ColRounds; c4Round++)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SlabAlloc::c4ColCount; c4Index++)
+                colTest.objAdd(TCardinal(c4Index));
+
+            while (colTest.bGetNext(cVal, 0))
+                c4Sum += cVal.c4Val();
+        }
+        strmOut << L"Queue put/get: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        const tCIDLib::TCard4 c4Expected
+        (
+            TestCIDLib2_SlabAlloc::c4ColRounds
+            * ((TestCIDLib2_SlabAlloc::c4ColCount * (TestCIDLib2_SlabAlloc::c4ColCount - 1)) / 2)
+        );
+        if (c4Sum != c4Expected)
+        {
+            strmOut << TFWCurLn << L"Expected queue sum of " << c4Expected
+                    << L" but got " << c4Sum << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    strmOut << L"\n";
+    return eRes;
+}
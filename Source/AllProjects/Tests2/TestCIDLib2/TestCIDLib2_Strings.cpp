@@ -44,6 +44,7 @@ RTTIDecls(TTest_String1,TTestFWTest)
 RTTIDecls(TTest_String2,TTestFWTest)
 RTTIDecls(TTest_String3,TTestFWTest)
 RTTIDecls(TTest_StringCopyCat,TTestFWTest)
+RTTIDecls(TTest_StringHash,TTestFWTest)
 RTTIDecls(TTest_StringMove,TTestFWTest)
 RTTIDecls(TTest_StringTokens,TTestFWTest)
 RTTIDecls(TTest_StringTokenRep,TTestFWTest)
@@ -1089,6 +1090,181 @@ TTest_StringMove::eRunTest(TTextStringOutStream&   strmOut
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_StringHash
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_StringHash: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_StringHash::TTest_StringHash() :
+
+    TTestFWTest
+    (
+        L"String Hash", L"Tests string hash caching and the small buffer", 2
+    )
+{
+}
+
+TTest_StringHash::~TTest_StringHash()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_StringHash: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_StringHash::eRunTest( TTextStringOutStream&   strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    constexpr tCIDLib::TCard4 c4Modulus = 109;
+
+    //
+    //  A little helper that checks the (possibly cached) hashes of a string
+    //  against ones calculated from scratch on the raw text.
+    //
+    auto bCheckHash = [c4Modulus](const TString& strTest) -> tCIDLib::TBoolean
+    {
+        if (strTest.hshCalcHash(c4Modulus) != TRawStr::hshHashStr(strTest.pszBuffer(), c4Modulus))
+            return kCIDLib::False;
+
+        TString strLower(strTest.pszBuffer());
+        strLower.ToLower();
+        if (strTest.hshCalcHashI(c4Modulus) != TRawStr::hshHashStr(strLower.pszBuffer(), c4Modulus))
+            return kCIDLib::False;
+
+        return kCIDLib::True;
+    };
+
+    // Strings up to the small buffer size shouldn't have to allocate
+    {
+        TString strSmall(L"123456789ABCDEF");
+        TString strBig(L"123456789ABCDEFG");
+        if (strSmall.c4BufChars() != strSmall.c4Length())
+        {
+            strmOut << TFWCurLn << L"A 15 char string was not in the small buffer\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (strBig.c4BufChars() < strBig.c4Length())
+        {
+            strmOut << TFWCurLn << L"A 16 char string's buffer is too small\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Hash, then change the string in various ways, and make sure the hash
+    //  follows along. We do each twice, so that the second time comes from the
+    //  cache.
+    //
+    {
+        TString strTest(L"Short");
+        tCIDLib::TCard4 c4Bad = 0;
+        for (tCIDLib::TCard4 c4Round = 0; c4Round < 2; c4Round++)
+        {
+            if (!bCheckHash(strTest))
+                c4Bad++;
+        }
+
+        strTest.Append(L" and now a lot longer than the small buffer");
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.PutAt(0, L'Q');
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.ToUpper();
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.Cut(0, 6);
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.CapAt(4);
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.Prepend(L"Pre-");
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.DeleteLast();
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.SetFormatted(tCIDLib::TCard4(12345));
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        strTest.Clear();
+        if (!bCheckHash(strTest) || !bCheckHash(strTest))
+            c4Bad++;
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" hashes were wrong after changing the string\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Copies and moves should carry along a correct hash, small or not
+    {
+        TString strSmall(L"Small");
+        TString strBig(L"Something too big for the small buffer");
+        const tCIDLib::THashVal hshSmall = strSmall.hshCalcHash(c4Modulus);
+        const tCIDLib::THashVal hshBig = strBig.hshCalcHash(c4Modulus);
+
+        TString strCopy(strBig);
+        strCopy = strSmall;
+        if (strCopy.hshCalcHash(c4Modulus) != hshSmall)
+        {
+            strmOut << TFWCurLn << L"Copied string has the wrong hash\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        TString strMoved(tCIDLib::ForceMove(strBig));
+        strMoved = tCIDLib::ForceMove(strSmall);
+        if ((strMoved.hshCalcHash(c4Modulus) != hshSmall)
+        ||  !bCheckHash(strSmall)
+        ||  !bCheckHash(strBig))
+        {
+            strmOut << TFWCurLn << L"Moved strings have the wrong hash\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        strCopy = L"Something too big for the small buffer";
+        if (strCopy.hshCalcHash(c4Modulus) != hshBig)
+        {
+            strmOut << TFWCurLn << L"Assigned string has the wrong hash\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Case insensitive key ops should find keys regardless of case
+    {
+        tCIDLib::TStrHashSet colTest(29, TStringKeyOps(kCIDLib::False));
+        colTest.objAdd(L"SomeKey");
+        colTest.objAdd(L"Some Longer Key Value");
+        if (!colTest.bHasElement(L"somekey")
+        ||  !colTest.bHasElement(L"SOME LONGER KEY VALUE")
+        ||  colTest.bHasElement(L"SomeKeyX"))
+        {
+            strmOut << TFWCurLn << L"Case insensitive hash set lookups failed\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_StringTokens
 // PREFIX: tfwt
@@ -0,0 +1,318 @@
+//
+// FILE NAME: TestCIDLib2_SyncPerf.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests that hammer on the basic sync primitives, mutexes,
+//  events, and thread wait lists. They check that nothing gets lost, and also
+//  report how long each one took, so they serve as a simple benchmark for the
+//  fast paths of those primitives.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The times are only reported, they are not checked, since they depend
+//      completely on the machine.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_SyncPerf,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDLib2_SyncPerf
+    {
+        // -----------------------------------------------------------------------
+        //  c4Uncontended
+        //      The number of lock/unlock rounds in the uncontended mutex test.
+        //
+        //  c4Lockers
+        //  c4LockRounds
+        //      The number of threads in the contended mutex test and how many
+        //      times each one locks it.
+        //
+        //  c4PingPongs
+        //      The number of round trips in the event and wait list tests.
+        //
+        //  c4WaitTime
+        //      How long the ping pong tests wait before they give up.
+        //
+        //  c4PulseSettle
+        //  c4PulseWait
+        //      How long the pulse tests give the waiters to get blocked before
+        //      pulsing, and how long the waiters wait before they time out.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4Uncontended   = 200000;
+        constexpr tCIDLib::TCard4   c4Lockers       = 4;
+        constexpr tCIDLib::TCard4   c4LockRounds    = 50000;
+        constexpr tCIDLib::TCard4   c4PingPongs     = 5000;
+        constexpr tCIDLib::TCard4   c4WaitTime      = 5000;
+        constexpr tCIDLib::TCard4   c4PulseSettle   = 500;
+        constexpr tCIDLib::TCard4   c4PulseWait     = 2000;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SyncPerf
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_SyncPerf: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_SyncPerf::TTest_SyncPerf() :
+
+    TTestFWTest
+    (
+        L"Sync Perf", L"Stress and timing of mutexes, events and wait lists", 4
+    )
+{
+}
+
+TTest_SyncPerf::~TTest_SyncPerf()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SyncPerf: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_SyncPerf::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TThreadPool tpoolTest(L"SyncPerfTest", TestCIDLib2_SyncPerf::c4Lockers);
+
+    // Uncontended lock and unlock, which should never leave user space
+    {
+        TMutex mtxTest;
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SyncPerf::c4Uncontended; c4Index++)
+        {
+            mtxTest.Lock();
+            mtxTest.Unlock();
+        }
+        strmOut << L"Uncontended mutex, " << TestCIDLib2_SyncPerf::c4Uncontended
+                << L" rounds: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+    }
+
+    // A number of threads fighting over a mutex to bump a counter
+    {
+        TMutex mtxTest;
+        tCIDLib::TCard4 c4Counter = 0;
+
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        TVector<TThreadPool::TTaskPtr> colTasks(TestCIDLib2_SyncPerf::c4Lockers);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SyncPerf::c4Lockers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&mtxTest, &c4Counter](TThreadPoolTask&)
+                    {
+                        for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_SyncPerf::c4LockRounds; c4Round++)
+                        {
+                            TLocker lockrTest(&mtxTest);
+                            c4Counter++;
+                        }
+                    }
+                )
+            );
+        }
+
+        const tCIDLib::TCard4 c4Count = colTasks.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colTasks[c4Index]->bWaitDone();
+
+        strmOut << L"Contended mutex, " << TestCIDLib2_SyncPerf::c4Lockers << L" threads, "
+                << TestCIDLib2_SyncPerf::c4LockRounds << L" rounds each: "
+                << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        const tCIDLib::TCard4 c4Expected
+        (
+            TestCIDLib2_SyncPerf::c4Lockers * TestCIDLib2_SyncPerf::c4LockRounds
+        );
+        if (c4Counter != c4Expected)
+        {
+            strmOut << TFWCurLn << L"Expected a mutex protected count of "
+                    << c4Expected << L" but got " << c4Counter << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Ping pong between two threads via a pair of auto-reset events
+    {
+        TEvent evPing(tCIDLib::EEventStates::Reset, kCIDLib::False);
+        TEvent evPong(tCIDLib::EEventStates::Reset, kCIDLib::False);
+        tCIDLib::TCard4 c4Pongs = 0;
+
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        TThreadPool::TTaskPtr cptrPonger = tpoolTest.cptrRun
+        (
+            [&evPing, &evPong, &c4Pongs](TThreadPoolTask&)
+            {
+                for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_SyncPerf::c4PingPongs; c4Round++)
+                {
+                    if (!evPing.bWaitFor(TestCIDLib2_SyncPerf::c4WaitTime))
+                        break;
+                    c4Pongs++;
+                    evPong.Trigger();
+                }
+            }
+        );
+
+        tCIDLib::TCard4 c4Round = 0;
+        for (; c4Round < TestCIDLib2_SyncPerf::c4PingPongs; c4Round++)
+        {
+            evPing.Trigger();
+            if (!evPong.bWaitFor(TestCIDLib2_SyncPerf::c4WaitTime))
+                break;
+        }
+        cptrPonger->bWaitDone();
+
+        strmOut << L"Event ping pong, " << TestCIDLib2_SyncPerf::c4PingPongs
+                << L" round trips: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        if ((c4Round != TestCIDLib2_SyncPerf::c4PingPongs)
+        ||  (c4Pongs != TestCIDLib2_SyncPerf::c4PingPongs))
+        {
+            strmOut << TFWCurLn << L"Event ping pong stopped after " << c4Round
+                    << L" pings and " << c4Pongs << L" pongs\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And the same via a thread wait list. We have to wait for the other thread
+    //  to get back onto the list before we can release it each time.
+    //
+    {
+        TThreadWaitList twlTest;
+        TEvent evPong(tCIDLib::EEventStates::Reset, kCIDLib::False);
+        tCIDLib::TCard4 c4Pongs = 0;
+
+        const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+        TThreadPool::TTaskPtr cptrPonger = tpoolTest.cptrRun
+        (
+            [&twlTest, &evPong, &c4Pongs](TThreadPoolTask&)
+            {
+                for (tCIDLib::TCard4 c4Round = 0; c4Round < TestCIDLib2_SyncPerf::c4PingPongs; c4Round++)
+                {
+                    if (!twlTest.bWaitOnList(kCIDLib::c4TWLReason_None, TestCIDLib2_SyncPerf::c4WaitTime))
+                        break;
+                    c4Pongs++;
+                    evPong.Trigger();
+                }
+            }
+        );
+
+        tCIDLib::TCard4 c4Round = 0;
+        for (; c4Round < TestCIDLib2_SyncPerf::c4PingPongs; c4Round++)
+        {
+            const tCIDLib::TCard8 c8End = TTime::c8Millis() + TestCIDLib2_SyncPerf::c4WaitTime;
+            tCIDLib::TBoolean bReleased = kCIDLib::False;
+            while (!bReleased && (TTime::c8Millis() < c8End))
+            {
+                bReleased = twlTest.bReleaseOne(kCIDLib::c4TWLReason_All);
+                if (!bReleased)
+                    TThread::Sleep(0);
+            }
+
+            if (!bReleased || !evPong.bWaitFor(TestCIDLib2_SyncPerf::c4WaitTime))
+                break;
+        }
+        cptrPonger->bWaitDone();
+
+        strmOut << L"Wait list ping pong, " << TestCIDLib2_SyncPerf::c4PingPongs
+                << L" round trips: " << (TTime::c8Millis() - c8Start) << L"ms\n";
+
+        if ((c4Round != TestCIDLib2_SyncPerf::c4PingPongs)
+        ||  (c4Pongs != TestCIDLib2_SyncPerf::c4PingPongs))
+        {
+            strmOut << TFWCurLn << L"Wait list ping pong stopped after " << c4Round
+                    << L" pings and " << c4Pongs << L" pongs\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Pulse an auto-reset event with a number of threads waiting on it. Only one
+    //  of them should be released, and the rest should time out. Then do the same
+    //  with a manual event, which should release them all.
+    //
+    for (tCIDLib::TCard4 c4Manual = 0; c4Manual < 2; c4Manual++)
+    {
+        const tCIDLib::TBoolean bManual = (c4Manual != 0);
+        TEvent evPulse(tCIDLib::EEventStates::Reset, bManual);
+        TSafeCard4Counter scntReleased;
+
+        TVector<TThreadPool::TTaskPtr> colTasks(TestCIDLib2_SyncPerf::c4Lockers);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < TestCIDLib2_SyncPerf::c4Lockers; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&evPulse, &scntReleased](TThreadPoolTask&)
+                    {
+                        if (evPulse.bWaitFor(TestCIDLib2_SyncPerf::c4PulseWait))
+                            scntReleased.c4Inc();
+                    }
+                )
+            );
+        }
+
+        TThread::Sleep(TestCIDLib2_SyncPerf::c4PulseSettle);
+        evPulse.Pulse();
+
+        const tCIDLib::TCard4 c4Count = colTasks.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            colTasks[c4Index]->bWaitDone();
+
+        const tCIDLib::TCard4 c4Expected = bManual ? TestCIDLib2_SyncPerf::c4Lockers : 1;
+        if (scntReleased.c4Value() != c4Expected)
+        {
+            strmOut << TFWCurLn << L"Pulsing " << (bManual ? L"a manual" : L"an auto-reset")
+                    << L" event with " << TestCIDLib2_SyncPerf::c4Lockers
+                    << L" waiters released " << scntReleased.c4Value()
+                    << L" of them, expected " << c4Expected << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    strmOut << L"\n";
+    return eRes;
+}
@@ -0,0 +1,351 @@
+//
+// FILE NAME: TestCIDLib2_ThreadPool.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file contains tests related to the thread pool.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDLib2.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_ThreadPool,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ThreadPool
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_ThreadPool: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_ThreadPool::TTest_ThreadPool() :
+
+    TTestFWTest
+    (
+        L"Thread Pool", L"Tests of the thread pool and its tasks", 4
+    )
+{
+}
+
+TTest_ThreadPool::~TTest_ThreadPool()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ThreadPool: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_ThreadPool::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // Use our own pool, so we know how many workers there are
+    const tCIDLib::TCard4 c4Workers = 4;
+    TThreadPool tpoolTest(L"TestPool", c4Workers);
+
+    if (tpoolTest.c4WorkerCount() != c4Workers)
+    {
+        strmOut << TFWCurLn << L"Expected " << c4Workers << L" workers but got "
+                << tpoolTest.c4WorkerCount() << L"\n\n";
+        return tTestFWLib::ETestRes::Failed;
+    }
+
+    // Run a bunch of simple tasks and make sure they all run
+    {
+        const tCIDLib::TCard4 c4TaskCnt = 256;
+        TSafeCard4Counter scntRuns;
+        TVector<TThreadPool::TTaskPtr> colTasks(c4TaskCnt);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TaskCnt; c4Index++)
+        {
+            colTasks.objAdd
+            (
+                tpoolTest.cptrRun([&scntRuns](TThreadPoolTask&) { scntRuns++; })
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TaskCnt; c4Index++)
+        {
+            if (!colTasks[c4Index]->bWaitDone(5000))
+            {
+                strmOut << TFWCurLn << L"Timed out waiting for task " << c4Index << L"\n\n";
+                return tTestFWLib::ETestRes::Failed;
+            }
+
+            if (colTasks[c4Index]->eState() != tCIDLib::ETaskStates::Complete)
+            {
+                strmOut << TFWCurLn << L"Task " << c4Index << L" did not complete\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        if (scntRuns.c4Value() != c4TaskCnt)
+        {
+            strmOut << TFWCurLn << L"Expected " << c4TaskCnt << L" runs but got "
+                    << scntRuns.c4Value() << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // A task can't be queued twice
+    {
+        TThreadPool::TTaskPtr cptrTask = tpoolTest.cptrRun([](TThreadPoolTask&) {});
+        try
+        {
+            tpoolTest.Submit(cptrTask);
+            strmOut << TFWCurLn << L"Queuing a task twice was not caught\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        catch(const TError& errToCatch)
+        {
+            if (!errToCatch.bCheckEvent(facCIDLib().strName(), kCIDErrs::errcTPool_NotIdle))
+            {
+                strmOut << TFWCurLn << L"Got the wrong error for double queuing\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+        cptrTask->bWaitDone(5000);
+    }
+
+    // Failures should be stored, both ours and unknown ones
+    {
+        TThreadPool::TTaskPtr cptrFail = tpoolTest.cptrRun
+        (
+            [](TThreadPoolTask&)
+            {
+                facCIDLib().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kCIDErrs::errcGen_BadEnumValue
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::BadParms
+                    , TString(L"1")
+                    , TString(L"Test")
+                );
+            }
+        );
+
+        TThreadPool::TTaskPtr cptrUnknown = tpoolTest.cptrRun
+        (
+            [](TThreadPoolTask&) { throw 1; }
+        );
+
+        if (!cptrFail->bWaitDone(5000) || !cptrUnknown->bWaitDone(5000))
+        {
+            strmOut << TFWCurLn << L"Timed out waiting for failed tasks\n\n";
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        if ((cptrFail->eState() != tCIDLib::ETaskStates::Failed)
+        ||  !cptrFail->errFailure().bCheckEvent(facCIDLib().strName(), kCIDErrs::errcGen_BadEnumValue))
+        {
+            strmOut << TFWCurLn << L"The task failure was not stored correctly\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if ((cptrUnknown->eState() != tCIDLib::ETaskStates::Failed)
+        ||  !cptrUnknown->errFailure().bCheckEvent(facCIDLib().strName(), kCIDErrs::errcTPool_UnknownExcept))
+        {
+            strmOut << TFWCurLn << L"The unknown task failure was not stored correctly\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // A continuation should run after the one it follows
+    {
+        tCIDLib::TCard4 c4Order = 0;
+        TThreadPool::TTaskPtr cptrAnte = tpoolTest.cptrRun
+        (
+            [&c4Order](TThreadPoolTask&) { TThread::Sleep(50); c4Order = 1; }
+        );
+        TThreadPool::TTaskPtr cptrCont = tpoolTest.cptrRunAfter
+        (
+            cptrAnte
+            , [&c4Order](TThreadPoolTask&) { if (c4Order == 1) c4Order = 2; }
+        );
+
+        if (!cptrCont->bWaitDone(5000))
+        {
+            strmOut << TFWCurLn << L"Timed out waiting for continuation\n\n";
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        if (c4Order != 2)
+        {
+            strmOut << TFWCurLn << L"The continuation did not run after its antecedent\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        // One added after the antecedent is done should just run
+        TThreadPool::TTaskPtr cptrLate = tpoolTest.cptrRunAfter
+        (
+            cptrAnte, [&c4Order](TThreadPoolTask&) { c4Order = 3; }
+        );
+        if (!cptrLate->bWaitDone(5000) || (c4Order != 3))
+        {
+            strmOut << TFWCurLn << L"The late continuation did not run\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Block all of the workers, then queue up a task and cancel it before it
+    //  can run. It should never run. And cancel a running one that checks for
+    //  cancellation.
+    //
+    {
+        TEvent evGate(tCIDLib::EEventStates::Reset);
+        TVector<TThreadPool::TTaskPtr> colGates(c4Workers);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Workers; c4Index++)
+        {
+            colGates.objAdd
+            (
+                tpoolTest.cptrRun([&evGate](TThreadPoolTask&) { evGate.bWaitFor(5000); })
+            );
+        }
+
+        tCIDLib::TBoolean bRan = kCIDLib::False;
+        TThreadPool::TTaskPtr cptrCancel = tpoolTest.cptrRun
+        (
+            [&bRan](TThreadPoolTask&) { bRan = kCIDLib::True; }
+        );
+        cptrCancel->RequestCancel();
+        evGate.Trigger();
+
+        if (!cptrCancel->bWaitDone(5000))
+        {
+            strmOut << TFWCurLn << L"Timed out waiting for cancelled task\n\n";
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        if (bRan || (cptrCancel->eState() != tCIDLib::ETaskStates::Cancelled))
+        {
+            strmOut << TFWCurLn << L"The cancelled task was run\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Workers; c4Index++)
+            colGates[c4Index]->bWaitDone(5000);
+
+        TThreadPool::TTaskPtr cptrLoop = tpoolTest.cptrRun
+        (
+            [](TThreadPoolTask& taskThis)
+            {
+                while (!taskThis.bCheckCancel())
+                    TThread::Sleep(5);
+            }
+        );
+        TThread::Sleep(20);
+        cptrLoop->RequestCancel();
+        if (!cptrLoop->bWaitDone(5000)
+        ||  (cptrLoop->eState() != tCIDLib::ETaskStates::Cancelled))
+        {
+            strmOut << TFWCurLn << L"The running task did not see the cancel\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Queue up more tasks than there are workers, each of which queues up
+    //  sub-tasks and waits for them. The workers have to run other tasks while
+    //  they wait, else this would hang.
+    //
+    {
+        const tCIDLib::TCard4 c4OuterCnt = c4Workers * 4;
+        const tCIDLib::TCard4 c4SubCnt = 8;
+        TSafeCard4Counter scntSubRuns;
+
+        TVector<TThreadPool::TTaskPtr> colOuter(c4OuterCnt);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OuterCnt; c4Index++)
+        {
+            colOuter.objAdd
+            (
+                tpoolTest.cptrRun
+                (
+                    [&tpoolTest, &scntSubRuns](TThreadPoolTask&)
+                    {
+                        TVector<TThreadPool::TTaskPtr> colSubs(c4SubCnt);
+                        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCnt; c4SubInd++)
+                        {
+                            colSubs.objAdd
+                            (
+                                tpoolTest.cptrRun
+                                (
+                                    [&scntSubRuns](TThreadPoolTask&) { scntSubRuns++; }
+                                )
+                            );
+                        }
+
+                        for (tCIDLib::TCard4 c4SubInd = 0; c4SubInd < c4SubCnt; c4SubInd++)
+                            colSubs[c4SubInd]->bWaitDone();
+                    }
+                )
+            );
+        }
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4OuterCnt; c4Index++)
+        {
+            if (!colOuter[c4Index]->bWaitDone(10000))
+            {
+                strmOut << TFWCurLn << L"Timed out waiting for nested tasks\n\n";
+                return tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        if (scntSubRuns.c4Value() != c4OuterCnt * c4SubCnt)
+        {
+            strmOut << TFWCurLn << L"Expected " << (c4OuterCnt * c4SubCnt)
+                    << L" sub-tasks but got " << scntSubRuns.c4Value() << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Once shut down, no more tasks can be queued
+    tpoolTest.Shutdown();
+    try
+    {
+        tpoolTest.cptrRun([](TThreadPoolTask&) {});
+        strmOut << TFWCurLn << L"Queuing on a shut down pool was not caught\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    catch(const TError& errToCatch)
+    {
+        if (!errToCatch.bCheckEvent(facCIDLib().strName(), kCIDErrs::errcTPool_ShuttingDown))
+        {
+            strmOut << TFWCurLn << L"Got the wrong error for queuing after shutdown\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
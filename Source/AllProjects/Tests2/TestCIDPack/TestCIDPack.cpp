@@ -0,0 +1,108 @@
+//
+// FILE NAME: TestCIDPack.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main implementation file of the test program.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "TestCIDPack.hpp"
+
+
+// ----------------------------------------------------------------------------
+//  Magic macros
+// ----------------------------------------------------------------------------
+RTTIDecls(TPackTestApp,TTestFWApp)
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TPackTestApp
+// PREFIX: tfwapp
+// ---------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TPackTestApp: Constructor and Destructor
+// ----------------------------------------------------------------------------
+TPackTestApp::TPackTestApp()
+{
+}
+
+TPackTestApp::~TPackTestApp()
+{
+}
+
+
+// ----------------------------------------------------------------------------
+//  TPackTestApp: Public, inherited methods
+// ----------------------------------------------------------------------------
+tCIDLib::TBoolean TPackTestApp::bInitialize(TString&)
+{
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TPackTestApp::LoadTests()
+{
+    // Load up our tests on our parent class
+    AddTest(new TTest_PackRoundTrip);
+    AddTest(new TTest_PackCorrupt);
+}
+
+tCIDLib::TVoid TPackTestApp::PostTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TPackTestApp::PreTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TPackTestApp::Terminate()
+{
+    // Nothing to do
+}
+
+
+
+// ----------------------------------------------------------------------------
+//  Declare the test app object
+// ----------------------------------------------------------------------------
+TPackTestApp   tfwappPack;
+
+
+
+// ----------------------------------------------------------------------------
+//  Include magic main module code. We just point it at the test thread
+//  entry point of the test framework app class.
+// ----------------------------------------------------------------------------
+CIDLib_MainModule
+(
+    TThread
+    (
+        L"TestThread"
+        , TMemberFunc<TPackTestApp>(&tfwappPack, &TPackTestApp::eTestThread)
+    )
+)
@@ -0,0 +1,170 @@
+//
+// FILE NAME: TestCIDPack.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main header file of the CIDPack tests. We just declare all of
+//  the tests here.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "CIDCrypto.hpp"
+#include    "CIDPack.hpp"
+#include    "TestFWLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PackCorrupt
+// PREFIX: tfwt
+//
+//  Corrupts the stored hash of one file and the stored size of another in a
+//  package, and makes sure that parallel extraction fails cleanly on each,
+//  i.e. it throws the worker's error and doesn't hang.
+// ---------------------------------------------------------------------------
+class TTest_PackCorrupt : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PackCorrupt();
+
+        TTest_PackCorrupt(const TTest_PackCorrupt&) = delete;
+        TTest_PackCorrupt(TTest_PackCorrupt&&) = delete;
+
+        ~TTest_PackCorrupt();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PackCorrupt,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PackRoundTrip
+// PREFIX: tfwt
+//
+//  Packs a tree of files serially and in parallel, makes sure the packages
+//  are the same, and extracts them both ways and makes sure we get the tree
+//  back. It logs the serial and parallel times.
+// ---------------------------------------------------------------------------
+class TTest_PackRoundTrip : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PackRoundTrip();
+
+        TTest_PackRoundTrip(const TTest_PackRoundTrip&) = delete;
+        TTest_PackRoundTrip(TTest_PackRoundTrip&&) = delete;
+
+        ~TTest_PackRoundTrip();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PackRoundTrip,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TPackTestApp
+// PREFIX: tfwapp
+//
+//  This is our implementation of the test framework's test program framework.
+//  We just create a derivative and override some methods.
+// ---------------------------------------------------------------------------
+class TPackTestApp : public TTestFWApp
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TPackTestApp();
+
+        TPackTestApp(const TPackTestApp&) = delete;
+        TPackTestApp(TPackTestApp&&) = delete;
+
+        ~TPackTestApp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bInitialize
+        (
+                    TString&                strErr
+        )   override;
+
+        tCIDLib::TVoid LoadTests() override;
+
+        tCIDLib::TVoid PostTest
+        (
+            const   TTestFWTest&            tfwtFinished
+        )   override;
+
+        tCIDLib::TVoid PreTest
+        (
+            const   TTestFWTest&            tfwtStarting
+        )   override;
+
+        tCIDLib::TVoid Terminate() override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TPackTestApp,TTestFWApp)
+};
+
@@ -0,0 +1,761 @@
+//
+// FILE NAME: TestCIDPack_Pack.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the tests of packing and extracting packages. We build
+//  a tree of files under the temp directory, with a mix of compressible and non-
+//  compressible content, and run it through the serial and parallel paths.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The corruption test finds the per-file header fields to corrupt by
+//      searching the package for them, since the header classes aren't public.
+//      Each file has a different size and content, so they are unique.
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDPack.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_PackCorrupt,TTestFWTest)
+RTTIDecls(TTest_PackRoundTrip,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDPack_Pack
+    {
+        // -----------------------------------------------------------------------
+        //  c4CorruptFiles
+        //  c4RoundTripFiles
+        //      The number of files in the test trees. The round trip one is large
+        //      enough to get some meaningful times.
+        //
+        //  c4BadHashInd
+        //  c4BadSizeInd
+        //      The files we corrupt the stored hash and size of. The bad size one
+        //      has to be compressible, see FillFile().
+        //
+        //  c8Version
+        //  enctStamp
+        //      Fixed header values, so that packages made at different times are
+        //      the same.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4       c4CorruptFiles = 24;
+        constexpr tCIDLib::TCard4       c4RoundTripFiles = 96;
+        constexpr tCIDLib::TCard4       c4BadHashInd = 9;
+        constexpr tCIDLib::TCard4       c4BadSizeInd = 13;
+        constexpr tCIDLib::TCard8       c8Version = 0x0001000200030004;
+        constexpr tCIDLib::TEncodedTime enctStamp = 0x01D5000012345678;
+
+
+        //
+        //  The size of each test file. They are all different, since 7919 is prime
+        //  and we don't have enough files to wrap.
+        //
+        tCIDLib::TCard4 c4FileSize(const tCIDLib::TCard4 c4Index)
+        {
+            return 1024 + ((c4Index * 7919) % 400000);
+        }
+
+
+        //
+        //  Fill a buffer with the content of a test file. Every third one is
+        //  pseudo-random, which won't compress, and the rest are text like, with
+        //  some random bytes, so that they compress but not trivially.
+        //
+        tCIDLib::TVoid
+        FillFile(const tCIDLib::TCard4 c4FileInd, TMemBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            const tCIDLib::TBoolean bRandom = (c4FileInd % 3) == 0;
+            tCIDLib::TCard4 c4Seed = 0x12345678 + c4FileInd;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                c4Seed = (c4Seed * 1103515245) + 12345;
+                if (bRandom || !(c4Seed & 0x3F0000))
+                {
+                    mbufTar.PutCard1(tCIDLib::TCard1(c4Seed >> 16), c4Index);
+                }
+                 else
+                {
+                    mbufTar.PutCard1
+                    (
+                        tCIDLib::TCard1(L'A' + (((c4Index / 5) + c4FileInd) % 26)), c4Index
+                    );
+                }
+            }
+        }
+
+
+        //
+        //  Build up the relative path of a test file. They are spread over a few
+        //  directories, some nested.
+        //
+        tCIDLib::TVoid MakeRelPath(const tCIDLib::TCard4 c4FileInd, TPathStr& pathToFill)
+        {
+            pathToFill = L"Dir";
+            pathToFill.AppendFormatted(c4FileInd % 4);
+            if (c4FileInd % 3)
+            {
+                pathToFill.AddLevel(L"Sub");
+                pathToFill.AppendFormatted(c4FileInd % 3);
+            }
+            pathToFill.AddLevel(L"File");
+            pathToFill.AppendFormatted(c4FileInd);
+            pathToFill.AppendExt(L".Dat");
+        }
+
+
+        //
+        //  Read in a file, sizing the buffer up if needed, and return the size.
+        //
+        tCIDLib::TCard4 c4ReadFile(const TString& strPath, THeapBuf& mbufToFill)
+        {
+            TBinaryFile bflSrc(strPath);
+            bflSrc.Open
+            (
+                tCIDLib::EAccessModes::Read
+                , tCIDLib::ECreateActs::OpenIfExists
+                , tCIDLib::EFilePerms::Default
+                , tCIDLib::EFileFlags::SequentialScan
+            );
+
+            const tCIDLib::TCard4 c4Size = tCIDLib::TCard4(bflSrc.c8CurSize());
+            if (mbufToFill.c4Size() < c4Size)
+                mbufToFill = THeapBuf(c4Size, c4Size);
+            bflSrc.c4ReadBuffer(mbufToFill, c4Size, tCIDLib::EAllData::FailIfNotAll);
+            return c4Size;
+        }
+
+
+        // Write out a buffer to a file, replacing any existing one
+        tCIDLib::TVoid
+        WriteFile(const TString& strPath, const TMemBuf& mbufSrc, const tCIDLib::TCard4 c4Bytes)
+        {
+            TBinFileOutStream strmTar
+            (
+                strPath
+                , tCIDLib::ECreateActs::CreateAlways
+                , tCIDLib::EFilePerms::Default
+                , tCIDLib::EFileFlags::SequentialScan
+            );
+            strmTar.c4WriteBuffer(mbufSrc, c4Bytes);
+            strmTar.Flush();
+        }
+
+
+        //
+        //  Set up an empty test directory under the temp directory, removing any
+        //  left over from a previous run.
+        //
+        tCIDLib::TBoolean
+        bMakeTestDir(TTextOutStream& strmOut, const TString& strName, TPathStr& pathToFill)
+        {
+            TString strTmp;
+            if (!TProcEnvironment::bFindTempPath(strTmp))
+            {
+                strmOut << TFWCurLn << L"Could not find the temp path\n\n";
+                return kCIDLib::False;
+            }
+
+            pathToFill = strTmp;
+            pathToFill.AddLevel(strName);
+            if (TFileSys::bIsDirectory(pathToFill))
+                TFileSys::RemovePath(pathToFill);
+            TFileSys::MakePath(pathToFill);
+            return kCIDLib::True;
+        }
+
+
+        // Create the test tree under the indicated directory
+        tCIDLib::TVoid MakeTree(const TString& strSrcPath, const tCIDLib::TCard4 c4Count)
+        {
+            THeapBuf mbufFile(c4FileSize(0));
+            TPathStr pathRel;
+            TPathStr pathFile;
+            TPathStr pathDir;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                const tCIDLib::TCard4 c4Size = c4FileSize(c4Index);
+                if (mbufFile.c4Size() < c4Size)
+                    mbufFile = THeapBuf(c4Size, c4Size);
+                FillFile(c4Index, mbufFile, c4Size);
+
+                MakeRelPath(c4Index, pathRel);
+                pathFile = strSrcPath;
+                pathFile.AddLevel(pathRel);
+
+                pathDir = pathFile;
+                pathDir.bRemoveNameExt();
+                if (!TFileSys::bIsDirectory(pathDir))
+                    TFileSys::MakePath(pathDir);
+
+                WriteFile(pathFile, mbufFile, c4Size);
+            }
+        }
+
+
+        // Load up the tree of files under a directory, and return the count found
+        tCIDLib::TCard4 c4LoadTree(const TString& strPath, TFindBuf& fndbToFill)
+        {
+            if (!TFileSys::bExists(strPath, fndbToFill, tCIDLib::EDirSearchFlags::AllDirs))
+                return 0;
+            return TFileSys::c4BuildFileTree(kCIDLib::pszAllFilesSpec, fndbToFill);
+        }
+
+
+        //
+        //  Check that the tree under the indicated directory has the test files
+        //  in it, and no others.
+        //
+        tCIDLib::TBoolean bCheckTree(       TTextOutStream&     strmOut
+                                    , const TString&            strSrcPath
+                                    , const TString&            strOutPath
+                                    , const tCIDLib::TCard4     c4Count
+                                    , const TString&            strWhat)
+        {
+            TFindBuf fndbSrc;
+            TFindBuf fndbOut;
+            if (c4LoadTree(strSrcPath, fndbSrc) != c4LoadTree(strOutPath, fndbOut))
+            {
+                strmOut << TFWCurLn << strWhat
+                        << L" extracted tree has a different number of entries\n\n";
+                return kCIDLib::False;
+            }
+
+            THeapBuf mbufExp(c4FileSize(0));
+            THeapBuf mbufRead(c4FileSize(0));
+            TPathStr pathRel;
+            TPathStr pathFile;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                MakeRelPath(c4Index, pathRel);
+                pathFile = strOutPath;
+                pathFile.AddLevel(pathRel);
+                if (!TFileSys::bExists(pathFile, tCIDLib::EDirSearchFlags::NormalFiles))
+                {
+                    strmOut << TFWCurLn << strWhat << L" did not extract " << pathRel
+                            << L"\n\n";
+                    return kCIDLib::False;
+                }
+
+                const tCIDLib::TCard4 c4Size = c4FileSize(c4Index);
+                if (mbufExp.c4Size() < c4Size)
+                    mbufExp = THeapBuf(c4Size, c4Size);
+                FillFile(c4Index, mbufExp, c4Size);
+
+                if ((c4ReadFile(pathFile, mbufRead) != c4Size)
+                ||  !mbufRead.bCompare(mbufExp, c4Size))
+                {
+                    strmOut << TFWCurLn << strWhat << L" extracted " << pathRel
+                            << L" with the wrong content\n\n";
+                    return kCIDLib::False;
+                }
+            }
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Find a run of bytes in a buffer, starting at the indicated index. We
+        //  return max card if not found.
+        //
+        tCIDLib::TCard4 c4FindBytes(const   TMemBuf&                mbufSrc
+                                    , const tCIDLib::TCard4         c4SrcBytes
+                                    , const tCIDLib::TCard1* const  pc1ToFind
+                                    , const tCIDLib::TCard4         c4ToFind
+                                    , const tCIDLib::TCard4         c4StartAt)
+        {
+            for (tCIDLib::TCard4 c4Index = c4StartAt; c4Index + c4ToFind <= c4SrcBytes; c4Index++)
+            {
+                if (TRawMem::bCompareMemBuf(mbufSrc.pc1DataAt(c4Index), pc1ToFind, c4ToFind))
+                    return c4Index;
+            }
+            return kCIDLib::c4MaxCard;
+        }
+
+
+        //
+        //  Flip the bits of the stored hash of the indicated file. The raw hash
+        //  bytes are in the file's header.
+        //
+        tCIDLib::TBoolean bCorruptHash(         TTextOutStream&     strmOut
+                                        ,       TMemBuf&            mbufPack
+                                        , const tCIDLib::TCard4     c4PackBytes
+                                        , const tCIDLib::TCard4     c4FileInd)
+        {
+            const tCIDLib::TCard4 c4Size = c4FileSize(c4FileInd);
+            THeapBuf mbufFile(c4Size, c4Size);
+            FillFile(c4FileInd, mbufFile, c4Size);
+
+            TMessageDigest5 mdigHash;
+            TMD5Hash        mhashFile;
+            mdigHash.StartNew();
+            mdigHash.DigestBuf(mbufFile, c4Size);
+            mdigHash.Complete(mhashFile);
+
+            const tCIDLib::TCard4 c4At = c4FindBytes
+            (
+                mbufPack, c4PackBytes, mhashFile.pc1Buffer(), mhashFile.c4Bytes(), 0
+            );
+            if (c4At == kCIDLib::c4MaxCard)
+            {
+                strmOut << TFWCurLn << L"Could not find the hash of file "
+                        << c4FileInd << L" in the package\n\n";
+                return kCIDLib::False;
+            }
+            mbufPack.PutCard1(tCIDLib::TCard1(mbufPack[c4At] ^ 0xFF), c4At);
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Bump the stored original size of the indicated file. The header has
+        //  the compressed and original sizes, followed by their XOR'd values, so
+        //  we look for the original size with its XOR'd value 8 bytes later, and
+        //  update both, so that the header itself still looks fine.
+        //
+        tCIDLib::TBoolean bCorruptSize(         TTextOutStream&     strmOut
+                                        ,       TMemBuf&            mbufPack
+                                        , const tCIDLib::TCard4     c4PackBytes
+                                        , const tCIDLib::TCard4     c4FileInd)
+        {
+            const tCIDLib::TCard4 c4Size = c4FileSize(c4FileInd);
+
+            // Stream the old and new values out, to get them in stream format
+            TBinMBufOutStream strmVals(32UL);
+            strmVals    << c4Size << tCIDLib::TCard4(c4Size ^ kCIDLib::c4MaxCard)
+                        << tCIDLib::TCard4(c4Size + 1)
+                        << tCIDLib::TCard4((c4Size + 1) ^ kCIDLib::c4MaxCard);
+            strmVals.Flush();
+            const TMemBuf& mbufVals = strmVals.mbufData();
+
+            tCIDLib::TCard4 c4At = 0;
+            while (kCIDLib::True)
+            {
+                c4At = c4FindBytes(mbufPack, c4PackBytes, mbufVals.pc1Data(), 4, c4At);
+                if ((c4At == kCIDLib::c4MaxCard) || (c4At + 12 > c4PackBytes))
+                {
+                    strmOut << TFWCurLn << L"Could not find the size of file "
+                            << c4FileInd << L" in the package\n\n";
+                    return kCIDLib::False;
+                }
+
+                if (TRawMem::bCompareMemBuf(mbufPack.pc1DataAt(c4At + 8), mbufVals.pc1DataAt(4), 4))
+                    break;
+                c4At++;
+            }
+
+            mbufPack.CopyIn(mbufVals.pc1DataAt(8), 4, c4At);
+            mbufPack.CopyIn(mbufVals.pc1DataAt(12), 4, c4At + 8);
+            return kCIDLib::True;
+        }
+
+
+        //
+        //  Pack the tree with the indicated number of workers, returning the time
+        //  it took.
+        //
+        tCIDLib::TCard8 c8Pack( const   TString&            strPackFile
+                                , const TString&            strSrcPath
+                                , const TFindBuf&           fndbTree
+                                , const tCIDLib::TCard4     c4Workers)
+        {
+            tCIDLib::TCard4 c4SoFar = 0;
+            const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+            facCIDPack().CreatePackage
+            (
+                strPackFile
+                , strSrcPath
+                , kCIDLib::True
+                , fndbTree
+                , c8Version
+                , enctStamp
+                , L"CIDPack test package"
+                , nullptr
+                , c4SoFar
+                , kCIDLib::False
+                , c4Workers
+            );
+            return TTime::c8Millis() - c8Start;
+        }
+
+
+        //
+        //  Extract a package with the indicated number of workers, checking the
+        //  header info we get back. We return the time it took.
+        //
+        tCIDLib::TCard8 c8Extract(          TTextOutStream&     strmOut
+                                    , const TString&            strPackFile
+                                    , const TString&            strOutPath
+                                    , const tCIDLib::TCard4     c4Workers
+                                    , const tCIDLib::TCard4     c4Count
+                                    ,       tCIDLib::TBoolean&  bGood)
+        {
+            tCIDLib::TCard8         c8VerRead = 0;
+            tCIDLib::TEncodedTime   enctRead = 0;
+            TString                 strNotes;
+            tCIDLib::TCard4         c4Total = 0;
+            tCIDLib::TCard4         c4SoFar = 0;
+
+            const tCIDLib::TCard8 c8Start = TTime::c8Millis();
+            facCIDPack().ExtractPackage
+            (
+                strPackFile
+                , strOutPath
+                , kCIDLib::True
+                , c8VerRead
+                , enctRead
+                , strNotes
+                , c4Total
+                , nullptr
+                , c4SoFar
+                , kCIDLib::False
+                , c4Workers
+            );
+            const tCIDLib::TCard8 c8Ret = TTime::c8Millis() - c8Start;
+
+            bGood = (c8VerRead == c8Version)
+                    && (enctRead == enctStamp)
+                    && (c4Total == c4Count)
+                    && (c4SoFar == c4Count);
+            if (!bGood)
+            {
+                strmOut << TFWCurLn << L"Bad header info or count from extract. Workers="
+                        << c4Workers << L", Files=" << c4Total << L", SoFar="
+                        << c4SoFar << L"\n\n";
+            }
+            return c8Ret;
+        }
+
+
+        //
+        //  Extract a corrupted package and make sure that it fails with the
+        //  expected error. If the abort path hangs, we never come back.
+        //
+        tCIDLib::TBoolean bExpectFailure(       TTextOutStream&     strmOut
+                                        , const TString&            strPackFile
+                                        , const TString&            strOutPath
+                                        , const tCIDLib::TCard4     c4Workers
+                                        , const tCIDLib::TErrCode   errcExpected
+                                        , const TString&            strWhat)
+        {
+            tCIDLib::TCard8         c8VerRead = 0;
+            tCIDLib::TEncodedTime   enctRead = 0;
+            TString                 strNotes;
+            tCIDLib::TCard4         c4Total = 0;
+            tCIDLib::TCard4         c4SoFar = 0;
+            try
+            {
+                facCIDPack().ExtractPackage
+                (
+                    strPackFile
+                    , strOutPath
+                    , kCIDLib::True
+                    , c8VerRead
+                    , enctRead
+                    , strNotes
+                    , c4Total
+                    , nullptr
+                    , c4SoFar
+                    , kCIDLib::False
+                    , c4Workers
+                );
+            }
+
+            catch(const TError& errToCatch)
+            {
+                if (!errToCatch.bCheckEvent(facCIDPack().strName(), errcExpected))
+                {
+                    strmOut << TFWCurLn << strWhat << L" failed with the wrong error: "
+                            << errToCatch.strErrText() << L"\n\n";
+                    return kCIDLib::False;
+                }
+
+                if (c4SoFar >= c4Total)
+                {
+                    strmOut << TFWCurLn << strWhat << L" reported all files done\n\n";
+                    return kCIDLib::False;
+                }
+                return kCIDLib::True;
+            }
+
+            strmOut << TFWCurLn << strWhat << L" did not fail\n\n";
+            return kCIDLib::False;
+        }
+
+
+        //
+        //  The number of workers we use for the parallel tests. We want at least
+        //  a few even on a single CPU machine, so that the pipe is exercised.
+        //
+        tCIDLib::TCard4 c4ParWorkers()
+        {
+            return tCIDLib::MinVal
+            (
+                tCIDLib::MaxVal(TSysInfo::c4CPUCount(), tCIDLib::TCard4(4))
+                , kCIDPack::c4MaxWorkers
+            );
+        }
+
+
+        // Format the speedup of the parallel version over the serial one
+        TFloat fSpeedup(const tCIDLib::TCard8 c8Serial, const tCIDLib::TCard8 c8Parallel)
+        {
+            return TFloat
+            (
+                tCIDLib::TFloat8(c8Serial)
+                / tCIDLib::TFloat8(tCIDLib::MaxVal(c8Parallel, tCIDLib::TCard8(1)))
+                , 2
+            );
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PackCorrupt
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PackCorrupt: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PackCorrupt::TTest_PackCorrupt() :
+
+    TTestFWTest
+    (
+        L"Corrupt Package", L"Extracts packages with a bad hash and a bad size", 3
+    )
+{
+}
+
+TTest_PackCorrupt::~TTest_PackCorrupt()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PackCorrupt: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PackCorrupt::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    const tCIDLib::TCard4 c4Count = TestCIDPack_Pack::c4CorruptFiles;
+    const tCIDLib::TCard4 c4Workers = TestCIDPack_Pack::c4ParWorkers();
+
+    TPathStr pathRoot;
+    if (!TestCIDPack_Pack::bMakeTestDir(strmOut, L"TestCIDPack_Corrupt", pathRoot))
+        return tTestFWLib::ETestRes::Failed;
+
+    TPathStr pathSrc(pathRoot);
+    pathSrc.AddLevel(L"Src");
+    TPathStr pathOut(pathRoot);
+    pathOut.AddLevel(L"Out");
+    TPathStr pathGood(pathRoot);
+    pathGood.AddLevel(L"Good.CIDPack");
+    TPathStr pathBad(pathRoot);
+    pathBad.AddLevel(L"Bad.CIDPack");
+
+    TestCIDPack_Pack::MakeTree(pathSrc, c4Count);
+    TFindBuf fndbTree;
+    TestCIDPack_Pack::c4LoadTree(pathSrc, fndbTree);
+    TestCIDPack_Pack::c8Pack(pathGood, pathSrc, fndbTree, c4Workers);
+
+    THeapBuf mbufGood(1024);
+    const tCIDLib::TCard4 c4PackBytes = TestCIDPack_Pack::c4ReadFile(pathGood, mbufGood);
+
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // Corrupt one file's hash, which the worker should catch after decompressing
+    {
+        THeapBuf mbufBad(mbufGood);
+        tCIDLib::TBoolean bRes = TestCIDPack_Pack::bCorruptHash
+        (
+            strmOut, mbufBad, c4PackBytes, TestCIDPack_Pack::c4BadHashInd
+        );
+
+        if (bRes)
+        {
+            TestCIDPack_Pack::WriteFile(pathBad, mbufBad, c4PackBytes);
+            bRes = TestCIDPack_Pack::bExpectFailure
+            (
+                strmOut, pathBad, pathOut, c4Workers, kPackErrs::errcDbg_BadHash, L"Bad hash"
+            );
+        }
+
+        if (!bRes)
+            eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    //
+    //  Corrupt another one's size, which the worker should catch when it gets
+    //  the wrong size back from the decompression.
+    //
+    {
+        THeapBuf mbufBad(mbufGood);
+        tCIDLib::TBoolean bRes = TestCIDPack_Pack::bCorruptSize
+        (
+            strmOut, mbufBad, c4PackBytes, TestCIDPack_Pack::c4BadSizeInd
+        );
+
+        if (bRes)
+        {
+            TestCIDPack_Pack::WriteFile(pathBad, mbufBad, c4PackBytes);
+            bRes = TestCIDPack_Pack::bExpectFailure
+            (
+                strmOut, pathBad, pathOut, c4Workers, kPackErrs::errcDbg_NotOrgSize, L"Bad size"
+            );
+        }
+
+        if (!bRes)
+            eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    //
+    //  And the good one should still extract fine over the top of what the
+    //  failed ones left behind.
+    //
+    tCIDLib::TBoolean bGood;
+    TestCIDPack_Pack::c8Extract(strmOut, pathGood, pathOut, c4Workers, c4Count, bGood);
+    if (!bGood || !TestCIDPack_Pack::bCheckTree(strmOut, pathSrc, pathOut, c4Count, L"Good package"))
+        eRes = tTestFWLib::ETestRes::Failed;
+
+    if (eRes == tTestFWLib::ETestRes::Success)
+        TFileSys::RemovePath(pathRoot);
+    return eRes;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PackRoundTrip
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PackRoundTrip: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PackRoundTrip::TTest_PackRoundTrip() :
+
+    TTestFWTest
+    (
+        L"Package Round Trip", L"Packs and extracts serially and in parallel", 3
+    )
+{
+}
+
+TTest_PackRoundTrip::~TTest_PackRoundTrip()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PackRoundTrip: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PackRoundTrip::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    const tCIDLib::TCard4 c4Count = TestCIDPack_Pack::c4RoundTripFiles;
+    const tCIDLib::TCard4 c4Workers = TestCIDPack_Pack::c4ParWorkers();
+
+    TPathStr pathRoot;
+    if (!TestCIDPack_Pack::bMakeTestDir(strmOut, L"TestCIDPack_RoundTrip", pathRoot))
+        return tTestFWLib::ETestRes::Failed;
+
+    TPathStr pathSrc(pathRoot);
+    pathSrc.AddLevel(L"Src");
+    TPathStr pathSerOut(pathRoot);
+    pathSerOut.AddLevel(L"SerialOut");
+    TPathStr pathParOut(pathRoot);
+    pathParOut.AddLevel(L"ParallelOut");
+    TPathStr pathSerPack(pathRoot);
+    pathSerPack.AddLevel(L"Serial.CIDPack");
+    TPathStr pathParPack(pathRoot);
+    pathParPack.AddLevel(L"Parallel.CIDPack");
+
+    TestCIDPack_Pack::MakeTree(pathSrc, c4Count);
+    TFindBuf fndbTree;
+    TestCIDPack_Pack::c4LoadTree(pathSrc, fndbTree);
+
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  Pack it serially and in parallel. The parallel one writes them out in
+    //  the same order, so we should get the same bytes.
+    //
+    const tCIDLib::TCard8 c8SerPack = TestCIDPack_Pack::c8Pack
+    (
+        pathSerPack, pathSrc, fndbTree, 1
+    );
+    const tCIDLib::TCard8 c8ParPack = TestCIDPack_Pack::c8Pack
+    (
+        pathParPack, pathSrc, fndbTree, c4Workers
+    );
+
+    THeapBuf mbufSer(1024);
+    THeapBuf mbufPar(1024);
+    const tCIDLib::TCard4 c4SerBytes = TestCIDPack_Pack::c4ReadFile(pathSerPack, mbufSer);
+    const tCIDLib::TCard4 c4ParBytes = TestCIDPack_Pack::c4ReadFile(pathParPack, mbufPar);
+    if ((c4SerBytes != c4ParBytes) || !mbufSer.bCompare(mbufPar, c4SerBytes))
+    {
+        strmOut << TFWCurLn << L"Serial and parallel packages are different. Sizes="
+                << c4SerBytes << L"/" << c4ParBytes << L"\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // And extract it both ways and check that we get the original tree back
+    tCIDLib::TBoolean bGood;
+    const tCIDLib::TCard8 c8SerExtract = TestCIDPack_Pack::c8Extract
+    (
+        strmOut, pathSerPack, pathSerOut, 1, c4Count, bGood
+    );
+    if (!bGood || !TestCIDPack_Pack::bCheckTree(strmOut, pathSrc, pathSerOut, c4Count, L"Serial"))
+        eRes = tTestFWLib::ETestRes::Failed;
+
+    const tCIDLib::TCard8 c8ParExtract = TestCIDPack_Pack::c8Extract
+    (
+        strmOut, pathSerPack, pathParOut, c4Workers, c4Count, bGood
+    );
+    if (!bGood || !TestCIDPack_Pack::bCheckTree(strmOut, pathSrc, pathParOut, c4Count, L"Parallel"))
+        eRes = tTestFWLib::ETestRes::Failed;
+
+    strmOut << L"Pack " << c4Count << L" files, serial: " << c8SerPack << L"ms, "
+            << c4Workers << L" workers: " << c8ParPack << L"ms, speedup: "
+            << TestCIDPack_Pack::fSpeedup(c8SerPack, c8ParPack) << L"x\n"
+            << L"Extract " << c4Count << L" files, serial: " << c8SerExtract << L"ms, "
+            << c4Workers << L" workers: " << c8ParExtract << L"ms, speedup: "
+            << TestCIDPack_Pack::fSpeedup(c8SerExtract, c8ParExtract) << L"x\n";
+
+    if (eRes == tTestFWLib::ETestRes::Success)
+        TFileSys::RemovePath(pathRoot);
+    return eRes;
+}
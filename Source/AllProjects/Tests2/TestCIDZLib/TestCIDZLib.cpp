@@ -0,0 +1,111 @@
+//
+// FILE NAME: TestCIDZLib.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main implementation file of the test program.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "TestCIDZLib.hpp"
+
+
+// ----------------------------------------------------------------------------
+//  Magic macros
+// ----------------------------------------------------------------------------
+RTTIDecls(TZLibTestApp,TTestFWApp)
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibTestApp
+// PREFIX: tfwapp
+// ---------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+//  TZLibTestApp: Constructor and Destructor
+// ----------------------------------------------------------------------------
+TZLibTestApp::TZLibTestApp()
+{
+}
+
+TZLibTestApp::~TZLibTestApp()
+{
+}
+
+
+// ----------------------------------------------------------------------------
+//  TZLibTestApp: Public, inherited methods
+// ----------------------------------------------------------------------------
+tCIDLib::TBoolean TZLibTestApp::bInitialize(TString&)
+{
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TZLibTestApp::LoadTests()
+{
+    // Load up our tests on our parent class
+    AddTest(new TTest_CRC);
+    AddTest(new TTest_Formats);
+    AddTest(new TTest_ParComp);
+    AddTest(new TTest_PushComp);
+    AddTest(new TTest_PushDecomp);
+}
+
+tCIDLib::TVoid TZLibTestApp::PostTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TZLibTestApp::PreTest(const TTestFWTest&)
+{
+    // Nothing to do
+}
+
+tCIDLib::TVoid TZLibTestApp::Terminate()
+{
+    // Nothing to do
+}
+
+
+
+// ----------------------------------------------------------------------------
+//  Declare the test app object
+// ----------------------------------------------------------------------------
+TZLibTestApp   tfwappZLib;
+
+
+
+// ----------------------------------------------------------------------------
+//  Include magic main module code. We just point it at the test thread
+//  entry point of the test framework app class.
+// ----------------------------------------------------------------------------
+CIDLib_MainModule
+(
+    TThread
+    (
+        L"TestThread"
+        , TMemberFunc<TZLibTestApp>(&tfwappZLib, &TZLibTestApp::eTestThread)
+    )
+)
@@ -0,0 +1,301 @@
+//
+// FILE NAME: TestCIDZLib.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the main header file of the CIDZLib tests. We just declare all of
+//  the tests here.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+#pragma once
+
+
+// -----------------------------------------------------------------------------
+//  Include underlying headers
+// -----------------------------------------------------------------------------
+#include    "CIDZLib.hpp"
+#include    "TestFWLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_CRC
+// PREFIX: tfwt
+//
+//  Tests the CRC-32 used by the gzip format, against a simple byte at a time
+//  version.
+// ---------------------------------------------------------------------------
+class TTest_CRC : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_CRC();
+
+        TTest_CRC(const TTest_CRC&) = delete;
+        TTest_CRC(TTest_CRC&&) = delete;
+
+        ~TTest_CRC();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_CRC,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Formats
+// PREFIX: tfwt
+//
+//  Tests the zlib, gzip and raw deflate formats, including some known streams
+//  from the standard zlib library, and truncated and corrupted streams.
+// ---------------------------------------------------------------------------
+class TTest_Formats : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Formats();
+
+        TTest_Formats(const TTest_Formats&) = delete;
+        TTest_Formats(TTest_Formats&&) = delete;
+
+        ~TTest_Formats();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Formats,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ParComp
+// PREFIX: tfwt
+//
+//  Tests the block parallel compressor, round tripping it through the regular
+//  decompressor, for empty, single and multiple segment inputs.
+// ---------------------------------------------------------------------------
+class TTest_ParComp : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_ParComp();
+
+        TTest_ParComp(const TTest_ParComp&) = delete;
+        TTest_ParComp(TTest_ParComp&&) = delete;
+
+        ~TTest_ParComp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bRoundTrip
+        (
+                    TTextOutStream&         strmOut
+            , const tCIDZLib::EFormats      eFormat
+            , const TMemBuf&                mbufSrc
+            , const tCIDLib::TCard4         c4SrcBytes
+            , const tCIDLib::TCard4         c4Threads
+            ,       tCIDLib::TCard4&        c4CompBytes
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_ParComp,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PushComp
+// PREFIX: tfwt
+//
+//  Tests the push style compressor, round tripping it through the one shot
+//  decompressor.
+// ---------------------------------------------------------------------------
+class TTest_PushComp : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PushComp();
+
+        TTest_PushComp(const TTest_PushComp&) = delete;
+        TTest_PushComp(TTest_PushComp&&) = delete;
+
+        ~TTest_PushComp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PushComp,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PushDecomp
+// PREFIX: tfwt
+//
+//  Tests the push style decompressor, feeding it in chunks of various sizes,
+//  and making sure it catches truncated streams.
+// ---------------------------------------------------------------------------
+class TTest_PushDecomp : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PushDecomp();
+
+        TTest_PushDecomp(const TTest_PushDecomp&) = delete;
+        TTest_PushDecomp(TTest_PushDecomp&&) = delete;
+
+        ~TTest_PushDecomp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PushDecomp,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TZLibTestApp
+// PREFIX: tfwapp
+//
+//  This is our implementation of the test framework's test program framework.
+//  We just create a derivative and override some methods.
+// ---------------------------------------------------------------------------
+class TZLibTestApp : public TTestFWApp
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TZLibTestApp();
+
+        TZLibTestApp(const TZLibTestApp&) = delete;
+        TZLibTestApp(TZLibTestApp&&) = delete;
+
+        ~TZLibTestApp();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bInitialize
+        (
+                    TString&                strErr
+        )   override;
+
+        tCIDLib::TVoid LoadTests() override;
+
+        tCIDLib::TVoid PostTest
+        (
+            const   TTestFWTest&            tfwtFinished
+        )   override;
+
+        tCIDLib::TVoid PreTest
+        (
+            const   TTestFWTest&            tfwtStarting
+        )   override;
+
+        tCIDLib::TVoid Terminate() override;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TZLibTestApp,TTestFWApp)
+};
+
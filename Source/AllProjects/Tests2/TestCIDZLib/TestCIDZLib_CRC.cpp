@@ -0,0 +1,180 @@
+//
+// FILE NAME: TestCIDZLib_CRC.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the CRC-32 that the gzip format uses. It lives down in the
+//  kernel's raw memory namespace, but gzip is the reason it's there, so we test
+//  it here.
+//
+//  The real one does 8 bytes at a time via a set of slice tables. We check it
+//  against a simple byte at a time version, for every length around the 8 byte
+//  steps and every alignment, and in pieces.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDZLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_CRC,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDZLib_CRC
+    {
+        //
+        //  The simplest possible byte at a time CRC-32, to check the real one
+        //  against. This works on the raw (not inverted) value, as the real one
+        //  does.
+        //
+        tCIDLib::TCard4 c4RefCRC(       tCIDLib::TCard4         c4CRC
+                                , const tCIDLib::TCard1* const  pc1Data
+                                , const tCIDLib::TCard4         c4Count)
+        {
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                c4CRC ^= pc1Data[c4Index];
+                for (tCIDLib::TCard4 c4Bit = 0; c4Bit < 8; c4Bit++)
+                {
+                    if (c4CRC & 1)
+                        c4CRC = 0xEDB88320 ^ (c4CRC >> 1);
+                    else
+                        c4CRC >>= 1;
+                }
+            }
+            return c4CRC;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_CRC
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_CRC: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_CRC::TTest_CRC() :
+
+    TTestFWTest
+    (
+        L"CRC-32", L"Tests the sliced CRC-32 used by gzip", 2
+    )
+{
+}
+
+TTest_CRC::~TTest_CRC()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_CRC: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_CRC::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // The standard check value, and an empty buffer
+    {
+        const tCIDLib::TCard1 ac1Check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+        if (TRawMem::hshHashBuffer3309(ac1Check, 9) != 0xCBF43926)
+        {
+            strmOut << TFWCurLn << L"CRC-32 check value was wrong\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (TRawMem::hshHashBuffer3309(ac1Check, 0) != 0)
+        {
+            strmOut << TFWCurLn << L"CRC-32 of an empty buffer should be zero\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Do every length up to a few 8 byte steps, at each alignment, against the
+    //  reference version. And make sure that doing it in two pieces, split at
+    //  every point, gets the same result.
+    //
+    {
+        tCIDLib::TCard1 ac1Data[128];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 128; c4Index++)
+            ac1Data[c4Index] = tCIDLib::TCard1((c4Index * 37) ^ (c4Index >> 3));
+
+        tCIDLib::TCard4 c4Bad = 0;
+        tCIDLib::TCard4 c4BadSplit = 0;
+        for (tCIDLib::TCard4 c4Ofs = 0; c4Ofs < 8; c4Ofs++)
+        {
+            for (tCIDLib::TCard4 c4Len = 0; c4Len <= 64; c4Len++)
+            {
+                const tCIDLib::TCard1* pc1Cur = ac1Data + c4Ofs;
+                const tCIDLib::TCard4 c4Exp = TestCIDZLib_CRC::c4RefCRC
+                (
+                    kCIDLib::c4MaxCard, pc1Cur, c4Len
+                );
+                if (TRawMem::hshHashBuffer3309(kCIDLib::c4MaxCard, pc1Cur, c4Len) != c4Exp)
+                    c4Bad++;
+
+                for (tCIDLib::TCard4 c4Split = 0; c4Split <= c4Len; c4Split++)
+                {
+                    tCIDLib::TCard4 c4CRC = TRawMem::hshHashBuffer3309
+                    (
+                        kCIDLib::c4MaxCard, pc1Cur, c4Split
+                    );
+                    c4CRC = TRawMem::hshHashBuffer3309
+                    (
+                        c4CRC, pc1Cur + c4Split, c4Len - c4Split
+                    );
+                    if (c4CRC != c4Exp)
+                        c4BadSplit++;
+                }
+            }
+        }
+
+        if (c4Bad)
+        {
+            strmOut << TFWCurLn << c4Bad << L" CRCs didn't match the byte at a time version\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (c4BadSplit)
+        {
+            strmOut << TFWCurLn << c4BadSplit << L" CRCs were wrong when done in pieces\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
@@ -0,0 +1,336 @@
+//
+// FILE NAME: TestCIDZLib_Formats.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the zlib, gzip and raw deflate framing of the one shot
+//  compressor. We decompress some known streams created by the standard zlib
+//  library, round trip our own, and make sure that truncated or corrupted
+//  streams are rejected.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDZLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_Formats,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDZLib_Formats
+    {
+        // -----------------------------------------------------------------------
+        //  The known streams were all created by the standard zlib library from
+        //  this text, repeated 6 times, followed by the bytes 0 to 39.
+        // -----------------------------------------------------------------------
+        constexpr const tCIDLib::TSCh* const pszKnownText = "The quick brown fox jumps over the lazy dog. ";
+        constexpr tCIDLib::TCard4 c4KnownReps = 6;
+        constexpr tCIDLib::TCard4 c4KnownBytes = 310;
+
+        const tCIDLib::TCard1 ac1KnownZLib[] =
+        {
+            0x78, 0x9C, 0x0B, 0xC9, 0x48, 0x55, 0x28, 0x2C, 0xCD, 0x4C, 0xCE, 0x56,
+            0x48, 0x2A, 0xCA, 0x2F, 0xCF, 0x53, 0x48, 0xCB, 0xAF, 0x50, 0xC8, 0x2A,
+            0xCD, 0x2D, 0x28, 0x56, 0xC8, 0x2F, 0x4B, 0x2D, 0x52, 0x28, 0x01, 0x4A,
+            0xE7, 0x24, 0x56, 0x55, 0x2A, 0xA4, 0xE4, 0xA7, 0xEB, 0x29, 0x84, 0x0C,
+            0x77, 0xC5, 0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C,
+            0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC, 0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2,
+            0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2, 0x0A, 0x8A,
+            0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x00, 0xD0, 0xFD, 0x63, 0xF7
+        };
+
+        const tCIDLib::TCard1 ac1KnownRaw[] =
+        {
+            0x0B, 0xC9, 0x48, 0x55, 0x28, 0x2C, 0xCD, 0x4C, 0xCE, 0x56, 0x48, 0x2A,
+            0xCA, 0x2F, 0xCF, 0x53, 0x48, 0xCB, 0xAF, 0x50, 0xC8, 0x2A, 0xCD, 0x2D,
+            0x28, 0x56, 0xC8, 0x2F, 0x4B, 0x2D, 0x52, 0x28, 0x01, 0x4A, 0xE7, 0x24,
+            0x56, 0x55, 0x2A, 0xA4, 0xE4, 0xA7, 0xEB, 0x29, 0x84, 0x0C, 0x77, 0xC5,
+            0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC,
+            0x3C, 0xBC, 0x7C, 0xFC, 0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
+            0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2, 0x0A, 0x8A, 0x4A, 0xCA,
+            0x2A, 0xAA, 0x6A, 0xEA, 0x00
+        };
+
+        //
+        //  This one has the optional extra field, file name, and header CRC, so
+        //  that we test skipping over all of them.
+        //
+        const tCIDLib::TCard1 ac1KnownGZip[] =
+        {
+            0x1F, 0x8B, 0x08, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x06, 0x00,
+            0x41, 0x42, 0x02, 0x00, 0x78, 0x79, 0x74, 0x65, 0x73, 0x74, 0x2E, 0x74,
+            0x78, 0x74, 0x00, 0x2F, 0x57, 0x0B, 0xC9, 0x48, 0x55, 0x28, 0x2C, 0xCD,
+            0x4C, 0xCE, 0x56, 0x48, 0x2A, 0xCA, 0x2F, 0xCF, 0x53, 0x48, 0xCB, 0xAF,
+            0x50, 0xC8, 0x2A, 0xCD, 0x2D, 0x28, 0x56, 0xC8, 0x2F, 0x4B, 0x2D, 0x52,
+            0x28, 0x01, 0x4A, 0xE7, 0x24, 0x56, 0x55, 0x2A, 0xA4, 0xE4, 0xA7, 0xEB,
+            0x29, 0x84, 0x0C, 0x77, 0xC5, 0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C,
+            0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC, 0x02, 0x82, 0x42,
+            0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72,
+            0xF2, 0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x00, 0x11, 0xBD,
+            0x0C, 0x35, 0x36, 0x01, 0x00, 0x00
+        };
+
+
+        // Build up the data that the known streams were created from
+        tCIDLib::TVoid BuildKnownData(TMemBuf& mbufTar)
+        {
+            const tCIDLib::TCard4 c4TextLen = TRawStr::c4StrLen(pszKnownText);
+            tCIDLib::TCard4 c4At = 0;
+            for (tCIDLib::TCard4 c4Rep = 0; c4Rep < c4KnownReps; c4Rep++)
+            {
+                mbufTar.CopyIn(pszKnownText, c4TextLen, c4At);
+                c4At += c4TextLen;
+            }
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < 40; c4Index++)
+                mbufTar.PutCard1(tCIDLib::TCard1(c4Index), c4At++);
+        }
+
+
+        // Fill a buffer with a mix of compressible and random data
+        tCIDLib::TVoid FillData(TMemBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            tCIDLib::TCard4 c4Seed = 0x2468ACE0;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                c4Seed = (c4Seed * 1103515245) + 12345;
+                if ((c4Index / 1000) % 3)
+                    mbufTar.PutCard1(tCIDLib::TCard1(L'a' + ((c4Index / 5) % 26)), c4Index);
+                else
+                    mbufTar.PutCard1(tCIDLib::TCard1(c4Seed >> 16), c4Index);
+            }
+        }
+
+
+        //
+        //  Try to decompress the passed stream, which should fail. We return true
+        //  if it threw, else false.
+        //
+        tCIDLib::TBoolean bDecompFails(         TZLibCompressor&        zlibTest
+                                        , const tCIDLib::TCard1* const  pc1Data
+                                        , const tCIDLib::TCard4         c4Count)
+        {
+            try
+            {
+                TBinMBufInStream strmSrc(pc1Data, c4Count);
+                TBinMBufOutStream strmTar(1024UL);
+                zlibTest.c4Decompress(strmSrc, strmTar);
+            }
+
+            catch(TError&)
+            {
+                return kCIDLib::True;
+            }
+            return kCIDLib::False;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Formats
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Formats: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Formats::TTest_Formats() :
+
+    TTestFWTest
+    (
+        L"Formats", L"Tests the zlib, gzip and raw deflate formats", 3
+    )
+{
+}
+
+TTest_Formats::~TTest_Formats()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Formats: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Formats::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    const tCIDZLib::EFormats aeFormats[] =
+    {
+        tCIDZLib::EFormats::ZLib, tCIDZLib::EFormats::GZip, tCIDZLib::EFormats::Raw
+    };
+
+    //
+    //  Decompress the known streams, both in one shot and pushed a byte at a
+    //  time, so that the resumable inflate has to stop and start at every
+    //  possible point, including all through the gzip header.
+    //
+    {
+        THeapBuf mbufKnown(TestCIDZLib_Formats::c4KnownBytes);
+        TestCIDZLib_Formats::BuildKnownData(mbufKnown);
+
+        struct TKnownStrm
+        {
+            tCIDZLib::EFormats      eFormat;
+            const tCIDLib::TCard1*  pc1Data;
+            tCIDLib::TCard4         c4Count;
+        };
+        const TKnownStrm aKnown[] =
+        {
+            { tCIDZLib::EFormats::ZLib, TestCIDZLib_Formats::ac1KnownZLib, sizeof(TestCIDZLib_Formats::ac1KnownZLib) }
+          , { tCIDZLib::EFormats::GZip, TestCIDZLib_Formats::ac1KnownGZip, sizeof(TestCIDZLib_Formats::ac1KnownGZip) }
+          , { tCIDZLib::EFormats::Raw, TestCIDZLib_Formats::ac1KnownRaw, sizeof(TestCIDZLib_Formats::ac1KnownRaw) }
+        };
+
+        for (const TKnownStrm& knownCur : aKnown)
+        {
+            TZLibCompressor zlibTest(knownCur.eFormat);
+            TBinMBufInStream strmSrc(knownCur.pc1Data, knownCur.c4Count);
+            TBinMBufOutStream strmTar(1024UL);
+            const tCIDLib::TCard4 c4Bytes = zlibTest.c4Decompress(strmSrc, strmTar);
+            strmTar.Flush();
+            if ((c4Bytes != TestCIDZLib_Formats::c4KnownBytes)
+            ||  !strmTar.mbufData().bCompare(mbufKnown, c4Bytes))
+            {
+                strmOut << TFWCurLn << L"Known stream failed. Format="
+                        << tCIDLib::c4EnumOrd(knownCur.eFormat) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+
+            TZLibPushDecompressor zpdTest(knownCur.eFormat);
+            TBinMBufOutStream strmPush(1024UL);
+            tCIDLib::TCard4 c4PushBytes = 0;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < knownCur.c4Count; c4Index++)
+                c4PushBytes += zpdTest.c4Feed(knownCur.pc1Data + c4Index, 1, strmPush);
+            strmPush.Flush();
+
+            if (!zpdTest.bDone()
+            ||  (c4PushBytes != TestCIDZLib_Formats::c4KnownBytes)
+            ||  !strmPush.mbufData().bCompare(mbufKnown, c4PushBytes))
+            {
+                strmOut << TFWCurLn << L"Known stream failed when pushed a byte at a time. Format="
+                        << tCIDLib::c4EnumOrd(knownCur.eFormat) << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    //
+    //  Round trip our own streams in each format. Check that the gzip trailer
+    //  has the CRC and length of the data, and the header has the magic bytes.
+    //
+    const tCIDLib::TCard4 ac4Sizes[] = { 0, 1, 1000, 100000 };
+    THeapBuf mbufSrc(100000);
+    TestCIDZLib_Formats::FillData(mbufSrc, 100000);
+    for (const tCIDZLib::EFormats eFormat : aeFormats)
+    {
+        for (const tCIDLib::TCard4 c4Size : ac4Sizes)
+        {
+            TZLibCompressor zlibTest(eFormat);
+            TBinMBufInStream strmSrc(&mbufSrc, c4Size);
+            TBinMBufOutStream strmComp(c4Size + 1024);
+            const tCIDLib::TCard4 c4CompBytes = zlibTest.c4Compress(strmSrc, strmComp);
+            strmComp.Flush();
+
+            if (eFormat == tCIDZLib::EFormats::GZip)
+            {
+                const TMemBuf& mbufComp = strmComp.mbufData();
+                if ((c4CompBytes < 18)
+                ||  (mbufComp[0] != 0x1F)
+                ||  (mbufComp[1] != 0x8B)
+                ||  (mbufComp[2] != 8)
+                ||  (mbufComp.c4At(c4CompBytes - 8) != TRawMem::hshHashBuffer3309(mbufSrc.pc1Data(), c4Size))
+                ||  (mbufComp.c4At(c4CompBytes - 4) != c4Size))
+                {
+                    strmOut << TFWCurLn << L"GZip header or trailer was wrong. Size="
+                            << c4Size << L"\n\n";
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+
+            TBinMBufInStream strmComped(strmComp);
+            TBinMBufOutStream strmDecomp(c4Size + 16);
+            const tCIDLib::TCard4 c4DecompBytes = zlibTest.c4Decompress(strmComped, strmDecomp);
+            strmDecomp.Flush();
+
+            if ((c4DecompBytes != c4Size)
+            ||  (c4Size && !strmDecomp.mbufData().bCompare(mbufSrc, c4Size)))
+            {
+                strmOut << TFWCurLn << L"Round trip failed. Format="
+                        << tCIDLib::c4EnumOrd(eFormat) << L", Size=" << c4Size << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+
+            // Skip the truncation tests for empty input
+            if (!c4Size)
+                continue;
+
+            //
+            //  Now cut it off in the header, in the middle, and just before the
+            //  end, which for zlib and gzip is in the trailer. They should all
+            //  fail.
+            //
+            const tCIDLib::TCard4 ac4Cuts[] = { 1, c4CompBytes / 2, c4CompBytes - 1 };
+            for (const tCIDLib::TCard4 c4Cut : ac4Cuts)
+            {
+                if (!TestCIDZLib_Formats::bDecompFails(zlibTest, strmComp.mbufData().pc1Data(), c4Cut))
+                {
+                    strmOut << TFWCurLn << L"Truncated stream was accepted. Format="
+                            << tCIDLib::c4EnumOrd(eFormat) << L", Size=" << c4Size
+                            << L", Cut=" << c4Cut << L"\n\n";
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+
+            //
+            //  And corrupt the check value in the trailer, which should fail for
+            //  the formats that have one.
+            //
+            if (eFormat != tCIDZLib::EFormats::Raw)
+            {
+                THeapBuf mbufBad(strmComp.mbufData(), c4CompBytes);
+                const tCIDLib::TCard4 c4At = c4CompBytes - ((eFormat == tCIDZLib::EFormats::GZip) ? 8 : 1);
+                mbufBad.PutCard1(mbufBad[c4At] ^ 0x5A, c4At);
+                if (!TestCIDZLib_Formats::bDecompFails(zlibTest, mbufBad.pc1Data(), c4CompBytes))
+                {
+                    strmOut << TFWCurLn << L"Bad check value was accepted. Format="
+                            << tCIDLib::c4EnumOrd(eFormat) << L", Size=" << c4Size << L"\n\n";
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+        }
+    }
+    return eRes;
+}
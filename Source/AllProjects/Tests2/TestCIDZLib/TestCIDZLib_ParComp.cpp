@@ -0,0 +1,243 @@
+//
+// FILE NAME: TestCIDZLib_ParComp.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the block parallel compressor. Everything it creates has to
+//  be a normal stream that the regular decompressor can handle, so we round
+//  trip through that, for each format.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDZLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_ParComp,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDZLib_ParComp
+    {
+        // -----------------------------------------------------------------------
+        //  c4RepBlockSz
+        //      The size of the random block we repeat to test that segments are
+        //      primed with the data before them. It's less than a window, so
+        //      every repeat can be matched against the previous one.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4RepBlockSz = 20000;
+
+
+        //
+        //  Fill a buffer with test data, a mix of text like runs, which will get
+        //  compressed well, and pseudo-random bytes, which won't. It's always the
+        //  same for a given size.
+        //
+        tCIDLib::TVoid FillData(TMemBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            tCIDLib::TCard4 c4Seed = 0x12345678;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                c4Seed = (c4Seed * 1103515245) + 12345;
+                if ((c4Index / 4096) & 1)
+                    mbufTar.PutCard1(tCIDLib::TCard1(c4Seed >> 16), c4Index);
+                else
+                    mbufTar.PutCard1(tCIDLib::TCard1(L'A' + ((c4Index / 7) % 26)), c4Index);
+            }
+        }
+
+
+        //
+        //  Fill a buffer with a block of random data, repeated over and over. If
+        //  each segment doesn't see the end of the one before it, it has to put
+        //  out a whole copy of the block at least once.
+        //
+        tCIDLib::TVoid FillRepeated(TMemBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            tCIDLib::TCard4 c4Seed = 0x87654321;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                if (c4Index < c4RepBlockSz)
+                {
+                    c4Seed = (c4Seed * 1103515245) + 12345;
+                    mbufTar.PutCard1(tCIDLib::TCard1(c4Seed >> 16), c4Index);
+                }
+                 else
+                {
+                    mbufTar.PutCard1(mbufTar[c4Index - c4RepBlockSz], c4Index);
+                }
+            }
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_ParComp
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_ParComp: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_ParComp::TTest_ParComp() :
+
+    TTestFWTest
+    (
+        L"Parallel Compress", L"Round trips the block parallel compressor", 3
+    )
+{
+}
+
+TTest_ParComp::~TTest_ParComp()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ParComp: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_ParComp::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  The sizes we test, in terms of the segment size. So empty, less than
+    //  one segment, exactly one batch for two threads (which ends with an
+    //  empty final block), and several batches with a partial last segment.
+    //
+    const tCIDLib::TCard4 c4SegSz = kCIDZLib::c4ParSegSz;
+    const tCIDLib::TCard4 ac4Sizes[] =
+    {
+        0, 1, 1000, c4SegSz, c4SegSz * 2, (c4SegSz * 5) + (c4SegSz / 2)
+    };
+
+    const tCIDZLib::EFormats aeFormats[] =
+    {
+        tCIDZLib::EFormats::ZLib, tCIDZLib::EFormats::GZip, tCIDZLib::EFormats::Raw
+    };
+
+    THeapBuf mbufSrc(ac4Sizes[tCIDLib::c4ArrayElems(ac4Sizes) - 1] + 16);
+    TestCIDZLib_ParComp::FillData(mbufSrc, mbufSrc.c4Size());
+
+    tCIDLib::TCard4 c4CompBytes;
+    for (const tCIDZLib::EFormats eFormat : aeFormats)
+    {
+        for (const tCIDLib::TCard4 c4Size : ac4Sizes)
+        {
+            //
+            //  Do one thread, which should just do a regular compress, and two
+            //  and four threads, which should get the same data back.
+            //
+            if (!bRoundTrip(strmOut, eFormat, mbufSrc, c4Size, 1, c4CompBytes)
+            ||  !bRoundTrip(strmOut, eFormat, mbufSrc, c4Size, 2, c4CompBytes)
+            ||  !bRoundTrip(strmOut, eFormat, mbufSrc, c4Size, 4, c4CompBytes))
+            {
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    //
+    //  Each segment is primed with the end of the data before it, so that it
+    //  can match back across the boundary. With a repeated block, that means
+    //  the block only has to be stored once. If the segments weren't primed,
+    //  each of the four would have to store it once.
+    //
+    {
+        const tCIDLib::TCard4 c4Size = c4SegSz * 4;
+        THeapBuf mbufRep(c4Size);
+        TestCIDZLib_ParComp::FillRepeated(mbufRep, c4Size);
+        if (!bRoundTrip(strmOut, tCIDZLib::EFormats::ZLib, mbufRep, c4Size, 4, c4CompBytes))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+         else if (c4CompBytes > TestCIDZLib_ParComp::c4RepBlockSz * 2)
+        {
+            strmOut << TFWCurLn << L"Repeated data compressed to " << c4CompBytes
+                    << L" bytes, so segments were not primed with the previous data\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_ParComp: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Compresses the indicated number of source bytes in parallel, then decompresses
+//  them with the regular decompressor and makes sure we get the same data back.
+//  We return the compressed size, for tests that want to check it.
+//
+tCIDLib::TBoolean
+TTest_ParComp::bRoundTrip(          TTextOutStream&     strmOut
+                            , const tCIDZLib::EFormats  eFormat
+                            , const TMemBuf&            mbufSrc
+                            , const tCIDLib::TCard4     c4SrcBytes
+                            , const tCIDLib::TCard4     c4Threads
+                            ,       tCIDLib::TCard4&    c4CompBytes)
+{
+    TZLibCompressor zlibTest(eFormat);
+
+    TBinMBufInStream strmSrc(&mbufSrc, c4SrcBytes);
+    TBinMBufOutStream strmComp(c4SrcBytes + 1024);
+    c4CompBytes = zlibTest.c4CompressPar(strmSrc, strmComp, kCIDLib::c4MaxCard, c4Threads);
+    strmComp.Flush();
+
+    if (c4CompBytes != strmComp.c4CurSize())
+    {
+        strmOut << TFWCurLn << L"Compressed size was wrong. Size="
+                << c4SrcBytes << L", Threads=" << c4Threads << L"\n\n";
+        return kCIDLib::False;
+    }
+
+    TBinMBufInStream strmComped(strmComp);
+    TBinMBufOutStream strmDecomp(c4SrcBytes + 16);
+    const tCIDLib::TCard4 c4DecompBytes = zlibTest.c4Decompress(strmComped, strmDecomp);
+    strmDecomp.Flush();
+
+    if ((c4DecompBytes != c4SrcBytes)
+    ||  (strmDecomp.c4CurSize() != c4SrcBytes)
+    ||  (c4SrcBytes && !strmDecomp.mbufData().bCompare(mbufSrc, c4SrcBytes)))
+    {
+        strmOut << TFWCurLn << L"Round trip failed. Format="
+                << tCIDLib::c4EnumOrd(eFormat) << L", Size=" << c4SrcBytes
+                << L", Threads=" << c4Threads << L"\n\n";
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
@@ -0,0 +1,427 @@
+//
+// FILE NAME: TestCIDZLib_Push.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/18/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2019
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file tests the push style compressor and decompressor. They have to
+//  interoperate with the one shot versions, so we round trip in both
+//  directions, feeding data in various sized chunks. And the decompressor has
+//  to know when it got a truncated stream.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $_CIDLib_Log_$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCIDZLib.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_PushComp,TTestFWTest)
+RTTIDecls(TTest_PushDecomp,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace TestCIDZLib_Push
+    {
+        // -----------------------------------------------------------------------
+        //  c4DataSz
+        //      The size of the test data, which is enough to go through the
+        //      push compressor's buffer a few times.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4DataSz = (kCIDZLib::c4PushBufSz * 3) + 1234;
+
+        const tCIDZLib::EFormats aeFormats[] =
+        {
+            tCIDZLib::EFormats::ZLib, tCIDZLib::EFormats::GZip, tCIDZLib::EFormats::Raw
+        };
+
+        // The chunk sizes that we feed data in
+        const tCIDLib::TCard4 ac4Chunks[] = { 1, 7, 4096, kCIDZLib::c4PushBufSz + 1, c4DataSz };
+
+
+        // Fill a buffer with a mix of compressible and random data
+        tCIDLib::TVoid FillData(TMemBuf& mbufTar, const tCIDLib::TCard4 c4Bytes)
+        {
+            tCIDLib::TCard4 c4Seed = 0x13579BDF;
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                c4Seed = (c4Seed * 1103515245) + 12345;
+                if ((c4Index / 3000) & 1)
+                    mbufTar.PutCard1(tCIDLib::TCard1(c4Seed >> 16), c4Index);
+                else
+                    mbufTar.PutCard1(tCIDLib::TCard1(L'0' + ((c4Index / 11) % 10)), c4Index);
+            }
+        }
+
+
+        //
+        //  Push the passed data through a push compressor in chunks of the
+        //  indicated size. If asked, we do a flush after the first chunk.
+        //
+        tCIDLib::TCard4 c4PushComp(         TZLibPushCompressor&    zpcTest
+                                    , const TMemBuf&                mbufSrc
+                                    , const tCIDLib::TCard4         c4SrcBytes
+                                    , const tCIDLib::TCard4         c4Chunk
+                                    , const tCIDLib::TBoolean       bFlush
+                                    ,       TBinMBufOutStream&      strmTar)
+        {
+            tCIDLib::TCard4 c4Ret = 0;
+            tCIDLib::TCard4 c4Done = 0;
+            while (c4Done < c4SrcBytes)
+            {
+                const tCIDLib::TCard4 c4ThisTime = tCIDLib::MinVal(c4Chunk, c4SrcBytes - c4Done);
+                c4Ret += zpcTest.c4Feed(mbufSrc.pc1DataAt(c4Done), c4ThisTime, strmTar);
+                if (bFlush && !c4Done)
+                    c4Ret += zpcTest.c4Flush(strmTar);
+                c4Done += c4ThisTime;
+            }
+            c4Ret += zpcTest.c4Finish(strmTar);
+            strmTar.Flush();
+            return c4Ret;
+        }
+
+
+        //
+        //  Push the passed compressed data through a push decompressor in chunks
+        //  of the indicated size. It doesn't call Finish, so that the caller can
+        //  check what happens.
+        //
+        tCIDLib::TCard4 c4PushDecomp(       TZLibPushDecompressor&  zpdTest
+                                    , const tCIDLib::TCard1* const  pc1Src
+                                    , const tCIDLib::TCard4         c4SrcBytes
+                                    , const tCIDLib::TCard4         c4Chunk
+                                    ,       TBinMBufOutStream&      strmTar)
+        {
+            tCIDLib::TCard4 c4Ret = 0;
+            tCIDLib::TCard4 c4Done = 0;
+            while (c4Done < c4SrcBytes)
+            {
+                const tCIDLib::TCard4 c4ThisTime = tCIDLib::MinVal(c4Chunk, c4SrcBytes - c4Done);
+                c4Ret += zpdTest.c4Feed(pc1Src + c4Done, c4ThisTime, strmTar);
+                c4Done += c4ThisTime;
+            }
+            strmTar.Flush();
+            return c4Ret;
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PushComp
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PushComp: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PushComp::TTest_PushComp() :
+
+    TTestFWTest
+    (
+        L"Push Compress", L"Tests the push style compressor", 3
+    )
+{
+}
+
+TTest_PushComp::~TTest_PushComp()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PushComp: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PushComp::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    THeapBuf mbufSrc(TestCIDZLib_Push::c4DataSz);
+    TestCIDZLib_Push::FillData(mbufSrc, TestCIDZLib_Push::c4DataSz);
+
+    //
+    //  Push it through in chunks of various sizes, with and without a flush,
+    //  and make sure the one shot decompressor gets the data back. We use the
+    //  same compressor each time, resetting it, to make sure that works.
+    //
+    for (const tCIDZLib::EFormats eFormat : TestCIDZLib_Push::aeFormats)
+    {
+        TZLibPushCompressor zpcTest(eFormat);
+        TZLibCompressor zlibTest(eFormat);
+        for (const tCIDLib::TCard4 c4Chunk : TestCIDZLib_Push::ac4Chunks)
+        {
+            for (tCIDLib::TCard4 c4Flush = 0; c4Flush < 2; c4Flush++)
+            {
+                zpcTest.Reset();
+                TBinMBufOutStream strmComp(TestCIDZLib_Push::c4DataSz + 1024);
+                const tCIDLib::TCard4 c4CompBytes = TestCIDZLib_Push::c4PushComp
+                (
+                    zpcTest
+                    , mbufSrc
+                    , TestCIDZLib_Push::c4DataSz
+                    , c4Chunk
+                    , c4Flush != 0
+                    , strmComp
+                );
+
+                TBinMBufInStream strmComped(strmComp);
+                TBinMBufOutStream strmDecomp(TestCIDZLib_Push::c4DataSz + 16);
+                const tCIDLib::TCard4 c4DecompBytes = zlibTest.c4Decompress(strmComped, strmDecomp);
+                strmDecomp.Flush();
+
+                if (!zpcTest.bFinished()
+                ||  (zpcTest.c4TotalIn() != TestCIDZLib_Push::c4DataSz)
+                ||  (zpcTest.c4TotalOut() != c4CompBytes)
+                ||  (strmComp.c4CurSize() != c4CompBytes)
+                ||  (c4DecompBytes != TestCIDZLib_Push::c4DataSz)
+                ||  !strmDecomp.mbufData().bCompare(mbufSrc, TestCIDZLib_Push::c4DataSz))
+                {
+                    strmOut << TFWCurLn << L"Push compress round trip failed. Format="
+                            << tCIDLib::c4EnumOrd(eFormat) << L", Chunk=" << c4Chunk
+                            << L", Flush=" << c4Flush << L"\n\n";
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+        }
+
+        // An empty stream should work as well
+        zpcTest.Reset();
+        TBinMBufOutStream strmComp(1024UL);
+        TestCIDZLib_Push::c4PushComp(zpcTest, mbufSrc, 0, 1, kCIDLib::False, strmComp);
+        TBinMBufInStream strmComped(strmComp);
+        TBinMBufOutStream strmDecomp(16UL);
+        if (zlibTest.c4Decompress(strmComped, strmDecomp))
+        {
+            strmOut << TFWCurLn << L"Empty push compress round trip failed. Format="
+                    << tCIDLib::c4EnumOrd(eFormat) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  A flush has to push out everything fed so far, such that the other side
+    //  can decompress all of it, even though the stream isn't finished.
+    //
+    for (const tCIDZLib::EFormats eFormat : TestCIDZLib_Push::aeFormats)
+    {
+        const tCIDLib::TCard4 c4Part = 5000;
+        TZLibPushCompressor zpcTest(eFormat);
+        TZLibPushDecompressor zpdTest(eFormat);
+        TBinMBufOutStream strmComp(TestCIDZLib_Push::c4DataSz + 1024);
+        TBinMBufOutStream strmDecomp(TestCIDZLib_Push::c4DataSz + 16);
+
+        zpcTest.c4Feed(mbufSrc, c4Part, strmComp);
+        zpcTest.c4Flush(strmComp);
+        strmComp.Flush();
+
+        const tCIDLib::TCard4 c4Got = zpdTest.c4Feed
+        (
+            strmComp.mbufData(), strmComp.c4CurSize(), strmDecomp
+        );
+        strmDecomp.Flush();
+
+        if (zpdTest.bDone()
+        ||  (c4Got != c4Part)
+        ||  !strmDecomp.mbufData().bCompare(mbufSrc, c4Part))
+        {
+            strmOut << TFWCurLn << L"Flushed data could not all be decompressed. Format="
+                    << tCIDLib::c4EnumOrd(eFormat) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Once finished, it has to be reset before it can be used again
+    {
+        TZLibPushCompressor zpcTest;
+        TBinMBufOutStream strmComp(1024UL);
+        zpcTest.c4Feed(mbufSrc, 100, strmComp);
+        zpcTest.c4Finish(strmComp);
+
+        tCIDLib::TBoolean bCaught = kCIDLib::False;
+        try
+        {
+            zpcTest.c4Feed(mbufSrc, 100, strmComp);
+        }
+
+        catch(TError& errToCatch)
+        {
+            bCaught = errToCatch.bCheckEvent
+            (
+                facCIDZLib().strName(), kZLibErrs::errcPush_Finished
+            );
+        }
+
+        if (!bCaught)
+        {
+            strmOut << TFWCurLn << L"Feeding a finished compressor was allowed\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PushDecomp
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PushDecomp: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PushDecomp::TTest_PushDecomp() :
+
+    TTestFWTest
+    (
+        L"Push Decompress", L"Tests the push style decompressor", 3
+    )
+{
+}
+
+TTest_PushDecomp::~TTest_PushDecomp()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PushDecomp: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PushDecomp::eRunTest(TTextStringOutStream& strmOut, tCIDLib::TBoolean& bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    THeapBuf mbufSrc(TestCIDZLib_Push::c4DataSz);
+    TestCIDZLib_Push::FillData(mbufSrc, TestCIDZLib_Push::c4DataSz);
+
+    for (const tCIDZLib::EFormats eFormat : TestCIDZLib_Push::aeFormats)
+    {
+        // Compress it in one shot
+        TZLibCompressor zlibTest(eFormat);
+        TBinMBufInStream strmSrc(&mbufSrc, TestCIDZLib_Push::c4DataSz);
+        TBinMBufOutStream strmComp(TestCIDZLib_Push::c4DataSz + 1024);
+        const tCIDLib::TCard4 c4CompBytes = zlibTest.c4Compress(strmSrc, strmComp);
+        strmComp.Flush();
+
+        //
+        //  Add some junk to the end. Anything after the end of the stream should
+        //  be ignored.
+        //
+        THeapBuf mbufComp(c4CompBytes + 64);
+        mbufComp.CopyIn(strmComp.mbufData(), c4CompBytes, 0);
+        mbufComp.Set(0xAC, c4CompBytes, 64);
+        const tCIDLib::TCard1* const pc1Comp = mbufComp.pc1Data();
+
+        //
+        //  And push it through the decompressor in chunks of various sizes, so
+        //  that it has to stop and pick up again at many different points.
+        //
+        TZLibPushDecompressor zpdTest(eFormat);
+        for (const tCIDLib::TCard4 c4Chunk : TestCIDZLib_Push::ac4Chunks)
+        {
+            zpdTest.Reset();
+            TBinMBufOutStream strmDecomp(TestCIDZLib_Push::c4DataSz + 16);
+            const tCIDLib::TCard4 c4Got = TestCIDZLib_Push::c4PushDecomp
+            (
+                zpdTest, pc1Comp, c4CompBytes + 64, c4Chunk, strmDecomp
+            );
+
+            if (!zpdTest.bDone()
+            ||  (c4Got != TestCIDZLib_Push::c4DataSz)
+            ||  (zpdTest.c4TotalOut() != c4Got)
+            ||  !strmDecomp.mbufData().bCompare(mbufSrc, TestCIDZLib_Push::c4DataSz))
+            {
+                strmOut << TFWCurLn << L"Push decompress failed. Format="
+                        << tCIDLib::c4EnumOrd(eFormat) << L", Chunk=" << c4Chunk << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+
+            // It's complete so finishing should be happy
+            try
+            {
+                zpdTest.Finish();
+            }
+
+            catch(TError&)
+            {
+                strmOut << TFWCurLn << L"Finish failed on a complete stream. Format="
+                        << tCIDLib::c4EnumOrd(eFormat) << L", Chunk=" << c4Chunk << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        //
+        //  Now cut it off in the header, in the middle, and just before the end.
+        //  It shouldn't be done, and finishing should say it was truncated. It
+        //  should still be usable after a reset.
+        //
+        const tCIDLib::TCard4 ac4Cuts[] = { 1, c4CompBytes / 2, c4CompBytes - 1 };
+        for (const tCIDLib::TCard4 c4Cut : ac4Cuts)
+        {
+            zpdTest.Reset();
+            TBinMBufOutStream strmDecomp(TestCIDZLib_Push::c4DataSz + 16);
+            TestCIDZLib_Push::c4PushDecomp(zpdTest, pc1Comp, c4Cut, 4096, strmDecomp);
+
+            tCIDLib::TBoolean bCaught = kCIDLib::False;
+            try
+            {
+                zpdTest.Finish();
+            }
+
+            catch(TError& errToCatch)
+            {
+                bCaught = errToCatch.bCheckEvent
+                (
+                    facCIDZLib().strName(), kZLibErrs::errcInfl_Truncated
+                );
+            }
+
+            if (zpdTest.bDone() || !bCaught)
+            {
+                strmOut << TFWCurLn << L"Truncated stream was not caught. Format="
+                        << tCIDLib::c4EnumOrd(eFormat) << L", Cut=" << c4Cut << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        zpdTest.Reset();
+        TBinMBufOutStream strmDecomp(TestCIDZLib_Push::c4DataSz + 16);
+        TestCIDZLib_Push::c4PushDecomp(zpdTest, pc1Comp, c4CompBytes, 4096, strmDecomp);
+        if (!zpdTest.bDone() || !strmDecomp.mbufData().bCompare(mbufSrc, TestCIDZLib_Push::c4DataSz))
+        {
+            strmOut << TFWCurLn << L"Reset after truncation failed. Format="
+                    << tCIDLib::c4EnumOrd(eFormat) << L"\n\n";
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return eRes;
+}
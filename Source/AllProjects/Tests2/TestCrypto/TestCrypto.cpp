@@ -202,11 +202,15 @@ tCIDLib::TVoid TCryptoTestApp::LoadTests()
     AddTest(new TTest_MD51);
     AddTest(new TTest_SHA1_1);
     AddTest(new TTest_SHA256_1);
+    AddTest(new TTest_SHA256_2);
     AddTest(new TTest_HMACSHA256);
+    AddTest(new TTest_HMACSHA256_2);
     AddTest(new TTest_UniqueId1);
     AddTest(new TTest_AES1);
     AddTest(new TTest_AES2);
     AddTest(new TTest_AES3);
+    AddTest(new TTest_AES4);
+    AddTest(new TTest_AES5);
     AddTest(new TTest_Blowfish1);
     AddTest(new TTest_XOR1);
 }
@@ -213,6 +213,40 @@ class TTest_SHA256_1 : public TTest_BaseCrypto
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SHA256_2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_SHA256_2 : public TTest_BaseCrypto
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_SHA256_2();
+
+        ~TTest_SHA256_2();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_SHA256_2,TTest_BaseCrypto)
+};
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_HMACSHA256
 // PREFIX: tfwt
@@ -247,6 +281,40 @@ class TTest_HMACSHA256 : public TTest_BaseCrypto
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_HMACSHA256_2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_HMACSHA256_2 : public TTest_BaseCrypto
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_HMACSHA256_2();
+
+        ~TTest_HMACSHA256_2();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_HMACSHA256_2,TTest_BaseCrypto)
+};
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_UniqueId1
 // PREFIX: tfwt
@@ -401,6 +469,72 @@ class TTest_AES3 : public TTest_BaseCrypto
 };
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_AES4
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_AES4 : public TTest_BaseCrypto
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_AES4();
+
+        ~TTest_AES4();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_AES4,TTestFWTest)
+};
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_AES5
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_AES5 : public TTest_BaseCrypto
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_AES5();
+
+        ~TTest_AES5();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_AES5,TTestFWTest)
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_Blowfish1
 // PREFIX: tfwt
@@ -37,6 +37,8 @@
 RTTIDecls(TTest_AES1, TTest_BaseCrypto)
 RTTIDecls(TTest_AES2, TTestFWTest)
 RTTIDecls(TTest_AES3, TTestFWTest)
+RTTIDecls(TTest_AES4, TTestFWTest)
+RTTIDecls(TTest_AES5, TTestFWTest)
 
 
 // ---------------------------------------------------------------------------
@@ -360,6 +362,56 @@ TTest_AES3::eRunTest(TTextStringOutStream&  strmOut
             }
         }
     }
+
+
+    //
+    //  Do some CTR mode tests. The first is from SP800-38A, the second has a
+    //  partial last block and makes the counter carry across the low 64 bits.
+    //
+    {
+        TTest aTests[] =
+        {
+            {
+                L"2b7e151628aed2a6abf7158809cf4f3c"
+                , L"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+                , L"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+                  L"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"
+                , L"874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+                  L"5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"
+            }
+          , {
+                L"2b7e151628aed2a6abf7158809cf4f3c"
+                , L"0000000000000000fffffffffffffffe"
+                , L"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+                  L"30c81c46a35ce411e5fb"
+                , L"393993cf1e6593644880765e7f951dda41aabde09dc756147830813822a8b13f"
+                  L"ecc227852555267e8ad1"
+            }
+        };
+        const tCIDLib::TCard4 c4TestCnt = tCIDLib::c4ArrayElems(aTests);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCnt; c4Index++)
+        {
+            const TTest& curTest = aTests[c4Index];
+            const tCIDLib::TBoolean bRes = bDoOne
+            (
+                strmOut
+                , tCIDCrypto::EBlockModes::CTR
+                , curTest.pchKey
+                , curTest.pchIV
+                , curTest.pchPlain
+                , curTest.pchCypher
+            );
+
+            if (!bRes)
+            {
+                strmOut << TFWCurLn
+                        << L"CTR test " << (c4Index + 1) << L" failed"
+                        << kCIDLib::DNewLn;
+                eRes = tTestFWLib::ETestRes::Failed;
+                break;
+            }
+        }
+    }
     return eRes;
 }
 
@@ -404,8 +456,8 @@ TTest_AES3::bDoOne(         TTextStringOutStream&   strmOut
         return kCIDLib::False;
     }
 
-    // Cypher text has to be multple of block
-    if (c4CypherLen % crypTest.c4BlockSize())
+    // Cypher text has to be multple of block, except for CTR which isn't padded
+    if ((eMode != tCIDCrypto::EBlockModes::CTR) && (c4CypherLen % crypTest.c4BlockSize()))
     {
         strmOut << TFWCurLn << L"Cypher text not multiple of block size" << kCIDLib::DNewLn;
         return kCIDLib::False;
@@ -443,7 +495,7 @@ TTest_AES3::bDoOne(         TTextStringOutStream&   strmOut
     );
 
     // And compare to the original now
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4CypherLen; c4Index++)
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PlainLen; c4Index++)
     {
         if (pc1Plain[c4Index] != pc1Out[c4Index])
         {
@@ -485,3 +537,341 @@ TTest_AES3::pc1ConvertVal(          TTextStringOutStream&   strmOut
     }
     return pc1Ret;
 }
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_AES4
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_AES4: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_AES4::TTest_AES4() :
+
+    TTest_BaseCrypto(L"AES 4", L"AES GCM mode tests", 4)
+{
+}
+
+TTest_AES4::~TTest_AES4()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_AES4: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_AES4::eRunTest(TTextStringOutStream&  strmOut
+                    , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  This is test case 4 from the original GCM spec, which has additional
+    //  data and a partial last block. The IV is the 12 byte nonce, padded out
+    //  to the block size.
+    //
+    const tCIDLib::TCard1 ac1Key[16] =
+    {
+        0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C
+      , 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08
+    };
+
+    const tCIDLib::TCard1 ac1IV[16] =
+    {
+        0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD
+      , 0xDE, 0xCA, 0xF8, 0x88, 0x00, 0x00, 0x00, 0x00
+    };
+
+    const tCIDLib::TCard1 ac1Auth[20] =
+    {
+        0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF
+      , 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF
+      , 0xAB, 0xAD, 0xDA, 0xD2
+    };
+
+    const tCIDLib::TCard1 ac1Plain[60] =
+    {
+        0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5
+      , 0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A
+      , 0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA
+      , 0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72
+      , 0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53
+      , 0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25
+      , 0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57
+      , 0xBA, 0x63, 0x7B, 0x39
+    };
+
+    // The cypher text with the 16 byte tag on the end
+    const tCIDLib::TCard1 ac1Cypher[76] =
+    {
+        0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24
+      , 0x4B, 0x72, 0x21, 0xB7, 0x84, 0xD0, 0xD4, 0x9C
+      , 0xE3, 0xAA, 0x21, 0x2F, 0x2C, 0x02, 0xA4, 0xE0
+      , 0x35, 0xC1, 0x7E, 0x23, 0x29, 0xAC, 0xA1, 0x2E
+      , 0x21, 0xD5, 0x14, 0xB2, 0x54, 0x66, 0x93, 0x1C
+      , 0x7D, 0x8F, 0x6A, 0x5A, 0xAC, 0x84, 0xAA, 0x05
+      , 0x1B, 0xA3, 0x0B, 0x39, 0x6A, 0x0A, 0xAC, 0x97
+      , 0x3D, 0x58, 0xE0, 0x91
+      , 0x5B, 0xC9, 0x4F, 0xBC, 0x32, 0x21, 0xA5, 0xDB
+      , 0x94, 0xFA, 0xE9, 0x5A, 0xE7, 0x12, 0x1A, 0x47
+    };
+
+    TCryptoKey ckeyTest(ac1Key, 16);
+    TAESEncrypter crypTest(ckeyTest, tCIDCrypto::EBlockModes::GCM);
+    crypTest.SetAuthData(ac1Auth, 20);
+
+    tCIDLib::TCard1 ac1Out[76];
+    tCIDLib::TCard4 c4Bytes = crypTest.c4Encrypt(ac1Plain, ac1Out, 60, 76, ac1IV);
+    if (c4Bytes != 76)
+    {
+        strmOut << TFWCurLn << L"Expected 76 GCM output bytes but got "
+                << c4Bytes << kCIDLib::DNewLn;
+        return tTestFWLib::ETestRes::Failed;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < 76; c4Index++)
+    {
+        if (ac1Cypher[c4Index] != ac1Out[c4Index])
+        {
+            strmOut << TFWCurLn << L"Got incorrect GCM cypher text at index "
+                    << c4Index << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    c4Bytes = crypTest.c4Decrypt(ac1Cypher, ac1Out, 76, 76, ac1IV);
+    if (c4Bytes != 60)
+    {
+        strmOut << TFWCurLn << L"Expected 60 GCM plain text bytes but got "
+                << c4Bytes << kCIDLib::DNewLn;
+        return tTestFWLib::ETestRes::Failed;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < 60; c4Index++)
+    {
+        if (ac1Plain[c4Index] != ac1Out[c4Index])
+        {
+            strmOut << TFWCurLn << L"Got incorrect GCM plain text at index "
+                    << c4Index << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Now change a byte of the cypher text, and then of the additional
+    //  data. Both must fail authentication.
+    //
+    tCIDLib::TCard1 ac1Bad[76];
+    TRawMem::CopyMemBuf(ac1Bad, ac1Cypher, 76);
+    ac1Bad[33] ^= 0x10;
+    for (tCIDLib::TCard4 c4Pass = 0; c4Pass < 2; c4Pass++)
+    {
+        tCIDLib::TBoolean bCaughtIt = kCIDLib::False;
+        try
+        {
+            if (c4Pass)
+            {
+                tCIDLib::TCard1 ac1BadAuth[20];
+                TRawMem::CopyMemBuf(ac1BadAuth, ac1Auth, 20);
+                ac1BadAuth[0] ^= 1;
+                crypTest.SetAuthData(ac1BadAuth, 20);
+                crypTest.c4Decrypt(ac1Cypher, ac1Out, 76, 76, ac1IV);
+            }
+             else
+            {
+                crypTest.c4Decrypt(ac1Bad, ac1Out, 76, 76, ac1IV);
+            }
+        }
+
+        catch(const TError& errToCatch)
+        {
+            if (errToCatch.bCheckEvent(facCIDCrypto().strName(), kCryptoErrs::errcBlock_AuthFailed))
+            {
+                bCaughtIt = kCIDLib::True;
+            }
+             else
+            {
+                strmOut << TFWCurLn << L"Got the wrong exception" << kCIDLib::NewLn
+                        << errToCatch << kCIDLib::DNewLn;
+                return tTestFWLib::ETestRes::Failed;
+            }
+        }
+
+        if (!bCaughtIt)
+        {
+            strmOut << TFWCurLn << L"Modified GCM "
+                    << (c4Pass ? L"additional data" : L"cypher text")
+                    << L" was not rejected" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And do a bigger round trip without additional data, enough to go
+    //  through multiple internal batches and end in a partial block.
+    //
+    crypTest.ClearAuthData();
+    const tCIDLib::TCard4 c4BigSz = 8195;
+    THeapBuf mbufPlain(c4BigSz, c4BigSz);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BigSz; c4Index++)
+        mbufPlain.PutCard1(tCIDLib::TCard1(c4Index * 7), c4Index);
+
+    THeapBuf mbufCypher(c4BigSz + 16, c4BigSz + 16);
+    THeapBuf mbufBack(c4BigSz + 16, c4BigSz + 16);
+    c4Bytes = crypTest.c4Encrypt(mbufPlain, mbufCypher, c4BigSz, ac1IV);
+    c4Bytes = crypTest.c4Decrypt(mbufCypher, mbufBack, c4Bytes, ac1IV);
+    if ((c4Bytes != c4BigSz) || !mbufPlain.bCompare(mbufBack, c4BigSz))
+    {
+        strmOut << TFWCurLn << L"Large GCM round trip failed" << kCIDLib::DNewLn;
+        return tTestFWLib::ETestRes::Failed;
+    }
+    return eRes;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_AES5
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_AES5: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_AES5::TTest_AES5() :
+
+    TTest_BaseCrypto(L"AES 5", L"AES throughput per block mode", 4)
+{
+}
+
+TTest_AES5::~TTest_AES5()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_AES5: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_AES5::eRunTest(TTextStringOutStream&  strmOut
+                    , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  We run the same fixed buffer through each mode a number of times, once
+    //  with the hardware paths enabled and once with them disabled, so the
+    //  numbers can be compared. The buffer is a multiple of the block size so
+    //  the padded modes don't add anything, but leave room for the GCM tag.
+    //
+    const tCIDLib::TCard4 c4BufSz = 0x100000;
+    const tCIDLib::TCard4 c4Rounds = 16;
+
+    const tCIDLib::TCard1 ac1Key[16] =
+    {
+        0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6
+      , 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+    };
+
+    const tCIDLib::TCard1 ac1IV[16] =
+    {
+        0x51, 0x86, 0x6F, 0xD5, 0xB8, 0x5E, 0xCB, 0x8A
+      , 0x4E, 0xF9, 0x97, 0x45, 0x61, 0x98, 0xDD, 0x78
+    };
+
+    const tCIDCrypto::EBlockModes aeModes[] =
+    {
+        tCIDCrypto::EBlockModes::ECB
+        , tCIDCrypto::EBlockModes::CBC
+        , tCIDCrypto::EBlockModes::CTR
+        , tCIDCrypto::EBlockModes::GCM
+    };
+    const tCIDLib::TCh* const apszModes[] = { L"ECB", L"CBC", L"CTR", L"GCM" };
+    const tCIDLib::TCard4 c4ModeCnt = tCIDLib::c4ArrayElems(aeModes);
+
+    THeapBuf mbufPlain(c4BufSz, c4BufSz);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4BufSz; c4Index++)
+        mbufPlain.PutCard1(tCIDLib::TCard1((c4Index * 13) ^ (c4Index >> 8)), c4Index);
+
+    THeapBuf mbufCypher(c4BufSz + 16, c4BufSz + 16);
+    THeapBuf mbufBack(c4BufSz + 16, c4BufSz + 16);
+
+    //
+    //  Keep the hardware run's cypher text for each mode, so we can make sure
+    //  the software run produces the same thing.
+    //
+    THeapBuf mbufHWCypher((c4BufSz + 16) * c4ModeCnt, (c4BufSz + 16) * c4ModeCnt);
+
+    if (!TSysInfo::bCPUHasFeatures(tCIDLib::ECPUFeatures::AESNI))
+        strmOut << L"No AES-NI support, both passes use the software path\n";
+
+    const TCryptoKey ckeyTest(ac1Key, 16);
+    const tCIDLib::TBoolean bOrgHW = facCIDCrypto().bHWAccel();
+    try
+    {
+        for (tCIDLib::TCard4 c4Pass = 0; c4Pass < 2; c4Pass++)
+        {
+            const tCIDLib::TBoolean bHW = (c4Pass == 0);
+            facCIDCrypto().bHWAccel(bHW);
+
+            for (tCIDLib::TCard4 c4ModeInd = 0; c4ModeInd < c4ModeCnt; c4ModeInd++)
+            {
+                // The mode is locked in when keyed, so create it after setting the flag
+                TAESEncrypter crypTest(ckeyTest, aeModes[c4ModeInd]);
+
+                tCIDLib::TCard4 c4CypherBytes = 0;
+                tCIDLib::TCard8 c8Start = TTime::c8Millis();
+                for (tCIDLib::TCard4 c4Round = 0; c4Round < c4Rounds; c4Round++)
+                    c4CypherBytes = crypTest.c4Encrypt(mbufPlain, mbufCypher, c4BufSz, ac1IV);
+                const tCIDLib::TCard8 c8EncMS = TTime::c8Millis() - c8Start;
+
+                tCIDLib::TCard4 c4PlainBytes = 0;
+                c8Start = TTime::c8Millis();
+                for (tCIDLib::TCard4 c4Round = 0; c4Round < c4Rounds; c4Round++)
+                    c4PlainBytes = crypTest.c4Decrypt(mbufCypher, mbufBack, c4CypherBytes, ac1IV);
+                const tCIDLib::TCard8 c8DecMS = TTime::c8Millis() - c8Start;
+
+                if ((c4PlainBytes != c4BufSz) || !mbufPlain.bCompare(mbufBack, c4BufSz))
+                {
+                    strmOut << TFWCurLn << apszModes[c4ModeInd] << L" round trip failed"
+                            << (bHW ? L" (hardware)" : L" (software)") << kCIDLib::DNewLn;
+                    eRes = tTestFWLib::ETestRes::Failed;
+                    continue;
+                }
+
+                const tCIDLib::TCard4 c4HWOfs = c4ModeInd * (c4BufSz + 16);
+                if (bHW)
+                {
+                    mbufHWCypher.CopyIn(mbufCypher, c4CypherBytes, c4HWOfs);
+                }
+                 else if (!mbufCypher.bCompare(mbufHWCypher.pc1DataAt(c4HWOfs), c4CypherBytes))
+                {
+                    strmOut << TFWCurLn << apszModes[c4ModeInd]
+                            << L" hardware and software cypher text differ"
+                            << kCIDLib::DNewLn;
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+
+                // MB/s, clipping the times so a very fast run doesn't divide by zero
+                const tCIDLib::TFloat8 f8MB = tCIDLib::TFloat8(c4BufSz) * c4Rounds / 0x100000;
+                strmOut << (bHW ? L"Hardware " : L"Software ") << apszModes[c4ModeInd]
+                        << L" encrypt: "
+                        << TFloat(f8MB * 1000 / tCIDLib::MaxVal(c8EncMS, tCIDLib::TCard8(1)), 2)
+                        << L" MB/s, decrypt: "
+                        << TFloat(f8MB * 1000 / tCIDLib::MaxVal(c8DecMS, tCIDLib::TCard8(1)), 2)
+                        << L" MB/s\n";
+            }
+        }
+    }
+
+    catch(...)
+    {
+        facCIDCrypto().bHWAccel(bOrgHW);
+        throw;
+    }
+    facCIDCrypto().bHWAccel(bOrgHW);
+    return eRes;
+}
@@ -35,7 +35,9 @@
 //  Magic macros
 // ---------------------------------------------------------------------------
 RTTIDecls(TTest_SHA256_1, TTest_BaseCrypto)
+RTTIDecls(TTest_SHA256_2, TTest_BaseCrypto)
 RTTIDecls(TTest_HMACSHA256, TTest_BaseCrypto)
+RTTIDecls(TTest_HMACSHA256_2, TTest_BaseCrypto)
 
 
 // ---------------------------------------------------------------------------
@@ -157,6 +159,247 @@ TTest_SHA256_1::eRunTest(TTextStringOutStream&  strmOut
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SHA256_2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_SHA256_2: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_SHA256_2::TTest_SHA256_2() :
+
+    TTest_BaseCrypto
+    (
+        L"SHA256 2", L"Tests of multi-block, multi-message and tree SHA256 hashing", 4
+    )
+{
+}
+
+TTest_SHA256_2::~TTest_SHA256_2()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SHA256_2: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_SHA256_2::eRunTest(TTextStringOutStream&  strmOut
+                        , tCIDLib::TBoolean&    bWarning)
+{
+    //
+    //  Do the standard million 'a' test, which makes sure that the bulk block
+    //  processing is right, whichever version we end up using.
+    //
+    {
+        const tCIDLib::TCard1 ac1Output[32] =
+        {
+              0xCD, 0xC7, 0x6E, 0x5C, 0x99, 0x14, 0xFB, 0x92
+            , 0x81, 0xA1, 0xC7, 0xE2, 0x84, 0xD7, 0x3E, 0x67
+            , 0xF1, 0x80, 0x9A, 0x48, 0xA4, 0x97, 0x20, 0x0E
+            , 0x04, 0x6D, 0x39, 0xCC, 0xC7, 0x11, 0x2C, 0xD0
+        };
+
+        const tCIDLib::TCard4 c4Size = 1000000;
+        TArrayJanitor<tCIDLib::TCard1> janBuf(c4Size);
+        TRawMem::SetMemBuf(janBuf.paThis(), tCIDLib::TCard1(0x61), c4Size);
+
+        TSHA256Hasher mdigTest;
+        TSHA256Hash mhashTest;
+        mdigTest.StartNew();
+        mdigTest.DigestRaw(janBuf.paThis(), c4Size);
+        mdigTest.Complete(mhashTest);
+
+        if (mhashTest != TSHA256Hash(ac1Output, 32))
+        {
+            strmOut << TFWCurLn << L"SHA256 million 'a' test failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Create a buffer of pseudo-random data that we can use for the rest of
+    //  the tests.
+    //
+    const tCIDLib::TCard4 c4DataSz = (kCIDCrypto::c4SHA256TreeLeafSz * 9) + 1234;
+    TArrayJanitor<tCIDLib::TCard1> janData(c4DataSz);
+    tCIDLib::TCard1* const pc1Data = janData.paThis();
+    {
+        tCIDLib::TCard4 c4Seed = 0x12345678;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4DataSz; c4Index++)
+        {
+            c4Seed = (c4Seed * 1103515245) + 12345;
+            pc1Data[c4Index] = tCIDLib::TCard1(c4Seed >> 16);
+        }
+    }
+
+    //
+    //  Do a set of messages of various sizes, including empty ones and the sizes
+    //  around the padding boundaries, via the multi-message hasher. Check that
+    //  each one matches a regular hash.
+    //
+    {
+        const tCIDLib::TCard4 ac4Sizes[] =
+        {
+            0, 1, 55, 56, 63, 64, 65, 119, 120, 1000, 4096, 100000, 3, 0, 777, 128, 191
+        };
+        const tCIDLib::TCard4 c4MsgCnt = tCIDLib::c4ArrayElems(ac4Sizes);
+
+        const tCIDLib::TCard1* apc1Msgs[c4MsgCnt];
+        tCIDLib::TCard4 c4Ofs = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4MsgCnt; c4Index++)
+        {
+            apc1Msgs[c4Index] = pc1Data + c4Ofs;
+            c4Ofs += ac4Sizes[c4Index] + 7;
+        }
+
+        TSHA256Hash amhashMulti[c4MsgCnt];
+        TSHA256Hasher::DigestMulti(apc1Msgs, ac4Sizes, amhashMulti, c4MsgCnt);
+
+        TSHA256Hasher mdigTest;
+        TSHA256Hash mhashTest;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4MsgCnt; c4Index++)
+        {
+            mdigTest.StartNew();
+            mdigTest.DigestRaw(apc1Msgs[c4Index], ac4Sizes[c4Index]);
+            mdigTest.Complete(mhashTest);
+
+            if (mhashTest != amhashMulti[c4Index])
+            {
+                strmOut << TFWCurLn << L"Multi-message hash #" << c4Index
+                        << L" (size " << ac4Sizes[c4Index] << L") did not match"
+                        << kCIDLib::DNewLn;
+                return tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    //
+    //  For something that fits in one leaf, the tree hash should be the root
+    //  hash of the prefixed leaf hash of the data plus the length. And it has
+    //  to match the known answer.
+    //
+    {
+        const tCIDLib::TCard1 ac1Output[32] =
+        {
+              0x53, 0xF7, 0xCA, 0x17, 0x07, 0x3F, 0xF3, 0x71
+            , 0xAD, 0x29, 0xB7, 0x7F, 0x52, 0xDD, 0x34, 0x6F
+            , 0x78, 0x3D, 0xF8, 0x81, 0x0D, 0xF5, 0xFC, 0xA5
+            , 0xC9, 0xB9, 0x61, 0x8C, 0x77, 0x79, 0x5B, 0x99
+        };
+        const tCIDLib::TCard4 c4Size = 5000;
+
+        const tCIDLib::TCard1 c1LeafPref = 0x00;
+        TSHA256Hasher mdigTest;
+        TSHA256Hash mhashLeaf;
+        mdigTest.StartNew();
+        mdigTest.DigestRaw(&c1LeafPref, 1);
+        mdigTest.DigestRaw(pc1Data, c4Size);
+        mdigTest.Complete(mhashLeaf);
+
+        const tCIDLib::TCard1 c1Pref = 0x02;
+        const tCIDLib::TCard1 ac1Len[8] = { 0, 0, 0, 0, 0, 0, 0x13, 0x88 };
+        TSHA256Hash mhashExpected;
+        mdigTest.StartNew();
+        mdigTest.DigestRaw(&c1Pref, 1);
+        mdigTest.DigestRaw(mhashLeaf.pc1Buffer(), mhashLeaf.c4Bytes());
+        mdigTest.DigestRaw(ac1Len, 8);
+        mdigTest.Complete(mhashExpected);
+
+        TSHA256Hash mhashTree;
+        TSHA256Hasher::TreeHash(pc1Data, c4Size, mhashTree);
+        if ((mhashTree != mhashExpected) || (mhashTree != TSHA256Hash(ac1Output, 32)))
+        {
+            strmOut << TFWCurLn << L"Single leaf tree hash was wrong" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // An empty buffer is a single empty leaf
+    {
+        const tCIDLib::TCard1 ac1Output[32] =
+        {
+              0xE5, 0xE3, 0xF6, 0x85, 0xEC, 0x1E, 0xC0, 0x4D
+            , 0xBB, 0xEF, 0x9C, 0xFB, 0x42, 0x93, 0x59, 0xB6
+            , 0xB9, 0xB6, 0x64, 0x85, 0xEF, 0x03, 0x55, 0x57
+            , 0x4F, 0x96, 0xBD, 0xC8, 0xFB, 0x7C, 0xD3, 0x6C
+        };
+
+        TSHA256Hash mhashTree;
+        TSHA256Hasher::TreeHash(pc1Data, 0, mhashTree);
+        if (mhashTree != TSHA256Hash(ac1Output, 32))
+        {
+            strmOut << TFWCurLn << L"Empty tree hash was wrong" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And do a multi-leaf one with one thread and with a few threads. They
+    //  have to come out the same and match the known answers. And it can't be
+    //  the same as the regular hash or the single leaf scheme.
+    //
+    {
+        const tCIDLib::TCard1 ac1Output[32] =
+        {
+              0x45, 0xBC, 0x9F, 0x0A, 0xC0, 0x43, 0xE1, 0xC7
+            , 0x05, 0x7E, 0x39, 0x66, 0x98, 0x84, 0x9C, 0xA3
+            , 0x41, 0x33, 0x4C, 0x12, 0xA2, 0x0F, 0x1D, 0x0C
+            , 0x13, 0x1B, 0xA4, 0xEE, 0xF8, 0x14, 0x80, 0xA0
+        };
+
+        const tCIDLib::TCard1 ac1OutputLess[32] =
+        {
+              0x57, 0x8B, 0xA5, 0x2C, 0xC8, 0xA5, 0x00, 0xCC
+            , 0x62, 0x5A, 0xE6, 0x65, 0x84, 0xDB, 0x8E, 0x5B
+            , 0xAD, 0xA3, 0xC6, 0x29, 0x5A, 0x46, 0x38, 0x97
+            , 0x5F, 0xB2, 0x22, 0xEA, 0x5C, 0x28, 0xC4, 0x61
+        };
+
+        TSHA256Hash mhashOne;
+        TSHA256Hash mhashPar;
+        TSHA256Hasher::TreeHash(pc1Data, c4DataSz, mhashOne, 1);
+        TSHA256Hasher::TreeHash(pc1Data, c4DataSz, mhashPar, 3);
+        if (mhashOne != mhashPar)
+        {
+            strmOut << TFWCurLn << L"Threaded tree hash did not match single thread"
+                    << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        if (mhashOne != TSHA256Hash(ac1Output, 32))
+        {
+            strmOut << TFWCurLn << L"Multi-leaf tree hash was wrong" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        TSHA256Hasher mdigTest;
+        TSHA256Hash mhashTest;
+        mdigTest.StartNew();
+        mdigTest.DigestRaw(pc1Data, c4DataSz);
+        mdigTest.Complete(mhashTest);
+        if (mhashTest == mhashOne)
+        {
+            strmOut << TFWCurLn << L"Tree hash should not match regular hash"
+                    << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        // One byte less has to give a different hash
+        TSHA256Hasher::TreeHash(pc1Data, c4DataSz - 1, mhashTest, 3);
+        if ((mhashTest == mhashOne) || (mhashTest != TSHA256Hash(ac1OutputLess, 32)))
+        {
+            strmOut << TFWCurLn << L"Tree hash did not see the length change"
+                    << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return tTestFWLib::ETestRes::Success;
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TTest_HMACSHA256
 // PREFIX: tfwt
@@ -277,3 +520,221 @@ TTest_HMACSHA256::eRunTest( TTextStringOutStream&   strmOut
     return tTestFWLib::ETestRes::Success;
 }
 
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_HMACSHA256_2
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_HMACSHA256_2: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_HMACSHA256_2::TTest_HMACSHA256_2() :
+
+    TTest_BaseCrypto
+    (
+        L"HMAC-SHA256 2", L"Tests of the HMAC class and the HKDF/PBKDF2 key derivation", 4
+    )
+{
+}
+
+TTest_HMACSHA256_2::~TTest_HMACSHA256_2()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_HMACSHA256_2: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_HMACSHA256_2::eRunTest(TTextStringOutStream&  strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    //
+    //  Make sure that the HMAC class agrees with the facility's HMAC method for
+    //  keys shorter, equal to and longer than the block size. Do it with the
+    //  same object for all of the messages for each key, and do the messages in
+    //  two parts, to make sure the state is reset and streaming works.
+    //
+    {
+        const tCIDLib::TCard4 ac4KeySizes[] = { 0, 20, 64, 65, 131 };
+        const tCIDLib::TCard4 ac4MsgSizes[] = { 0, 1, 63, 64, 200 };
+
+        tCIDLib::TCard1 ac1Data[256];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 256; c4Index++)
+            ac1Data[c4Index] = tCIDLib::TCard1((c4Index * 7) + 3);
+
+        TSHA256Hasher mdigTest;
+        TSHA256Hash mhashExpected;
+        TSHA256Hash mhashTest;
+        THeapBuf mbufKey(256, 256);
+        THeapBuf mbufMsg(256, 256);
+        for (tCIDLib::TCard4 c4KeyInd = 0; c4KeyInd < tCIDLib::c4ArrayElems(ac4KeySizes); c4KeyInd++)
+        {
+            const tCIDLib::TCard4 c4KeySz = ac4KeySizes[c4KeyInd];
+            mbufKey.CopyIn(ac1Data, c4KeySz);
+
+            tCIDCrypto::THMACSHA256 hmacTest(ac1Data, c4KeySz);
+            for (tCIDLib::TCard4 c4MsgInd = 0; c4MsgInd < tCIDLib::c4ArrayElems(ac4MsgSizes); c4MsgInd++)
+            {
+                const tCIDLib::TCard4 c4MsgSz = ac4MsgSizes[c4MsgInd];
+                const tCIDLib::TCard1* pc1Msg = ac1Data + 17;
+                mbufMsg.CopyIn(pc1Msg, c4MsgSz);
+
+                facCIDCrypto().GenerateHMAC
+                (
+                    mbufKey, c4KeySz, mbufMsg, c4MsgSz, mdigTest, mhashExpected
+                );
+
+                const tCIDLib::TCard4 c4Half = c4MsgSz / 2;
+                hmacTest.DigestRaw(pc1Msg, c4Half);
+                hmacTest.DigestRaw(pc1Msg + c4Half, c4MsgSz - c4Half);
+                hmacTest.Complete(mhashTest);
+
+                if (mhashTest != mhashExpected)
+                {
+                    strmOut << TFWCurLn << L"HMAC class failed for key size "
+                            << c4KeySz << L", message size " << c4MsgSz
+                            << kCIDLib::DNewLn;
+                    return tTestFWLib::ETestRes::Failed;
+                }
+            }
+        }
+    }
+
+    // RFC 5869 test cases 1 and 3
+    {
+        tCIDLib::TCard1 ac1IKM[22];
+        tCIDLib::TCard1 ac1Salt[13];
+        tCIDLib::TCard1 ac1Info[10];
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 22; c4Index++)
+            ac1IKM[c4Index] = 0x0B;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 13; c4Index++)
+            ac1Salt[c4Index] = tCIDLib::TCard1(c4Index);
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 10; c4Index++)
+            ac1Info[c4Index] = tCIDLib::TCard1(0xF0 + c4Index);
+
+        const tCIDLib::TCard1 ac1PRK1[32] =
+        {
+              0x07, 0x77, 0x09, 0x36, 0x2C, 0x2E, 0x32, 0xDF
+            , 0x0D, 0xDC, 0x3F, 0x0D, 0xC4, 0x7B, 0xBA, 0x63
+            , 0x90, 0xB6, 0xC7, 0x3B, 0xB5, 0x0F, 0x9C, 0x31
+            , 0x22, 0xEC, 0x84, 0x4A, 0xD7, 0xC2, 0xB3, 0xE5
+        };
+        const tCIDLib::TCard1 ac1OKM1[42] =
+        {
+              0x3C, 0xB2, 0x5F, 0x25, 0xFA, 0xAC, 0xD5, 0x7A
+            , 0x90, 0x43, 0x4F, 0x64, 0xD0, 0x36, 0x2F, 0x2A
+            , 0x2D, 0x2D, 0x0A, 0x90, 0xCF, 0x1A, 0x5A, 0x4C
+            , 0x5D, 0xB0, 0x2D, 0x56, 0xEC, 0xC4, 0xC5, 0xBF
+            , 0x34, 0x00, 0x72, 0x08, 0xD5, 0xB8, 0x87, 0x18
+            , 0x58, 0x65
+        };
+        const tCIDLib::TCard1 ac1OKM3[42] =
+        {
+              0x8D, 0xA4, 0xE7, 0x75, 0xA5, 0x63, 0xC1, 0x8F
+            , 0x71, 0x5F, 0x80, 0x2A, 0x06, 0x3C, 0x5A, 0x31
+            , 0xB8, 0xA1, 0x1F, 0x5C, 0x5E, 0xE1, 0x87, 0x9E
+            , 0xC3, 0x45, 0x4E, 0x5F, 0x3C, 0x73, 0x8D, 0x2D
+            , 0x9D, 0x20, 0x13, 0x95, 0xFA, 0xA4, 0xB6, 0x1A
+            , 0x96, 0xC8
+        };
+
+        TSHA256Hash mhashPRK;
+        tCIDCrypto::THMACSHA256::HKDFExtract(ac1Salt, 13, ac1IKM, 22, mhashPRK);
+        if (mhashPRK != TSHA256Hash(ac1PRK1, 32))
+        {
+            strmOut << TFWCurLn << L"HKDF extract test 1 failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        tCIDLib::TCard1 ac1Out[42];
+        tCIDCrypto::THMACSHA256::HKDF(ac1Salt, 13, ac1IKM, 22, ac1Info, 10, ac1Out, 42);
+        if (!TRawMem::bCompareMemBuf(ac1Out, ac1OKM1, 42))
+        {
+            strmOut << TFWCurLn << L"HKDF test 1 failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        tCIDCrypto::THMACSHA256::HKDF(nullptr, 0, ac1IKM, 22, nullptr, 0, ac1Out, 42);
+        if (!TRawMem::bCompareMemBuf(ac1Out, ac1OKM3, 42))
+        {
+            strmOut << TFWCurLn << L"HKDF test 3 failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        // Asking for too much output should be rejected
+        tCIDLib::TBoolean bGotIt = kCIDLib::False;
+        try
+        {
+            tCIDLib::TCard1 ac1Big[32 * 256];
+            tCIDCrypto::THMACSHA256::HKDFExpand
+            (
+                mhashPRK.pc1Buffer(), 32, nullptr, 0, ac1Big, 32 * 256
+            );
+        }
+
+        catch(const TError& errToCatch)
+        {
+            bGotIt = errToCatch.bCheckEvent
+            (
+                facCIDCrypto().strName(), kCryptoErrs::errcKDF_OutputTooLong
+            );
+        }
+
+        if (!bGotIt)
+        {
+            strmOut << TFWCurLn << L"HKDF did not reject an overly long output"
+                    << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // And some PBKDF2-HMAC-SHA256 vectors
+    {
+        const tCIDLib::TCard1 ac1DK1[32] =
+        {
+              0x12, 0x0F, 0xB6, 0xCF, 0xFC, 0xF8, 0xB3, 0x2C
+            , 0x43, 0xE7, 0x22, 0x52, 0x56, 0xC4, 0xF8, 0x37
+            , 0xA8, 0x65, 0x48, 0xC9, 0x2C, 0xCC, 0x35, 0x48
+            , 0x08, 0x05, 0x98, 0x7C, 0xB7, 0x0B, 0xE1, 0x7B
+        };
+        const tCIDLib::TCard1 ac1DK2[40] =
+        {
+              0x34, 0x8C, 0x89, 0xDB, 0xCB, 0xD3, 0x2B, 0x2F
+            , 0x32, 0xD8, 0x14, 0xB8, 0x11, 0x6E, 0x84, 0xCF
+            , 0x2B, 0x17, 0x34, 0x7E, 0xBC, 0x18, 0x00, 0x18
+            , 0x1C, 0x4E, 0x2A, 0x1F, 0xB8, 0xDD, 0x53, 0xE1
+            , 0xC6, 0x35, 0x51, 0x8C, 0x7D, 0xAC, 0x47, 0xE9
+        };
+
+        const tCIDLib::TCard1* const pc1PW1 = reinterpret_cast<const tCIDLib::TCard1*>("password");
+        const tCIDLib::TCard1* const pc1Salt1 = reinterpret_cast<const tCIDLib::TCard1*>("salt");
+        const tCIDLib::TCard1* const pc1PW2 = reinterpret_cast<const tCIDLib::TCard1*>
+        (
+            "passwordPASSWORDpassword"
+        );
+        const tCIDLib::TCard1* const pc1Salt2 = reinterpret_cast<const tCIDLib::TCard1*>
+        (
+            "saltSALTsaltSALTsaltSALTsaltSALTsalt"
+        );
+
+        tCIDLib::TCard1 ac1Out[40];
+        tCIDCrypto::THMACSHA256::PBKDF2(pc1PW1, 8, pc1Salt1, 4, 1, ac1Out, 32);
+        if (!TRawMem::bCompareMemBuf(ac1Out, ac1DK1, 32))
+        {
+            strmOut << TFWCurLn << L"PBKDF2 test 1 failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+
+        tCIDCrypto::THMACSHA256::PBKDF2(pc1PW2, 24, pc1Salt2, 36, 4096, ac1Out, 40);
+        if (!TRawMem::bCompareMemBuf(ac1Out, ac1DK2, 40))
+        {
+            strmOut << TFWCurLn << L"PBKDF2 test 2 failed" << kCIDLib::DNewLn;
+            return tTestFWLib::ETestRes::Failed;
+        }
+    }
+    return tTestFWLib::ETestRes::Success;
+}
@@ -68,6 +68,10 @@ tCIDLib::TVoid TMacroEngTestApp::LoadTests()
     AddTest(new TTest_PathValidation);
     AddTest(new TTest_NumConstProbe);
     AddTest(new TTest_CMLRuntime);
+    AddTest(new TTest_CompiledCache);
+    AddTest(new TTest_Optimizer);
+    AddTest(new TTest_Profiler);
+    AddTest(new TTest_SharedClasses);
 }
 
 tCIDLib::TVoid TMacroEngTestApp::PostTest(const TTestFWTest&)
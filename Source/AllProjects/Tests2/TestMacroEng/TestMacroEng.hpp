@@ -163,6 +163,265 @@ class TTest_CMLRuntime : public TTestFWTest
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_CompiledCache
+// PREFIX: tfwt
+//
+//  Parses some macros cold, which stores the compiled form to a cache dir,
+//  then again from the cache, and makes sure they run the same both ways.
+// ---------------------------------------------------------------------------
+class TTest_CompiledCache : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_CompiledCache();
+
+        ~TTest_CompiledCache();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bParseAndRun
+        (
+                    TTextStringOutStream&   strmOut
+            , const TString&                strClassPath
+            ,       tCIDLib::TCard4&        c4ClassCount
+            ,       tCIDLib::TCard8&        c8ParseUS
+            ,       TString&                strOutput
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        // -------------------------------------------------------------------
+        TMEngFixedBaseClassMgr      m_mecmTest;
+        TMEngFixedBaseFileResolver  m_mefrTest;
+        TMEngStrmErrHandler         m_meehEngine;
+        TMEngStrmPrsErrHandler      m_meehParser;
+        TMacroEngParser             m_meprsTest;
+        TTextStringOutStream        m_strmConsole;
+
+        // This guy has to be last so it destructs last
+        TCIDMacroEngine             m_meTest;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_CompiledCache,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Optimizer
+// PREFIX: tfwt
+//
+//  Parses some macros with and without the opcode optimizer and makes sure
+//  they run the same both ways, reporting opcode counts and run times.
+// ---------------------------------------------------------------------------
+class TTest_Optimizer : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Optimizer();
+
+        ~TTest_Optimizer();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bParseAndRun
+        (
+                    TTextStringOutStream&   strmOut
+            ,       TMacroEngParser&        meprsToUse
+            , const TString&                strClassPath
+            ,       tCIDLib::TCard4&        c4OpCount
+            ,       tCIDLib::TCard8&        c8RunUS
+            ,       TString&                strOutput
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        // -------------------------------------------------------------------
+        TMEngFixedBaseClassMgr      m_mecmTest;
+        TMEngFixedBaseFileResolver  m_mefrTest;
+        TMEngStrmErrHandler         m_meehEngine;
+        TMEngStrmPrsErrHandler      m_meehParser;
+        TMacroEngParser             m_meprsMax;
+        TMacroEngParser             m_meprsMin;
+        TTextStringOutStream        m_strmConsole;
+
+        // This guy has to be last so it destructs last
+        TCIDMacroEngine             m_meTest;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Optimizer,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Profiler
+// PREFIX: tfwt
+//
+//  Runs a macro with profiling enabled and checks that the expected calls
+//  were seen, and then with it disabled and makes sure nothing is collected.
+// ---------------------------------------------------------------------------
+class TTest_Profiler : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_Profiler();
+
+        ~TTest_Profiler();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bParseAndRun
+        (
+                    TTextStringOutStream&   strmOut
+            , const TString&                strClassPath
+            , const tCIDLib::TBoolean       bProfile
+            ,       TMEngClassInfo*&        pmeciMain
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        // -------------------------------------------------------------------
+        TMEngFixedBaseClassMgr      m_mecmTest;
+        TMEngFixedBaseFileResolver  m_mefrTest;
+        TMEngStrmErrHandler         m_meehEngine;
+        TMEngStrmPrsErrHandler      m_meehParser;
+        TMacroEngParser             m_meprsTest;
+        TTextStringOutStream        m_strmConsole;
+
+        // This guy has to be last so it destructs last
+        TCIDMacroEngine             m_meTest;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_Profiler,TTestFWTest)
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SharedClasses
+// PREFIX: tfwt
+//
+//  Parses some macros in one engine, shares the classes, and runs them in a
+//  second engine that uses the shared set, making sure the output matches.
+// ---------------------------------------------------------------------------
+class TTest_SharedClasses : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_SharedClasses();
+
+        ~TTest_SharedClasses();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bRun
+        (
+                    TTextStringOutStream&   strmOut
+            ,       TCIDMacroEngine&        meToUse
+            ,       TMEngClassInfo&         meciMain
+            ,       TTextStringOutStream&   strmConsole
+            ,       TString&                strOutput
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        // -------------------------------------------------------------------
+        TMEngFixedBaseClassMgr      m_mecmTest;
+        TMEngFixedBaseFileResolver  m_mefrTest;
+        TMEngStrmErrHandler         m_meehEngine;
+        TMEngStrmPrsErrHandler      m_meehParser;
+        TMacroEngParser             m_meprsTest;
+        TTextStringOutStream        m_strmConsole;
+        TTextStringOutStream        m_strmConsole2;
+
+        // These guys have to be last so they destruct last
+        TCIDMacroEngine             m_meTest;
+        TCIDMacroEngine             m_meTest2;
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_SharedClasses,TTestFWTest)
+};
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TMacroEngTestApp
 // PREFIX: tfwapp
@@ -38,6 +38,10 @@
 RTTIDecls(TTest_PathValidation,TTestFWTest)
 RTTIDecls(TTest_NumConstProbe,TTestFWTest)
 RTTIDecls(TTest_CMLRuntime,TTestFWTest)
+RTTIDecls(TTest_CompiledCache,TTestFWTest)
+RTTIDecls(TTest_Optimizer,TTestFWTest)
+RTTIDecls(TTest_Profiler,TTestFWTest)
+RTTIDecls(TTest_SharedClasses,TTestFWTest)
 
 
 
@@ -382,7 +386,9 @@ TTest_CMLRuntime::eRunTest( TTextStringOutStream&   strmOut
       , { L"MEng.User.Tests.TestXML1", L"" }
       , { L"MEng.User.Tests.TestEPParms1", L"1" }
       , { L"MEng.User.Tests.TestEPParms2", L"1 2.3 -4 C 'Eat Me' ValP2" }
+#if defined(WIN32)
       , { L"MEng.User.Tests.TestJSONParser", L"" }
+#endif
       , { L"MEng.User.Tests.TestZLib", L"" }
     };
     const tCIDLib::TCard4 c4TestCnt = tCIDLib::c4ArrayElems(aTests);
@@ -508,3 +514,746 @@ TTest_CMLRuntime::eRunTestMacro(        TTextStringOutStream&   strmOut
     return eRes;
 }
 
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_CompiledCache
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_CompiledCache: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_CompiledCache::TTest_CompiledCache() :
+
+    TTestFWTest(L"Compiled Cache", L"Tests loading macros from the compiled class cache", 6)
+    , m_strmConsole(0x1000UL)
+{
+}
+
+TTest_CompiledCache::~TTest_CompiledCache()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_CompiledCache: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_CompiledCache::eRunTest(  TTextStringOutStream&   strmOut
+                                , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TPathStr pathLoad;
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Classes");
+    m_mecmTest.strBasePath(pathLoad);
+
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Files");
+    m_mefrTest.strBasePath(pathLoad);
+
+    //
+    //  Set up a cache directory, getting rid of anything left over from a
+    //  previous run, so that the first parse of each macro is really cold.
+    //
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"CacheTest");
+    if (TFileSys::bIsDirectory(pathLoad))
+        TFileSys::RemovePath(pathLoad);
+    TFileSys::MakePath(pathLoad);
+    m_mecmTest.strCachePath(pathLoad);
+
+    m_meehEngine.SetStream(&strmOut);
+    m_meehParser.SetStream(&strmOut);
+    m_meTest.SetErrHandler(&m_meehEngine);
+    m_meTest.SetFileResolver(&m_mefrTest);
+    m_meTest.SetConsole(&m_strmConsole);
+    m_meTest.bValidation(kCIDLib::True);
+
+    //
+    //  A set that covers nested enums, vectors and arrays, derived classes,
+    //  jump tables and literals, which are the trickier bits to restore.
+    //
+    const tCIDLib::TCh* apszTests[] =
+    {
+        L"MEng.User.Tests.TestDerivedClass"
+        , L"MEng.User.Tests.TestEnum1"
+        , L"MEng.User.Tests.TestVector1"
+        , L"MEng.User.Tests.TestArray1"
+        , L"MEng.User.Tests.TestFlow1"
+        , L"MEng.User.Tests.TestLiterals"
+    };
+    const tCIDLib::TCard4 c4TestCnt = tCIDLib::c4ArrayElems(apszTests);
+
+    THeapBuf        mbufCache(1024);
+    tCIDLib::TCard4 c4Bytes;
+    tCIDLib::TCard4 c4ColdCount, c4WarmCount;
+    tCIDLib::TCard8 c8ColdUS, c8WarmUS;
+    TString         strColdOut, strWarmOut;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCnt; c4Index++)
+    {
+        const TString strPath(apszTests[c4Index]);
+
+        // The first one parses the source and should store the compiled form
+        if (!bParseAndRun(strmOut, strPath, c4ColdCount, c8ColdUS, strColdOut))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        if (!m_mecmTest.bLoadCompiled(strPath, mbufCache, c4Bytes))
+        {
+            strmOut << TFWCurLn << L"No compiled form was stored for "
+                    << strPath << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        // And the second one should come from the cache
+        if (!bParseAndRun(strmOut, strPath, c4WarmCount, c8WarmUS, strWarmOut))
+        {
+            strmOut << TFWCurLn << L"Cached load of " << strPath
+                    << L" failed" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        if (c4WarmCount != c4ColdCount)
+        {
+            strmOut << TFWCurLn << L"Cached load of " << strPath << L" has "
+                    << c4WarmCount << L" classes, expected " << c4ColdCount
+                    << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (strWarmOut != strColdOut)
+        {
+            strmOut << TFWCurLn << L"Cached load of " << strPath
+                    << L" produced different output" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        strmOut << strPath << L"  Cold=" << c8ColdUS << L"us  Warm="
+                << c8WarmUS << L"us\n";
+    }
+    strmOut << kCIDLib::EndLn;
+
+    // Clean up the cache directory
+    TFileSys::RemovePath(pathLoad);
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_CompiledCache: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Parses the indicated macro, timing the parse, then runs it and gives back the
+//  class count and console output so the caller can compare cold and warm runs.
+//
+tCIDLib::TBoolean
+TTest_CompiledCache::bParseAndRun(          TTextStringOutStream&   strmOut
+                                    , const TString&                strClassPath
+                                    ,       tCIDLib::TCard4&        c4ClassCount
+                                    ,       tCIDLib::TCard8&        c8ParseUS
+                                    ,       TString&                strOutput)
+{
+    TMEngClassInfo* pmeciMain;
+    const tCIDLib::TCard8 c8Start = TTime::c8HPTimerUS();
+    if (!m_meprsTest.bParse(strClassPath
+                            , pmeciMain
+                            , &m_meTest
+                            , &m_meehParser
+                            , &m_mecmTest))
+    {
+        strmOut << TFWCurLn << L"Macro '" << strClassPath << L"' failed to parse"
+                << kCIDLib::DNewLn;
+        return kCIDLib::False;
+    }
+    c8ParseUS = TTime::c8HPTimerUS() - c8Start;
+    c4ClassCount = m_meTest.c4ClassCount();
+
+    TMEngClassVal* pmecvTarget = pmeciMain->pmecvMakeStorage
+    (
+        L"$Main$", m_meTest, tCIDMacroEng::EConstTypes::NonConst
+    );
+    TJanitor<TMEngClassVal> janTarget(pmecvTarget);
+
+    try
+    {
+        if (!m_meTest.bInvokeDefCtor(*pmecvTarget, 0))
+            return kCIDLib::False;
+
+        TCIDMacroEngine::TParmList colParms(tCIDLib::EAdoptOpts::Adopt);
+        if (m_meTest.i4Run(*pmecvTarget, colParms, 0) != 0)
+        {
+            strmOut << TFWCurLn << L"Macro '" << strClassPath
+                    << L"' returned non-zero" << kCIDLib::DNewLn;
+            return kCIDLib::False;
+        }
+    }
+
+    catch(const TExceptException&)
+    {
+        // Already reported to the output by the error handler
+        return kCIDLib::False;
+    }
+
+    m_strmConsole.Flush();
+    strOutput = m_strmConsole.strData();
+    return kCIDLib::True;
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Optimizer
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Optimizer: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Optimizer::TTest_Optimizer() :
+
+    TTestFWTest(L"Optimizer", L"Tests that optimized macros run the same", 6)
+    , m_meprsMax(tCIDMacroEng::EOptLevels::Maximum)
+    , m_meprsMin(tCIDMacroEng::EOptLevels::Minimal)
+    , m_strmConsole(0x1000UL)
+{
+}
+
+TTest_Optimizer::~TTest_Optimizer()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Optimizer: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Optimizer::eRunTest(  TTextStringOutStream&   strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TPathStr pathLoad;
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Classes");
+    m_mecmTest.strBasePath(pathLoad);
+
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Files");
+    m_mefrTest.strBasePath(pathLoad);
+
+    m_meehEngine.SetStream(&strmOut);
+    m_meehParser.SetStream(&strmOut);
+    m_meTest.SetErrHandler(&m_meehEngine);
+    m_meTest.SetFileResolver(&m_mefrTest);
+    m_meTest.SetConsole(&m_strmConsole);
+
+    //
+    //  A set that covers loops, switches, exceptions, and calls through the
+    //  class hierarchy, which are what the optimizer rewrites.
+    //
+    const tCIDLib::TCh* apszTests[] =
+    {
+        L"MEng.User.Tests.TestFlow1"
+        , L"MEng.User.Tests.TestCond1"
+        , L"MEng.User.Tests.TestException1"
+        , L"MEng.User.Tests.TestDerivedClass"
+        , L"MEng.User.Tests.TestInheritance"
+        , L"MEng.User.Tests.TestOperators1"
+        , L"MEng.User.Tests.TestString1"
+    };
+    const tCIDLib::TCard4 c4TestCnt = tCIDLib::c4ArrayElems(apszTests);
+
+    tCIDLib::TCard4 c4MinOps, c4MaxOps;
+    tCIDLib::TCard8 c8MinUS, c8MaxUS;
+    TString         strMinOut, strMaxOut;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCnt; c4Index++)
+    {
+        const TString strPath(apszTests[c4Index]);
+
+        if (!bParseAndRun(strmOut, m_meprsMin, strPath, c4MinOps, c8MinUS, strMinOut)
+        ||  !bParseAndRun(strmOut, m_meprsMax, strPath, c4MaxOps, c8MaxUS, strMaxOut))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        if (c4MaxOps > c4MinOps)
+        {
+            strmOut << TFWCurLn << L"Optimized " << strPath << L" has "
+                    << c4MaxOps << L" opcodes, but unoptimized has "
+                    << c4MinOps << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        if (strMaxOut != strMinOut)
+        {
+            strmOut << TFWCurLn << L"Optimized " << strPath
+                    << L" produced different output" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        strmOut << strPath << L"  Ops=" << c4MinOps << L"/" << c4MaxOps
+                << L"  Run=" << c8MinUS << L"us/" << c8MaxUS << L"us\n";
+    }
+    strmOut << kCIDLib::EndLn;
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Optimizer: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Parses the indicated macro with the passed parser, then runs it, giving
+//  back the total opcodes in the classes it compiled, the run time, and the
+//  console output.
+//
+tCIDLib::TBoolean
+TTest_Optimizer::bParseAndRun(          TTextStringOutStream&   strmOut
+                                ,       TMacroEngParser&        meprsToUse
+                                , const TString&                strClassPath
+                                ,       tCIDLib::TCard4&        c4OpCount
+                                ,       tCIDLib::TCard8&        c8RunUS
+                                ,       TString&                strOutput)
+{
+    TMEngClassInfo* pmeciMain;
+    if (!meprsToUse.bParse(strClassPath, pmeciMain, &m_meTest, &m_meehParser, &m_mecmTest))
+    {
+        strmOut << TFWCurLn << L"Macro '" << strClassPath << L"' failed to parse"
+                << kCIDLib::DNewLn;
+        return kCIDLib::False;
+    }
+
+    // Count up the opcodes of all of the compiled classes
+    c4OpCount = 0;
+    const tCIDLib::TCard4 c4ClassCount = m_meTest.c4ClassCount();
+    for (tCIDLib::TCard4 c4ClassId = 0; c4ClassId < c4ClassCount; c4ClassId++)
+    {
+        const TMEngClassInfo& meciCur = m_meTest.meciFind(tCIDLib::TCard2(c4ClassId));
+        if (meciCur.clsIsA() != TMEngStdClassInfo::clsThis())
+            continue;
+
+        const tCIDLib::TCard4 c4MethCount = meciCur.c4MethodCount();
+        for (tCIDLib::TCard4 c4MethId = 0; c4MethId < c4MethCount; c4MethId++)
+        {
+            const TMEngMethodImpl* pmethCur = meciCur.pmethFind(tCIDLib::TCard2(c4MethId));
+            if (pmethCur && (pmethCur->clsIsA() == TMEngOpMethodImpl::clsThis()))
+                c4OpCount += static_cast<const TMEngOpMethodImpl*>(pmethCur)->c4CurOffset();
+        }
+    }
+
+    TMEngClassVal* pmecvTarget = pmeciMain->pmecvMakeStorage
+    (
+        L"$Main$", m_meTest, tCIDMacroEng::EConstTypes::NonConst
+    );
+    TJanitor<TMEngClassVal> janTarget(pmecvTarget);
+
+    try
+    {
+        const tCIDLib::TCard8 c8Start = TTime::c8HPTimerUS();
+        if (!m_meTest.bInvokeDefCtor(*pmecvTarget, 0))
+            return kCIDLib::False;
+
+        TCIDMacroEngine::TParmList colParms(tCIDLib::EAdoptOpts::Adopt);
+        if (m_meTest.i4Run(*pmecvTarget, colParms, 0) != 0)
+        {
+            strmOut << TFWCurLn << L"Macro '" << strClassPath
+                    << L"' returned non-zero" << kCIDLib::DNewLn;
+            return kCIDLib::False;
+        }
+        c8RunUS = TTime::c8HPTimerUS() - c8Start;
+    }
+
+    catch(const TExceptException&)
+    {
+        // Already reported to the output by the error handler
+        return kCIDLib::False;
+    }
+
+    m_strmConsole.Flush();
+    strOutput = m_strmConsole.strData();
+    return kCIDLib::True;
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_Profiler
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_Profiler: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_Profiler::TTest_Profiler() :
+
+    TTestFWTest(L"Profiler", L"Tests the macro engine's profiler", 6)
+    , m_strmConsole(0x1000UL)
+{
+}
+
+TTest_Profiler::~TTest_Profiler()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Profiler: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_Profiler::eRunTest(   TTextStringOutStream&   strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TPathStr pathLoad;
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Classes");
+    m_mecmTest.strBasePath(pathLoad);
+
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Files");
+    m_mefrTest.strBasePath(pathLoad);
+
+    m_meehEngine.SetStream(&strmOut);
+    m_meehParser.SetStream(&strmOut);
+    m_meTest.SetErrHandler(&m_meehEngine);
+    m_meTest.SetFileResolver(&m_mefrTest);
+    m_meTest.SetConsole(&m_strmConsole);
+
+    //
+    //  This one has a Start method that calls a couple of helper methods in
+    //  loops, so we should see all three and the call tree.
+    //
+    const TString strPath(L"MEng.User.Tests.TestFlow1");
+    TMEngClassInfo* pmeciMain;
+    if (!bParseAndRun(strmOut, strPath, kCIDLib::True, pmeciMain))
+        return tTestFWLib::ETestRes::Failed;
+
+    const TMEngProfiler& meprfTest = m_meTest.meprfData();
+    if (!meprfTest.bHasData())
+    {
+        strmOut << TFWCurLn << L"No profiling data was collected" << kCIDLib::DNewLn;
+        return tTestFWLib::ETestRes::Failed;
+    }
+
+    const tCIDLib::TCard2 c2ClassId = pmeciMain->c2Id();
+    const tCIDLib::TCard2 c2StartId = pmeciMain->c2FindMethod(L"Start");
+    const tCIDLib::TCard2 c2SideFxId = pmeciMain->c2FindMethod(L"SideFx");
+    if ((c2StartId == kCIDMacroEng::c2BadId) || (c2SideFxId == kCIDMacroEng::c2BadId))
+    {
+        strmOut << TFWCurLn << L"Could not find the test methods" << kCIDLib::DNewLn;
+        return tTestFWLib::ETestRes::Failed;
+    }
+
+    if (meprfTest.c4CallCount(c2ClassId, c2StartId) != 1)
+    {
+        strmOut << TFWCurLn << L"Expected 1 call to Start, got "
+                << meprfTest.c4CallCount(c2ClassId, c2StartId) << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    if (!meprfTest.c4CallCount(c2ClassId, c2SideFxId))
+    {
+        strmOut << TFWCurLn << L"Expected calls to SideFx" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Start's inclusive time has to cover the time of the calls it made
+    if (meprfTest.c8InclusiveUS(c2ClassId, c2StartId)
+                < meprfTest.c8InclusiveUS(c2ClassId, c2SideFxId))
+    {
+        strmOut << TFWCurLn << L"Start's inclusive time is less than SideFx's"
+                << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    //
+    //  And the folded output should have Start in it. Stacks with no measurable
+    //  exclusive time are left out, so we can't count on seeing the helpers.
+    //
+    TTextStringOutStream strmFolded(0x1000UL);
+    meprfTest.FormatFolded(strmFolded, m_meTest);
+    strmFolded.Flush();
+    tCIDLib::TCard4 c4At = 0;
+    if (!strmFolded.strData().bFirstOccurrence(L".Start", c4At))
+    {
+        strmOut << TFWCurLn << L"Folded stacks didn't include Start"
+                << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Do it again with profiling off, and we should get nothing
+    if (!bParseAndRun(strmOut, strPath, kCIDLib::False, pmeciMain))
+        return tTestFWLib::ETestRes::Failed;
+
+    if (m_meTest.meprfData().bHasData())
+    {
+        strmOut << TFWCurLn << L"Profiling data was collected while disabled"
+                << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_Profiler: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Parses the indicated macro, which resets the engine and so any previous
+//  profiling data, then runs it with profiling on or off as indicated.
+//
+tCIDLib::TBoolean
+TTest_Profiler::bParseAndRun(       TTextStringOutStream&   strmOut
+                            , const TString&                strClassPath
+                            , const tCIDLib::TBoolean       bProfile
+                            ,       TMEngClassInfo*&        pmeciMain)
+{
+    if (!m_meprsTest.bParse(strClassPath, pmeciMain, &m_meTest, &m_meehParser, &m_mecmTest))
+    {
+        strmOut << TFWCurLn << L"Macro '" << strClassPath << L"' failed to parse"
+                << kCIDLib::DNewLn;
+        return kCIDLib::False;
+    }
+    m_meTest.bProfiling(bProfile);
+
+    TMEngClassVal* pmecvTarget = pmeciMain->pmecvMakeStorage
+    (
+        L"$Main$", m_meTest, tCIDMacroEng::EConstTypes::NonConst
+    );
+    TJanitor<TMEngClassVal> janTarget(pmecvTarget);
+
+    tCIDLib::TBoolean bRes = kCIDLib::True;
+    try
+    {
+        if (!m_meTest.bInvokeDefCtor(*pmecvTarget, 0))
+        {
+            bRes = kCIDLib::False;
+        }
+         else
+        {
+            TCIDMacroEngine::TParmList colParms(tCIDLib::EAdoptOpts::Adopt);
+            if (m_meTest.i4Run(*pmecvTarget, colParms, 0) != 0)
+            {
+                strmOut << TFWCurLn << L"Macro '" << strClassPath
+                        << L"' returned non-zero" << kCIDLib::DNewLn;
+                bRes = kCIDLib::False;
+            }
+        }
+    }
+
+    catch(const TExceptException&)
+    {
+        // Already reported to the output by the error handler
+        bRes = kCIDLib::False;
+    }
+
+    m_meTest.bProfiling(kCIDLib::False);
+    return bRes;
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SharedClasses
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_SharedClasses: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_SharedClasses::TTest_SharedClasses() :
+
+    TTestFWTest(L"Shared Classes", L"Tests running macros from shared class sets", 6)
+    , m_strmConsole(0x1000UL)
+    , m_strmConsole2(0x1000UL)
+{
+}
+
+TTest_SharedClasses::~TTest_SharedClasses()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SharedClasses: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_SharedClasses::eRunTest(  TTextStringOutStream&   strmOut
+                                , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TPathStr pathLoad;
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Classes");
+    m_mecmTest.strBasePath(pathLoad);
+
+    TFileSys::QueryCurrentDir(pathLoad);
+    pathLoad.AddLevel(L"Files");
+    m_mefrTest.strBasePath(pathLoad);
+
+    m_meehEngine.SetStream(&strmOut);
+    m_meehParser.SetStream(&strmOut);
+    m_meTest.SetErrHandler(&m_meehEngine);
+    m_meTest.SetFileResolver(&m_mefrTest);
+    m_meTest.SetConsole(&m_strmConsole);
+    m_meTest2.SetErrHandler(&m_meehEngine);
+    m_meTest2.SetFileResolver(&m_mefrTest);
+    m_meTest2.SetConsole(&m_strmConsole2);
+
+    // All engines should be using the same built in classes
+    if (&m_meTest.meciFind(tCIDMacroEng::EIntrinsics::String)
+                            != &m_meTest2.meciFind(tCIDMacroEng::EIntrinsics::String))
+    {
+        strmOut << TFWCurLn << L"Engines are not sharing built in classes"
+                << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    const tCIDLib::TCh* apszTests[] =
+    {
+        L"MEng.User.Tests.TestFlow1"
+        , L"MEng.User.Tests.TestDerivedClass"
+        , L"MEng.User.Tests.TestEnum1"
+        , L"MEng.User.Tests.TestVector1"
+    };
+    const tCIDLib::TCard4 c4TestCnt = tCIDLib::c4ArrayElems(apszTests);
+
+    TString strOut1, strOut2;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCnt; c4Index++)
+    {
+        const TString strPath(apszTests[c4Index]);
+
+        TMEngClassInfo* pmeciMain;
+        if (!m_meprsTest.bParse(strPath, pmeciMain, &m_meTest, &m_meehParser, &m_mecmTest))
+        {
+            strmOut << TFWCurLn << L"Macro '" << strPath << L"' failed to parse"
+                    << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        // Share the classes and have the second engine use them
+        TMEngClassSet::TPtr cptrShared = m_meTest.cptrShareClasses();
+        m_meTest2.UseClassSet(cptrShared);
+
+        if (m_meTest2.c4ClassCount() != m_meTest.c4ClassCount())
+        {
+            strmOut << TFWCurLn << L"Shared " << strPath << L" has "
+                    << m_meTest2.c4ClassCount() << L" classes, expected "
+                    << m_meTest.c4ClassCount() << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        TMEngClassInfo* pmeciMain2 = m_meTest2.pmeciFind(strPath);
+        if (pmeciMain2 != pmeciMain)
+        {
+            strmOut << TFWCurLn << L"Shared " << strPath
+                    << L" did not get the same main class" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        if (!bRun(strmOut, m_meTest, *pmeciMain, m_strmConsole, strOut1)
+        ||  !bRun(strmOut, m_meTest2, *pmeciMain2, m_strmConsole2, strOut2))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+
+        if (strOut1 != strOut2)
+        {
+            strmOut << TFWCurLn << L"Shared " << strPath
+                    << L" produced different output" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+
+        //
+        //  Reset the second engine, which should leave the shared set alive
+        //  for the first, then make sure the first can still run it.
+        //
+        m_meTest2.Reset();
+        if (!bRun(strmOut, m_meTest, *pmeciMain, m_strmConsole, strOut2))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+            continue;
+        }
+    }
+
+    // Report how long it takes to create an engine, now that it's just a reference
+    const tCIDLib::TCard4 c4EngCount = 100;
+    const tCIDLib::TCard8 c8Start = TTime::c8HPTimerUS();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4EngCount; c4Index++)
+    {
+        TCIDMacroEngine meTmp;
+    }
+    strmOut << L"Engine create/destroy = "
+            << ((TTime::c8HPTimerUS() - c8Start) / c4EngCount) << L"us\n"
+            << kCIDLib::EndLn;
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SharedClasses: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Runs the main class in the passed engine and gives back the console output
+tCIDLib::TBoolean
+TTest_SharedClasses::bRun(  TTextStringOutStream&   strmOut
+                            , TCIDMacroEngine&      meToUse
+                            , TMEngClassInfo&       meciMain
+                            , TTextStringOutStream& strmConsole
+                            , TString&              strOutput)
+{
+    TMEngClassVal* pmecvTarget = meciMain.pmecvMakeStorage
+    (
+        L"$Main$", meToUse, tCIDMacroEng::EConstTypes::NonConst
+    );
+    TJanitor<TMEngClassVal> janTarget(pmecvTarget);
+
+    strmConsole.Reset();
+    try
+    {
+        if (!meToUse.bInvokeDefCtor(*pmecvTarget, 0))
+            return kCIDLib::False;
+
+        TCIDMacroEngine::TParmList colParms(tCIDLib::EAdoptOpts::Adopt);
+        if (meToUse.i4Run(*pmecvTarget, colParms, 0) != 0)
+        {
+            strmOut << TFWCurLn << L"Macro '" << meciMain.strClassPath()
+                    << L"' returned non-zero" << kCIDLib::DNewLn;
+            return kCIDLib::False;
+        }
+    }
+
+    catch(const TExceptException&)
+    {
+        // Already reported to the output by the error handler
+        return kCIDLib::False;
+    }
+
+    strmConsole.Flush();
+    strOutput = strmConsole.strData();
+    return kCIDLib::True;
+}
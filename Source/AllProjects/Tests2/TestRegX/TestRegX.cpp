@@ -82,6 +82,8 @@ tCIDLib::TVoid TRegXTestApp::LoadTests()
     AddTest(new TTest_RepAll);
     AddTest(new TTest_CpMv);
     AddTest(new TTest_Misc);
+    AddTest(new TTest_DFA);
+    AddTest(new TTest_RegExSet);
 }
 
 tCIDLib::TVoid TRegXTestApp::PostTest(const TTestFWTest&)
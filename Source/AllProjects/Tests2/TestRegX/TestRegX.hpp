@@ -200,6 +200,98 @@ class TTest_Misc : public TTestFWTest
 };
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_DFA
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_DFA : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_DFA();
+
+        ~TTest_DFA();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCompareFinds
+        (
+                    TTextStringOutStream&   strmOutput
+            , const TString&                strPattern
+            , const TString&                strSearch
+            , const tCIDLib::TBoolean       bCaseSensitive
+            ,       tCIDLib::TEncodedTime&  enctNFA
+            ,       tCIDLib::TEncodedTime&  enctDFA
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_DFA,TTestFWTest)
+};
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RegExSet
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_RegExSet : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_RegExSet();
+
+        ~TTest_RegExSet();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCompareSet
+        (
+                    TTextStringOutStream&   strmOutput
+            , const TRegExSet&              rxsetTest
+            , const TString&                strSearch
+            , const tCIDLib::TBoolean       bCaseSensitive
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_RegExSet,TTestFWTest)
+};
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TRegXTest
 // PREFIX: tfwapp
@@ -40,6 +40,8 @@ RTTIDecls(TTest_Match,TTestFWTest)
 RTTIDecls(TTest_RepAll,TTestFWTest)
 RTTIDecls(TTest_CpMv,TTestFWTest)
 RTTIDecls(TTest_Misc,TTestFWTest)
+RTTIDecls(TTest_DFA,TTestFWTest)
+RTTIDecls(TTest_RegExSet,TTestFWTest)
 
 
 
@@ -270,11 +272,54 @@ static const TTestEntry aTests[] =
   , { 0 , 0, EFull  , 0 , 0 , 0, L"([0-9]|[0-9][0-9]|[0-9][0-9][0-9])(\\.[0-9])*", L"1.23" }
 
 
+    //
+    //  Nested alternations and closures. The NFA used to drop states here, which
+    //  lost the longest match, or loop forever on nullable closures in closures.
+    //
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"((A|AB)*C)+"    , L"AABCABC" }
+  , { 1 , 0, EPart  , 0 , 0 , 7, L"((A|AB)*C)+"    , L"AABCABC" }
+  , { 1 , 0, EPart  , 0 , 1 , 4, L"((A|AB)*C)+"    , L"XAABCDX" }
+  , { 0 , 1, EFull  , 0 , 0 , 0, L"((A|AB)*C)+"    , L"AABCAB" }
+  , { 1 , 0, EPart  , 0 , 0 , 2, L"(AB*|B)*A"      , L"AAB" }
+  , { 1 , 0, EPart  , 0 , 1 , 2, L"(AB*|B)*A"      , L"XAABCDX" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"(AB*|B)*A"      , L"ABBA" }
+  , { 0 , 1, EFull  , 0 , 0 , 0, L"(AB*|B)*A"      , L"AAB" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"(A*)*B"         , L"AAB" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"(A*)*B"         , L"B" }
+  , { 1 , 0, EPart  , 0 , 1 , 3, L"(A*)*B"         , L"XAABCDX" }
+  , { 0 , 1, EFull  , 0 , 0 , 0, L"(A*)*B"         , L"AAC" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"(A|B*)*C"       , L"ABABC" }
+  , { 1 , 0, EPart  , 0 , 1 , 4, L"(A|B*)*C"       , L"XABBC" }
+  , { 0 , 1, EFull  , 0 , 0 , 0, L"(A|B*)*C"       , L"ABAB" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"((X*)|(Y*))*Z"  , L"XYXZ" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"(A?)*B"         , L"AAB" }
+  , { 1 , 1, EFull  , 0 , 0 , 0, L"((A*)*|B)*"     , L"" }
+
+
   , { 1 , 1, EFull  , 0 , 0 , 0, L"ARMED \\*+[A-Z]+\\*+ .*", L"ARMED ***AWAY***** ALL SECURE **" }
 };
 static const tCIDLib::TCard4 c4TestCount = tCIDLib::c4ArrayElems(aTests);
 
 
+//
+//  A set of patterns that are run over a generated log file style corpus,
+//  with and without the DFA, to make sure they get the same results and to
+//  report the relative times. They are a mix of ones with a literal prefix,
+//  with only a required literal, and with neither.
+//
+static const tCIDLib::TCh* const apszCorpusPats[] =
+{
+    L"timeout"
+    , L"id=[0-9]+"
+    , L"WARN[A-Z]*"
+    , L"user=[a-z]+[0-9]@[a-z]+\\.com"
+    , L"(ERROR|FATAL) [a-z]+"
+    , L"module(1|2)[0-9]? status"
+    , L".*timeout.*"
+};
+static const tCIDLib::TCard4 c4CorpusPatCount = tCIDLib::c4ArrayElems(apszCorpusPats);
+
+
 
 
 // ---------------------------------------------------------------------------
@@ -535,108 +580,113 @@ TTest_Match::eRunTest(  TTextStringOutStream&   strmOut
 
     //
     //  Run through each of the tests in the test list and do each one
-    //  in turn. Actually we have three layers. The outer one runs all of
-    //  the tests once in case sensitive mode and then once in case
+    //  in turn. Actually we have four layers. The outer one runs all of
+    //  the tests once with the DFA and once with just the NFA. The next one
+    //  runs them once in case sensitive mode and then once in case
     //  insensitive mode. The next one runs each test, and the final one
     //  decides what type of test each one is.
     //
     TRegEx regxTest;
-    tCIDLib::TBoolean bCase = kCIDLib::True;
-    for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < 2; c4CaseInd++)
+    for (tCIDLib::TCard4 c4EngInd = 0; c4EngInd < 2; c4EngInd++)
     {
-        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCount; c4Index++)
+        regxTest.bUseDFA(c4EngInd == 0);
+        tCIDLib::TBoolean bCase = kCIDLib::True;
+        for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < 2; c4CaseInd++)
         {
-            const TTestEntry& testCur = aTests[c4Index];
-
-            regxTest.SetExpression(testCur.pszPattern);
-            tCIDLib::TBoolean   bRes;
-            tCIDLib::TCard4     c4Ofs;
-            tCIDLib::TCard4     c4Len;
-            if (testCur.eType == EPart)
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCount; c4Index++)
             {
-                //
-                //  If there is a start index, then we are obviously doing a
-                //  'match at', otherwise just do a 'match'.
-                //
-                c4Ofs = testCur.c4StartAt;
-                if (testCur.c4StartAt)
+                const TTestEntry& testCur = aTests[c4Index];
+
+                regxTest.SetExpression(testCur.pszPattern);
+                tCIDLib::TBoolean   bRes;
+                tCIDLib::TCard4     c4Ofs;
+                tCIDLib::TCard4     c4Len;
+                if (testCur.eType == EPart)
                 {
-                    bRes = regxTest.bFindMatchAt
-                    (
-                        testCur.pszToSearch
-                        , c4Ofs
-                        , c4Len
-                        , (testCur.c1OnlyAtStart == 1)
-                        , bCase
-                    );
+                    //
+                    //  If there is a start index, then we are obviously doing a
+                    //  'match at', otherwise just do a 'match'.
+                    //
+                    c4Ofs = testCur.c4StartAt;
+                    if (testCur.c4StartAt)
+                    {
+                        bRes = regxTest.bFindMatchAt
+                        (
+                            testCur.pszToSearch
+                            , c4Ofs
+                            , c4Len
+                            , (testCur.c1OnlyAtStart == 1)
+                            , bCase
+                        );
+                    }
+                     else
+                    {
+                        bRes = regxTest.bFindMatch
+                        (
+                            testCur.pszToSearch
+                            , c4Ofs
+                            , c4Len
+                            , (testCur.c1OnlyAtStart == 1)
+                            , bCase
+                        );
+                    }
+
+                    // Make sure it matched at the right offset
+                    if ((bRes == (testCur.c1ShouldMatch == 1))
+                    &&  (testCur.c4ShouldMatchAt != c4Ofs))
+                    {
+                        eRes = tTestFWLib::ETestRes::Failed;
+                        strmOut << L"Test (" << c4Index
+                                << L" matched at wrong offset. Pattern: '"
+                                << testCur.pszPattern << L"', Search: '"
+                                << testCur.pszToSearch << L"'\n\n";
+                    }
+
+                    if (bRes
+                    &&  (testCur.c1ShouldMatch == 1)
+                    &&  (testCur.c4ExpectedLen != c4Len))
+                    {
+                        eRes = tTestFWLib::ETestRes::Failed;
+                        strmOut << L"Test (" << c4Index
+                                << L" Partial match was wrong length. Pattern: '"
+                                << testCur.pszPattern << L"', Search: '"
+                                << testCur.pszToSearch << L"'\n\n";
+                    }
                 }
-                 else
+                 else if (testCur.eType == EFull)
                 {
-                    bRes = regxTest.bFindMatch
-                    (
-                        testCur.pszToSearch
-                        , c4Ofs
-                        , c4Len
-                        , (testCur.c1OnlyAtStart == 1)
-                        , bCase
-                    );
+                    //
+                    //  Its a full match so we need to call the method that
+                    //  checks for a full match of the whole target string.
+                    //
+                    bRes = regxTest.bFullyMatches(testCur.pszToSearch, bCase);
                 }
 
-                // Make sure it matched at the right offset
-                if ((bRes == (testCur.c1ShouldMatch == 1))
-                &&  (testCur.c4ShouldMatchAt != c4Ofs))
+                // Make sure it matched if it should have or not if not
+                if (bRes != (testCur.c1ShouldMatch == 1))
                 {
                     eRes = tTestFWLib::ETestRes::Failed;
-                    strmOut << L"Test (" << c4Index
-                            << L" matched at wrong offset. Pattern: '"
-                            << testCur.pszPattern << L"', Search: '"
-                            << testCur.pszToSearch << L"'\n\n";
-                }
 
-                if (bRes
-                &&  (testCur.c1ShouldMatch == 1)
-                &&  (testCur.c4ExpectedLen != c4Len))
-                {
-                    eRes = tTestFWLib::ETestRes::Failed;
-                    strmOut << L"Test (" << c4Index
-                            << L" Partial match was wrong length. Pattern: '"
+                    if (!testCur.c1ShouldMatch)
+                        strmOut << L"Not-";
+                    if (testCur.eType == EPart)
+                        strmOut << L"Part-";
+                    else if (testCur.eType == EFull)
+                        strmOut << L"Full-";
+                    else
+                        strmOut << L"????-";
+
+                    strmOut << L"Test (" << c4Index << L") failed. Pattern: '"
                             << testCur.pszPattern << L"', Search: '"
-                            << testCur.pszToSearch << L"'\n\n";
+                            << testCur.pszToSearch << L"'\n"
+                            << kCIDLib::NewLn << L"NFA is:\n" << regxTest
+                            << kCIDLib::DNewLn;
                 }
             }
-             else if (testCur.eType == EFull)
-            {
-                //
-                //  Its a full match so we need to call the method that
-                //  checks for a full match of the whole target string.
-                //
-                bRes = regxTest.bFullyMatches(testCur.pszToSearch, bCase);
-            }
-
-            // Make sure it matched if it should have or not if not
-            if (bRes != (testCur.c1ShouldMatch == 1))
-            {
-                eRes = tTestFWLib::ETestRes::Failed;
 
-                if (!testCur.c1ShouldMatch)
-                    strmOut << L"Not-";
-                if (testCur.eType == EPart)
-                    strmOut << L"Part-";
-                else if (testCur.eType == EFull)
-                    strmOut << L"Full-";
-                else
-                    strmOut << L"????-";
-
-                strmOut << L"Test (" << c4Index << L") failed. Pattern: '"
-                        << testCur.pszPattern << L"', Search: '"
-                        << testCur.pszToSearch << L"'\n"
-                        << kCIDLib::NewLn << L"NFA is:\n" << regxTest
-                        << kCIDLib::DNewLn;
-            }
+            // Flip the case flag
+            bCase = kCIDLib::False;
         }
-
-        // Flip the case flag
-        bCase = kCIDLib::False;
     }
     return eRes;
 }
@@ -918,3 +968,513 @@ TTest_Misc::eRunTest( TTextStringOutStream&   strmOut
 
     return eRes;
 }
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_DFA
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_DFA: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_DFA::TTest_DFA() :
+
+    TTestFWTest
+    (
+        L"Lazy DFA", L"Compares DFA and NFA matching, and times them", 3
+    )
+{
+}
+
+TTest_DFA::~TTest_DFA()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_DFA: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_DFA::eRunTest(TTextStringOutStream&   strmOut
+                    , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    // The DFA should be on by default and the setting should be copied
+    TRegEx regxDFA;
+    if (!regxDFA.bUseDFA())
+    {
+        strmOut << L"The DFA was not enabled by default" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    TRegEx regxNFA;
+    regxNFA.bUseDFA(kCIDLib::False);
+    {
+        TRegEx regxCopy(regxNFA);
+        if (regxCopy.bUseDFA())
+        {
+            strmOut << L"The DFA setting was not copied" << kCIDLib::DNewLn;
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  Run the standard test list through both and make sure they get the
+    //  same results. The match test checks each of them against the expected
+    //  results, this just makes sure they agree with each other directly.
+    //
+    tCIDLib::TBoolean bCase = kCIDLib::True;
+    for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < 2; c4CaseInd++)
+    {
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCount; c4Index++)
+        {
+            const TTestEntry& testCur = aTests[c4Index];
+            regxDFA.SetExpression(testCur.pszPattern);
+            regxNFA.SetExpression(testCur.pszPattern);
+
+            tCIDLib::TBoolean   bDFARes;
+            tCIDLib::TBoolean   bNFARes;
+            tCIDLib::TCard4     c4DFAOfs = testCur.c4StartAt;
+            tCIDLib::TCard4     c4DFALen = 0;
+            tCIDLib::TCard4     c4NFAOfs = testCur.c4StartAt;
+            tCIDLib::TCard4     c4NFALen = 0;
+            if (testCur.eType == EPart)
+            {
+                bDFARes = regxDFA.bFindMatchAt
+                (
+                    testCur.pszToSearch
+                    , c4DFAOfs
+                    , c4DFALen
+                    , (testCur.c1OnlyAtStart == 1)
+                    , bCase
+                );
+
+                bNFARes = regxNFA.bFindMatchAt
+                (
+                    testCur.pszToSearch
+                    , c4NFAOfs
+                    , c4NFALen
+                    , (testCur.c1OnlyAtStart == 1)
+                    , bCase
+                );
+            }
+             else
+            {
+                bDFARes = regxDFA.bFullyMatches(testCur.pszToSearch, bCase);
+                bNFARes = regxNFA.bFullyMatches(testCur.pszToSearch, bCase);
+            }
+
+            if ((bDFARes != bNFARes)
+            ||  (bDFARes && ((c4DFAOfs != c4NFAOfs) || (c4DFALen != c4NFALen))))
+            {
+                strmOut << L"Test (" << c4Index << L") DFA and NFA results differ. "
+                        << L"Pattern: '" << testCur.pszPattern << L"', Search: '"
+                        << testCur.pszToSearch << L"'\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+        bCase = kCIDLib::False;
+    }
+
+    //
+    //  This one requires more DFA states than we allow, since it has to
+    //  remember the last nine characters. So it will overflow and fall back
+    //  to the NFA, and should still get the same results. We generate some
+    //  pseudo-random A/B strings to search.
+    //
+    tCIDLib::TEncodedTime enctNFA = 0;
+    tCIDLib::TEncodedTime enctDFA = 0;
+    {
+        const TString strPattern(L"(A|B)*A(A|B)(A|B)(A|B)(A|B)(A|B)(A|B)(A|B)(A|B)");
+
+        tCIDLib::TCard4 c4Seed = 0x1234;
+        TString strSearch;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 16; c4Index++)
+        {
+            strSearch.Clear();
+            for (tCIDLib::TCard4 c4ChInd = 0; c4ChInd < 48; c4ChInd++)
+            {
+                c4Seed = (c4Seed * 1103515245) + 12345;
+                strSearch.Append((c4Seed & 0x10000) ? kCIDLib::chLatin_A : kCIDLib::chLatin_B);
+            }
+
+            if (!bCompareFinds(strmOut, strPattern, strSearch, kCIDLib::True, enctNFA, enctDFA))
+                eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    //
+    //  And now the corpus. We generate a log file style text, and run each
+    //  pattern over it, finding all matches, and then also do full matches
+    //  against each line. We report the times, though they are only a rough
+    //  indication.
+    //
+    TVector<TString> colLines(256);
+    TString strCorpus(16384UL);
+    {
+        TString strLine;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < 256; c4Index++)
+        {
+            strLine = L"Line ";
+            strLine.AppendFormatted(c4Index);
+            strLine.Append((c4Index % 17 == 3) ? L" WARNING module" : L" INFO module");
+            strLine.AppendFormatted(c4Index % 13);
+            strLine.Append(L" status=ok id=");
+            strLine.AppendFormatted(4711 + (c4Index * 7));
+            strLine.Append(L" user=fred");
+            strLine.AppendFormatted(c4Index % 5);
+            strLine.Append(L"@example.com");
+            if (c4Index % 23 == 5)
+                strLine.Append(L" timeout waiting for reply");
+
+            colLines.objAdd(strLine);
+            strCorpus.Append(strLine);
+            strCorpus.Append(kCIDLib::chLF);
+        }
+    }
+
+    enctNFA = 0;
+    enctDFA = 0;
+    for (tCIDLib::TCard4 c4PatInd = 0; c4PatInd < c4CorpusPatCount; c4PatInd++)
+    {
+        const TString strPattern(apszCorpusPats[c4PatInd]);
+
+        bCase = kCIDLib::True;
+        for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < 2; c4CaseInd++)
+        {
+            if (!bCompareFinds(strmOut, strPattern, strCorpus, bCase, enctNFA, enctDFA))
+                eRes = tTestFWLib::ETestRes::Failed;
+            bCase = kCIDLib::False;
+        }
+
+        regxDFA.SetExpression(strPattern);
+        regxNFA.SetExpression(strPattern);
+        const tCIDLib::TCard4 c4LineCount = colLines.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LineCount; c4Index++)
+        {
+            const TString& strCur = colLines[c4Index];
+
+            tCIDLib::TEncodedTime enctStart = TTime::enctNow();
+            const tCIDLib::TBoolean bNFARes = regxNFA.bFullyMatches(strCur, kCIDLib::False);
+            enctNFA += TTime::enctNow() - enctStart;
+
+            enctStart = TTime::enctNow();
+            const tCIDLib::TBoolean bDFARes = regxDFA.bFullyMatches(strCur, kCIDLib::False);
+            enctDFA += TTime::enctNow() - enctStart;
+
+            if (bDFARes != bNFARes)
+            {
+                strmOut << L"DFA and NFA full match results differ. Pattern: '"
+                        << strPattern << L"', Line: " << c4Index << L"\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    strmOut << L"Corpus times (ms), NFA: "
+            << TCardinal64(enctNFA / kCIDLib::enctOneMilliSec)
+            << L", DFA: "
+            << TCardinal64(enctDFA / kCIDLib::enctOneMilliSec)
+            << kCIDLib::DNewLn;
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_DFA: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Finds all of the matches of the pattern in the search string, using an
+//  engine with and one without the DFA, and makes sure they get the same
+//  results. The time each one takes is added to the passed times.
+//
+tCIDLib::TBoolean
+TTest_DFA::bCompareFinds(       TTextStringOutStream&   strmOut
+                        , const TString&                strPattern
+                        , const TString&                strSearch
+                        , const tCIDLib::TBoolean       bCaseSensitive
+                        ,       tCIDLib::TEncodedTime&  enctNFA
+                        ,       tCIDLib::TEncodedTime&  enctDFA)
+{
+    TRegEx regxDFA(strPattern);
+    TRegEx regxNFA;
+    regxNFA.bUseDFA(kCIDLib::False);
+    regxNFA.SetExpression(strPattern);
+
+    auto FindAll = [&](const TRegEx& regxSrc, TFundVector<tCIDLib::TCard4>& fcolTar)
+    {
+        const tCIDLib::TEncodedTime enctStart = TTime::enctNow();
+        const tCIDLib::TCard4 c4SearchLen = strSearch.c4Length();
+        tCIDLib::TCard4 c4At = 0;
+        while (c4At < c4SearchLen)
+        {
+            tCIDLib::TCard4 c4Ofs = c4At;
+            tCIDLib::TCard4 c4Len = 0;
+            if (!regxSrc.bFindMatchAt(strSearch, c4Ofs, c4Len, kCIDLib::False, bCaseSensitive))
+                break;
+
+            fcolTar.c4AddElement(c4Ofs);
+            fcolTar.c4AddElement(c4Len);
+            c4At = c4Ofs + c4Len;
+        }
+        return TTime::enctNow() - enctStart;
+    };
+
+    TFundVector<tCIDLib::TCard4> fcolNFA;
+    TFundVector<tCIDLib::TCard4> fcolDFA;
+    enctNFA += FindAll(regxNFA, fcolNFA);
+    enctDFA += FindAll(regxDFA, fcolDFA);
+
+    if (fcolNFA.c4ElemCount() != fcolDFA.c4ElemCount())
+    {
+        strmOut << L"DFA found " << (fcolDFA.c4ElemCount() / 2)
+                << L" matches but NFA found " << (fcolNFA.c4ElemCount() / 2)
+                << L". Pattern: '" << strPattern << L"'\n\n";
+        return kCIDLib::False;
+    }
+
+    const tCIDLib::TCard4 c4Count = fcolNFA.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        if (fcolNFA[c4Index] != fcolDFA[c4Index])
+        {
+            strmOut << L"DFA and NFA matches differ at match " << (c4Index / 2)
+                    << L". Pattern: '" << strPattern << L"'\n\n";
+            return kCIDLib::False;
+        }
+    }
+    return kCIDLib::True;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_RegExSet
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_RegExSet: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_RegExSet::TTest_RegExSet() :
+
+    TTestFWTest
+    (
+        L"Expression Sets", L"Tests multi-pattern matching via TRegExSet", 3
+    )
+{
+}
+
+TTest_RegExSet::~TTest_RegExSet()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RegExSet: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_RegExSet::eRunTest(TTextStringOutStream&  strmOut
+                        , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    //
+    //  Set up a small set of log filter type rules, some of which are just
+    //  literals, and check that we get the expected literal count.
+    //
+    TRegExSet rxsetTest;
+    rxsetTest.c4AddPattern(L"ERROR");
+    rxsetTest.c4AddPattern(L"WARN[A-Z]*");
+    rxsetTest.c4AddPattern(L"id=[0-9]+");
+    rxsetTest.c4AddPattern(L"timeout");
+    rxsetTest.c4AddPattern(L"user=[a-z]+[0-9]@example\\.com");
+    rxsetTest.c4AddPattern(L"fred\\.");
+
+    if (rxsetTest.c4PatternCount() != 6)
+    {
+        strmOut << L"Set reported wrong pattern count" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    if (rxsetTest.c4LiteralCount() != 3)
+    {
+        strmOut << L"Expected 3 literal patterns but got "
+                << rxsetTest.c4LiteralCount() << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Do one by hand to make sure we get the right indices back
+    TFundVector<tCIDLib::TCard4> fcolMatches;
+    rxsetTest.c4FindMatches
+    (
+        L"WARNING id=12 timeout for user=fred1@example.com", fcolMatches, kCIDLib::True
+    );
+    if ((fcolMatches.c4ElemCount() != 4)
+    ||  (fcolMatches[0] != 1)
+    ||  (fcolMatches[1] != 2)
+    ||  (fcolMatches[2] != 3)
+    ||  (fcolMatches[3] != 4))
+    {
+        strmOut << L"Set find returned the wrong matches" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Run some lines through it and compare to the individual expressions
+    const tCIDLib::TCh* const apszLines[] =
+    {
+        L"Line 1 INFO status=ok id=4711 user=fred1@example.com"
+        , L"Line 2 WARNING id=4718 user=fred2@example.com timeout"
+        , L"Line 3 ERROR timeout waiting for FRED."
+        , L"error: Fred. timed out"
+        , L"ERROR"
+        , L"fred."
+        , L"id="
+        , L"x"
+    };
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < tCIDLib::c4ArrayElems(apszLines); c4Index++)
+    {
+        if (!bCompareSet(strmOut, rxsetTest, apszLines[c4Index], kCIDLib::True)
+        ||  !bCompareSet(strmOut, rxsetTest, apszLines[c4Index], kCIDLib::False))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Adding an empty pattern should fail
+    try
+    {
+        rxsetTest.c4AddPattern(TString::strEmpty());
+        strmOut << L"Adding an empty pattern did not fail" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    catch(...)
+    {
+    }
+
+    //
+    //  Now put all of the patterns from the match test list into a set and,
+    //  for each of the search strings, make sure we get the same results as
+    //  running them separately. This is enough patterns that it will likely
+    //  overflow the combined DFA, so do the first bunch as well, so that we
+    //  check both ways.
+    //
+    TRegExSet rxsetAll;
+    TRegExSet rxsetSome;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCount; c4Index++)
+    {
+        const TString strPattern(aTests[c4Index].pszPattern);
+        const tCIDLib::TCard4 c4Count = rxsetAll.c4PatternCount();
+        tCIDLib::TCard4 c4PatInd = 0;
+        for (; c4PatInd < c4Count; c4PatInd++)
+        {
+            if (rxsetAll.strPatternAt(c4PatInd) == strPattern)
+                break;
+        }
+
+        if (c4PatInd == c4Count)
+        {
+            rxsetAll.c4AddPattern(strPattern);
+            if (c4Count < 16)
+                rxsetSome.c4AddPattern(strPattern);
+        }
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4TestCount; c4Index++)
+    {
+        const TString strSearch(aTests[c4Index].pszToSearch);
+        if (!bCompareSet(strmOut, rxsetAll, strSearch, kCIDLib::True)
+        ||  !bCompareSet(strmOut, rxsetAll, strSearch, kCIDLib::False)
+        ||  !bCompareSet(strmOut, rxsetSome, strSearch, kCIDLib::True)
+        ||  !bCompareSet(strmOut, rxsetSome, strSearch, kCIDLib::False))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Once reset it should be empty and match nothing
+    rxsetAll.Reset();
+    if (rxsetAll.c4PatternCount()
+    ||  rxsetAll.c4FindMatches(L"ABC", fcolMatches)
+    ||  rxsetAll.c4FullMatches(L"ABC", fcolMatches))
+    {
+        strmOut << L"Reset set was not empty" << kCIDLib::DNewLn;
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_RegExSet: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Run the search string through the set, for both finds and full matches, and
+//  compare the results to running each of the set's patterns separately.
+//
+tCIDLib::TBoolean
+TTest_RegExSet::bCompareSet(        TTextStringOutStream&   strmOut
+                            , const TRegExSet&              rxsetTest
+                            , const TString&                strSearch
+                            , const tCIDLib::TBoolean       bCaseSensitive)
+{
+    TFundVector<tCIDLib::TCard4> fcolFind;
+    TFundVector<tCIDLib::TCard4> fcolFull;
+    rxsetTest.c4FindMatches(strSearch, fcolFind, bCaseSensitive);
+    rxsetTest.c4FullMatches(strSearch, fcolFull, bCaseSensitive);
+
+    tCIDLib::TBoolean bRet = kCIDLib::True;
+    tCIDLib::TCard4 c4FindInd = 0;
+    tCIDLib::TCard4 c4FullInd = 0;
+    TRegEx regxTest;
+    const tCIDLib::TCard4 c4Count = rxsetTest.c4PatternCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        regxTest.SetExpression(rxsetTest.strPatternAt(c4Index));
+
+        tCIDLib::TCard4 c4Ofs = 0;
+        tCIDLib::TCard4 c4Len = 0;
+        const tCIDLib::TBoolean bFind = !strSearch.bIsEmpty()
+                                        && regxTest.bFindMatch(strSearch
+                                                                , c4Ofs
+                                                                , c4Len
+                                                                , kCIDLib::False
+                                                                , bCaseSensitive);
+        const tCIDLib::TBoolean bSetFind = (c4FindInd < fcolFind.c4ElemCount())
+                                           && (fcolFind[c4FindInd] == c4Index);
+        if (bSetFind)
+            c4FindInd++;
+
+        const tCIDLib::TBoolean bFull = regxTest.bFullyMatches(strSearch, bCaseSensitive);
+        const tCIDLib::TBoolean bSetFull = (c4FullInd < fcolFull.c4ElemCount())
+                                           && (fcolFull[c4FullInd] == c4Index);
+        if (bSetFull)
+            c4FullInd++;
+
+        if ((bFind != bSetFind) || (bFull != bSetFull))
+        {
+            strmOut << L"Set and single results differ. Pattern: '"
+                    << rxsetTest.strPatternAt(c4Index) << L"', Search: '"
+                    << strSearch << L"', Case: " << bCaseSensitive
+                    << kCIDLib::DNewLn;
+            bRet = kCIDLib::False;
+        }
+    }
+
+    // Make sure there weren't any bogus extra ones
+    if ((c4FindInd != fcolFind.c4ElemCount()) || (c4FullInd != fcolFull.c4ElemCount()))
+    {
+        strmOut << L"Set returned invalid pattern indices. Search: '"
+                << strSearch << L"'" << kCIDLib::DNewLn;
+        bRet = kCIDLib::False;
+    }
+    return bRet;
+}